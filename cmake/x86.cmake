@@ -1,3 +1,5 @@
+option(PPLNN_USE_NUMA "build with libnuma" OFF)
+
 file(GLOB_RECURSE PPLNN_X86_SRC src/ppl/nn/engines/x86/*.cc)
 list(APPEND PPLNN_SOURCES ${PPLNN_X86_SRC})
 
@@ -7,6 +9,11 @@ list(APPEND PPLNN_LINK_LIBRARIES pplkernelx86_static)
 set(PPLNN_USE_X86 ON)
 list(APPEND PPLNN_COMPILE_DEFINITIONS PPLNN_USE_X86)
 
+if (PPLNN_USE_NUMA)
+    list(APPEND PPLNN_LINK_LIBRARIES numa)
+    list(APPEND PPLNN_COMPILE_DEFINITIONS PPLNN_USE_NUMA)
+endif()
+
 if(PPLNN_ENABLE_SANITIZE_OPTIONS)
     if(CMAKE_CXX_COMPILER_ID MATCHES "GNU" OR CMAKE_CXX_COMPILER_ID MATCHES "Clang")
         set(__ASAN_FLAGS__ "-fsanitize=undefined -fsanitize=address -fsanitize=leak -fno-omit-frame-pointer")
@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_X86_ENGINE_OPTIONS_H_
 
 #include "ppl/nn/common/common.h"
+#include "ppl/common/types.h"
 #include "ppl/nn/engines/x86/x86_options.h"
 #include <stdint.h>
 
@@ -26,6 +27,16 @@ namespace ppl { namespace nn {
 
 struct PPLNN_PUBLIC X86EngineOptions final {
     uint32_t mm_policy = X86_MM_COMPACT;
+    uint32_t dynamic_tuning_level = X86_TUNING_OFF;
+    /** DATATYPE_FLOAT32 or DATATYPE_BFLOAT16. bf16 is used by conv and gemm if the cpu supports avx512-bf16. */
+    uint32_t forward_precision = ppl::common::DATATYPE_FLOAT32;
+    /** number of threads used by kernels of runtimes created by this engine. 0 means the openmp default. */
+    uint32_t thread_num = 0;
+    /**
+       bind threads and memory of this engine to the specified numa node, range [0, numa_max_node].
+       -1 means not bind. requires building with PPLNN_USE_NUMA.
+    */
+    int32_t numa_node_id = -1;
 };
 
 }} // namespace ppl::nn
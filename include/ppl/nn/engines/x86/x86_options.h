@@ -42,10 +42,79 @@ enum {
     */
     X86_CONF_DISABLE_AVX_FMA3 = 1,
 
+    /**
+       @brief set quantization information. conv and gemm whose input tensors have per-tensor int8 params
+       will run in int8 if the cpu supports avx512 vnni.
+
+       @param json_str a json string(const char*) containing quantization information
+
+       @note example:
+       @code{.cpp}
+       x86_engine->Configure(X86_CONF_SET_QUANT_INFO, json_str);
+       @endcode
+    */
+    X86_CONF_SET_QUANT_INFO = 2,
+
+    /**
+       @brief export algorithms selected for conv ops to a json file after processing graphs. the file can be
+       imported by X86_CONF_IMPORT_ALGORITHMS on cpus of the same model to skip dynamic tuning.
+
+       @param json_file path of the json file(const char*)
+
+       @note example:
+       @code{.cpp}
+       x86_engine->Configure(X86_CONF_EXPORT_ALGORITHMS, json_file);
+       @endcode
+    */
+    X86_CONF_EXPORT_ALGORITHMS = 3,
+
+    /**
+       @brief import algorithms exported by X86_CONF_EXPORT_ALGORITHMS. imported algorithms take precedence over
+       both heuristics and dynamic tuning.
+
+       @param json_file path of the json file(const char*)
+
+       @note example:
+       @code{.cpp}
+       x86_engine->Configure(X86_CONF_IMPORT_ALGORITHMS, json_file);
+       @endcode
+    */
+    X86_CONF_IMPORT_ALGORITHMS = 4,
+
+    /**
+       @brief bind threads running kernels of runtimes created by this engine to the given cores. the i-th
+       openmp thread is bound to cores[i]. `X86EngineOptions::thread_num` is set to `core_num` if it is 0,
+       and should not be greater than `core_num` otherwise. cores of `X86EngineOptions::numa_node_id` are
+       used if this option is not set.
+
+       @note the thread calling `Runtime::Run()` is openmp thread 0 and belongs to the caller, so it is NOT
+       bound to cores[0] and keeps its own affinity. bind it to cores[0] before calling `Run()` if needed,
+       otherwise cores[0] may be idle while this thread runs on other cores.
+
+       @param cores core ids(const int32_t*)
+       @param core_num number of cores(uint32_t)
+
+       @note example:
+       @code{.cpp}
+       int32_t cores[] = {0, 1, 2, 3};
+       x86_engine->Configure(X86_CONF_SET_CORE_BINDING, cores, 4);
+       @endcode
+    */
+    X86_CONF_SET_CORE_BINDING = 5,
+
     /** max value */
     X86_CONF_MAX,
 };
 
+/** @brief dynamic tuning level */
+enum {
+    /** turn off dynamic tuning, algorithms are selected by heuristics */
+    X86_TUNING_OFF = 0,
+
+    /** measure candidate algorithms of conv ops with fixed input shapes and select the fastest one */
+    X86_TUNING_SELECT_ALGO = 1,
+};
+
 /** @brief memory management policies */
 enum {
     /** less memory usage, may cause performance loss */
@@ -60,6 +129,15 @@ enum {
     /** @brief memory defragmentation. make sure that device is not used when performing defragmentations. */
     X86_DEV_CONF_MEM_DEFRAG = 0,
 
+    /**
+       @brief args: uint64_t, max bytes of activations and temporary buffers allocated by this device. 0 means
+       unlimited, which is the default.
+       @note allocations exceeding the budget fail with `RC_OUT_OF_MEMORY` instead of growing memory usage. kernels
+       that can run with less temporary memory, e.g. conv falling back from winograd to direct, or im2col with
+       smaller tiles, use that instead of failing. refer to `RUNTIME_CONF_GET_MEMORY_STATISTICS` for memory usage.
+    */
+    X86_DEV_CONF_SET_MEMORY_BUDGET = 1,
+
     X86_DEV_CONF_MAX,
 };
 
@@ -32,6 +32,7 @@ public:
        @brief init from a model file
        @param engines used to process this model
        @note engines are managed by the caller
+       @note external data of the model, if any, is loaded from files relative to the directory of `model_file`
     */
     virtual ppl::common::RetCode Init(const char* model_file, Engine** engines, uint32_t engine_num) = 0;
 
@@ -39,13 +40,19 @@ public:
        @brief init from a model buffer
        @param engines used to process this model
        @note engines are managed by the caller
+       @note external data of the model, if any, is loaded from files relative to the current working directory
     */
     virtual ppl::common::RetCode Init(const char* model_buf, uint64_t buf_len, Engine** engines,
                                       uint32_t engine_num) = 0;
 
     virtual ppl::common::RetCode Preprocess() = 0;
 
-    /** @brief creates a Runtime instance */
+    /**
+       @brief creates a Runtime instance.
+       @note runtimes created by the same builder share constants and data preprocessed by engines, e.g. converted
+       weights of conv and fc kernels, which are read-only during inference. each runtime only owns its
+       activations and temporary buffers, so runtimes can run concurrently in different threads.
+    */
     virtual Runtime* CreateRuntime() = 0;
 
     virtual ppl::common::RetCode Serialize(const char* output_file, const char* fmt) const = 0;
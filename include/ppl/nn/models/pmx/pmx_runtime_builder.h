@@ -24,6 +24,20 @@
 
 namespace ppl { namespace nn {
 
+/** options for PmxRuntimeBuilder::Configure() */
+enum {
+    /**
+       @brief args: true/false. default is false.
+       maps the model file into memory when calling `Init(model_file, ...)` instead of reading it, and lets engines
+       use constants in the mapped file directly without copying them if possible.
+       @note MUST be set before `Init()`. the model file MUST NOT be modified until all runtimes created by this
+       builder and the builder itself are released.
+    */
+    PMX_RB_CONF_SET_MMAP_FLAG = 0,
+
+    PMX_RB_CONF_MAX,
+};
+
 class PPLNN_PUBLIC PmxRuntimeBuilder {
 public:
     virtual ~PmxRuntimeBuilder() {}
@@ -43,10 +57,18 @@ public:
     virtual ppl::common::RetCode Init(const char* model_buf, uint64_t buf_len, Engine** engines,
                                       uint32_t engine_num) = 0;
 
-    /** @brief creates a Runtime instance */
+    /**
+       @brief creates a Runtime instance.
+       @note runtimes created by the same builder share constants and data preprocessed by engines, e.g. converted
+       weights of conv and fc kernels, which are read-only during inference. each runtime only owns its
+       activations and temporary buffers, so runtimes can run concurrently in different threads.
+    */
     virtual Runtime* CreateRuntime() = 0;
 
     virtual ppl::common::RetCode Serialize(const char* output_file, const char* fmt) const = 0;
+
+    /** @brief set various runtime builder options defined in `pmx_runtime_builder.h` */
+    virtual ppl::common::RetCode Configure(uint32_t option, ...) = 0;
 };
 
 }} // namespace ppl::nn
@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_BATCHING_RUNNER_H_
+#define _ST_HPC_PPL_NN_RUNTIME_BATCHING_RUNNER_H_
+
+#include "ppl/nn/runtime/runtime.h"
+#include <vector>
+
+namespace ppl { namespace nn {
+
+struct PPLNN_PUBLIC BatchingOptions final {
+    /** max number of samples, i.e. sum of dim 0 of inputs of requests, that are run together */
+    uint32_t max_batch_size = 8;
+
+    /** max time in microseconds that the oldest pending request waits for others before running */
+    uint32_t max_wait_us = 1000;
+};
+
+struct PPLNN_PUBLIC BatchingStatistics final {
+    /** number of requests finished successfully */
+    uint64_t request_count = 0;
+    /** number of batches run successfully */
+    uint64_t batch_count = 0;
+    /** number of samples of requests finished successfully */
+    uint64_t sample_count = 0;
+    /** number of requests in failed batches */
+    uint64_t failed_request_count = 0;
+    /** number of failed batches */
+    uint64_t failed_batch_count = 0;
+};
+
+/**
+   @class BatchingRunner
+   @brief queues requests from multiple threads and runs them with one `Runtime` in batches, which are made by
+   concatenating inputs of requests along dim 0. outputs are split along dim 0 and returned to each caller.
+   @note dim 0 of all inputs and outputs of the model MUST be the batch dimension. requests whose inputs differ
+   in other dims or data types are never put into the same batch.
+*/
+class PPLNN_PUBLIC BatchingRunner {
+public:
+    virtual ~BatchingRunner() {}
+
+    /**
+       @brief runs a request and blocks until it is finished. this function is thread-safe.
+       @param inputs host buffers in the same order as `Runtime::GetInputTensor()`.
+       @param input_shapes shapes of `inputs` in NDARRAY format. dim 0 is the number of samples of this request
+       and MUST be the same for all inputs.
+       @param outputs resized and filled with outputs in the same order as `Runtime::GetOutputTensor()`,
+       converted to NDARRAY format with the data types of runtime outputs.
+       @param output_shapes shapes of `outputs`. can be nullptr.
+    */
+    virtual ppl::common::RetCode Run(const std::vector<const void*>& inputs,
+                                     const std::vector<TensorShape>& input_shapes,
+                                     std::vector<std::vector<char>>* outputs,
+                                     std::vector<TensorShape>* output_shapes = nullptr) = 0;
+
+    /** @brief get statistics of requests that have been run */
+    virtual void GetStatistics(BatchingStatistics*) const = 0;
+};
+
+class PPLNN_PUBLIC BatchingRunnerFactory final {
+public:
+    /**
+       @brief creates a `BatchingRunner` running requests with `runtime`.
+       @note `runtime` MUST NOT be used by others and MUST be valid until the returned runner is destroyed.
+    */
+    static BatchingRunner* Create(Runtime* runtime, const BatchingOptions& options = BatchingOptions());
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -0,0 +1,73 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_MEMORY_STATISTICS_H_
+#define _ST_HPC_PPL_NN_RUNTIME_MEMORY_STATISTICS_H_
+
+#include "ppl/nn/common/common.h"
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+namespace ppl { namespace nn {
+
+struct PPLNN_PUBLIC KernelMemoryInfo final {
+    std::string name;
+    std::string domain;
+    std::string type;
+    /** max bytes of scratch buffers used by one execution, 0 if not available */
+    uint64_t max_scratch_bytes = 0;
+};
+
+/**
+   @brief memory used by a runtime. values of devices used by the runtime are summed up, and fields
+   that a device does not report are left 0.
+*/
+struct PPLNN_PUBLIC MemoryStatistics final {
+    /**
+       bytes of constant tensors. constants are shared by runtimes created by the same builder, and weights
+       converted and held by kernels are not included.
+    */
+    uint64_t constant_bytes = 0;
+
+    /** bytes of tensors allocated during `Run()`, including arenas of the static memory plan */
+    uint64_t activation_bytes = 0;
+    uint64_t max_activation_bytes = 0;
+
+    /** bytes of temporary buffers used by kernels */
+    uint64_t scratch_bytes = 0;
+    uint64_t max_scratch_bytes = 0;
+
+    /** activations and scratch buffers, which is the usage limited by memory budgets of devices */
+    uint64_t total_bytes = 0;
+    uint64_t max_total_bytes = 0;
+
+    /** bytes held by memory managers of devices, which may be larger than `total_bytes` because of caching */
+    uint64_t reserved_bytes = 0;
+
+    /**
+       number of allocations refused because of memory budgets. kernels may fall back to algorithms that
+       need less memory instead of failing.
+    */
+    uint64_t budget_exceeded_count = 0;
+
+    std::vector<KernelMemoryInfo> kernel_info;
+};
+
+}} // namespace ppl::nn
+
+#endif
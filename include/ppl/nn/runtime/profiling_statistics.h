@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_RUNTIME_PROFILING_STATISTICS_H_
 
 #include "ppl/nn/common/common.h"
+#include "ppl/common/retcode.h"
 #include <vector>
 #include <string>
 #include <stdint.h>
@@ -31,12 +32,51 @@ struct PPLNN_PUBLIC KernelProfilingInfo final {
     std::string type;
     uint64_t exec_microseconds;
     uint32_t exec_count;
+
+    /** latency distribution in microseconds of recent executions */
+    uint64_t p50_microseconds = 0;
+    uint64_t p99_microseconds = 0;
+    uint64_t max_microseconds = 0;
+
+    /** algorithm selected by the engine, empty if not available */
+    std::string algorithm;
+    /** input dims of the last execution. empty for inputs that are not tensors. */
+    std::vector<std::vector<int64_t>> input_dims;
+    /** estimated floating point operations of the last execution, 0 if not available */
+    uint64_t flops = 0;
+    /** bytes of inputs and outputs of the last execution */
+    uint64_t bytes = 0;
+    /** achieved GFLOP/s over all executions, 0 if flops is not available */
+    double gflops_per_second = 0;
+
+    /** iterations of all executions for kernels running subgraphs iteratively like Loop, 0 for other kernels */
+    uint64_t iteration_count = 0;
+    /** average time in microseconds spent outside of the subgraph per iteration, e.g. copying states and outputs */
+    double iteration_overhead_microseconds = 0;
+};
+
+struct PPLNN_PUBLIC KernelTraceEvent final {
+    /** index of the kernel in `ProfilingStatistics::prof_info` */
+    uint32_t kernel_idx;
+    /** index of the thread that runs this kernel */
+    uint32_t thread_idx;
+    /** relative to the time when profiling is enabled */
+    uint64_t begin_microseconds;
+    uint64_t duration_microseconds;
 };
 
 struct PPLNN_PUBLIC ProfilingStatistics final {
     std::vector<KernelProfilingInfo> prof_info;
+    /** executions in time order. the oldest ones are dropped if there are too many. */
+    std::vector<KernelTraceEvent> trace_events;
 };
 
+/**
+   @brief write `stat` to `filename` in chrome trace event format, which can be
+   viewed in chrome://tracing or perfetto.
+*/
+PPLNN_PUBLIC ppl::common::RetCode ExportChromeTrace(const ProfilingStatistics& stat, const char* filename);
+
 }} // namespace ppl::nn
 
 #endif
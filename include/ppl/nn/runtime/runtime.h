@@ -23,6 +23,7 @@
 #include "ppl/nn/common/device_context.h"
 #include "ppl/nn/runtime/tensor.h"
 #include "ppl/nn/runtime/profiling_statistics.h"
+#include "ppl/nn/runtime/memory_statistics.h"
 
 namespace ppl { namespace nn {
 
@@ -34,9 +35,57 @@ enum {
     */
     RUNTIME_CONF_SET_KERNEL_PROFILING_FLAG = 0,
 
+    /**
+       @brief args: uint32_t, one of `RUNTIME_SCHED_*`. default is `RUNTIME_SCHED_SEQUENTIAL`.
+       @note `RUNTIME_SCHED_PARALLEL` requires that devices used by this runtime can be accessed from multiple
+       threads concurrently. currently only the x86 engine satisfies this requirement, and `RC_UNSUPPORTED` is
+       returned if other engines are used.
+    */
+    RUNTIME_CONF_SET_SCHEDULING_POLICY = 1,
+
+    /**
+       @brief args: uint32_t, number of threads used by `RUNTIME_SCHED_PARALLEL`, including the caller of `Run()`.
+       0 means using `std::thread::hardware_concurrency()`. default is 0.
+       @note each kernel still runs with the openmp threads of its engine, e.g. `X86EngineOptions::thread_num`,
+       so up to `thread_num` * openmp threads may be busy at the same time. set both of them so that the product
+       does not exceed the number of cores, otherwise threads are oversubscribed and run slower.
+    */
+    RUNTIME_CONF_SET_SCHEDULING_THREAD_NUM = 2,
+
+    /**
+       @brief args: true/false. default is false.
+       allocates activations whose shapes are fixed in preprocessing stage from preallocated arenas according to
+       a static memory plan, instead of allocating them from devices in every `Run()`.
+       @note cannot be used with `RUNTIME_SCHED_PARALLEL`. tensors which need more memory than planned, e.g. after
+       inputs are reshaped, are still allocated by devices.
+    */
+    RUNTIME_CONF_SET_MEMORY_PLAN_FLAG = 3,
+
+    /**
+       @brief args: uint64_t*, total size in bytes of arenas required by the static memory plan.
+       0 means no activations are planned. this value is available before the first `Run()`.
+    */
+    RUNTIME_CONF_GET_PLANNED_MEMORY_BYTES = 4,
+
+    /**
+       @brief args: `MemoryStatistics*`. current and peak memory used by this runtime, and max scratch bytes of
+       each kernel.
+       @note memory budgets are set by device contexts, e.g. `X86_DEV_CONF_SET_MEMORY_BUDGET` of x86 devices.
+    */
+    RUNTIME_CONF_GET_MEMORY_STATISTICS = 5,
+
     RUNTIME_CONF_MAX,
 };
 
+/** @brief scheduling policies */
+enum {
+    /** runs kernels one by one in topological order */
+    RUNTIME_SCHED_SEQUENTIAL = 0,
+
+    /** runs kernels whose inputs are ready concurrently on a thread pool */
+    RUNTIME_SCHED_PARALLEL = 1,
+};
+
 /**
    @class Runtime
    @brief runs a model
@@ -32,11 +32,41 @@ void RegisterX86EngineOptions(const shared_ptr<LuaState>& lstate, const shared_p
                              },
                              [](X86EngineOptions* options, uint32_t v) -> void {
                                  options->mm_policy = v;
-                             });
+                             })
+        .DefMember<uint32_t>("dynamic_tuning_level",
+                             [](const X86EngineOptions* options) -> uint32_t {
+                                 return options->dynamic_tuning_level;
+                             },
+                             [](X86EngineOptions* options, uint32_t v) -> void {
+                                 options->dynamic_tuning_level = v;
+                             })
+        .DefMember<uint32_t>("forward_precision",
+                             [](const X86EngineOptions* options) -> uint32_t {
+                                 return options->forward_precision;
+                             },
+                             [](X86EngineOptions* options, uint32_t v) -> void {
+                                 options->forward_precision = v;
+                             })
+        .DefMember<uint32_t>("thread_num",
+                             [](const X86EngineOptions* options) -> uint32_t {
+                                 return options->thread_num;
+                             },
+                             [](X86EngineOptions* options, uint32_t v) -> void {
+                                 options->thread_num = v;
+                             })
+        .DefMember<int32_t>("numa_node_id",
+                            [](const X86EngineOptions* options) -> int32_t {
+                                return options->numa_node_id;
+                            },
+                            [](X86EngineOptions* options, int32_t v) -> void {
+                                options->numa_node_id = v;
+                            });
     lmodule->Set("X86EngineOptions", lclass);
 
     lmodule->SetInteger("X86_MM_MRU", X86_MM_MRU);
     lmodule->SetInteger("X86_MM_COMPACT", X86_MM_COMPACT);
+    lmodule->SetInteger("X86_TUNING_OFF", X86_TUNING_OFF);
+    lmodule->SetInteger("X86_TUNING_SELECT_ALGO", X86_TUNING_SELECT_ALGO);
 }
 
 }}}
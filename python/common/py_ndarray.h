@@ -25,6 +25,8 @@ namespace ppl { namespace nn { namespace python {
 
 struct PyNdArray final {
     std::vector<char> data;
+    /** data owned by others. used instead of `data` if it is not nullptr. */
+    void* external_data = nullptr;
     ppl::common::datatype_t data_type = ppl::common::DATATYPE_UNKNOWN;
     std::vector<int64_t> dims;
     std::vector<uint64_t> strides;
@@ -18,6 +18,8 @@
 #include "py_tensor.h"
 #include "../common/py_device_context.h"
 #include "ppl/nn/common/logger.h"
+#include "ppl/nn/runtime/tensor_impl.h"
+#include <cstring>
 #include <map>
 using namespace std;
 using namespace ppl::common;
@@ -39,6 +41,29 @@ static const map<string, datatype_t> g_format2datatype = {
     {"?", DATATYPE_BOOL}, //  -> unsigned char
 };
 
+/* host buffers used without copying must be aligned to this value */
+static const uint64_t g_zero_copy_alignment = 64;
+
+static bool IsHostDevice(const DeviceContext* ctx) {
+    if (!ctx) {
+        return false;
+    }
+    auto type = ctx->GetType();
+    return (strcmp(type, "x86") == 0 || strcmp(type, "arm") == 0 || strcmp(type, "riscv") == 0 ||
+            strcmp(type, "cpu") == 0);
+}
+
+static bool IsContiguous(const pybind11::buffer_info& info) {
+    pybind11::ssize_t stride = info.itemsize;
+    for (pybind11::ssize_t i = info.ndim - 1; i >= 0; --i) {
+        if (info.shape[i] > 1 && info.strides[i] != stride) {
+            return false;
+        }
+        stride *= info.shape[i];
+    }
+    return true;
+}
+
 RetCode PyTensor::ConvertFromHost(const pybind11::buffer& b) {
     pybind11::buffer_info info = b.request();
 
@@ -80,6 +105,23 @@ RetCode PyTensor::ConvertFromHost(const pybind11::buffer& b) {
     return RC_SUCCESS;
 }
 
+static void FillNdArrayShape(const TensorShape& shape, PyNdArray* arr) {
+    arr->data_type = shape.GetDataType();
+
+    auto dim_count = shape.GetRealDimCount();
+
+    arr->dims.resize(dim_count);
+    for (uint32_t i = 0; i < dim_count; ++i) {
+        arr->dims[i] = shape.GetDim(i);
+    }
+
+    arr->strides.resize(dim_count);
+    for (uint32_t i = 1; i < dim_count; ++i) {
+        arr->strides[i - 1] = shape.GetBytesFromDimesionExcludingPadding(i);
+    }
+    arr->strides[dim_count - 1] = GetSizeOfDataType(shape.GetDataType());
+}
+
 PyNdArray PyTensor::ConvertToHost() const {
     PyNdArray arr;
     if (tensor_->GetShape()->GetBytesExcludingPadding() == 0) {
@@ -96,21 +138,62 @@ PyNdArray PyTensor::ConvertToHost() const {
         return arr;
     }
 
-    arr.data_type = dst_shape.GetDataType();
+    FillNdArrayShape(dst_shape, &arr);
+    return arr;
+}
 
-    auto dim_count = dst_shape.GetRealDimCount();
+RetCode PyTensor::ShareFromHost(const pybind11::buffer& b) {
+    // `b` may be written by kernels if this tensor is an output or used as an output buffer in place
+    pybind11::buffer_info info;
+    try {
+        info = b.request(true);
+    } catch (const pybind11::error_already_set&) {
+        LOG(ERROR) << "cannot share read-only buffer with tensor[" << tensor_->GetName() << "]. copy it instead.";
+        return RC_PERMISSION_DENIED;
+    }
 
-    arr.dims.resize(dim_count);
-    for (uint32_t i = 0; i < dim_count; ++i) {
-        arr.dims[i] = dst_shape.GetDim(i);
+    auto ref = g_format2datatype.find(info.format);
+    if (ref == g_format2datatype.end()) {
+        LOG(ERROR) << "unsupported data format[\"" << info.format << "\"]";
+        return RC_UNSUPPORTED;
     }
 
-    arr.strides.resize(dim_count);
-    for (uint32_t i = 1; i < dim_count; ++i) {
-        arr.strides[i - 1] = dst_shape.GetBytesFromDimesionExcludingPadding(i);
+    auto shape = tensor_->GetShape();
+    if (!IsHostDevice(tensor_->GetDeviceContext()) || shape->GetDataFormat() != DATAFORMAT_NDARRAY ||
+        shape->GetDataType() != ref->second || !IsContiguous(info) ||
+        (uintptr_t)info.ptr % g_zero_copy_alignment != 0) {
+        LOG(DEBUG) << "cannot use host buffer as tensor[" << tensor_->GetName() << "] directly. copy it instead.";
+        // the previous buffer may be shared from host and cannot be reused
+        tensor_->FreeBuffer();
+        return ConvertFromHost(b);
+    }
+
+    vector<int64_t> dims(info.ndim);
+    for (pybind11::ssize_t i = 0; i < info.ndim; ++i) {
+        dims[i] = info.shape[i];
+    }
+    shape->Reshape(dims);
+
+    // the size is recorded so that outputs requiring more memory than `b` get a new buffer from the device instead of
+    // writing past the end of `b`.
+    static_cast<TensorImpl*>(tensor_)->SetReservedBuffer(BufferDesc(info.ptr), info.size * info.itemsize);
+    return RC_SUCCESS;
+}
+
+PyNdArray PyTensor::ShareToHost() const {
+    auto shape = tensor_->GetShape();
+    if (!IsHostDevice(tensor_->GetDeviceContext()) || shape->GetDataFormat() != DATAFORMAT_NDARRAY ||
+        shape->GetBytesIncludingPadding() != shape->GetBytesExcludingPadding() || !tensor_->GetBufferPtr()) {
+        return ConvertToHost();
+    }
+
+    PyNdArray arr;
+    if (shape->GetBytesExcludingPadding() == 0) {
+        return arr;
     }
-    arr.strides[dim_count - 1] = GetSizeOfDataType(dst_shape.GetDataType());
 
+    arr.external_data = tensor_->GetBufferPtr();
+    FillNdArrayShape(*shape, &arr);
     return arr;
 }
 
@@ -135,7 +218,9 @@ void RegisterTensor(pybind11::module* m) {
         .def("GetName", &PyTensor::GetName, pybind11::return_value_policy::reference)
         .def("GetShape", &PyTensor::GetConstShape, pybind11::return_value_policy::reference)
         .def("ConvertFromHost", &PyTensor::ConvertFromHost)
-        .def("ConvertToHost", &PyTensor::ConvertToHost, pybind11::return_value_policy::move);
+        .def("ConvertToHost", &PyTensor::ConvertToHost, pybind11::return_value_policy::move)
+        .def("ShareFromHost", &PyTensor::ShareFromHost)
+        .def("ShareToHost", &PyTensor::ShareToHost, pybind11::return_value_policy::move);
 }
 
 }}} // namespace ppl::nn::python
@@ -41,6 +41,20 @@ public:
     ppl::common::RetCode ConvertFromHost(const pybind11::buffer&);
     PyNdArray ConvertToHost() const;
 
+    /**
+       @brief uses the host buffer `b` as the buffer of this tensor without copying if possible, otherwise falls back
+       to `ConvertFromHost()`.
+       @note `b` is not retained and MUST be kept valid until it is no longer used by the runtime.
+    */
+    ppl::common::RetCode ShareFromHost(const pybind11::buffer& b);
+
+    /**
+       @brief returns an array referring to data of this tensor without copying if possible, otherwise falls back to
+       `ConvertToHost()`.
+       @note the returned array is valid until the next `Run()` or until the runtime is released.
+    */
+    PyNdArray ShareToHost() const;
+
 private:
     Tensor* tensor_;
 };
@@ -0,0 +1,112 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+# usage: PYTHONPATH=<pplnn-install-dir>/lib python3 -m unittest python/tests/py_tensor_test.py
+
+import os
+import unittest
+import numpy as np
+from pyppl import nn as pplnn
+from pyppl import common as pplcommon
+
+# input -> conv -> conv_out, gemm_input -> gemm -> gemm_out
+g_model_file = os.path.join(os.path.dirname(os.path.abspath(__file__)), "../../tests/testdata/conv_gemm.onnx")
+g_input_dims = {"input": [1, 3, 4, 4], "gemm_input": [2, 32]}
+g_zero_copy_alignment = 64
+
+def AlignedArray(dims, fill):
+    count = int(np.prod(dims))
+    buf = np.empty(count + g_zero_copy_alignment, dtype = np.float32)
+    offset = (-buf.ctypes.data % g_zero_copy_alignment) // buf.itemsize
+    arr = buf[offset : offset + count].reshape(dims)
+    arr[...] = fill
+    return arr
+
+def MakeInput(dims):
+    return ((np.arange(int(np.prod(dims))) % 7) - 3).astype(np.float32).reshape(dims)
+
+class PyTensorTest(unittest.TestCase):
+    def setUp(self):
+        self.engine = pplnn.X86EngineFactory.Create(pplnn.X86EngineOptions())
+        self.builder = pplnn.OnnxRuntimeBuilderFactory.Create()
+        self.assertEqual(pplcommon.RC_SUCCESS, self.builder.InitFromFile(g_model_file, [self.engine]))
+        self.assertEqual(pplcommon.RC_SUCCESS, self.builder.Preprocess())
+
+    def GetTensor(self, runtime, name, is_input):
+        count = runtime.GetInputCount() if is_input else runtime.GetOutputCount()
+        for i in range(count):
+            tensor = runtime.GetInputTensor(i) if is_input else runtime.GetOutputTensor(i)
+            if tensor.GetName() == name:
+                return tensor
+        self.fail("tensor[" + name + "] not found")
+
+    def RunWithCopy(self):
+        runtime = self.builder.CreateRuntime()
+        for name, dims in g_input_dims.items():
+            tensor = self.GetTensor(runtime, name, True)
+            self.assertEqual(pplcommon.RC_SUCCESS, tensor.ConvertFromHost(MakeInput(dims)))
+        self.assertEqual(pplcommon.RC_SUCCESS, runtime.Run())
+        return np.array(self.GetTensor(runtime, "gemm_out", False).ConvertToHost(), copy = True)
+
+    def test_share_inputs_and_outputs(self):
+        expected = self.RunWithCopy()
+
+        runtime = self.builder.CreateRuntime()
+        inputs = {}
+        for name, dims in g_input_dims.items():
+            inputs[name] = AlignedArray(dims, MakeInput(dims))
+            tensor = self.GetTensor(runtime, name, True)
+            self.assertEqual(pplcommon.RC_SUCCESS, tensor.ShareFromHost(inputs[name]))
+        self.assertEqual(inputs["gemm_input"].ctypes.data, self.GetTensor(runtime, "gemm_input", True).GetBufferPtr())
+
+        output = AlignedArray(expected.shape, 0)
+        output_tensor = self.GetTensor(runtime, "gemm_out", False)
+        self.assertEqual(pplcommon.RC_SUCCESS, output_tensor.ShareFromHost(output))
+        self.assertEqual(pplcommon.RC_SUCCESS, runtime.Run())
+
+        # results are written into `output` directly
+        self.assertEqual(output.ctypes.data, output_tensor.GetBufferPtr())
+        np.testing.assert_array_equal(expected, output)
+
+    def test_share_output_too_small(self):
+        expected = self.RunWithCopy()
+
+        runtime = self.builder.CreateRuntime()
+        for name, dims in g_input_dims.items():
+            tensor = self.GetTensor(runtime, name, True)
+            self.assertEqual(pplcommon.RC_SUCCESS, tensor.ConvertFromHost(MakeInput(dims)))
+
+        # the runtime allocates a new buffer instead of writing past the end of `output`
+        output = AlignedArray([1, 10], -1)
+        output_tensor = self.GetTensor(runtime, "gemm_out", False)
+        self.assertEqual(pplcommon.RC_SUCCESS, output_tensor.ShareFromHost(output))
+        self.assertEqual(pplcommon.RC_SUCCESS, runtime.Run())
+
+        self.assertNotEqual(output.ctypes.data, output_tensor.GetBufferPtr())
+        np.testing.assert_array_equal(np.full([1, 10], -1, dtype = np.float32), output)
+        np.testing.assert_array_equal(expected, np.array(output_tensor.ShareToHost(), copy = False))
+
+    def test_share_read_only(self):
+        runtime = self.builder.CreateRuntime()
+        output = AlignedArray([2, 10], 0)
+        output.flags.writeable = False
+        output_tensor = self.GetTensor(runtime, "gemm_out", False)
+        self.assertEqual(pplcommon.RC_PERMISSION_DENIED, output_tensor.ShareFromHost(output))
+        self.assertNotEqual(output.ctypes.data, output_tensor.GetBufferPtr())
+
+if __name__ == "__main__":
+    unittest.main()
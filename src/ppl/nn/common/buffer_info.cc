@@ -30,10 +30,12 @@ BufferInfo::BufferInfo(BufferInfo&& info) {
     is_buffer_owner_ = info.is_buffer_owner_;
     buffer_ = info.buffer_;
     device_ = info.device_;
+    reserved_bytes_ = info.reserved_bytes_;
 
     info.buffer_.addr = nullptr;
     info.device_ = nullptr;
     info.is_buffer_owner_ = false;
+    info.reserved_bytes_ = 0;
 }
 
 BufferInfo& BufferInfo::operator=(BufferInfo&& info) {
@@ -44,10 +46,12 @@ BufferInfo& BufferInfo::operator=(BufferInfo&& info) {
     is_buffer_owner_ = info.is_buffer_owner_;
     buffer_ = info.buffer_;
     device_ = info.device_;
+    reserved_bytes_ = info.reserved_bytes_;
 
     info.buffer_.addr = nullptr;
     info.device_ = nullptr;
     info.is_buffer_owner_ = false;
+    info.reserved_bytes_ = 0;
 
     return *this;
 }
@@ -77,6 +81,12 @@ void BufferInfo::SetBuffer(const BufferDesc& buf, Device* device, bool is_buffer
 
     buffer_ = buf;
     is_buffer_owner_ = is_buffer_owner;
+    reserved_bytes_ = 0;
+}
+
+void BufferInfo::SetReservedBuffer(const BufferDesc& buf, uint64_t bytes) {
+    SetBuffer(buf, nullptr, false);
+    reserved_bytes_ = bytes;
 }
 
 RetCode BufferInfo::ReallocBuffer(const TensorShape& shape) {
@@ -86,7 +96,11 @@ RetCode BufferInfo::ReallocBuffer(const TensorShape& shape) {
     }
 
     if (!is_buffer_owner_) {
+        if (reserved_bytes_ > 0 && buffer_.addr && shape.GetBytesIncludingPadding() <= reserved_bytes_) {
+            return RC_SUCCESS;
+        }
         buffer_.addr = nullptr;
+        reserved_bytes_ = 0;
     }
 
     auto status = device_->Realloc(shape, &buffer_);
@@ -104,6 +118,7 @@ BufferDesc BufferInfo::DetachBuffer() {
     auto ret = buffer_;
     buffer_.addr = nullptr;
     is_buffer_owner_ = false;
+    reserved_bytes_ = 0;
     return ret;
 }
 
@@ -114,6 +129,7 @@ void BufferInfo::FreeBuffer() {
     }
 
     buffer_.addr = nullptr;
+    reserved_bytes_ = 0;
 }
 
 }} // namespace ppl::nn
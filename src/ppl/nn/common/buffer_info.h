@@ -24,7 +24,7 @@ namespace ppl { namespace nn {
 
 class BufferInfo final {
 public:
-    BufferInfo() : is_buffer_owner_(false), device_(nullptr) {}
+    BufferInfo() : is_buffer_owner_(false), device_(nullptr), reserved_bytes_(0) {}
     BufferInfo(BufferInfo&&);
     BufferInfo& operator=(BufferInfo&&);
     ~BufferInfo();
@@ -50,6 +50,18 @@ public:
     */
     void SetBuffer(const BufferDesc& buf, Device* device = nullptr, bool is_buffer_owner = false);
 
+    /**
+       @brief set a buffer `buf` of `bytes` bytes which is NOT owned by this tensor as this tensor's buffer.
+       `ReallocBuffer()` keeps using `buf` as long as the required size does not exceed `bytes`.
+       @note `buf` is usually a part of a preallocated arena, and its lifetime is managed by the caller.
+    */
+    void SetReservedBuffer(const BufferDesc& buf, uint64_t bytes);
+
+    /** @brief whether the current buffer is set by `SetReservedBuffer()` */
+    bool HasReservedBuffer() const {
+        return (reserved_bytes_ > 0 && buffer_.addr);
+    }
+
     /** @brief returns buffer_ to caller and reset buffer_. */
     BufferDesc DetachBuffer();
 
@@ -75,6 +87,9 @@ private:
     BufferDesc buffer_;
     Device* device_;
 
+    /** size of the reserved buffer set by `SetReservedBuffer()`. 0 means no reserved buffer. */
+    uint64_t reserved_bytes_;
+
 private:
     BufferInfo(const BufferInfo&) = delete;
     BufferInfo& operator=(const BufferInfo&) = delete;
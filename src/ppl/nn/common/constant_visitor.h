@@ -29,6 +29,13 @@ public:
     virtual ~ConstantVisitor() {}
     /** @param alignment each constant should align to. MUST be power of 2 */
     virtual uint64_t CalcTotalBytes(uint64_t alignment = 0) const = 0;
+    /**
+       @brief tells whether data passed to callbacks of `ForEach()` is kept valid and unchanged until the
+       corresponding `RuntimeGraphInfo` is released, so that engines can use it without copying.
+    */
+    virtual bool IsDataPersistent() const {
+        return false;
+    }
     virtual ppl::common::RetCode ForEach(const std::function<ppl::common::RetCode(const ir::Edge*, const void*, uint64_t,
                                                                                   const TensorShape&)>&) const = 0;
 };
@@ -25,6 +25,7 @@
 #include "ppl/nn/common/device_context.h"
 #include "ppl/nn/common/data_converter.h"
 #include "ppl/nn/common/types.h"
+#include "ppl/nn/runtime/memory_statistics.h"
 
 namespace ppl { namespace nn {
 
@@ -95,6 +96,14 @@ public:
 
     /** @brief get DataConverter that can process data on this device */
     virtual const DataConverter* GetDataConverter() const = 0;
+
+    /**
+       @brief get usage of buffers allocated by this device. only device-level fields of `stat` are filled.
+       @return RC_UNSUPPORTED if this device does not keep track of its memory usage.
+    */
+    virtual ppl::common::RetCode GetMemoryStatistics(MemoryStatistics* stat) const {
+        return ppl::common::RC_UNSUPPORTED;
+    }
 };
 
 }} // namespace ppl::nn
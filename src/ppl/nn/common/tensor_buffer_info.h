@@ -46,6 +46,14 @@ public:
         return info_.SetBuffer(buf, device, is_buffer_owner);
     }
 
+    void SetReservedBuffer(const BufferDesc& buf, uint64_t bytes) {
+        info_.SetReservedBuffer(buf, bytes);
+    }
+
+    bool HasReservedBuffer() const {
+        return info_.HasReservedBuffer();
+    }
+
     BufferDesc DetachBuffer() {
         return info_.DetachBuffer();
     }
@@ -21,6 +21,8 @@
 #include "ppl/nn/engines/utils.h"
 #include "ppl/nn/utils/generic_cpu_device.h"
 #include "ppl/nn/common/logger.h"
+#include <string.h>
+#include <algorithm>
 using namespace std;
 using namespace ppl::common;
 
@@ -30,7 +32,7 @@ template <typename T>
 void EmptyDeleter(T*) {}
 
 RetCode LoopKernel::SetExecutionInfo(const shared_ptr<ir::GraphTopo>& topo, const RuntimeGraphInfo* info,
-                                     const RuntimeAuxInfo* aux_info, LoopConcatOutputFunc func) {
+                                     const RuntimeAuxInfo* aux_info) {
     auto status = subgraph_.Init(topo, shared_ptr<const RuntimeGraphInfo>(info, EmptyDeleter<const RuntimeGraphInfo>),
                                  shared_ptr<const RuntimeAuxInfo>(aux_info, EmptyDeleter<const RuntimeAuxInfo>));
     if (status != RC_SUCCESS) {
@@ -38,7 +40,6 @@ RetCode LoopKernel::SetExecutionInfo(const shared_ptr<ir::GraphTopo>& topo, cons
         return status;
     }
 
-    concat_output_func_ = func;
     return RC_SUCCESS;
 }
 
@@ -64,49 +65,150 @@ static inline RetCode GetKeepGoing(const KernelExecContext& ctx, bool* keep_goin
     return RC_SUCCESS;
 }
 
+/*
+  copies data of `src` to `dst` which has the same shape as `src`. devices of the same type can access buffers of each
+  other directly, so that data is not copied through host memory.
+*/
+static RetCode CopyTensorData(const TensorImpl& src, TensorImpl* dst, Device* tmp_cpu_device) {
+    auto src_device = src.GetDevice();
+    auto dst_device = dst->GetDevice();
+    if (src_device == dst_device || strcmp(src_device->GetType(), dst_device->GetType()) != 0) {
+        return utils::CopyTensorBuffer(src, dst, tmp_cpu_device);
+    }
+
+    auto status = dst->ReallocBuffer();
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "ReallocBuffer for tensor[" << dst->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    return dst_device->Copy(&dst->GetBufferDesc(), src.GetBufferDesc(), *src.GetShape());
+}
+
+/** scan outputs of all iterations are appended to one buffer which is handed over to the loop's output at last */
+struct ScanOutputBuffer final {
+    ~ScanOutputBuffer() {
+        if (buffer.addr) {
+            device->Free(&buffer);
+        }
+    }
+
+    TensorShape shape; // shape of one iteration
+    Device* device = nullptr; // device of the loop's output
+    BufferDesc buffer;
+    uint64_t bytes = 0; // bytes used
+    uint64_t capacity = 0;
+    int64_t count = 0; // number of iterations appended
+};
+
 struct LoopInfo final {
     LoopInfo(const KernelExecContext& ctx) {
         loop_carried_dep_num = ctx.GetInputCount() - 2; // N
         scan_output_num = ctx.GetOutputCount() - loop_carried_dep_num; // K
-        intermediate_outputs.resize(scan_output_num);
+        scan_outputs.resize(scan_output_num);
     }
 
     uint32_t loop_carried_dep_num;
     uint32_t scan_output_num;
-    vector<vector<TensorBufferInfo>> intermediate_outputs;
+    vector<ScanOutputBuffer> scan_outputs;
 };
 
-static RetCode SaveSubgraphOutputs(RuntimeImpl* subgraph, LoopInfo* info) {
-    for (uint32_t i = 0; i < info->scan_output_num; ++i) {
-        auto scan_output = subgraph->GetOutputTensorImpl(info->loop_carried_dep_num + i + 1); // +1 for skipping `cond`
+// grows `scan` geometrically to hold at least `bytes` bytes
+static RetCode ReserveScanOutputBuffer(uint64_t bytes, ScanOutputBuffer* scan) {
+    if (bytes <= scan->capacity) {
+        return RC_SUCCESS;
+    }
 
-        TensorBufferInfo output_buffer;
-        if (scan_output->IsBufferOwner()) {
-            output_buffer.Reshape(*scan_output->GetShape());
-            output_buffer.SetBuffer(scan_output->GetBufferDesc(), scan_output->GetDevice(), true);
-            scan_output->DetachBuffer();
-        } else {
-            auto device = scan_output->GetDevice();
+    const uint64_t capacity = std::max(bytes, scan->capacity * 2);
+
+    BufferDesc new_buffer;
+    auto status = scan->device->Realloc(capacity, &new_buffer);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "alloc [" << capacity << "] bytes for scan outputs failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    if (scan->bytes > 0) {
+        status = scan->device->Copy(&new_buffer, scan->buffer, scan->bytes);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "copy scan outputs failed: " << GetRetCodeStr(status);
+            scan->device->Free(&new_buffer);
+            return status;
+        }
+    }
+
+    if (scan->buffer.addr) {
+        scan->device->Free(&scan->buffer);
+    }
+    scan->buffer = new_buffer;
+    scan->capacity = capacity;
 
-            output_buffer.SetDevice(scan_output->GetDevice());
-            output_buffer.Reshape(*scan_output->GetShape());
-            auto status = output_buffer.ReallocBuffer();
+    return RC_SUCCESS;
+}
+
+/*
+  buffers of scan outputs reserved before the first iteration are limited to this size, because the loop may still
+  stop early by `cond` of the body. they grow geometrically beyond it.
+*/
+static const uint64_t g_max_reserved_scan_output_bytes = 16 * 1024 * 1024;
+
+/*
+  appends scan outputs of the current iteration to buffers of the loop's outputs. buffers are allocated for
+  `reserved_trip_count` iterations at first, up to `g_max_reserved_scan_output_bytes` bytes.
+*/
+static RetCode AppendScanOutputs(const RuntimeImpl& subgraph, const KernelExecContext& ctx,
+                                 int64_t reserved_trip_count, vector<char>* tmp_host_buffer, LoopInfo* info) {
+    for (uint32_t i = 0; i < info->scan_output_num; ++i) {
+        auto src = subgraph.GetOutputTensorImpl(info->loop_carried_dep_num + i + 1); // +1 for skipping `cond`
+        auto& src_shape = *src->GetShape();
+        const uint64_t bytes = src_shape.GetBytesIncludingPadding();
+
+        auto scan = &info->scan_outputs[i];
+        if (scan->count == 0) {
+            scan->shape = src_shape;
+            scan->device = ctx.GetOutput<TensorImpl>(info->loop_carried_dep_num + i)->GetDevice();
+            if (bytes > 0 && reserved_trip_count > 1) {
+                const uint64_t max_reserved_count = std::max<uint64_t>(g_max_reserved_scan_output_bytes / bytes, 1);
+                const uint64_t reserved_count = std::min((uint64_t)reserved_trip_count, max_reserved_count);
+                auto status = ReserveScanOutputBuffer(bytes * reserved_count, scan);
+                if (status != RC_SUCCESS) {
+                    return status;
+                }
+            }
+        } else if (bytes != scan->shape.GetBytesIncludingPadding()) {
+            LOG(ERROR) << "size of scan output[" << src->GetName() << "] changes from ["
+                       << scan->shape.GetBytesIncludingPadding() << "] to [" << bytes << "] bytes.";
+            return RC_INVALID_VALUE;
+        }
+
+        if (bytes > 0) {
+            auto status = ReserveScanOutputBuffer(scan->bytes + bytes, scan);
             if (status != RC_SUCCESS) {
-                LOG(ERROR) << "alloc buffer for tensor[" << scan_output->GetName()
-                           << "] failed: " << GetRetCodeStr(status);
                 return status;
             }
 
-            status =
-                device->Copy(&output_buffer.GetBufferDesc(), scan_output->GetBufferDesc(), *scan_output->GetShape());
+            BufferDesc dst_cursor = scan->buffer;
+            dst_cursor.addr = (char*)dst_cursor.addr + scan->bytes;
+
+            auto src_device = src->GetDevice();
+            if (src_device == scan->device || strcmp(src_device->GetType(), scan->device->GetType()) == 0) {
+                status = scan->device->Copy(&dst_cursor, src->GetBufferDesc(), bytes);
+            } else {
+                tmp_host_buffer->resize(bytes);
+                status = src_device->CopyToHost(tmp_host_buffer->data(), src->GetBufferDesc(), bytes);
+                if (status == RC_SUCCESS) {
+                    status = scan->device->CopyFromHost(&dst_cursor, tmp_host_buffer->data(), bytes);
+                }
+            }
             if (status != RC_SUCCESS) {
-                LOG(ERROR) << "copy data from tensor[" << scan_output->GetName()
-                           << "] failed: " << GetRetCodeStr(status);
+                LOG(ERROR) << "copy data from tensor[" << src->GetName() << "] failed: " << GetRetCodeStr(status);
                 return status;
             }
+
+            scan->bytes += bytes;
         }
 
-        info->intermediate_outputs[i].emplace_back(std::move(output_buffer));
+        ++scan->count;
     }
 
     return RC_SUCCESS;
@@ -135,7 +237,7 @@ static RetCode UpdateSubgraphInputs(int64_t trip_count, RuntimeImpl* subgraph,
         if (dst->GetDevice() == src->GetDevice()) {
             dst->TransferBufferFrom(src);
         } else {
-            auto status = utils::CopyTensorBuffer(*src, dst, tmp_cpu_device);
+            auto status = CopyTensorData(*src, dst, tmp_cpu_device);
             if (status != RC_SUCCESS) {
                 LOG(ERROR) << "copy data from tensor[" << src->GetName() << "] to tensor[" << dst->GetName()
                            << "] failed: " << GetRetCodeStr(status);
@@ -191,7 +293,7 @@ static RetCode InitSubgraphInputs(const KernelExecContext& ctx, bool keep_going,
         if (dst->GetDevice() == src->GetDevice()) {
             dst->SetBuffer(src->GetBufferDesc());
         } else {
-            status = utils::CopyTensorBuffer(*src, dst, tmp_cpu_device);
+            status = CopyTensorData(*src, dst, tmp_cpu_device);
             if (status != RC_SUCCESS) {
                 LOG(ERROR) << "copy tensor from [" << src->GetName() << "] to [" << dst->GetName()
                            << "] failed: " << GetRetCodeStr(status);
@@ -214,7 +316,7 @@ static RetCode InitSubgraphInputs(const KernelExecContext& ctx, bool keep_going,
             dst->SetBuffer(src->GetBufferDesc());
         } else {
             // srcs are already synchronized by SyncAllInputs()
-            status = utils::CopyTensorBuffer(*src, dst, tmp_cpu_device);
+            status = CopyTensorData(*src, dst, tmp_cpu_device);
             if (status != RC_SUCCESS) {
                 LOG(ERROR) << "copy tensor from [" << src->GetName() << "] to [" << dst->GetName()
                            << "] failed: " << GetRetCodeStr(status);
@@ -267,18 +369,22 @@ static RetCode SetOutputsFromInputs(const LoopInfo& info, const string& loop_ker
     return RC_SUCCESS;
 }
 
-static RetCode SetOutputsFromSubgraph(const LoopInfo& info, Device* tmp_cpu_device,
-                                      LoopConcatOutputFunc concat_output_func, RuntimeImpl* subgraph,
+static RetCode SetOutputsFromSubgraph(Device* tmp_cpu_device, RuntimeImpl* subgraph, LoopInfo* info,
                                       KernelExecContext* ctx) {
-    // copy loop carried deps from subgraph's output
-    for (uint32_t i = 0; i < info.loop_carried_dep_num; ++i) {
+    // move loop carried deps from subgraph's output
+    for (uint32_t i = 0; i < info->loop_carried_dep_num; ++i) {
         auto src = subgraph->GetOutputTensorImpl(i + 1);
         auto dst = ctx->GetOutput<TensorImpl>(i);
 
         *dst->GetShape() = *src->GetShape();
 
+        if (dst->GetDevice() == src->GetDevice() && src->IsBufferOwner()) {
+            dst->TransferBufferFrom(src);
+            continue;
+        }
+
         // srcs are already synchronized by subgraph->Sync()
-        auto status = utils::CopyTensorBuffer(*src, dst, tmp_cpu_device);
+        auto status = CopyTensorData(*src, dst, tmp_cpu_device);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "copy from tensor[" << src->GetName() << "] to tensor[" << dst->GetName()
                        << "] failed: " << GetRetCodeStr(status);
@@ -286,14 +392,14 @@ static RetCode SetOutputsFromSubgraph(const LoopInfo& info, Device* tmp_cpu_devi
         }
     }
 
-    for (uint32_t i = info.loop_carried_dep_num; i < ctx->GetOutputCount(); ++i) {
-        auto dst = ctx->GetOutput<TensorImpl>(i);
-
-        auto& outputs = info.intermediate_outputs[i];
-        auto& output_shape = *outputs[i].GetShape();
+    // hand buffers of scan outputs over to outputs
+    for (uint32_t i = 0; i < info->scan_output_num; ++i) {
+        auto dst = ctx->GetOutput<TensorImpl>(info->loop_carried_dep_num + i);
+        auto scan = &info->scan_outputs[i];
+        auto& output_shape = scan->shape;
 
         vector<int64_t> dims(1 + output_shape.GetDimCount());
-        dims[0] = outputs.size();
+        dims[0] = scan->count;
         for (uint32_t j = 0; j < output_shape.GetDimCount(); ++j) {
             dims[j + 1] = output_shape.GetDim(j);
         }
@@ -303,15 +409,15 @@ static RetCode SetOutputsFromSubgraph(const LoopInfo& info, Device* tmp_cpu_devi
         dst_shape->SetDataFormat(output_shape.GetDataFormat());
         dst_shape->Reshape(dims.data(), dims.size());
 
-        auto status = dst->ReallocBuffer();
-        if (status != RC_SUCCESS) {
-            LOG(ERROR) << "ReallocBuffer for tensor[" << dst->GetName() << "] failed: " << GetRetCodeStr(status);
-            return status;
-        }
-
-        status = concat_output_func(outputs, &dst->GetBufferDesc());
-        if (status != RC_SUCCESS) {
-            return status;
+        if (scan->buffer.addr) {
+            dst->SetBuffer(scan->buffer, scan->device, true);
+            scan->buffer.addr = nullptr;
+        } else {
+            auto status = dst->ReallocBuffer();
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "ReallocBuffer for tensor[" << dst->GetName() << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
         }
     }
 
@@ -321,6 +427,9 @@ static RetCode SetOutputsFromSubgraph(const LoopInfo& info, Device* tmp_cpu_devi
 static RetCode SyncAllInputs(KernelExecContext* ctx) {
     for (uint32_t i = 0; i < ctx->GetInputCount(); ++i) {
         auto e = ctx->GetInput<EdgeObject>(i);
+        if (!e) { // optional inputs `M` and `cond`
+            continue;
+        }
         auto barrier = e->GetBarrier();
         if (barrier) {
             auto status = barrier->Sync();
@@ -347,6 +456,26 @@ static RetCode SyncAllInputs(KernelExecContext* ctx) {
 }
 
 RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    iteration_count_ = 0;
+    subgraph_microseconds_ = 0;
+    auto begin_ts = std::chrono::steady_clock::now();
+#endif
+
+    auto status = DoLoop(ctx);
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    auto end_ts = std::chrono::steady_clock::now();
+    const uint64_t total_microseconds =
+        std::chrono::duration_cast<std::chrono::microseconds>(end_ts - begin_ts).count();
+    overhead_microseconds_ =
+        (total_microseconds > subgraph_microseconds_) ? total_microseconds - subgraph_microseconds_ : 0;
+#endif
+
+    return status;
+}
+
+RetCode LoopKernel::DoLoop(KernelExecContext* ctx) {
     auto status = SyncAllInputs(ctx);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "sync inputs of loop kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
@@ -369,12 +498,17 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
 
     const int64_t max_trip_count = GetMaxTripCount(*ctx);
 
+    // buffers of scan outputs can be allocated at once if `cond` is not given, though the body may still stop early
+    const int64_t reserved_trip_count =
+        (max_trip_count != INT64_MAX && !ctx->GetInput<TensorImpl>(1)) ? max_trip_count : 1;
+
     status = InitSubgraphInputs(*ctx, keep_going, &tmp_cpu_device, &subgraph_);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "InitSubgraphInputs of loop kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
         return status;
     }
 
+    vector<char> tmp_host_buffer;
     int64_t trip_count = 0;
     while (trip_count < max_trip_count && keep_going) {
         if (trip_count != 0) {
@@ -383,18 +517,22 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
                 LOG(ERROR) << "UpdateSubgraphInputs failed: " << GetRetCodeStr(status);
                 return status;
             }
-            status = SaveSubgraphOutputs(&subgraph_, &loop_info);
-            if (status != RC_SUCCESS) {
-                LOG(ERROR) << "SaveSubgraphOutputs failed: " << GetRetCodeStr(status);
-                return status;
-            }
         }
 
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+        auto run_begin_ts = std::chrono::steady_clock::now();
+#endif
         status = subgraph_.Run();
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "loop kernel[" << GetName() << "] Run() failed: " << GetRetCodeStr(status);
             return status;
         }
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+        auto run_end_ts = std::chrono::steady_clock::now();
+        subgraph_microseconds_ +=
+            std::chrono::duration_cast<std::chrono::microseconds>(run_end_ts - run_begin_ts).count();
+        ++iteration_count_;
+#endif
 
         ++trip_count;
         status = subgraph_.GetOutputTensorImpl(0)->CopyToHost(&keep_going);
@@ -402,6 +540,12 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
             LOG(ERROR) << "set `keep_going` failed: " << GetRetCodeStr(status);
             return status;
         }
+
+        status = AppendScanOutputs(subgraph_, *ctx, reserved_trip_count, &tmp_host_buffer, &loop_info);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "AppendScanOutputs of loop kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
     }
 
     if (trip_count == 0) {
@@ -411,8 +555,7 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
             return status;
         }
     } else {
-        SaveSubgraphOutputs(&subgraph_, &loop_info);
-        status = SetOutputsFromSubgraph(loop_info, &tmp_cpu_device, concat_output_func_, &subgraph_, ctx);
+        status = SetOutputsFromSubgraph(&tmp_cpu_device, &subgraph_, &loop_info, ctx);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "SetOutputsFromSubgraph of loop kernel[" << GetName()
                        << "] failed: " << GetRetCodeStr(status);
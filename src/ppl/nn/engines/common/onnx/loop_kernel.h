@@ -23,20 +23,34 @@
 
 namespace ppl { namespace nn { namespace common {
 
-typedef ppl::common::RetCode (*LoopConcatOutputFunc)(const std::vector<TensorBufferInfo>&, BufferDesc*);
-
 class LoopKernel final : public CommonKernelImpl {
 public:
     LoopKernel(const ir::Node* node) : CommonKernelImpl(node) {}
     ppl::common::RetCode SetExecutionInfo(const std::shared_ptr<ir::GraphTopo>&, const RuntimeGraphInfo*,
-                                          const RuntimeAuxInfo*, LoopConcatOutputFunc func);
+                                          const RuntimeAuxInfo*);
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    void GetIterationInfo(uint64_t* iteration_count, uint64_t* overhead_microseconds) const override {
+        *iteration_count = iteration_count_;
+        *overhead_microseconds = overhead_microseconds_;
+    }
+#endif
 
 protected:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
 
+private:
+    ppl::common::RetCode DoLoop(KernelExecContext*);
+
 private:
     RuntimeImpl subgraph_;
-    LoopConcatOutputFunc concat_output_func_;
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    // of the last execution
+    uint64_t iteration_count_ = 0;
+    uint64_t overhead_microseconds_ = 0; // time spent outside of the subgraph
+    uint64_t subgraph_microseconds_ = 0;
+#endif
 };
 
 }}} // namespace ppl::nn::common
@@ -33,7 +33,7 @@ class LoopOp final {
 public:
     LoopOp(const ir::Node* node) : node_(node) {}
     ~LoopOp();
-    ppl::common::RetCode Init(const utils::SharedResource*, LoopParam*, LoopConcatOutputFunc);
+    ppl::common::RetCode Init(const utils::SharedResource*, LoopParam*);
     KernelImpl* CreateKernelImpl() const;
 
 private:
@@ -41,7 +41,6 @@ private:
     std::shared_ptr<ir::GraphTopo> topo_;
     RuntimeGraphInfo graph_info_;
     RuntimeAuxInfo aux_info_;
-    LoopConcatOutputFunc concat_output_func_;
     std::vector<std::unique_ptr<EngineImpl>> engines_;
 };
 
@@ -46,7 +46,14 @@ static inline ppl::common::RetCode CopyTensorBuffer(const TensorImpl& src, Tenso
 ppl::common::RetCode LoadConstants(const ir::Graph&, Device*, std::map<edgeid_t, RuntimeConstantInfo>*,
                                    const std::set<edgeid_t>* = nullptr);
 
-ppl::common::RetCode LoadConstants(const ConstantVisitor&, Device*, std::map<edgeid_t, BufferInfo>*);
+/**
+   @brief loads constants visited by `visitor` into buffers allocated by `dev`.
+   @param inplace_alignment if it is not 0, persistent data(refer to `ConstantVisitor::IsDataPersistent()`) whose
+   address is aligned to `inplace_alignment` is used directly without being copied. MUST be 0 unless `dev`
+   accesses host memory and copies data from host as is.
+*/
+ppl::common::RetCode LoadConstants(const ConstantVisitor& visitor, Device* dev, std::map<edgeid_t, BufferInfo>*,
+                                   uint64_t inplace_alignment = 0);
 
 ppl::common::RetCode GenericLoadConstant(const void* data, uint64_t size, const TensorShape& shape, Device* device,
                                          RuntimeConstantInfo* info, bool omit_data = false);
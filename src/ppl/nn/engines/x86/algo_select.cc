@@ -0,0 +1,138 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/algo_select.h"
+#include "ppl/nn/common/logger.h"
+#include "rapidjson/document.h"
+#include "rapidjson/error/error.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include <fstream>
+#include <sstream>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+static RetCode ParseAlgoSelect(const rapidjson::Value& v, AlgoSelect* algo) {
+    if (!v.IsObject()) {
+        LOG(ERROR) << "value is not an object.";
+        return RC_INVALID_VALUE;
+    }
+
+    uint32_t found_fields = 0;
+    for (auto it = v.MemberBegin(); it != v.MemberEnd(); ++it) {
+        const string key(it->name.GetString(), it->name.GetStringLength());
+        if (!it->value.IsUint()) {
+            LOG(ERROR) << "value of field[" << key << "] is not an unsigned integer.";
+            return RC_INVALID_VALUE;
+        }
+
+        if (key == "algo_type") {
+            algo->algo_type = it->value.GetUint();
+        } else if (key == "isa") {
+            algo->isa = it->value.GetUint();
+        } else if (key == "input_format") {
+            algo->input_format = it->value.GetUint();
+        } else if (key == "output_format") {
+            algo->output_format = it->value.GetUint();
+        } else {
+            LOG(ERROR) << "unknown field[" << key << "].";
+            return RC_INVALID_VALUE;
+        }
+        ++found_fields;
+    }
+
+    if (found_fields != 4) {
+        LOG(ERROR) << "incomplete algorithm info.";
+        return RC_INVALID_VALUE;
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode ImportAlgoSelects(const char* fname, AlgoSelectMap* algos) {
+    ifstream ifile(fname, ios_base::in);
+    if (!ifile.is_open()) {
+        LOG(ERROR) << "open file[" << fname << "] failed.";
+        return RC_NOT_FOUND;
+    }
+
+    stringstream ss;
+    ss << ifile.rdbuf();
+    const string content = ss.str();
+    if (content.empty()) {
+        LOG(WARNING) << "empty algorithm file[" << fname << "]. do nothing.";
+        return RC_SUCCESS;
+    }
+
+    rapidjson::Document d;
+    d.Parse(content.c_str());
+    if (d.HasParseError()) {
+        LOG(ERROR) << "parse algorithm file failed: position[" << d.GetErrorOffset() << "], code["
+                   << d.GetParseError() << "]";
+        return RC_INVALID_VALUE;
+    }
+    if (!d.IsObject()) {
+        LOG(ERROR) << "algorithm file content is not an object.";
+        return RC_INVALID_VALUE;
+    }
+
+    for (auto it = d.MemberBegin(); it != d.MemberEnd(); ++it) {
+        const string key(it->name.GetString(), it->name.GetStringLength());
+        AlgoSelect algo;
+        auto status = ParseAlgoSelect(it->value, &algo);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "parse algorithm of [" << key << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+        (*algos)[key] = algo;
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode ExportAlgoSelects(const AlgoSelectMap& algos, const char* fname) {
+    rapidjson::Document d;
+    d.SetObject();
+    auto& allocator = d.GetAllocator();
+
+    for (auto it = algos.begin(); it != algos.end(); ++it) {
+        rapidjson::Value object(rapidjson::kObjectType);
+        object.AddMember("algo_type", it->second.algo_type, allocator);
+        object.AddMember("isa", (uint32_t)it->second.isa, allocator);
+        object.AddMember("input_format", (uint32_t)it->second.input_format, allocator);
+        object.AddMember("output_format", (uint32_t)it->second.output_format, allocator);
+
+        rapidjson::Value key(it->first.c_str(), it->first.size(), allocator);
+        d.AddMember(key, object, allocator);
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    d.Accept(writer);
+
+    ofstream ofile(fname, ios_base::out);
+    if (!ofile.is_open()) {
+        LOG(ERROR) << "open file[" << fname << "] failed.";
+        return RC_OTHER_ERROR;
+    }
+    ofile << buffer.GetString();
+    return RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::x86
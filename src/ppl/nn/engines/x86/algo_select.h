@@ -0,0 +1,48 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_ALGO_SELECT_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_ALGO_SELECT_H_
+
+#include "ppl/common/retcode.h"
+#include "ppl/common/types.h"
+#include "ppl/common/sys.h"
+#include <stdint.h>
+#include <string>
+#include <map>
+
+namespace ppl { namespace nn { namespace x86 {
+
+/** @brief algorithm selected for an op by dynamic tuning */
+struct AlgoSelect final {
+    uint32_t algo_type;
+    ppl::common::isa_t isa;
+    ppl::common::dataformat_t input_format;
+    ppl::common::dataformat_t output_format;
+};
+
+/** @brief selected algorithms keyed by op type, params and input shapes */
+typedef std::map<std::string, AlgoSelect> AlgoSelectMap;
+
+/** @brief merges algorithms in json file `fname` into `algos` */
+ppl::common::RetCode ImportAlgoSelects(const char* fname, AlgoSelectMap* algos);
+
+ppl::common::RetCode ExportAlgoSelects(const AlgoSelectMap& algos, const char* fname);
+
+}}} // namespace ppl::nn::x86
+
+#endif
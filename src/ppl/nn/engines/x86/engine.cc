@@ -22,7 +22,9 @@
 #include "ppl/nn/engines/x86/optimizer/opt_kernel_creator_manager.h"
 #include "ppl/nn/engines/x86/optimizer/opt_graph.h"
 #include "ppl/nn/engines/x86/engine_factory.h"
+#include "ppl/nn/engines/x86/pmx_data.h"
 #include "ppl/nn/engines/utils.h"
+#include "ppl/nn/quantization/quant_param_parser.h"
 #include "ppl/nn/common/logger.h"
 #include "ppl/kernel/x86/common/simd_tools.h"
 #include "ppl/kernel/x86/common/general_include.h"
@@ -43,11 +45,60 @@ X86Engine::X86Engine() : EngineImpl("x86"), device_(X86_DEFAULT_ALIGNMENT, ppl::
 
 RetCode X86Engine::Init(const X86EngineOptions& options) {
     options_ = options;
+
+    if (options_.forward_precision != DATATYPE_FLOAT32 && options_.forward_precision != DATATYPE_BFLOAT16) {
+        LOG(ERROR) << "x86 engine only supports fp32 & bf16 forward precision.";
+        return RC_INVALID_VALUE;
+    }
+#ifndef PPL_USE_X86_AVX512BF16
+    if (options_.forward_precision == DATATYPE_BFLOAT16) {
+        LOG(WARNING) << "current build does not support bf16, fp32 kernels will be used.";
+    }
+#endif
+
+    if (options_.numa_node_id >= 0 && !IsNumaNodeAvailable(options_.numa_node_id)) {
+        LOG(WARNING) << "engine will not bind to numa node[" << options_.numa_node_id << "].";
+        options_.numa_node_id = -1;
+    }
+    device_.SetNumaNode(options_.numa_node_id);
+
+    return InitThreadConfig(vector<int32_t>());
+}
+
+RetCode X86Engine::InitThreadConfig(const vector<int32_t>& cores) {
+    auto config = make_shared<ThreadConfig>();
+    config->thread_num = options_.thread_num;
+    config->numa_node_id = options_.numa_node_id;
+
+    if (!cores.empty()) {
+        config->cores = cores;
+    } else if (options_.numa_node_id >= 0) {
+        auto status = GetNumaNodeCores(options_.numa_node_id, &config->cores);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "get cores of numa node[" << options_.numa_node_id << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    if (!config->cores.empty()) {
+        if (config->thread_num == 0) {
+            config->thread_num = config->cores.size();
+        } else if (config->thread_num > config->cores.size()) {
+            LOG(ERROR) << "thread num[" << config->thread_num << "] > number of bound cores[" << config->cores.size()
+                       << "]";
+            return RC_INVALID_VALUE;
+        }
+    }
+
+    // a default config is kept too, so that runtimes of this engine do not inherit the thread num and core binding
+    // applied by other engines on the same thread.
+    thread_config_ = config;
+    device_.SetThreadConfig(thread_config_);
     return RC_SUCCESS;
 }
 
 EngineContext* X86Engine::CreateEngineContext() {
-    return new X86EngineContext(device_.GetISA(), options_.mm_policy);
+    return new X86EngineContext(device_.GetISA(), options_.mm_policy, thread_config_);
 }
 
 bool X86Engine::Supports(const ir::Node* node) const {
@@ -56,6 +107,11 @@ bool X86Engine::Supports(const ir::Node* node) const {
 }
 
 RetCode X86Engine::DoOptimize(const utils::SharedResource* resource, ir::Graph* graph, RuntimePartitionInfo* info) {
+    // dynamic tuning measures kernels with the same threads as runtimes
+    if (thread_config_) {
+        ApplyThreadConfig(*thread_config_);
+    }
+
     OptGraph opt_graph;
     auto status = opt_graph.Init(resource, graph, info);
     if (status != RC_SUCCESS) {
@@ -63,12 +119,20 @@ RetCode X86Engine::DoOptimize(const utils::SharedResource* resource, ir::Graph*
         return status;
     }
 
-    status = opt_graph.DoOptimize(&device_);
+    status = opt_graph.DoOptimize(options_, &quant_info_, &algos_, &device_);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "OptGraph DoOptimize failed: " << GetRetCodeStr(status);
         return status;
     }
 
+    if (!export_algo_file_.empty()) {
+        status = ExportAlgoSelects(algos_, export_algo_file_.c_str());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "export algorithms to [" << export_algo_file_ << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
     return RC_SUCCESS;
 }
 
@@ -133,12 +197,19 @@ RetCode X86Engine::ProcessGraph(const utils::SharedResource* resource, ir::Graph
 }
 
 EngineImpl* X86Engine::Create() {
-    return static_cast<EngineImpl*>(X86EngineFactory::Create(options_));
+    auto engine = static_cast<X86Engine*>(X86EngineFactory::Create(options_));
+    if (engine) {
+        // cores set by X86_CONF_SET_CORE_BINDING are not in options
+        engine->thread_config_ = thread_config_;
+        engine->device_.SetThreadConfig(thread_config_);
+    }
+    return engine;
 }
 
 #ifdef PPLNN_ENABLE_PMX_MODEL
 RetCode X86Engine::LoadConstants(const ConstantVisitor& visitor, map<edgeid_t, BufferInfo>* eid2info) {
-    return utils::LoadConstants(visitor, &device_, eid2info);
+    // constants in mmapped pmx models are used directly if they are aligned
+    return utils::LoadConstants(visitor, &device_, eid2info, X86_DEFAULT_ALIGNMENT);
 }
 
 OptKernel* X86Engine::CreateOptKernel(const ir::Node* node) const {
@@ -155,9 +226,50 @@ OptKernel* X86Engine::CreateOptKernel(const ir::Node* node) const {
         LOG(ERROR) << "create kernel[" << node->GetName() << "] failed: oom.";
         return nullptr;
     }
+    opt_kernel->SetDevice(&device_);
 
     return opt_kernel;
 }
+
+/*
+  converted weights saved by ops depend on the isa used when selecting algorithms, so the isa is saved
+  and restored before deserializing ops.
+*/
+static const uint32_t g_pmx_data_version = 2;
+
+RetCode X86Engine::SerializeData(const pmx::SerializationContext&, utils::DataStream* ds) const {
+    PmxDataWriter writer;
+    writer.Write<uint32_t>(g_pmx_data_version);
+    writer.Write<isa_t>(device_.GetISA());
+
+    auto& data = writer.GetData();
+    return ds->Write(data.data(), data.size());
+}
+
+RetCode X86Engine::DeserializeData(const void* base, uint64_t size) {
+    PmxDataReader reader(base, size);
+
+    uint32_t version = 0;
+    if (!reader.Read(&version) || version != g_pmx_data_version) {
+        LOG(ERROR) << "unsupported x86 engine data version[" << version << "], expected [" << g_pmx_data_version
+                   << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    isa_t isa = 0;
+    if (!reader.Read(&isa)) {
+        LOG(ERROR) << "read isa of x86 engine failed.";
+        return RC_INVALID_VALUE;
+    }
+    if ((isa & device_.GetISA()) != isa) {
+        LOG(ERROR) << "model is optimized with isa[" << isa << "] which is not supported by current device isa["
+                   << device_.GetISA() << "]";
+        return RC_UNSUPPORTED;
+    }
+    device_.SetISA(isa);
+
+    return RC_SUCCESS;
+}
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -178,9 +290,78 @@ RetCode X86Engine::DisableAVXFMA3(X86Engine* engine, va_list) {
     return RC_SUCCESS;
 }
 
+RetCode X86Engine::SetQuantInfo(X86Engine* engine, va_list args) {
+    const char* json_str = va_arg(args, const char*);
+    if (!json_str) {
+        LOG(ERROR) << "empty quantization info string.";
+        return RC_INVALID_VALUE;
+    }
+
+    QuantParamInfo quant_info;
+    auto status = QuantParamParser::ParseBuffer(json_str, &quant_info);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "parse quantization buffer failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    engine->quant_info_ = std::move(quant_info);
+    LOG(DEBUG) << "Quant tensor size: " << engine->quant_info_.tensor_params.size();
+    LOG(DEBUG) << "Quant node size: " << engine->quant_info_.node_params.size();
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::ExportAlgorithms(X86Engine* engine, va_list args) {
+    const char* json_file = va_arg(args, const char*);
+    if (!json_file) {
+        LOG(ERROR) << "empty algorithm file name.";
+        return RC_INVALID_VALUE;
+    }
+
+    engine->export_algo_file_ = json_file;
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::ImportAlgorithms(X86Engine* engine, va_list args) {
+    const char* json_file = va_arg(args, const char*);
+    if (!json_file) {
+        LOG(ERROR) << "empty algorithm file name.";
+        return RC_INVALID_VALUE;
+    }
+
+    auto status = ImportAlgoSelects(json_file, &engine->algos_);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "import algorithms from [" << json_file << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    LOG(DEBUG) << "imported algorithm size: " << engine->algos_.size();
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::SetCoreBinding(X86Engine* engine, va_list args) {
+    auto cores = va_arg(args, const int32_t*);
+    auto core_num = va_arg(args, uint32_t);
+    if (!cores || core_num == 0) {
+        LOG(ERROR) << "empty core list.";
+        return RC_INVALID_VALUE;
+    }
+    for (uint32_t i = 0; i < core_num; ++i) {
+        if (cores[i] < 0) {
+            LOG(ERROR) << "invalid core id[" << cores[i] << "]";
+            return RC_INVALID_VALUE;
+        }
+    }
+
+    return engine->InitThreadConfig(vector<int32_t>(cores, cores + core_num));
+}
+
 X86Engine::ConfHandlerFunc X86Engine::conf_handlers_[] = {
-    X86Engine::DisableAVX512,
-    X86Engine::DisableAVXFMA3,
+    X86Engine::DisableAVX512, // X86_CONF_DISABLE_AVX512
+    X86Engine::DisableAVXFMA3, // X86_CONF_DISABLE_AVX_FMA3
+    X86Engine::SetQuantInfo, // X86_CONF_SET_QUANT_INFO
+    X86Engine::ExportAlgorithms, // X86_CONF_EXPORT_ALGORITHMS
+    X86Engine::ImportAlgorithms, // X86_CONF_IMPORT_ALGORITHMS
+    X86Engine::SetCoreBinding, // X86_CONF_SET_CORE_BINDING
 };
 
 RetCode X86Engine::Configure(uint32_t option, ...) {
@@ -21,6 +21,9 @@
 #include "ppl/nn/engines/engine_impl.h"
 #include "ppl/nn/engines/x86/x86_device.h"
 #include "ppl/nn/engines/x86/x86_engine_options.h"
+#include "ppl/nn/engines/x86/algo_select.h"
+#include "ppl/nn/engines/x86/thread_config.h"
+#include "ppl/nn/quantization/quant_param_info.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -37,18 +40,15 @@ public:
 #ifdef PPLNN_ENABLE_PMX_MODEL
     ppl::common::RetCode LoadConstants(const ConstantVisitor&, std::map<edgeid_t, BufferInfo>*) override;
     OptKernel* CreateOptKernel(const ir::Node*) const override;
-    ppl::common::RetCode SerializeData(const pmx::SerializationContext&, utils::DataStream*) const override {
-        return ppl::common::RC_UNSUPPORTED;
-    }
-    ppl::common::RetCode DeserializeData(const void*, uint64_t) override {
-        return ppl::common::RC_UNSUPPORTED;
-    }
+    ppl::common::RetCode SerializeData(const pmx::SerializationContext&, utils::DataStream*) const override;
+    ppl::common::RetCode DeserializeData(const void*, uint64_t) override;
 #endif
 
 private:
     ppl::common::RetCode DoOptimize(const utils::SharedResource*, ir::Graph*, RuntimePartitionInfo*);
     ppl::common::RetCode CalDataOmittedConstants(const ir::Graph&, const RuntimePartitionInfo&,
                                                  std::set<edgeid_t>*) const;
+    ppl::common::RetCode InitThreadConfig(const std::vector<int32_t>& cores);
 
 private:
     /*
@@ -57,6 +57,10 @@ private:
      */
     static ppl::common::RetCode DisableAVX512(X86Engine*, va_list);
     static ppl::common::RetCode DisableAVXFMA3(X86Engine*, va_list);
+    static ppl::common::RetCode SetQuantInfo(X86Engine*, va_list);
+    static ppl::common::RetCode ExportAlgorithms(X86Engine*, va_list);
+    static ppl::common::RetCode ImportAlgorithms(X86Engine*, va_list);
+    static ppl::common::RetCode SetCoreBinding(X86Engine*, va_list);
 
     typedef ppl::common::RetCode (*ConfHandlerFunc)(X86Engine*, va_list);
     static ConfHandlerFunc conf_handlers_[X86_CONF_MAX];
@@ -64,6 +68,10 @@ private:
 private:
     X86Device device_;
     X86EngineOptions options_;
+    QuantParamInfo quant_info_;
+    AlgoSelectMap algos_;
+    std::string export_algo_file_;
+    std::shared_ptr<const ThreadConfig> thread_config_;
 };
 
 }}} // namespace ppl::nn::x86
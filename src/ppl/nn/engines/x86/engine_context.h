@@ -27,7 +27,8 @@ namespace ppl { namespace nn { namespace x86 {
 
 class X86EngineContext final : public EngineContext {
 public:
-    X86EngineContext(ppl::common::isa_t isa, uint32_t mm_policy) : device_(X86_DEFAULT_ALIGNMENT, isa, mm_policy) {}
+    X86EngineContext(ppl::common::isa_t isa, uint32_t mm_policy, const std::shared_ptr<const ThreadConfig>& thread_config)
+        : device_(X86_DEFAULT_ALIGNMENT, isa, mm_policy, thread_config) {}
 
     Device* GetDevice() override {
         return &device_;
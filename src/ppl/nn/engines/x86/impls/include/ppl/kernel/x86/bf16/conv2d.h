@@ -0,0 +1,245 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_BF16_CONV2D_H_
+#define __ST_PPL_KERNEL_X86_BF16_CONV2D_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/common/conv_common.h"
+#include "ppl/common/allocator.h"
+#include "ppl/common/sys.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// Conv2d with fp32 ndarray input and output computed in bf16.
+// src is converted to bf16 on the fly and filter is converted when converting weights,
+// products are accumulated in fp32 with bias and activation fused.
+struct conv2d_bf16_param {
+    int64_t kernel_h;
+    int64_t kernel_w;
+    int64_t stride_h;
+    int64_t stride_w;
+    int64_t dilation_h;
+    int64_t dilation_w;
+    int64_t pad_h;
+    int64_t pad_w;
+    int64_t channels;
+    int64_t num_output;
+    int64_t group;
+    conv_fuse_flag_t fuse_flag;
+
+    bool is_depthwise() const
+    {
+        return true &&
+               group != 1 &&
+               group == channels &&
+               group == num_output;
+    }
+
+    bool is_pointwise() const
+    {
+        return true &&
+               kernel_h == 1 &&
+               kernel_w == 1 &&
+               pad_h == 0 &&
+               pad_w == 0 &&
+               stride_h == 1 &&
+               stride_w == 1 &&
+               !is_depthwise();
+    }
+};
+
+typedef uint32_t conv2d_bf16_algo_t;
+
+class conv2d_bf16_algo {
+public:
+    static const conv2d_bf16_algo_t UNKNOWN     = 0;
+    static const conv2d_bf16_algo_t IM2COL_GEMM = 4;
+    static const conv2d_bf16_algo_t DIRECT      = 5;
+};
+
+struct conv2d_bf16_algo_info {
+    conv2d_bf16_algo_t algo_type;
+    ppl::common::isa_t isa;
+    ppl::common::dataformat_t input_format;
+    ppl::common::dataformat_t output_format;
+};
+
+class conv2d_bf16_manager;
+
+class conv2d_bf16_executor {
+private:
+    const conv2d_bf16_manager *mgr_;
+
+    const float *src_;
+    const ppl::nn::TensorShape *src_shape_;
+    float *dst_;
+    const ppl::nn::TensorShape *dst_shape_;
+
+    void *temp_buffer_;
+
+public:
+    conv2d_bf16_executor(const conv2d_bf16_manager *mgr)
+        : mgr_(mgr)
+        , src_(nullptr)
+        , src_shape_(nullptr)
+        , dst_(nullptr)
+        , dst_shape_(nullptr)
+        , temp_buffer_(nullptr) {}
+
+    uint64_t cal_temp_buffer_size();
+    ppl::common::RetCode prepare();
+    ppl::common::RetCode execute();
+
+    const conv2d_bf16_param *conv_param() const;
+
+    void set_src(const float *src)
+    {
+        src_ = src;
+    }
+    const float *src() const
+    {
+        return src_;
+    }
+
+    void set_src_shape(const ppl::nn::TensorShape *src_shape)
+    {
+        src_shape_ = src_shape;
+    }
+    const ppl::nn::TensorShape *src_shape() const
+    {
+        return src_shape_;
+    }
+
+    void set_dst(float *dst)
+    {
+        dst_ = dst;
+    }
+    float *dst() const
+    {
+        return dst_;
+    }
+
+    void set_dst_shape(const ppl::nn::TensorShape *dst_shape)
+    {
+        dst_shape_ = dst_shape;
+    }
+    const ppl::nn::TensorShape *dst_shape() const
+    {
+        return dst_shape_;
+    }
+
+    void set_temp_buffer(void *temp_buffer)
+    {
+        temp_buffer_ = temp_buffer;
+    }
+    void *temp_buffer() const
+    {
+        return temp_buffer_;
+    }
+};
+
+class conv2d_bf16_manager {
+private:
+    conv2d_bf16_param param_;
+    conv2d_bf16_algo_info algo_info_;
+    ppl::common::Allocator *allocator_;
+
+    // all converted weights are placed in one buffer
+    void *cvt_weights_;
+    uint16_t *cvt_filter_; // per group: [padded_oc / oc_blk][padded_k / 2][oc_blk][2]
+    float *cvt_bias_;      // per group: [padded_oc]
+    uint64_t cvt_weights_bytes_;
+
+    ppl::common::RetCode alloc_cvt_weights();
+
+public:
+    conv2d_bf16_manager(const conv2d_bf16_param &param, const conv2d_bf16_algo_info &algo_info, ppl::common::Allocator *allocator)
+        : param_(param)
+        , algo_info_(algo_info)
+        , allocator_(allocator)
+        , cvt_weights_(nullptr)
+        , cvt_filter_(nullptr)
+        , cvt_bias_(nullptr)
+        , cvt_weights_bytes_(0) {}
+
+    ~conv2d_bf16_manager()
+    {
+        release_cvt_weights();
+    }
+
+    void set_param(const conv2d_bf16_param &param)
+    {
+        param_ = param;
+    }
+    const conv2d_bf16_param &param() const
+    {
+        return param_;
+    }
+
+    const conv2d_bf16_algo_info &algo_info() const
+    {
+        return algo_info_;
+    }
+
+    const uint16_t *cvt_filter() const
+    {
+        return cvt_filter_;
+    }
+    const float *cvt_bias() const
+    {
+        return cvt_bias_;
+    }
+
+    // all converted weights as one buffer, for saving and restoring them without converting again
+    const void *cvt_weights() const
+    {
+        return cvt_weights_;
+    }
+    uint64_t cvt_weights_bytes() const
+    {
+        return cvt_weights_bytes_;
+    }
+    ppl::common::RetCode set_cvt_weights(const void *cvt_weights, const uint64_t cvt_weights_bytes);
+
+    void release_cvt_weights()
+    {
+        if (cvt_weights_) {
+            allocator_->Free(cvt_weights_);
+            cvt_weights_       = nullptr;
+            cvt_filter_        = nullptr;
+            cvt_bias_          = nullptr;
+            cvt_weights_bytes_ = 0;
+        }
+    }
+
+    bool is_supported();
+    ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias);
+    conv2d_bf16_executor *gen_executor();
+};
+
+class conv2d_bf16_algo_selector {
+public:
+    // returns UNKNOWN if bf16 is not supported or not profitable for param on this cpu.
+    // input_format of the selected algo is always ndarray, src_format is accepted for api consistency.
+    static conv2d_bf16_algo_info select_algo(const ppl::common::dataformat_t src_format, const conv2d_bf16_param &param, const ppl::common::isa_t isa_flags);
+    static conv2d_bf16_manager *gen_algo(const conv2d_bf16_param &param, const conv2d_bf16_algo_info &algo_info, ppl::common::Allocator *allocator);
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
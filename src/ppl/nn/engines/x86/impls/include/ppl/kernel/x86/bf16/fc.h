@@ -0,0 +1,211 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_BF16_FC_H_
+#define __ST_PPL_KERNEL_X86_BF16_FC_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/common/fc_common.h"
+#include "ppl/common/allocator.h"
+#include "ppl/common/sys.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// Fully connected layer with fp32 input and output computed in bf16, see conv2d_bf16_param.
+struct fc_bf16_param {
+    int64_t channels;
+    int64_t num_output;
+    fc_fuse_flag_t fuse_flag;
+};
+
+typedef uint32_t fc_bf16_algo_t;
+
+class fc_bf16_algo {
+public:
+    static const fc_bf16_algo_t UNKNOWN  = 0;
+    static const fc_bf16_algo_t STANDARD = 1;
+    static const fc_bf16_algo_t AMX      = 2;
+};
+
+struct fc_bf16_algo_info {
+    fc_bf16_algo_t algo_type;
+    ppl::common::isa_t isa;
+};
+
+class fc_bf16_manager;
+
+class fc_bf16_executor {
+private:
+    const fc_bf16_manager *mgr_;
+
+    const float *src_;
+    const ppl::nn::TensorShape *src_shape_;
+    float *dst_;
+    const ppl::nn::TensorShape *dst_shape_;
+
+    void *temp_buffer_;
+
+public:
+    fc_bf16_executor(const fc_bf16_manager *mgr)
+        : mgr_(mgr)
+        , src_(nullptr)
+        , src_shape_(nullptr)
+        , dst_(nullptr)
+        , dst_shape_(nullptr)
+        , temp_buffer_(nullptr) {}
+
+    uint64_t cal_temp_buffer_size();
+    ppl::common::RetCode prepare();
+    ppl::common::RetCode execute();
+
+    const fc_bf16_param *fc_param() const;
+
+    void set_src(const float *src)
+    {
+        src_ = src;
+    }
+    const float *src() const
+    {
+        return src_;
+    }
+
+    void set_src_shape(const ppl::nn::TensorShape *src_shape)
+    {
+        src_shape_ = src_shape;
+    }
+    const ppl::nn::TensorShape *src_shape() const
+    {
+        return src_shape_;
+    }
+
+    void set_dst(float *dst)
+    {
+        dst_ = dst;
+    }
+    float *dst() const
+    {
+        return dst_;
+    }
+
+    void set_dst_shape(const ppl::nn::TensorShape *dst_shape)
+    {
+        dst_shape_ = dst_shape;
+    }
+    const ppl::nn::TensorShape *dst_shape() const
+    {
+        return dst_shape_;
+    }
+
+    void set_temp_buffer(void *temp_buffer)
+    {
+        temp_buffer_ = temp_buffer;
+    }
+    void *temp_buffer() const
+    {
+        return temp_buffer_;
+    }
+};
+
+class fc_bf16_manager {
+private:
+    fc_bf16_param param_;
+    fc_bf16_algo_info algo_info_;
+    ppl::common::Allocator *allocator_;
+
+    // all converted weights are placed in one buffer
+    void *cvt_weights_;
+    uint16_t *cvt_filter_; // [padded_oc / oc_blk][padded_k / 2][oc_blk][2]
+    float *cvt_bias_;      // [padded_oc]
+    uint64_t cvt_weights_bytes_;
+
+    ppl::common::RetCode alloc_cvt_weights();
+
+public:
+    fc_bf16_manager(const fc_bf16_param &param, const fc_bf16_algo_info &algo_info, ppl::common::Allocator *allocator)
+        : param_(param)
+        , algo_info_(algo_info)
+        , allocator_(allocator)
+        , cvt_weights_(nullptr)
+        , cvt_filter_(nullptr)
+        , cvt_bias_(nullptr)
+        , cvt_weights_bytes_(0) {}
+
+    ~fc_bf16_manager()
+    {
+        release_cvt_weights();
+    }
+
+    void set_param(const fc_bf16_param &param)
+    {
+        param_ = param;
+    }
+    const fc_bf16_param &param() const
+    {
+        return param_;
+    }
+
+    const fc_bf16_algo_info &algo_info() const
+    {
+        return algo_info_;
+    }
+
+    const uint16_t *cvt_filter() const
+    {
+        return cvt_filter_;
+    }
+    const float *cvt_bias() const
+    {
+        return cvt_bias_;
+    }
+
+    // all converted weights as one buffer, for saving and restoring them without converting again
+    const void *cvt_weights() const
+    {
+        return cvt_weights_;
+    }
+    uint64_t cvt_weights_bytes() const
+    {
+        return cvt_weights_bytes_;
+    }
+    ppl::common::RetCode set_cvt_weights(const void *cvt_weights, const uint64_t cvt_weights_bytes);
+
+    void release_cvt_weights()
+    {
+        if (cvt_weights_) {
+            allocator_->Free(cvt_weights_);
+            cvt_weights_       = nullptr;
+            cvt_filter_        = nullptr;
+            cvt_bias_          = nullptr;
+            cvt_weights_bytes_ = 0;
+        }
+    }
+
+    bool is_supported();
+    ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias);
+    fc_bf16_executor *gen_executor();
+};
+
+class fc_bf16_algo_selector {
+public:
+    // returns UNKNOWN if bf16 is not supported on this cpu, AMX is preferred if available
+    static fc_bf16_algo_info select_algo(const ppl::common::dataformat_t src_format, const fc_bf16_param &param, const ppl::common::isa_t isa_flags);
+    static fc_bf16_manager *gen_algo(const fc_bf16_param &param, const fc_bf16_algo_info &algo_info, ppl::common::Allocator *allocator);
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
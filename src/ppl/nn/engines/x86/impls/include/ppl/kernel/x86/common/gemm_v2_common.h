@@ -64,6 +64,21 @@ struct gemm_v2_param_fp32 {
     ppl::common::isa_t isa_flag   = ppl::common::ISA_UNKNOWN;
     gemm_v2_fuse_flag_t fuse_flag = gemm_v2_fuse_flag::NONE;
     gemm_v2_C_type_t c_type       = gemm_v2_C_type::EMPTY;
+
+    // `batch` gemms sharing M, N, K, C and leading dimensions, the i-th one reads src_A + batch_offset_A[i],
+    // src_B + batch_offset_B[i] and writes dst_Y + batch_offset_Y[i]. offsets are in elements,
+    // null offsets mean the matrix is shared by all gemms.
+    int64_t batch                 = 1;
+    const int64_t* batch_offset_A = nullptr;
+    const int64_t* batch_offset_B = nullptr;
+    const int64_t* batch_offset_Y = nullptr;
+
+    // B packed by gemm_v2_executor_fp32::pack_b(), src_B, trans_B, ldb and batch_offset_B are ignored if not null
+    const void* packed_B = nullptr;
+
+    // DATATYPE_BFLOAT16 allows A and B to be rounded to bf16 when the cpu has native bf16 dot products,
+    // accumulation, C and Y are always fp32
+    ppl::common::datatype_t compute_type = ppl::common::DATATYPE_FLOAT32;
 };
 
 }}} // namespace ppl::kernel::x86
@@ -35,8 +35,21 @@ class rnn_num_gate {
 public:
     static const int64_t LSTM = 4;
     static const int64_t GRU  = 3;
+    static const int64_t RNN  = 1;
 };
 
+// number of valid steps of the b-th sequence, steps after them are padding
+inline int64_t rnn_valid_seq_len(const int32_t *sequence_lens, const int64_t seq_len, const int64_t b)
+{
+    return (sequence_lens && sequence_lens[b] < seq_len) ? sequence_lens[b] : seq_len;
+}
+
+// step of a sequence processed in the seq_idx-th iteration, reversed sequences start from their last valid step
+inline int64_t rnn_mapped_seq_index(const bool is_reverse, const int64_t valid_seq_len, const int64_t seq_idx)
+{
+    return is_reverse ? (valid_seq_len - seq_idx - 1) : seq_idx;
+}
+
 }}}; // namespace ppl::kernel::x86
 
 #endif
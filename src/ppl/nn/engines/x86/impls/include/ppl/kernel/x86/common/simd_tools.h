@@ -24,6 +24,12 @@ namespace ppl { namespace kernel { namespace x86 {
 
 void set_denormals_zero(const int32_t on);
 
+// ppl::common::isa_t has no flag for avx512 vnni, check it by cpuid
+bool cpu_supports_avx512vnni();
+bool cpu_supports_avx512bf16();
+// also requests the permission of using tile registers from the os, returns false if it is denied
+bool cpu_supports_amx_bf16();
+
 }}}; // namespace ppl::kernel::x86
 
 #endif
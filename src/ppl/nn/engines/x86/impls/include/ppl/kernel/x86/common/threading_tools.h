@@ -32,8 +32,14 @@ namespace ppl { namespace kernel { namespace x86 {
 */
 void set_omp_core_binding(const int32_t *cores, const int32_t num_cores, const int32_t mode);
 
+// lets threads started by the calling thread run on all cores the calling thread may run on
+void unset_omp_core_binding();
+
 int32_t get_omp_max_threads();
 
+// sets number of threads used by parallel regions started from the calling thread
+void set_omp_num_threads(const int32_t num_threads);
+
 struct single_parallel_loop_config_t {
     int64_t depth_of_loop;
     int64_t num_threads;
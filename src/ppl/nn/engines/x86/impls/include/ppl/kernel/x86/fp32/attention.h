@@ -0,0 +1,84 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_ATTENTION_H_
+#define __ST_PPL_KERNEL_X86_FP32_ATTENTION_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// dst = softmax(Q * K * scale + mask) * V
+// Q: [batch..., S, D], K: [batch..., D, T] (already transposed), V: [batch..., T, Dv], dst: [batch..., S, Dv]
+// mask is optional and broadcastable to [batch..., S, T]. batch dims of Q, K and V must be equal.
+// the S x T attention matrix is never materialized, only a few rows of it are kept per thread.
+
+uint64_t attention_fp32_get_buffer_bytes(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *k_shape);
+
+// checks dims of Q, K, V and mask described above. mask_shape can be nullptr.
+bool attention_fp32_check_shapes(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *k_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape);
+
+#ifdef PPL_USE_X86_AVX512
+ppl::common::RetCode attention_fp32_avx512(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *k_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    const float *Q,
+    const float *K,
+    const float *V,
+    const float *mask,
+    const float scale,
+    void *temp_buffer,
+    float *dst);
+#endif
+
+ppl::common::RetCode attention_fp32_fma(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *k_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    const float *Q,
+    const float *K,
+    const float *V,
+    const float *mask,
+    const float scale,
+    void *temp_buffer,
+    float *dst);
+
+ppl::common::RetCode attention_fp32(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *k_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    const float *Q,
+    const float *K,
+    const float *V,
+    const float *mask,
+    const float scale,
+    void *temp_buffer,
+    float *dst);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -19,6 +19,7 @@
 #define __ST_PPL_KERNEL_X86_FP32_CONV2D_H_
 
 #include <string>
+#include <vector>
 
 #include "ppl/kernel/x86/common/general_include.h"
 #include "ppl/kernel/x86/common/conv_common.h"
@@ -150,6 +151,13 @@ public:
     virtual ppl::common::RetCode execute()  = 0;
     virtual ~conv2d_fp32_executor() {}
 
+    // called after prepare(), trades performance for a smaller temp buffer. call cal_temp_buffer_size() again for the new size.
+    // returns false if temp buffer cannot be smaller.
+    virtual bool reduce_temp_buffer()
+    {
+        return false;
+    }
+
     virtual bool init_profiler()
     {
         return false;
@@ -349,6 +357,9 @@ class conv2d_algo_selector {
 public:
     static conv2d_fp32_algo_info select_algo(const ppl::common::dataformat_t src_format, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags);
     static conv2d_fp32_manager *gen_algo(const conv2d_fp32_param &param, const conv2d_fp32_algo_info &algo_info, ppl::common::Allocator *allocator);
+    // all supported algorithms with the same isa and data formats as select_algo, for picking the fastest one by
+    // measuring. the result of select_algo comes first.
+    static std::vector<conv2d_fp32_algo_info> get_candidate_algos(const ppl::common::dataformat_t src_format, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags);
 };
 
 }}}; // namespace ppl::kernel::x86
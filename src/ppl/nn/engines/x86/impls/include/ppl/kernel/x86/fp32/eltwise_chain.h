@@ -0,0 +1,107 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_ELTWISE_CHAIN_H_
+#define __ST_PPL_KERNEL_X86_FP32_ELTWISE_CHAIN_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// a chain of elementwise ops evaluated in one pass over dst.
+// every op reads the result of the previous op (src[0] for the first op) and writes the current value,
+// binary ops take another operand from a src or from a value saved by an earlier op.
+
+typedef uint32_t eltwise_chain_op_type_t;
+
+class eltwise_chain_op_type {
+public:
+    static const eltwise_chain_op_type_t ADD        = 0;
+    static const eltwise_chain_op_type_t SUB        = 1;
+    static const eltwise_chain_op_type_t MUL        = 2;
+    static const eltwise_chain_op_type_t DIV        = 3;
+    static const eltwise_chain_op_type_t RELU       = 4;
+    static const eltwise_chain_op_type_t SIGMOID    = 5;
+    static const eltwise_chain_op_type_t TANH       = 6;
+    static const eltwise_chain_op_type_t EXP        = 7;
+    static const eltwise_chain_op_type_t SQRT       = 8;
+    static const eltwise_chain_op_type_t CLIP       = 9;  // alpha: min, beta: max
+    static const eltwise_chain_op_type_t LEAKY_RELU = 10; // alpha: slope
+};
+
+inline bool eltwise_chain_op_is_binary(const eltwise_chain_op_type_t type)
+{
+    return type <= eltwise_chain_op_type::DIV;
+}
+
+struct eltwise_chain_op {
+    eltwise_chain_op_type_t type;
+    int32_t src_idx;   // other operand of binary op is src[src_idx], or -1
+    int32_t value_idx; // other operand of binary op is the result of op[value_idx], or -1
+    bool reverse;      // other operand is the lhs of binary op
+    float alpha;
+    float beta;
+};
+
+// element i of dst reads data[(i / inner) % length]
+struct eltwise_chain_src {
+    const float *data;
+    int64_t inner;
+    int64_t length;
+};
+
+// fill src for broadcasting src_shape to dst_shape, returns false if it can not be described by inner and length.
+// src in the same format as dst must have the same dims, other broadcasting is for ndarray only.
+bool eltwise_chain_init_src(
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *data,
+    eltwise_chain_src *src);
+
+uint64_t eltwise_chain_fp32_get_buffer_bytes(
+    const eltwise_chain_op *ops,
+    const int32_t num_ops);
+
+#ifdef PPL_USE_X86_AVX512
+ppl::common::RetCode eltwise_chain_fp32_avx512(
+    const ppl::nn::TensorShape *dst_shape,
+    const eltwise_chain_src *srcs,
+    const eltwise_chain_op *ops,
+    const int32_t num_ops,
+    void *temp_buffer,
+    float *dst);
+#endif
+
+ppl::common::RetCode eltwise_chain_fp32_fma(
+    const ppl::nn::TensorShape *dst_shape,
+    const eltwise_chain_src *srcs,
+    const eltwise_chain_op *ops,
+    const int32_t num_ops,
+    void *temp_buffer,
+    float *dst);
+
+ppl::common::RetCode eltwise_chain_fp32(
+    const ppl::nn::TensorShape *dst_shape,
+    const eltwise_chain_src *srcs,
+    const eltwise_chain_op *ops,
+    const int32_t num_ops,
+    void *temp_buffer,
+    float *dst);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
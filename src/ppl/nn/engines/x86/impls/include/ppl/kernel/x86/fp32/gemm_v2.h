@@ -46,6 +46,7 @@ public:
         mnk_kernel_nm_atbn_fp32_avx512      = 1,
         mnk_sub_kmn_kernel_nm_atbn_fp32_fma = 2,
         mnk_sub_kmn_kernel_nm_atbn_fp32_sse = 3,
+        mnk_kernel_nm_atbn_fp32_avx512bf16  = 4,
     };
 };
 typedef uint32_t gemm_v2_fp32_algo_type_t;
@@ -88,6 +89,18 @@ public:
     virtual ppl::common::RetCode execute(void)    = 0;
     virtual ppl::common::RetCode optimize(void)   = 0;
 
+    // constant B could be packed once to skip packing it in every execute(). packed B is only valid for executors
+    // of the same algo, internal param and N, K, trans_B, ldb. returns 0 if packing is not supported.
+    virtual uint64_t get_packed_b_bytes(void) const
+    {
+        return 0;
+    }
+
+    virtual ppl::common::RetCode pack_b(const float* B, void* packed_B)
+    {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
 protected:
     gemm_v2_param_fp32 param_;
     void* temp_buffer_;
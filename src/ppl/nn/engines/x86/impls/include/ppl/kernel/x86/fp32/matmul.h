@@ -37,6 +37,28 @@ common::RetCode matmul_ndarray_fp32(
     void *temp_buffer,
     float *dst);
 
+// constant src1 without batch could be packed once and shared by all executions, returns 0 if it could not be packed
+uint64_t matmul_ndarray_fp32_get_packed_b_bytes(
+    const ppl::nn::TensorShape *src1_shape,
+    const ppl::common::isa_t isa_flag);
+
+common::RetCode matmul_ndarray_fp32_pack_b(
+    const ppl::nn::TensorShape *src1_shape,
+    const float *src1,
+    const ppl::common::isa_t isa_flag,
+    void *packed_src1);
+
+// packed_src1 must be packed by matmul_ndarray_fp32_pack_b() with the same src1_shape and isa_flag
+common::RetCode matmul_ndarray_fp32_with_packed_b(
+    const ppl::nn::TensorShape *src0_shape,
+    const ppl::nn::TensorShape *src1_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src0,
+    const void *packed_src1,
+    const ppl::common::isa_t isa_flag,
+    void *temp_buffer,
+    float *dst);
+
 }}}; // namespace ppl::kernel::x86
 
 #endif //! __ST_PPL_KERNEL_X86_FP32_MATMUL_H_
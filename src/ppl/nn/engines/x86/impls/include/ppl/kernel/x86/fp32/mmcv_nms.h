@@ -31,6 +31,26 @@ ppl::common::RetCode mmcv_nms_ndarray_fp32(
         int64_t *dst,
         int64_t *num_boxes_out);
 
+ppl::common::RetCode mmcv_nms_ndarray_fp32_fma(
+        const float *boxes,
+        const float *scores,
+        const uint32_t num_boxes_in,
+        const float iou_threshold,
+        const int64_t offset,
+        int64_t *dst,
+        int64_t *num_boxes_out);
+
+#ifdef PPL_USE_X86_AVX512
+ppl::common::RetCode mmcv_nms_ndarray_fp32_avx512(
+        const float *boxes,
+        const float *scores,
+        const uint32_t num_boxes_in,
+        const float iou_threshold,
+        const int64_t offset,
+        int64_t *dst,
+        int64_t *num_boxes_out);
+#endif
+
 }}}; // namespace ppl::kernel::x86
 
 #endif //! __ST_PPL_KERNEL_X86_FP32_MMCV_NMS_H_
@@ -0,0 +1,43 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/bf16/common/cvt_tools_bf16.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+void cvt_and_pack_filter_bf16(
+    const float *filter,
+    const int64_t oc,
+    const int64_t k,
+    const int64_t oc_blk,
+    const int64_t padded_oc,
+    const int64_t padded_k,
+    uint16_t *packed_filter)
+{
+    memset(packed_filter, 0, padded_oc * padded_k * sizeof(uint16_t));
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t o = 0; o < oc; ++o) {
+        const float *l_flt = filter + o * k;
+        uint16_t *l_packed = packed_filter + (o / oc_blk) * padded_k * oc_blk + (o % oc_blk) * 2;
+        for (int64_t i = 0; i < k; ++i) {
+            l_packed[(i / 2) * oc_blk * 2 + i % 2] = cvt_fp32_to_bf16(l_flt[i]);
+        }
+    }
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,61 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_BF16_COMMON_CVT_TOOLS_BF16_H_
+#define __ST_PPL_KERNEL_X86_BF16_COMMON_CVT_TOOLS_BF16_H_
+
+#include <string.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// bf16 values are stored as uint16_t, the upper half of a fp32
+inline uint16_t cvt_fp32_to_bf16(const float x)
+{
+    uint32_t u;
+    memcpy(&u, &x, sizeof(u));
+    if ((u & 0x7fffffff) > 0x7f800000) {
+        return 0x7fc0; // quiet nan
+    }
+    // round to nearest even, same as the vcvtneps2bf16 instruction
+    u += 0x7fff + ((u >> 16) & 1);
+    return static_cast<uint16_t>(u >> 16);
+}
+
+inline float cvt_bf16_to_fp32(const uint16_t x)
+{
+    const uint32_t u = static_cast<uint32_t>(x) << 16;
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+// Converts filter [oc][k] to bf16 and packs it into [padded_oc / oc_blk][padded_k / 2][oc_blk][2],
+// padded_oc must be a multiple of oc_blk and padded_k must be even, paddings are filled with zero.
+void cvt_and_pack_filter_bf16(
+    const float *filter,
+    const int64_t oc,
+    const int64_t k,
+    const int64_t oc_blk,
+    const int64_t padded_oc,
+    const int64_t padded_k,
+    uint16_t *packed_filter);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
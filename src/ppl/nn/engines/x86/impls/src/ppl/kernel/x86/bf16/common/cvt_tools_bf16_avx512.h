@@ -0,0 +1,54 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_BF16_COMMON_CVT_TOOLS_BF16_AVX512_H_
+#define __ST_PPL_KERNEL_X86_BF16_COMMON_CVT_TOOLS_BF16_AVX512_H_
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+// only for sources compiled with avx512bf16 enabled
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// converts to bf16 with round to nearest even, results are zero extended to the low half of each 32-bit lane
+inline __m512i cvt_fp32_to_bf16_epi32_avx512(const __m512 x)
+{
+    return _mm512_cvtepu16_epi32((__m256i)_mm512_cvtneps_pbh(x));
+}
+
+// converts src[len] to dst[padded_len], the padding is filled with zero
+inline void cvt_fp32_to_bf16_avx512(
+    const float *src,
+    const int64_t len,
+    const int64_t padded_len,
+    uint16_t *dst)
+{
+    for (int64_t i = 0; i < padded_len; i += 16) {
+        const int64_t load_eff     = min<int64_t>(max<int64_t>(len - i, 0), 16);
+        const int64_t store_eff    = min<int64_t>(padded_len - i, 16);
+        const __mmask16 load_mask  = load_eff == 16 ? 0xffff : ((1 << load_eff) - 1);
+        const __mmask16 store_mask = store_eff == 16 ? 0xffff : ((1 << store_eff) - 1);
+        const __m512i v            = cvt_fp32_to_bf16_epi32_avx512(_mm512_maskz_loadu_ps(load_mask, src + i));
+        _mm512_mask_cvtepi32_storeu_epi16(dst + i, store_mask, v);
+    }
+}
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,385 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/bf16/conv2d/avx512bf16/conv2d_bf16_avx512bf16.h"
+#include "ppl/kernel/x86/bf16/common/cvt_tools_bf16_avx512.h"
+
+#define OC_KR_BLK() CONV2D_BF16_AVX512BF16_OC_BLK()
+#define HW_DT_BLK() 16
+#define HW_KR_BLK() (2 * HW_DT_BLK())
+
+#define HW_L2_BLK_MAX()   1024
+#define SRC_L2_BLK_BYTES() (256 * 1024)
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct conv2d_bf16_kernel_param {
+    const uint16_t *src;       // [padded_k / 2][src_k2_stride / 2][2]
+    const uint16_t *flt;       // [padded_k / 2][OC_KR_BLK()][2]
+    const float *bias;
+    float *dst;
+    int64_t src_k2_stride;     // in elements
+    int64_t k2_count;
+    int64_t dst_oc_stride;
+    __mmask16 tail_mask;       // mask of the last hw vector
+    conv_fuse_flag_t fuse_flag;
+};
+
+typedef void (*conv2d_bf16_kernel_func_t)(const conv2d_bf16_kernel_param &);
+
+static inline __m512 conv2d_bf16_epilogue_avx512(
+    const __m512 acc,
+    const int64_t oc,
+    const conv2d_bf16_kernel_param &kp)
+{
+    __m512 v = _mm512_add_ps(acc, _mm512_set1_ps(kp.bias[oc]));
+    if (kp.fuse_flag & (conv_fuse_flag::RELU | conv_fuse_flag::RELU6)) {
+        v = _mm512_max_ps(v, _mm512_setzero_ps());
+    }
+    if (kp.fuse_flag & conv_fuse_flag::RELU6) {
+        v = _mm512_min_ps(v, _mm512_set1_ps(6.0f));
+    }
+    return v;
+}
+
+// dst[oc_len][hw] = sum(flt[oc_len][k] * src[k][hw]), src is broadcast along oc and flt is broadcast along hw
+template <int64_t oc_len, int64_t hw_len>
+void conv2d_bf16_kernel_avx512bf16(const conv2d_bf16_kernel_param &kp)
+{
+#define DECL_ACC(OC) __m512 acc##OC##0 = _mm512_setzero_ps(), acc##OC##1 = _mm512_setzero_ps()
+#define DPBF16(OC)                                                      \
+    do {                                                                \
+        if (oc_len > OC) {                                              \
+            const __m512bh w = (__m512bh)_mm512_set1_epi32(l_flt[OC]);  \
+            acc##OC##0       = _mm512_dpbf16_ps(acc##OC##0, s0, w);     \
+            if (hw_len > 1) acc##OC##1 = _mm512_dpbf16_ps(acc##OC##1, s1, w); \
+        }                                                               \
+    } while (0)
+#define STORE_ACC(OC)                                                                          \
+    do {                                                                                       \
+        if (oc_len > OC) {                                                                     \
+            float *l_dst = kp.dst + OC * kp.dst_oc_stride;                                     \
+            if (hw_len > 1) {                                                                  \
+                _mm512_storeu_ps(l_dst, conv2d_bf16_epilogue_avx512(acc##OC##0, OC, kp));      \
+                _mm512_mask_storeu_ps(l_dst + HW_DT_BLK(), kp.tail_mask, conv2d_bf16_epilogue_avx512(acc##OC##1, OC, kp)); \
+            } else {                                                                           \
+                _mm512_mask_storeu_ps(l_dst, kp.tail_mask, conv2d_bf16_epilogue_avx512(acc##OC##0, OC, kp)); \
+            }                                                                                  \
+        }                                                                                      \
+    } while (0)
+
+    DECL_ACC(0); DECL_ACC(1); DECL_ACC(2); DECL_ACC(3);
+    DECL_ACC(4); DECL_ACC(5); DECL_ACC(6); DECL_ACC(7);
+
+    const uint16_t *l_src = kp.src;
+    const int32_t *l_flt  = reinterpret_cast<const int32_t *>(kp.flt);
+    for (int64_t k2 = 0; k2 < kp.k2_count; ++k2) {
+        __m512bh s0, s1;
+        if (hw_len > 1) {
+            s0 = (__m512bh)_mm512_loadu_si512(l_src);
+            s1 = (__m512bh)_mm512_maskz_loadu_epi32(kp.tail_mask, l_src + HW_DT_BLK() * 2);
+        } else {
+            s0 = (__m512bh)_mm512_maskz_loadu_epi32(kp.tail_mask, l_src);
+        }
+        DPBF16(0); DPBF16(1); DPBF16(2); DPBF16(3);
+        DPBF16(4); DPBF16(5); DPBF16(6); DPBF16(7);
+        l_src += kp.src_k2_stride;
+        l_flt += OC_KR_BLK();
+    }
+
+    STORE_ACC(0); STORE_ACC(1); STORE_ACC(2); STORE_ACC(3);
+    STORE_ACC(4); STORE_ACC(5); STORE_ACC(6); STORE_ACC(7);
+
+#undef DECL_ACC
+#undef DPBF16
+#undef STORE_ACC
+}
+
+static const conv2d_bf16_kernel_func_t conv2d_bf16_kernel_table[OC_KR_BLK()][2] = {
+    {conv2d_bf16_kernel_avx512bf16<1, 1>, conv2d_bf16_kernel_avx512bf16<1, 2>},
+    {conv2d_bf16_kernel_avx512bf16<2, 1>, conv2d_bf16_kernel_avx512bf16<2, 2>},
+    {conv2d_bf16_kernel_avx512bf16<3, 1>, conv2d_bf16_kernel_avx512bf16<3, 2>},
+    {conv2d_bf16_kernel_avx512bf16<4, 1>, conv2d_bf16_kernel_avx512bf16<4, 2>},
+    {conv2d_bf16_kernel_avx512bf16<5, 1>, conv2d_bf16_kernel_avx512bf16<5, 2>},
+    {conv2d_bf16_kernel_avx512bf16<6, 1>, conv2d_bf16_kernel_avx512bf16<6, 2>},
+    {conv2d_bf16_kernel_avx512bf16<7, 1>, conv2d_bf16_kernel_avx512bf16<7, 2>},
+    {conv2d_bf16_kernel_avx512bf16<8, 1>, conv2d_bf16_kernel_avx512bf16<8, 2>},
+};
+
+// convert ndarray src to bf16 ndarray
+static void conv2d_bf16_cvt_src_avx512(
+    const float *src,
+    const int64_t channels,
+    const int64_t src_hw,
+    uint16_t *dst)
+{
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t c = 0; c < channels; ++c) {
+        cvt_fp32_to_bf16_avx512(src + c * src_hw, src_hw, src_hw, dst + c * src_hw);
+    }
+}
+
+// convert ndarray src of all groups to bf16 [batch * group][padded_k / 2][src_hw][2], where k is channels of a group
+static void conv2d_bf16_cvt_src_interleave_avx512(
+    const float *src,
+    const int64_t batch_group,
+    const int64_t ic_per_gp,
+    const int64_t src_hw,
+    uint16_t *dst)
+{
+    const int64_t k2_count = div_up(ic_per_gp, 2);
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t bgk = 0; bgk < batch_group * k2_count; ++bgk) {
+        const int64_t bg      = bgk / k2_count;
+        const int64_t k2      = bgk % k2_count;
+        const bool has_second = k2 * 2 + 1 < ic_per_gp;
+        const float *l_src    = src + (bg * ic_per_gp + k2 * 2) * src_hw;
+        uint16_t *l_dst       = dst + bgk * src_hw * 2;
+        for (int64_t hw = 0; hw < src_hw; hw += HW_DT_BLK()) {
+            const __mmask16 mask = hw + HW_DT_BLK() <= src_hw ? 0xffff : ((1 << (src_hw - hw)) - 1);
+            __m512i v            = cvt_fp32_to_bf16_epi32_avx512(_mm512_maskz_loadu_ps(mask, l_src + hw));
+            if (has_second) {
+                const __m512i v1 = cvt_fp32_to_bf16_epi32_avx512(_mm512_maskz_loadu_ps(mask, l_src + src_hw + hw));
+                v                = _mm512_or_si512(v, _mm512_slli_epi32(v1, 16));
+            }
+            _mm512_mask_storeu_epi32(l_dst + hw * 2, mask, v);
+        }
+    }
+}
+
+// im2col of hw_eff output pixels from hw_start into [padded_k / 2][hw_l2_blk][2]
+static void conv2d_bf16_im2col(
+    const conv2d_bf16_param &param,
+    const uint16_t *src_bf16, // [ic_per_gp][src_h][src_w] of one group
+    const int64_t src_h,
+    const int64_t src_w,
+    const int64_t dst_w,
+    const int64_t hw_start,
+    const int64_t hw_eff,
+    const int64_t hw_l2_blk,
+    uint16_t *col)
+{
+    const int64_t ic_per_gp = param.channels / param.group;
+    const int64_t k_per_ic  = param.kernel_h * param.kernel_w;
+    const int64_t k_per_gp  = ic_per_gp * k_per_ic;
+    const int64_t padded_k  = round_up(k_per_gp, 2);
+
+    for (int64_t k = 0; k < padded_k; ++k) {
+        uint16_t *l_col = col + (k / 2) * hw_l2_blk * 2 + (k % 2);
+        if (k >= k_per_gp) {
+            for (int64_t p = 0; p < hw_eff; ++p) {
+                l_col[p * 2] = 0;
+            }
+            continue;
+        }
+        const int64_t ic      = k / k_per_ic;
+        const int64_t kh      = (k % k_per_ic) / param.kernel_w;
+        const int64_t kw      = k % param.kernel_w;
+        const uint16_t *l_src = src_bf16 + ic * src_h * src_w;
+
+        int64_t oh = hw_start / dst_w;
+        int64_t ow = hw_start % dst_w;
+        int64_t p  = 0;
+        while (p < hw_eff) {
+            const int64_t seg = min(dst_w - ow, hw_eff - p);
+            const int64_t ih  = oh * param.stride_h - param.pad_h + kh * param.dilation_h;
+            if (ih < 0 || ih >= src_h) {
+                for (int64_t i = 0; i < seg; ++i) {
+                    l_col[(p + i) * 2] = 0;
+                }
+            } else {
+                const uint16_t *l_row = l_src + ih * src_w;
+                int64_t iw            = ow * param.stride_w - param.pad_w + kw * param.dilation_w;
+                for (int64_t i = 0; i < seg; ++i, iw += param.stride_w) {
+                    l_col[(p + i) * 2] = (iw >= 0 && iw < src_w) ? l_row[iw] : 0;
+                }
+            }
+            p += seg;
+            ow = 0;
+            ++oh;
+        }
+    }
+}
+
+// computes oc of [oc_start, oc_end) of one group for hw_eff pixels
+static void conv2d_bf16_compute_block(
+    const uint16_t *src,
+    const int64_t src_k2_stride,
+    const uint16_t *flt,
+    const float *bias,
+    const int64_t padded_k,
+    const int64_t oc_start,
+    const int64_t oc_end,
+    const int64_t hw_eff,
+    const int64_t dst_oc_stride,
+    const conv_fuse_flag_t fuse_flag,
+    float *dst)
+{
+    conv2d_bf16_kernel_param kp;
+    kp.src_k2_stride = src_k2_stride;
+    kp.k2_count      = padded_k / 2;
+    kp.dst_oc_stride = dst_oc_stride;
+    kp.fuse_flag     = fuse_flag;
+
+    for (int64_t oc = oc_start; oc < oc_end; oc += OC_KR_BLK()) {
+        const int64_t oc_eff = min<int64_t>(oc_end - oc, OC_KR_BLK());
+        kp.flt  = flt + oc * padded_k;
+        kp.bias = bias + oc;
+        for (int64_t hw = 0; hw < hw_eff; hw += HW_KR_BLK()) {
+            const int64_t hw_len = min<int64_t>(hw_eff - hw, HW_KR_BLK());
+            const int64_t vecs   = div_up(hw_len, HW_DT_BLK());
+            const int64_t tail   = hw_len - (vecs - 1) * HW_DT_BLK();
+            kp.tail_mask         = tail == HW_DT_BLK() ? 0xffff : ((1 << tail) - 1);
+            kp.src               = src + hw * 2;
+            kp.dst               = dst + oc * dst_oc_stride + hw;
+            conv2d_bf16_kernel_table[oc_eff - 1][vecs - 1](kp);
+        }
+    }
+}
+
+static int64_t conv2d_bf16_cal_hw_l2_blk(const int64_t padded_k, const int64_t dst_hw)
+{
+    int64_t hw_l2_blk = round(SRC_L2_BLK_BYTES() / (padded_k * (int64_t)sizeof(uint16_t)), HW_KR_BLK());
+    hw_l2_blk         = max<int64_t>(hw_l2_blk, HW_KR_BLK());
+    hw_l2_blk         = min<int64_t>(hw_l2_blk, HW_L2_BLK_MAX());
+    return min<int64_t>(hw_l2_blk, round_up(dst_hw, HW_KR_BLK()));
+}
+
+uint64_t conv2d_bf16_avx512bf16_get_temp_buffer_bytes(
+    const conv2d_bf16_param &param,
+    const conv2d_bf16_algo_t algo,
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape)
+{
+    const int64_t batch    = src_shape->GetDim(0);
+    const int64_t src_hw   = src_shape->GetDim(2) * src_shape->GetDim(3);
+    const int64_t dst_hw   = dst_shape->GetDim(2) * dst_shape->GetDim(3);
+    const int64_t padded_k = round_up(param.channels / param.group * param.kernel_h * param.kernel_w, 2);
+
+    if (algo == conv2d_bf16_algo::DIRECT) {
+        return round_up(batch * param.group * padded_k * src_hw * sizeof(uint16_t), PPL_X86_CACHELINE_BYTES());
+    }
+
+    const uint64_t src_bf16_bytes = round_up(batch * param.channels * src_hw * sizeof(uint16_t), PPL_X86_CACHELINE_BYTES());
+    const uint64_t col_bytes      = round_up(padded_k * conv2d_bf16_cal_hw_l2_blk(padded_k, dst_hw) * sizeof(uint16_t), PPL_X86_CACHELINE_BYTES());
+    return src_bf16_bytes + col_bytes * PPL_OMP_MAX_THREADS();
+}
+
+ppl::common::RetCode conv2d_bf16_avx512bf16(
+    const conv2d_bf16_param &param,
+    const conv2d_bf16_algo_t algo,
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const uint16_t *cvt_filter,
+    const float *cvt_bias,
+    void *temp_buffer,
+    float *dst)
+{
+    const int64_t batch     = src_shape->GetDim(0);
+    const int64_t src_h     = src_shape->GetDim(2);
+    const int64_t src_w     = src_shape->GetDim(3);
+    const int64_t dst_h     = dst_shape->GetDim(2);
+    const int64_t dst_w     = dst_shape->GetDim(3);
+    const int64_t src_hw    = src_h * src_w;
+    const int64_t dst_hw    = dst_h * dst_w;
+    const int64_t ic_per_gp = param.channels / param.group;
+    const int64_t oc_per_gp = param.num_output / param.group;
+    const int64_t padded_k  = round_up(ic_per_gp * param.kernel_h * param.kernel_w, 2);
+    const int64_t padded_oc = round_up(oc_per_gp, OC_KR_BLK());
+
+    const int64_t hw_l2_blk   = conv2d_bf16_cal_hw_l2_blk(padded_k, dst_hw);
+    const int64_t num_threads = PPL_OMP_MAX_THREADS();
+    const int64_t hw_tasks    = div_up(dst_hw, hw_l2_blk);
+    const int64_t bgh_tasks   = batch * param.group * hw_tasks;
+    const int64_t oc_blks     = padded_oc / OC_KR_BLK();
+
+    // split output channels when there are too few tasks to feed all threads
+    int64_t oc_tasks = 1;
+    if (bgh_tasks < num_threads) {
+        oc_tasks = min<int64_t>(oc_blks, div_up(num_threads, bgh_tasks));
+    }
+    const int64_t oc_task_blk = div_up(oc_blks, oc_tasks) * OC_KR_BLK();
+    oc_tasks                  = div_up(padded_oc, oc_task_blk);
+
+    const int64_t flt_g_stride = padded_oc * padded_k;
+
+    if (algo == conv2d_bf16_algo::DIRECT) {
+        uint16_t *src_bf16 = reinterpret_cast<uint16_t *>(temp_buffer);
+        conv2d_bf16_cvt_src_interleave_avx512(src, batch * param.group, ic_per_gp, src_hw, src_bf16);
+
+        PRAGMA_OMP_PARALLEL_FOR()
+        for (int64_t task = 0; task < bgh_tasks * oc_tasks; ++task) {
+            const int64_t oc_task  = task % oc_tasks;
+            const int64_t hw_task  = task / oc_tasks % hw_tasks;
+            const int64_t bg       = task / oc_tasks / hw_tasks;
+            const int64_t g        = bg % param.group;
+            const int64_t hw_start = hw_task * hw_l2_blk;
+            const int64_t oc_start = oc_task * oc_task_blk;
+            conv2d_bf16_compute_block(
+                src_bf16 + bg * padded_k * src_hw + hw_start * 2,
+                src_hw * 2,
+                cvt_filter + g * flt_g_stride,
+                cvt_bias + g * padded_oc,
+                padded_k,
+                oc_start,
+                min(oc_start + oc_task_blk, oc_per_gp),
+                min(dst_hw - hw_start, hw_l2_blk),
+                dst_hw,
+                param.fuse_flag,
+                dst + bg * oc_per_gp * dst_hw + hw_start);
+        }
+        return ppl::common::RC_SUCCESS;
+    }
+
+    uint16_t *src_bf16      = reinterpret_cast<uint16_t *>(temp_buffer);
+    uint16_t *col_buf       = src_bf16 + round_up(batch * param.channels * src_hw * sizeof(uint16_t), PPL_X86_CACHELINE_BYTES()) / sizeof(uint16_t);
+    const int64_t col_elems = round_up(padded_k * hw_l2_blk * sizeof(uint16_t), PPL_X86_CACHELINE_BYTES()) / sizeof(uint16_t);
+    conv2d_bf16_cvt_src_avx512(src, batch * param.channels, src_hw, src_bf16);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t task = 0; task < bgh_tasks * oc_tasks; ++task) {
+        const int64_t oc_task  = task % oc_tasks;
+        const int64_t hw_task  = task / oc_tasks % hw_tasks;
+        const int64_t bg       = task / oc_tasks / hw_tasks;
+        const int64_t g        = bg % param.group;
+        const int64_t hw_start = hw_task * hw_l2_blk;
+        const int64_t hw_eff   = min(dst_hw - hw_start, hw_l2_blk);
+        const int64_t oc_start = oc_task * oc_task_blk;
+        uint16_t *col          = col_buf + PPL_OMP_THREAD_ID() * col_elems;
+
+        conv2d_bf16_im2col(param, src_bf16 + bg * ic_per_gp * src_hw, src_h, src_w, dst_w, hw_start, hw_eff, hw_l2_blk, col);
+        conv2d_bf16_compute_block(
+            col,
+            hw_l2_blk * 2,
+            cvt_filter + g * flt_g_stride,
+            cvt_bias + g * padded_oc,
+            padded_k,
+            oc_start,
+            min(oc_start + oc_task_blk, oc_per_gp),
+            hw_eff,
+            dst_hw,
+            param.fuse_flag,
+            dst + bg * oc_per_gp * dst_hw + hw_start);
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,212 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <new>
+#include <string.h>
+
+#include "ppl/kernel/x86/bf16/conv2d.h"
+#include "ppl/kernel/x86/bf16/common/cvt_tools_bf16.h"
+#include "ppl/kernel/x86/common/simd_tools.h"
+
+#ifdef PPL_USE_X86_AVX512BF16
+#include "ppl/kernel/x86/bf16/conv2d/avx512bf16/conv2d_bf16_avx512bf16.h"
+#endif
+
+namespace ppl { namespace kernel { namespace x86 {
+
+conv2d_bf16_algo_info conv2d_bf16_algo_selector::select_algo(const ppl::common::dataformat_t src_format, const conv2d_bf16_param &param, const ppl::common::isa_t isa_flags)
+{
+    static conv2d_bf16_algo_info unknown_info = {
+        conv2d_bf16_algo::UNKNOWN,
+        ppl::common::ISA_UNKNOWN,
+        ppl::common::DATAFORMAT_UNKNOWN,
+        ppl::common::DATAFORMAT_UNKNOWN};
+
+    // without native bf16 dot products converting to bf16 only loses precision
+#ifdef PPL_USE_X86_AVX512BF16
+    if ((isa_flags & ppl::common::ISA_X86_AVX512) && cpu_supports_avx512bf16()) {
+        conv2d_bf16_algo_info info = {
+            param.is_pointwise() ? conv2d_bf16_algo::DIRECT : conv2d_bf16_algo::IM2COL_GEMM,
+            ppl::common::ISA_X86_AVX512,
+            ppl::common::DATAFORMAT_NDARRAY,
+            ppl::common::DATAFORMAT_NDARRAY};
+        conv2d_bf16_manager mgr(param, info, nullptr);
+        if (mgr.is_supported()) {
+            return info;
+        }
+    }
+#endif
+
+    return unknown_info;
+}
+
+conv2d_bf16_manager *conv2d_bf16_algo_selector::gen_algo(const conv2d_bf16_param &param, const conv2d_bf16_algo_info &algo_info, ppl::common::Allocator *allocator)
+{
+    if (algo_info.algo_type == conv2d_bf16_algo::UNKNOWN) {
+        return nullptr;
+    }
+    return new (std::nothrow) conv2d_bf16_manager(param, algo_info, allocator);
+}
+
+static int64_t conv2d_bf16_get_oc_blk(const conv2d_bf16_algo_info &algo_info)
+{
+#ifdef PPL_USE_X86_AVX512BF16
+    if (algo_info.isa & ppl::common::ISA_X86_AVX512) {
+        return CONV2D_BF16_AVX512BF16_OC_BLK();
+    }
+#endif
+    return 1;
+}
+
+bool conv2d_bf16_manager::is_supported()
+{
+    // depthwise has too little reduction per output to benefit from bf16 dot products
+    if (param_.is_depthwise()) {
+        return false;
+    }
+    return !(param_.fuse_flag & conv_fuse_flag::SUM);
+}
+
+ppl::common::RetCode conv2d_bf16_manager::alloc_cvt_weights()
+{
+    if (cvt_weights_ != nullptr) {
+        return ppl::common::RC_PERMISSION_DENIED;
+    }
+
+    const int64_t oc_blk    = conv2d_bf16_get_oc_blk(algo_info_);
+    const int64_t ic_per_gp = param_.channels / param_.group;
+    const int64_t oc_per_gp = param_.num_output / param_.group;
+    const int64_t k_per_gp  = ic_per_gp * param_.kernel_h * param_.kernel_w;
+    const int64_t padded_oc = round_up(oc_per_gp, oc_blk);
+    const int64_t padded_k  = round_up(k_per_gp, 2);
+
+    const uint64_t filter_bytes = round_up(param_.group * padded_oc * padded_k * sizeof(uint16_t), PPL_X86_CACHELINE_BYTES());
+    const uint64_t vector_bytes = round_up(param_.group * padded_oc * sizeof(float), PPL_X86_CACHELINE_BYTES());
+    cvt_weights_ = allocator_->Alloc(filter_bytes + vector_bytes);
+    if (!cvt_weights_) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+    cvt_weights_bytes_ = filter_bytes + vector_bytes;
+    cvt_filter_        = reinterpret_cast<uint16_t *>(cvt_weights_);
+    cvt_bias_          = reinterpret_cast<float *>(reinterpret_cast<uint8_t *>(cvt_weights_) + filter_bytes);
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode conv2d_bf16_manager::set_cvt_weights(const void *cvt_weights, const uint64_t cvt_weights_bytes)
+{
+    ppl::common::RetCode rc = alloc_cvt_weights();
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+    if (cvt_weights_bytes != cvt_weights_bytes_) {
+        release_cvt_weights();
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    memcpy(cvt_weights_, cvt_weights, cvt_weights_bytes);
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode conv2d_bf16_manager::gen_cvt_weights(const float *filter, const float *bias)
+{
+    ppl::common::RetCode rc = alloc_cvt_weights();
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+
+    const int64_t oc_blk    = conv2d_bf16_get_oc_blk(algo_info_);
+    const int64_t ic_per_gp = param_.channels / param_.group;
+    const int64_t oc_per_gp = param_.num_output / param_.group;
+    const int64_t k_per_gp  = ic_per_gp * param_.kernel_h * param_.kernel_w;
+    const int64_t padded_oc = round_up(oc_per_gp, oc_blk);
+    const int64_t padded_k  = round_up(k_per_gp, 2);
+
+    for (int64_t g = 0; g < param_.group; ++g) {
+        cvt_and_pack_filter_bf16(
+            filter + g * oc_per_gp * k_per_gp,
+            oc_per_gp,
+            k_per_gp,
+            oc_blk,
+            padded_oc,
+            padded_k,
+            cvt_filter_ + g * padded_oc * padded_k);
+        memset(cvt_bias_ + g * padded_oc, 0, padded_oc * sizeof(float));
+        if (bias) {
+            memcpy(cvt_bias_ + g * padded_oc, bias + g * oc_per_gp, oc_per_gp * sizeof(float));
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+conv2d_bf16_executor *conv2d_bf16_manager::gen_executor()
+{
+    return new (std::nothrow) conv2d_bf16_executor(this);
+}
+
+const conv2d_bf16_param *conv2d_bf16_executor::conv_param() const
+{
+    return &mgr_->param();
+}
+
+uint64_t conv2d_bf16_executor::cal_temp_buffer_size()
+{
+#ifdef PPL_USE_X86_AVX512BF16
+    if (mgr_->algo_info().isa & ppl::common::ISA_X86_AVX512) {
+        return max<uint64_t>(conv2d_bf16_avx512bf16_get_temp_buffer_bytes(
+            mgr_->param(), mgr_->algo_info().algo_type, src_shape_, dst_shape_), 64u);
+    }
+#endif
+    return 64u;
+}
+
+ppl::common::RetCode conv2d_bf16_executor::prepare()
+{
+    if (!mgr_ || !src_shape_ || !dst_shape_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    if (src_shape_->GetDimCount() != 4 || src_shape_->GetDataFormat() != ppl::common::DATAFORMAT_NDARRAY) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode conv2d_bf16_executor::execute()
+{
+    if (!mgr_ || !mgr_->cvt_filter() || !src_ || !dst_ || !temp_buffer_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+#ifdef PPL_USE_X86_AVX512BF16
+    if (mgr_->algo_info().isa & ppl::common::ISA_X86_AVX512) {
+        return conv2d_bf16_avx512bf16(
+            mgr_->param(),
+            mgr_->algo_info().algo_type,
+            src_shape_,
+            dst_shape_,
+            src_,
+            mgr_->cvt_filter(),
+            mgr_->cvt_bias(),
+            temp_buffer_,
+            dst_);
+    }
+#endif
+
+    return ppl::common::RC_UNSUPPORTED;
+}
+
+}}}; // namespace ppl::kernel::x86
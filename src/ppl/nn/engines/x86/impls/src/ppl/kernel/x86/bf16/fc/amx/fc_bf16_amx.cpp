@@ -0,0 +1,156 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/bf16/fc/amx/fc_bf16_amx.h"
+#include "ppl/kernel/x86/bf16/common/cvt_tools_bf16_avx512.h"
+
+#define OC_DT_BLK() FC_BF16_AMX_OC_DT_BLK()
+#define OC_KR_BLK() FC_BF16_AMX_OC_BLK()
+#define K_DT_BLK()  FC_BF16_AMX_K_BLK()
+#define B_DT_BLK()  16
+#define B_KR_BLK()  (2 * B_DT_BLK())
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// tile 0-3: dst[2][2], tile 4-5: src[2], tile 6-7: flt[2]
+struct fc_bf16_amx_tile_config {
+    uint8_t palette_id;
+    uint8_t start_row;
+    uint8_t reserved[14];
+    uint16_t colsb[16];
+    uint8_t rows[16];
+};
+
+static void fc_bf16_amx_load_tile_config()
+{
+    fc_bf16_amx_tile_config cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.palette_id = 1;
+    for (int32_t t = 0; t < 8; ++t) {
+        cfg.rows[t]  = B_DT_BLK();
+        cfg.colsb[t] = 64;
+    }
+    _tile_loadconfig(&cfg);
+}
+
+// dst[B_KR_BLK()][OC_KR_BLK()] = sum(src[B_KR_BLK()][k] * flt[k][OC_KR_BLK()]), dst is stored to a temporary fp32 block
+static void fc_bf16_amx_kernel(
+    const uint16_t *src,
+    const uint16_t *flt,
+    const int64_t padded_k,
+    float *dst_blk)
+{
+    const int64_t src_stride    = padded_k * sizeof(uint16_t);
+    const int64_t flt_oc_stride = padded_k * OC_DT_BLK();
+    const int64_t dst_stride    = OC_KR_BLK() * sizeof(float);
+
+    _tile_zero(0);
+    _tile_zero(1);
+    _tile_zero(2);
+    _tile_zero(3);
+    for (int64_t k = 0; k < padded_k; k += K_DT_BLK()) {
+        _tile_loadd(4, src + k, src_stride);
+        _tile_loadd(5, src + B_DT_BLK() * padded_k + k, src_stride);
+        _tile_loadd(6, flt + k * OC_DT_BLK(), OC_DT_BLK() * 2 * sizeof(uint16_t));
+        _tile_loadd(7, flt + flt_oc_stride + k * OC_DT_BLK(), OC_DT_BLK() * 2 * sizeof(uint16_t));
+        _tile_dpbf16ps(0, 4, 6);
+        _tile_dpbf16ps(1, 4, 7);
+        _tile_dpbf16ps(2, 5, 6);
+        _tile_dpbf16ps(3, 5, 7);
+    }
+    _tile_stored(0, dst_blk, dst_stride);
+    _tile_stored(1, dst_blk + OC_DT_BLK(), dst_stride);
+    _tile_stored(2, dst_blk + B_DT_BLK() * OC_KR_BLK(), dst_stride);
+    _tile_stored(3, dst_blk + B_DT_BLK() * OC_KR_BLK() + OC_DT_BLK(), dst_stride);
+}
+
+uint64_t fc_bf16_amx_get_temp_buffer_bytes(
+    const fc_bf16_param &param,
+    const int64_t batch)
+{
+    const uint64_t src_bytes = round_up(round_up(batch, B_KR_BLK()) * round_up(param.channels, K_DT_BLK()) * sizeof(uint16_t), PPL_X86_CACHELINE_BYTES());
+    const uint64_t dst_bytes = B_KR_BLK() * OC_KR_BLK() * sizeof(float);
+    return src_bytes + dst_bytes * PPL_OMP_MAX_THREADS();
+}
+
+ppl::common::RetCode fc_bf16_amx(
+    const fc_bf16_param &param,
+    const int64_t batch,
+    const float *src,
+    const uint16_t *cvt_filter,
+    const float *cvt_bias,
+    void *temp_buffer,
+    float *dst)
+{
+    const int64_t padded_k = round_up(param.channels, K_DT_BLK());
+    const int64_t padded_b = round_up(batch, B_KR_BLK());
+    uint16_t *src_bf16     = reinterpret_cast<uint16_t *>(temp_buffer);
+    float *dst_blk_buf     = reinterpret_cast<float *>(
+        reinterpret_cast<uint8_t *>(temp_buffer) + round_up(padded_b * padded_k * sizeof(uint16_t), PPL_X86_CACHELINE_BYTES()));
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t b = 0; b < padded_b; ++b) {
+        if (b < batch) {
+            cvt_fp32_to_bf16_avx512(src + b * param.channels, param.channels, padded_k, src_bf16 + b * padded_k);
+        } else {
+            memset(src_bf16 + b * padded_k, 0, padded_k * sizeof(uint16_t));
+        }
+    }
+
+    const int64_t b_tasks  = padded_b / B_KR_BLK();
+    const int64_t oc_tasks = div_up(param.num_output, OC_KR_BLK());
+    const bool with_relu   = param.fuse_flag & fc_fuse_flag::RELU;
+
+    PRAGMA_OMP_PARALLEL()
+    {
+        // tile configuration is per thread
+        fc_bf16_amx_load_tile_config();
+        float *dst_blk = dst_blk_buf + PPL_OMP_THREAD_ID() * B_KR_BLK() * OC_KR_BLK();
+
+        PRAGMA_OMP_FOR()
+        for (int64_t task = 0; task < b_tasks * oc_tasks; ++task) {
+            const int64_t oc     = task % oc_tasks * OC_KR_BLK();
+            const int64_t b      = task / oc_tasks * B_KR_BLK();
+            const int64_t b_eff  = min<int64_t>(batch - b, B_KR_BLK());
+            const int64_t oc_eff = min<int64_t>(param.num_output - oc, OC_KR_BLK());
+
+            fc_bf16_amx_kernel(src_bf16 + b * padded_k, cvt_filter + oc * padded_k, padded_k, dst_blk);
+
+            for (int64_t i = 0; i < b_eff; ++i) {
+                float *l_dst = dst + (b + i) * param.num_output + oc;
+                for (int64_t o = 0; o < oc_eff; o += OC_DT_BLK()) {
+                    const int64_t o_eff  = min<int64_t>(oc_eff - o, OC_DT_BLK());
+                    const __mmask16 mask = o_eff == OC_DT_BLK() ? 0xffff : ((1 << o_eff) - 1);
+                    // masked load, cvt_bias may come from serialized data without padding
+                    const __m512 bias = _mm512_maskz_loadu_ps(mask, cvt_bias + oc + o);
+                    __m512 v = _mm512_add_ps(_mm512_loadu_ps(dst_blk + i * OC_KR_BLK() + o), bias);
+                    if (with_relu) v = _mm512_max_ps(v, _mm512_setzero_ps());
+                    _mm512_mask_storeu_ps(l_dst + o, mask, v);
+                }
+            }
+        }
+
+        _tile_release();
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,47 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_BF16_FC_AMX_FC_BF16_AMX_H_
+#define __ST_PPL_KERNEL_X86_BF16_FC_AMX_FC_BF16_AMX_H_
+
+#include "ppl/kernel/x86/bf16/fc.h"
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// oc_blk of the converted filter, the columns of a tile
+#define FC_BF16_AMX_OC_DT_BLK() 16
+// output channels and channels of the converted filter are padded to these
+#define FC_BF16_AMX_OC_BLK() 32
+#define FC_BF16_AMX_K_BLK()  32
+
+uint64_t fc_bf16_amx_get_temp_buffer_bytes(
+    const fc_bf16_param &param,
+    const int64_t batch);
+
+ppl::common::RetCode fc_bf16_amx(
+    const fc_bf16_param &param,
+    const int64_t batch,
+    const float *src,
+    const uint16_t *cvt_filter,
+    const float *cvt_bias,
+    void *temp_buffer,
+    float *dst);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,171 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/bf16/fc/avx512bf16/fc_bf16_avx512bf16.h"
+#include "ppl/kernel/x86/bf16/common/cvt_tools_bf16_avx512.h"
+
+#define OC_DT_BLK() FC_BF16_AVX512BF16_OC_BLK()
+#define OC_KR_BLK() (4 * OC_DT_BLK())
+#define B_KR_BLK()  6
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct fc_bf16_kernel_param {
+    const uint16_t *src;       // [B_KR_BLK()][padded_k]
+    const uint16_t *flt;       // [OC_KR_BLK() / OC_DT_BLK()][padded_k / 2][OC_DT_BLK()][2]
+    const float *bias;
+    float *dst;
+    int64_t padded_k;
+    int64_t dst_b_stride;
+    __mmask16 tail_mask;       // mask of the last oc vector
+    fc_fuse_flag_t fuse_flag;
+};
+
+typedef void (*fc_bf16_kernel_func_t)(const fc_bf16_kernel_param &);
+
+// dst[b_len][oc] = sum(src[b_len][k] * flt[k][oc]), src is broadcast along oc
+template <int64_t b_len, int64_t oc_len>
+void fc_bf16_kernel_avx512bf16(const fc_bf16_kernel_param &kp)
+{
+#define DECL_ACC(B) __m512 acc##B##0 = _mm512_setzero_ps(), acc##B##1 = _mm512_setzero_ps(), \
+                           acc##B##2 = _mm512_setzero_ps(), acc##B##3 = _mm512_setzero_ps()
+#define DPBF16(B)                                                                  \
+    do {                                                                           \
+        if (b_len > B) {                                                           \
+            const __m512bh s = (__m512bh)_mm512_set1_epi32(*(const int32_t *)(l_src + B * kp.padded_k)); \
+            if (oc_len > 0) acc##B##0 = _mm512_dpbf16_ps(acc##B##0, s, w0);        \
+            if (oc_len > 1) acc##B##1 = _mm512_dpbf16_ps(acc##B##1, s, w1);        \
+            if (oc_len > 2) acc##B##2 = _mm512_dpbf16_ps(acc##B##2, s, w2);        \
+            if (oc_len > 3) acc##B##3 = _mm512_dpbf16_ps(acc##B##3, s, w3);        \
+        }                                                                          \
+    } while (0)
+#define STORE_VEC(B, O)                                                                      \
+    do {                                                                                     \
+        if (oc_len > O) {                                                                    \
+            __m512 v = _mm512_add_ps(acc##B##O, bias##O);                                    \
+            if (kp.fuse_flag & fc_fuse_flag::RELU) v = _mm512_max_ps(v, _mm512_setzero_ps()); \
+            float *l_dst = kp.dst + B * kp.dst_b_stride + O * OC_DT_BLK();                   \
+            if (oc_len == O + 1) _mm512_mask_storeu_ps(l_dst, kp.tail_mask, v);              \
+            else _mm512_storeu_ps(l_dst, v);                                                 \
+        }                                                                                    \
+    } while (0)
+#define STORE_ACC(B)          \
+    do {                      \
+        if (b_len > B) {      \
+            STORE_VEC(B, 0);  \
+            STORE_VEC(B, 1);  \
+            STORE_VEC(B, 2);  \
+            STORE_VEC(B, 3);  \
+        }                     \
+    } while (0)
+
+    DECL_ACC(0); DECL_ACC(1); DECL_ACC(2);
+    DECL_ACC(3); DECL_ACC(4); DECL_ACC(5);
+
+    const int64_t flt_oc_stride = kp.padded_k * OC_DT_BLK();
+    const uint16_t *l_src       = kp.src;
+    const uint16_t *l_flt       = kp.flt;
+    for (int64_t k = 0; k < kp.padded_k; k += 2) {
+        __m512bh w0, w1, w2, w3;
+        if (oc_len > 0) w0 = (__m512bh)_mm512_loadu_si512(l_flt + 0 * flt_oc_stride);
+        if (oc_len > 1) w1 = (__m512bh)_mm512_loadu_si512(l_flt + 1 * flt_oc_stride);
+        if (oc_len > 2) w2 = (__m512bh)_mm512_loadu_si512(l_flt + 2 * flt_oc_stride);
+        if (oc_len > 3) w3 = (__m512bh)_mm512_loadu_si512(l_flt + 3 * flt_oc_stride);
+        DPBF16(0); DPBF16(1); DPBF16(2);
+        DPBF16(3); DPBF16(4); DPBF16(5);
+        l_src += 2;
+        l_flt += OC_DT_BLK() * 2;
+    }
+
+    __m512 bias0, bias1, bias2, bias3;
+    if (oc_len > 0) bias0 = _mm512_loadu_ps(kp.bias + 0 * OC_DT_BLK());
+    if (oc_len > 1) bias1 = _mm512_loadu_ps(kp.bias + 1 * OC_DT_BLK());
+    if (oc_len > 2) bias2 = _mm512_loadu_ps(kp.bias + 2 * OC_DT_BLK());
+    if (oc_len > 3) bias3 = _mm512_loadu_ps(kp.bias + 3 * OC_DT_BLK());
+
+    STORE_ACC(0); STORE_ACC(1); STORE_ACC(2);
+    STORE_ACC(3); STORE_ACC(4); STORE_ACC(5);
+
+#undef DECL_ACC
+#undef DPBF16
+#undef STORE_VEC
+#undef STORE_ACC
+}
+
+static const fc_bf16_kernel_func_t fc_bf16_kernel_table[B_KR_BLK()][OC_KR_BLK() / OC_DT_BLK()] = {
+    {fc_bf16_kernel_avx512bf16<1, 1>, fc_bf16_kernel_avx512bf16<1, 2>, fc_bf16_kernel_avx512bf16<1, 3>, fc_bf16_kernel_avx512bf16<1, 4>},
+    {fc_bf16_kernel_avx512bf16<2, 1>, fc_bf16_kernel_avx512bf16<2, 2>, fc_bf16_kernel_avx512bf16<2, 3>, fc_bf16_kernel_avx512bf16<2, 4>},
+    {fc_bf16_kernel_avx512bf16<3, 1>, fc_bf16_kernel_avx512bf16<3, 2>, fc_bf16_kernel_avx512bf16<3, 3>, fc_bf16_kernel_avx512bf16<3, 4>},
+    {fc_bf16_kernel_avx512bf16<4, 1>, fc_bf16_kernel_avx512bf16<4, 2>, fc_bf16_kernel_avx512bf16<4, 3>, fc_bf16_kernel_avx512bf16<4, 4>},
+    {fc_bf16_kernel_avx512bf16<5, 1>, fc_bf16_kernel_avx512bf16<5, 2>, fc_bf16_kernel_avx512bf16<5, 3>, fc_bf16_kernel_avx512bf16<5, 4>},
+    {fc_bf16_kernel_avx512bf16<6, 1>, fc_bf16_kernel_avx512bf16<6, 2>, fc_bf16_kernel_avx512bf16<6, 3>, fc_bf16_kernel_avx512bf16<6, 4>},
+};
+
+uint64_t fc_bf16_avx512bf16_get_temp_buffer_bytes(
+    const fc_bf16_param &param,
+    const int64_t batch)
+{
+    return round_up(batch * round_up(param.channels, 2) * sizeof(uint16_t), PPL_X86_CACHELINE_BYTES());
+}
+
+ppl::common::RetCode fc_bf16_avx512bf16(
+    const fc_bf16_param &param,
+    const int64_t batch,
+    const float *src,
+    const uint16_t *cvt_filter,
+    const float *cvt_bias,
+    void *temp_buffer,
+    float *dst)
+{
+    const int64_t padded_k = round_up(param.channels, 2);
+    uint16_t *src_bf16     = reinterpret_cast<uint16_t *>(temp_buffer);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t b = 0; b < batch; ++b) {
+        cvt_fp32_to_bf16_avx512(src + b * param.channels, param.channels, padded_k, src_bf16 + b * padded_k);
+    }
+
+    const int64_t b_tasks  = div_up(batch, B_KR_BLK());
+    const int64_t oc_tasks = div_up(param.num_output, OC_KR_BLK());
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t task = 0; task < b_tasks * oc_tasks; ++task) {
+        const int64_t oc     = task % oc_tasks * OC_KR_BLK();
+        const int64_t b      = task / oc_tasks * B_KR_BLK();
+        const int64_t b_eff  = min<int64_t>(batch - b, B_KR_BLK());
+        const int64_t oc_eff = min<int64_t>(param.num_output - oc, OC_KR_BLK());
+        const int64_t vecs   = div_up(oc_eff, OC_DT_BLK());
+        const int64_t tail   = oc_eff - (vecs - 1) * OC_DT_BLK();
+
+        fc_bf16_kernel_param kp;
+        kp.src          = src_bf16 + b * padded_k;
+        kp.flt          = cvt_filter + oc * padded_k;
+        kp.bias         = cvt_bias + oc;
+        kp.dst          = dst + b * param.num_output + oc;
+        kp.padded_k     = padded_k;
+        kp.dst_b_stride = param.num_output;
+        kp.tail_mask    = tail == OC_DT_BLK() ? 0xffff : ((1 << tail) - 1);
+        kp.fuse_flag    = param.fuse_flag;
+        fc_bf16_kernel_table[b_eff - 1][vecs - 1](kp);
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
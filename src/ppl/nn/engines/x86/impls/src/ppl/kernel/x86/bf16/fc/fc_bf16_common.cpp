@@ -0,0 +1,238 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <new>
+#include <string.h>
+
+#include "ppl/kernel/x86/bf16/fc.h"
+#include "ppl/kernel/x86/bf16/common/cvt_tools_bf16.h"
+#include "ppl/kernel/x86/common/simd_tools.h"
+
+#ifdef PPL_USE_X86_AVX512BF16
+#include "ppl/kernel/x86/bf16/fc/avx512bf16/fc_bf16_avx512bf16.h"
+#endif
+#ifdef PPL_USE_X86_AMX
+#include "ppl/kernel/x86/bf16/fc/amx/fc_bf16_amx.h"
+#endif
+
+namespace ppl { namespace kernel { namespace x86 {
+
+fc_bf16_algo_info fc_bf16_algo_selector::select_algo(const ppl::common::dataformat_t src_format, const fc_bf16_param &param, const ppl::common::isa_t isa_flags)
+{
+    static fc_bf16_algo_info unknown_info = {
+        fc_bf16_algo::UNKNOWN,
+        ppl::common::ISA_UNKNOWN};
+
+#ifdef PPL_USE_X86_AMX
+    if ((isa_flags & ppl::common::ISA_X86_AVX512) && cpu_supports_amx_bf16()) {
+        fc_bf16_algo_info info = {
+            fc_bf16_algo::AMX,
+            ppl::common::ISA_X86_AVX512};
+        fc_bf16_manager mgr(param, info, nullptr);
+        if (mgr.is_supported()) {
+            return info;
+        }
+    }
+#endif
+
+#ifdef PPL_USE_X86_AVX512BF16
+    if ((isa_flags & ppl::common::ISA_X86_AVX512) && cpu_supports_avx512bf16()) {
+        fc_bf16_algo_info info = {
+            fc_bf16_algo::STANDARD,
+            ppl::common::ISA_X86_AVX512};
+        fc_bf16_manager mgr(param, info, nullptr);
+        if (mgr.is_supported()) {
+            return info;
+        }
+    }
+#endif
+
+    return unknown_info;
+}
+
+fc_bf16_manager *fc_bf16_algo_selector::gen_algo(const fc_bf16_param &param, const fc_bf16_algo_info &algo_info, ppl::common::Allocator *allocator)
+{
+    if (algo_info.algo_type == fc_bf16_algo::UNKNOWN) {
+        return nullptr;
+    }
+    return new (std::nothrow) fc_bf16_manager(param, algo_info, allocator);
+}
+
+static int64_t fc_bf16_get_oc_blk(const fc_bf16_algo_info &algo_info)
+{
+#ifdef PPL_USE_X86_AMX
+    if (algo_info.algo_type == fc_bf16_algo::AMX) {
+        return FC_BF16_AMX_OC_DT_BLK();
+    }
+#endif
+#ifdef PPL_USE_X86_AVX512BF16
+    if (algo_info.isa & ppl::common::ISA_X86_AVX512) {
+        return FC_BF16_AVX512BF16_OC_BLK();
+    }
+#endif
+    return 1;
+}
+
+// the amx kernels compute whole tiles, so output channels and channels are padded to tiles
+static void fc_bf16_get_padded_oc_k(const fc_bf16_param &param, const fc_bf16_algo_info &algo_info, int64_t *padded_oc, int64_t *padded_k)
+{
+#ifdef PPL_USE_X86_AMX
+    if (algo_info.algo_type == fc_bf16_algo::AMX) {
+        *padded_oc = round_up(param.num_output, FC_BF16_AMX_OC_BLK());
+        *padded_k  = round_up(param.channels, FC_BF16_AMX_K_BLK());
+        return;
+    }
+#endif
+    *padded_oc = round_up(param.num_output, fc_bf16_get_oc_blk(algo_info));
+    *padded_k  = round_up(param.channels, 2);
+}
+
+bool fc_bf16_manager::is_supported()
+{
+    return param_.channels > 0 && param_.num_output > 0;
+}
+
+ppl::common::RetCode fc_bf16_manager::alloc_cvt_weights()
+{
+    if (cvt_weights_ != nullptr) {
+        return ppl::common::RC_PERMISSION_DENIED;
+    }
+
+    int64_t padded_oc, padded_k;
+    fc_bf16_get_padded_oc_k(param_, algo_info_, &padded_oc, &padded_k);
+
+    const uint64_t filter_bytes = round_up(padded_oc * padded_k * sizeof(uint16_t), PPL_X86_CACHELINE_BYTES());
+    const uint64_t vector_bytes = round_up(padded_oc * sizeof(float), PPL_X86_CACHELINE_BYTES());
+    cvt_weights_ = allocator_->Alloc(filter_bytes + vector_bytes);
+    if (!cvt_weights_) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+    cvt_weights_bytes_ = filter_bytes + vector_bytes;
+    cvt_filter_        = reinterpret_cast<uint16_t *>(cvt_weights_);
+    cvt_bias_          = reinterpret_cast<float *>(reinterpret_cast<uint8_t *>(cvt_weights_) + filter_bytes);
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode fc_bf16_manager::set_cvt_weights(const void *cvt_weights, const uint64_t cvt_weights_bytes)
+{
+    ppl::common::RetCode rc = alloc_cvt_weights();
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+    if (cvt_weights_bytes != cvt_weights_bytes_) {
+        release_cvt_weights();
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    memcpy(cvt_weights_, cvt_weights, cvt_weights_bytes);
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode fc_bf16_manager::gen_cvt_weights(const float *filter, const float *bias)
+{
+    ppl::common::RetCode rc = alloc_cvt_weights();
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+
+    int64_t padded_oc, padded_k;
+    fc_bf16_get_padded_oc_k(param_, algo_info_, &padded_oc, &padded_k);
+
+    cvt_and_pack_filter_bf16(
+        filter,
+        param_.num_output,
+        param_.channels,
+        fc_bf16_get_oc_blk(algo_info_),
+        padded_oc,
+        padded_k,
+        cvt_filter_);
+    memset(cvt_bias_, 0, padded_oc * sizeof(float));
+    if (bias) {
+        memcpy(cvt_bias_, bias, param_.num_output * sizeof(float));
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+fc_bf16_executor *fc_bf16_manager::gen_executor()
+{
+    return new (std::nothrow) fc_bf16_executor(this);
+}
+
+const fc_bf16_param *fc_bf16_executor::fc_param() const
+{
+    return &mgr_->param();
+}
+
+uint64_t fc_bf16_executor::cal_temp_buffer_size()
+{
+#ifdef PPL_USE_X86_AMX
+    if (mgr_->algo_info().algo_type == fc_bf16_algo::AMX) {
+        return max<uint64_t>(fc_bf16_amx_get_temp_buffer_bytes(mgr_->param(), src_shape_->GetDim(0)), 64u);
+    }
+#endif
+#ifdef PPL_USE_X86_AVX512BF16
+    if (mgr_->algo_info().isa & ppl::common::ISA_X86_AVX512) {
+        return max<uint64_t>(fc_bf16_avx512bf16_get_temp_buffer_bytes(mgr_->param(), src_shape_->GetDim(0)), 64u);
+    }
+#endif
+    return 64u;
+}
+
+ppl::common::RetCode fc_bf16_executor::prepare()
+{
+    if (!mgr_ || !src_shape_ || !dst_shape_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode fc_bf16_executor::execute()
+{
+    if (!mgr_ || !mgr_->cvt_filter() || !src_ || !dst_ || !temp_buffer_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+#ifdef PPL_USE_X86_AMX
+    if (mgr_->algo_info().algo_type == fc_bf16_algo::AMX) {
+        return fc_bf16_amx(
+            mgr_->param(),
+            src_shape_->GetDim(0),
+            src_,
+            mgr_->cvt_filter(),
+            mgr_->cvt_bias(),
+            temp_buffer_,
+            dst_);
+    }
+#endif
+#ifdef PPL_USE_X86_AVX512BF16
+    if (mgr_->algo_info().isa & ppl::common::ISA_X86_AVX512) {
+        return fc_bf16_avx512bf16(
+            mgr_->param(),
+            src_shape_->GetDim(0),
+            src_,
+            mgr_->cvt_filter(),
+            mgr_->cvt_bias(),
+            temp_buffer_,
+            dst_);
+    }
+#endif
+
+    return ppl::common::RC_UNSUPPORTED;
+}
+
+}}}; // namespace ppl::kernel::x86
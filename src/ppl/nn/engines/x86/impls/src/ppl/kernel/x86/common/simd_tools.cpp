@@ -16,6 +16,15 @@
 // under the License.
 
 #include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
 
 #include "ppl/kernel/x86/common/internal_include.h"
 #include "ppl/common/sys.h"
@@ -37,4 +46,78 @@ void set_denormals_zero(const int32_t on) {
     }
 }
 
+// returns false if the leaf is not supported
+static bool cpuid_count(const uint32_t leaf, const uint32_t sub_leaf, uint32_t regs[4])
+{
+#ifdef _MSC_VER
+    int32_t r[4];
+    __cpuid(r, 0);
+    if ((uint32_t)r[0] < leaf) {
+        return false;
+    }
+    __cpuidex(r, leaf, sub_leaf);
+    for (int32_t i = 0; i < 4; ++i) {
+        regs[i] = r[i];
+    }
+    return true;
+#else
+    if (__get_cpuid_max(0, nullptr) < leaf) {
+        return false;
+    }
+    __cpuid_count(leaf, sub_leaf, regs[0], regs[1], regs[2], regs[3]);
+    return true;
+#endif
+}
+
+bool cpu_supports_avx512vnni()
+{
+    // cpuid leaf 7, sub-leaf 0, ecx bit 11
+    uint32_t regs[4];
+    if (!cpuid_count(7, 0, regs)) {
+        return false;
+    }
+    return (regs[2] >> 11) & 1;
+}
+
+bool cpu_supports_avx512bf16()
+{
+    // cpuid leaf 7, sub-leaf 1, eax bit 5
+    uint32_t regs[4];
+    if (!cpuid_count(7, 0, regs) || regs[0] < 1) {
+        return false;
+    }
+    cpuid_count(7, 1, regs);
+    return (regs[0] >> 5) & 1;
+}
+
+static bool request_amx_permission()
+{
+#if defined(__linux__)
+    // tile data is disabled for user space by default, ask the kernel to enable it for this process
+    const int64_t ARCH_REQ_XCOMP_PERM = 0x1023;
+    const int64_t XFEATURE_XTILEDATA  = 18;
+    return syscall(SYS_arch_prctl, ARCH_REQ_XCOMP_PERM, XFEATURE_XTILEDATA) == 0;
+#elif defined(_MSC_VER)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool cpu_supports_amx_bf16()
+{
+    // cpuid leaf 7, sub-leaf 0, edx bit 22 for amx-bf16 and bit 24 for amx-tile
+    static const bool supported = []() -> bool {
+        uint32_t regs[4];
+        if (!cpuid_count(7, 0, regs)) {
+            return false;
+        }
+        if (!((regs[3] >> 22) & 1) || !((regs[3] >> 24) & 1)) {
+            return false;
+        }
+        return request_amx_permission();
+    }();
+    return supported;
+}
+
 }}};
@@ -52,10 +52,36 @@ void set_omp_core_binding(const int32_t *cores, const int32_t num_cores, const i
 #endif
 }
 
+void unset_omp_core_binding() {
+#if defined(__linux__)
+    cpu_set_t cpuset;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+        LOG(ERROR) << "Get core binding failed";
+        return;
+    }
+    PRAGMA_OMP_PARALLEL()
+    {
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+            LOG(ERROR) << "Core unbinding failed";
+        }
+    }
+#endif
+}
+
 int32_t get_omp_max_threads()
 {
     return PPL_OMP_MAX_THREADS();
 }
+
+void set_omp_num_threads(const int32_t num_threads)
+{
+#ifdef PPL_USE_X86_OMP
+    if (num_threads > 0) {
+        omp_set_num_threads(num_threads);
+    }
+#endif
+}
+
 // A very naive version
 single_parallel_loop_config_t select_single_parallel_loop(
     const std::vector<int64_t> &iter_of_loop,
@@ -0,0 +1,77 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_ATTENTION_ATTENTION_COMMON_H_
+#define __ST_PPL_KERNEL_X86_FP32_ATTENTION_ATTENTION_COMMON_H_
+
+#include <vector>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// rows of the attention matrix computed together, they share every load of K and V
+#define ATTENTION_M_BLK() 4
+
+struct attention_mask_info {
+    std::vector<int64_t> batch_offsets;
+    int64_t row_stride = 0;
+    int64_t col_stride = 0;
+};
+
+inline void attention_init_mask_info(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *k_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    attention_mask_info *info)
+{
+    const int64_t dim_count = q_shape->GetDimCount();
+    const int64_t mask_dim_count = mask_shape->GetDimCount();
+
+    std::vector<int64_t> dims(q_shape->GetDims(), q_shape->GetDims() + dim_count);
+    dims[dim_count - 1] = k_shape->GetDim(dim_count - 1);
+
+    // dims of mask are aligned to the right, broadcasted dims get zero strides
+    std::vector<int64_t> strides(dim_count, 0);
+    int64_t stride = 1;
+    for (int64_t i = mask_dim_count - 1; i >= 0; --i) {
+        const int64_t mask_dim = mask_shape->GetDim(i);
+        strides[dim_count - mask_dim_count + i] = mask_dim == 1 ? 0 : stride;
+        stride *= mask_dim;
+    }
+    info->row_stride = strides[dim_count - 2];
+    info->col_stride = strides[dim_count - 1];
+
+    int64_t batch = 1;
+    for (int64_t i = 0; i < dim_count - 2; ++i) {
+        batch *= dims[i];
+    }
+    info->batch_offsets.resize(batch);
+    for (int64_t b = 0; b < batch; ++b) {
+        int64_t rem = b;
+        int64_t offset = 0;
+        for (int64_t i = dim_count - 3; i >= 0; --i) {
+            offset += (rem % dims[i]) * strides[i];
+            rem /= dims[i];
+        }
+        info->batch_offsets[b] = offset;
+    }
+}
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,148 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+#include <float.h>
+
+#include "ppl/kernel/x86/fp32/attention.h"
+#include "ppl/kernel/x86/fp32/attention/attention_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+uint64_t attention_fp32_get_buffer_bytes(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *k_shape)
+{
+    const int64_t T = k_shape->GetDim(k_shape->GetDimCount() - 1);
+    return PPL_OMP_MAX_THREADS() * ATTENTION_M_BLK() * T * sizeof(float);
+}
+
+bool attention_fp32_check_shapes(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *k_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape)
+{
+    const uint32_t dim_count = q_shape->GetDimCount();
+    if (dim_count < 2 || k_shape->GetDimCount() != dim_count || v_shape->GetDimCount() != dim_count) {
+        return false;
+    }
+    for (uint32_t i = 0; i < dim_count - 2; ++i) {
+        if (k_shape->GetDim(i) != q_shape->GetDim(i) || v_shape->GetDim(i) != q_shape->GetDim(i)) {
+            return false;
+        }
+    }
+    const int64_t S = q_shape->GetDim(dim_count - 2);
+    const int64_t T = k_shape->GetDim(dim_count - 1);
+    if (k_shape->GetDim(dim_count - 2) != q_shape->GetDim(dim_count - 1) || v_shape->GetDim(dim_count - 2) != T) {
+        return false;
+    }
+    if (mask_shape) {
+        // right aligned broadcasting to [batch..., S, T]
+        const uint32_t mask_dim_count = mask_shape->GetDimCount();
+        if (mask_dim_count > dim_count) {
+            return false;
+        }
+        for (uint32_t i = 0; i < mask_dim_count; ++i) {
+            const int64_t m        = mask_shape->GetDim(mask_dim_count - 1 - i);
+            const int64_t expected = (i == 0) ? T : (i == 1 ? S : q_shape->GetDim(dim_count - 1 - i));
+            if (m != 1 && m != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+ppl::common::RetCode attention_fp32(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *k_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    const float *Q,
+    const float *K,
+    const float *V,
+    const float *mask,
+    const float scale,
+    void *temp_buffer,
+    float *dst)
+{
+    const int64_t dim_count = q_shape->GetDimCount();
+    const int64_t S = q_shape->GetDim(dim_count - 2);
+    const int64_t D = q_shape->GetDim(dim_count - 1);
+    const int64_t T = k_shape->GetDim(dim_count - 1);
+    const int64_t Dv = v_shape->GetDim(dim_count - 1);
+    int64_t batch = 1;
+    for (int64_t i = 0; i < dim_count - 2; ++i) {
+        batch *= q_shape->GetDim(i);
+    }
+
+    attention_mask_info mask_info;
+    if (mask) {
+        attention_init_mask_info(q_shape, k_shape, mask_shape, &mask_info);
+    }
+
+PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t task = 0; task < batch * S; ++task) {
+        const int64_t b = task / S;
+        const int64_t i = task % S;
+        const float *q = Q + (b * S + i) * D;
+        const float *k = K + b * D * T;
+        const float *v = V + b * T * Dv;
+        float *out = dst + (b * S + i) * Dv;
+        float *s = (float*)temp_buffer + PPL_OMP_THREAD_ID() * ATTENTION_M_BLK() * T;
+
+        for (int64_t t = 0; t < T; ++t) {
+            s[t] = 0.0f;
+        }
+        for (int64_t d = 0; d < D; ++d) {
+            const float qd = q[d];
+            for (int64_t t = 0; t < T; ++t) {
+                s[t] += qd * k[d * T + t];
+            }
+        }
+
+        float max_val = -FLT_MAX;
+        for (int64_t t = 0; t < T; ++t) {
+            s[t] *= scale;
+            if (mask) {
+                s[t] += mask[mask_info.batch_offsets[b] + i * mask_info.row_stride + t * mask_info.col_stride];
+            }
+            max_val = max(max_val, s[t]);
+        }
+        float exp_sum = 0.0f;
+        for (int64_t t = 0; t < T; ++t) {
+            s[t] = expf(s[t] - max_val);
+            exp_sum += s[t];
+        }
+        const float r_exp_sum = 1.0f / exp_sum;
+
+        for (int64_t j = 0; j < Dv; ++j) {
+            out[j] = 0.0f;
+        }
+        for (int64_t t = 0; t < T; ++t) {
+            const float p = s[t] * r_exp_sum;
+            for (int64_t j = 0; j < Dv; ++j) {
+                out[j] += p * v[t * Dv + j];
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,289 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+#include <float.h>
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/fp32/attention.h"
+#include "ppl/kernel/x86/fp32/attention/attention_common.h"
+#include "ppl/kernel/x86/common/math_fma.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// s[m_len][T] = q[m_len][D] * k[D][T] * scale, each loaded vector of k is shared by m_len rows
+template <int64_t m_len>
+static void attention_qk_fp32_fma(
+    const float *q,
+    const float *k,
+    const int64_t D,
+    const int64_t T,
+    const float scale,
+    float *s)
+{
+    const int64_t simd_w = 8;
+    const __m256 v_scale = _mm256_set1_ps(scale);
+
+    int64_t t = 0;
+    for (; t + 2 * simd_w <= T; t += 2 * simd_w) {
+        __m256 acc0[m_len], acc1[m_len];
+        for (int64_t r = 0; r < m_len; ++r) {
+            acc0[r] = _mm256_setzero_ps();
+            acc1[r] = _mm256_setzero_ps();
+        }
+        const float *l_k = k + t;
+        for (int64_t d = 0; d < D; ++d) {
+            const __m256 k0 = _mm256_loadu_ps(l_k);
+            const __m256 k1 = _mm256_loadu_ps(l_k + simd_w);
+            for (int64_t r = 0; r < m_len; ++r) {
+                const __m256 qv = _mm256_set1_ps(q[r * D + d]);
+                acc0[r] = _mm256_fmadd_ps(qv, k0, acc0[r]);
+                acc1[r] = _mm256_fmadd_ps(qv, k1, acc1[r]);
+            }
+            l_k += T;
+        }
+        for (int64_t r = 0; r < m_len; ++r) {
+            _mm256_storeu_ps(s + r * T + t, _mm256_mul_ps(acc0[r], v_scale));
+            _mm256_storeu_ps(s + r * T + t + simd_w, _mm256_mul_ps(acc1[r], v_scale));
+        }
+    }
+    for (; t + simd_w <= T; t += simd_w) {
+        __m256 acc0[m_len];
+        for (int64_t r = 0; r < m_len; ++r) {
+            acc0[r] = _mm256_setzero_ps();
+        }
+        const float *l_k = k + t;
+        for (int64_t d = 0; d < D; ++d) {
+            const __m256 k0 = _mm256_loadu_ps(l_k);
+            for (int64_t r = 0; r < m_len; ++r) {
+                acc0[r] = _mm256_fmadd_ps(_mm256_set1_ps(q[r * D + d]), k0, acc0[r]);
+            }
+            l_k += T;
+        }
+        for (int64_t r = 0; r < m_len; ++r) {
+            _mm256_storeu_ps(s + r * T + t, _mm256_mul_ps(acc0[r], v_scale));
+        }
+    }
+    for (; t < T; ++t) {
+        for (int64_t r = 0; r < m_len; ++r) {
+            float acc = 0.0f;
+            for (int64_t d = 0; d < D; ++d) {
+                acc += q[r * D + d] * k[d * T + t];
+            }
+            s[r * T + t] = acc * scale;
+        }
+    }
+}
+
+// adds mask to s and replaces each row by exp(s - max(s)), 1 / sum(exp) of each row goes to r_exp_sum
+static void attention_softmax_fp32_fma(
+    const int64_t m_len,
+    const int64_t T,
+    const float *mask,
+    const int64_t mask_row_stride,
+    const int64_t mask_col_stride,
+    float *s,
+    float *r_exp_sum)
+{
+    const int64_t simd_w = 8;
+    const int64_t unroll_T = T / simd_w * simd_w;
+    float tmp[simd_w];
+
+    for (int64_t r = 0; r < m_len; ++r) {
+        float *l_s = s + r * T;
+        if (mask) {
+            const float *l_mask = mask + r * mask_row_stride;
+            if (mask_col_stride == 1) {
+                for (int64_t t = 0; t < unroll_T; t += simd_w) {
+                    _mm256_storeu_ps(l_s + t, _mm256_add_ps(_mm256_loadu_ps(l_s + t), _mm256_loadu_ps(l_mask + t)));
+                }
+                for (int64_t t = unroll_T; t < T; ++t) {
+                    l_s[t] += l_mask[t];
+                }
+            } else {
+                const __m256 v_mask = _mm256_set1_ps(l_mask[0]);
+                for (int64_t t = 0; t < unroll_T; t += simd_w) {
+                    _mm256_storeu_ps(l_s + t, _mm256_add_ps(_mm256_loadu_ps(l_s + t), v_mask));
+                }
+                for (int64_t t = unroll_T; t < T; ++t) {
+                    l_s[t] += l_mask[0];
+                }
+            }
+        }
+
+        __m256 v_max = _mm256_set1_ps(-FLT_MAX);
+        for (int64_t t = 0; t < unroll_T; t += simd_w) {
+            v_max = _mm256_max_ps(v_max, _mm256_loadu_ps(l_s + t));
+        }
+        _mm256_storeu_ps(tmp, v_max);
+        float max_val = -FLT_MAX;
+        for (int64_t k = 0; k < simd_w; ++k) {
+            max_val = max(max_val, tmp[k]);
+        }
+        for (int64_t t = unroll_T; t < T; ++t) {
+            max_val = max(max_val, l_s[t]);
+        }
+
+        v_max = _mm256_set1_ps(max_val);
+        __m256 v_sum = _mm256_setzero_ps();
+        for (int64_t t = 0; t < unroll_T; t += simd_w) {
+            const __m256 v_exp = _fma_exp_ps(_mm256_sub_ps(_mm256_loadu_ps(l_s + t), v_max));
+            _mm256_storeu_ps(l_s + t, v_exp);
+            v_sum = _mm256_add_ps(v_sum, v_exp);
+        }
+        _mm256_storeu_ps(tmp, v_sum);
+        float exp_sum = 0.0f;
+        for (int64_t k = 0; k < simd_w; ++k) {
+            exp_sum += tmp[k];
+        }
+        for (int64_t t = unroll_T; t < T; ++t) {
+            l_s[t] = expf(l_s[t] - max_val);
+            exp_sum += l_s[t];
+        }
+        r_exp_sum[r] = 1.0f / exp_sum;
+    }
+}
+
+// out[m_len][Dv] = s[m_len][T] * v[T][Dv] * r_exp_sum, the softmax normalization is applied at the end
+template <int64_t m_len>
+static void attention_pv_fp32_fma(
+    const float *s,
+    const float *v,
+    const float *r_exp_sum,
+    const int64_t T,
+    const int64_t Dv,
+    float *out)
+{
+    const int64_t simd_w = 8;
+
+    int64_t j = 0;
+    for (; j + 2 * simd_w <= Dv; j += 2 * simd_w) {
+        __m256 acc0[m_len], acc1[m_len];
+        for (int64_t r = 0; r < m_len; ++r) {
+            acc0[r] = _mm256_setzero_ps();
+            acc1[r] = _mm256_setzero_ps();
+        }
+        const float *l_v = v + j;
+        for (int64_t t = 0; t < T; ++t) {
+            const __m256 v0 = _mm256_loadu_ps(l_v);
+            const __m256 v1 = _mm256_loadu_ps(l_v + simd_w);
+            for (int64_t r = 0; r < m_len; ++r) {
+                const __m256 pv = _mm256_set1_ps(s[r * T + t]);
+                acc0[r] = _mm256_fmadd_ps(pv, v0, acc0[r]);
+                acc1[r] = _mm256_fmadd_ps(pv, v1, acc1[r]);
+            }
+            l_v += Dv;
+        }
+        for (int64_t r = 0; r < m_len; ++r) {
+            const __m256 v_r_sum = _mm256_set1_ps(r_exp_sum[r]);
+            _mm256_storeu_ps(out + r * Dv + j, _mm256_mul_ps(acc0[r], v_r_sum));
+            _mm256_storeu_ps(out + r * Dv + j + simd_w, _mm256_mul_ps(acc1[r], v_r_sum));
+        }
+    }
+    for (; j + simd_w <= Dv; j += simd_w) {
+        __m256 acc0[m_len];
+        for (int64_t r = 0; r < m_len; ++r) {
+            acc0[r] = _mm256_setzero_ps();
+        }
+        const float *l_v = v + j;
+        for (int64_t t = 0; t < T; ++t) {
+            const __m256 v0 = _mm256_loadu_ps(l_v);
+            for (int64_t r = 0; r < m_len; ++r) {
+                acc0[r] = _mm256_fmadd_ps(_mm256_set1_ps(s[r * T + t]), v0, acc0[r]);
+            }
+            l_v += Dv;
+        }
+        for (int64_t r = 0; r < m_len; ++r) {
+            _mm256_storeu_ps(out + r * Dv + j, _mm256_mul_ps(acc0[r], _mm256_set1_ps(r_exp_sum[r])));
+        }
+    }
+    for (; j < Dv; ++j) {
+        for (int64_t r = 0; r < m_len; ++r) {
+            float acc = 0.0f;
+            for (int64_t t = 0; t < T; ++t) {
+                acc += s[r * T + t] * v[t * Dv + j];
+            }
+            out[r * Dv + j] = acc * r_exp_sum[r];
+        }
+    }
+}
+
+ppl::common::RetCode attention_fp32_fma(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *k_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    const float *Q,
+    const float *K,
+    const float *V,
+    const float *mask,
+    const float scale,
+    void *temp_buffer,
+    float *dst)
+{
+    const int64_t dim_count = q_shape->GetDimCount();
+    const int64_t S = q_shape->GetDim(dim_count - 2);
+    const int64_t D = q_shape->GetDim(dim_count - 1);
+    const int64_t T = k_shape->GetDim(dim_count - 1);
+    const int64_t Dv = v_shape->GetDim(dim_count - 1);
+    int64_t batch = 1;
+    for (int64_t i = 0; i < dim_count - 2; ++i) {
+        batch *= q_shape->GetDim(i);
+    }
+
+    attention_mask_info mask_info;
+    if (mask) {
+        attention_init_mask_info(q_shape, k_shape, mask_shape, &mask_info);
+    }
+
+    const int64_t m_blk = ATTENTION_M_BLK();
+    const int64_t num_m_blk = div_up(S, m_blk);
+
+PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t task = 0; task < batch * num_m_blk; ++task) {
+        const int64_t b = task / num_m_blk;
+        const int64_t i = task % num_m_blk * m_blk;
+        const int64_t m_len = min(S - i, m_blk);
+        const float *l_q = Q + (b * S + i) * D;
+        const float *l_k = K + b * D * T;
+        const float *l_v = V + b * T * Dv;
+        const float *l_mask = mask ? mask + mask_info.batch_offsets[b] + i * mask_info.row_stride : nullptr;
+        float *l_dst = dst + (b * S + i) * Dv;
+        float *l_s = (float*)temp_buffer + PPL_OMP_THREAD_ID() * m_blk * T;
+        float r_exp_sum[ATTENTION_M_BLK()];
+
+        switch (m_len) {
+            case 4: attention_qk_fp32_fma<4>(l_q, l_k, D, T, scale, l_s); break;
+            case 3: attention_qk_fp32_fma<3>(l_q, l_k, D, T, scale, l_s); break;
+            case 2: attention_qk_fp32_fma<2>(l_q, l_k, D, T, scale, l_s); break;
+            default: attention_qk_fp32_fma<1>(l_q, l_k, D, T, scale, l_s); break;
+        }
+
+        attention_softmax_fp32_fma(m_len, T, l_mask, mask_info.row_stride, mask_info.col_stride, l_s, r_exp_sum);
+
+        switch (m_len) {
+            case 4: attention_pv_fp32_fma<4>(l_s, l_v, r_exp_sum, T, Dv, l_dst); break;
+            case 3: attention_pv_fp32_fma<3>(l_s, l_v, r_exp_sum, T, Dv, l_dst); break;
+            case 2: attention_pv_fp32_fma<2>(l_s, l_v, r_exp_sum, T, Dv, l_dst); break;
+            default: attention_pv_fp32_fma<1>(l_s, l_v, r_exp_sum, T, Dv, l_dst); break;
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -342,4 +342,42 @@ conv2d_fp32_manager *conv2d_algo_selector::gen_algo(const conv2d_fp32_param &par
     return nullptr;
 }
 
+std::vector<conv2d_fp32_algo_info> conv2d_algo_selector::get_candidate_algos(const ppl::common::dataformat_t src_format, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags)
+{
+    static const conv2d_fp32_algo_t algo_types[] = {
+        conv2d_fp32_algo::DEPTHWISE,
+        conv2d_fp32_algo::GEMM_DIRECT,
+        conv2d_fp32_algo::WINOGRAD_B4F3,
+        conv2d_fp32_algo::DIRECT,
+        conv2d_fp32_algo::IM2COL_GEMM,
+    };
+
+    std::vector<conv2d_fp32_algo_info> candidates;
+    const conv2d_fp32_algo_info selected_info = select_algo(src_format, param, isa_flags);
+    if (selected_info.algo_type == conv2d_fp32_algo::UNKNOWN) {
+        return candidates;
+    }
+    candidates.push_back(selected_info);
+
+    // candidates keep data formats of the selected one, so that layout of the graph is not changed
+    for (uint64_t i = 0; i < sizeof(algo_types) / sizeof(algo_types[0]); ++i) {
+        if (algo_types[i] == selected_info.algo_type) {
+            continue;
+        }
+        conv2d_fp32_algo_info algo_info = selected_info;
+        algo_info.algo_type             = algo_types[i];
+
+        auto mgr = gen_algo(param, algo_info, nullptr);
+        if (mgr == nullptr) {
+            continue;
+        }
+        if (mgr->is_supported()) {
+            candidates.push_back(algo_info);
+        }
+        delete mgr;
+    }
+
+    return candidates;
+}
+
 }}}; // namespace ppl::kernel::x86
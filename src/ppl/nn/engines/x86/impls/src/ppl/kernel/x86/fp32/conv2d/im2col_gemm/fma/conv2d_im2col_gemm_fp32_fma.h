@@ -35,6 +35,7 @@ public:
     uint64_t cal_temp_buffer_size() override;
     ppl::common::RetCode prepare() override;
     ppl::common::RetCode execute() override;
+    bool reduce_temp_buffer() override;
 
 private:
     struct kernel_schedule_param {
@@ -88,6 +88,29 @@ uint64_t conv2d_im2col_gemm_fp32_sse_executor::cal_temp_buffer_size()
     return im2col_size + (src_trans_size_per_thr + dst_buf_size_per_thr) * PPL_OMP_MAX_THREADS();
 }
 
+bool conv2d_im2col_gemm_fp32_sse_executor::reduce_temp_buffer()
+{
+    const conv2d_fp32_param &cp = *conv_param_;
+    kernel_schedule_param &sp   = schedule_param_;
+
+    // gemm reads src directly without im2col buffer, smaller l3 tiles save nothing
+    const bool is_gemm = cp.is_pointwise() && cp.sparse_level() == 1.0f;
+    if (is_gemm) {
+        return false;
+    }
+
+    // im2col buffer holds mb_l3_blk * gp_l3_blk images, fewer images in l3 tile means less parallelism
+    if (sp.gp_l3_blk > 1) {
+        sp.gp_l3_blk = div_up(sp.gp_l3_blk, 2);
+        return true;
+    }
+    if (sp.mb_l3_blk > 1) {
+        sp.mb_l3_blk = div_up(sp.mb_l3_blk, 2);
+        return true;
+    }
+    return false;
+}
+
 ppl::common::RetCode conv2d_im2col_gemm_fp32_sse_executor::prepare()
 {
     if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & conv_fuse_flag::SUM) && !sum_src_shape_)) {
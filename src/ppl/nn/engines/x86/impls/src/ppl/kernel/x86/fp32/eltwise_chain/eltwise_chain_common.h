@@ -0,0 +1,146 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_ELTWISE_CHAIN_ELTWISE_CHAIN_COMMON_H_
+#define __ST_PPL_KERNEL_X86_FP32_ELTWISE_CHAIN_ELTWISE_CHAIN_COMMON_H_
+
+#include <string.h>
+#include <vector>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/eltwise_chain.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// elements of dst processed by all ops of the chain before moving on, the tile and its operands stay in L1
+#define ELTWISE_CHAIN_TILE() 1024
+
+// slot of the saved value for each op, -1 if no later op reads its result
+inline int32_t eltwise_chain_init_slots(
+    const eltwise_chain_op *ops,
+    const int32_t num_ops,
+    std::vector<int32_t> *slots)
+{
+    slots->assign(num_ops, -1);
+    for (int32_t i = 0; i < num_ops; ++i) {
+        if (eltwise_chain_op_is_binary(ops[i].type) && ops[i].value_idx >= 0) {
+            (*slots)[ops[i].value_idx] = 0;
+        }
+    }
+    int32_t num_saved = 0;
+    for (int32_t i = 0; i < num_ops; ++i) {
+        if ((*slots)[i] >= 0) {
+            (*slots)[i] = num_saved++;
+        }
+    }
+    return num_saved;
+}
+
+// returns elements [start, start + n) of broadcasted src, gathered into tile if they are not contiguous
+inline const float *eltwise_chain_load_src(
+    const eltwise_chain_src &src,
+    const int64_t start,
+    const int64_t n,
+    float *tile)
+{
+    if (src.inner == 1 && start % src.length + n <= src.length) {
+        return src.data + start % src.length;
+    }
+    int64_t i = 0;
+    while (i < n) {
+        const int64_t g   = start + i;
+        const int64_t idx = (g / src.inner) % src.length;
+        if (src.inner == 1) {
+            const int64_t run = min(n - i, src.length - idx);
+            memcpy(tile + i, src.data + idx, run * sizeof(float));
+            i += run;
+        } else {
+            const int64_t run = min(n - i, src.inner - g % src.inner);
+            const float val   = src.data[idx];
+            for (int64_t j = 0; j < run; ++j) {
+                tile[i + j] = val;
+            }
+            i += run;
+        }
+    }
+    return tile;
+}
+
+// apply_op(op, other, other_scalar, n, cur): other is nullptr if the operand of a binary op is a scalar
+typedef void (*eltwise_chain_apply_func_t)(const eltwise_chain_op *, const float *, const float, const int64_t, float *);
+
+template <eltwise_chain_apply_func_t apply_op>
+ppl::common::RetCode eltwise_chain_fp32_execute(
+    const ppl::nn::TensorShape *dst_shape,
+    const eltwise_chain_src *srcs,
+    const eltwise_chain_op *ops,
+    const int32_t num_ops,
+    void *temp_buffer,
+    float *dst)
+{
+    const int64_t tile      = ELTWISE_CHAIN_TILE();
+    const int64_t total     = dst_shape->GetElementsIncludingPadding();
+    const int64_t num_tiles = div_up(total, tile);
+
+    std::vector<int32_t> slots;
+    const int32_t num_saved = eltwise_chain_init_slots(ops, num_ops, &slots);
+
+PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t t = 0; t < num_tiles; ++t) {
+        const int64_t start = t * tile;
+        const int64_t n     = min(tile, total - start);
+        float *gather_tile  = (float *)temp_buffer + PPL_OMP_THREAD_ID() * (num_saved + 1) * tile;
+        float *saved_tiles  = gather_tile + tile;
+        float *cur          = dst + start;
+
+        if (srcs[0].length == 1) {
+            for (int64_t i = 0; i < n; ++i) {
+                cur[i] = srcs[0].data[0];
+            }
+        } else {
+            const float *head = eltwise_chain_load_src(srcs[0], start, n, cur);
+            if (head != cur) {
+                memcpy(cur, head, n * sizeof(float));
+            }
+        }
+
+        for (int32_t k = 0; k < num_ops; ++k) {
+            const eltwise_chain_op *op = ops + k;
+            const float *other         = nullptr;
+            float other_scalar         = 0.0f;
+            if (eltwise_chain_op_is_binary(op->type)) {
+                if (op->value_idx >= 0) {
+                    other = saved_tiles + slots[op->value_idx] * tile;
+                } else if (srcs[op->src_idx].length == 1) {
+                    other_scalar = srcs[op->src_idx].data[0];
+                } else {
+                    other = eltwise_chain_load_src(srcs[op->src_idx], start, n, gather_tile);
+                }
+            }
+            apply_op(op, other, other_scalar, n, cur);
+            if (slots[k] >= 0) {
+                memcpy(saved_tiles + slots[k] * tile, cur, n * sizeof(float));
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
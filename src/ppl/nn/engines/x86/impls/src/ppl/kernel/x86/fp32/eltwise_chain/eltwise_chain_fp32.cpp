@@ -0,0 +1,125 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+
+#include "ppl/kernel/x86/fp32/eltwise_chain/eltwise_chain_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+bool eltwise_chain_init_src(
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *data,
+    eltwise_chain_src *src)
+{
+    src->data   = data;
+    src->inner  = 1;
+    src->length = 1;
+    if (src_shape->GetElementsExcludingPadding() == 1) {
+        return true;
+    }
+    if (src_shape->GetDataFormat() != dst_shape->GetDataFormat()) {
+        return false;
+    }
+
+    const int64_t src_dim_count = src_shape->GetDimCount();
+    const int64_t dst_dim_count = dst_shape->GetDimCount();
+    bool same_dims              = src_dim_count == dst_dim_count;
+    for (int64_t i = 0; same_dims && i < dst_dim_count; ++i) {
+        same_dims = src_shape->GetDim(i) == dst_shape->GetDim(i);
+    }
+    if (same_dims) {
+        src->length = dst_shape->GetElementsIncludingPadding();
+        return true;
+    }
+    if (dst_shape->GetDataFormat() != ppl::common::DATAFORMAT_NDARRAY || src_dim_count > dst_dim_count) {
+        return false;
+    }
+
+    // dims of src are aligned to the right, only a contiguous range of them may be larger than 1
+    const int64_t offset = dst_dim_count - src_dim_count;
+    int64_t first = -1;
+    int64_t last  = -1;
+    for (int64_t i = 0; i < src_dim_count; ++i) {
+        if (src_shape->GetDim(i) != 1) {
+            first = first < 0 ? i : first;
+            last  = i;
+        }
+    }
+    for (int64_t i = first; i <= last; ++i) {
+        if (src_shape->GetDim(i) != dst_shape->GetDim(offset + i)) {
+            return false;
+        }
+        src->length *= src_shape->GetDim(i);
+    }
+    for (int64_t i = offset + last + 1; i < dst_dim_count; ++i) {
+        src->inner *= dst_shape->GetDim(i);
+    }
+    return true;
+}
+
+uint64_t eltwise_chain_fp32_get_buffer_bytes(
+    const eltwise_chain_op *ops,
+    const int32_t num_ops)
+{
+    std::vector<int32_t> slots;
+    const int32_t num_saved = eltwise_chain_init_slots(ops, num_ops, &slots);
+    return uint64_t(PPL_OMP_MAX_THREADS()) * (num_saved + 1) * ELTWISE_CHAIN_TILE() * sizeof(float);
+}
+
+static void eltwise_chain_apply_fp32(
+    const eltwise_chain_op *op,
+    const float *other,
+    const float other_scalar,
+    const int64_t n,
+    float *cur)
+{
+    for (int64_t i = 0; i < n; ++i) {
+        const float a = cur[i];
+        const float b   = other ? other[i] : other_scalar;
+        const float lhs = op->reverse ? b : a;
+        const float rhs = op->reverse ? a : b;
+        switch (op->type) {
+            case eltwise_chain_op_type::ADD: cur[i] = lhs + rhs; break;
+            case eltwise_chain_op_type::SUB: cur[i] = lhs - rhs; break;
+            case eltwise_chain_op_type::MUL: cur[i] = lhs * rhs; break;
+            case eltwise_chain_op_type::DIV: cur[i] = lhs / rhs; break;
+            case eltwise_chain_op_type::RELU: cur[i] = max(a, 0.0f); break;
+            case eltwise_chain_op_type::SIGMOID: cur[i] = 1.0f / (1.0f + expf(-a)); break;
+            case eltwise_chain_op_type::TANH: cur[i] = tanhf(a); break;
+            case eltwise_chain_op_type::EXP: cur[i] = expf(a); break;
+            case eltwise_chain_op_type::SQRT: cur[i] = sqrtf(a); break;
+            case eltwise_chain_op_type::CLIP: cur[i] = min(max(a, op->alpha), op->beta); break;
+            case eltwise_chain_op_type::LEAKY_RELU: cur[i] = a >= 0.0f ? a : a * op->alpha; break;
+            default: break;
+        }
+    }
+}
+
+ppl::common::RetCode eltwise_chain_fp32(
+    const ppl::nn::TensorShape *dst_shape,
+    const eltwise_chain_src *srcs,
+    const eltwise_chain_op *ops,
+    const int32_t num_ops,
+    void *temp_buffer,
+    float *dst)
+{
+    return eltwise_chain_fp32_execute<eltwise_chain_apply_fp32>(dst_shape, srcs, ops, num_ops, temp_buffer, dst);
+}
+
+}}}; // namespace ppl::kernel::x86
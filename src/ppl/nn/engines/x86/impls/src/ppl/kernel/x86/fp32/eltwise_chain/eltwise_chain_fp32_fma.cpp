@@ -0,0 +1,150 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/math_fma.h"
+#include "ppl/kernel/x86/fp32/eltwise_chain/eltwise_chain_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+template <eltwise_chain_op_type_t _op>
+static inline __m256 eltwise_chain_kernel_fp32_fma(const __m256 a, const __m256 b, const __m256 alpha, const __m256 beta)
+{
+    if (_op == eltwise_chain_op_type::ADD) return _mm256_add_ps(a, b);
+    if (_op == eltwise_chain_op_type::SUB) return _mm256_sub_ps(a, b);
+    if (_op == eltwise_chain_op_type::MUL) return _mm256_mul_ps(a, b);
+    if (_op == eltwise_chain_op_type::DIV) return _mm256_div_ps(a, b);
+    if (_op == eltwise_chain_op_type::RELU) return _mm256_max_ps(a, _mm256_setzero_ps());
+    if (_op == eltwise_chain_op_type::SIGMOID) return _fma_sigmoid_ps(a);
+    if (_op == eltwise_chain_op_type::TANH) return _fma_tanh_ps(a);
+    if (_op == eltwise_chain_op_type::EXP) return _fma_exp_ps(a);
+    if (_op == eltwise_chain_op_type::SQRT) return _mm256_sqrt_ps(a);
+    if (_op == eltwise_chain_op_type::CLIP) return _mm256_min_ps(_mm256_max_ps(a, alpha), beta);
+    if (_op == eltwise_chain_op_type::LEAKY_RELU) {
+        const __m256 mask = _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_GE_OQ);
+        return _mm256_blendv_ps(_mm256_mul_ps(a, alpha), a, mask);
+    }
+    return a;
+}
+
+template <eltwise_chain_op_type_t _op, bool reverse, bool scalar>
+static void eltwise_chain_loop_fp32_fma(
+    const eltwise_chain_op *op,
+    const float *other,
+    const float other_scalar,
+    const int64_t n,
+    float *cur)
+{
+    const int64_t simd_w = 8;
+    const int64_t body   = n / simd_w * simd_w;
+
+    const __m256 v_alpha  = _mm256_set1_ps(op->alpha);
+    const __m256 v_beta   = _mm256_set1_ps(op->beta);
+    const __m256 v_scalar = _mm256_set1_ps(other_scalar);
+
+    for (int64_t i = 0; i < body; i += simd_w) {
+        const __m256 a = _mm256_loadu_ps(cur + i);
+        const __m256 b = scalar ? v_scalar : _mm256_loadu_ps(other + i);
+        _mm256_storeu_ps(cur + i, reverse ? eltwise_chain_kernel_fp32_fma<_op>(b, a, v_alpha, v_beta)
+                                          : eltwise_chain_kernel_fp32_fma<_op>(a, b, v_alpha, v_beta));
+    }
+    if (body < n) {
+        float tail_a[simd_w] = {0.0f};
+        float tail_b[simd_w] = {0.0f};
+        for (int64_t i = body; i < n; ++i) {
+            tail_a[i - body] = cur[i];
+            tail_b[i - body] = scalar ? other_scalar : other[i];
+        }
+        const __m256 a = _mm256_loadu_ps(tail_a);
+        const __m256 b = _mm256_loadu_ps(tail_b);
+        _mm256_storeu_ps(tail_a, reverse ? eltwise_chain_kernel_fp32_fma<_op>(b, a, v_alpha, v_beta)
+                                         : eltwise_chain_kernel_fp32_fma<_op>(a, b, v_alpha, v_beta));
+        for (int64_t i = body; i < n; ++i) {
+            cur[i] = tail_a[i - body];
+        }
+    }
+}
+
+template <eltwise_chain_op_type_t _op>
+static void eltwise_chain_binary_fp32_fma(
+    const eltwise_chain_op *op,
+    const float *other,
+    const float other_scalar,
+    const int64_t n,
+    float *cur)
+{
+    if (other) {
+        if (op->reverse) {
+            eltwise_chain_loop_fp32_fma<_op, true, false>(op, other, other_scalar, n, cur);
+        } else {
+            eltwise_chain_loop_fp32_fma<_op, false, false>(op, other, other_scalar, n, cur);
+        }
+    } else {
+        if (op->reverse) {
+            eltwise_chain_loop_fp32_fma<_op, true, true>(op, other, other_scalar, n, cur);
+        } else {
+            eltwise_chain_loop_fp32_fma<_op, false, true>(op, other, other_scalar, n, cur);
+        }
+    }
+}
+
+template <eltwise_chain_op_type_t _op>
+static void eltwise_chain_unary_fp32_fma(
+    const eltwise_chain_op *op,
+    const int64_t n,
+    float *cur)
+{
+    eltwise_chain_loop_fp32_fma<_op, false, true>(op, nullptr, 0.0f, n, cur);
+}
+
+static void eltwise_chain_apply_fp32_fma(
+    const eltwise_chain_op *op,
+    const float *other,
+    const float other_scalar,
+    const int64_t n,
+    float *cur)
+{
+    typedef eltwise_chain_op_type t;
+    switch (op->type) {
+        case t::ADD: eltwise_chain_binary_fp32_fma<t::ADD>(op, other, other_scalar, n, cur); break;
+        case t::SUB: eltwise_chain_binary_fp32_fma<t::SUB>(op, other, other_scalar, n, cur); break;
+        case t::MUL: eltwise_chain_binary_fp32_fma<t::MUL>(op, other, other_scalar, n, cur); break;
+        case t::DIV: eltwise_chain_binary_fp32_fma<t::DIV>(op, other, other_scalar, n, cur); break;
+        case t::RELU: eltwise_chain_unary_fp32_fma<t::RELU>(op, n, cur); break;
+        case t::SIGMOID: eltwise_chain_unary_fp32_fma<t::SIGMOID>(op, n, cur); break;
+        case t::TANH: eltwise_chain_unary_fp32_fma<t::TANH>(op, n, cur); break;
+        case t::EXP: eltwise_chain_unary_fp32_fma<t::EXP>(op, n, cur); break;
+        case t::SQRT: eltwise_chain_unary_fp32_fma<t::SQRT>(op, n, cur); break;
+        case t::CLIP: eltwise_chain_unary_fp32_fma<t::CLIP>(op, n, cur); break;
+        case t::LEAKY_RELU: eltwise_chain_unary_fp32_fma<t::LEAKY_RELU>(op, n, cur); break;
+        default: break;
+    }
+}
+
+ppl::common::RetCode eltwise_chain_fp32_fma(
+    const ppl::nn::TensorShape *dst_shape,
+    const eltwise_chain_src *srcs,
+    const eltwise_chain_op *ops,
+    const int32_t num_ops,
+    void *temp_buffer,
+    float *dst)
+{
+    return eltwise_chain_fp32_execute<eltwise_chain_apply_fp32_fma>(dst_shape, srcs, ops, num_ops, temp_buffer, dst);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,384 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/gemm_v2/avx512bf16/gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512bf16.h"
+#include "ppl/kernel/x86/bf16/common/cvt_tools_bf16.h"
+#include "ppl/kernel/x86/bf16/common/cvt_tools_bf16_avx512.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static const int32_t simd_w = 16;
+
+// C[m_len][n_vecs * simd_w] += A[m_len][k] * B[k][n_vecs * simd_w]
+// A is [m][k_stride] row major and B is [n / simd_w][k_stride / 2][simd_w][2], k is counted in pairs
+template <int32_t m_len, int32_t n_vecs>
+static void gemm_kernel_fp32_avx512bf16(
+    const uint16_t* A,
+    const uint16_t* B,
+    const int32_t k2_len,
+    const int32_t lda,
+    const int32_t ldb_panel,
+    const int32_t ldc,
+    float* C)
+{
+#define DECL_ACC(M) __m512 acc##M##0, acc##M##1, acc##M##2, acc##M##3
+#define LOAD_ACC(M)                                                            \
+    do {                                                                       \
+        if (m_len > M) {                                                       \
+            if (n_vecs > 0) acc##M##0 = _mm512_loadu_ps(C + M * ldc + 0 * simd_w); \
+            if (n_vecs > 1) acc##M##1 = _mm512_loadu_ps(C + M * ldc + 1 * simd_w); \
+            if (n_vecs > 2) acc##M##2 = _mm512_loadu_ps(C + M * ldc + 2 * simd_w); \
+            if (n_vecs > 3) acc##M##3 = _mm512_loadu_ps(C + M * ldc + 3 * simd_w); \
+        }                                                                      \
+    } while (0)
+#define DPBF16(M)                                                                         \
+    do {                                                                                  \
+        if (m_len > M) {                                                                  \
+            const __m512bh a = (__m512bh)_mm512_set1_epi32(*(const int32_t*)(l_a + M * lda)); \
+            if (n_vecs > 0) acc##M##0 = _mm512_dpbf16_ps(acc##M##0, a, b0);               \
+            if (n_vecs > 1) acc##M##1 = _mm512_dpbf16_ps(acc##M##1, a, b1);               \
+            if (n_vecs > 2) acc##M##2 = _mm512_dpbf16_ps(acc##M##2, a, b2);               \
+            if (n_vecs > 3) acc##M##3 = _mm512_dpbf16_ps(acc##M##3, a, b3);               \
+        }                                                                                 \
+    } while (0)
+#define STORE_ACC(M)                                                          \
+    do {                                                                      \
+        if (m_len > M) {                                                      \
+            if (n_vecs > 0) _mm512_storeu_ps(C + M * ldc + 0 * simd_w, acc##M##0); \
+            if (n_vecs > 1) _mm512_storeu_ps(C + M * ldc + 1 * simd_w, acc##M##1); \
+            if (n_vecs > 2) _mm512_storeu_ps(C + M * ldc + 2 * simd_w, acc##M##2); \
+            if (n_vecs > 3) _mm512_storeu_ps(C + M * ldc + 3 * simd_w, acc##M##3); \
+        }                                                                     \
+    } while (0)
+
+    DECL_ACC(0); DECL_ACC(1); DECL_ACC(2);
+    DECL_ACC(3); DECL_ACC(4); DECL_ACC(5);
+    LOAD_ACC(0); LOAD_ACC(1); LOAD_ACC(2);
+    LOAD_ACC(3); LOAD_ACC(4); LOAD_ACC(5);
+
+    const uint16_t* l_a = A;
+    const uint16_t* l_b = B;
+    for (int32_t k2 = 0; k2 < k2_len; ++k2) {
+        __m512bh b0, b1, b2, b3;
+        if (n_vecs > 0) b0 = (__m512bh)_mm512_loadu_si512(l_b + 0 * ldb_panel);
+        if (n_vecs > 1) b1 = (__m512bh)_mm512_loadu_si512(l_b + 1 * ldb_panel);
+        if (n_vecs > 2) b2 = (__m512bh)_mm512_loadu_si512(l_b + 2 * ldb_panel);
+        if (n_vecs > 3) b3 = (__m512bh)_mm512_loadu_si512(l_b + 3 * ldb_panel);
+        DPBF16(0); DPBF16(1); DPBF16(2);
+        DPBF16(3); DPBF16(4); DPBF16(5);
+        l_a += 2;
+        l_b += simd_w * 2;
+    }
+
+    STORE_ACC(0); STORE_ACC(1); STORE_ACC(2);
+    STORE_ACC(3); STORE_ACC(4); STORE_ACC(5);
+
+#undef DECL_ACC
+#undef LOAD_ACC
+#undef DPBF16
+#undef STORE_ACC
+}
+
+typedef void (*gemm_kernel_fp32_avx512bf16_func_type_t)(const uint16_t*, const uint16_t*, const int32_t, const int32_t, const int32_t, const int32_t, float*);
+static const gemm_kernel_fp32_avx512bf16_func_type_t gemm_kernel_max6x64_fp32_avx512bf16_func_tab[6][4] = {
+    {gemm_kernel_fp32_avx512bf16<1, 1>, gemm_kernel_fp32_avx512bf16<1, 2>, gemm_kernel_fp32_avx512bf16<1, 3>, gemm_kernel_fp32_avx512bf16<1, 4>},
+    {gemm_kernel_fp32_avx512bf16<2, 1>, gemm_kernel_fp32_avx512bf16<2, 2>, gemm_kernel_fp32_avx512bf16<2, 3>, gemm_kernel_fp32_avx512bf16<2, 4>},
+    {gemm_kernel_fp32_avx512bf16<3, 1>, gemm_kernel_fp32_avx512bf16<3, 2>, gemm_kernel_fp32_avx512bf16<3, 3>, gemm_kernel_fp32_avx512bf16<3, 4>},
+    {gemm_kernel_fp32_avx512bf16<4, 1>, gemm_kernel_fp32_avx512bf16<4, 2>, gemm_kernel_fp32_avx512bf16<4, 3>, gemm_kernel_fp32_avx512bf16<4, 4>},
+    {gemm_kernel_fp32_avx512bf16<5, 1>, gemm_kernel_fp32_avx512bf16<5, 2>, gemm_kernel_fp32_avx512bf16<5, 3>, gemm_kernel_fp32_avx512bf16<5, 4>},
+    {gemm_kernel_fp32_avx512bf16<6, 1>, gemm_kernel_fp32_avx512bf16<6, 2>, gemm_kernel_fp32_avx512bf16<6, 3>, gemm_kernel_fp32_avx512bf16<6, 4>},
+};
+
+// A block to [m_len][k_blk_len] bf16, k is padded to even with zero
+void gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512bf16::load_a_data(
+    const float* src,
+    const int32_t m_len,
+    const int32_t k_len,
+    uint16_t* dst)
+{
+    const int64_t lda          = param_.lda;
+    const int32_t k_blk_len    = blk_partition_.k_blk_len;
+    const int32_t padded_k_len = round_up(k_len, 2);
+
+    if (param_.trans_A) {
+        for (int32_t m = 0; m < m_len; ++m) {
+            uint16_t* l_dst = dst + m * k_blk_len;
+            for (int32_t k = 0; k < k_len; ++k) {
+                l_dst[k] = cvt_fp32_to_bf16(src[k * lda + m]);
+            }
+            if (padded_k_len != k_len) {
+                l_dst[k_len] = 0;
+            }
+        }
+    } else {
+        for (int32_t m = 0; m < m_len; ++m) {
+            cvt_fp32_to_bf16_avx512(src + m * lda, k_len, padded_k_len, dst + m * k_blk_len);
+        }
+    }
+}
+
+// B block to [n_len / simd_w][k_blk_len / 2][simd_w][2] bf16, n is padded to simd_w and k is padded to even with zero
+void gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512bf16::load_b_data(
+    const float* src,
+    const int32_t n_len,
+    const int32_t k_len,
+    uint16_t* dst)
+{
+    const int64_t ldb       = param_.ldb;
+    const int32_t k_blk_len = blk_partition_.k_blk_len;
+    const int32_t k2_len    = div_up(k_len, 2);
+    const int64_t ldb_panel = (int64_t)k_blk_len * simd_w;
+
+    if (param_.trans_B) {
+        // every two consecutive k of one n are a pair, scatter the pairs to their n lane
+        const __m512i v_idx = _mm512_mullo_epi32(
+            _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0), _mm512_set1_epi32(simd_w));
+        if (n_len % simd_w != 0) {
+            memset(dst + (n_len / simd_w) * ldb_panel, 0, ldb_panel * sizeof(uint16_t));
+        }
+        for (int32_t n = 0; n < n_len; ++n) {
+            const float* l_src = src + n * ldb;
+            int32_t* l_dst     = (int32_t*)(dst + (n / simd_w) * ldb_panel) + n % simd_w;
+            for (int32_t k2 = 0; k2 < k2_len; k2 += simd_w) {
+                const int32_t k_eff  = min<int32_t>(k_len - k2 * 2, 2 * simd_w);
+                const __mmask16 m_lo = k_eff >= simd_w ? 0xffff : ((1 << k_eff) - 1);
+                const __mmask16 m_hi = k_eff >= 2 * simd_w ? 0xffff : k_eff <= simd_w ? 0 : ((1 << (k_eff - simd_w)) - 1);
+                const __m512 lo      = _mm512_maskz_loadu_ps(m_lo, l_src + k2 * 2);
+                const __m512 hi      = _mm512_maskz_loadu_ps(m_hi, l_src + k2 * 2 + simd_w);
+                const __m512i pairs  = (__m512i)_mm512_cvtne2ps_pbh(hi, lo);
+                const int32_t k2_eff = min<int32_t>(k2_len - k2, simd_w);
+                const __mmask16 mask = k2_eff == simd_w ? 0xffff : ((1 << k2_eff) - 1);
+                _mm512_mask_i32scatter_epi32(l_dst + k2 * simd_w, mask, v_idx, pairs, 4);
+            }
+        }
+    } else {
+        for (int32_t n = 0; n < n_len; n += simd_w) {
+            const int32_t n_eff  = min<int32_t>(n_len - n, simd_w);
+            const __mmask16 mask = n_eff == simd_w ? 0xffff : ((1 << n_eff) - 1);
+            int32_t* l_dst       = (int32_t*)(dst + (n / simd_w) * ldb_panel);
+            for (int32_t k2 = 0; k2 < k2_len; ++k2) {
+                const int32_t k = k2 * 2;
+                __m512i v       = cvt_fp32_to_bf16_epi32_avx512(_mm512_maskz_loadu_ps(mask, src + k * ldb + n));
+                if (k + 1 < k_len) {
+                    const __m512i v1 = cvt_fp32_to_bf16_epi32_avx512(_mm512_maskz_loadu_ps(mask, src + (k + 1) * ldb + n));
+                    v                = _mm512_or_si512(v, _mm512_slli_epi32(v1, 16));
+                }
+                _mm512_storeu_si512(l_dst + k2 * simd_w, v);
+            }
+        }
+    }
+}
+
+void gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512bf16::store_dst_data(
+    const float* src,
+    const int32_t m_len,
+    const int32_t n_len,
+    const float* C,
+    float* dst)
+{
+    const float alpha             = param_.alpha;
+    const float beta              = param_.beta;
+    const gemm_v2_C_type_t c_type = (beta == 0.0f || C == nullptr) ? (gemm_v2_C_type_t)gemm_v2_C_type::EMPTY : param_.c_type;
+    const bool with_relu          = param_.fuse_flag & gemm_v2_fuse_flag::RELU;
+    const int32_t n_blk_len       = blk_partition_.n_blk_len;
+    const int64_t ldc             = param_.ldc;
+    const int64_t ldy             = param_.ldy;
+
+    const __m512 v_alpha = _mm512_set1_ps(alpha);
+    const __m512 v_beta  = _mm512_set1_ps(beta);
+    __m512 v_c           = _mm512_setzero_ps();
+    if (c_type == gemm_v2_C_type::SCALAR) {
+        v_c = _mm512_set1_ps(C[0]);
+    }
+
+    for (int32_t m = 0; m < m_len; ++m) {
+        if (c_type == gemm_v2_C_type::VECTOR_H) {
+            v_c = _mm512_set1_ps(C[m]);
+        }
+        for (int32_t n = 0; n < n_len; n += simd_w) {
+            const int32_t n_eff  = min<int32_t>(n_len - n, simd_w);
+            const __mmask16 mask = n_eff == simd_w ? 0xffff : ((1 << n_eff) - 1);
+            __m512 v_data        = _mm512_mul_ps(_mm512_loadu_ps(src + m * n_blk_len + n), v_alpha);
+            if (c_type != gemm_v2_C_type::EMPTY) {
+                if (c_type == gemm_v2_C_type::MATRIX) {
+                    v_c = _mm512_maskz_loadu_ps(mask, C + m * ldc + n);
+                }
+                if (c_type == gemm_v2_C_type::VECTOR_W) {
+                    v_c = _mm512_maskz_loadu_ps(mask, C + n);
+                }
+                v_data = _mm512_fmadd_ps(v_beta, v_c, v_data);
+            }
+            if (with_relu) {
+                v_data = _mm512_max_ps(v_data, _mm512_setzero_ps());
+            }
+            _mm512_mask_storeu_ps(dst + m * ldy + n, mask, v_data);
+        }
+    }
+}
+
+void gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512bf16::execute_sub_blk(
+    const uint16_t* A,
+    const uint16_t* B,
+    const int32_t m_len,
+    const int32_t n_len,
+    const int32_t k_len,
+    float* dst)
+{
+    const int32_t m_kernel_blk_len = blk_partition_.m_kernel_blk_len;
+    const int32_t n_kernel_blk_len = blk_partition_.n_kernel_blk_len;
+
+    const int32_t lda       = blk_partition_.k_blk_len;
+    const int32_t ldb_panel = blk_partition_.k_blk_len * simd_w;
+    const int32_t ldc       = blk_partition_.n_blk_len;
+    const int32_t k2_len    = div_up(k_len, 2);
+
+    for (int32_t n = 0; n < n_len; n += n_kernel_blk_len) {
+        const int32_t n_kernel_blk_eff = min(n_kernel_blk_len, n_len - n);
+        for (int32_t m = 0; m < m_len; m += m_kernel_blk_len) {
+            const int32_t m_kernel_blk_eff = min(m_kernel_blk_len, m_len - m);
+            gemm_kernel_max6x64_fp32_avx512bf16_func_tab[m_kernel_blk_eff - 1][div_up(n_kernel_blk_eff, simd_w) - 1](
+                A + m * lda, B + (n / simd_w) * ldb_panel, k2_len, lda, ldb_panel, ldc, dst + m * ldc + n);
+        }
+    }
+}
+
+common::RetCode gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512bf16::pack_b(const float* B, void* packed_B)
+{
+    const int64_t N         = param_.N;
+    const int64_t K         = param_.K;
+    const int64_t ldb       = param_.ldb;
+    const int32_t trans_B   = param_.trans_B;
+    const int32_t n_blk_len = blk_partition_.n_blk_len;
+    const int32_t k_blk_len = blk_partition_.k_blk_len;
+
+    if (n_blk_len % simd_w != 0 || k_blk_len % 2 != 0) {
+        return common::RC_INVALID_VALUE;
+    }
+
+    // B blocks are packed as they are loaded in execute(), ordered by [n_blk][k_blk]
+    const int64_t num_n_blks = div_up(N, n_blk_len);
+    const int64_t num_k_blks = div_up(K, k_blk_len);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t blk = 0; blk < num_n_blks * num_k_blks; blk++) {
+        const int64_t n      = blk / num_k_blks * n_blk_len;
+        const int64_t k      = blk % num_k_blks * k_blk_len;
+        const float* l_src_b = trans_B ? B + n * ldb + k : B + k * ldb + n;
+        uint16_t* l_packed_b = (uint16_t*)((uint8_t*)packed_B + blk * get_b_buffer_bytes());
+
+        memset(l_packed_b, 0, get_b_buffer_bytes());
+        load_b_data(l_src_b, min<int64_t>(n_blk_len, N - n), min<int64_t>(k_blk_len, K - k), l_packed_b);
+    }
+
+    return common::RC_SUCCESS;
+}
+
+common::RetCode gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512bf16::execute(void)
+{
+    const int64_t M                = param_.M;
+    const int64_t N                = param_.N;
+    const int64_t K                = param_.K;
+    const int64_t lda              = param_.lda;
+    const int64_t ldb              = param_.ldb;
+    const int64_t ldc              = param_.ldc;
+    const int64_t ldy              = param_.ldy;
+    const float* C                 = param_.src_C;
+    const uint8_t* packed_B        = (const uint8_t*)param_.packed_B;
+    const int32_t trans_A          = param_.trans_A;
+    const int32_t trans_B          = param_.trans_B;
+    const gemm_v2_C_type_t& c_type = param_.c_type;
+
+    const int32_t m_blk_len = blk_partition_.m_blk_len;
+    const int32_t n_blk_len = blk_partition_.n_blk_len;
+    const int32_t k_blk_len = blk_partition_.k_blk_len;
+
+    // the kernels read whole vectors of n and pairs of k
+    if (n_blk_len % simd_w != 0 || k_blk_len % 2 != 0 || blk_partition_.m_kernel_blk_len > 6 || blk_partition_.n_kernel_blk_len > 4 * simd_w) {
+        return common::RC_INVALID_VALUE;
+    }
+
+    const int64_t num_m_blks = div_up(M, m_blk_len);
+    const int64_t num_n_blks = div_up(N, n_blk_len);
+    const int64_t num_k_blks = div_up(K, k_blk_len);
+    const int64_t num_tasks  = param_.batch * num_m_blks * num_n_blks;
+
+    uint8_t* temp_buffer = (uint8_t*)temp_buffer_;
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t task = 0; task < num_tasks; task++) {
+        const int64_t b = task / (num_m_blks * num_n_blks);
+        const int64_t m = task / num_n_blks % num_m_blks * m_blk_len;
+        const int64_t n = task % num_n_blks * n_blk_len;
+
+        const float* A = param_.src_A + (param_.batch_offset_A ? param_.batch_offset_A[b] : 0);
+        const float* B = packed_B ? nullptr : param_.src_B + (param_.batch_offset_B ? param_.batch_offset_B[b] : 0);
+        float* dst     = param_.dst_Y + (param_.batch_offset_Y ? param_.batch_offset_Y[b] : 0);
+
+        uint8_t* l_temp  = temp_buffer + PPL_OMP_THREAD_ID() * get_buffer_bytes_per_thread();
+        uint16_t* temp_a = (uint16_t*)l_temp;
+        uint16_t* temp_b = (uint16_t*)(l_temp + get_a_buffer_bytes());
+        float* temp_dst  = (float*)(l_temp + get_a_buffer_bytes() + get_b_buffer_bytes());
+
+        memset(temp_dst, 0, get_dst_buffer_bytes());
+
+        const int32_t m_blk_eff = min<int64_t>(m_blk_len, M - m);
+        const int32_t n_blk_eff = min<int64_t>(n_blk_len, N - n);
+
+        for (int64_t k = 0; k < K; k += k_blk_len) {
+            const int32_t k_blk_eff = min<int64_t>(k_blk_len, K - k);
+            // load data into L2
+            const float* l_src_a = trans_A ? A + k * lda + m : A + m * lda + k;
+            load_a_data(l_src_a, m_blk_eff, k_blk_eff, temp_a);
+
+            const uint16_t* l_temp_b = temp_b;
+            if (packed_B) {
+                l_temp_b = (const uint16_t*)(packed_B + (n / n_blk_len * num_k_blks + k / k_blk_len) * get_b_buffer_bytes());
+            } else {
+                load_b_data(trans_B ? B + n * ldb + k : B + k * ldb + n, n_blk_eff, k_blk_eff, temp_b);
+            }
+
+            execute_sub_blk(
+                temp_a,
+                l_temp_b,
+                m_blk_eff,
+                n_blk_eff,
+                k_blk_eff,
+                temp_dst);
+        }
+
+        const float* l_src_c = nullptr;
+        if (c_type == gemm_v2_C_type::EMPTY || C == nullptr) {
+            l_src_c = nullptr;
+        } else if (c_type == gemm_v2_C_type::SCALAR) {
+            l_src_c = C;
+        } else if (c_type == gemm_v2_C_type::VECTOR_H) {
+            l_src_c = C + m;
+        } else if (c_type == gemm_v2_C_type::VECTOR_W) {
+            l_src_c = C + n;
+        } else if (c_type == gemm_v2_C_type::MATRIX) {
+            l_src_c = C + m * ldc + n;
+        }
+        store_dst_data(temp_dst, m_blk_eff, n_blk_eff, l_src_c, dst + m * ldy + n);
+    }
+
+    return common::RC_SUCCESS;
+}
+
+}}} // namespace ppl::kernel::x86
@@ -0,0 +1,118 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_GEMM_V2_GEMM_V2_MNK_KENREL_NM_EXECUTOR_FP32_AVX512BF16_H_
+#define __ST_PPL_KERNEL_X86_FP32_GEMM_V2_GEMM_V2_MNK_KENREL_NM_EXECUTOR_FP32_AVX512BF16_H_
+
+#include <string.h> // for memcpy
+
+#include "ppl/kernel/x86/fp32/gemm_v2.h"
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// fp32 gemm with A and B rounded to bf16 and accumulated in fp32 by avx512 bf16 dot products
+class gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512bf16 : public gemm_v2_executor_fp32 {
+public:
+    gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512bf16()
+    {
+        // default internal param
+        blk_partition_.m_blk_len = 96; // 176 KB used in L2/L3
+        blk_partition_.n_blk_len = 128;
+        blk_partition_.k_blk_len = 256;
+
+        blk_partition_.m_kernel_blk_len = 6; // only support 6x64 kernel now
+        blk_partition_.n_kernel_blk_len = 64;
+    }
+    virtual ~gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512bf16() {}
+
+    void set_internal_param(const std::vector<uint8_t>& internal_param) override final
+    {
+        memcpy(&blk_partition_, internal_param.data(), min(internal_param.size(), sizeof(blk_partition)));
+    }
+
+    const void* get_internal_param_ptr(void) override final
+    {
+        return (const void*)&blk_partition_;
+    }
+
+    virtual uint64_t get_internal_param_bytes(void) override final
+    {
+        return sizeof(blk_partition);
+    }
+
+    uint64_t get_buffer_bytes(void) const override final
+    {
+        return get_buffer_bytes_per_thread() * PPL_OMP_MAX_THREADS();
+    }
+
+    common::RetCode optimize(void) override final
+    {
+        return common::RC_SUCCESS;
+    }
+
+    uint64_t get_packed_b_bytes(void) const override final
+    {
+        return div_up(param_.N, blk_partition_.n_blk_len) * div_up(param_.K, blk_partition_.k_blk_len) * get_b_buffer_bytes();
+    }
+
+    common::RetCode pack_b(const float* B, void* packed_B) override final;
+
+    common::RetCode execute(void) override final;
+
+private:
+    // buffer related functions, k_blk_len is always even
+    inline uint64_t get_a_buffer_bytes(void) const
+    {
+        return blk_partition_.m_blk_len * blk_partition_.k_blk_len * sizeof(uint16_t);
+    }
+    inline uint64_t get_b_buffer_bytes(void) const
+    {
+        return blk_partition_.k_blk_len * blk_partition_.n_blk_len * sizeof(uint16_t);
+    }
+    inline uint64_t get_dst_buffer_bytes(void) const
+    {
+        return blk_partition_.m_blk_len * blk_partition_.n_blk_len * sizeof(float);
+    }
+    inline uint64_t get_buffer_bytes_per_thread(void) const
+    {
+        return get_a_buffer_bytes() + get_b_buffer_bytes() + get_dst_buffer_bytes() + PPL_X86_CACHELINE_BYTES();
+    }
+
+    // execute related functions
+    void load_a_data(const float* src, const int32_t m_len, const int32_t k_len, uint16_t* dst);
+    void load_b_data(const float* src, const int32_t n_len, const int32_t k_len, uint16_t* dst);
+    void store_dst_data(const float* src, const int32_t m_len, const int32_t n_len, const float* C, float* dst);
+    void execute_sub_blk(const uint16_t* A, const uint16_t* B, const int32_t m_len, const int32_t n_len, const int32_t k_len, float* dst);
+
+private:
+    struct blk_partition {
+        // L2/L3 blk
+        int32_t m_blk_len;
+        int32_t n_blk_len;
+        int32_t k_blk_len;
+        // register blk
+        int32_t m_kernel_blk_len;
+        int32_t n_kernel_blk_len;
+    };
+
+    blk_partition blk_partition_;
+};
+
+}}} // namespace ppl::kernel::x86
+
+#endif // !__ST_PPL_KERNEL_X86_FP32_GEMM_V2_GEMM_V2_MNK_KENREL_NM_EXECUTOR_FP32_AVX512BF16_H_
@@ -487,6 +487,33 @@ void gemm_v2_mnk_sub_kmn_kernel_nm_atbn_executor_fp32_fma::execute_sub_blk(
     }
 }
 
+common::RetCode gemm_v2_mnk_sub_kmn_kernel_nm_atbn_executor_fp32_fma::pack_b(const float* B, void* packed_B)
+{
+    const int32_t& N         = param_.N;
+    const int32_t& K         = param_.K;
+    const int32_t& ldb       = param_.ldb;
+    const int32_t& trans_B   = param_.trans_B;
+    const int32_t& n_blk_len = blk_partition_.n_blk_len;
+    const int32_t& k_blk_len = blk_partition_.k_blk_len;
+
+    // B blocks are packed as they are loaded in execute(), ordered by [n_blk][k_blk]
+    const int32_t num_n_blks = div_up(N, n_blk_len);
+    const int32_t num_k_blks = div_up(K, k_blk_len);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t blk = 0; blk < (int64_t)num_n_blks * num_k_blks; blk++) {
+        const int32_t n      = blk / num_k_blks * n_blk_len;
+        const int32_t k      = blk % num_k_blks * k_blk_len;
+        const float* l_src_b = trans_B ? B + n * ldb + k : B + k * ldb + n;
+        float* l_packed_b    = (float*)packed_B + blk * get_b_buffer_len();
+
+        memset(l_packed_b, 0, get_b_buffer_len() * sizeof(float));
+        load_b_data(l_src_b, min(n_blk_len, N - n), min(k_blk_len, K - k), l_packed_b);
+    }
+
+    return common::RC_SUCCESS;
+}
+
 common::RetCode gemm_v2_mnk_sub_kmn_kernel_nm_atbn_executor_fp32_fma::execute(void)
 {
     const int32_t& M               = param_.M;
@@ -496,10 +523,8 @@ common::RetCode gemm_v2_mnk_sub_kmn_kernel_nm_atbn_executor_fp32_fma::execute(vo
     const int32_t& ldb             = param_.ldb;
     const int32_t& ldc             = param_.ldc;
     const int32_t& ldy             = param_.ldy;
-    const float* A                 = param_.src_A;
-    const float* B                 = param_.src_B;
     const float* C                 = param_.src_C;
-    float* dst                     = param_.dst_Y;
+    const float* packed_B          = (const float*)param_.packed_B;
     const int32_t& trans_A         = param_.trans_A;
     const int32_t& trans_B         = param_.trans_B;
     const gemm_v2_C_type_t& c_type = param_.c_type;
@@ -511,76 +536,85 @@ common::RetCode gemm_v2_mnk_sub_kmn_kernel_nm_atbn_executor_fp32_fma::execute(vo
     const int32_t& n_sub_blk_len = blk_partition_.n_sub_blk_len;
     const int32_t& k_sub_blk_len = blk_partition_.k_sub_blk_len;
 
+    const int32_t num_m_blks = div_up(M, m_blk_len);
+    const int32_t num_n_blks = div_up(N, n_blk_len);
+    const int32_t num_k_blks = div_up(K, k_blk_len);
+    const int64_t num_tasks  = param_.batch * num_m_blks * num_n_blks;
+
     float* temp_buffer = (float*)temp_buffer_;
 
-#ifdef PPL_USE_X86_OMP_COLLAPSE
-    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
-#else
     PRAGMA_OMP_PARALLEL_FOR()
-#endif
-    for (int32_t m = 0; m < M; m += m_blk_len) {
-        for (int32_t n = 0; n < N; n += n_blk_len) {
-            float* l_temp   = temp_buffer + PPL_OMP_THREAD_ID() * get_buffer_len_per_thread();
-            float* temp_a   = l_temp;
-            float* temp_b   = temp_a + get_a_buffer_len();
-            float* temp_dst = temp_b + get_b_buffer_len();
-
-            memset(temp_dst, 0, get_dst_buffer_len() * sizeof(float));
-
-            const int32_t m_blk_eff = min(m_blk_len, M - m);
-            const int32_t n_blk_eff = min(n_blk_len, N - n);
-
-            for (int32_t k = 0; k < K; k += k_blk_len) {
-                const int32_t k_blk_eff = min(k_blk_len, K - k);
-                // load data into L2
-                const float* l_src_a    = nullptr;
-                const float* l_src_b    = nullptr;
-                if (trans_A) {
-                    l_src_a = A + k * lda + m;
-                } else {
-                    l_src_a = A + m * lda + k;
-                }
-                if (trans_B) {
-                    l_src_b = B + n * ldb + k;
-                } else {
-                    l_src_b = B + k * ldb + n;
-                }
-                load_a_data(l_src_a, m_blk_eff, k_blk_eff, temp_a);
-                load_b_data(l_src_b, n_blk_eff, k_blk_eff, temp_b);
-
-                for (int32_t kk = 0; kk < k_blk_eff; kk += k_sub_blk_len) {
-                    for (int32_t mm = 0; mm < m_blk_eff; mm += m_sub_blk_len) {
-                        for (int32_t nn = 0; nn < n_blk_eff; nn += n_sub_blk_len) {
-                            const int32_t m_sub_blk_eff = min(m_sub_blk_len, m_blk_eff - mm);
-                            const int32_t n_sub_blk_eff = min(n_sub_blk_len, n_blk_eff - nn);
-                            const int32_t k_sub_blk_eff = min(k_sub_blk_len, k_blk_eff - kk);
-
-                            execute_sub_blk(
-                                temp_a + kk * m_blk_len + mm,
-                                temp_b + kk * n_blk_len + nn,
-                                m_sub_blk_eff,
-                                n_sub_blk_eff,
-                                k_sub_blk_eff,
-                                temp_dst + mm * n_blk_len + nn);
-                        }
+    for (int64_t task = 0; task < num_tasks; task++) {
+        const int64_t b = task / ((int64_t)num_m_blks * num_n_blks);
+        const int32_t m = task / num_n_blks % num_m_blks * m_blk_len;
+        const int32_t n = task % num_n_blks * n_blk_len;
+
+        const float* A = param_.src_A + (param_.batch_offset_A ? param_.batch_offset_A[b] : 0);
+        const float* B = packed_B ? nullptr : param_.src_B + (param_.batch_offset_B ? param_.batch_offset_B[b] : 0);
+        float* dst     = param_.dst_Y + (param_.batch_offset_Y ? param_.batch_offset_Y[b] : 0);
+
+        float* l_temp   = temp_buffer + PPL_OMP_THREAD_ID() * get_buffer_len_per_thread();
+        float* temp_a   = l_temp;
+        float* temp_b   = temp_a + get_a_buffer_len();
+        float* temp_dst = temp_b + get_b_buffer_len();
+
+        memset(temp_dst, 0, get_dst_buffer_len() * sizeof(float));
+
+        const int32_t m_blk_eff = min(m_blk_len, M - m);
+        const int32_t n_blk_eff = min(n_blk_len, N - n);
+
+        for (int32_t k = 0; k < K; k += k_blk_len) {
+            const int32_t k_blk_eff = min(k_blk_len, K - k);
+            // load data into L2
+            const float* l_src_a = nullptr;
+            if (trans_A) {
+                l_src_a = A + k * lda + m;
+            } else {
+                l_src_a = A + m * lda + k;
+            }
+            load_a_data(l_src_a, m_blk_eff, k_blk_eff, temp_a);
+
+            const float* l_temp_b = temp_b;
+            if (packed_B) {
+                l_temp_b = packed_B + ((int64_t)(n / n_blk_len) * num_k_blks + k / k_blk_len) * get_b_buffer_len();
+            } else if (trans_B) {
+                load_b_data(B + n * ldb + k, n_blk_eff, k_blk_eff, temp_b);
+            } else {
+                load_b_data(B + k * ldb + n, n_blk_eff, k_blk_eff, temp_b);
+            }
+
+            for (int32_t kk = 0; kk < k_blk_eff; kk += k_sub_blk_len) {
+                for (int32_t mm = 0; mm < m_blk_eff; mm += m_sub_blk_len) {
+                    for (int32_t nn = 0; nn < n_blk_eff; nn += n_sub_blk_len) {
+                        const int32_t m_sub_blk_eff = min(m_sub_blk_len, m_blk_eff - mm);
+                        const int32_t n_sub_blk_eff = min(n_sub_blk_len, n_blk_eff - nn);
+                        const int32_t k_sub_blk_eff = min(k_sub_blk_len, k_blk_eff - kk);
+
+                        execute_sub_blk(
+                            temp_a + kk * m_blk_len + mm,
+                            l_temp_b + kk * n_blk_len + nn,
+                            m_sub_blk_eff,
+                            n_sub_blk_eff,
+                            k_sub_blk_eff,
+                            temp_dst + mm * n_blk_len + nn);
                     }
                 }
             }
+        }
 
-            const float* l_src_c = nullptr;
-            if (c_type == gemm_v2_C_type::EMPTY || C == nullptr) {
-                l_src_c = nullptr;
-            } else if (c_type == gemm_v2_C_type::SCALAR) {
-                l_src_c = C;
-            } else if (c_type == gemm_v2_C_type::VECTOR_H) {
-                l_src_c = C + m;
-            } else if (c_type == gemm_v2_C_type::VECTOR_W) {
-                l_src_c = C + n;
-            } else if (c_type == gemm_v2_C_type::MATRIX) {
-                l_src_c = C + m * ldc + n;
-            }
-            store_dst_data(temp_dst, m_blk_eff, n_blk_eff, l_src_c, dst + m * ldy + n);
+        const float* l_src_c = nullptr;
+        if (c_type == gemm_v2_C_type::EMPTY || C == nullptr) {
+            l_src_c = nullptr;
+        } else if (c_type == gemm_v2_C_type::SCALAR) {
+            l_src_c = C;
+        } else if (c_type == gemm_v2_C_type::VECTOR_H) {
+            l_src_c = C + m;
+        } else if (c_type == gemm_v2_C_type::VECTOR_W) {
+            l_src_c = C + n;
+        } else if (c_type == gemm_v2_C_type::MATRIX) {
+            l_src_c = C + m * ldc + n;
         }
+        store_dst_data(temp_dst, m_blk_eff, n_blk_eff, l_src_c, dst + m * ldy + n);
     }
 
     return common::RC_SUCCESS;
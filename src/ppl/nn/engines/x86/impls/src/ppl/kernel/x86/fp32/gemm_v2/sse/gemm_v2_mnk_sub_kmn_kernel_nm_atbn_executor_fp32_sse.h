@@ -68,6 +68,13 @@ public:
         return common::RC_SUCCESS;
     } // TODO: add optimize
 
+    uint64_t get_packed_b_bytes(void) const override final
+    {
+        return div_up(param_.N, blk_partition_.n_blk_len) * div_up(param_.K, blk_partition_.k_blk_len) * get_b_buffer_len() * sizeof(float);
+    }
+
+    common::RetCode pack_b(const float* B, void* packed_B) override final;
+
     common::RetCode execute(void) override final;
 
 private:
@@ -0,0 +1,250 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/gru.h"
+#include "ppl/kernel/x86/fp32/gemm.h"
+#include "ppl/kernel/x86/common/avx_tools.h"
+#include "ppl/kernel/x86/common/math_fma.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static inline float sigmoidf(const float x) {
+    return 1.0f / (1.0f + expf(-x));
+}
+
+uint64_t gru_fp32_fma_get_buffer_bytes(
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool has_Y,
+    const bool has_Y_h)
+{
+    if (!has_Y && !has_Y_h)
+        return 64u;
+
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+
+    const uint64_t xgate_buff_size = seq_len * batch * rnn_num_gate::GRU * hidden_size;
+    const uint64_t hgate_buff_size = batch * rnn_num_gate::GRU * hidden_size;
+    const uint64_t rh_size = batch * hidden_size;
+    const uint64_t yh_size = has_Y_h ? 0 : num_direction * batch * hidden_size;
+
+    return (xgate_buff_size + hgate_buff_size + rh_size + yh_size) * sizeof(float);
+}
+
+ppl::common::RetCode gru_fp32_fma(
+    const ppl::nn::TensorShape *X_shape,
+    const float *X,
+    const float *X_weight,
+    const float *R_weight,
+    const float *bias,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h)
+{
+    if (!Y && !Y_h) {
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t simd_w = 8;
+
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t input_size = X_shape->GetDim(2);
+    const int64_t gate_len = rnn_num_gate::GRU * hidden_size;
+    const gemm_v_type_t bias_type = bias ? gemm_v_type::ROW_VEC : gemm_v_type::EMPTY;
+
+    float *Yh_buf = Y_h;
+
+    // set temp buffer
+    float *temp_buffer_fp32 = reinterpret_cast<float*>(temp_buffer);
+    if (!Yh_buf) {
+        Yh_buf = temp_buffer_fp32;
+        temp_buffer_fp32 += num_direction * batch * hidden_size;
+    }
+    float *xgate_buf = temp_buffer_fp32;
+    float *hgate_buf = xgate_buf + seq_len * batch * gate_len;
+    float *rh_buf = hgate_buf + batch * gate_len;
+
+    for (int64_t nd = 0; nd < num_direction; ++nd) {
+        const bool is_reverse = nd || (direction == rnn_direction::REVERSE);
+
+        // X (seq_len, batch, input_size)
+        // h_0 (num_direction, batch, hidden_size)
+        // Y (seq_len, num_direction, batch, hidden_size)
+        // h_n (num_direction, batch, hidden_size)
+
+        float *nd_Yh = Yh_buf + nd * batch * hidden_size;
+        float *nd_Y = Y ? Y + nd * batch * hidden_size : nullptr;
+
+        const float *nd_W = X_weight + nd * gate_len * input_size;
+        const float *nd_R = R_weight + nd * gate_len * hidden_size;
+        const float *nd_Wb = bias ? bias + nd * 2 * gate_len : nullptr;
+        const float *nd_Rb = bias ? nd_Wb + gate_len : nullptr;
+
+        // input projection of all timesteps does not depend on h, do it as one big gemm
+        gemm_fp32_fma( // X*W[nd]_{zrh}^T+Wb_{zrh}
+            X, nd_W, nd_Wb, nullptr,
+            gemm_m_type::NOTRANS, gemm_m_type::TRANS,
+            bias_type, gemm_m_type::EMPTY,
+            seq_len * batch, gate_len, input_size,
+            input_size, input_size, gate_len, 0,
+            1.0f, 1.0f, gemm_post::NONE, xgate_buf);
+
+        // nd_Yh always holds h_{t-1} when entering a timestep
+        if (initial_h) {
+            memcpy32_avx(nd_Yh, initial_h + nd * batch * hidden_size, batch * hidden_size);
+        } else {
+            memset32_avx(nd_Yh, 0, batch * hidden_size);
+        }
+
+        for (int64_t seq_idx = 0; seq_idx < seq_len; ++seq_idx) {
+            if (linear_before_reset) {
+                gemm_fp32_fma( // h_{t-1}*R[nd]_{zrh}^T+Rb_{zrh}
+                    nd_Yh, nd_R, nd_Rb, nullptr,
+                    gemm_m_type::NOTRANS, gemm_m_type::TRANS,
+                    bias_type, gemm_m_type::EMPTY,
+                    batch, gate_len, hidden_size,
+                    hidden_size, hidden_size, gate_len, 0,
+                    1.0f, 1.0f, gemm_post::NONE, hgate_buf);
+
+PRAGMA_OMP_PARALLEL_FOR()
+                for (int64_t b = 0; b < batch; ++b) {
+                    float *Ht = nd_Yh + b * hidden_size;
+                    const int64_t valid_seq_len = rnn_valid_seq_len(sequence_lens, seq_len, b);
+                    if (seq_idx < valid_seq_len) {
+                        const int64_t mapped_seq_index = rnn_mapped_seq_index(is_reverse, valid_seq_len, seq_idx);
+                        const float *xZ = xgate_buf + (mapped_seq_index * batch + b) * gate_len;
+                        const float *xR = xZ + hidden_size;
+                        const float *xH = xR + hidden_size;
+                        const float *hZ = hgate_buf + b * gate_len;
+                        const float *hR = hZ + hidden_size;
+                        const float *hH = hR + hidden_size;
+                        int64_t h = 0;
+                        for (; h <= hidden_size - simd_w; h += simd_w) {
+                            const __m256 zt = _fma_sigmoid_ps(_mm256_loadu_ps(xZ + h) + _mm256_loadu_ps(hZ + h));
+                            const __m256 rt = _fma_sigmoid_ps(_mm256_loadu_ps(xR + h) + _mm256_loadu_ps(hR + h));
+                            const __m256 ht = _fma_tanh_ps(_mm256_fmadd_ps(rt, _mm256_loadu_ps(hH + h), _mm256_loadu_ps(xH + h)));
+                            const __m256 hp = _mm256_loadu_ps(Ht + h);
+                            _mm256_storeu_ps(Ht + h, _mm256_fmadd_ps(zt, hp - ht, ht));
+                        }
+                        for (; h < hidden_size; ++h) {
+                            const float zt = sigmoidf(xZ[h] + hZ[h]);
+                            const float rt = sigmoidf(xR[h] + hR[h]);
+                            const float ht = ::tanhf(xH[h] + rt * hH[h]);
+                            Ht[h] = ht + zt * (Ht[h] - ht);
+                        }
+                        if (nd_Y) {
+                            float *Yt = nd_Y + mapped_seq_index * num_direction * batch * hidden_size + b * hidden_size;
+                            memcpy32_avx(Yt, Ht, hidden_size);
+                        }
+                    } else if (nd_Y) { // h_{t-1} passes through, Y is padded with zeros
+                        float *Yt = nd_Y + seq_idx * num_direction * batch * hidden_size + b * hidden_size;
+                        memset32_avx(Yt, 0, hidden_size);
+                    }
+                }
+            } else {
+                gemm_fp32_fma( // h_{t-1}*R[nd]_{zr}^T+Rb_{zr}
+                    nd_Yh, nd_R, nd_Rb, nullptr,
+                    gemm_m_type::NOTRANS, gemm_m_type::TRANS,
+                    bias_type, gemm_m_type::EMPTY,
+                    batch, 2 * hidden_size, hidden_size,
+                    hidden_size, hidden_size, gate_len, 0,
+                    1.0f, 1.0f, gemm_post::NONE, hgate_buf);
+
+PRAGMA_OMP_PARALLEL_FOR()
+                for (int64_t b = 0; b < batch; ++b) {
+                    const int64_t valid_seq_len = rnn_valid_seq_len(sequence_lens, seq_len, b);
+                    if (seq_idx >= valid_seq_len) {
+                        continue;
+                    }
+                    const int64_t mapped_seq_index = rnn_mapped_seq_index(is_reverse, valid_seq_len, seq_idx);
+                    const float *xZ = xgate_buf + (mapped_seq_index * batch + b) * gate_len;
+                    const float *xR = xZ + hidden_size;
+                    float *hZ = hgate_buf + b * gate_len;
+                    const float *hR = hZ + hidden_size;
+                    const float *Hprev = nd_Yh + b * hidden_size;
+                    float *rH = rh_buf + b * hidden_size;
+                    int64_t h = 0;
+                    for (; h <= hidden_size - simd_w; h += simd_w) {
+                        const __m256 zt = _fma_sigmoid_ps(_mm256_loadu_ps(xZ + h) + _mm256_loadu_ps(hZ + h));
+                        const __m256 rt = _fma_sigmoid_ps(_mm256_loadu_ps(xR + h) + _mm256_loadu_ps(hR + h));
+                        _mm256_storeu_ps(hZ + h, zt);
+                        _mm256_storeu_ps(rH + h, rt * _mm256_loadu_ps(Hprev + h));
+                    }
+                    for (; h < hidden_size; ++h) {
+                        hZ[h] = sigmoidf(xZ[h] + hZ[h]);
+                        rH[h] = sigmoidf(xR[h] + hR[h]) * Hprev[h];
+                    }
+                }
+
+                gemm_fp32_fma( // (r_t (.) h_{t-1})*R[nd]_{h}^T+Rb_{h}
+                    rh_buf, nd_R + 2 * hidden_size * hidden_size, nd_Rb ? nd_Rb + 2 * hidden_size : nullptr, nullptr,
+                    gemm_m_type::NOTRANS, gemm_m_type::TRANS,
+                    bias_type, gemm_m_type::EMPTY,
+                    batch, hidden_size, hidden_size,
+                    hidden_size, hidden_size, gate_len, 0,
+                    1.0f, 1.0f, gemm_post::NONE, hgate_buf + 2 * hidden_size);
+
+PRAGMA_OMP_PARALLEL_FOR()
+                for (int64_t b = 0; b < batch; ++b) {
+                    float *Ht = nd_Yh + b * hidden_size;
+                    const int64_t valid_seq_len = rnn_valid_seq_len(sequence_lens, seq_len, b);
+                    if (seq_idx < valid_seq_len) {
+                        const int64_t mapped_seq_index = rnn_mapped_seq_index(is_reverse, valid_seq_len, seq_idx);
+                        const float *xH = xgate_buf + (mapped_seq_index * batch + b) * gate_len + 2 * hidden_size;
+                        const float *zT = hgate_buf + b * gate_len;
+                        const float *hH = zT + 2 * hidden_size;
+                        int64_t h = 0;
+                        for (; h <= hidden_size - simd_w; h += simd_w) {
+                            const __m256 ht = _fma_tanh_ps(_mm256_loadu_ps(xH + h) + _mm256_loadu_ps(hH + h));
+                            const __m256 hp = _mm256_loadu_ps(Ht + h);
+                            _mm256_storeu_ps(Ht + h, _mm256_fmadd_ps(_mm256_loadu_ps(zT + h), hp - ht, ht));
+                        }
+                        for (; h < hidden_size; ++h) {
+                            const float ht = ::tanhf(xH[h] + hH[h]);
+                            Ht[h] = ht + zT[h] * (Ht[h] - ht);
+                        }
+                        if (nd_Y) {
+                            float *Yt = nd_Y + mapped_seq_index * num_direction * batch * hidden_size + b * hidden_size;
+                            memcpy32_avx(Yt, Ht, hidden_size);
+                        }
+                    } else if (nd_Y) { // h_{t-1} passes through, Y is padded with zeros
+                        float *Yt = nd_Y + seq_idx * num_direction * batch * hidden_size + b * hidden_size;
+                        memset32_avx(Yt, 0, hidden_size);
+                    }
+                }
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,192 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/gru.h"
+#include "ppl/kernel/x86/fp32/gemm.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static inline float sigmoidf(const float x) {
+    return 1.0f / (1.0f + expf(-x));
+}
+
+uint64_t gru_ref_fp32_get_buffer_bytes(
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool has_Y,
+    const bool has_Y_h)
+{
+    if (!has_Y && !has_Y_h)
+        return 64u;
+
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+
+    const uint64_t xgate_buff_size = seq_len * batch * rnn_num_gate::GRU * hidden_size;
+    const uint64_t hgate_buff_size = batch * rnn_num_gate::GRU * hidden_size;
+    const uint64_t rh_size = batch * hidden_size;
+    const uint64_t yh_size = has_Y_h ? 0 : num_direction * batch * hidden_size;
+
+    return (xgate_buff_size + hgate_buff_size + rh_size + yh_size) * sizeof(float);
+}
+
+ppl::common::RetCode gru_ref_fp32(
+    const ppl::nn::TensorShape *X_shape,
+    const float *X,
+    const float *X_weight,
+    const float *R_weight,
+    const float *bias,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h)
+{
+    if (!Y && !Y_h) {
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t input_size = X_shape->GetDim(2);
+    const int64_t gate_len = rnn_num_gate::GRU * hidden_size;
+
+    float *Yh_buf = Y_h;
+
+    // set temp buffer
+    float *temp_buffer_fp32 = reinterpret_cast<float*>(temp_buffer);
+    if (!Yh_buf) {
+        Yh_buf = temp_buffer_fp32;
+        temp_buffer_fp32 += num_direction * batch * hidden_size;
+    }
+    float *xgate_buf = temp_buffer_fp32;
+    float *hgate_buf = xgate_buf + seq_len * batch * gate_len;
+    float *rh_buf = hgate_buf + batch * gate_len;
+
+    for (int64_t nd = 0; nd < num_direction; ++nd) {
+        const bool is_reverse = nd || (direction == rnn_direction::REVERSE);
+
+        // X (seq_len, batch, input_size)
+        // h_0 (num_direction, batch, hidden_size)
+        // Y (seq_len, num_direction, batch, hidden_size)
+        // h_n (num_direction, batch, hidden_size)
+
+        float *nd_Yh = Yh_buf + nd * batch * hidden_size;
+        float *nd_Y = Y ? Y + nd * batch * hidden_size : nullptr;
+
+        const float *nd_W = X_weight + nd * gate_len * input_size;
+        const float *nd_R = R_weight + nd * gate_len * hidden_size;
+        const float *nd_Wb = bias ? bias + nd * 2 * gate_len : nullptr;
+        const float *nd_Rb = bias ? nd_Wb + gate_len : nullptr;
+
+        gemm_ref_fp32( // X*W[nd]_{zrh}^T+Wb_{zrh}
+            X, nd_W, nd_Wb, nullptr,
+            gemm_m_type::NOTRANS, gemm_m_type::TRANS,
+            gemm_v_type::ROW_VEC, gemm_m_type::EMPTY,
+            seq_len * batch, gate_len, input_size,
+            input_size, input_size, gate_len, 0,
+            1.0f, 1.0f, gemm_post::NONE, xgate_buf);
+
+        if (initial_h) {
+            memcpy(nd_Yh, initial_h + nd * batch * hidden_size, batch * hidden_size * sizeof(float));
+        } else {
+            memset(nd_Yh, 0, batch * hidden_size * sizeof(float));
+        }
+
+        for (int64_t seq_idx = 0; seq_idx < seq_len; ++seq_idx) {
+            const int64_t rzh_len = linear_before_reset ? gate_len : 2 * hidden_size;
+            gemm_ref_fp32( // h_{t-1}*R[nd]_{zr(h)}^T+Rb_{zr(h)}
+                nd_Yh, nd_R, nd_Rb, nullptr,
+                gemm_m_type::NOTRANS, gemm_m_type::TRANS,
+                gemm_v_type::ROW_VEC, gemm_m_type::EMPTY,
+                batch, rzh_len, hidden_size,
+                hidden_size, hidden_size, gate_len, 0,
+                1.0f, 1.0f, gemm_post::NONE, hgate_buf);
+
+            if (!linear_before_reset) {
+PRAGMA_OMP_PARALLEL_FOR()
+                for (int64_t b = 0; b < batch; ++b) {
+                    const int64_t valid_seq_len = rnn_valid_seq_len(sequence_lens, seq_len, b);
+                    if (seq_idx >= valid_seq_len) {
+                        continue;
+                    }
+                    const int64_t mapped_seq_index = rnn_mapped_seq_index(is_reverse, valid_seq_len, seq_idx);
+                    const float *hR = hgate_buf + b * gate_len + hidden_size;
+                    const float *xR = xgate_buf + (mapped_seq_index * batch + b) * gate_len + hidden_size;
+                    const float *Hprev = nd_Yh + b * hidden_size;
+                    float *rH = rh_buf + b * hidden_size;
+                    for (int64_t h = 0; h < hidden_size; ++h) {
+                        rH[h] = sigmoidf(xR[h] + hR[h]) * Hprev[h];
+                    }
+                }
+                gemm_ref_fp32( // (r_t (.) h_{t-1})*R[nd]_{h}^T+Rb_{h}
+                    rh_buf, nd_R + 2 * hidden_size * hidden_size, nd_Rb ? nd_Rb + 2 * hidden_size : nullptr, nullptr,
+                    gemm_m_type::NOTRANS, gemm_m_type::TRANS,
+                    gemm_v_type::ROW_VEC, gemm_m_type::EMPTY,
+                    batch, hidden_size, hidden_size,
+                    hidden_size, hidden_size, gate_len, 0,
+                    1.0f, 1.0f, gemm_post::NONE, hgate_buf + 2 * hidden_size);
+            }
+
+PRAGMA_OMP_PARALLEL_FOR()
+            for (int64_t b = 0; b < batch; ++b) {
+                float *Ht = nd_Yh + b * hidden_size;
+                const int64_t valid_seq_len = rnn_valid_seq_len(sequence_lens, seq_len, b);
+                if (seq_idx < valid_seq_len) {
+                    const int64_t mapped_seq_index = rnn_mapped_seq_index(is_reverse, valid_seq_len, seq_idx);
+                    const float *xZ = xgate_buf + (mapped_seq_index * batch + b) * gate_len;
+                    const float *xR = xZ + hidden_size;
+                    const float *xH = xR + hidden_size;
+                    const float *hZ = hgate_buf + b * gate_len;
+                    const float *hR = hZ + hidden_size;
+                    const float *hH = hR + hidden_size;
+                    for (int64_t h = 0; h < hidden_size; ++h) {
+                        const float zt = sigmoidf(xZ[h] + hZ[h]);
+                        float ht;
+                        if (linear_before_reset) {
+                            ht = ::tanhf(xH[h] + sigmoidf(xR[h] + hR[h]) * hH[h]);
+                        } else {
+                            ht = ::tanhf(xH[h] + hH[h]);
+                        }
+                        Ht[h] = (1.0f - zt) * ht + zt * Ht[h];
+                    }
+                    if (nd_Y) {
+                        float *Yt = nd_Y + mapped_seq_index * num_direction * batch * hidden_size + b * hidden_size;
+                        memcpy(Yt, Ht, hidden_size * sizeof(float));
+                    }
+                } else if (nd_Y) { // h_{t-1} passes through, Y is padded with zeros
+                    float *Yt = nd_Y + seq_idx * num_direction * batch * hidden_size + b * hidden_size;
+                    memset(Yt, 0, hidden_size * sizeof(float));
+                }
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,104 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/layer_norm.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+ppl::common::RetCode layer_norm_fp32_avx512(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    const float *scale,
+    const float *shift,
+    const int64_t axis,
+    const float eps,
+    float *dst)
+{
+    int64_t outer_dim = 1;
+    int64_t inner_dim = 1;
+    for (int64_t i = 0; i < axis; ++i) {
+        outer_dim *= src_shape->GetDim(i);
+    }
+    for (int64_t i = axis; i < src_shape->GetDimCount(); ++i) {
+        inner_dim *= src_shape->GetDim(i);
+    }
+
+    const int64_t simd_w = 16;
+    const int64_t unroll_inner = inner_dim / simd_w * simd_w;
+    const float r_inner = 1.0f / inner_dim;
+
+PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t i = 0; i < outer_dim; ++i) {
+        const float *p_src = src + i * inner_dim;
+        float *p_dst = dst + i * inner_dim;
+
+        float tmp[simd_w];
+        __m512 v_sum = _mm512_set1_ps(0.0f);
+        for (int64_t j = 0; j < unroll_inner; j += simd_w) {
+            v_sum = _mm512_add_ps(v_sum, _mm512_loadu_ps(p_src + j));
+        }
+        _mm512_storeu_ps(tmp, v_sum);
+        float sum = 0.0f;
+        for (int64_t k = 0; k < simd_w; ++k) {
+            sum += tmp[k];
+        }
+        for (int64_t j = unroll_inner; j < inner_dim; ++j) {
+            sum += p_src[j];
+        }
+        const float mean = sum * r_inner;
+
+        // two pass variance to match the precision of the unfused graph
+        const __m512 v_mean = _mm512_set1_ps(mean);
+        __m512 v_var = _mm512_set1_ps(0.0f);
+        for (int64_t j = 0; j < unroll_inner; j += simd_w) {
+            const __m512 v_diff = _mm512_sub_ps(_mm512_loadu_ps(p_src + j), v_mean);
+            v_var = _mm512_fmadd_ps(v_diff, v_diff, v_var);
+        }
+        _mm512_storeu_ps(tmp, v_var);
+        float var = 0.0f;
+        for (int64_t k = 0; k < simd_w; ++k) {
+            var += tmp[k];
+        }
+        for (int64_t j = unroll_inner; j < inner_dim; ++j) {
+            const float diff = p_src[j] - mean;
+            var += diff * diff;
+        }
+        const float rstd = 1.0f / sqrtf(var * r_inner + eps);
+
+        const __m512 v_rstd = _mm512_set1_ps(rstd);
+        for (int64_t j = 0; j < unroll_inner; j += simd_w) {
+            __m512 v_dst = _mm512_mul_ps(_mm512_sub_ps(_mm512_loadu_ps(p_src + j), v_mean), v_rstd);
+            if (scale) v_dst = _mm512_mul_ps(v_dst, _mm512_loadu_ps(scale + j));
+            if (shift) v_dst = _mm512_add_ps(v_dst, _mm512_loadu_ps(shift + j));
+            _mm512_storeu_ps(p_dst + j, v_dst);
+        }
+        for (int64_t j = unroll_inner; j < inner_dim; ++j) {
+            float y = (p_src[j] - mean) * rstd;
+            if (scale) y *= scale[j];
+            if (shift) y += shift[j];
+            p_dst[j] = y;
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
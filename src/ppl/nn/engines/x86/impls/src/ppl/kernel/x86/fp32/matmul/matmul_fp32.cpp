@@ -17,6 +17,7 @@
 
 #include <deque>
 #include <memory>
+#include <vector>
 
 #include "ppl/kernel/x86/common/internal_include.h"
 #include "ppl/kernel/x86/fp32/gemm_v2.h"
@@ -66,48 +67,67 @@ uint64_t matmul_ndarray_fp32_get_buffer_bytes(
     return executor->get_buffer_bytes();
 }
 
-static ppl::common::RetCode matmul_ndarray_recursive_fp32(
-    const float *src0,
+uint64_t matmul_ndarray_fp32_get_packed_b_bytes(
+    const ppl::nn::TensorShape *src1_shape,
+    const ppl::common::isa_t isa_flag)
+{
+    // only B without batch could be shared by all gemms
+    const int64_t dim_count = src1_shape->GetDimCount();
+    if (dim_count < 2) {
+        return 0;
+    }
+    const int64_t k = src1_shape->GetDim(dim_count - 2);
+    const int64_t n = src1_shape->GetDim(dim_count - 1);
+    if (n * k == 0 || src1_shape->GetElementsExcludingPadding() != n * k) {
+        return 0;
+    }
+
+    gemm_v2_param_fp32 param;
+    param.M        = 1;
+    param.N        = n;
+    param.K        = k;
+    param.ldb      = n;
+    param.isa_flag = isa_flag;
+
+    auto executor = std::unique_ptr<gemm_v2_executor_fp32>(create_gemm_v2_executor_fp32(param));
+    if (!executor) {
+        return 0;
+    }
+    return executor->get_packed_b_bytes();
+}
+
+ppl::common::RetCode matmul_ndarray_fp32_pack_b(
+    const ppl::nn::TensorShape *src1_shape,
     const float *src1,
-    gemm_v2_executor_fp32 *executor,
-    const int64_t *src0_strides,
-    const int64_t *src1_strides,
-    const int64_t *dst_strides,
-    const int64_t *dst_dims,
-    const int64_t dim_count,
-    const int64_t dim_idx,
-    const int32_t m,
-    const int32_t n,
-    const int32_t k,
-    float *dst)
+    const ppl::common::isa_t isa_flag,
+    void *packed_src1)
 {
-    if (dim_idx >= dim_count - 2) {
-        executor->get_param_mutable().src_A = src0;
-        executor->get_param_mutable().src_B = src1;
-        executor->get_param_mutable().dst_Y = dst;
-        return executor->execute();
-    } else {
-        const int64_t length = dst_dims[dim_idx];
-        for (int64_t i = 0; i < length; i++) {
-            ppl::common::RetCode ret = matmul_ndarray_recursive_fp32(
-                src0 + i * src0_strides[dim_idx], src1 + i * src1_strides[dim_idx], executor,
-                src0_strides, src1_strides, dst_strides, dst_dims,
-                dim_count, dim_idx + 1, m, n, k, dst + i * dst_strides[dim_idx]);
-            if (ret != ppl::common::RC_SUCCESS) {
-                return ret;
-            }
-        }
+    if (matmul_ndarray_fp32_get_packed_b_bytes(src1_shape, isa_flag) == 0) {
+        return ppl::common::RC_UNSUPPORTED;
     }
+    const int64_t dim_count = src1_shape->GetDimCount();
+
+    gemm_v2_param_fp32 param;
+    param.M        = 1;
+    param.N        = src1_shape->GetDim(dim_count - 1);
+    param.K        = src1_shape->GetDim(dim_count - 2);
+    param.ldb      = param.N;
+    param.isa_flag = isa_flag;
 
-    return ppl::common::RC_SUCCESS;
+    auto executor = std::unique_ptr<gemm_v2_executor_fp32>(create_gemm_v2_executor_fp32(param));
+    if (!executor) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    return executor->pack_b(src1, packed_src1);
 }
 
-ppl::common::RetCode matmul_ndarray_fp32(
+static ppl::common::RetCode matmul_ndarray_fp32_impl(
     const ppl::nn::TensorShape *src0_shape,
     const ppl::nn::TensorShape *src1_shape,
     const ppl::nn::TensorShape *dst_shape,
     const float *src0,
     const float *src1,
+    const void *packed_src1,
     const ppl::common::isa_t isa_flag,
     void *temp_buffer,
     float *dst)
@@ -150,48 +170,102 @@ ppl::common::RetCode matmul_ndarray_fp32(
     param.ldb      = n;
     param.ldy      = n;
     param.isa_flag = isa_flag; // other param use default value
-
-    auto executor = std::unique_ptr<gemm_v2_executor_fp32>(create_gemm_v2_executor_fp32(param));
-    if (!executor) {
-        return ppl::common::RC_UNSUPPORTED;
-    }
-    executor->set_temp_buffer(temp_buffer);
-
-    if (src0_dims.size() == 2 && src1_dims.size() == 2) { // normal gemm
-        executor->get_param_mutable().src_A = src0;
-        executor->get_param_mutable().src_B = src1;
-        executor->get_param_mutable().dst_Y = dst;
-        return executor->execute();
-    }
+    param.src_A    = src0;
+    param.src_B    = src1;
+    param.packed_B = packed_src1;
+    param.dst_Y    = dst;
 
     int64_t dst_dims[PPL_X86_TENSOR_MAX_DIMS()] = {0};
     dst_dims[max_dim_count - 2] = m;
     dst_dims[max_dim_count - 1] = n;
+    int64_t batch = 1;
     for (int64_t i = 0; i < max_dim_count - 2; i++) {
         dst_dims[i] = src0_dims[i] == src1_dims[i] ? src0_dims[i] : src0_dims[i] * src1_dims[i]; // assuming that can broadcast
+        batch *= dst_dims[i];
     }
 
-    int64_t src0_strides[PPL_X86_TENSOR_MAX_DIMS()] = {0};
-    int64_t src1_strides[PPL_X86_TENSOR_MAX_DIMS()] = {0};
-    int64_t dst_strides[PPL_X86_TENSOR_MAX_DIMS()] = {0};
-    src0_strides[max_dim_count - 1] = 1;
-    src1_strides[max_dim_count - 1] = 1;
-    dst_strides[max_dim_count - 1]  = 1;
-    for (int64_t i = max_dim_count - 2; i >= 0; i--) {
-        src0_strides[i] = src0_strides[i + 1] * src0_dims[i + 1];
-        src1_strides[i] = src1_strides[i + 1] * src1_dims[i + 1];
-        dst_strides[i]  = dst_strides[i + 1] * dst_dims[i + 1];
+    // broadcasted batches are run as one batched gemm, offsets of each gemm are computed by strides
+    std::vector<int64_t> batch_offsets;
+    if (batch > 1) {
+        if (packed_src1) {
+            return ppl::common::RC_INVALID_VALUE; // packed B must be shared by all batches and has been folded into M
+        }
+
+        int64_t src0_strides[PPL_X86_TENSOR_MAX_DIMS()] = {0};
+        int64_t src1_strides[PPL_X86_TENSOR_MAX_DIMS()] = {0};
+        int64_t dst_strides[PPL_X86_TENSOR_MAX_DIMS()] = {0};
+        src0_strides[max_dim_count - 1] = 1;
+        src1_strides[max_dim_count - 1] = 1;
+        dst_strides[max_dim_count - 1]  = 1;
+        for (int64_t i = max_dim_count - 2; i >= 0; i--) {
+            src0_strides[i] = src0_strides[i + 1] * src0_dims[i + 1];
+            src1_strides[i] = src1_strides[i + 1] * src1_dims[i + 1];
+            dst_strides[i]  = dst_strides[i + 1] * dst_dims[i + 1];
+        }
+        for (int64_t i = 0; i < max_dim_count - 2; i++) {
+            src0_strides[i] = src0_dims[i] == 1 ? 0 : src0_strides[i];
+            src1_strides[i] = src1_dims[i] == 1 ? 0 : src1_strides[i];
+        }
+
+        batch_offsets.resize(batch * 3);
+        int64_t *src0_offsets = batch_offsets.data();
+        int64_t *src1_offsets = src0_offsets + batch;
+        int64_t *dst_offsets  = src1_offsets + batch;
+        for (int64_t b = 0; b < batch; b++) {
+            int64_t src0_offset = 0;
+            int64_t src1_offset = 0;
+            int64_t dst_offset  = 0;
+            int64_t idx         = b;
+            for (int64_t i = max_dim_count - 3; i >= 0; i--) {
+                const int64_t dim_idx = idx % dst_dims[i];
+                idx /= dst_dims[i];
+                src0_offset += dim_idx * src0_strides[i];
+                src1_offset += dim_idx * src1_strides[i];
+                dst_offset += dim_idx * dst_strides[i];
+            }
+            src0_offsets[b] = src0_offset;
+            src1_offsets[b] = src1_offset;
+            dst_offsets[b]  = dst_offset;
+        }
+
+        param.batch          = batch;
+        param.batch_offset_A = src0_offsets;
+        param.batch_offset_B = src1_offsets;
+        param.batch_offset_Y = dst_offsets;
     }
-    for (int64_t i = 0; i < max_dim_count - 2; i++) {
-        src0_strides[i] = src0_dims[i] == 1 ? 0 : src0_strides[i];
-        src1_strides[i] = src1_dims[i] == 1 ? 0 : src1_strides[i];
+
+    auto executor = std::unique_ptr<gemm_v2_executor_fp32>(create_gemm_v2_executor_fp32(param));
+    if (!executor) {
+        return ppl::common::RC_UNSUPPORTED;
     }
+    executor->set_temp_buffer(temp_buffer);
+    return executor->execute();
+}
 
-    return matmul_ndarray_recursive_fp32(
-        src0, src1, executor.get(),
-        src0_strides, src1_strides,
-        dst_strides, dst_dims,
-        max_dim_count, 0, m, n, k, dst);
+ppl::common::RetCode matmul_ndarray_fp32(
+    const ppl::nn::TensorShape *src0_shape,
+    const ppl::nn::TensorShape *src1_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src0,
+    const float *src1,
+    const ppl::common::isa_t isa_flag,
+    void *temp_buffer,
+    float *dst)
+{
+    return matmul_ndarray_fp32_impl(src0_shape, src1_shape, dst_shape, src0, src1, nullptr, isa_flag, temp_buffer, dst);
+}
+
+ppl::common::RetCode matmul_ndarray_fp32_with_packed_b(
+    const ppl::nn::TensorShape *src0_shape,
+    const ppl::nn::TensorShape *src1_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src0,
+    const void *packed_src1,
+    const ppl::common::isa_t isa_flag,
+    void *temp_buffer,
+    float *dst)
+{
+    return matmul_ndarray_fp32_impl(src0_shape, src1_shape, dst_shape, src0, nullptr, packed_src1, isa_flag, temp_buffer, dst);
 }
 
 }}}; // namespace ppl::kernel::x86
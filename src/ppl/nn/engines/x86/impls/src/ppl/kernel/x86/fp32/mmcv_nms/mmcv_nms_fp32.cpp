@@ -15,72 +15,56 @@
 // specific language governing permissions and limitations
 // under the License.
 
-#include "ppl/kernel/x86/common/internal_include.h"
-
 #include <vector>
-#include <algorithm>
-#include <numeric>
-
-namespace ppl { namespace kernel { namespace x86 {
 
-inline float calc_iou(
-        const float *boxes,
-        const float *areas,
-        const int64_t i0,
-        const int64_t i1,
-        const int64_t offset)
-{
-    float ix1 = boxes[i0 * 4 + 0];
-    float iy1 = boxes[i0 * 4 + 1];
-    float ix2 = boxes[i0 * 4 + 2];
-    float iy2 = boxes[i0 * 4 + 3];
+#include "ppl/kernel/x86/fp32/mmcv_nms.h"
+#include "ppl/kernel/x86/fp32/nms/nms_fp32_common.h"
 
-    float xx1 = max(ix1, boxes[i1 * 4 + 0]);
-    float yy1 = max(iy1, boxes[i1 * 4 + 1]);
-    float xx2 = min(ix2, boxes[i1 * 4 + 2]);
-    float yy2 = min(iy2, boxes[i1 * 4 + 3]);
-
-    float w = max(0.f, xx2 - xx1 + offset);
-    float h = max(0.f, yy2 - yy1 + offset);
-
-    float inter = w * h;
-    float ovr = inter / (areas[i0] + areas[i1] - inter);
-    return ovr;
-}
+namespace ppl { namespace kernel { namespace x86 {
 
-ppl::common::RetCode mmcv_nms_ndarray_fp32_naive(
+ppl::common::RetCode mmcv_nms_ndarray_fp32_common(
         const float *boxes,
         const float *scores,
         const uint32_t num_boxes_in,
         const float iou_threshold,
         const int64_t offset,
+        const nms_suppressed_func_t suppressed_func,
         int64_t *dst,
         int64_t *num_boxes_out)
 {
+    *num_boxes_out = 0;
+    if (num_boxes_in == 0) {
+        return ppl::common::RC_SUCCESS;
+    }
+
     std::vector<uint32_t> sorted_index_(num_boxes_in);
-    std::vector<float> areas_(num_boxes_in);
+    std::vector<float> kept_buffer(num_boxes_in * 5);
     uint32_t *sorted_index = sorted_index_.data();
-    float *areas = areas_.data();
-
-    for (uint32_t i = 0; i < num_boxes_in; i++) {
-        areas[i] = (boxes[i * 4 + 2] - boxes[i * 4 + 0] + offset) * (boxes[i * 4 + 3] - boxes[i * 4 + 1] + offset);
-    }
     argsort(scores, sorted_index, num_boxes_in);
 
-    *num_boxes_out = 0;
+    nms_kept_boxes_fp32 kept;
+    kept.x1   = kept_buffer.data() + 0 * num_boxes_in;
+    kept.y1   = kept_buffer.data() + 1 * num_boxes_in;
+    kept.x2   = kept_buffer.data() + 2 * num_boxes_in;
+    kept.y2   = kept_buffer.data() + 3 * num_boxes_in;
+    kept.area = kept_buffer.data() + 4 * num_boxes_in;
+    kept.num  = 0;
+
+    const float f_offset = offset;
     for (uint32_t i = 0; i < num_boxes_in; i++) {
-        int64_t idx = sorted_index[i];
-        bool keep = true;
-        for (int64_t j = 0; j < *num_boxes_out; j++) {
-            float iou = calc_iou(boxes, areas, idx, dst[j], offset);
-            if (iou >= iou_threshold) {
-                keep = false;
-                break;
-            }
-        }
-        if (keep) {
-            dst[(*num_boxes_out)++] = idx;
+        const uint32_t idx = sorted_index[i];
+        const float *b     = boxes + idx * 4;
+        const float box[5] = {b[0], b[1], b[2], b[3], (b[2] - b[0] + f_offset) * (b[3] - b[1] + f_offset)};
+        if (suppressed_func(&kept, box, iou_threshold, f_offset, true)) {
+            continue;
         }
+        kept.x1[kept.num]   = box[0];
+        kept.y1[kept.num]   = box[1];
+        kept.x2[kept.num]   = box[2];
+        kept.y2[kept.num]   = box[3];
+        kept.area[kept.num] = box[4];
+        ++kept.num;
+        dst[(*num_boxes_out)++] = idx;
     }
 
     return ppl::common::RC_SUCCESS;
@@ -95,7 +79,7 @@ ppl::common::RetCode mmcv_nms_ndarray_fp32(
         int64_t *dst,
         int64_t *num_boxes_out)
 {
-    return mmcv_nms_ndarray_fp32_naive(boxes, scores, num_boxes_in, iou_threshold, offset, dst, num_boxes_out);
+    return mmcv_nms_ndarray_fp32_common(boxes, scores, num_boxes_in, iou_threshold, offset, nms_suppressed_fp32, dst, num_boxes_out);
 }
 
 }}}; // namespace ppl::kernel::x86
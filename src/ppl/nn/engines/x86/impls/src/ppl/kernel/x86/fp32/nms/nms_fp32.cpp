@@ -15,109 +15,138 @@
 // specific language governing permissions and limitations
 // under the License.
 
-
 #include <algorithm>
 #include <vector>
 
-#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/nms.h"
+#include "ppl/kernel/x86/fp32/nms/nms_fp32_common.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
-inline float calc_iou(const float *p_boxes, int64_t i0, int64_t i1, bool centered)
+bool nms_suppressed_fp32(
+    const nms_kept_boxes_fp32 *kept,
+    const float *box,
+    const float iou_threshold,
+    const float offset,
+    const bool inclusive)
 {
-    const float *b0 = p_boxes + i0 * 4;
-    const float *b1 = p_boxes + i1 * 4;
-    float x_min, x_max, y_min, y_max;
-    float w0, w1, h0, h1;
-    if (centered == true) { // tf_format: [x_center, y_center, width, height]
-        w0    = b0[2];
-        w1    = b1[2];
-        h0    = b0[3];
-        h1    = b1[3];
-        x_min = min(b0[0] - w0 / 2, b1[0] - w1 / 2);
-        x_max = max(b0[0] + w0 / 2, b1[0] + w1 / 2);
-        y_min = min(b0[1] - h0 / 2, b1[1] - h1 / 2);
-        y_max = max(b0[1] + h0 / 2, b1[1] + h1 / 2);
-    } else { // pytorch_format: [y1, x1, y2, x2]
-        w0    = abs(b0[1] - b0[3]);
-        w1    = abs(b1[1] - b1[3]);
-        h0    = abs(b0[0] - b0[2]);
-        h1    = abs(b1[0] - b1[2]);
-        x_min = min(min(b0[1], b0[3]), min(b1[1], b1[3]));
-        x_max = max(max(b0[1], b0[3]), max(b1[1], b1[3]));
-        y_min = min(min(b0[0], b0[2]), min(b1[0], b1[2]));
-        y_max = max(max(b0[0], b0[2]), max(b1[0], b1[2]));
-    }
-
-    if (w0 + w1 <= x_max - x_min || h0 + h1 <= y_max - y_min) {
-        return 0;
+    for (int64_t i = 0; i < kept->num; i++) {
+        const float iou = nms_iou_fp32(kept, i, box, offset);
+        if (inclusive ? iou >= iou_threshold : iou > iou_threshold) {
+            return true;
+        }
     }
-
-    float area0 = w0 * h0, area1 = w1 * h1;
-    float iw = w0 + w1 - (x_max - x_min);
-    float ih = h0 + h1 - (y_max - y_min);
-    float I  = ih * iw;
-    float U  = area0 + area1 - I;
-
-    return I / U;
+    return false;
 }
 
-static ppl::common::RetCode nms_ndarray_naive(
+ppl::common::RetCode nms_ndarray_fp32_common(
     const float *boxes,
-    const float *scommons,
+    const float *scores,
     const uint32_t num_boxes_in,
     const uint32_t batch,
     const uint32_t num_classes,
     const bool center_point_box,
-    const int64_t maxoutput_boxes_per_batch_per_class,
+    const int64_t max_output_boxes_per_batch_per_class,
     const float iou_threshold,
-    const float scommon_threshold,
+    const float score_threshold,
+    const nms_suppressed_func_t suppressed_func,
     int64_t *dst,
     int64_t *num_boxes_out)
 {
-    std::vector<uint32_t> sorted_index_;
-    std::vector<uint32_t> selected_index_;
-    sorted_index_.resize(num_boxes_in);
-    selected_index_.resize(num_boxes_in);
-    uint32_t *sorted_index   = sorted_index_.data();
-    uint32_t *selected_index = selected_index_.data();
-
-    uint64_t out_idx = 0;
-    for (int64_t n = 0; n < batch; n++) {
-        const float *p_boxes = boxes + n * num_boxes_in * 4;
-        for (int64_t c = 0; c < num_classes; c++) {
-            int64_t selected_num   = 0;
-            const float *p_scommons = scommons + (n * num_classes + c) * num_boxes_in;
-            argsort(p_scommons, sorted_index, num_boxes_in);
-            for (int64_t i = 0; i < num_boxes_in; i++) {
-                int64_t idx = sorted_index[i];
-                if (p_scommons[idx] <= scommon_threshold) {
-                    break;
-                }
-                bool keep = true;
-                for (int64_t j = 0; j < selected_num; j++) {
-                    float iou = calc_iou(p_boxes, idx, selected_index[j], center_point_box);
-                    if (iou > iou_threshold) {
-                        keep = false;
-                        break;
-                    }
-                }
-                if (keep) { // box i has not been suppressed
-                    selected_index[selected_num++] = idx;
-                }
-                if (selected_num >= maxoutput_boxes_per_batch_per_class) {
-                    break;
-                }
+    *num_boxes_out = 0;
+    if (max_output_boxes_per_batch_per_class <= 0 || num_boxes_in == 0 || batch == 0 || num_classes == 0) {
+        return ppl::common::RC_SUCCESS;
+    }
+
+    // boxes of all batches in {x1, y1, x2, y2, area}
+    const int64_t box_len = 5;
+    std::vector<float> cvt_boxes_((int64_t)batch * num_boxes_in * box_len);
+    float *cvt_boxes = cvt_boxes_.data();
+PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t i = 0; i < (int64_t)batch * num_boxes_in; i++) {
+        const float *b = boxes + i * 4;
+        float *cb      = cvt_boxes + i * box_len;
+        if (center_point_box) { // tf_format: [x_center, y_center, width, height]
+            cb[0] = b[0] - b[2] / 2;
+            cb[1] = b[1] - b[3] / 2;
+            cb[2] = b[0] + b[2] / 2;
+            cb[3] = b[1] + b[3] / 2;
+        } else { // pytorch_format: [y1, x1, y2, x2]
+            cb[0] = min(b[1], b[3]);
+            cb[1] = min(b[0], b[2]);
+            cb[2] = max(b[1], b[3]);
+            cb[3] = max(b[0], b[2]);
+        }
+        cb[4] = (cb[2] - cb[0]) * (cb[3] - cb[1]);
+    }
+
+    const int64_t num_tasks = (int64_t)batch * num_classes;
+    const int64_t max_kept  = min<int64_t>(max_output_boxes_per_batch_per_class, num_boxes_in);
+    std::vector<std::vector<uint32_t>> selected_index(num_tasks);
+
+PRAGMA_OMP_PARALLEL_FOR_SCHEDULE(dynamic)
+    for (int64_t t = 0; t < num_tasks; t++) {
+        const float *p_scores = scores + t * num_boxes_in;
+        const float *p_boxes  = cvt_boxes + t / num_classes * num_boxes_in * box_len;
+
+        std::vector<uint32_t> candidates;
+        for (uint32_t i = 0; i < num_boxes_in; i++) {
+            if (p_scores[i] > score_threshold) {
+                candidates.push_back(i);
             }
-            // process result
-            for (int64_t i = 0; i < selected_num; i++) {
-                int64_t *p_dst = dst + out_idx * 3;
-
-                p_dst[0] = n;
-                p_dst[1] = c;
-                p_dst[2] = selected_index[i];
-                out_idx++;
+        }
+        if (candidates.empty()) {
+            continue;
+        }
+
+        // candidates are popped from a heap in descending order of scores, so that only boxes examined are sorted.
+        // boxes with the same score are popped in ascending order of indices.
+        auto less = [p_scores](const uint32_t a, const uint32_t b) {
+            return p_scores[a] < p_scores[b] || (p_scores[a] == p_scores[b] && a > b);
+        };
+        std::make_heap(candidates.begin(), candidates.end(), less);
+
+        const int64_t kept_cap = min<int64_t>(max_kept, candidates.size());
+        std::vector<float> kept_buffer(kept_cap * box_len);
+        nms_kept_boxes_fp32 kept;
+        kept.x1   = kept_buffer.data() + 0 * kept_cap;
+        kept.y1   = kept_buffer.data() + 1 * kept_cap;
+        kept.x2   = kept_buffer.data() + 2 * kept_cap;
+        kept.y2   = kept_buffer.data() + 3 * kept_cap;
+        kept.area = kept_buffer.data() + 4 * kept_cap;
+        kept.num  = 0;
+
+        auto &p_selected_index = selected_index[t];
+        auto heap_end          = candidates.end();
+        while (heap_end != candidates.begin() && kept.num < kept_cap) {
+            std::pop_heap(candidates.begin(), heap_end, less);
+            --heap_end;
+            const uint32_t idx = *heap_end;
+            const float *box   = p_boxes + idx * box_len;
+            if (suppressed_func(&kept, box, iou_threshold, 0.0f, false)) {
+                continue;
             }
+            kept.x1[kept.num]   = box[0];
+            kept.y1[kept.num]   = box[1];
+            kept.x2[kept.num]   = box[2];
+            kept.y2[kept.num]   = box[3];
+            kept.area[kept.num] = box[4];
+            ++kept.num;
+            p_selected_index.push_back(idx);
+        }
+    }
+
+    // process result
+    int64_t out_idx = 0;
+    for (int64_t t = 0; t < num_tasks; t++) {
+        auto &p_selected_index = selected_index[t];
+        for (size_t i = 0; i < p_selected_index.size(); i++) {
+            int64_t *p_dst = dst + out_idx * 3;
+
+            p_dst[0] = t / num_classes;
+            p_dst[1] = t % num_classes;
+            p_dst[2] = p_selected_index[i];
+            out_idx++;
         }
     }
 
@@ -127,18 +156,20 @@ static ppl::common::RetCode nms_ndarray_naive(
 
 ppl::common::RetCode nms_ndarray_fp32(
     const float *boxes,
-    const float *scommons,
+    const float *scores,
     const uint32_t num_boxes_in,
     const uint32_t batch,
     const uint32_t num_classes,
     const bool center_point_box,
-    const int64_t maxoutput_boxes_per_batch_per_class,
+    const int64_t max_output_boxes_per_batch_per_class,
     const float iou_threshold,
-    const float scommon_threshold,
+    const float score_threshold,
     int64_t *dst,
     int64_t *num_boxes_out)
 {
-    return nms_ndarray_naive(boxes, scommons, num_boxes_in, batch, num_classes, center_point_box, maxoutput_boxes_per_batch_per_class, iou_threshold, scommon_threshold, dst, num_boxes_out);
+    return nms_ndarray_fp32_common(
+        boxes, scores, num_boxes_in, batch, num_classes, center_point_box, max_output_boxes_per_batch_per_class,
+        iou_threshold, score_threshold, nms_suppressed_fp32, dst, num_boxes_out);
 }
 
 }}}; // namespace ppl::kernel::x86
@@ -0,0 +1,88 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/fp32/nms.h"
+#include "ppl/kernel/x86/fp32/nms/nms_fp32_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+bool nms_suppressed_fp32_avx512(
+    const nms_kept_boxes_fp32 *kept,
+    const float *box,
+    const float iou_threshold,
+    const float offset,
+    const bool inclusive)
+{
+    const int64_t simd_w = 16;
+
+    const __m512 v_x1            = _mm512_set1_ps(box[0]);
+    const __m512 v_y1            = _mm512_set1_ps(box[1]);
+    const __m512 v_x2            = _mm512_set1_ps(box[2]);
+    const __m512 v_y2            = _mm512_set1_ps(box[3]);
+    const __m512 v_area          = _mm512_set1_ps(box[4]);
+    const __m512 v_offset        = _mm512_set1_ps(offset);
+    const __m512 v_zero          = _mm512_setzero_ps();
+    const __m512 v_iou_threshold = _mm512_set1_ps(iou_threshold);
+
+    for (int64_t i = 0; i < kept->num; i += simd_w) {
+        const __mmask16 k = kept->num - i >= simd_w ? 0xffff : (__mmask16)((1u << (kept->num - i)) - 1);
+
+        __m512 v_w = _mm512_sub_ps(
+            _mm512_min_ps(v_x2, _mm512_maskz_loadu_ps(k, kept->x2 + i)),
+            _mm512_max_ps(v_x1, _mm512_maskz_loadu_ps(k, kept->x1 + i)));
+        __m512 v_h = _mm512_sub_ps(
+            _mm512_min_ps(v_y2, _mm512_maskz_loadu_ps(k, kept->y2 + i)),
+            _mm512_max_ps(v_y1, _mm512_maskz_loadu_ps(k, kept->y1 + i)));
+        v_w = _mm512_max_ps(_mm512_add_ps(v_w, v_offset), v_zero);
+        v_h = _mm512_max_ps(_mm512_add_ps(v_h, v_offset), v_zero);
+
+        const __m512 v_inter = _mm512_mul_ps(v_w, v_h);
+        const __m512 v_union = _mm512_sub_ps(_mm512_add_ps(v_area, _mm512_maskz_loadu_ps(k, kept->area + i)), v_inter);
+        const __m512 v_iou   = _mm512_div_ps(v_inter, v_union);
+
+        const __mmask16 suppressed = inclusive
+            ? _mm512_mask_cmp_ps_mask(k, v_iou, v_iou_threshold, _CMP_GE_OQ)
+            : _mm512_mask_cmp_ps_mask(k, v_iou, v_iou_threshold, _CMP_GT_OQ);
+        if (suppressed) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ppl::common::RetCode nms_ndarray_fp32_avx512(
+    const float *boxes,
+    const float *scores,
+    const uint32_t num_boxes_in,
+    const uint32_t batch,
+    const uint32_t num_classes,
+    const bool center_point_box,
+    const int64_t max_output_boxes_per_batch_per_class,
+    const float iou_threshold,
+    const float score_threshold,
+    int64_t *dst,
+    int64_t *num_boxes_out)
+{
+    return nms_ndarray_fp32_common(
+        boxes, scores, num_boxes_in, batch, num_classes, center_point_box, max_output_boxes_per_batch_per_class,
+        iou_threshold, score_threshold, nms_suppressed_fp32_avx512, dst, num_boxes_out);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,105 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_NMS_NMS_FP32_COMMON_H_
+#define __ST_PPL_KERNEL_X86_FP32_NMS_NMS_FP32_COMMON_H_
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// boxes kept so far by nms, stored as structure of arrays for vectorized iou computation
+struct nms_kept_boxes_fp32 {
+    float *x1;
+    float *y1;
+    float *x2;
+    float *y2;
+    float *area;
+    int64_t num;
+};
+
+// returns true if iou of `box` {x1, y1, x2, y2, area} and any box in `kept` is greater than `iou_threshold`,
+// or not less than `iou_threshold` if `inclusive` is true. `offset` is added to width and height of intersections.
+typedef bool (*nms_suppressed_func_t)(
+    const nms_kept_boxes_fp32 *kept,
+    const float *box,
+    const float iou_threshold,
+    const float offset,
+    const bool inclusive);
+
+inline float nms_iou_fp32(
+    const nms_kept_boxes_fp32 *kept,
+    const int64_t i,
+    const float *box,
+    const float offset)
+{
+    const float w     = max(min(box[2], kept->x2[i]) - max(box[0], kept->x1[i]) + offset, 0.0f);
+    const float h     = max(min(box[3], kept->y2[i]) - max(box[1], kept->y1[i]) + offset, 0.0f);
+    const float inter = w * h;
+    return inter / (box[4] + kept->area[i] - inter);
+}
+
+bool nms_suppressed_fp32(
+    const nms_kept_boxes_fp32 *kept,
+    const float *box,
+    const float iou_threshold,
+    const float offset,
+    const bool inclusive);
+
+bool nms_suppressed_fp32_fma(
+    const nms_kept_boxes_fp32 *kept,
+    const float *box,
+    const float iou_threshold,
+    const float offset,
+    const bool inclusive);
+
+#ifdef PPL_USE_X86_AVX512
+bool nms_suppressed_fp32_avx512(
+    const nms_kept_boxes_fp32 *kept,
+    const float *box,
+    const float iou_threshold,
+    const float offset,
+    const bool inclusive);
+#endif
+
+ppl::common::RetCode nms_ndarray_fp32_common(
+    const float *boxes,
+    const float *scores,
+    const uint32_t num_boxes_in,
+    const uint32_t batch,
+    const uint32_t num_classes,
+    const bool center_point_box,
+    const int64_t max_output_boxes_per_batch_per_class,
+    const float iou_threshold,
+    const float score_threshold,
+    const nms_suppressed_func_t suppressed_func,
+    int64_t *dst,
+    int64_t *num_boxes_out);
+
+ppl::common::RetCode mmcv_nms_ndarray_fp32_common(
+    const float *boxes,
+    const float *scores,
+    const uint32_t num_boxes_in,
+    const float iou_threshold,
+    const int64_t offset,
+    const nms_suppressed_func_t suppressed_func,
+    int64_t *dst,
+    int64_t *num_boxes_out);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,159 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/rnn.h"
+#include "ppl/kernel/x86/fp32/gemm.h"
+#include "ppl/kernel/x86/common/avx_tools.h"
+#include "ppl/kernel/x86/common/math_fma.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+uint64_t rnn_fp32_fma_get_buffer_bytes(
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool has_Y,
+    const bool has_Y_h)
+{
+    if (!has_Y && !has_Y_h)
+        return 64u;
+
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+
+    const uint64_t xgate_buff_size = seq_len * batch * rnn_num_gate::RNN * hidden_size;
+    const uint64_t hgate_buff_size = batch * rnn_num_gate::RNN * hidden_size;
+    const uint64_t yh_size = has_Y_h ? 0 : num_direction * batch * hidden_size;
+
+    return (xgate_buff_size + hgate_buff_size + yh_size) * sizeof(float);
+}
+
+ppl::common::RetCode rnn_fp32_fma(
+    const ppl::nn::TensorShape *X_shape,
+    const float *X,
+    const float *X_weight,
+    const float *R_weight,
+    const float *bias,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h)
+{
+    if (!Y && !Y_h) {
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t simd_w = 8;
+
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t input_size = X_shape->GetDim(2);
+    const gemm_v_type_t bias_type = bias ? gemm_v_type::ROW_VEC : gemm_v_type::EMPTY;
+
+    float *Yh_buf = Y_h;
+
+    // set temp buffer
+    float *temp_buffer_fp32 = reinterpret_cast<float*>(temp_buffer);
+    if (!Yh_buf) {
+        Yh_buf = temp_buffer_fp32;
+        temp_buffer_fp32 += num_direction * batch * hidden_size;
+    }
+    float *xgate_buf = temp_buffer_fp32;
+    float *hgate_buf = xgate_buf + seq_len * batch * hidden_size;
+
+    for (int64_t nd = 0; nd < num_direction; ++nd) {
+        const bool is_reverse = nd || (direction == rnn_direction::REVERSE);
+
+        // X (seq_len, batch, input_size)
+        // h_0 (num_direction, batch, hidden_size)
+        // Y (seq_len, num_direction, batch, hidden_size)
+        // h_n (num_direction, batch, hidden_size)
+
+        float *nd_Yh = Yh_buf + nd * batch * hidden_size;
+        float *nd_Y = Y ? Y + nd * batch * hidden_size : nullptr;
+
+        const float *nd_W = X_weight + nd * hidden_size * input_size;
+        const float *nd_R = R_weight + nd * hidden_size * hidden_size;
+        const float *nd_Wb = bias ? bias + nd * 2 * hidden_size : nullptr;
+        const float *nd_Rb = bias ? nd_Wb + hidden_size : nullptr;
+
+        // input projection of all timesteps does not depend on h, do it as one big gemm
+        gemm_fp32_fma( // X*W[nd]_{i}^T+Wb_{i}
+            X, nd_W, nd_Wb, nullptr,
+            gemm_m_type::NOTRANS, gemm_m_type::TRANS,
+            bias_type, gemm_m_type::EMPTY,
+            seq_len * batch, hidden_size, input_size,
+            input_size, input_size, hidden_size, 0,
+            1.0f, 1.0f, gemm_post::NONE, xgate_buf);
+
+        // nd_Yh always holds h_{t-1} when entering a timestep
+        if (initial_h) {
+            memcpy32_avx(nd_Yh, initial_h + nd * batch * hidden_size, batch * hidden_size);
+        } else {
+            memset32_avx(nd_Yh, 0, batch * hidden_size);
+        }
+
+        for (int64_t seq_idx = 0; seq_idx < seq_len; ++seq_idx) {
+            gemm_fp32_fma( // h_{t-1}*R[nd]_{i}^T+Rb_{i}
+                nd_Yh, nd_R, nd_Rb, nullptr,
+                gemm_m_type::NOTRANS, gemm_m_type::TRANS,
+                bias_type, gemm_m_type::EMPTY,
+                batch, hidden_size, hidden_size,
+                hidden_size, hidden_size, hidden_size, 0,
+                1.0f, 1.0f, gemm_post::NONE, hgate_buf);
+
+PRAGMA_OMP_PARALLEL_FOR()
+            for (int64_t b = 0; b < batch; ++b) {
+                float *Ht = nd_Yh + b * hidden_size;
+                const int64_t valid_seq_len = rnn_valid_seq_len(sequence_lens, seq_len, b);
+                if (seq_idx < valid_seq_len) {
+                    // X[s]*W[nd]_{i}^T+Wb_{i} is added here because reversed sequences may be at different steps
+                    const int64_t mapped_seq_index = rnn_mapped_seq_index(is_reverse, valid_seq_len, seq_idx);
+                    const float *xI = xgate_buf + (mapped_seq_index * batch + b) * hidden_size;
+                    const float *hI = hgate_buf + b * hidden_size;
+                    int64_t h = 0;
+                    for (; h <= hidden_size - simd_w; h += simd_w) {
+                        _mm256_storeu_ps(Ht + h, _fma_tanh_ps(_mm256_loadu_ps(xI + h) + _mm256_loadu_ps(hI + h)));
+                    }
+                    for (; h < hidden_size; ++h) {
+                        Ht[h] = ::tanhf(xI[h] + hI[h]);
+                    }
+                    if (nd_Y) {
+                        float *Yt = nd_Y + mapped_seq_index * num_direction * batch * hidden_size + b * hidden_size;
+                        memcpy32_avx(Yt, Ht, hidden_size);
+                    }
+                } else if (nd_Y) { // h_{t-1} passes through, Y is padded with zeros
+                    float *Yt = nd_Y + seq_idx * num_direction * batch * hidden_size + b * hidden_size;
+                    memset32_avx(Yt, 0, hidden_size);
+                }
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
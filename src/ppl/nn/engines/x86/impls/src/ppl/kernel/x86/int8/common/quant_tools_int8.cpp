@@ -0,0 +1,64 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+#include "ppl/kernel/x86/int8/common/quant_tools_int8.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+void quant_and_pack_filter_int8(
+    const float *filter,
+    const int64_t oc,
+    const int64_t k,
+    const int64_t oc_blk,
+    const float src_scale,
+    int8_t *packed_filter,
+    int32_t *comp,
+    float *scale)
+{
+    const int64_t padded_oc = round_up(oc, oc_blk);
+    const int64_t padded_k  = round_up(k, 4);
+
+    memset(packed_filter, 0, padded_oc * padded_k * sizeof(int8_t));
+    memset(comp, 0, padded_oc * sizeof(int32_t));
+    memset(scale, 0, padded_oc * sizeof(float));
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t o = 0; o < oc; ++o) {
+        const float *l_flt = filter + o * k;
+        float abs_max      = 0.0f;
+        for (int64_t i = 0; i < k; ++i) {
+            abs_max = max(abs_max, abs(l_flt[i]));
+        }
+        const float flt_scale     = abs_max > 0.0f ? abs_max / INT8_QUANT_MAX() : 1.0f;
+        const float inv_flt_scale = 1.0f / flt_scale;
+
+        int8_t *l_packed = packed_filter + (o / oc_blk) * padded_k * oc_blk + (o % oc_blk) * 4;
+        int32_t sum      = 0;
+        for (int64_t i = 0; i < k; ++i) {
+            int32_t q = static_cast<int32_t>(nearbyintf(l_flt[i] * inv_flt_scale));
+            q         = min<int32_t>(max<int32_t>(q, -INT8_QUANT_MAX()), INT8_QUANT_MAX());
+            l_packed[(i / 4) * oc_blk * 4 + i % 4] = static_cast<int8_t>(q);
+            sum += q;
+        }
+        comp[o]  = INT8_SRC_ZERO_POINT() * sum;
+        scale[o] = src_scale * flt_scale;
+    }
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,55 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_INT8_COMMON_QUANT_TOOLS_INT8_H_
+#define __ST_PPL_KERNEL_X86_INT8_COMMON_QUANT_TOOLS_INT8_H_
+
+#include <math.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// symmetric quantization range, -128 is not used so that u8 * s8 products never saturate
+#define INT8_QUANT_MAX() 127
+// src is stored as uint8 with this zero point to fit the u8 * s8 dot product instructions
+#define INT8_SRC_ZERO_POINT() 128
+
+inline uint8_t quant_fp32_to_u8(const float x, const float inv_scale)
+{
+    int32_t q = static_cast<int32_t>(nearbyintf(x * inv_scale));
+    q = min<int32_t>(max<int32_t>(q, -INT8_QUANT_MAX()), INT8_QUANT_MAX());
+    return static_cast<uint8_t>(q + INT8_SRC_ZERO_POINT());
+}
+
+// Quantizes filter [oc][k] per output channel and packs it into [padded_oc / oc_blk][padded_k / 4][oc_blk][4],
+// padded_oc is rounded up to oc_blk and padded_k is rounded up to 4, paddings are filled with zero.
+// comp[padded_oc] is INT8_SRC_ZERO_POINT() * sum(quantized filter) which is subtracted from the accumulator,
+// scale[padded_oc] is src_scale * filter_scale which converts the accumulator back to fp32.
+void quant_and_pack_filter_int8(
+    const float *filter,
+    const int64_t oc,
+    const int64_t k,
+    const int64_t oc_blk,
+    const float src_scale,
+    int8_t *packed_filter,
+    int32_t *comp,
+    float *scale);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,421 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/int8/conv2d/avx512vnni/conv2d_int8_avx512vnni.h"
+#include "ppl/kernel/x86/int8/common/quant_tools_int8.h"
+
+#define OC_KR_BLK() CONV2D_INT8_AVX512VNNI_OC_BLK()
+#define HW_DT_BLK() 16
+#define HW_KR_BLK() (2 * HW_DT_BLK())
+
+#define HW_L2_BLK_MAX()   1024
+#define SRC_L2_BLK_BYTES() (256 * 1024)
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct conv2d_int8_kernel_param {
+    const uint8_t *src;        // [padded_k / 4][src_k4_stride / 4][4]
+    const int8_t *flt;         // [padded_k / 4][OC_KR_BLK()][4]
+    const int32_t *comp;
+    const float *scale;
+    const float *bias;
+    float *dst;
+    int64_t src_k4_stride;     // in bytes
+    int64_t k4_count;
+    int64_t dst_oc_stride;
+    __mmask16 tail_mask;       // mask of the last hw vector
+    conv_fuse_flag_t fuse_flag;
+};
+
+typedef void (*conv2d_int8_kernel_func_t)(const conv2d_int8_kernel_param &);
+
+static inline __m512 conv2d_int8_dequant_avx512(
+    const __m512i acc,
+    const int64_t oc,
+    const conv2d_int8_kernel_param &kp)
+{
+    __m512 v = _mm512_cvtepi32_ps(_mm512_sub_epi32(acc, _mm512_set1_epi32(kp.comp[oc])));
+    v        = _mm512_fmadd_ps(v, _mm512_set1_ps(kp.scale[oc]), _mm512_set1_ps(kp.bias[oc]));
+    if (kp.fuse_flag & (conv_fuse_flag::RELU | conv_fuse_flag::RELU6)) {
+        v = _mm512_max_ps(v, _mm512_setzero_ps());
+    }
+    if (kp.fuse_flag & conv_fuse_flag::RELU6) {
+        v = _mm512_min_ps(v, _mm512_set1_ps(6.0f));
+    }
+    return v;
+}
+
+// dst[oc_len][hw] = sum(flt[oc_len][k] * src[k][hw]), src is broadcast along oc and flt is broadcast along hw
+template <int64_t oc_len, int64_t hw_len>
+void conv2d_int8_kernel_avx512vnni(const conv2d_int8_kernel_param &kp)
+{
+#define DECL_ACC(OC) __m512i acc##OC##0 = _mm512_setzero_si512(), acc##OC##1 = _mm512_setzero_si512()
+#define DPBUSD(OC)                                                      \
+    do {                                                                \
+        if (oc_len > OC) {                                              \
+            const __m512i w = _mm512_set1_epi32(l_flt[OC]);             \
+            acc##OC##0      = _mm512_dpbusd_epi32(acc##OC##0, s0, w);   \
+            if (hw_len > 1) acc##OC##1 = _mm512_dpbusd_epi32(acc##OC##1, s1, w); \
+        }                                                               \
+    } while (0)
+#define STORE_ACC(OC)                                                                          \
+    do {                                                                                       \
+        if (oc_len > OC) {                                                                     \
+            float *l_dst = kp.dst + OC * kp.dst_oc_stride;                                     \
+            if (hw_len > 1) {                                                                  \
+                _mm512_storeu_ps(l_dst, conv2d_int8_dequant_avx512(acc##OC##0, OC, kp));       \
+                _mm512_mask_storeu_ps(l_dst + HW_DT_BLK(), kp.tail_mask, conv2d_int8_dequant_avx512(acc##OC##1, OC, kp)); \
+            } else {                                                                           \
+                _mm512_mask_storeu_ps(l_dst, kp.tail_mask, conv2d_int8_dequant_avx512(acc##OC##0, OC, kp)); \
+            }                                                                                  \
+        }                                                                                      \
+    } while (0)
+
+    DECL_ACC(0); DECL_ACC(1); DECL_ACC(2); DECL_ACC(3);
+    DECL_ACC(4); DECL_ACC(5); DECL_ACC(6); DECL_ACC(7);
+
+    const uint8_t *l_src = kp.src;
+    const int32_t *l_flt = reinterpret_cast<const int32_t *>(kp.flt);
+    for (int64_t k4 = 0; k4 < kp.k4_count; ++k4) {
+        __m512i s0, s1;
+        if (hw_len > 1) {
+            s0 = _mm512_loadu_si512(l_src);
+            s1 = _mm512_maskz_loadu_epi32(kp.tail_mask, l_src + HW_DT_BLK() * 4);
+        } else {
+            s0 = _mm512_maskz_loadu_epi32(kp.tail_mask, l_src);
+        }
+        DPBUSD(0); DPBUSD(1); DPBUSD(2); DPBUSD(3);
+        DPBUSD(4); DPBUSD(5); DPBUSD(6); DPBUSD(7);
+        l_src += kp.src_k4_stride;
+        l_flt += OC_KR_BLK();
+    }
+
+    STORE_ACC(0); STORE_ACC(1); STORE_ACC(2); STORE_ACC(3);
+    STORE_ACC(4); STORE_ACC(5); STORE_ACC(6); STORE_ACC(7);
+
+#undef DECL_ACC
+#undef DPBUSD
+#undef STORE_ACC
+}
+
+static const conv2d_int8_kernel_func_t conv2d_int8_kernel_table[OC_KR_BLK()][2] = {
+    {conv2d_int8_kernel_avx512vnni<1, 1>, conv2d_int8_kernel_avx512vnni<1, 2>},
+    {conv2d_int8_kernel_avx512vnni<2, 1>, conv2d_int8_kernel_avx512vnni<2, 2>},
+    {conv2d_int8_kernel_avx512vnni<3, 1>, conv2d_int8_kernel_avx512vnni<3, 2>},
+    {conv2d_int8_kernel_avx512vnni<4, 1>, conv2d_int8_kernel_avx512vnni<4, 2>},
+    {conv2d_int8_kernel_avx512vnni<5, 1>, conv2d_int8_kernel_avx512vnni<5, 2>},
+    {conv2d_int8_kernel_avx512vnni<6, 1>, conv2d_int8_kernel_avx512vnni<6, 2>},
+    {conv2d_int8_kernel_avx512vnni<7, 1>, conv2d_int8_kernel_avx512vnni<7, 2>},
+    {conv2d_int8_kernel_avx512vnni<8, 1>, conv2d_int8_kernel_avx512vnni<8, 2>},
+};
+
+static inline __m512i quant_fp32_to_u8_epi32_avx512(const __m512 x, const __m512 inv_scale)
+{
+    __m512i q = _mm512_cvtps_epi32(_mm512_mul_ps(x, inv_scale));
+    q         = _mm512_max_epi32(q, _mm512_set1_epi32(-INT8_QUANT_MAX()));
+    q         = _mm512_min_epi32(q, _mm512_set1_epi32(INT8_QUANT_MAX()));
+    return _mm512_add_epi32(q, _mm512_set1_epi32(INT8_SRC_ZERO_POINT()));
+}
+
+// quantize ndarray src to uint8 ndarray
+static void conv2d_int8_quant_src_avx512(
+    const float *src,
+    const int64_t channels,
+    const int64_t src_hw,
+    const float inv_scale,
+    uint8_t *dst)
+{
+    const __m512 v_inv_scale = _mm512_set1_ps(inv_scale);
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t c = 0; c < channels; ++c) {
+        const float *l_src = src + c * src_hw;
+        uint8_t *l_dst     = dst + c * src_hw;
+        for (int64_t hw = 0; hw < src_hw; hw += HW_DT_BLK()) {
+            const __mmask16 mask = hw + HW_DT_BLK() <= src_hw ? 0xffff : ((1 << (src_hw - hw)) - 1);
+            const __m512i q      = quant_fp32_to_u8_epi32_avx512(_mm512_maskz_loadu_ps(mask, l_src + hw), v_inv_scale);
+            _mm512_mask_cvtepi32_storeu_epi8(l_dst + hw, mask, q);
+        }
+    }
+}
+
+// quantize ndarray src of all groups to [batch * group][padded_k / 4][src_hw][4], where k is channels of a group
+static void conv2d_int8_quant_src_interleave_avx512(
+    const float *src,
+    const int64_t batch_group,
+    const int64_t ic_per_gp,
+    const int64_t src_hw,
+    const float inv_scale,
+    uint8_t *dst)
+{
+    const int64_t k4_count   = div_up(ic_per_gp, 4);
+    const __m512 v_inv_scale = _mm512_set1_ps(inv_scale);
+    const __m512i v_zp       = _mm512_set1_epi32(INT8_SRC_ZERO_POINT());
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t bgk = 0; bgk < batch_group * k4_count; ++bgk) {
+        const int64_t bg    = bgk / k4_count;
+        const int64_t k4    = bgk % k4_count;
+        const int64_t c_eff = min<int64_t>(ic_per_gp - k4 * 4, 4);
+        const float *l_src  = src + (bg * ic_per_gp + k4 * 4) * src_hw;
+        uint8_t *l_dst      = dst + bgk * src_hw * 4;
+        for (int64_t hw = 0; hw < src_hw; hw += HW_DT_BLK()) {
+            const __mmask16 mask = hw + HW_DT_BLK() <= src_hw ? 0xffff : ((1 << (src_hw - hw)) - 1);
+            __m512i q            = _mm512_setzero_si512();
+            for (int64_t c = 0; c < 4; ++c) {
+                const __m512i qc = c < c_eff
+                    ? quant_fp32_to_u8_epi32_avx512(_mm512_maskz_loadu_ps(mask, l_src + c * src_hw + hw), v_inv_scale)
+                    : v_zp;
+                q = _mm512_or_si512(q, _mm512_slli_epi32(qc, c * 8));
+            }
+            _mm512_mask_storeu_epi32(l_dst + hw * 4, mask, q);
+        }
+    }
+}
+
+// im2col of hw_eff output pixels from hw_start into [padded_k / 4][hw_l2_blk][4]
+static void conv2d_int8_im2col(
+    const conv2d_int8_param &param,
+    const uint8_t *src_q,   // [ic_per_gp][src_h][src_w] of one group
+    const int64_t src_h,
+    const int64_t src_w,
+    const int64_t dst_w,
+    const int64_t hw_start,
+    const int64_t hw_eff,
+    const int64_t hw_l2_blk,
+    uint8_t *col)
+{
+    const int64_t ic_per_gp = param.channels / param.group;
+    const int64_t k_per_ic  = param.kernel_h * param.kernel_w;
+    const int64_t k_per_gp  = ic_per_gp * k_per_ic;
+    const int64_t padded_k  = round_up(k_per_gp, 4);
+    const uint8_t zp        = INT8_SRC_ZERO_POINT();
+
+    for (int64_t k = 0; k < padded_k; ++k) {
+        uint8_t *l_col = col + (k / 4) * hw_l2_blk * 4 + (k % 4);
+        if (k >= k_per_gp) {
+            for (int64_t p = 0; p < hw_eff; ++p) {
+                l_col[p * 4] = zp;
+            }
+            continue;
+        }
+        const int64_t ic   = k / k_per_ic;
+        const int64_t kh   = (k % k_per_ic) / param.kernel_w;
+        const int64_t kw   = k % param.kernel_w;
+        const uint8_t *l_src = src_q + ic * src_h * src_w;
+
+        int64_t oh = hw_start / dst_w;
+        int64_t ow = hw_start % dst_w;
+        int64_t p  = 0;
+        while (p < hw_eff) {
+            const int64_t seg = min(dst_w - ow, hw_eff - p);
+            const int64_t ih  = oh * param.stride_h - param.pad_h + kh * param.dilation_h;
+            if (ih < 0 || ih >= src_h) {
+                for (int64_t i = 0; i < seg; ++i) {
+                    l_col[(p + i) * 4] = zp;
+                }
+            } else {
+                const uint8_t *l_row = l_src + ih * src_w;
+                int64_t iw           = ow * param.stride_w - param.pad_w + kw * param.dilation_w;
+                for (int64_t i = 0; i < seg; ++i, iw += param.stride_w) {
+                    l_col[(p + i) * 4] = (iw >= 0 && iw < src_w) ? l_row[iw] : zp;
+                }
+            }
+            p += seg;
+            ow = 0;
+            ++oh;
+        }
+    }
+}
+
+// computes oc of [oc_start, oc_end) of one group for hw_eff pixels
+static void conv2d_int8_compute_block(
+    const uint8_t *src,
+    const int64_t src_k4_stride,
+    const int8_t *flt,
+    const int32_t *comp,
+    const float *scale,
+    const float *bias,
+    const int64_t padded_k,
+    const int64_t oc_start,
+    const int64_t oc_end,
+    const int64_t hw_eff,
+    const int64_t dst_oc_stride,
+    const conv_fuse_flag_t fuse_flag,
+    float *dst)
+{
+    conv2d_int8_kernel_param kp;
+    kp.src_k4_stride = src_k4_stride;
+    kp.k4_count      = padded_k / 4;
+    kp.dst_oc_stride = dst_oc_stride;
+    kp.fuse_flag     = fuse_flag;
+
+    for (int64_t oc = oc_start; oc < oc_end; oc += OC_KR_BLK()) {
+        const int64_t oc_eff = min<int64_t>(oc_end - oc, OC_KR_BLK());
+        kp.flt   = flt + oc * padded_k;
+        kp.comp  = comp + oc;
+        kp.scale = scale + oc;
+        kp.bias  = bias + oc;
+        for (int64_t hw = 0; hw < hw_eff; hw += HW_KR_BLK()) {
+            const int64_t hw_len = min<int64_t>(hw_eff - hw, HW_KR_BLK());
+            const int64_t vecs   = div_up(hw_len, HW_DT_BLK());
+            const int64_t tail   = hw_len - (vecs - 1) * HW_DT_BLK();
+            kp.tail_mask         = tail == HW_DT_BLK() ? 0xffff : ((1 << tail) - 1);
+            kp.src               = src + hw * 4;
+            kp.dst               = dst + oc * dst_oc_stride + hw;
+            conv2d_int8_kernel_table[oc_eff - 1][vecs - 1](kp);
+        }
+    }
+}
+
+static int64_t conv2d_int8_cal_hw_l2_blk(const int64_t padded_k, const int64_t dst_hw)
+{
+    int64_t hw_l2_blk = round(SRC_L2_BLK_BYTES() / padded_k, HW_KR_BLK());
+    hw_l2_blk         = max<int64_t>(hw_l2_blk, HW_KR_BLK());
+    hw_l2_blk         = min<int64_t>(hw_l2_blk, HW_L2_BLK_MAX());
+    return min<int64_t>(hw_l2_blk, round_up(dst_hw, HW_KR_BLK()));
+}
+
+uint64_t conv2d_int8_avx512vnni_get_temp_buffer_bytes(
+    const conv2d_int8_param &param,
+    const conv2d_int8_algo_t algo,
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape)
+{
+    const int64_t batch    = src_shape->GetDim(0);
+    const int64_t src_hw   = src_shape->GetDim(2) * src_shape->GetDim(3);
+    const int64_t dst_hw   = dst_shape->GetDim(2) * dst_shape->GetDim(3);
+    const int64_t padded_k = round_up(param.channels / param.group * param.kernel_h * param.kernel_w, 4);
+
+    if (algo == conv2d_int8_algo::DIRECT) {
+        return round_up(batch * param.group * padded_k * src_hw, PPL_X86_CACHELINE_BYTES());
+    }
+
+    const uint64_t src_q_bytes = round_up(batch * param.channels * src_hw, PPL_X86_CACHELINE_BYTES());
+    const uint64_t col_bytes   = round_up(padded_k * conv2d_int8_cal_hw_l2_blk(padded_k, dst_hw), PPL_X86_CACHELINE_BYTES());
+    return src_q_bytes + col_bytes * PPL_OMP_MAX_THREADS();
+}
+
+ppl::common::RetCode conv2d_int8_avx512vnni(
+    const conv2d_int8_param &param,
+    const conv2d_int8_algo_t algo,
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const int8_t *cvt_filter,
+    const int32_t *cvt_comp,
+    const float *cvt_scale,
+    const float *cvt_bias,
+    void *temp_buffer,
+    float *dst)
+{
+    const int64_t batch     = src_shape->GetDim(0);
+    const int64_t src_h     = src_shape->GetDim(2);
+    const int64_t src_w     = src_shape->GetDim(3);
+    const int64_t dst_h     = dst_shape->GetDim(2);
+    const int64_t dst_w     = dst_shape->GetDim(3);
+    const int64_t src_hw    = src_h * src_w;
+    const int64_t dst_hw    = dst_h * dst_w;
+    const int64_t ic_per_gp = param.channels / param.group;
+    const int64_t oc_per_gp = param.num_output / param.group;
+    const int64_t padded_k  = round_up(ic_per_gp * param.kernel_h * param.kernel_w, 4);
+    const int64_t padded_oc = round_up(oc_per_gp, OC_KR_BLK());
+    const float inv_scale   = 1.0f / param.src_scale;
+
+    const int64_t hw_l2_blk   = conv2d_int8_cal_hw_l2_blk(padded_k, dst_hw);
+    const int64_t num_threads = PPL_OMP_MAX_THREADS();
+    const int64_t hw_tasks    = div_up(dst_hw, hw_l2_blk);
+    const int64_t bgh_tasks   = batch * param.group * hw_tasks;
+    const int64_t oc_blks     = padded_oc / OC_KR_BLK();
+
+    // split output channels when there are too few tasks to feed all threads
+    int64_t oc_tasks = 1;
+    if (bgh_tasks < num_threads) {
+        oc_tasks = min<int64_t>(oc_blks, div_up(num_threads, bgh_tasks));
+    }
+    const int64_t oc_task_blk = div_up(oc_blks, oc_tasks) * OC_KR_BLK();
+    oc_tasks                  = div_up(padded_oc, oc_task_blk);
+
+    const int64_t flt_g_stride = padded_oc * padded_k;
+
+    if (algo == conv2d_int8_algo::DIRECT) {
+        uint8_t *src_q = reinterpret_cast<uint8_t *>(temp_buffer);
+        conv2d_int8_quant_src_interleave_avx512(src, batch * param.group, ic_per_gp, src_hw, inv_scale, src_q);
+
+        PRAGMA_OMP_PARALLEL_FOR()
+        for (int64_t task = 0; task < bgh_tasks * oc_tasks; ++task) {
+            const int64_t oc_task  = task % oc_tasks;
+            const int64_t hw_task  = task / oc_tasks % hw_tasks;
+            const int64_t bg       = task / oc_tasks / hw_tasks;
+            const int64_t g        = bg % param.group;
+            const int64_t hw_start = hw_task * hw_l2_blk;
+            const int64_t oc_start = oc_task * oc_task_blk;
+            conv2d_int8_compute_block(
+                src_q + bg * padded_k * src_hw + hw_start * 4,
+                src_hw * 4,
+                cvt_filter + g * flt_g_stride,
+                cvt_comp + g * padded_oc,
+                cvt_scale + g * padded_oc,
+                cvt_bias + g * padded_oc,
+                padded_k,
+                oc_start,
+                min(oc_start + oc_task_blk, oc_per_gp),
+                min(dst_hw - hw_start, hw_l2_blk),
+                dst_hw,
+                param.fuse_flag,
+                dst + bg * oc_per_gp * dst_hw + hw_start);
+        }
+        return ppl::common::RC_SUCCESS;
+    }
+
+    uint8_t *src_q          = reinterpret_cast<uint8_t *>(temp_buffer);
+    uint8_t *col_buf        = src_q + round_up(batch * param.channels * src_hw, PPL_X86_CACHELINE_BYTES());
+    const int64_t col_bytes = round_up(padded_k * hw_l2_blk, PPL_X86_CACHELINE_BYTES());
+    conv2d_int8_quant_src_avx512(src, batch * param.channels, src_hw, inv_scale, src_q);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t task = 0; task < bgh_tasks * oc_tasks; ++task) {
+        const int64_t oc_task  = task % oc_tasks;
+        const int64_t hw_task  = task / oc_tasks % hw_tasks;
+        const int64_t bg       = task / oc_tasks / hw_tasks;
+        const int64_t g        = bg % param.group;
+        const int64_t hw_start = hw_task * hw_l2_blk;
+        const int64_t hw_eff   = min(dst_hw - hw_start, hw_l2_blk);
+        const int64_t oc_start = oc_task * oc_task_blk;
+        uint8_t *col           = col_buf + PPL_OMP_THREAD_ID() * col_bytes;
+
+        conv2d_int8_im2col(param, src_q + bg * ic_per_gp * src_hw, src_h, src_w, dst_w, hw_start, hw_eff, hw_l2_blk, col);
+        conv2d_int8_compute_block(
+            col,
+            hw_l2_blk * 4,
+            cvt_filter + g * flt_g_stride,
+            cvt_comp + g * padded_oc,
+            cvt_scale + g * padded_oc,
+            cvt_bias + g * padded_oc,
+            padded_k,
+            oc_start,
+            min(oc_start + oc_task_blk, oc_per_gp),
+            hw_eff,
+            dst_hw,
+            param.fuse_flag,
+            dst + bg * oc_per_gp * dst_hw + hw_start);
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
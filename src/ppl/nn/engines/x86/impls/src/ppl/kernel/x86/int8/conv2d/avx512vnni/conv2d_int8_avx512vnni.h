@@ -0,0 +1,50 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_INT8_CONV2D_AVX512VNNI_CONV2D_INT8_AVX512VNNI_H_
+#define __ST_PPL_KERNEL_X86_INT8_CONV2D_AVX512VNNI_CONV2D_INT8_AVX512VNNI_H_
+
+#include "ppl/kernel/x86/int8/conv2d.h"
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// output channels computed by one kernel invocation, also the oc_blk of the converted filter
+#define CONV2D_INT8_AVX512VNNI_OC_BLK() 8
+
+uint64_t conv2d_int8_avx512vnni_get_temp_buffer_bytes(
+    const conv2d_int8_param &param,
+    const conv2d_int8_algo_t algo,
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape);
+
+ppl::common::RetCode conv2d_int8_avx512vnni(
+    const conv2d_int8_param &param,
+    const conv2d_int8_algo_t algo,
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const int8_t *cvt_filter,
+    const int32_t *cvt_comp,
+    const float *cvt_scale,
+    const float *cvt_bias,
+    void *temp_buffer,
+    float *dst);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,198 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/int8/fc/avx512vnni/fc_int8_avx512vnni.h"
+#include "ppl/kernel/x86/int8/common/quant_tools_int8.h"
+
+#define OC_DT_BLK() FC_INT8_AVX512VNNI_OC_BLK()
+#define OC_KR_BLK() (4 * OC_DT_BLK())
+#define B_KR_BLK()  6
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct fc_int8_kernel_param {
+    const uint8_t *src;        // [B_KR_BLK()][padded_k]
+    const int8_t *flt;         // [OC_KR_BLK() / OC_DT_BLK()][padded_k / 4][OC_DT_BLK()][4]
+    const int32_t *comp;
+    const float *scale;
+    const float *bias;
+    float *dst;
+    int64_t padded_k;
+    int64_t dst_b_stride;
+    __mmask16 tail_mask;       // mask of the last oc vector
+    fc_fuse_flag_t fuse_flag;
+};
+
+typedef void (*fc_int8_kernel_func_t)(const fc_int8_kernel_param &);
+
+// dst[b_len][oc] = sum(src[b_len][k] * flt[k][oc]), src is broadcast along oc
+template <int64_t b_len, int64_t oc_len>
+void fc_int8_kernel_avx512vnni(const fc_int8_kernel_param &kp)
+{
+#define DECL_ACC(B) __m512i acc##B##0 = _mm512_setzero_si512(), acc##B##1 = _mm512_setzero_si512(), \
+                            acc##B##2 = _mm512_setzero_si512(), acc##B##3 = _mm512_setzero_si512()
+#define DPBUSD(B)                                                                  \
+    do {                                                                           \
+        if (b_len > B) {                                                           \
+            const __m512i s = _mm512_set1_epi32(*(const int32_t *)(l_src + B * kp.padded_k)); \
+            if (oc_len > 0) acc##B##0 = _mm512_dpbusd_epi32(acc##B##0, s, w0);     \
+            if (oc_len > 1) acc##B##1 = _mm512_dpbusd_epi32(acc##B##1, s, w1);     \
+            if (oc_len > 2) acc##B##2 = _mm512_dpbusd_epi32(acc##B##2, s, w2);     \
+            if (oc_len > 3) acc##B##3 = _mm512_dpbusd_epi32(acc##B##3, s, w3);     \
+        }                                                                          \
+    } while (0)
+#define STORE_VEC(B, O)                                                                      \
+    do {                                                                                     \
+        if (oc_len > O) {                                                                    \
+            __m512 v = _mm512_cvtepi32_ps(_mm512_sub_epi32(acc##B##O, comp##O));             \
+            v        = _mm512_fmadd_ps(v, scale##O, bias##O);                                \
+            if (kp.fuse_flag & fc_fuse_flag::RELU) v = _mm512_max_ps(v, _mm512_setzero_ps()); \
+            float *l_dst = kp.dst + B * kp.dst_b_stride + O * OC_DT_BLK();                   \
+            if (oc_len == O + 1) _mm512_mask_storeu_ps(l_dst, kp.tail_mask, v);              \
+            else _mm512_storeu_ps(l_dst, v);                                                 \
+        }                                                                                    \
+    } while (0)
+#define STORE_ACC(B)          \
+    do {                      \
+        if (b_len > B) {      \
+            STORE_VEC(B, 0);  \
+            STORE_VEC(B, 1);  \
+            STORE_VEC(B, 2);  \
+            STORE_VEC(B, 3);  \
+        }                     \
+    } while (0)
+
+    DECL_ACC(0); DECL_ACC(1); DECL_ACC(2);
+    DECL_ACC(3); DECL_ACC(4); DECL_ACC(5);
+
+    const int64_t flt_oc_stride = kp.padded_k * OC_DT_BLK();
+    const uint8_t *l_src        = kp.src;
+    const int8_t *l_flt         = kp.flt;
+    for (int64_t k = 0; k < kp.padded_k; k += 4) {
+        __m512i w0, w1, w2, w3;
+        if (oc_len > 0) w0 = _mm512_loadu_si512(l_flt + 0 * flt_oc_stride);
+        if (oc_len > 1) w1 = _mm512_loadu_si512(l_flt + 1 * flt_oc_stride);
+        if (oc_len > 2) w2 = _mm512_loadu_si512(l_flt + 2 * flt_oc_stride);
+        if (oc_len > 3) w3 = _mm512_loadu_si512(l_flt + 3 * flt_oc_stride);
+        DPBUSD(0); DPBUSD(1); DPBUSD(2);
+        DPBUSD(3); DPBUSD(4); DPBUSD(5);
+        l_src += 4;
+        l_flt += OC_DT_BLK() * 4;
+    }
+
+    __m512i comp0, comp1, comp2, comp3;
+    __m512 scale0, scale1, scale2, scale3;
+    __m512 bias0, bias1, bias2, bias3;
+#define LOAD_VEC(O)                                                   \
+    do {                                                              \
+        if (oc_len > O) {                                             \
+            comp##O  = _mm512_loadu_si512(kp.comp + O * OC_DT_BLK()); \
+            scale##O = _mm512_loadu_ps(kp.scale + O * OC_DT_BLK());   \
+            bias##O  = _mm512_loadu_ps(kp.bias + O * OC_DT_BLK());    \
+        }                                                             \
+    } while (0)
+    LOAD_VEC(0); LOAD_VEC(1); LOAD_VEC(2); LOAD_VEC(3);
+
+    STORE_ACC(0); STORE_ACC(1); STORE_ACC(2);
+    STORE_ACC(3); STORE_ACC(4); STORE_ACC(5);
+
+#undef DECL_ACC
+#undef DPBUSD
+#undef STORE_VEC
+#undef STORE_ACC
+#undef LOAD_VEC
+}
+
+static const fc_int8_kernel_func_t fc_int8_kernel_table[B_KR_BLK()][OC_KR_BLK() / OC_DT_BLK()] = {
+    {fc_int8_kernel_avx512vnni<1, 1>, fc_int8_kernel_avx512vnni<1, 2>, fc_int8_kernel_avx512vnni<1, 3>, fc_int8_kernel_avx512vnni<1, 4>},
+    {fc_int8_kernel_avx512vnni<2, 1>, fc_int8_kernel_avx512vnni<2, 2>, fc_int8_kernel_avx512vnni<2, 3>, fc_int8_kernel_avx512vnni<2, 4>},
+    {fc_int8_kernel_avx512vnni<3, 1>, fc_int8_kernel_avx512vnni<3, 2>, fc_int8_kernel_avx512vnni<3, 3>, fc_int8_kernel_avx512vnni<3, 4>},
+    {fc_int8_kernel_avx512vnni<4, 1>, fc_int8_kernel_avx512vnni<4, 2>, fc_int8_kernel_avx512vnni<4, 3>, fc_int8_kernel_avx512vnni<4, 4>},
+    {fc_int8_kernel_avx512vnni<5, 1>, fc_int8_kernel_avx512vnni<5, 2>, fc_int8_kernel_avx512vnni<5, 3>, fc_int8_kernel_avx512vnni<5, 4>},
+    {fc_int8_kernel_avx512vnni<6, 1>, fc_int8_kernel_avx512vnni<6, 2>, fc_int8_kernel_avx512vnni<6, 3>, fc_int8_kernel_avx512vnni<6, 4>},
+};
+
+uint64_t fc_int8_avx512vnni_get_temp_buffer_bytes(
+    const fc_int8_param &param,
+    const int64_t batch)
+{
+    return round_up(batch * round_up(param.channels, 4), PPL_X86_CACHELINE_BYTES());
+}
+
+ppl::common::RetCode fc_int8_avx512vnni(
+    const fc_int8_param &param,
+    const int64_t batch,
+    const float *src,
+    const int8_t *cvt_filter,
+    const int32_t *cvt_comp,
+    const float *cvt_scale,
+    const float *cvt_bias,
+    void *temp_buffer,
+    float *dst)
+{
+    const int64_t padded_k = round_up(param.channels, 4);
+    uint8_t *src_q         = reinterpret_cast<uint8_t *>(temp_buffer);
+
+    const __m512 v_inv_scale = _mm512_set1_ps(1.0f / param.src_scale);
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t b = 0; b < batch; ++b) {
+        const float *l_src = src + b * param.channels;
+        uint8_t *l_dst     = src_q + b * padded_k;
+        for (int64_t ic = 0; ic < padded_k; ic += 16) {
+            const int64_t ic_eff = min<int64_t>(param.channels - ic, 16);
+            const __mmask16 mask = ic_eff >= 16 ? 0xffff : ((1 << ic_eff) - 1);
+            __m512i q            = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_maskz_loadu_ps(mask, l_src + ic), v_inv_scale));
+            q = _mm512_max_epi32(q, _mm512_set1_epi32(-INT8_QUANT_MAX()));
+            q = _mm512_min_epi32(q, _mm512_set1_epi32(INT8_QUANT_MAX()));
+            q = _mm512_add_epi32(q, _mm512_set1_epi32(INT8_SRC_ZERO_POINT()));
+            const __mmask16 store_mask = padded_k - ic >= 16 ? 0xffff : ((1 << (padded_k - ic)) - 1);
+            _mm512_mask_cvtepi32_storeu_epi8(l_dst + ic, store_mask, q);
+        }
+    }
+
+    const int64_t b_tasks  = div_up(batch, B_KR_BLK());
+    const int64_t oc_tasks = div_up(param.num_output, OC_KR_BLK());
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t task = 0; task < b_tasks * oc_tasks; ++task) {
+        const int64_t oc     = task % oc_tasks * OC_KR_BLK();
+        const int64_t b      = task / oc_tasks * B_KR_BLK();
+        const int64_t b_eff  = min<int64_t>(batch - b, B_KR_BLK());
+        const int64_t oc_eff = min<int64_t>(param.num_output - oc, OC_KR_BLK());
+        const int64_t vecs   = div_up(oc_eff, OC_DT_BLK());
+        const int64_t tail   = oc_eff - (vecs - 1) * OC_DT_BLK();
+
+        fc_int8_kernel_param kp;
+        kp.src          = src_q + b * padded_k;
+        kp.flt          = cvt_filter + oc * padded_k;
+        kp.comp         = cvt_comp + oc;
+        kp.scale        = cvt_scale + oc;
+        kp.bias         = cvt_bias + oc;
+        kp.dst          = dst + b * param.num_output + oc;
+        kp.padded_k     = padded_k;
+        kp.dst_b_stride = param.num_output;
+        kp.tail_mask    = tail == OC_DT_BLK() ? 0xffff : ((1 << tail) - 1);
+        kp.fuse_flag    = param.fuse_flag;
+        fc_int8_kernel_table[b_eff - 1][vecs - 1](kp);
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,197 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <new>
+#include <string.h>
+
+#include "ppl/kernel/x86/int8/fc.h"
+#include "ppl/kernel/x86/int8/common/quant_tools_int8.h"
+#include "ppl/kernel/x86/common/simd_tools.h"
+
+#ifdef PPL_USE_X86_AVX512VNNI
+#include "ppl/kernel/x86/int8/fc/avx512vnni/fc_int8_avx512vnni.h"
+#endif
+
+namespace ppl { namespace kernel { namespace x86 {
+
+fc_int8_algo_info fc_int8_algo_selector::select_algo(const ppl::common::dataformat_t src_format, const fc_int8_param &param, const ppl::common::isa_t isa_flags)
+{
+    static fc_int8_algo_info unknown_info = {
+        fc_int8_algo::UNKNOWN,
+        ppl::common::ISA_UNKNOWN};
+
+#ifdef PPL_USE_X86_AVX512VNNI
+    if ((isa_flags & ppl::common::ISA_X86_AVX512) && cpu_supports_avx512vnni()) {
+        fc_int8_algo_info info = {
+            fc_int8_algo::STANDARD,
+            ppl::common::ISA_X86_AVX512};
+        fc_int8_manager mgr(param, info, nullptr);
+        if (mgr.is_supported()) {
+            return info;
+        }
+    }
+#endif
+
+    return unknown_info;
+}
+
+fc_int8_manager *fc_int8_algo_selector::gen_algo(const fc_int8_param &param, const fc_int8_algo_info &algo_info, ppl::common::Allocator *allocator)
+{
+    if (algo_info.algo_type == fc_int8_algo::UNKNOWN) {
+        return nullptr;
+    }
+    return new (std::nothrow) fc_int8_manager(param, algo_info, allocator);
+}
+
+static int64_t fc_int8_get_oc_blk(const fc_int8_algo_info &algo_info)
+{
+#ifdef PPL_USE_X86_AVX512VNNI
+    if (algo_info.isa & ppl::common::ISA_X86_AVX512) {
+        return FC_INT8_AVX512VNNI_OC_BLK();
+    }
+#endif
+    return 1;
+}
+
+bool fc_int8_manager::is_supported()
+{
+    if (param_.src_scale <= 0.0f) {
+        return false;
+    }
+    // keeps the int32 accumulator from overflowing: 255 * 127 * 65536 < 2^31
+    return param_.channels <= 65536;
+}
+
+ppl::common::RetCode fc_int8_manager::alloc_cvt_weights()
+{
+    if (cvt_weights_ != nullptr) {
+        return ppl::common::RC_PERMISSION_DENIED;
+    }
+
+    const int64_t oc_blk    = fc_int8_get_oc_blk(algo_info_);
+    const int64_t padded_oc = round_up(param_.num_output, oc_blk);
+    const int64_t padded_k  = round_up(param_.channels, 4);
+
+    const uint64_t filter_bytes = round_up(padded_oc * padded_k * sizeof(int8_t), PPL_X86_CACHELINE_BYTES());
+    const uint64_t vector_bytes = round_up(padded_oc * sizeof(float), PPL_X86_CACHELINE_BYTES());
+    cvt_weights_ = allocator_->Alloc(filter_bytes + 3 * vector_bytes);
+    if (!cvt_weights_) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+    cvt_weights_bytes_ = filter_bytes + 3 * vector_bytes;
+    cvt_filter_        = reinterpret_cast<int8_t *>(cvt_weights_);
+    cvt_comp_          = reinterpret_cast<int32_t *>(reinterpret_cast<uint8_t *>(cvt_weights_) + filter_bytes);
+    cvt_scale_         = reinterpret_cast<float *>(reinterpret_cast<uint8_t *>(cvt_comp_) + vector_bytes);
+    cvt_bias_          = reinterpret_cast<float *>(reinterpret_cast<uint8_t *>(cvt_scale_) + vector_bytes);
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode fc_int8_manager::set_cvt_weights(const void *cvt_weights, const uint64_t cvt_weights_bytes)
+{
+    ppl::common::RetCode rc = alloc_cvt_weights();
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+    if (cvt_weights_bytes != cvt_weights_bytes_) {
+        release_cvt_weights();
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    memcpy(cvt_weights_, cvt_weights, cvt_weights_bytes);
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode fc_int8_manager::gen_cvt_weights(const float *filter, const float *bias)
+{
+    ppl::common::RetCode rc = alloc_cvt_weights();
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+
+    const int64_t oc_blk    = fc_int8_get_oc_blk(algo_info_);
+    const int64_t padded_oc = round_up(param_.num_output, oc_blk);
+
+    quant_and_pack_filter_int8(
+        filter,
+        param_.num_output,
+        param_.channels,
+        oc_blk,
+        param_.src_scale,
+        cvt_filter_,
+        cvt_comp_,
+        cvt_scale_);
+    memset(cvt_bias_, 0, padded_oc * sizeof(float));
+    if (bias) {
+        memcpy(cvt_bias_, bias, param_.num_output * sizeof(float));
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+fc_int8_executor *fc_int8_manager::gen_executor()
+{
+    return new (std::nothrow) fc_int8_executor(this);
+}
+
+const fc_int8_param *fc_int8_executor::fc_param() const
+{
+    return &mgr_->param();
+}
+
+uint64_t fc_int8_executor::cal_temp_buffer_size()
+{
+#ifdef PPL_USE_X86_AVX512VNNI
+    if (mgr_->algo_info().isa & ppl::common::ISA_X86_AVX512) {
+        return max<uint64_t>(fc_int8_avx512vnni_get_temp_buffer_bytes(mgr_->param(), src_shape_->GetDim(0)), 64u);
+    }
+#endif
+    return 64u;
+}
+
+ppl::common::RetCode fc_int8_executor::prepare()
+{
+    if (!mgr_ || !src_shape_ || !dst_shape_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode fc_int8_executor::execute()
+{
+    if (!mgr_ || !mgr_->cvt_filter() || !src_ || !dst_ || !temp_buffer_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+#ifdef PPL_USE_X86_AVX512VNNI
+    if (mgr_->algo_info().isa & ppl::common::ISA_X86_AVX512) {
+        return fc_int8_avx512vnni(
+            mgr_->param(),
+            src_shape_->GetDim(0),
+            src_,
+            mgr_->cvt_filter(),
+            mgr_->cvt_comp(),
+            mgr_->cvt_scale(),
+            mgr_->cvt_bias(),
+            temp_buffer_,
+            dst_);
+    }
+#endif
+
+    return ppl::common::RC_UNSUPPORTED;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,1871 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <chrono>
+#include <memory>
+#include <map>
+#include <vector>
+#include <string>
+#include <functional>
+#include <inttypes.h>
+
+#if defined(__linux__) && defined(PPL_USE_X86_OMP)
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <pthread.h>
+#include <omp.h>
+#endif
+
+#include "ppl/kernel/x86/fp32/arithmetic.h"
+#include "ppl/kernel/x86/fp32/attention.h"
+#include "ppl/kernel/x86/fp32/averagepool2d.h"
+#include "ppl/kernel/x86/fp32/batchnorm.h"
+#include "ppl/kernel/x86/fp32/clip.h"
+#include "ppl/kernel/x86/fp32/concat.h"
+#include "ppl/kernel/x86/fp32/eltwise_chain.h"
+#include "ppl/kernel/x86/fp32/erf.h"
+#include "ppl/kernel/x86/fp32/exp.h"
+#include "ppl/kernel/x86/fp32/gemm_v2.h"
+#include "ppl/kernel/x86/fp32/gru.h"
+#include "ppl/kernel/x86/fp32/layer_norm.h"
+#include "ppl/kernel/x86/fp32/leaky_relu.h"
+#include "ppl/kernel/x86/fp32/lstm.h"
+#include "ppl/kernel/x86/fp32/matmul.h"
+#include "ppl/kernel/x86/fp32/maxpool2d.h"
+#include "ppl/kernel/x86/fp32/mmcv_nms.h"
+#include "ppl/kernel/x86/fp32/nms.h"
+#include "ppl/kernel/x86/fp32/reduce.h"
+#include "ppl/kernel/x86/fp32/relu.h"
+#include "ppl/kernel/x86/fp32/reorder.h"
+#include "ppl/kernel/x86/fp32/resize2d.h"
+#include "ppl/kernel/x86/fp32/rnn.h"
+#include "ppl/kernel/x86/fp32/sigmiod.h"
+#include "ppl/kernel/x86/fp32/softmax.h"
+#include "ppl/kernel/x86/fp32/split.h"
+#include "ppl/kernel/x86/fp32/sqrt.h"
+#include "ppl/kernel/x86/fp32/swish.h"
+#include "ppl/kernel/x86/fp32/tanh.h"
+#include "ppl/kernel/x86/fp32/topk.h"
+#include "ppl/kernel/x86/fp32/transpose.h"
+#include "ppl/kernel/x86/common/cast.h"
+#include "ppl/kernel/x86/common/memory.h"
+#include "ppl/common/generic_cpu_allocator.h"
+#include "ppl/kernel/x86/common/simd_tools.h"
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/nn/common/tensor_shape.h"
+#include "simple_flags.h"
+
+/*
+ * Micro-benchmarks of kernel families in the x86 kernel library.
+ *
+ * Each line of the config file is a sweep of space separated key=value pairs, values separated by ',' are
+ * expanded to the cartesian product of cases. dims are separated by 'x' and lists(axes, perm) by ':'. e.g.
+ *
+ *     kernel=relu,sigmoid dims=1x64x56x56,1x256x14x14
+ *     kernel=maxpool2d dims=1x64x112x112 kernel_size=3 stride=2 pad=1 format=ndarray,n16cx
+ *     kernel=transpose dims=1x64x56x56 perm=0:2:3:1
+ *     kernel=nms boxes=20000 classes=80 max_output=100 score=0.05 density=1.0,0.01
+ *
+ * Each case is reported with GFLOP/s, GB/s and its efficiency against the roofline of this cpu, whose
+ * compute roof is measured with gemm and bandwidth roof with memory copy of the same working set size.
+ */
+
+Define_bool_opt("--help", Flag_help, false, "show these help information");
+Define_string(cfg, "", "config file, each line is a sweep of key=value pairs");
+Define_string(sweep, "", "a sweep in the same format as lines of config file, used when cfg is empty");
+Define_bool(list, false, "(false) list kernels and their arguments");
+Define_int32(warm_up, 10, "(10) warm up iterations");
+Define_int32(min_iter, 20, "(20) min benchmark iterations");
+Define_float(min_second, 1.0f, "(1.0) min benchmark seconds");
+Define_string(isa, "auto", "sse, fma, avx512, auto");
+Define_float(peak_gflops, 0.0f, "(0.0) peak GFLOP/s of roofline, measured with gemm if 0");
+Define_float(peak_gbps, 0.0f, "(0.0) peak GB/s of roofline, measured with memory copy of the same working set size if 0");
+Define_string(json, "", "write results to this file as json lines for regression tracking");
+
+// kernels may use instruction sets up to the selected one
+static std::map<std::string, ppl::common::isa_t> isa_table =
+{
+    {"sse", ppl::common::ISA_X86_SSE},
+    {"fma", ppl::common::ISA_X86_SSE | ppl::common::ISA_X86_AVX | ppl::common::ISA_X86_FMA},
+    {"avx512", ppl::common::ISA_X86_SSE | ppl::common::ISA_X86_AVX | ppl::common::ISA_X86_FMA | ppl::common::ISA_X86_AVX512},
+};
+
+/*************************** arguments ***************************/
+
+class bench_args {
+public:
+    void set(const std::string &key, const std::string &value) {
+        for (auto &kv : kvs_) {
+            if (kv.first == key) {
+                kv.second = value;
+                return;
+            }
+        }
+        kvs_.push_back(std::make_pair(key, value));
+    }
+
+    bool has(const std::string &key) const {
+        return find(key) != nullptr;
+    }
+
+    std::string get_str(const std::string &key, const std::string &def) const {
+        auto value = find(key);
+        return value ? *value : def;
+    }
+
+    int64_t get_int(const std::string &key, const int64_t def) const {
+        auto value = find(key);
+        return value ? atoll(value->c_str()) : def;
+    }
+
+    float get_float(const std::string &key, const float def) const {
+        auto value = find(key);
+        return value ? (float)atof(value->c_str()) : def;
+    }
+
+    std::vector<int64_t> get_list(const std::string &key, const std::string &def, const char sep) const {
+        std::vector<int64_t> list;
+        std::stringstream ss(get_str(key, def));
+        std::string item;
+        while (std::getline(ss, item, sep)) {
+            list.push_back(atoll(item.c_str()));
+        }
+        return list;
+    }
+
+    std::vector<int64_t> get_dims(const std::string &key, const std::string &def) const {
+        return get_list(key, def, 'x');
+    }
+
+    std::string to_string() const {
+        std::string str;
+        for (auto &kv : kvs_) {
+            str += (str.empty() ? "" : " ") + kv.first + "=" + kv.second;
+        }
+        return str;
+    }
+
+private:
+    const std::string *find(const std::string &key) const {
+        for (auto &kv : kvs_) {
+            if (kv.first == key) {
+                return &kv.second;
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<std::pair<std::string, std::string>> kvs_;
+};
+
+static bool parse_sweep(const std::string &line, std::vector<bench_args> *cases) {
+    cases->assign(1, bench_args());
+
+    std::stringstream ss(line);
+    std::string token;
+    while (ss >> token) {
+        auto pos = token.find('=');
+        if (pos == std::string::npos || pos == 0) {
+            return false;
+        }
+        const std::string key = token.substr(0, pos);
+
+        std::vector<std::string> values;
+        std::stringstream vs(token.substr(pos + 1));
+        std::string value;
+        while (std::getline(vs, value, ',')) {
+            values.push_back(value);
+        }
+        if (values.empty()) {
+            return false;
+        }
+
+        std::vector<bench_args> expanded;
+        for (auto &c : *cases) {
+            for (auto &v : values) {
+                expanded.push_back(c);
+                expanded.back().set(key, v);
+            }
+        }
+        cases->swap(expanded);
+    }
+
+    return (*cases)[0].has("kernel");
+}
+
+/*************************** resources ***************************/
+
+class bench_memory {
+public:
+    bench_memory() : allocator_(PPL_X86_CACHELINE_BYTES()) {}
+    ~bench_memory() {
+        for (auto ptr : buffers_) {
+            allocator_.Free(ptr);
+        }
+    }
+
+    void *alloc(const uint64_t bytes) {
+        void *ptr = allocator_.Alloc(bytes > 0 ? bytes : 1);
+        if (ptr) {
+            memset(ptr, 0, bytes);
+            buffers_.push_back(ptr);
+        }
+        return ptr;
+    }
+
+    float *alloc_random(const uint64_t num_elements, const float lo = -1.0f, const float hi = 1.0f) {
+        float *ptr = (float*)alloc(num_elements * sizeof(float));
+        if (ptr) {
+            for (uint64_t i = 0; i < num_elements; ++i) {
+                ptr[i] = lo + (hi - lo) * rand() / RAND_MAX;
+            }
+        }
+        return ptr;
+    }
+
+    ppl::nn::TensorShape *new_shape(
+        const std::vector<int64_t> &dims,
+        const ppl::common::dataformat_t format = ppl::common::DATAFORMAT_NDARRAY,
+        const ppl::common::datatype_t type = ppl::common::DATATYPE_FLOAT32)
+    {
+        shapes_.emplace_back(new ppl::nn::TensorShape());
+        auto shape = shapes_.back().get();
+        shape->SetDataType(type);
+        shape->SetDataFormat(format);
+        shape->Reshape(dims);
+        return shape;
+    }
+
+private:
+    ppl::common::GenericCpuAllocator allocator_;
+    std::vector<void*> buffers_;
+    std::vector<std::unique_ptr<ppl::nn::TensorShape>> shapes_;
+};
+
+struct bench_case {
+    std::function<ppl::common::RetCode()> execute;
+    double gops = 0.; // giga floating point operations of one execution, transcendental functions are not counted
+    double gbs = 0.;  // gigabytes read and written by one execution
+    std::string impl; // implementation selected by isa
+};
+
+typedef ppl::common::RetCode (*bench_creator_t)(
+    const bench_args &args,
+    const ppl::common::isa_t isa,
+    bench_memory *mem,
+    bench_case *bc);
+
+#define BENCH_CHECK_ALLOC(PTR) do { \
+    if (!(PTR)) { \
+        std::cerr << "," << #PTR << " out of memory"; \
+        return ppl::common::RC_OUT_OF_MEMORY; \
+    } \
+} while (0)
+
+template <typename T>
+struct bench_variant {
+    ppl::common::isa_t isa;
+    const char *name;
+    T func;
+};
+
+// variants are ordered from the most preferred one
+template <typename T>
+static T select_variant(const std::vector<bench_variant<T>> &variants, const ppl::common::isa_t isa, std::string *impl) {
+    for (auto &v : variants) {
+        if (v.func && (v.isa & isa) == v.isa) {
+            *impl = v.name;
+            return v.func;
+        }
+    }
+    return nullptr;
+}
+
+#define ISA_REF ppl::common::ISA_UNKNOWN
+#define ISA_SSE ppl::common::ISA_X86_SSE
+#define ISA_AVX ppl::common::ISA_X86_AVX
+#define ISA_FMA ppl::common::ISA_X86_FMA
+#define ISA_AVX512 ppl::common::ISA_X86_AVX512
+
+static double bytes_of(const ppl::nn::TensorShape *shape) {
+    return (double)shape->GetBytesExcludingPadding();
+}
+
+static int64_t normalize_axis(const int64_t axis, const uint32_t dim_count) {
+    return axis < 0 ? axis + dim_count : axis;
+}
+
+/*************************** kernels ***************************/
+
+typedef ppl::common::RetCode (*unary_func_t)(const ppl::nn::TensorShape*, const float*, float*);
+
+static ppl::common::RetCode create_unary(
+    const std::vector<bench_variant<unary_func_t>> &variants,
+    const double ops_per_element,
+    const bench_args &args,
+    const ppl::common::isa_t isa,
+    bench_memory *mem,
+    bench_case *bc)
+{
+    auto func = select_variant(variants, isa, &bc->impl);
+    if (!func) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    auto shape = mem->new_shape(args.get_dims("dims", "1x64x56x56"));
+    auto src = mem->alloc_random(shape->GetElementsIncludingPadding(), 0.0f, 1.0f);
+    auto dst = (float*)mem->alloc(shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+
+    bc->execute = [=]() { return func(shape, src, dst); };
+    bc->gops = ops_per_element * shape->GetElementsExcludingPadding() / 1e9;
+    bc->gbs = 2 * bytes_of(shape) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_relu(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_unary({
+        {ISA_AVX, "avx", ppl::kernel::x86::relu_fp32_avx},
+        {ISA_SSE, "sse", ppl::kernel::x86::relu_fp32_sse},
+    }, 1, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_sigmoid(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_unary({
+        {ISA_FMA, "fma", ppl::kernel::x86::sigmoid_fp32_fma},
+        {ISA_SSE, "sse", ppl::kernel::x86::sigmoid_fp32_sse},
+        {ISA_REF, "ref", ppl::kernel::x86::sigmoid_fp32},
+    }, 0, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_tanh(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_unary({
+        {ISA_FMA, "fma", ppl::kernel::x86::tanh_fp32_fma},
+        {ISA_SSE, "sse", ppl::kernel::x86::tanh_fp32_sse},
+        {ISA_REF, "ref", ppl::kernel::x86::tanh_fp32},
+    }, 0, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_exp(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_unary({
+        {ISA_FMA, "fma", ppl::kernel::x86::exp_fp32_fma},
+        {ISA_SSE, "sse", ppl::kernel::x86::exp_fp32_sse},
+        {ISA_REF, "ref", ppl::kernel::x86::exp_fp32},
+    }, 0, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_erf(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_unary({
+#ifdef PPL_USE_X86_AVX512
+        {ISA_AVX512, "avx512", ppl::kernel::x86::erf_fp32_avx512},
+#endif
+        {ISA_FMA, "fma", ppl::kernel::x86::erf_fp32_fma},
+        {ISA_SSE, "sse", ppl::kernel::x86::erf_fp32_sse},
+        {ISA_REF, "ref", ppl::kernel::x86::erf_fp32},
+    }, 0, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_sqrt(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_unary({
+        {ISA_SSE, "sse", ppl::kernel::x86::sqrt_fp32_sse},
+    }, 1, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_clip(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(const ppl::nn::TensorShape*, const float*, const float, const float, float*);
+    auto func = select_variant<func_t>({
+        {ISA_AVX, "avx", ppl::kernel::x86::clip_fp32_avx},
+        {ISA_SSE, "sse", ppl::kernel::x86::clip_fp32_sse},
+    }, isa, &bc->impl);
+    if (!func) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    auto shape = mem->new_shape(args.get_dims("dims", "1x64x56x56"));
+    auto src = mem->alloc_random(shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+    const float clip_min = args.get_float("min", 0.0f);
+    const float clip_max = args.get_float("max", 6.0f);
+
+    bc->execute = [=]() { return func(shape, src, clip_min, clip_max, dst); };
+    bc->gops = 2.0 * shape->GetElementsExcludingPadding() / 1e9;
+    bc->gbs = 2 * bytes_of(shape) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_leaky_relu(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(const ppl::nn::TensorShape*, const float*, const float, float*);
+    auto func = select_variant<func_t>({
+        {ISA_AVX, "avx", ppl::kernel::x86::leaky_relu_fp32_avx},
+        {ISA_SSE, "sse", ppl::kernel::x86::leaky_relu_fp32_sse},
+    }, isa, &bc->impl);
+    if (!func) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    auto shape = mem->new_shape(args.get_dims("dims", "1x64x56x56"));
+    auto src = mem->alloc_random(shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+    const float alpha = args.get_float("alpha", 0.01f);
+
+    bc->execute = [=]() { return func(shape, src, alpha, dst); };
+    bc->gops = 2.0 * shape->GetElementsExcludingPadding() / 1e9;
+    bc->gbs = 2 * bytes_of(shape) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+typedef ppl::common::RetCode (*binary_func_t)(
+    const ppl::nn::TensorShape*, const ppl::nn::TensorShape*, const ppl::nn::TensorShape*,
+    const float*, const float*, const bool, float*);
+
+static ppl::common::RetCode create_binary(
+    const std::vector<bench_variant<binary_func_t>> &variants,
+    const bench_args &args,
+    const ppl::common::isa_t isa,
+    bench_memory *mem,
+    bench_case *bc)
+{
+    auto func = select_variant(variants, isa, &bc->impl);
+    if (!func) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    const auto format = args.get_str("format", "ndarray") == "n16cx" ? ppl::common::DATAFORMAT_N16CX : ppl::common::DATAFORMAT_NDARRAY;
+    auto dims0 = args.get_dims("dims", "1x64x56x56");
+    auto dims1 = args.get_dims("dims1", args.get_str("dims", "1x64x56x56"));
+
+    // numpy style broadcasting
+    const uint32_t dim_count = std::max(dims0.size(), dims1.size());
+    std::vector<int64_t> dst_dims(dim_count);
+    for (uint32_t i = 0; i < dim_count; ++i) {
+        const int64_t d0 = i + dims0.size() >= dim_count ? dims0[i + dims0.size() - dim_count] : 1;
+        const int64_t d1 = i + dims1.size() >= dim_count ? dims1[i + dims1.size() - dim_count] : 1;
+        if (d0 != d1 && d0 != 1 && d1 != 1) {
+            std::cerr << ",dims and dims1 cannot be broadcasted";
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        dst_dims[i] = std::max(d0, d1);
+    }
+
+    auto src0_shape = mem->new_shape(dims0, format);
+    auto src1_shape = mem->new_shape(dims1, format);
+    auto dst_shape = mem->new_shape(dst_dims, format);
+    auto src0 = mem->alloc_random(src0_shape->GetElementsIncludingPadding(), 0.5f, 1.0f);
+    auto src1 = mem->alloc_random(src1_shape->GetElementsIncludingPadding(), 0.5f, 1.0f);
+    auto dst = (float*)mem->alloc(dst_shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src0);
+    BENCH_CHECK_ALLOC(src1);
+    BENCH_CHECK_ALLOC(dst);
+
+    bc->execute = [=]() { return func(src0_shape, src1_shape, dst_shape, src0, src1, false, dst); };
+    bc->gops = (double)dst_shape->GetElementsExcludingPadding() / 1e9;
+    bc->gbs = (bytes_of(src0_shape) + bytes_of(src1_shape) + bytes_of(dst_shape)) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_add(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_binary({
+        {ISA_AVX, "avx", ppl::kernel::x86::add_fp32_avx},
+        {ISA_SSE, "sse", ppl::kernel::x86::add_fp32_sse},
+    }, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_sub(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_binary({
+        {ISA_AVX, "avx", ppl::kernel::x86::sub_fp32_avx},
+        {ISA_SSE, "sse", ppl::kernel::x86::sub_fp32_sse},
+    }, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_mul(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_binary({
+        {ISA_AVX, "avx", ppl::kernel::x86::mul_fp32_avx},
+        {ISA_SSE, "sse", ppl::kernel::x86::mul_fp32_sse},
+    }, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_div(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_binary({
+        {ISA_AVX, "avx", ppl::kernel::x86::div_fp32_avx},
+        {ISA_SSE, "sse", ppl::kernel::x86::div_fp32_sse},
+    }, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_softmax(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(const ppl::nn::TensorShape*, const float*, const int64_t, float*);
+    auto func = select_variant<func_t>({
+#ifdef PPL_USE_X86_AVX512
+        {ISA_AVX512, "avx512", ppl::kernel::x86::softmax_ndarray_fp32_avx512},
+#endif
+        {ISA_FMA, "fma", ppl::kernel::x86::softmax_ndarray_fp32_fma},
+        {ISA_SSE, "sse", ppl::kernel::x86::softmax_ndarray_fp32_sse},
+        {ISA_REF, "ref", ppl::kernel::x86::softmax_ndarray_fp32},
+    }, isa, &bc->impl);
+    auto shape = mem->new_shape(args.get_dims("dims", "64x1000"));
+    const int64_t axis = normalize_axis(args.get_int("axis", -1), shape->GetDimCount());
+    auto src = mem->alloc_random(shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+
+    bc->execute = [=]() { return func(shape, src, axis, dst); };
+    bc->gops = 0;
+    bc->gbs = 2 * bytes_of(shape) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+typedef ppl::common::RetCode (*reduce_func_t)(
+    const ppl::nn::TensorShape*, const ppl::nn::TensorShape*, const float*, const int32_t*, const int32_t, float*);
+
+static ppl::common::RetCode create_reduce(
+    const std::vector<bench_variant<reduce_func_t>> &variants,
+    const bench_args &args,
+    const ppl::common::isa_t isa,
+    bench_memory *mem,
+    bench_case *bc)
+{
+    auto func = select_variant(variants, isa, &bc->impl);
+    if (!func) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    const auto format = args.get_str("format", "ndarray") == "n16cx" ? ppl::common::DATAFORMAT_N16CX : ppl::common::DATAFORMAT_NDARRAY;
+    auto src_dims = args.get_dims("dims", "1x64x56x56");
+    auto axes_list = args.get_list("axes", "-1", ':');
+
+    // reduced dims are kept
+    auto dst_dims = src_dims;
+    std::vector<int32_t> axes;
+    for (auto axis : axes_list) {
+        axes.push_back(normalize_axis(axis, src_dims.size()));
+        dst_dims[axes.back()] = 1;
+    }
+
+    auto src_shape = mem->new_shape(src_dims, format);
+    auto dst_shape = mem->new_shape(dst_dims, format);
+    auto src = mem->alloc_random(src_shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(dst_shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+
+    bc->execute = [=]() { return func(src_shape, dst_shape, src, axes.data(), axes.size(), dst); };
+    bc->gops = (double)src_shape->GetElementsExcludingPadding() / 1e9;
+    bc->gbs = (bytes_of(src_shape) + bytes_of(dst_shape)) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_reduce_sum(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_reduce({
+        {ISA_AVX, "avx", ppl::kernel::x86::reduce_sum_fp32_avx},
+        {ISA_SSE, "sse", ppl::kernel::x86::reduce_sum_fp32_sse},
+    }, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_reduce_mean(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_reduce({
+        {ISA_AVX, "avx", ppl::kernel::x86::reduce_mean_fp32_avx},
+        {ISA_SSE, "sse", ppl::kernel::x86::reduce_mean_fp32_sse},
+    }, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_reduce_max(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_reduce({
+        {ISA_AVX, "avx", ppl::kernel::x86::reduce_max_fp32_avx},
+        {ISA_SSE, "sse", ppl::kernel::x86::reduce_max_fp32_sse},
+    }, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_reduce_min(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_reduce({
+        {ISA_AVX, "avx", ppl::kernel::x86::reduce_min_fp32_avx},
+        {ISA_SSE, "sse", ppl::kernel::x86::reduce_min_fp32_sse},
+    }, args, isa, mem, bc);
+}
+
+typedef ppl::common::RetCode (*resize2d_func_t)(
+    const ppl::nn::TensorShape*, const ppl::nn::TensorShape*, const float*, const float, const float, float*);
+
+static ppl::common::RetCode create_resize2d(
+    const std::vector<bench_variant<resize2d_func_t>> &ndarray_variants,
+    const std::vector<bench_variant<resize2d_func_t>> &n16cx_variants,
+    const bench_args &args,
+    const ppl::common::isa_t isa,
+    bench_memory *mem,
+    bench_case *bc)
+{
+    const bool is_n16cx = args.get_str("format", "ndarray") == "n16cx";
+    const auto format = is_n16cx ? ppl::common::DATAFORMAT_N16CX : ppl::common::DATAFORMAT_NDARRAY;
+    auto func = select_variant(is_n16cx ? n16cx_variants : ndarray_variants, isa, &bc->impl);
+    if (!func) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    auto src_dims = args.get_dims("dims", "1x64x56x56");
+    if (src_dims.size() != 4) {
+        std::cerr << ",resize2d requires 4-d dims";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    const float scale = args.get_float("scale", 2.0f);
+    auto dst_dims = src_dims;
+    dst_dims[2] = (int64_t)(src_dims[2] * scale);
+    dst_dims[3] = (int64_t)(src_dims[3] * scale);
+
+    auto src_shape = mem->new_shape(src_dims, format);
+    auto dst_shape = mem->new_shape(dst_dims, format);
+    auto src = mem->alloc_random(src_shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(dst_shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+
+    bc->execute = [=]() { return func(src_shape, dst_shape, src, scale, scale, dst); };
+    bc->gops = 0;
+    bc->gbs = (bytes_of(src_shape) + bytes_of(dst_shape)) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_resize2d_nearest(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_resize2d({
+        {ISA_REF, "ref", ppl::kernel::x86::reisze2d_ndarray_asymmetric_nearest_floor_fp32},
+    }, {
+#ifdef PPL_USE_X86_AVX512
+        {ISA_AVX512, "avx512", ppl::kernel::x86::reisze2d_n16cx_asymmetric_nearest_floor_fp32_avx512},
+#endif
+        {ISA_AVX, "avx", ppl::kernel::x86::reisze2d_n16cx_asymmetric_nearest_floor_fp32_avx},
+    }, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_resize2d_linear(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_resize2d({
+        {ISA_REF, "ref", ppl::kernel::x86::reisze2d_ndarray_pytorch_linear_floor_fp32},
+    }, {
+#ifdef PPL_USE_X86_AVX512
+        {ISA_AVX512, "avx512", ppl::kernel::x86::resize2d_n16cx_pytorch_2linear_floor_fp32_avx512},
+#endif
+        {ISA_AVX, "avx", ppl::kernel::x86::resize2d_n16chw_pytorch_2linear_floor_fp32_avx},
+    }, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_transpose(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    auto src_dims = args.get_dims("dims", "1x64x56x56");
+    auto perm_list = args.get_list("perm", "0:2:3:1", ':');
+    if (perm_list.size() != src_dims.size()) {
+        std::cerr << ",size of perm does not match dims";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    std::vector<int32_t> perm(perm_list.begin(), perm_list.end());
+    std::vector<int64_t> dst_dims(src_dims.size());
+    for (uint32_t i = 0; i < perm.size(); ++i) {
+        dst_dims[i] = src_dims[perm[i]];
+    }
+
+    auto src_shape = mem->new_shape(src_dims);
+    auto dst_shape = mem->new_shape(dst_dims);
+    auto src = mem->alloc_random(src_shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(dst_shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+
+    bc->impl = "ref";
+    bc->execute = [=]() { return ppl::kernel::x86::transpose_ndarray_fp32(src_shape, dst_shape, src, perm.data(), dst); };
+    bc->gops = 0;
+    bc->gbs = 2 * bytes_of(src_shape) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+typedef ppl::common::RetCode (*reorder_func_t)(const ppl::nn::TensorShape*, const float*, float*);
+
+static ppl::common::RetCode create_reorder(
+    const std::vector<bench_variant<reorder_func_t>> &variants,
+    const ppl::common::dataformat_t src_format,
+    const ppl::common::dataformat_t dst_format,
+    const bench_args &args,
+    const ppl::common::isa_t isa,
+    bench_memory *mem,
+    bench_case *bc)
+{
+    auto func = select_variant(variants, isa, &bc->impl);
+    if (!func) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    auto dims = args.get_dims("dims", "1x64x56x56");
+    auto src_shape = mem->new_shape(dims, src_format);
+    auto dst_shape = mem->new_shape(dims, dst_format);
+    auto src = mem->alloc_random(src_shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(dst_shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+
+    bc->execute = [=]() { return func(src_shape, src, dst); };
+    bc->gops = 0;
+    bc->gbs = (bytes_of(src_shape) + bytes_of(dst_shape)) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_reorder_ndarray_n16cx(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_reorder({
+        {ISA_AVX, "avx", ppl::kernel::x86::reorder_ndarray_n16cx_fp32_avx},
+        {ISA_REF, "ref", ppl::kernel::x86::reorder_ndarray_n16cx_fp32},
+    }, ppl::common::DATAFORMAT_NDARRAY, ppl::common::DATAFORMAT_N16CX, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_reorder_n16cx_ndarray(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    return create_reorder({
+        {ISA_AVX, "avx", ppl::kernel::x86::reorder_n16cx_ndarray_fp32_avx},
+        {ISA_REF, "ref", ppl::kernel::x86::reorder_n16cx_ndarray_fp32},
+    }, ppl::common::DATAFORMAT_N16CX, ppl::common::DATAFORMAT_NDARRAY, args, isa, mem, bc);
+}
+
+static ppl::common::RetCode create_topk(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    auto src_dims = args.get_dims("dims", "64x1000");
+    const int32_t axis = normalize_axis(args.get_int("axis", -1), src_dims.size());
+    const int64_t k = args.get_int("k", 10);
+    const int32_t largest = args.get_int("largest", 1);
+    const int32_t sorted = args.get_int("sorted", 1);
+    auto dst_dims = src_dims;
+    dst_dims[axis] = k;
+
+    auto src_shape = mem->new_shape(src_dims);
+    auto values_shape = mem->new_shape(dst_dims);
+    auto indices_shape = mem->new_shape(dst_dims, ppl::common::DATAFORMAT_NDARRAY, ppl::common::DATATYPE_INT64);
+    auto src = mem->alloc_random(src_shape->GetElementsIncludingPadding());
+    auto values = (float*)mem->alloc(values_shape->GetBytesIncludingPadding());
+    auto indices = (int64_t*)mem->alloc(indices_shape->GetBytesIncludingPadding());
+    auto temp_buffer = mem->alloc(ppl::kernel::x86::topk_ndarray_fp32_get_buffer_bytes(src_shape, axis));
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(values);
+    BENCH_CHECK_ALLOC(indices);
+    BENCH_CHECK_ALLOC(temp_buffer);
+
+    bc->impl = "ref";
+    bc->execute = [=]() {
+        return ppl::kernel::x86::topk_ndarray_fp32(
+            src_shape, values_shape, indices_shape, src, k, axis, largest, sorted, temp_buffer, values, indices);
+    };
+    bc->gops = 0;
+    bc->gbs = (bytes_of(src_shape) + bytes_of(values_shape) + bytes_of(indices_shape)) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+// random boxes of [y1, x1, y2, x2] in a 1000x1000 image
+static void fill_nms_boxes(const int64_t num_boxes, float *boxes) {
+    for (int64_t i = 0; i < num_boxes; ++i) {
+        const float y = 900.0f * rand() / RAND_MAX;
+        const float x = 900.0f * rand() / RAND_MAX;
+        boxes[i * 4 + 0] = y;
+        boxes[i * 4 + 1] = x;
+        boxes[i * 4 + 2] = y + 10.0f + 90.0f * rand() / RAND_MAX;
+        boxes[i * 4 + 3] = x + 10.0f + 90.0f * rand() / RAND_MAX;
+    }
+}
+
+// a `density` fraction of scores are above score_threshold, dense scores are typical for one-stage detectors
+// before filtering, sparse ones for confident multi-class outputs.
+static void fill_nms_scores(const int64_t num_scores, const float score_threshold, const float density, float *scores) {
+    for (int64_t i = 0; i < num_scores; ++i) {
+        const float r = (float)rand() / RAND_MAX;
+        if ((float)rand() / RAND_MAX < density) {
+            scores[i] = score_threshold + (1.0f - score_threshold) * std::max(r, 1e-6f);
+        } else {
+            scores[i] = score_threshold * r;
+        }
+    }
+}
+
+static ppl::common::RetCode create_nms(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(
+        const float*, const float*, const uint32_t, const uint32_t, const uint32_t, const bool,
+        const int64_t, const float, const float, int64_t*, int64_t*);
+    auto func = select_variant<func_t>({
+#ifdef PPL_USE_X86_AVX512
+        {ISA_AVX512, "avx512", ppl::kernel::x86::nms_ndarray_fp32_avx512},
+#endif
+        {ISA_FMA, "fma", ppl::kernel::x86::nms_ndarray_fp32_fma},
+        {ISA_REF, "ref", ppl::kernel::x86::nms_ndarray_fp32},
+    }, isa, &bc->impl);
+    const int64_t num_boxes = args.get_int("boxes", 1000);
+    const int64_t batch = args.get_int("batch", 1);
+    const int64_t num_classes = args.get_int("classes", 1);
+    const int64_t max_output = args.get_int("max_output", num_boxes);
+    const float iou_threshold = args.get_float("iou", 0.5f);
+    const float score_threshold = args.get_float("score", 0.0f);
+    const float density = args.get_float("density", 1.0f);
+
+    auto boxes = (float*)mem->alloc(batch * num_boxes * 4 * sizeof(float));
+    auto scores = (float*)mem->alloc(batch * num_classes * num_boxes * sizeof(float));
+    auto dst = (int64_t*)mem->alloc(batch * num_classes * std::min(max_output, num_boxes) * 3 * sizeof(int64_t));
+    BENCH_CHECK_ALLOC(boxes);
+    BENCH_CHECK_ALLOC(scores);
+    BENCH_CHECK_ALLOC(dst);
+    fill_nms_boxes(batch * num_boxes, boxes);
+    fill_nms_scores(batch * num_classes * num_boxes, score_threshold, density, scores);
+
+    bc->execute = [=]() {
+        int64_t num_boxes_out = 0;
+        return func(
+            boxes, scores, num_boxes, batch, num_classes, false, max_output,
+            iou_threshold, score_threshold, dst, &num_boxes_out);
+    };
+    bc->gops = 0;
+    bc->gbs = (double)(batch * num_boxes * 4 + batch * num_classes * num_boxes) * sizeof(float) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_mmcv_nms(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(
+        const float*, const float*, const uint32_t, const float, const int64_t, int64_t*, int64_t*);
+    auto func = select_variant<func_t>({
+#ifdef PPL_USE_X86_AVX512
+        {ISA_AVX512, "avx512", ppl::kernel::x86::mmcv_nms_ndarray_fp32_avx512},
+#endif
+        {ISA_FMA, "fma", ppl::kernel::x86::mmcv_nms_ndarray_fp32_fma},
+        {ISA_REF, "ref", ppl::kernel::x86::mmcv_nms_ndarray_fp32},
+    }, isa, &bc->impl);
+    const int64_t num_boxes = args.get_int("boxes", 1000);
+    const float iou_threshold = args.get_float("iou", 0.5f);
+    const int64_t offset = args.get_int("offset", 0);
+
+    // mmcv boxes are [x1, y1, x2, y2], which makes no difference to random boxes
+    auto boxes = (float*)mem->alloc(num_boxes * 4 * sizeof(float));
+    auto scores = mem->alloc_random(num_boxes, 0.0f, 1.0f);
+    auto dst = (int64_t*)mem->alloc(num_boxes * sizeof(int64_t));
+    BENCH_CHECK_ALLOC(boxes);
+    BENCH_CHECK_ALLOC(scores);
+    BENCH_CHECK_ALLOC(dst);
+    fill_nms_boxes(num_boxes, boxes);
+
+    bc->execute = [=]() {
+        int64_t num_boxes_out = 0;
+        return func(boxes, scores, num_boxes, iou_threshold, offset, dst, &num_boxes_out);
+    };
+    bc->gops = 0;
+    bc->gbs = (double)(num_boxes * 4 + num_boxes) * sizeof(float) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+struct pool2d_args {
+    std::vector<int64_t> src_dims;
+    std::vector<int64_t> dst_dims;
+    int32_t kernel;
+    int32_t stride;
+    int32_t pad;
+};
+
+static ppl::common::RetCode parse_pool2d_args(const bench_args &args, pool2d_args *pa) {
+    pa->src_dims = args.get_dims("dims", "1x64x112x112");
+    pa->kernel = args.get_int("kernel_size", 3);
+    pa->stride = args.get_int("stride", 2);
+    pa->pad = args.get_int("pad", 1);
+    if (pa->src_dims.size() != 4) {
+        std::cerr << ",pool2d requires 4-d dims";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    pa->dst_dims = pa->src_dims;
+    pa->dst_dims[2] = (pa->src_dims[2] + 2 * pa->pad - pa->kernel) / pa->stride + 1;
+    pa->dst_dims[3] = (pa->src_dims[3] + 2 * pa->pad - pa->kernel) / pa->stride + 1;
+    return ppl::common::RC_SUCCESS;
+}
+
+typedef ppl::common::RetCode (*maxpool2d_func_t)(
+    const ppl::nn::TensorShape*, const ppl::nn::TensorShape*, const float*,
+    const int32_t, const int32_t, const int32_t, const int32_t, const int32_t, const int32_t, float*);
+
+static ppl::common::RetCode create_maxpool2d(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    const bool is_n16cx = args.get_str("format", "ndarray") == "n16cx";
+    const auto format = is_n16cx ? ppl::common::DATAFORMAT_N16CX : ppl::common::DATAFORMAT_NDARRAY;
+    std::vector<bench_variant<maxpool2d_func_t>> variants;
+    if (is_n16cx) {
+        variants = {
+#ifdef PPL_USE_X86_AVX512
+            {ISA_AVX512, "avx512", ppl::kernel::x86::maxpool2d_n16chw_blk1x16_fp32_avx512},
+#endif
+            {ISA_AVX, "avx", ppl::kernel::x86::maxpool2d_n16chw_blk1x8_fp32_avx},
+            {ISA_SSE, "sse", ppl::kernel::x86::maxpool2d_n16chw_blk1x4_fp32_sse},
+        };
+    } else {
+        variants = {{ISA_REF, "ref", ppl::kernel::x86::maxpool2d_nchw_normal_fp32}};
+    }
+    auto func = select_variant(variants, isa, &bc->impl);
+    if (!func) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    pool2d_args pa;
+    auto rc = parse_pool2d_args(args, &pa);
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+    auto src_shape = mem->new_shape(pa.src_dims, format);
+    auto dst_shape = mem->new_shape(pa.dst_dims, format);
+    auto src = mem->alloc_random(src_shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(dst_shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+
+    bc->execute = [=]() {
+        return func(src_shape, dst_shape, src, pa.kernel, pa.kernel, pa.stride, pa.stride, pa.pad, pa.pad, dst);
+    };
+    bc->gops = (double)dst_shape->GetElementsExcludingPadding() * pa.kernel * pa.kernel / 1e9;
+    bc->gbs = (bytes_of(src_shape) + bytes_of(dst_shape)) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+typedef ppl::common::RetCode (*averagepool2d_func_t)(
+    const ppl::nn::TensorShape*, const ppl::nn::TensorShape*, const float*,
+    const int32_t, const int32_t, const int32_t, const int32_t, const int32_t, const int32_t,
+    const int32_t, const int32_t, float*);
+
+static ppl::common::RetCode create_averagepool2d(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    const bool is_n16cx = args.get_str("format", "ndarray") == "n16cx";
+    const auto format = is_n16cx ? ppl::common::DATAFORMAT_N16CX : ppl::common::DATAFORMAT_NDARRAY;
+    std::vector<bench_variant<averagepool2d_func_t>> variants;
+    if (is_n16cx) {
+        variants = {
+#ifdef PPL_USE_X86_AVX512
+            {ISA_AVX512, "avx512", ppl::kernel::x86::averagepool2d_n16chw_blk1x16_fp32_avx512},
+#endif
+            {ISA_AVX, "avx", ppl::kernel::x86::averagepool2d_n16chw_blk1x8_fp32_avx},
+            {ISA_SSE, "sse", ppl::kernel::x86::averagepool2d_n16chw_blk1x4_fp32_sse},
+        };
+    } else {
+        variants = {{ISA_REF, "ref", ppl::kernel::x86::averagepool2d_nchw_normal_fp32}};
+    }
+    auto func = select_variant(variants, isa, &bc->impl);
+    if (!func) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    pool2d_args pa;
+    auto rc = parse_pool2d_args(args, &pa);
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+    auto src_shape = mem->new_shape(pa.src_dims, format);
+    auto dst_shape = mem->new_shape(pa.dst_dims, format);
+    auto src = mem->alloc_random(src_shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(dst_shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+
+    const int32_t exclude_pad_mode = 1; // same as POOLING_AVERAGE_EXCLUDE
+    bc->execute = [=]() {
+        return func(src_shape, dst_shape, src, pa.kernel, pa.kernel, pa.stride, pa.stride, pa.pad, pa.pad,
+                    exclude_pad_mode, 0, dst);
+    };
+    bc->gops = (double)dst_shape->GetElementsExcludingPadding() * pa.kernel * pa.kernel / 1e9;
+    bc->gbs = (bytes_of(src_shape) + bytes_of(dst_shape)) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_concat(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    const bool is_n16cx = args.get_str("format", "ndarray") == "n16cx";
+    const auto format = is_n16cx ? ppl::common::DATAFORMAT_N16CX : ppl::common::DATAFORMAT_NDARRAY;
+    auto src_dims = args.get_dims("dims", "1x64x56x56");
+    const int32_t num_src = args.get_int("num", 2);
+    const int32_t axis = normalize_axis(args.get_int("axis", 1), src_dims.size());
+    auto dst_dims = src_dims;
+    dst_dims[axis] *= num_src;
+
+    auto src_shapes = std::make_shared<std::vector<const ppl::nn::TensorShape*>>();
+    auto srcs = std::make_shared<std::vector<const float*>>();
+    for (int32_t i = 0; i < num_src; ++i) {
+        src_shapes->push_back(mem->new_shape(src_dims, format));
+        srcs->push_back(mem->alloc_random(src_shapes->back()->GetElementsIncludingPadding()));
+        BENCH_CHECK_ALLOC(srcs->back());
+    }
+    auto dst_shape = mem->new_shape(dst_dims, format);
+    auto dst = (float*)mem->alloc(dst_shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(dst);
+
+    bc->impl = "ref";
+    if (is_n16cx) {
+        bc->execute = [=]() {
+            return ppl::kernel::x86::concat_n16cx_fp32(src_shapes->data(), srcs->data(), num_src, axis, dst);
+        };
+    } else {
+        bc->execute = [=]() {
+            return ppl::kernel::x86::concat_ndarray_fp32(src_shapes->data(), srcs->data(), num_src, axis, dst);
+        };
+    }
+    bc->gops = 0;
+    bc->gbs = 2 * bytes_of(dst_shape) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_split(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    const bool is_n16cx = args.get_str("format", "ndarray") == "n16cx";
+    const auto format = is_n16cx ? ppl::common::DATAFORMAT_N16CX : ppl::common::DATAFORMAT_NDARRAY;
+    auto src_dims = args.get_dims("dims", "1x128x56x56");
+    const int32_t num_dst = args.get_int("num", 2);
+    const int32_t axis = normalize_axis(args.get_int("axis", 1), src_dims.size());
+    if (src_dims[axis] % num_dst != 0) {
+        std::cerr << ",dims on axis cannot be split evenly";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    auto dst_dims = src_dims;
+    dst_dims[axis] /= num_dst;
+
+    auto src_shape = mem->new_shape(src_dims, format);
+    auto src = mem->alloc_random(src_shape->GetElementsIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    auto dst_shapes = std::make_shared<std::vector<const ppl::nn::TensorShape*>>();
+    auto dsts = std::make_shared<std::vector<float*>>();
+    for (int32_t i = 0; i < num_dst; ++i) {
+        dst_shapes->push_back(mem->new_shape(dst_dims, format));
+        dsts->push_back((float*)mem->alloc(dst_shapes->back()->GetBytesIncludingPadding()));
+        BENCH_CHECK_ALLOC(dsts->back());
+    }
+
+    bc->impl = "ref";
+    if (is_n16cx) {
+        bc->execute = [=]() {
+            return ppl::kernel::x86::split_n16cx_fp32(src_shape, dst_shapes->data(), src, axis, num_dst, dsts->data());
+        };
+    } else {
+        bc->execute = [=]() {
+            return ppl::kernel::x86::split_ndarray_fp32(src_shape, dst_shapes->data(), src, axis, num_dst, dsts->data());
+        };
+    }
+    bc->gops = 0;
+    bc->gbs = 2 * bytes_of(src_shape) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_batchnorm(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(
+        const ppl::nn::TensorShape*, const float*, const float*, const float*, const float*, const float*,
+        const float, const bool, float*);
+    const bool is_n16cx = args.get_str("format", "ndarray") == "n16cx";
+    const auto format = is_n16cx ? ppl::common::DATAFORMAT_N16CX : ppl::common::DATAFORMAT_NDARRAY;
+    std::vector<bench_variant<func_t>> variants;
+    if (is_n16cx) {
+        variants = {
+            {ISA_AVX, "avx", ppl::kernel::x86::batchnorm_n16cx_fp32_avx},
+            {ISA_SSE, "sse", ppl::kernel::x86::batchnorm_n16cx_fp32_sse},
+        };
+    } else {
+        variants = {
+            {ISA_AVX, "avx", ppl::kernel::x86::batchnorm_ndarray_fp32_avx},
+            {ISA_SSE, "sse", ppl::kernel::x86::batchnorm_ndarray_fp32_sse},
+        };
+    }
+    auto func = select_variant(variants, isa, &bc->impl);
+    if (!func) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    auto shape = mem->new_shape(args.get_dims("dims", "1x64x56x56"), format);
+    const int64_t channels = shape->GetDimCount() > 1 ? shape->GetDim(1) : 1;
+    auto src = mem->alloc_random(shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(shape->GetBytesIncludingPadding());
+    auto mean = mem->alloc_random(channels);
+    auto var = mem->alloc_random(channels, 0.5f, 1.0f);
+    auto scale = mem->alloc_random(channels);
+    auto shift = mem->alloc_random(channels);
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+    BENCH_CHECK_ALLOC(mean);
+    BENCH_CHECK_ALLOC(var);
+    BENCH_CHECK_ALLOC(scale);
+    BENCH_CHECK_ALLOC(shift);
+
+    bc->execute = [=]() { return func(shape, src, mean, var, scale, shift, 1e-5f, false, dst); };
+    bc->gops = 2.0 * shape->GetElementsExcludingPadding() / 1e9;
+    bc->gbs = 2 * bytes_of(shape) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_layer_norm(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(
+        const ppl::nn::TensorShape*, const float*, const float*, const float*, const int64_t, const float, float*);
+    auto func = select_variant<func_t>({
+#ifdef PPL_USE_X86_AVX512
+        {ISA_AVX512, "avx512", ppl::kernel::x86::layer_norm_fp32_avx512},
+#endif
+        {ISA_FMA, "fma", ppl::kernel::x86::layer_norm_fp32_fma},
+        {ISA_REF, "ref", ppl::kernel::x86::layer_norm_fp32},
+    }, isa, &bc->impl);
+    auto shape = mem->new_shape(args.get_dims("dims", "128x768"));
+    const int64_t axis = normalize_axis(args.get_int("axis", -1), shape->GetDimCount());
+    const int64_t norm_size = shape->GetElementsFromDimensionExcludingPadding(axis);
+    auto src = mem->alloc_random(shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(shape->GetBytesIncludingPadding());
+    auto scale = mem->alloc_random(norm_size);
+    auto shift = mem->alloc_random(norm_size);
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+    BENCH_CHECK_ALLOC(scale);
+    BENCH_CHECK_ALLOC(shift);
+
+    bc->execute = [=]() { return func(shape, src, scale, shift, axis, 1e-5f, dst); };
+    // mean, variance and the affine transformation
+    bc->gops = 6.0 * shape->GetElementsExcludingPadding() / 1e9;
+    bc->gbs = 2 * bytes_of(shape) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_matmul(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    auto a_dims = args.get_dims("dims", "128x768");
+    auto b_dims = args.get_dims("dims1", "768x768");
+    if (a_dims.size() < 2 || b_dims.size() < 2 || a_dims.back() != b_dims[b_dims.size() - 2] ||
+        (b_dims.size() > 2 && b_dims.size() != a_dims.size())) {
+        std::cerr << ",dims and dims1 do not match";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    auto dst_dims = a_dims;
+    dst_dims.back() = b_dims.back();
+
+    auto a_shape = mem->new_shape(a_dims);
+    auto b_shape = mem->new_shape(b_dims);
+    auto dst_shape = mem->new_shape(dst_dims);
+    auto a = mem->alloc_random(a_shape->GetElementsIncludingPadding());
+    auto b = mem->alloc_random(b_shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(dst_shape->GetBytesIncludingPadding());
+    auto temp_buffer = mem->alloc(ppl::kernel::x86::matmul_ndarray_fp32_get_buffer_bytes(a_shape, b_shape, isa));
+    BENCH_CHECK_ALLOC(a);
+    BENCH_CHECK_ALLOC(b);
+    BENCH_CHECK_ALLOC(dst);
+    BENCH_CHECK_ALLOC(temp_buffer);
+
+    bc->impl = "isa";
+    bc->execute = [=]() {
+        return ppl::kernel::x86::matmul_ndarray_fp32(a_shape, b_shape, dst_shape, a, b, isa, temp_buffer, dst);
+    };
+    bc->gops = 2.0 * dst_shape->GetElementsExcludingPadding() * a_dims.back() / 1e9;
+    bc->gbs = (bytes_of(a_shape) + bytes_of(b_shape) + bytes_of(dst_shape)) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_gemm(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    const int64_t M = args.get_int("m", 512);
+    const int64_t N = args.get_int("n", 512);
+    const int64_t K = args.get_int("k", 512);
+
+    ppl::kernel::x86::gemm_v2_param_fp32 param;
+    param.src_A = mem->alloc_random(M * K);
+    param.src_B = mem->alloc_random(K * N);
+    param.dst_Y = (float*)mem->alloc(M * N * sizeof(float));
+    BENCH_CHECK_ALLOC(param.src_A);
+    BENCH_CHECK_ALLOC(param.src_B);
+    BENCH_CHECK_ALLOC(param.dst_Y);
+    param.M = M;
+    param.N = N;
+    param.K = K;
+    param.lda = K;
+    param.ldb = N;
+    param.ldy = N;
+    param.isa_flag = isa;
+
+    auto executor = std::shared_ptr<ppl::kernel::x86::gemm_v2_executor_fp32>(
+        ppl::kernel::x86::create_gemm_v2_executor_fp32(param));
+    if (!executor) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    auto temp_buffer = mem->alloc(executor->get_buffer_bytes());
+    BENCH_CHECK_ALLOC(temp_buffer);
+    executor->set_temp_buffer(temp_buffer);
+
+    bc->impl = "isa";
+    bc->execute = [=]() { return executor->execute(); };
+    bc->gops = 2.0 * M * N * K / 1e9;
+    bc->gbs = (double)(M * K + K * N + M * N) * sizeof(float) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_memory_copy(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    auto shape = mem->new_shape(args.get_dims("dims", "1x64x56x56"));
+    const uint64_t bytes = shape->GetBytesExcludingPadding();
+    auto src = mem->alloc(bytes);
+    auto dst = mem->alloc(bytes);
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+
+    bc->impl = "ref";
+    bc->execute = [=]() { return ppl::kernel::x86::memory_copy(src, bytes, dst); };
+    bc->gops = 0;
+    bc->gbs = 2.0 * bytes / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_cast(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    static std::map<std::string, ppl::common::datatype_t> type_table = {
+        {"int32", ppl::common::DATATYPE_INT32},
+        {"int64", ppl::common::DATATYPE_INT64},
+        {"float64", ppl::common::DATATYPE_FLOAT64},
+    };
+    auto it = type_table.find(args.get_str("to", "int64"));
+    if (it == type_table.end()) {
+        std::cerr << ",cast supports to=int32,int64,float64";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    auto dims = args.get_dims("dims", "1x64x56x56");
+    auto src_shape = mem->new_shape(dims);
+    auto dst_shape = mem->new_shape(dims, ppl::common::DATAFORMAT_NDARRAY, it->second);
+    auto src = mem->alloc_random(src_shape->GetElementsIncludingPadding(), -100.0f, 100.0f);
+    auto dst = mem->alloc(dst_shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+
+    bc->impl = "ref";
+    bc->execute = [=]() { return ppl::kernel::x86::cast(src_shape, dst_shape, src, dst); };
+    bc->gops = 0;
+    bc->gbs = (bytes_of(src_shape) + bytes_of(dst_shape)) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_swish(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(const ppl::nn::TensorShape*, const float*, const float, float*);
+    auto func = select_variant<func_t>({
+        {ISA_FMA, "fma", ppl::kernel::x86::swish_fp32_fma},
+        {ISA_SSE, "sse", ppl::kernel::x86::swish_fp32_sse},
+        {ISA_REF, "ref", ppl::kernel::x86::swish_fp32},
+    }, isa, &bc->impl);
+    auto shape = mem->new_shape(args.get_dims("dims", "1x64x56x56"));
+    auto src = mem->alloc_random(shape->GetElementsIncludingPadding());
+    auto dst = (float*)mem->alloc(shape->GetBytesIncludingPadding());
+    BENCH_CHECK_ALLOC(src);
+    BENCH_CHECK_ALLOC(dst);
+    const float beta = args.get_float("beta", 1.0f);
+
+    bc->execute = [=]() { return func(shape, src, beta, dst); };
+    // x * sigmoid(beta * x)
+    bc->gops = 5.0 * shape->GetElementsExcludingPadding() / 1e9;
+    bc->gbs = 2 * bytes_of(shape) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_eltwise_chain(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::kernel::x86::eltwise_chain_op_type op_type;
+    static std::map<std::string, ppl::kernel::x86::eltwise_chain_op_type_t> op_table = {
+        {"add", op_type::ADD}, {"sub", op_type::SUB}, {"mul", op_type::MUL}, {"div", op_type::DIV},
+        {"relu", op_type::RELU}, {"sigmoid", op_type::SIGMOID}, {"tanh", op_type::TANH}, {"exp", op_type::EXP},
+    };
+    typedef ppl::common::RetCode (*func_t)(
+        const ppl::nn::TensorShape*, const ppl::kernel::x86::eltwise_chain_src*,
+        const ppl::kernel::x86::eltwise_chain_op*, const int32_t, void*, float*);
+    auto func = select_variant<func_t>({
+#ifdef PPL_USE_X86_AVX512
+        {ISA_AVX512, "avx512", ppl::kernel::x86::eltwise_chain_fp32_avx512},
+#endif
+        {ISA_FMA, "fma", ppl::kernel::x86::eltwise_chain_fp32_fma},
+        {ISA_REF, "ref", ppl::kernel::x86::eltwise_chain_fp32},
+    }, isa, &bc->impl);
+
+    // binary ops take the other operand from src[1], which has the same dims as src[0]
+    std::vector<ppl::kernel::x86::eltwise_chain_op> ops;
+    std::stringstream ss(args.get_str("ops", "add:relu"));
+    std::string name;
+    while (std::getline(ss, name, ':')) {
+        auto it = op_table.find(name);
+        if (it == op_table.end()) {
+            std::cerr << ",eltwise_chain supports ops of add,sub,mul,div,relu,sigmoid,tanh,exp";
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        ppl::kernel::x86::eltwise_chain_op op;
+        op.type = it->second;
+        op.src_idx = ppl::kernel::x86::eltwise_chain_op_is_binary(op.type) ? 1 : -1;
+        op.value_idx = -1;
+        op.reverse = false;
+        op.alpha = 0.0f;
+        op.beta = 0.0f;
+        ops.push_back(op);
+    }
+    if (ops.empty()) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    auto shape = mem->new_shape(args.get_dims("dims", "1x64x56x56"));
+    const uint64_t num_elements = shape->GetElementsIncludingPadding();
+    auto src0 = mem->alloc_random(num_elements, 0.0f, 1.0f);
+    auto src1 = mem->alloc_random(num_elements, 1.0f, 2.0f);
+    auto dst = (float*)mem->alloc(shape->GetBytesIncludingPadding());
+    auto temp_buffer = mem->alloc(ppl::kernel::x86::eltwise_chain_fp32_get_buffer_bytes(ops.data(), ops.size()));
+    BENCH_CHECK_ALLOC(src0);
+    BENCH_CHECK_ALLOC(src1);
+    BENCH_CHECK_ALLOC(dst);
+    BENCH_CHECK_ALLOC(temp_buffer);
+
+    std::vector<ppl::kernel::x86::eltwise_chain_src> srcs(2);
+    ppl::kernel::x86::eltwise_chain_init_src(shape, shape, src0, &srcs[0]);
+    ppl::kernel::x86::eltwise_chain_init_src(shape, shape, src1, &srcs[1]);
+    bool use_src1 = false;
+    for (auto &op : ops) {
+        use_src1 = use_src1 || op.src_idx == 1;
+    }
+
+    bc->execute = [=]() { return func(shape, srcs.data(), ops.data(), ops.size(), temp_buffer, dst); };
+    bc->gops = (double)ops.size() * shape->GetElementsExcludingPadding() / 1e9;
+    bc->gbs = (use_src1 ? 3 : 2) * bytes_of(shape) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_attention(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(
+        const ppl::nn::TensorShape*, const ppl::nn::TensorShape*, const ppl::nn::TensorShape*,
+        const ppl::nn::TensorShape*, const float*, const float*, const float*, const float*, const float,
+        void*, float*);
+    auto func = select_variant<func_t>({
+#ifdef PPL_USE_X86_AVX512
+        {ISA_AVX512, "avx512", ppl::kernel::x86::attention_fp32_avx512},
+#endif
+        {ISA_FMA, "fma", ppl::kernel::x86::attention_fp32_fma},
+        {ISA_REF, "ref", ppl::kernel::x86::attention_fp32},
+    }, isa, &bc->impl);
+    // batch x heads x seq x head_size of Q, K and V
+    auto dims = args.get_dims("dims", "1x12x128x64");
+    if (dims.size() != 4) {
+        std::cerr << ",attention requires 4 dims";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    const int64_t batch = dims[0], heads = dims[1], seq = dims[2], head_size = dims[3];
+    auto q_shape = mem->new_shape({batch, heads, seq, head_size});
+    auto k_shape = mem->new_shape({batch, heads, head_size, seq});
+    auto v_shape = mem->new_shape({batch, heads, seq, head_size});
+    auto mask_shape = args.get_int("mask", 0) ? mem->new_shape({batch, 1, 1, seq}) : nullptr;
+    auto Q = mem->alloc_random(q_shape->GetElementsIncludingPadding());
+    auto K = mem->alloc_random(k_shape->GetElementsIncludingPadding());
+    auto V = mem->alloc_random(v_shape->GetElementsIncludingPadding());
+    auto mask = mask_shape ? mem->alloc_random(mask_shape->GetElementsIncludingPadding()) : nullptr;
+    auto dst = (float*)mem->alloc(q_shape->GetBytesIncludingPadding());
+    auto temp_buffer = mem->alloc(ppl::kernel::x86::attention_fp32_get_buffer_bytes(q_shape, k_shape));
+    BENCH_CHECK_ALLOC(Q);
+    BENCH_CHECK_ALLOC(K);
+    BENCH_CHECK_ALLOC(V);
+    BENCH_CHECK_ALLOC(dst);
+    BENCH_CHECK_ALLOC(temp_buffer);
+    if (mask_shape) {
+        BENCH_CHECK_ALLOC(mask);
+    }
+    const float scale = 1.0f / sqrtf((float)head_size);
+
+    bc->execute = [=]() {
+        return func(q_shape, k_shape, v_shape, mask_shape, Q, K, V, mask, scale, temp_buffer, dst);
+    };
+    // Q * K and softmax(.) * V
+    bc->gops = 4.0 * batch * heads * seq * seq * head_size / 1e9;
+    bc->gbs = (4 * bytes_of(q_shape) + (mask_shape ? bytes_of(mask_shape) : 0.)) / 1e9;
+    return ppl::common::RC_SUCCESS;
+}
+
+// X: seq x batch x input_size, weights of all gates are stacked as in onnx. initial states are always given,
+// as in stateful inference where hidden states are fed back between calls.
+struct rnn_bench_shapes {
+    int64_t seq_len;
+    int64_t batch;
+    int64_t input_size;
+    int64_t hidden_size;
+    int64_t num_direction;
+    ppl::kernel::x86::rnn_direction_t direction;
+};
+
+static ppl::common::RetCode parse_rnn_args(const bench_args &args, rnn_bench_shapes *rs) {
+    auto dims = args.get_dims("dims", "32x1x256");
+    if (dims.size() != 3) {
+        std::cerr << ",rnn requires 3 dims";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    rs->seq_len = dims[0];
+    rs->batch = dims[1];
+    rs->input_size = dims[2];
+    rs->hidden_size = args.get_int("hidden", 256);
+    const std::string direction = args.get_str("direction", "forward");
+    if (direction == "forward") {
+        rs->direction = ppl::kernel::x86::rnn_direction::FORWARD;
+    } else if (direction == "bidirectional") {
+        rs->direction = ppl::kernel::x86::rnn_direction::BIDIRECTIONAL;
+    } else {
+        std::cerr << ",rnn supports direction=forward,bidirectional";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    rs->num_direction = rs->direction == ppl::kernel::x86::rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    return ppl::common::RC_SUCCESS;
+}
+
+static void fill_rnn_bench_case(const rnn_bench_shapes &rs, const int64_t num_gate, bench_case *bc) {
+    const double num_steps = (double)rs.num_direction * rs.seq_len * rs.batch;
+    bc->gops = 2.0 * num_steps * num_gate * rs.hidden_size * (rs.input_size + rs.hidden_size) / 1e9;
+    const double weight_elements =
+        (double)rs.num_direction * num_gate * rs.hidden_size * (rs.input_size + rs.hidden_size);
+    const double io_elements = (double)rs.seq_len * rs.batch * (rs.input_size + rs.num_direction * rs.hidden_size);
+    bc->gbs = (weight_elements + io_elements) * sizeof(float) / 1e9;
+}
+
+static ppl::common::RetCode create_lstm(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(
+        const ppl::nn::TensorShape*, const float*, const float*, const float*, const float*, const float*,
+        const int32_t*, const float*, const float*, const ppl::kernel::x86::rnn_direction_t, const int64_t,
+        void*, float*, float*, float*);
+    typedef uint64_t (*buffer_func_t)(
+        const ppl::nn::TensorShape*, const ppl::kernel::x86::rnn_direction_t, const int64_t, const bool, const bool, const bool);
+    auto func = select_variant<func_t>({
+        {ISA_FMA, "fma", ppl::kernel::x86::lstm_fp32_fma},
+        {ISA_REF, "ref", ppl::kernel::x86::lstm_ref_fp32},
+    }, isa, &bc->impl);
+    std::string unused;
+    auto buffer_func = select_variant<buffer_func_t>({
+        {ISA_FMA, "fma", ppl::kernel::x86::lstm_fp32_fma_get_buffer_bytes},
+        {ISA_REF, "ref", ppl::kernel::x86::lstm_ref_fp32_get_buffer_bytes},
+    }, isa, &unused);
+    rnn_bench_shapes rs;
+    auto rc = parse_rnn_args(args, &rs);
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+    const int64_t num_gate = ppl::kernel::x86::rnn_num_gate::LSTM;
+    const int64_t gate_size = num_gate * rs.hidden_size;
+    auto x_shape = mem->new_shape({rs.seq_len, rs.batch, rs.input_size});
+    auto X = mem->alloc_random(x_shape->GetElementsIncludingPadding());
+    auto W = mem->alloc_random(rs.num_direction * gate_size * rs.input_size);
+    auto R = mem->alloc_random(rs.num_direction * gate_size * rs.hidden_size);
+    auto B = mem->alloc_random(rs.num_direction * 2 * gate_size);
+    auto Y = (float*)mem->alloc(rs.seq_len * rs.num_direction * rs.batch * rs.hidden_size * sizeof(float));
+    auto Y_h = (float*)mem->alloc(rs.num_direction * rs.batch * rs.hidden_size * sizeof(float));
+    auto Y_c = (float*)mem->alloc(rs.num_direction * rs.batch * rs.hidden_size * sizeof(float));
+    auto initial_h = mem->alloc_random(rs.num_direction * rs.batch * rs.hidden_size);
+    auto initial_c = mem->alloc_random(rs.num_direction * rs.batch * rs.hidden_size);
+    auto temp_buffer = mem->alloc(buffer_func(x_shape, rs.direction, rs.hidden_size, true, true, true));
+    BENCH_CHECK_ALLOC(X);
+    BENCH_CHECK_ALLOC(W);
+    BENCH_CHECK_ALLOC(R);
+    BENCH_CHECK_ALLOC(B);
+    BENCH_CHECK_ALLOC(Y);
+    BENCH_CHECK_ALLOC(Y_h);
+    BENCH_CHECK_ALLOC(Y_c);
+    BENCH_CHECK_ALLOC(initial_h);
+    BENCH_CHECK_ALLOC(initial_c);
+    BENCH_CHECK_ALLOC(temp_buffer);
+    const auto direction = rs.direction;
+    const int64_t hidden_size = rs.hidden_size;
+
+    bc->execute = [=]() {
+        return func(x_shape, X, W, R, nullptr, B, nullptr, initial_h, initial_c, direction, hidden_size, temp_buffer,
+                    Y, Y_h, Y_c);
+    };
+    fill_rnn_bench_case(rs, num_gate, bc);
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_gru(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(
+        const ppl::nn::TensorShape*, const float*, const float*, const float*, const float*, const int32_t*,
+        const float*, const ppl::kernel::x86::rnn_direction_t, const int64_t, const bool, void*, float*, float*);
+    typedef uint64_t (*buffer_func_t)(
+        const ppl::nn::TensorShape*, const ppl::kernel::x86::rnn_direction_t, const int64_t, const bool, const bool);
+    auto func = select_variant<func_t>({
+        {ISA_FMA, "fma", ppl::kernel::x86::gru_fp32_fma},
+        {ISA_REF, "ref", ppl::kernel::x86::gru_ref_fp32},
+    }, isa, &bc->impl);
+    std::string unused;
+    auto buffer_func = select_variant<buffer_func_t>({
+        {ISA_FMA, "fma", ppl::kernel::x86::gru_fp32_fma_get_buffer_bytes},
+        {ISA_REF, "ref", ppl::kernel::x86::gru_ref_fp32_get_buffer_bytes},
+    }, isa, &unused);
+    rnn_bench_shapes rs;
+    auto rc = parse_rnn_args(args, &rs);
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+    const int64_t num_gate = ppl::kernel::x86::rnn_num_gate::GRU;
+    const int64_t gate_size = num_gate * rs.hidden_size;
+    auto x_shape = mem->new_shape({rs.seq_len, rs.batch, rs.input_size});
+    auto X = mem->alloc_random(x_shape->GetElementsIncludingPadding());
+    auto W = mem->alloc_random(rs.num_direction * gate_size * rs.input_size);
+    auto R = mem->alloc_random(rs.num_direction * gate_size * rs.hidden_size);
+    auto B = mem->alloc_random(rs.num_direction * 2 * gate_size);
+    auto Y = (float*)mem->alloc(rs.seq_len * rs.num_direction * rs.batch * rs.hidden_size * sizeof(float));
+    auto Y_h = (float*)mem->alloc(rs.num_direction * rs.batch * rs.hidden_size * sizeof(float));
+    auto initial_h = mem->alloc_random(rs.num_direction * rs.batch * rs.hidden_size);
+    auto temp_buffer = mem->alloc(buffer_func(x_shape, rs.direction, rs.hidden_size, true, true));
+    BENCH_CHECK_ALLOC(X);
+    BENCH_CHECK_ALLOC(W);
+    BENCH_CHECK_ALLOC(R);
+    BENCH_CHECK_ALLOC(B);
+    BENCH_CHECK_ALLOC(Y);
+    BENCH_CHECK_ALLOC(Y_h);
+    BENCH_CHECK_ALLOC(initial_h);
+    BENCH_CHECK_ALLOC(temp_buffer);
+    const auto direction = rs.direction;
+    const int64_t hidden_size = rs.hidden_size;
+    const bool linear_before_reset = args.get_int("linear_before_reset", 0) != 0;
+
+    bc->execute = [=]() {
+        return func(x_shape, X, W, R, B, nullptr, initial_h, direction, hidden_size, linear_before_reset, temp_buffer,
+                    Y, Y_h);
+    };
+    fill_rnn_bench_case(rs, num_gate, bc);
+    return ppl::common::RC_SUCCESS;
+}
+
+static ppl::common::RetCode create_rnn(const bench_args &args, const ppl::common::isa_t isa, bench_memory *mem, bench_case *bc) {
+    typedef ppl::common::RetCode (*func_t)(
+        const ppl::nn::TensorShape*, const float*, const float*, const float*, const float*, const int32_t*,
+        const float*, const ppl::kernel::x86::rnn_direction_t, const int64_t, void*, float*, float*);
+    typedef uint64_t (*buffer_func_t)(
+        const ppl::nn::TensorShape*, const ppl::kernel::x86::rnn_direction_t, const int64_t, const bool, const bool);
+    auto func = select_variant<func_t>({
+        {ISA_FMA, "fma", ppl::kernel::x86::rnn_fp32_fma},
+        {ISA_REF, "ref", ppl::kernel::x86::rnn_ref_fp32},
+    }, isa, &bc->impl);
+    std::string unused;
+    auto buffer_func = select_variant<buffer_func_t>({
+        {ISA_FMA, "fma", ppl::kernel::x86::rnn_fp32_fma_get_buffer_bytes},
+        {ISA_REF, "ref", ppl::kernel::x86::rnn_ref_fp32_get_buffer_bytes},
+    }, isa, &unused);
+    rnn_bench_shapes rs;
+    auto rc = parse_rnn_args(args, &rs);
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+    const int64_t num_gate = ppl::kernel::x86::rnn_num_gate::RNN;
+    const int64_t gate_size = num_gate * rs.hidden_size;
+    auto x_shape = mem->new_shape({rs.seq_len, rs.batch, rs.input_size});
+    auto X = mem->alloc_random(x_shape->GetElementsIncludingPadding());
+    auto W = mem->alloc_random(rs.num_direction * gate_size * rs.input_size);
+    auto R = mem->alloc_random(rs.num_direction * gate_size * rs.hidden_size);
+    auto B = mem->alloc_random(rs.num_direction * 2 * gate_size);
+    auto Y = (float*)mem->alloc(rs.seq_len * rs.num_direction * rs.batch * rs.hidden_size * sizeof(float));
+    auto Y_h = (float*)mem->alloc(rs.num_direction * rs.batch * rs.hidden_size * sizeof(float));
+    auto initial_h = mem->alloc_random(rs.num_direction * rs.batch * rs.hidden_size);
+    auto temp_buffer = mem->alloc(buffer_func(x_shape, rs.direction, rs.hidden_size, true, true));
+    BENCH_CHECK_ALLOC(X);
+    BENCH_CHECK_ALLOC(W);
+    BENCH_CHECK_ALLOC(R);
+    BENCH_CHECK_ALLOC(B);
+    BENCH_CHECK_ALLOC(Y);
+    BENCH_CHECK_ALLOC(Y_h);
+    BENCH_CHECK_ALLOC(initial_h);
+    BENCH_CHECK_ALLOC(temp_buffer);
+    const auto direction = rs.direction;
+    const int64_t hidden_size = rs.hidden_size;
+
+    bc->execute = [=]() {
+        return func(x_shape, X, W, R, B, nullptr, initial_h, direction, hidden_size, temp_buffer, Y, Y_h);
+    };
+    fill_rnn_bench_case(rs, num_gate, bc);
+    return ppl::common::RC_SUCCESS;
+}
+
+struct bench_kernel {
+    bench_creator_t creator;
+    const char *usage;
+};
+
+static std::map<std::string, bench_kernel> kernel_table =
+{
+    {"relu", {create_relu, "dims"}},
+    {"sigmoid", {create_sigmoid, "dims"}},
+    {"tanh", {create_tanh, "dims"}},
+    {"exp", {create_exp, "dims"}},
+    {"erf", {create_erf, "dims"}},
+    {"sqrt", {create_sqrt, "dims"}},
+    {"clip", {create_clip, "dims min max"}},
+    {"leaky_relu", {create_leaky_relu, "dims alpha"}},
+    {"add", {create_add, "dims dims1 format(ndarray|n16cx)"}},
+    {"sub", {create_sub, "dims dims1 format(ndarray|n16cx)"}},
+    {"mul", {create_mul, "dims dims1 format(ndarray|n16cx)"}},
+    {"div", {create_div, "dims dims1 format(ndarray|n16cx)"}},
+    {"softmax", {create_softmax, "dims axis"}},
+    {"reduce_sum", {create_reduce_sum, "dims axes format(ndarray|n16cx)"}},
+    {"reduce_mean", {create_reduce_mean, "dims axes format(ndarray|n16cx)"}},
+    {"reduce_max", {create_reduce_max, "dims axes format(ndarray|n16cx)"}},
+    {"reduce_min", {create_reduce_min, "dims axes format(ndarray|n16cx)"}},
+    {"resize2d_nearest", {create_resize2d_nearest, "dims scale format(ndarray|n16cx)"}},
+    {"resize2d_linear", {create_resize2d_linear, "dims scale format(ndarray|n16cx)"}},
+    {"transpose", {create_transpose, "dims perm"}},
+    {"reorder_ndarray_n16cx", {create_reorder_ndarray_n16cx, "dims"}},
+    {"reorder_n16cx_ndarray", {create_reorder_n16cx_ndarray, "dims"}},
+    {"topk", {create_topk, "dims k axis largest sorted"}},
+    {"nms", {create_nms, "boxes batch classes max_output iou score density"}},
+    {"mmcv_nms", {create_mmcv_nms, "boxes iou offset"}},
+    {"maxpool2d", {create_maxpool2d, "dims kernel_size stride pad format(ndarray|n16cx)"}},
+    {"averagepool2d", {create_averagepool2d, "dims kernel_size stride pad format(ndarray|n16cx)"}},
+    {"concat", {create_concat, "dims num axis format(ndarray|n16cx)"}},
+    {"split", {create_split, "dims num axis format(ndarray|n16cx)"}},
+    {"batchnorm", {create_batchnorm, "dims format(ndarray|n16cx)"}},
+    {"layer_norm", {create_layer_norm, "dims axis"}},
+    {"matmul", {create_matmul, "dims dims1"}},
+    {"gemm", {create_gemm, "m n k"}},
+    {"memory_copy", {create_memory_copy, "dims"}},
+    {"cast", {create_cast, "dims to(int32|int64|float64)"}},
+    {"swish", {create_swish, "dims beta"}},
+    {"eltwise_chain", {create_eltwise_chain, "dims ops(e.g. add:relu, binary ops read a second input of dims)"}},
+    {"attention", {create_attention, "dims(batch x heads x seq x head_size) mask(0|1)"}},
+    {"lstm", {create_lstm, "dims(seq x batch x input) hidden direction(forward|bidirectional)"}},
+    {"gru", {create_gru, "dims(seq x batch x input) hidden direction(forward|bidirectional) linear_before_reset"}},
+    {"rnn", {create_rnn, "dims(seq x batch x input) hidden direction(forward|bidirectional)"}},
+};
+
+/*************************** driver ***************************/
+
+struct bench_result {
+    double min_us;
+    double avg_us;
+    int64_t iters;
+};
+
+static bench_result run_case(const bench_case &bc, const int32_t warm_up, const int32_t min_iter, const float min_second) {
+    for (int32_t i = 0; i < warm_up; ++i) {
+        bc.execute();
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    std::chrono::high_resolution_clock::time_point end;
+    bench_result result;
+    double tot_exe_us = 0.;
+    result.min_us = DBL_MAX;
+    result.iters = 0;
+    for (; result.iters < min_iter || tot_exe_us < min_second * 1e6; ++result.iters) {
+        start = std::chrono::high_resolution_clock::now();
+        bc.execute();
+        end = std::chrono::high_resolution_clock::now();
+        double dur = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e3;
+        tot_exe_us += dur;
+        if (dur < result.min_us) {
+            result.min_us = dur;
+        }
+    }
+    result.avg_us = tot_exe_us / result.iters;
+    return result;
+}
+
+// practical peak GFLOP/s of this cpu, measured with gemm
+static double measure_peak_gflops(const ppl::common::isa_t isa) {
+    bench_args args;
+    bench_memory mem;
+    bench_case bc;
+    args.set("m", "1024");
+    args.set("n", "1024");
+    args.set("k", "1024");
+    if (create_gemm(args, isa, &mem, &bc) != ppl::common::RC_SUCCESS) {
+        return 0.;
+    }
+    auto result = run_case(bc, 2, 5, 0.2f);
+    return bc.gops / (result.min_us / 1e6);
+}
+
+// practical GB/s of copying a working set of gbs gigabytes. the bandwidth roof depends on which level of
+// cache the working set fits in, so it is measured for each size instead of only for main memory.
+static double measure_peak_gbps(const ppl::common::isa_t isa, const double gbs) {
+    static std::map<int64_t, double> peak_table;
+    const int64_t num_elements = std::max<int64_t>(1024, gbs * 1e9 / 2 / sizeof(float));
+    auto it = peak_table.find(num_elements);
+    if (it != peak_table.end()) {
+        return it->second;
+    }
+
+    bench_args args;
+    bench_memory mem;
+    bench_case bc;
+    args.set("dims", std::to_string(num_elements));
+    double peak = 0.;
+    if (create_memory_copy(args, isa, &mem, &bc) == ppl::common::RC_SUCCESS) {
+        auto result = run_case(bc, 2, 5, 0.05f);
+        peak = bc.gbs / (result.min_us / 1e6);
+    }
+    peak_table[num_elements] = peak;
+    return peak;
+}
+
+// case strings come from the config file and may contain any character
+static std::string json_escape(const std::string &str) {
+    std::string escaped;
+    for (auto c : str) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if ((unsigned char)c < 0x20) {
+            char buf[8];
+            sprintf(buf, "\\u%04x", (unsigned char)c);
+            escaped += buf;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+int main(int argc, char **argv) {
+    simple_flags::parse_args(argc, argv);
+    if (Flag_help) {
+        simple_flags::print_args_info();
+        return 0;
+    }
+
+    if (Flag_list) {
+        for (auto &kv : kernel_table) {
+            std::cerr << "kernel=" << kv.first << " " << kv.second.usage << "\n";
+        }
+        return 0;
+    }
+
+    ppl::kernel::x86::set_denormals_zero(1);
+
+    std::vector<std::pair<int32_t, std::string>> sweeps;
+    if (!Flag_cfg.empty()) {
+        std::ifstream cfgfile(Flag_cfg, std::ios_base::in);
+        if (!cfgfile.is_open()) {
+            std::cerr << "cannot open config file\n";
+            simple_flags::print_args_info();
+            return -1;
+        }
+        std::string line;
+        for (int32_t line_no = 1; std::getline(cfgfile, line); ++line_no) {
+            // skip comment
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            sweeps.push_back(std::make_pair(line_no, line));
+        }
+    } else if (!Flag_sweep.empty()) {
+        sweeps.push_back(std::make_pair(0, Flag_sweep));
+    } else {
+        std::cerr << "either cfg or sweep is required\n";
+        simple_flags::print_args_info();
+        return -1;
+    }
+
+    ppl::common::isa_t isa = ppl::common::ISA_UNKNOWN;
+    if (Flag_isa == "auto") {
+        auto cpu_isa = ppl::common::GetCpuISA();
+        if (cpu_isa & ppl::common::ISA_X86_AVX512) {
+            Flag_isa = "avx512";
+        } else if (cpu_isa & ppl::common::ISA_X86_FMA) {
+            Flag_isa = "fma";
+        } else {
+            Flag_isa = "sse";
+        }
+    }
+    if (isa_table.find(Flag_isa) == isa_table.end()) {
+        std::cerr << "unknown isa " << Flag_isa << "\n";
+        return -1;
+    }
+    isa = isa_table[Flag_isa];
+    if ((isa & ppl::common::GetCpuISA()) != isa) {
+        std::cerr << "isa " << Flag_isa << " is not supported by this cpu\n";
+        return -1;
+    }
+
+    int32_t num_threads = 1;
+#if defined(__linux__) && defined(PPL_USE_X86_OMP)
+    num_threads = omp_get_max_threads();
+#pragma omp parallel
+    {
+#define handle_error_en(en, msg) do { errno = en; perror(msg); exit(EXIT_FAILURE); } while (0)
+        int i = omp_get_thread_num();
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(i, &cpuset);
+        if (int s = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+            handle_error_en(s, "pthread_setaffinity_np");
+        }
+#undef handle_error_en
+    }
+#endif
+
+    const double peak_gflops = Flag_peak_gflops > 0 ? Flag_peak_gflops : measure_peak_gflops(isa);
+
+    std::ofstream jsonfile;
+    if (!Flag_json.empty()) {
+        jsonfile.open(Flag_json, std::ios_base::out | std::ios_base::trunc);
+        if (!jsonfile.is_open()) {
+            std::cerr << "cannot open json file\n";
+            return -1;
+        }
+    }
+
+    std::cerr << "==============================================================\n";
+    fprintf(
+        stderr,
+        "num_threads=%d\nisa=%s\nwarm_up=%d\nmin_iter=%d\nmin_second=%f\npeak_gflops=%.2f\npeak_gbps=%s\n\n",
+        num_threads, Flag_isa.c_str(), Flag_warm_up, Flag_min_iter, Flag_min_second, peak_gflops,
+        Flag_peak_gbps > 0 ? std::to_string(Flag_peak_gbps).c_str() : "per working set"
+    );
+    std::cerr << "==============================================================\n";
+    std::cerr << "begin tests\n";
+    std::cerr << "line_no,case_string,impl,min_ms,max_gflops,max_gbps,avg_ms,avg_gflops,avg_gbps,peak_gbps,roofline_eff\n";
+
+    int32_t num_failed = 0;
+    for (auto &sweep : sweeps) {
+        std::vector<bench_args> cases;
+        if (!parse_sweep(sweep.second, &cases)) {
+            std::cerr << sweep.first << "," << sweep.second << ",invalid format\n";
+            ++num_failed;
+            continue;
+        }
+
+        for (auto &args : cases) {
+            const std::string case_string = args.to_string();
+            std::cerr << sweep.first << "," << case_string;
+
+            auto it = kernel_table.find(args.get_str("kernel", ""));
+            if (it == kernel_table.end()) {
+                std::cerr << ",unknown kernel\n";
+                ++num_failed;
+                continue;
+            }
+
+            bench_memory mem;
+            bench_case bc;
+            auto rc = it->second.creator(args, isa, &mem, &bc);
+            if (rc == ppl::common::RC_SUCCESS) {
+                rc = bc.execute();
+            }
+            if (rc != ppl::common::RC_SUCCESS) {
+                std::cerr << "," << ppl::common::GetRetCodeStr(rc) << "\n";
+                ++num_failed;
+                continue;
+            }
+
+            auto result = run_case(bc, Flag_warm_up, Flag_min_iter, Flag_min_second);
+
+            const double peak_gbps = Flag_peak_gbps > 0 ? Flag_peak_gbps : measure_peak_gbps(isa, bc.gbs);
+
+            // time bound of roofline over the measured time
+            const double roofline_us = std::max(
+                peak_gflops > 0 ? bc.gops / peak_gflops : 0.,
+                peak_gbps > 0 ? bc.gbs / peak_gbps : 0.) * 1e6;
+            const double eff = roofline_us / result.min_us;
+            const double max_gflops = bc.gops / (result.min_us / 1e6);
+            const double avg_gflops = bc.gops / (result.avg_us / 1e6);
+            const double max_gbps = bc.gbs / (result.min_us / 1e6);
+            const double avg_gbps = bc.gbs / (result.avg_us / 1e6);
+
+            fprintf(stderr, ",%s,%.3f,%.2f,%.2f,%.3f,%.2f,%.2f,%.2f,%.3f\n",
+                bc.impl.c_str(),
+                result.min_us / 1e3, max_gflops, max_gbps,
+                result.avg_us / 1e3, avg_gflops, avg_gbps, peak_gbps, eff);
+
+            if (jsonfile.is_open()) {
+                char buf[512];
+                sprintf(buf,
+                    "\"min_ms\":%.4f,\"avg_ms\":%.4f,\"iters\":%" PRId64 ",\"max_gflops\":%.3f,\"max_gbps\":%.3f,"
+                    "\"peak_gflops\":%.3f,\"peak_gbps\":%.3f,\"roofline_eff\":%.4f,\"num_threads\":%d}\n",
+                    result.min_us / 1e3, result.avg_us / 1e3, result.iters, max_gflops, max_gbps,
+                    peak_gflops, peak_gbps, eff, num_threads);
+                jsonfile << "{\"case\":\"" << json_escape(case_string) << "\",\"kernel\":\"" << json_escape(it->first)
+                         << "\",\"isa\":\"" << Flag_isa << "\",\"impl\":\"" << json_escape(bc.impl) << "\"," << buf;
+            }
+        }
+    }
+
+    std::cerr << "failed cases: " << num_failed << "\n";
+    return num_failed > 0 ? -1 : 0;
+}
@@ -0,0 +1,322 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <iostream>
+#include <vector>
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/int8/conv2d.h"
+#include "ppl/kernel/x86/int8/fc.h"
+#include "ppl/kernel/x86/fp32/conv2d.h"
+#include "ppl/kernel/x86/fp32/gemm.h"
+#include "ppl/kernel/x86/common/macros.h"
+#include "ppl/common/generic_cpu_allocator.h"
+#include "ppl/nn/common/tensor_shape.h"
+#include "simple_flags.h"
+#include "utils/check.h"
+
+// Validates int8 conv2d and fc kernels against fp32 reference kernels.
+// Inputs are integers in [-2, 2] quantized with src_scale = 1, and filters are in {-1, 0, 1} so that every output
+// channel is quantized with abs_max = 1. Quantization is lossless in this way, and results must match the reference
+// up to rounding errors of dequantization.
+
+Define_bool_opt("--help", Flag_help, false, "show these help information");
+Define_float(eps, 1e-4f, "(1e-4) rel error trunk for validation");
+
+struct conv2d_int8_case {
+    int64_t group, batch, channels, src_h, src_w, num_output;
+    int64_t kernel_h, kernel_w, stride_h, stride_w, pad_h, pad_w, dilation_h, dilation_w;
+    ppl::kernel::x86::conv_fuse_flag_t fuse_flag;
+};
+
+struct fc_int8_case {
+    int64_t M, N, K;
+    ppl::kernel::x86::fc_fuse_flag_t fuse_flag;
+};
+
+static const conv2d_int8_case conv2d_cases[] = {
+    // pointwise, direct
+    {1, 2, 64, 14, 14, 128, 1, 1, 1, 1, 0, 0, 1, 1, 0},
+    {1, 1, 30, 7, 9, 21, 1, 1, 1, 1, 0, 0, 1, 1, ppl::kernel::x86::conv_fuse_flag::RELU},
+    // im2col gemm
+    {1, 1, 32, 15, 15, 48, 3, 3, 1, 1, 1, 1, 1, 1, 0},
+    {1, 2, 3, 32, 32, 17, 3, 3, 2, 2, 1, 1, 1, 1, ppl::kernel::x86::conv_fuse_flag::RELU6},
+    {1, 1, 16, 12, 12, 16, 3, 3, 1, 1, 2, 2, 2, 2, 0},
+    {2, 1, 32, 10, 10, 32, 3, 3, 1, 1, 1, 1, 1, 1, ppl::kernel::x86::conv_fuse_flag::RELU},
+    {1, 1, 8, 9, 9, 8, 1, 1, 2, 2, 0, 0, 1, 1, 0},
+};
+
+static const fc_int8_case fc_cases[] = {
+    {1, 1000, 2048, 0},
+    {7, 33, 129, ppl::kernel::x86::fc_fuse_flag::RELU},
+    {64, 256, 512, 0},
+    {3, 16, 3, 0},
+};
+
+static void gen_src(float *src, uint64_t len)
+{
+    for (uint64_t i = 0; i < len; ++i) {
+        src[i] = float(rand() % 5 - 2);
+    }
+}
+
+static void gen_filter(float *filter, uint64_t oc, uint64_t k)
+{
+    for (uint64_t o = 0; o < oc; ++o) {
+        for (uint64_t i = 0; i < k; ++i) {
+            filter[o * k + i] = float(rand() % 3 - 1);
+        }
+        filter[o * k] = 1.0f; // abs_max of every output channel is 1
+    }
+}
+
+static void gen_bias(float *bias, uint64_t len)
+{
+    for (uint64_t i = 0; i < len; ++i) {
+        bias[i] = float(rand() % 7 - 3);
+    }
+}
+
+static bool test_conv2d_int8(const conv2d_int8_case &c, ppl::common::Allocator *allocator)
+{
+    ppl::kernel::x86::conv2d_int8_param param;
+    param.kernel_h   = c.kernel_h;
+    param.kernel_w   = c.kernel_w;
+    param.stride_h   = c.stride_h;
+    param.stride_w   = c.stride_w;
+    param.dilation_h = c.dilation_h;
+    param.dilation_w = c.dilation_w;
+    param.pad_h      = c.pad_h;
+    param.pad_w      = c.pad_w;
+    param.channels   = c.channels;
+    param.num_output = c.num_output;
+    param.group      = c.group;
+    param.fuse_flag  = c.fuse_flag;
+    param.src_scale  = 1.0f;
+
+    const int64_t ext_kernel_h = (c.kernel_h - 1) * c.dilation_h + 1;
+    const int64_t ext_kernel_w = (c.kernel_w - 1) * c.dilation_w + 1;
+    const int64_t dst_h        = (c.src_h + 2 * c.pad_h - ext_kernel_h) / c.stride_h + 1;
+    const int64_t dst_w        = (c.src_w + 2 * c.pad_w - ext_kernel_w) / c.stride_w + 1;
+
+    fprintf(stderr, "conv2d,g%" PRId64 "_mb%" PRId64 "_ic%" PRId64 "ih%" PRId64 "iw%" PRId64 "_oc%" PRId64
+            "oh%" PRId64 "ow%" PRId64 "_kh%" PRId64 "kw%" PRId64 "sh%" PRId64 "sw%" PRId64 "ph%" PRId64 "pw%" PRId64
+            "dh%" PRId64 "dw%" PRId64 "_f%u",
+            c.group, c.batch, c.channels, c.src_h, c.src_w, c.num_output, dst_h, dst_w, c.kernel_h, c.kernel_w,
+            c.stride_h, c.stride_w, c.pad_h, c.pad_w, c.dilation_h - 1, c.dilation_w - 1, c.fuse_flag);
+
+    auto algo_info = ppl::kernel::x86::conv2d_int8_algo_selector::select_algo(
+        ppl::common::DATAFORMAT_NDARRAY, param, ppl::common::GetCpuISA());
+    if (algo_info.algo_type == ppl::kernel::x86::conv2d_int8_algo::UNKNOWN) {
+        std::cerr << ",unsupported case\n";
+        return false;
+    }
+    fprintf(stderr, ",%s", algo_info.algo_type == ppl::kernel::x86::conv2d_int8_algo::DIRECT ? "direct" : "im2col_gemm");
+
+    ppl::nn::TensorShape src_shape;
+    src_shape.SetDataType(ppl::common::DATATYPE_FLOAT32);
+    src_shape.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+    src_shape.Reshape({c.batch, c.channels, c.src_h, c.src_w});
+
+    ppl::nn::TensorShape dst_shape;
+    dst_shape.SetDataType(ppl::common::DATATYPE_FLOAT32);
+    dst_shape.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+    dst_shape.Reshape({c.batch, c.num_output, dst_h, dst_w});
+
+    const int64_t flt_k = c.channels / c.group * c.kernel_h * c.kernel_w;
+    std::vector<float> src(src_shape.GetElementsIncludingPadding());
+    std::vector<float> filter(c.num_output * flt_k);
+    std::vector<float> bias(c.num_output);
+    std::vector<float> dst(dst_shape.GetElementsIncludingPadding(), 0.0f);
+    std::vector<float> dst_ref(dst_shape.GetElementsIncludingPadding(), 0.0f);
+    gen_src(src.data(), src.size());
+    gen_filter(filter.data(), c.num_output, flt_k);
+    gen_bias(bias.data(), bias.size());
+
+    auto mgr = ppl::kernel::x86::conv2d_int8_algo_selector::gen_algo(param, algo_info, allocator);
+    if (!mgr || ppl::common::RC_SUCCESS != mgr->gen_cvt_weights(filter.data(), bias.data())) {
+        std::cerr << ",gen_cvt_weights failed\n";
+        delete mgr;
+        return false;
+    }
+
+    auto exe = mgr->gen_executor();
+    exe->set_src_shape(&src_shape);
+    exe->set_dst_shape(&dst_shape);
+    bool ok = (ppl::common::RC_SUCCESS == exe->prepare());
+    void *temp_buffer = nullptr;
+    if (ok) {
+        temp_buffer = allocator->Alloc(exe->cal_temp_buffer_size());
+        exe->set_temp_buffer(temp_buffer);
+        exe->set_src(src.data());
+        exe->set_dst(dst.data());
+        ok = (temp_buffer && ppl::common::RC_SUCCESS == exe->execute());
+    }
+    if (!ok) {
+        std::cerr << ",execute failed\n";
+    }
+
+    if (ok) {
+        ppl::kernel::x86::conv2d_fp32_param ref_param;
+        ref_param.kernel_h   = c.kernel_h;
+        ref_param.kernel_w   = c.kernel_w;
+        ref_param.stride_h   = c.stride_h;
+        ref_param.stride_w   = c.stride_w;
+        ref_param.dilation_h = c.dilation_h;
+        ref_param.dilation_w = c.dilation_w;
+        ref_param.pad_h      = c.pad_h;
+        ref_param.pad_w      = c.pad_w;
+        ref_param.channels   = c.channels;
+        ref_param.num_output = c.num_output;
+        ref_param.group      = c.group;
+        ref_param.fuse_flag  = c.fuse_flag;
+        ppl::kernel::x86::conv2d_ref_fp32(
+            &src_shape, nullptr, &dst_shape, src.data(), nullptr, filter.data(), bias.data(), ref_param, dst_ref.data());
+
+        std::cerr << ",";
+        ok = check_array_error(dst.data(), dst_ref.data(), dst.size(), Flag_eps);
+        std::cerr << "\n";
+    }
+
+    allocator->Free(temp_buffer);
+    delete exe;
+    delete mgr;
+    return ok;
+}
+
+static bool test_fc_int8(const fc_int8_case &c, ppl::common::Allocator *allocator)
+{
+    ppl::kernel::x86::fc_int8_param param;
+    param.channels   = c.K;
+    param.num_output = c.N;
+    param.fuse_flag  = c.fuse_flag;
+    param.src_scale  = 1.0f;
+
+    fprintf(stderr, "fc,m%" PRId64 "n%" PRId64 "k%" PRId64 "_f%u", c.M, c.N, c.K, c.fuse_flag);
+
+    auto algo_info = ppl::kernel::x86::fc_int8_algo_selector::select_algo(
+        ppl::common::DATAFORMAT_NDARRAY, param, ppl::common::GetCpuISA());
+    if (algo_info.algo_type == ppl::kernel::x86::fc_int8_algo::UNKNOWN) {
+        std::cerr << ",unsupported case\n";
+        return false;
+    }
+
+    ppl::nn::TensorShape src_shape;
+    src_shape.SetDataType(ppl::common::DATATYPE_FLOAT32);
+    src_shape.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+    src_shape.Reshape({c.M, c.K});
+
+    ppl::nn::TensorShape dst_shape;
+    dst_shape.SetDataType(ppl::common::DATATYPE_FLOAT32);
+    dst_shape.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+    dst_shape.Reshape({c.M, c.N});
+
+    std::vector<float> src(c.M * c.K);
+    std::vector<float> filter(c.N * c.K);
+    std::vector<float> bias(c.N);
+    std::vector<float> dst(c.M * c.N, 0.0f);
+    std::vector<float> dst_ref(c.M * c.N, 0.0f);
+    gen_src(src.data(), src.size());
+    gen_filter(filter.data(), c.N, c.K);
+    gen_bias(bias.data(), bias.size());
+
+    auto mgr = ppl::kernel::x86::fc_int8_algo_selector::gen_algo(param, algo_info, allocator);
+    if (!mgr || ppl::common::RC_SUCCESS != mgr->gen_cvt_weights(filter.data(), bias.data())) {
+        std::cerr << ",gen_cvt_weights failed\n";
+        delete mgr;
+        return false;
+    }
+
+    auto exe = mgr->gen_executor();
+    exe->set_src_shape(&src_shape);
+    exe->set_dst_shape(&dst_shape);
+    bool ok = (ppl::common::RC_SUCCESS == exe->prepare());
+    void *temp_buffer = nullptr;
+    if (ok) {
+        temp_buffer = allocator->Alloc(exe->cal_temp_buffer_size());
+        exe->set_temp_buffer(temp_buffer);
+        exe->set_src(src.data());
+        exe->set_dst(dst.data());
+        ok = (temp_buffer && ppl::common::RC_SUCCESS == exe->execute());
+    }
+    if (!ok) {
+        std::cerr << ",execute failed\n";
+    }
+
+    if (ok) {
+        ppl::kernel::x86::gemm_ref_fp32(
+            src.data(), filter.data(), bias.data(), nullptr,
+            ppl::kernel::x86::gemm_m_type::NOTRANS,
+            ppl::kernel::x86::gemm_m_type::TRANS,
+            ppl::kernel::x86::gemm_v_type::ROW_VEC,
+            ppl::kernel::x86::gemm_m_type::EMPTY,
+            c.M, c.N, c.K, c.K, c.K, c.N, 0,
+            1.0f, 1.0f,
+            (c.fuse_flag & ppl::kernel::x86::fc_fuse_flag::RELU) ? ppl::kernel::x86::gemm_post::RELU : ppl::kernel::x86::gemm_post::NONE,
+            dst_ref.data());
+
+        std::cerr << ",";
+        ok = check_array_error(dst.data(), dst_ref.data(), dst.size(), Flag_eps);
+        std::cerr << "\n";
+    }
+
+    allocator->Free(temp_buffer);
+    delete exe;
+    delete mgr;
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    simple_flags::parse_args(argc, argv);
+    if (Flag_help) {
+        simple_flags::print_args_info();
+        return 0;
+    }
+
+    // int8 kernels need avx512 vnni, which is detected by the algo selectors
+    ppl::kernel::x86::fc_int8_param probe_param;
+    probe_param.channels   = 4;
+    probe_param.num_output = 4;
+    probe_param.fuse_flag  = 0;
+    probe_param.src_scale  = 1.0f;
+    auto probe = ppl::kernel::x86::fc_int8_algo_selector::select_algo(
+        ppl::common::DATAFORMAT_NDARRAY, probe_param, ppl::common::GetCpuISA());
+    if (probe.algo_type == ppl::kernel::x86::fc_int8_algo::UNKNOWN) {
+        std::cerr << "int8 kernels are not supported on this cpu, skipped\n";
+        return 0;
+    }
+
+    ppl::common::GenericCpuAllocator allocator(PPL_X86_CACHELINE_BYTES());
+
+    int32_t failed = 0;
+    for (uint32_t i = 0; i < sizeof(conv2d_cases) / sizeof(conv2d_cases[0]); ++i) {
+        if (!test_conv2d_int8(conv2d_cases[i], &allocator)) {
+            ++failed;
+        }
+    }
+    for (uint32_t i = 0; i < sizeof(fc_cases) / sizeof(fc_cases[0]); ++i) {
+        if (!test_fc_int8(fc_cases[i], &allocator)) {
+            ++failed;
+        }
+    }
+
+    fprintf(stderr, "%d case(s) failed\n", failed);
+    return failed ? -1 : 0;
+}
@@ -26,6 +26,11 @@ using namespace ppl::common;
 namespace ppl { namespace nn { namespace x86 {
 
 RetCode X86Kernel::BeforeExecute(KernelExecContext* ctx) {
+    // outputs are created with shapes inferred in the last run
+    if (ctx->CanSkipReshape()) {
+        return RC_SUCCESS;
+    }
+
     auto status = Reshape(ctx);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "reshape kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
@@ -35,6 +40,14 @@ RetCode X86Kernel::BeforeExecute(KernelExecContext* ctx) {
     return RC_SUCCESS;
 }
 
+RetCode X86Kernel::AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) {
+    auto status = GetX86Device()->AllocTmpBuffer(bytes, buffer);
+    if (status == RC_SUCCESS && bytes > max_tmp_buffer_bytes_) {
+        max_tmp_buffer_bytes_ = bytes;
+    }
+    return status;
+}
+
 bool X86Kernel::CanDoExecute(const KernelExecContext& ctx) const {
     for (uint32_t i = 0; i < ctx.GetInputCount(); ++i) {
         auto tensor = ctx.GetInput<TensorImpl>(i);
@@ -50,6 +63,11 @@ RetCode X86Kernel::Execute(KernelExecContext* ctx) {
     utils::CpuTimingGuard __timing_guard__(&begin_ts_, &end_ts_, ctx->IsProfilingEnabled());
 #endif
 
+    auto thread_config = GetX86Device()->GetThreadConfig();
+    if (thread_config) {
+        ApplyThreadConfig(*thread_config);
+    }
+
     auto status = BeforeExecute(ctx);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "BeforeExecute() of kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
@@ -50,6 +50,10 @@ public:
         common_param_ = p;
     }
 
+    uint64_t GetMaxTmpBufferBytes() const override {
+        return max_tmp_buffer_bytes_;
+    }
+
 protected:
     virtual bool CanDoExecute(const KernelExecContext&) const;
 
@@ -58,6 +62,9 @@ protected:
         return 0;
     }
 
+    /** @brief allocates a tmp buffer from the device and records its size for memory statistics */
+    ppl::common::RetCode AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer);
+
     bool MayUseISA(uint32_t flag) const {
         return !!(GetX86Device()->GetISA() & flag);
     }
@@ -89,6 +96,7 @@ private:
 
 private:
     const X86CommonParam* common_param_ = nullptr;
+    uint64_t max_tmp_buffer_bytes_ = 0;
     std::function<ppl::common::RetCode(InputOutputInfo*)> reshape_func_;
 };
 
@@ -42,7 +42,19 @@ ppl::common::RetCode MMCVNonMaxSuppressionKernel::DoExecute(KernelExecContext* c
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(output);
 
     int64_t real_num_boxes_output = 0;
-    auto ret = kernel::x86::mmcv_nms_ndarray_fp32(
+    auto nms_func = kernel::x86::mmcv_nms_ndarray_fp32;
+    if (false) {
+    }
+#ifdef PPL_USE_X86_AVX512
+    else if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
+        nms_func = kernel::x86::mmcv_nms_ndarray_fp32_avx512;
+    }
+#endif
+    else if (MayUseISA(ppl::common::ISA_X86_FMA)) {
+        nms_func = kernel::x86::mmcv_nms_ndarray_fp32_fma;
+    }
+
+    auto ret = nms_func(
         boxes->GetBufferPtr<const float>(), scores->GetBufferPtr<const float>(), boxes->GetShape()->GetDim(0),
         param_->iou_threshold, param_->offset, output->GetBufferPtr<int64_t>(), &real_num_boxes_output);
     if (ret != ppl::common::RC_SUCCESS) {
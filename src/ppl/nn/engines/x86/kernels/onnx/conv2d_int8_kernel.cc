@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/onnx/conv2d_int8_kernel.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+uint64_t Conv2dInt8Kernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
+    return executor_->cal_temp_buffer_size();
+}
+
+ppl::common::RetCode Conv2dInt8Kernel::DoExecute(KernelExecContext* ctx) {
+    PPLNN_X86_REQUIRED_INPUT(X, 0);
+    PPLNN_X86_REQUIRED_OUTPUT(Y, 0);
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+    PPLNN_X86_DEBUG_TRACE("Input [X]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(X);
+
+    PPLNN_X86_DEBUG_TRACE("kernel_shape: %ld %ld\n", executor_->conv_param()->kernel_h,
+                          executor_->conv_param()->kernel_w);
+    PPLNN_X86_DEBUG_TRACE("dilations: %ld %ld\n", executor_->conv_param()->dilation_h,
+                          executor_->conv_param()->dilation_w);
+    PPLNN_X86_DEBUG_TRACE("strides: %ld %ld\n", executor_->conv_param()->stride_h,
+                          executor_->conv_param()->stride_w);
+    PPLNN_X86_DEBUG_TRACE("pads: %ld %ld\n", executor_->conv_param()->pad_h, executor_->conv_param()->pad_w);
+    PPLNN_X86_DEBUG_TRACE("group: %ld\n", executor_->conv_param()->group);
+    PPLNN_X86_DEBUG_TRACE("channels: %ld\n", executor_->conv_param()->channels);
+    PPLNN_X86_DEBUG_TRACE("num_output: %ld\n", executor_->conv_param()->num_output);
+    PPLNN_X86_DEBUG_TRACE("fuse_flag: %ld\n", executor_->conv_param()->fuse_flag);
+    PPLNN_X86_DEBUG_TRACE("src_scale: %f\n", executor_->conv_param()->src_scale);
+    PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+
+    executor_->set_src_shape(X->GetShape());
+    executor_->set_dst_shape(Y->GetShape());
+
+    ppl::common::RetCode rc;
+    rc = executor_->prepare();
+    if (ppl::common::RC_SUCCESS != rc) {
+        LOG(ERROR) << "Prepare failed: " << ppl::common::GetRetCodeStr(rc);
+        return rc;
+    }
+
+    PPLNN_X86_REALLOC_TENSOR_BUFFER(Y);
+    PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
+
+    BufferDesc tmp_buffer_desc;
+    auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
+    rc = AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    if (rc != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
+                   << "] failed: " << ppl::common::GetRetCodeStr(rc);
+        return rc;
+    }
+    BufferDescGuard __tmp_buffer_guard(&tmp_buffer_desc, [this](BufferDesc* buffer) -> void {
+        GetX86Device()->FreeTmpBuffer(buffer);
+    });
+    auto tmp_buffer = tmp_buffer_desc.addr;
+    PPLNN_X86_DEBUG_TRACE("buffer: %p\n", tmp_buffer);
+
+    executor_->set_temp_buffer(tmp_buffer);
+    executor_->set_src(X->GetBufferPtr<float>());
+    executor_->set_dst(Y->GetBufferPtr<float>());
+
+    rc = executor_->execute();
+    if (ppl::common::RC_SUCCESS != rc) {
+        LOG(ERROR) << "Execute failed: " << ppl::common::GetRetCodeStr(rc);
+        return rc;
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::x86
@@ -93,8 +93,33 @@ ppl::common::RetCode Conv2dKernel::DoExecute(KernelExecContext* ctx) {
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
 
     BufferDesc tmp_buffer_desc;
-    auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
-    auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    auto tmp_buffer_size = cur_executor->cal_temp_buffer_size();
+    auto status = AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    // memory budget of the device is exceeded, retries with less tmp memory at the cost of performance
+    while (status == ppl::common::RC_OUT_OF_MEMORY) {
+        if (cur_executor->reduce_temp_buffer()) {
+            LOG(DEBUG) << "kernel[" << GetName() << "] reduces tmp buffer size[" << tmp_buffer_size << "]";
+        } else if (fallback_executor_ && cur_executor != fallback_executor_) {
+            LOG(DEBUG) << "kernel[" << GetName() << "] uses fallback algorithm instead of tmp buffer size["
+                       << tmp_buffer_size << "]";
+            cur_executor = fallback_executor_;
+            cur_executor->set_src_shape(X->GetShape());
+            cur_executor->set_dst_shape(Y->GetShape());
+            if (sum_src) {
+                cur_executor->set_sum_src_shape(sum_src->GetShape());
+            }
+            rc = cur_executor->prepare();
+            if (ppl::common::RC_SUCCESS != rc) {
+                LOG(ERROR) << "Prepare failed: " << ppl::common::GetRetCodeStr(rc);
+                return rc;
+            }
+        } else {
+            break;
+        }
+
+        tmp_buffer_size = cur_executor->cal_temp_buffer_size();
+        status = AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    }
     if (status != ppl::common::RC_SUCCESS) {
         LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
                    << "] failed: " << ppl::common::GetRetCodeStr(status);
@@ -122,4 +147,36 @@ ppl::common::RetCode Conv2dKernel::DoExecute(KernelExecContext* ctx) {
     return ppl::common::RC_SUCCESS;
 }
 
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+static const char* GetConv2dAlgoStr(ppl::kernel::x86::conv2d_fp32_algo_t algo) {
+    switch (algo) {
+        case ppl::kernel::x86::conv2d_fp32_algo::IMPLICIT_GEMM: return "implicit_gemm";
+        case ppl::kernel::x86::conv2d_fp32_algo::GEMM_DIRECT: return "gemm_direct";
+        case ppl::kernel::x86::conv2d_fp32_algo::DEPTHWISE: return "depthwise";
+        case ppl::kernel::x86::conv2d_fp32_algo::IM2COL_GEMM: return "im2col_gemm";
+        case ppl::kernel::x86::conv2d_fp32_algo::DIRECT: return "direct";
+        case ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B2F3: return "winograd_b2f3";
+        case ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3: return "winograd_b4f3";
+        case ppl::kernel::x86::conv2d_fp32_algo::GEMM_DIRECT_V2: return "gemm_direct_v2";
+        case ppl::kernel::x86::conv2d_fp32_algo::DIRECT_V2: return "direct_v2";
+        default: return "unknown";
+    }
+}
+
+std::string Conv2dKernel::GetAlgorithmInfo() const {
+    if (use_fallback_) {
+        return "fallback";
+    }
+    return std::string(GetConv2dAlgoStr(param_->algo_info.algo_type)) + "_" +
+        ppl::common::GetDataFormatStr(param_->algo_info.input_format) + "_" +
+        ppl::common::GetDataFormatStr(param_->algo_info.output_format);
+}
+
+uint64_t Conv2dKernel::CalcFlops(const KernelExecContext& ctx) const {
+    auto& param = param_->param;
+    const uint64_t macs_per_output = (param.channels / param.group) * param.kernel_h * param.kernel_w;
+    return 2 * macs_per_output * ctx.GetOutput<TensorImpl>(0)->GetShape()->GetElementsExcludingPadding();
+}
+#endif
+
 }}} // namespace ppl::nn::x86
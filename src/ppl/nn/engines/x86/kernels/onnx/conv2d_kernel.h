@@ -50,6 +50,12 @@ private:
     uint64_t CalcTmpBufferSize(const KernelExecContext& ctx) const override;
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
 
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+public:
+    std::string GetAlgorithmInfo() const override;
+    uint64_t CalcFlops(const KernelExecContext&) const override;
+#endif
+
 private:
     const Conv2dParam* param_ = nullptr;
     ppl::kernel::x86::conv2d_fp32_executor* executor_ = nullptr;
@@ -82,6 +82,7 @@ ppl::common::RetCode GemmKernel::DoExecute(KernelExecContext* ctx) {
     param.trans_A = param_->transA;
     param.trans_B = param_->transB;
     param.isa_flag = GetISA();
+    param.compute_type = forward_precision_;
 
     if (gemm_fuse_relu_) {
         param.fuse_flag = ppl::kernel::x86::gemm_v2_fuse_flag::RELU;
@@ -119,7 +120,7 @@ ppl::common::RetCode GemmKernel::DoExecute(KernelExecContext* ctx) {
 
     BufferDesc tmp_buffer_desc;
     uint64_t tmp_buffer_size = executor->get_buffer_bytes();
-    auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    auto status = AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
     if (status != ppl::common::RC_SUCCESS) {
         LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
                    << "] failed: " << ppl::common::GetRetCodeStr(status);
@@ -136,4 +137,12 @@ ppl::common::RetCode GemmKernel::DoExecute(KernelExecContext* ctx) {
     return executor->execute();
 }
 
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+uint64_t GemmKernel::CalcFlops(const KernelExecContext& ctx) const {
+    auto A = ctx.GetInput<TensorImpl>(0)->GetShape();
+    const uint64_t K = A->GetDim(param_->transA ? 0 : 1);
+    return 2 * K * ctx.GetOutput<TensorImpl>(0)->GetShape()->GetElementsExcludingPadding();
+}
+#endif
+
 }}} // namespace ppl::nn::x86
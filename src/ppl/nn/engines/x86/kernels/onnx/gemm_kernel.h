@@ -33,13 +33,22 @@ public:
     void SetFuseReLU(bool fuse_relu) {
         gemm_fuse_relu_ = fuse_relu;
     }
+    void SetForwardPrecision(ppl::common::datatype_t forward_precision) {
+        forward_precision_ = forward_precision;
+    }
 
 private:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
 
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+public:
+    uint64_t CalcFlops(const KernelExecContext&) const override;
+#endif
+
 private:
     const ppl::nn::common::GemmParam* param_ = nullptr;
     bool gemm_fuse_relu_ = false;
+    ppl::common::datatype_t forward_precision_ = ppl::common::DATATYPE_FLOAT32;
 };
 
 }}} // namespace ppl::nn::x86
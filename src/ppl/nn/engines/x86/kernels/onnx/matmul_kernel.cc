@@ -38,6 +38,7 @@ ppl::common::RetCode MatMulKernel::DoExecute(KernelExecContext* ctx) {
     PPLNN_X86_DEBUG_TRACE("Input [B]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(B);
 
+    PPLNN_X86_DEBUG_TRACE("packed B: %p\n", param_ ? param_->packed_b : nullptr);
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
     PPLNN_X86_REALLOC_TENSOR_BUFFER(Y);
@@ -46,7 +47,7 @@ ppl::common::RetCode MatMulKernel::DoExecute(KernelExecContext* ctx) {
 
     BufferDesc tmp_buffer_desc;
     auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
-    auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    auto status = AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
     if (status != ppl::common::RC_SUCCESS) {
         LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
                    << "] failed: " << ppl::common::GetRetCodeStr(status);
@@ -62,6 +63,11 @@ ppl::common::RetCode MatMulKernel::DoExecute(KernelExecContext* ctx) {
     const auto data_format = A->GetShape()->GetDataFormat();
 
     if (data_type == ppl::common::DATATYPE_FLOAT32 && data_format == ppl::common::DATAFORMAT_NDARRAY) {
+        if (param_ && param_->packed_b) {
+            return kernel::x86::matmul_ndarray_fp32_with_packed_b(A->GetShape(), B->GetShape(), Y->GetShape(),
+                                                                  A->GetBufferPtr<float>(), param_->packed_b, GetISA(),
+                                                                  tmp_buffer, Y->GetBufferPtr<float>());
+        }
         return kernel::x86::matmul_ndarray_fp32(A->GetShape(), B->GetShape(), Y->GetShape(),
                                                 A->GetBufferPtr<float>(), B->GetBufferPtr<float>(), GetISA(),
                                                 tmp_buffer, Y->GetBufferPtr<float>());
@@ -72,4 +78,12 @@ ppl::common::RetCode MatMulKernel::DoExecute(KernelExecContext* ctx) {
     return ppl::common::RC_UNSUPPORTED;
 }
 
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+uint64_t MatMulKernel::CalcFlops(const KernelExecContext& ctx) const {
+    auto A = ctx.GetInput<TensorImpl>(0)->GetShape();
+    const uint64_t K = A->GetDim(A->GetDimCount() - 1);
+    return 2 * K * ctx.GetOutput<TensorImpl>(0)->GetShape()->GetElementsExcludingPadding();
+}
+#endif
+
 }}} // namespace ppl::nn::x86
@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_ONNX_MATMUL_KERNEL_H_
 
 #include "ppl/nn/engines/x86/kernel.h"
+#include "ppl/nn/engines/x86/params/matmul_param.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -26,9 +27,21 @@ class MatMulKernel : public X86Kernel {
 public:
     MatMulKernel(const ir::Node* node) : X86Kernel(node) {}
 
+    void SetParam(const MatMulParam* p) {
+        param_ = p;
+    }
+
 private:
     uint64_t CalcTmpBufferSize(const KernelExecContext&) const override;
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+public:
+    uint64_t CalcFlops(const KernelExecContext&) const override;
+#endif
+
+private:
+    const MatMulParam* param_ = nullptr;
 };
 
 }}} // namespace ppl::nn::x86
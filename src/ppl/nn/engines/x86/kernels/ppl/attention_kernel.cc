@@ -0,0 +1,114 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/ppl/attention_kernel.h"
+#include "ppl/nn/common/logger.h"
+
+#include "ppl/kernel/x86/fp32/attention.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+uint64_t AttentionKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
+    auto Q = ctx.GetInput<TensorImpl>(0);
+    auto K = ctx.GetInput<TensorImpl>(1);
+    return ppl::kernel::x86::attention_fp32_get_buffer_bytes(Q->GetShape(), K->GetShape());
+}
+
+ppl::common::RetCode AttentionKernel::DoExecute(KernelExecContext* ctx) {
+    PPLNN_X86_REQUIRED_INPUT(Q, 0);
+    PPLNN_X86_REQUIRED_INPUT(K, 1);
+    PPLNN_X86_REQUIRED_INPUT(V, 2);
+    PPLNN_X86_OPTIONAL_INPUT(mask, 3);
+    PPLNN_X86_REQUIRED_OUTPUT(Y, 0);
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+
+    PPLNN_X86_DEBUG_TRACE("Input [Q]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(Q);
+    PPLNN_X86_DEBUG_TRACE("Input [K]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(K);
+    PPLNN_X86_DEBUG_TRACE("Input [V]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(V);
+
+    const TensorShape* mask_shape = nullptr;
+    const float* mask_data = nullptr;
+    if (mask) {
+        PPLNN_X86_DEBUG_TRACE("Input [mask]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(mask);
+        mask_shape = mask->GetShape();
+        mask_data = mask->GetBufferPtr<const float>();
+    }
+
+    PPLNN_X86_DEBUG_TRACE("scale: %f\n", param_->scale);
+    PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+
+    if (!ppl::kernel::x86::attention_fp32_check_shapes(Q->GetShape(), K->GetShape(), V->GetShape(), mask_shape)) {
+        LOG(ERROR) << "input shapes of Attention[" << GetName() << "] mismatch.";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    PPLNN_X86_REALLOC_TENSOR_BUFFER(Y);
+    PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
+
+    BufferDesc tmp_buffer_desc;
+    auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
+    auto status = AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    if (status != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
+                   << "] failed: " << ppl::common::GetRetCodeStr(status);
+        return status;
+    }
+    BufferDescGuard __tmp_buffer_guard(&tmp_buffer_desc, [this](BufferDesc* buffer) -> void {
+        GetX86Device()->FreeTmpBuffer(buffer);
+    });
+    auto tmp_buffer = tmp_buffer_desc.addr;
+    PPLNN_X86_DEBUG_TRACE("buffer: %p\n", tmp_buffer);
+
+    const auto data_type = Q->GetShape()->GetDataType();
+    const auto data_format = Q->GetShape()->GetDataFormat();
+
+    if (data_type == ppl::common::DATATYPE_FLOAT32 && data_format == ppl::common::DATAFORMAT_NDARRAY) {
+        if (false) {
+        }
+#ifdef PPL_USE_X86_AVX512
+        else if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
+            return ppl::kernel::x86::attention_fp32_avx512(
+                Q->GetShape(), K->GetShape(), V->GetShape(), mask_shape,
+                Q->GetBufferPtr<const float>(), K->GetBufferPtr<const float>(), V->GetBufferPtr<const float>(),
+                mask_data, param_->scale, tmp_buffer, Y->GetBufferPtr<float>());
+        }
+#endif
+        else if (MayUseISA(ppl::common::ISA_X86_FMA)) {
+            return ppl::kernel::x86::attention_fp32_fma(
+                Q->GetShape(), K->GetShape(), V->GetShape(), mask_shape,
+                Q->GetBufferPtr<const float>(), K->GetBufferPtr<const float>(), V->GetBufferPtr<const float>(),
+                mask_data, param_->scale, tmp_buffer, Y->GetBufferPtr<float>());
+        } else {
+            return ppl::kernel::x86::attention_fp32(
+                Q->GetShape(), K->GetShape(), V->GetShape(), mask_shape,
+                Q->GetBufferPtr<const float>(), K->GetBufferPtr<const float>(), V->GetBufferPtr<const float>(),
+                mask_data, param_->scale, tmp_buffer, Y->GetBufferPtr<float>());
+        }
+    } else {
+        LOG(ERROR) << "only support fp32 ndarray now.";
+    }
+
+    return ppl::common::RC_UNSUPPORTED;
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,97 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/ppl/eltwise_chain_kernel.h"
+#include "ppl/nn/common/logger.h"
+
+#include "ppl/kernel/x86/fp32/eltwise_chain.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+uint64_t EltwiseChainKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
+    return ppl::kernel::x86::eltwise_chain_fp32_get_buffer_bytes(param_->ops.data(), param_->ops.size());
+}
+
+ppl::common::RetCode EltwiseChainKernel::DoExecute(KernelExecContext* ctx) {
+    PPLNN_X86_REQUIRED_OUTPUT(output, 0);
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+
+    for (uint32_t i = 0; i < ctx->GetInputCount(); ++i) {
+        auto input = ctx->GetInput<TensorImpl>(i);
+        if (!input) {
+            LOG(ERROR) << "input #" << i << " of [" << GetName() << "] is empty.";
+            return ppl::common::RC_NOT_FOUND;
+        }
+        if (input->GetShape()->GetDataType() != ppl::common::DATATYPE_FLOAT32) {
+            LOG(ERROR) << "only support fp32 now.";
+            return ppl::common::RC_UNSUPPORTED;
+        }
+        PPLNN_X86_DEBUG_TRACE("Input [inputs[%u]]:\n", i);
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(input);
+    }
+
+    PPLNN_X86_DEBUG_TRACE("ops: %lu\n", param_->ops.size());
+    PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+
+    PPLNN_X86_REALLOC_TENSOR_BUFFER(output);
+    PPLNN_X86_DEBUG_TRACE("Output [output]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(output);
+
+    std::vector<ppl::kernel::x86::eltwise_chain_src> srcs(ctx->GetInputCount());
+    for (uint32_t i = 0; i < ctx->GetInputCount(); ++i) {
+        auto input = ctx->GetInput<TensorImpl>(i);
+        if (!ppl::kernel::x86::eltwise_chain_init_src(input->GetShape(), output->GetShape(),
+                                                      input->GetBufferPtr<const float>(), &srcs[i])) {
+            LOG(ERROR) << "input #" << i << " of [" << GetName() << "] can not be broadcasted to output.";
+            return ppl::common::RC_UNSUPPORTED;
+        }
+    }
+
+    BufferDesc tmp_buffer_desc;
+    auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
+    auto status = AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    if (status != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
+                   << "] failed: " << ppl::common::GetRetCodeStr(status);
+        return status;
+    }
+    BufferDescGuard __tmp_buffer_guard(&tmp_buffer_desc, [this](BufferDesc* buffer) -> void {
+        GetX86Device()->FreeTmpBuffer(buffer);
+    });
+    auto tmp_buffer = tmp_buffer_desc.addr;
+    PPLNN_X86_DEBUG_TRACE("buffer: %p\n", tmp_buffer);
+
+    if (false) {
+    }
+#ifdef PPL_USE_X86_AVX512
+    else if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
+        return ppl::kernel::x86::eltwise_chain_fp32_avx512(output->GetShape(), srcs.data(), param_->ops.data(),
+                                                           param_->ops.size(), tmp_buffer,
+                                                           output->GetBufferPtr<float>());
+    }
+#endif
+    else if (MayUseISA(ppl::common::ISA_X86_FMA)) {
+        return ppl::kernel::x86::eltwise_chain_fp32_fma(output->GetShape(), srcs.data(), param_->ops.data(),
+                                                        param_->ops.size(), tmp_buffer, output->GetBufferPtr<float>());
+    } else {
+        return ppl::kernel::x86::eltwise_chain_fp32(output->GetShape(), srcs.data(), param_->ops.data(),
+                                                    param_->ops.size(), tmp_buffer, output->GetBufferPtr<float>());
+    }
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,105 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/ppl/layer_norm_kernel.h"
+#include "ppl/nn/common/logger.h"
+
+#include "ppl/kernel/x86/fp32/layer_norm.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+ppl::common::RetCode LayerNormKernel::DoExecute(KernelExecContext* ctx) {
+    PPLNN_X86_REQUIRED_INPUT(input, 0);
+    PPLNN_X86_OPTIONAL_INPUT(scale, 1);
+    PPLNN_X86_OPTIONAL_INPUT(shift, 2);
+    PPLNN_X86_REQUIRED_OUTPUT(output, 0);
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+
+    PPLNN_X86_DEBUG_TRACE("Input [input]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(input);
+
+    const int32_t dim_count = input->GetShape()->GetDimCount();
+    const int32_t axis = param_->axis < 0 ? param_->axis + dim_count : param_->axis;
+    if (axis < 0 || axis >= dim_count) {
+        LOG(ERROR) << "invalid axis[" << param_->axis << "] for input of dim count[" << dim_count << "].";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    uint64_t norm_size = 1;
+    for (int32_t i = axis; i < dim_count; ++i) {
+        norm_size *= input->GetShape()->GetDim(i);
+    }
+
+    const float* scale_data = nullptr;
+    const float* shift_data = nullptr;
+    if (scale) {
+        PPLNN_X86_DEBUG_TRACE("Input [scale]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(scale);
+        if (scale->GetShape()->GetElementsExcludingPadding() != norm_size) {
+            LOG(ERROR) << "scale must have the same number of elements as the normalized dims.";
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        scale_data = scale->GetBufferPtr<const float>();
+    }
+    if (shift) {
+        PPLNN_X86_DEBUG_TRACE("Input [shift]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(shift);
+        if (shift->GetShape()->GetElementsExcludingPadding() != norm_size) {
+            LOG(ERROR) << "shift must have the same number of elements as the normalized dims.";
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        shift_data = shift->GetBufferPtr<const float>();
+    }
+
+    PPLNN_X86_DEBUG_TRACE("axis: %d\n", param_->axis);
+    PPLNN_X86_DEBUG_TRACE("epsilon: %f\n", param_->epsilon);
+    PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+
+    PPLNN_X86_REALLOC_TENSOR_BUFFER(output);
+    PPLNN_X86_DEBUG_TRACE("Output [output]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(output);
+
+    const auto data_type = input->GetShape()->GetDataType();
+    const auto data_format = input->GetShape()->GetDataFormat();
+
+    if (data_type == ppl::common::DATATYPE_FLOAT32 && data_format == ppl::common::DATAFORMAT_NDARRAY) {
+        if (false) {
+        }
+#ifdef PPL_USE_X86_AVX512
+        else if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
+            return ppl::kernel::x86::layer_norm_fp32_avx512(input->GetShape(), input->GetBufferPtr<const float>(),
+                                                            scale_data, shift_data, axis, param_->epsilon,
+                                                            output->GetBufferPtr<float>());
+        }
+#endif
+        else if (MayUseISA(ppl::common::ISA_X86_FMA)) {
+            return ppl::kernel::x86::layer_norm_fp32_fma(input->GetShape(), input->GetBufferPtr<const float>(),
+                                                         scale_data, shift_data, axis, param_->epsilon,
+                                                         output->GetBufferPtr<float>());
+        } else {
+            return ppl::kernel::x86::layer_norm_fp32(input->GetShape(), input->GetBufferPtr<const float>(),
+                                                     scale_data, shift_data, axis, param_->epsilon,
+                                                     output->GetBufferPtr<float>());
+        }
+    } else {
+        LOG(ERROR) << "only support fp32 ndarray now.";
+    }
+
+    return ppl::common::RC_UNSUPPORTED;
+}
+
+}}} // namespace ppl::nn::x86
@@ -56,7 +56,7 @@ ppl::common::RetCode PostDepthwiseConv2dKernel::SeparateExecute(KernelExecContex
     {
         BufferDesc conv_tmp_buffer_desc;
         auto conv_tmp_buffer_size = executor_->conv2d_executor()->cal_temp_buffer_size();
-        auto status = GetX86Device()->AllocTmpBuffer(conv_tmp_buffer_size, &conv_tmp_buffer_desc);
+        auto status = AllocTmpBuffer(conv_tmp_buffer_size, &conv_tmp_buffer_desc);
         if (status != ppl::common::RC_SUCCESS) {
             LOG(ERROR) << "alloc conv tmp buffer size[" << conv_tmp_buffer_size << "] for kernel[" << GetName()
                     << "] failed: " << ppl::common::GetRetCodeStr(status);
@@ -91,7 +91,7 @@ ppl::common::RetCode PostDepthwiseConv2dKernel::SeparateExecute(KernelExecContex
 
         BufferDesc depthwise_conv_tmp_buffer_desc;
         auto depthwise_conv_tmp_buffer_size = executor_->depthwise_conv2d_executor()->cal_temp_buffer_size();
-        auto status = GetX86Device()->AllocTmpBuffer(depthwise_conv_tmp_buffer_size, &depthwise_conv_tmp_buffer_desc);
+        auto status = AllocTmpBuffer(depthwise_conv_tmp_buffer_size, &depthwise_conv_tmp_buffer_desc);
         if (status != ppl::common::RC_SUCCESS) {
             LOG(ERROR) << "alloc depthwise conv tmp buffer size[" << depthwise_conv_tmp_buffer_size << "] for kernel[" << GetName()
                     << "] failed: " << ppl::common::GetRetCodeStr(status);
@@ -124,7 +124,7 @@ ppl::common::RetCode PostDepthwiseConv2dKernel::FuseExecute(KernelExecContext* c
 
     BufferDesc tmp_buffer_desc;
     auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
-    auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    auto status = AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
     if (status != ppl::common::RC_SUCCESS) {
         LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
                    << "] failed: " << ppl::common::GetRetCodeStr(status);
@@ -0,0 +1,76 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/numa_allocator.h"
+#include "ppl/nn/common/logger.h"
+
+#if defined(__linux__) && defined(PPLNN_USE_NUMA)
+#include <numa.h>
+#include <numaif.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#endif
+
+namespace ppl { namespace nn { namespace x86 {
+
+#if defined(__linux__) && defined(PPLNN_USE_NUMA)
+NumaAllocator::NumaAllocator(ppl::common::Allocator* allocator, int32_t numa_node_id)
+    : allocator_(allocator), nodemask_(nullptr), page_size_(sysconf(_SC_PAGESIZE)) {
+    if (numa_available() >= 0 && numa_node_id >= 0 && numa_node_id <= numa_max_node()) {
+        nodemask_ = numa_allocate_nodemask();
+        if (nodemask_) {
+            numa_bitmask_setbit(nodemask_, numa_node_id);
+        }
+    }
+}
+
+NumaAllocator::~NumaAllocator() {
+    if (nodemask_) {
+        numa_free_nodemask(nodemask_);
+    }
+}
+
+void* NumaAllocator::Alloc(uint64_t bytes) {
+    auto ptr = allocator_->Alloc(bytes);
+    if (!ptr || !nodemask_) {
+        return ptr;
+    }
+
+    auto begin = ((uintptr_t)ptr + page_size_ - 1) & ~(uintptr_t)(page_size_ - 1);
+    auto end = ((uintptr_t)ptr + bytes) & ~(uintptr_t)(page_size_ - 1);
+    if (end > begin) {
+        // MPOL_PREFERRED falls back to other nodes instead of failing when the node is out of memory
+        if (mbind((void*)begin, end - begin, MPOL_PREFERRED, nodemask_->maskp, nodemask_->size + 1, MPOL_MF_MOVE) !=
+            0) {
+            LOG(DEBUG) << "mbind [" << end - begin << "] bytes failed: " << strerror(errno);
+        }
+    }
+    return ptr;
+}
+#else
+NumaAllocator::NumaAllocator(ppl::common::Allocator* allocator, int32_t)
+    : allocator_(allocator), nodemask_(nullptr), page_size_(0) {}
+
+NumaAllocator::~NumaAllocator() {}
+
+void* NumaAllocator::Alloc(uint64_t bytes) {
+    return allocator_->Alloc(bytes);
+}
+#endif
+
+}}} // namespace ppl::nn::x86
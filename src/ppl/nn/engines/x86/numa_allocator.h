@@ -0,0 +1,54 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_NUMA_ALLOCATOR_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_NUMA_ALLOCATOR_H_
+
+#include "ppl/common/allocator.h"
+
+struct bitmask;
+
+namespace ppl { namespace nn { namespace x86 {
+
+/**
+   @brief places memory allocated by another allocator on a numa node.
+   @note only whole pages inside each block are moved. it does nothing if NUMA is not supported in current build.
+*/
+class NumaAllocator final : public ppl::common::Allocator {
+public:
+    /** @param allocator is not owned by this allocator and should outlive it */
+    NumaAllocator(ppl::common::Allocator* allocator, int32_t numa_node_id);
+    ~NumaAllocator();
+
+    void* Alloc(uint64_t bytes) override;
+    void Free(void* ptr) override {
+        allocator_->Free(ptr);
+    }
+
+private:
+    ppl::common::Allocator* allocator_;
+    struct bitmask* nodemask_;
+    uint64_t page_size_;
+
+private:
+    NumaAllocator(const NumaAllocator&) = delete;
+    NumaAllocator& operator=(const NumaAllocator&) = delete;
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
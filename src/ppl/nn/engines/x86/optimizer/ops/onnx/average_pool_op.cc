@@ -19,6 +19,11 @@
 #include "ppl/nn/engines/x86/kernels/onnx/averagepool_kernel.h"
 #include "ppl/nn/oputils/onnx/reshape_pooling.h"
 #include "ppl/nn/common/logger.h"
+
+#ifdef PPLNN_ENABLE_PMX_MODEL
+#include "ppl/nn/models/pmx/oputils/onnx/pooling.h"
+#endif
+
 using namespace std;
 using namespace ppl::common;
 
@@ -31,13 +36,17 @@ RetCode AveragePoolOp::Init(const OptKernelOptions& options) {
         return status;
     }
 
+    SetInferFuncs();
+
+    return RC_SUCCESS;
+}
+
+void AveragePoolOp::SetInferFuncs() {
     infer_dims_func_ = [this](InputOutputInfo* info) -> RetCode {
         return oputils::ReshapePooling(info, param_.get());
     };
 
     infer_type_func_ = GenericInferType;
-
-    return RC_SUCCESS;
 }
 
 RetCode AveragePoolOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* selected_input_formats,
@@ -53,4 +62,43 @@ KernelImpl* AveragePoolOp::CreateKernelImpl() const {
     return CreateKernelImplWithParam<AveragePoolKernel>(param_.get());
 }
 
+#ifdef PPLNN_ENABLE_PMX_MODEL
+RetCode AveragePoolOp::SerializeData(const pmx::SerializationContext&, utils::DataStream* ds) const {
+    PmxDataWriter writer;
+    SerializeCommonParam(&writer);
+
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_param = pmx::onnx::SerializePoolingParam(*param_, &builder);
+    auto fb_data = builder.CreateVector(writer.GetData());
+    auto fb_op_param =
+        pmx::onnx::CreateOpParam(builder, pmx::onnx::OpParamType_PoolingParam, fb_param.Union(), fb_data);
+    pmx::onnx::FinishOpParamBuffer(builder, fb_op_param);
+    return ds->Write(builder.GetBufferPointer(), builder.GetSize());
+}
+
+RetCode AveragePoolOp::DeserializeData(const pmx::DeserializationContext&, const void* base, uint64_t size) {
+    auto node = GetNode();
+
+    flatbuffers::Verifier verifier((const uint8_t*)base, size);
+    if (!pmx::onnx::VerifyOpParamBuffer(verifier)) {
+        LOG(ERROR) << "invalid data of AveragePool[" << node->GetName() << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    auto fb_op_param = pmx::onnx::GetOpParam(base);
+    auto fb_pooling_param = fb_op_param->value_as_PoolingParam();
+    if (!fb_pooling_param || !fb_op_param->data_()) {
+        LOG(ERROR) << "param of AveragePool[" << node->GetName() << "] not found";
+        return RC_NOT_FOUND;
+    }
+
+    param_ = make_shared<ppl::nn::common::PoolingParam>();
+    pmx::onnx::DeserializePoolingParam(*fb_pooling_param, node->GetType().name, param_.get());
+    SetInferFuncs();
+
+    PmxDataReader reader(fb_op_param->data_()->data(), fb_op_param->data_()->size());
+    return DeserializeCommonParam(&reader);
+}
+#endif
+
 }}} // namespace ppl::nn::x86
@@ -18,11 +18,22 @@
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/conv_op.h"
 #include "ppl/nn/engines/x86/kernels/onnx/conv2d_dynamic_kernel.h"
 #include "ppl/nn/engines/x86/kernels/onnx/conv2d_kernel.h"
+#include "ppl/nn/engines/x86/kernels/onnx/conv2d_int8_kernel.h"
+#include "ppl/nn/engines/x86/kernels/onnx/conv2d_bf16_kernel.h"
 #include "ppl/nn/oputils/onnx/reshape_conv.h"
 #include "ppl/nn/common/logger.h"
 
+#ifdef PPLNN_ENABLE_PMX_MODEL
+#include "ppl/nn/models/pmx/oputils/onnx/conv.h"
+#endif
+
 #include "ppl/kernel/x86/common/threading_tools.h"
 
+#include <chrono>
+#include <sstream>
+#include <memory>
+#include <cstring>
+
 using namespace std;
 using namespace ppl::common;
 
@@ -38,6 +49,18 @@ ConvOp::~ConvOp() {
         }
         delete conv2d_param_;
     }
+    if (conv2d_int8_param_ != nullptr) {
+        if (conv2d_int8_param_->mgr != nullptr) {
+            conv2d_int8_param_->mgr->release_cvt_weights();
+        }
+        delete conv2d_int8_param_;
+    }
+    if (conv2d_bf16_param_ != nullptr) {
+        if (conv2d_bf16_param_->mgr != nullptr) {
+            conv2d_bf16_param_->mgr->release_cvt_weights();
+        }
+        delete conv2d_bf16_param_;
+    }
 }
 
 RetCode ConvOp::Init(const OptKernelOptions& options) {
@@ -47,13 +70,294 @@ RetCode ConvOp::Init(const OptKernelOptions& options) {
         return status;
     }
 
+    SetInferFuncs();
+
+    return RC_SUCCESS;
+}
+
+void ConvOp::SetInferFuncs() {
     infer_dims_func_ = [this](InputOutputInfo* info) -> RetCode {
         return oputils::ReshapeConv(info, param_.get());
     };
 
     infer_type_func_ = GenericInferType;
+}
 
-    return RC_SUCCESS;
+// winograd b4f3 avx512 may fallback to direct
+static bool InferWinogradFallback(const TensorImpl* X, const TensorImpl* Y,
+                                  const ppl::kernel::x86::conv2d_fp32_param* param) {
+    const int64_t dst_h = Y->GetShape()->GetDim(2);
+    const int64_t dst_w = Y->GetShape()->GetDim(3);
+    const int64_t batch = X->GetShape()->GetDim(0);
+    const int64_t num_tiles = batch * ((dst_h + 3) / 4) * ((dst_w + 3) / 4);
+    const bool align_tiles = (dst_h % 4 == 0) && (dst_w % 4) == 0;
+
+    const int64_t num_threads = ppl::kernel::x86::get_omp_max_threads();
+    if (num_threads > 4) { // Maybe memory bound. Just maybe.
+        if (param->group > 4) {
+            if (param->channels / param->group <= 2 * 1.801f * 16) { // Multigroup need more channels
+                return true;
+            }
+        }
+        if (param->group / num_threads > 1 && num_threads / batch <= 4) { // Many group but small batch
+            return true;
+        }
+    }
+    return num_tiles < (align_tiles ? 10 : 12);
+}
+
+static bool IsShapeFixed(const TensorShape& shape) {
+    if (shape.GetDimCount() == 0) {
+        return false;
+    }
+    for (uint32_t i = 0; i < shape.GetDimCount(); ++i) {
+        if (shape.GetDim(i) <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static string GenConv2dFp32AlgoKey(const ppl::kernel::x86::conv2d_fp32_param& param, isa_t isa,
+                                   const TensorShape& src_shape) {
+    ostringstream ss;
+    ss << "Conv_isa" << isa << "_g" << param.group << "_ic" << param.channels << "_oc" << param.num_output << "_k"
+       << param.kernel_h << "x" << param.kernel_w << "_s" << param.stride_h << "x" << param.stride_w << "_p"
+       << param.pad_h << "x" << param.pad_w << "_d" << param.dilation_h << "x" << param.dilation_w << "_src";
+    for (uint32_t i = 0; i < src_shape.GetDimCount(); ++i) {
+        ss << (i == 0 ? "" : "x") << src_shape.GetDim(i);
+    }
+    ss << "_f" << src_shape.GetDataFormat();
+    return ss.str();
+}
+
+/** @return execution time of `algo_info` in milliseconds, or a negative value if it cannot run */
+static double ProfileConv2dFp32Algo(const ppl::kernel::x86::conv2d_fp32_param& param,
+                                    const ppl::kernel::x86::conv2d_fp32_algo_info& algo_info,
+                                    const float* weight_data, const float* bias_data, const TensorShape& src_shape,
+                                    const TensorShape& dst_shape, X86Device* device) {
+    static const int32_t warmup_iter = 1;
+    static const int32_t profile_iter = 3;
+
+    auto allocator = device->GetAllocator();
+    unique_ptr<ppl::kernel::x86::conv2d_fp32_manager> mgr(
+        ppl::kernel::x86::conv2d_algo_selector::gen_algo(param, algo_info, allocator));
+    if (!mgr || !mgr->is_supported() || mgr->gen_cvt_weights(weight_data, bias_data) != RC_SUCCESS) {
+        return -1.0;
+    }
+
+    TensorShape algo_src_shape(src_shape), algo_dst_shape(dst_shape);
+    algo_src_shape.SetDataFormat(algo_info.input_format);
+    algo_dst_shape.SetDataFormat(algo_info.output_format);
+
+    double min_time = -1.0;
+    unique_ptr<ppl::kernel::x86::conv2d_fp32_executor> executor(mgr->gen_executor());
+    if (executor) {
+        executor->set_src_shape(&algo_src_shape);
+        executor->set_dst_shape(&algo_dst_shape);
+        if (executor->prepare() == RC_SUCCESS) {
+            BufferDesc src_buf, dst_buf, tmp_buf;
+            if (device->Realloc(algo_src_shape, &src_buf) == RC_SUCCESS &&
+                device->Realloc(algo_dst_shape, &dst_buf) == RC_SUCCESS &&
+                device->Realloc(executor->cal_temp_buffer_size(), &tmp_buf) == RC_SUCCESS) {
+                memset(src_buf.addr, 0, algo_src_shape.GetBytesIncludingPadding());
+                executor->set_src((const float*)src_buf.addr);
+                executor->set_dst((float*)dst_buf.addr);
+                executor->set_temp_buffer(tmp_buf.addr);
+
+                bool ok = true;
+                for (int32_t i = 0; i < warmup_iter + profile_iter && ok; ++i) {
+                    auto begin_ts = chrono::high_resolution_clock::now();
+                    ok = (executor->execute() == RC_SUCCESS);
+                    auto end_ts = chrono::high_resolution_clock::now();
+                    const double time = chrono::duration<double, milli>(end_ts - begin_ts).count();
+                    if (ok && i >= warmup_iter && (min_time < 0 || time < min_time)) {
+                        min_time = time;
+                    }
+                }
+                if (!ok) {
+                    min_time = -1.0;
+                }
+            }
+            device->Free(&src_buf);
+            device->Free(&dst_buf);
+            device->Free(&tmp_buf);
+        }
+    }
+
+    mgr->release_cvt_weights();
+    return min_time;
+}
+
+/*
+  looks up algorithm of this conv in `options.algos` and selects one by running all candidates if it is not
+  found and dynamic tuning is enabled. returns true if `algo_info` is replaced.
+*/
+static bool SelectConv2dFp32AlgoDynamically(const TensorImpl* X, const TensorImpl* Y,
+                                            const ppl::kernel::x86::conv2d_fp32_param& param,
+                                            const float* weight_data, const float* bias_data,
+                                            const OptKernelOptions& options, const string& node_name,
+                                            ppl::kernel::x86::conv2d_fp32_algo_info* algo_info) {
+    if (!options.algos || !IsShapeFixed(*X->GetShape()) || !IsShapeFixed(*Y->GetShape())) {
+        return false;
+    }
+
+    auto device = options.device;
+    const string key = GenConv2dFp32AlgoKey(param, device->GetISA(), *X->GetShape());
+
+    auto ref = options.algos->find(key);
+    if (ref != options.algos->end()) {
+        ppl::kernel::x86::conv2d_fp32_algo_info cached_info;
+        cached_info.algo_type = ref->second.algo_type;
+        cached_info.isa = ref->second.isa;
+        cached_info.input_format = ref->second.input_format;
+        cached_info.output_format = ref->second.output_format;
+
+        bool is_valid = ((cached_info.isa & device->GetISA()) == cached_info.isa);
+        if (is_valid) {
+            unique_ptr<ppl::kernel::x86::conv2d_fp32_manager> mgr(
+                ppl::kernel::x86::conv2d_algo_selector::gen_algo(param, cached_info, nullptr));
+            is_valid = (mgr && mgr->is_supported());
+        }
+        if (is_valid) {
+            *algo_info = cached_info;
+            return true;
+        }
+        LOG(WARNING) << "algorithm of Conv[" << node_name << "] in cache is invalid, ignored.";
+    }
+
+    if (!options.engine_options || options.engine_options->dynamic_tuning_level == X86_TUNING_OFF) {
+        return false;
+    }
+
+    auto candidates = ppl::kernel::x86::conv2d_algo_selector::get_candidate_algos(X->GetShape()->GetDataFormat(),
+                                                                                  param, device->GetISA());
+    if (candidates.size() <= 1) {
+        return false;
+    }
+
+    vector<float> zero_bias;
+    if (!bias_data) {
+        zero_bias.resize(param.num_output, 0.0f);
+        bias_data = zero_bias.data();
+    }
+
+    const bool winograd_fallback = InferWinogradFallback(X, Y, &param);
+    double best_time = -1.0;
+    for (auto c = candidates.begin(); c != candidates.end(); ++c) {
+        if (c->algo_type == ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3 && winograd_fallback) {
+            continue; // the same as DIRECT for this shape
+        }
+        const double time = ProfileConv2dFp32Algo(param, *c, weight_data, bias_data, *X->GetShape(),
+                                                  *Y->GetShape(), device);
+        LOG(DEBUG) << "Conv[" << node_name << "] algo[" << c->algo_type << "] time: " << time << " ms";
+        if (time >= 0 && (best_time < 0 || time < best_time)) {
+            best_time = time;
+            *algo_info = *c;
+        }
+    }
+    if (best_time < 0) {
+        return false;
+    }
+
+    AlgoSelect selected;
+    selected.algo_type = algo_info->algo_type;
+    selected.isa = algo_info->isa;
+    selected.input_format = algo_info->input_format;
+    selected.output_format = algo_info->output_format;
+    options.algos->insert(make_pair(key, selected));
+    return true;
+}
+
+// fills fields shared by conv2d params of fp32, int8 and bf16 kernels
+template <typename T>
+static void FillConv2dParam(const ppl::nn::common::ConvParam& conv_param, const ir::Shape& weight_shape, T* param) {
+    param->kernel_h = conv_param.kernel_shape[0];
+    param->kernel_w = conv_param.kernel_shape[1];
+    param->stride_h = conv_param.strides[0];
+    param->stride_w = conv_param.strides[1];
+    param->pad_h = conv_param.pads[0];
+    param->pad_w = conv_param.pads[1];
+    param->dilation_h = conv_param.dilations[0];
+    param->dilation_w = conv_param.dilations[1];
+    param->group = conv_param.group;
+    param->num_output = weight_shape.dims[0];
+    param->channels = weight_shape.dims[1] * conv_param.group;
+    param->fuse_flag = 0;
+}
+
+bool ConvOp::TrySelectInt8Algorithm(const OptKernelOptions& options, const float* weight_data,
+                                    const float* bias_data) {
+    float src_scale;
+    if (!GetInputQuantScale(options, 0, &src_scale)) {
+        return false;
+    }
+
+    auto node = GetNode();
+    const ir::Shape& weight_shape = options.graph_data->shapes.find(node->GetInput(1))->second;
+    const ppl::nn::common::ConvParam& conv_param = *param_;
+
+    if (!conv2d_int8_param_) {
+        conv2d_int8_param_ = new Conv2dInt8Param;
+    }
+    ppl::kernel::x86::conv2d_int8_param& conv2d_param = conv2d_int8_param_->param;
+    FillConv2dParam(conv_param, weight_shape, &conv2d_param);
+    conv2d_param.src_scale = src_scale;
+
+    conv2d_int8_param_->algo_info = ppl::kernel::x86::conv2d_int8_algo_selector::select_algo(
+        ppl::common::DATAFORMAT_NDARRAY, conv2d_param, options.device->GetISA());
+    if (conv2d_int8_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_int8_algo::UNKNOWN) {
+        LOG(INFO) << "Conv[" << node->GetName() << "] has quant info but int8 is unsupported, use fp32 kernel";
+        return false;
+    }
+
+    conv2d_int8_param_->mgr = ppl::kernel::x86::conv2d_int8_algo_selector::gen_algo(
+        conv2d_param, conv2d_int8_param_->algo_info, options.device->GetAllocator());
+    if (!conv2d_int8_param_->mgr ||
+        conv2d_int8_param_->mgr->gen_cvt_weights(weight_data, bias_data) != ppl::common::RC_SUCCESS) {
+        LOG(WARNING) << "Conv[" << node->GetName() << "] generate int8 weights failed, use fp32 kernel";
+        delete conv2d_int8_param_;
+        conv2d_int8_param_ = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool ConvOp::TrySelectBf16Algorithm(const OptKernelOptions& options, const float* weight_data,
+                                    const float* bias_data) {
+    if (!options.engine_options || options.engine_options->forward_precision != DATATYPE_BFLOAT16) {
+        return false;
+    }
+
+    auto node = GetNode();
+    const ir::Shape& weight_shape = options.graph_data->shapes.find(node->GetInput(1))->second;
+    const ppl::nn::common::ConvParam& conv_param = *param_;
+
+    if (!conv2d_bf16_param_) {
+        conv2d_bf16_param_ = new Conv2dBf16Param;
+    }
+    ppl::kernel::x86::conv2d_bf16_param& conv2d_param = conv2d_bf16_param_->param;
+    FillConv2dParam(conv_param, weight_shape, &conv2d_param);
+
+    conv2d_bf16_param_->algo_info = ppl::kernel::x86::conv2d_bf16_algo_selector::select_algo(
+        ppl::common::DATAFORMAT_NDARRAY, conv2d_param, options.device->GetISA());
+    if (conv2d_bf16_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_bf16_algo::UNKNOWN) {
+        LOG(DEBUG) << "Conv[" << node->GetName() << "] is not supported by bf16 kernels, use fp32 kernel";
+        return false;
+    }
+
+    conv2d_bf16_param_->mgr = ppl::kernel::x86::conv2d_bf16_algo_selector::gen_algo(
+        conv2d_param, conv2d_bf16_param_->algo_info, options.device->GetAllocator());
+    if (!conv2d_bf16_param_->mgr ||
+        conv2d_bf16_param_->mgr->gen_cvt_weights(weight_data, bias_data) != ppl::common::RC_SUCCESS) {
+        LOG(WARNING) << "Conv[" << node->GetName() << "] generate bf16 weights failed, use fp32 kernel";
+        delete conv2d_bf16_param_;
+        conv2d_bf16_param_ = nullptr;
+        return false;
+    }
+
+    return true;
 }
 
 ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const OptKernelOptions& options) {
@@ -92,32 +396,26 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
     }
 
     if (kernel_dims == 2) {
-        if (!conv2d_param_) {
-            conv2d_param_ = new Conv2dParam;
+        if (TrySelectInt8Algorithm(options, weight_data, bias_data)) {
+            return RC_SUCCESS;
         }
-        if (!conv2d_param_) {
-            return ppl::common::RC_OUT_OF_MEMORY;
+        if (TrySelectBf16Algorithm(options, weight_data, bias_data)) {
+            return RC_SUCCESS;
         }
 
-        const int32_t num_output = weight_shape.dims[0];
-        const int32_t channels = weight_shape.dims[1] * param_->group;
-
+        if (!conv2d_param_) {
+            conv2d_param_ = new Conv2dParam;
+        }
         ppl::kernel::x86::conv2d_fp32_param& conv2d_param = conv2d_param_->param;
-        conv2d_param.kernel_h = conv_param.kernel_shape[0];
-        conv2d_param.kernel_w = conv_param.kernel_shape[1];
-        conv2d_param.stride_h = conv_param.strides[0];
-        conv2d_param.stride_w = conv_param.strides[1];
-        conv2d_param.pad_h = conv_param.pads[0];
-        conv2d_param.pad_w = conv_param.pads[1];
-        conv2d_param.dilation_h = conv_param.dilations[0];
-        conv2d_param.dilation_w = conv_param.dilations[1];
-        conv2d_param.group = conv_param.group;
-        conv2d_param.num_output = num_output;
-        conv2d_param.channels = channels;
-        conv2d_param.fuse_flag = 0;
+        FillConv2dParam(conv_param, weight_shape, &conv2d_param);
 
         conv2d_param_->algo_info = ppl::kernel::x86::conv2d_algo_selector::select_algo(
             info.GetInput<TensorImpl>(0)->GetShape()->GetDataFormat(), conv2d_param_->param, options.device->GetISA());
+        if (conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
+            SelectConv2dFp32AlgoDynamically(info.GetInput<TensorImpl>(0), info.GetOutput<TensorImpl>(0),
+                                            conv2d_param_->param, weight_data, bias_data, options, node->GetName(),
+                                            &conv2d_param_->algo_info);
+        }
 
         if (conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
             LOG(INFO) << "Conv select algorithm failed, use fallback kernel";
@@ -125,32 +423,11 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
             conv2d_param_->mgr = ppl::kernel::x86::conv2d_algo_selector::gen_algo(
                 conv2d_param_->param, conv2d_param_->algo_info, options.device->GetAllocator());
 
-            // winograd b4f3 avx512 may fallback to direct
             if (conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3) {
                 conv2d_param_->algo_info.algo_type = ppl::kernel::x86::conv2d_fp32_algo::DIRECT;
                 conv2d_param_->fallback_mgr = ppl::kernel::x86::conv2d_algo_selector::gen_algo(
                     conv2d_param_->param, conv2d_param_->algo_info, options.device->GetAllocator());
-                conv2d_param_->infer_fallback_func = [](const TensorImpl* X, const TensorImpl* Y,
-                                                        const ppl::kernel::x86::conv2d_fp32_param* param) -> bool {
-                    const int64_t dst_h = Y->GetShape()->GetDim(2);
-                    const int64_t dst_w = Y->GetShape()->GetDim(3);
-                    const int64_t batch = X->GetShape()->GetDim(0);
-                    const int64_t num_tiles = batch * ((dst_h + 3) / 4) * ((dst_w + 3) / 4);
-                    const bool align_tiles = (dst_h % 4 == 0) && (dst_w % 4) == 0;
-
-                    const int64_t num_threads = ppl::kernel::x86::get_omp_max_threads();
-                    if (num_threads > 4) { // Maybe memory bound. Just maybe.
-                        if (param->group > 4) {
-                            if (param->channels / param->group <= 2 * 1.801f * 16) { // Multigroup need more channels
-                                return true;
-                            }
-                        }
-                        if (param->group / num_threads > 1 && num_threads / batch <= 4) { // Many group but small batch
-                            return true;
-                        }
-                    }
-                    return num_tiles < (align_tiles ? 10 : 12);
-                };
+                conv2d_param_->infer_fallback_func = InferWinogradFallback;
                 conv2d_param_->algo_info.algo_type = ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3;
             }
 
@@ -177,6 +454,16 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
 
 RetCode ConvOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* selected_input_formats,
                              vector<dataformat_t>* selected_output_formats) {
+    if (IsInt8AlgoSelected()) {
+        selected_input_formats->at(0) = conv2d_int8_param_->algo_info.input_format;
+        selected_output_formats->at(0) = conv2d_int8_param_->algo_info.output_format;
+        return RC_SUCCESS;
+    }
+    if (IsBf16AlgoSelected()) {
+        selected_input_formats->at(0) = conv2d_bf16_param_->algo_info.input_format;
+        selected_output_formats->at(0) = conv2d_bf16_param_->algo_info.output_format;
+        return RC_SUCCESS;
+    }
     if (conv2d_param_ && conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
         selected_input_formats->at(0) = conv2d_param_->algo_info.input_format;
         if (conv2d_param_->mgr->param().fuse_flag & ppl::kernel::x86::conv_fuse_flag::SUM) {
@@ -188,7 +475,8 @@ RetCode ConvOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>*
 }
 
 RetCode ConvOp::OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_refcount) {
-    if (conv2d_param_ && conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
+    if (IsInt8AlgoSelected() || IsBf16AlgoSelected() ||
+        (conv2d_param_ && conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN)) {
         auto weight_id = GetNode()->GetInput(1);
         auto it = constants_data_refcount->find(weight_id);
         if (it != constants_data_refcount->end()) {
@@ -206,6 +494,18 @@ RetCode ConvOp::OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_re
 }
 
 bool ConvOp::TryFuseReLU() {
+    if (IsInt8AlgoSelected()) {
+        ppl::kernel::x86::conv2d_int8_param param = conv2d_int8_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::RELU;
+        conv2d_int8_param_->mgr->set_param(param);
+        return true;
+    }
+    if (IsBf16AlgoSelected()) {
+        ppl::kernel::x86::conv2d_bf16_param param = conv2d_bf16_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::RELU;
+        conv2d_bf16_param_->mgr->set_param(param);
+        return true;
+    }
     if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
         return false;
     }
@@ -219,6 +519,18 @@ bool ConvOp::TryFuseReLU() {
 }
 
 bool ConvOp::TryFuseReLU6() {
+    if (IsInt8AlgoSelected()) {
+        ppl::kernel::x86::conv2d_int8_param param = conv2d_int8_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::RELU6;
+        conv2d_int8_param_->mgr->set_param(param);
+        return true;
+    }
+    if (IsBf16AlgoSelected()) {
+        ppl::kernel::x86::conv2d_bf16_param param = conv2d_bf16_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::RELU6;
+        conv2d_bf16_param_->mgr->set_param(param);
+        return true;
+    }
     if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
         return false;
     }
@@ -249,10 +561,246 @@ bool ConvOp::TryFuseSum() {
 }
 
 KernelImpl* ConvOp::CreateKernelImpl() const {
+    if (IsInt8AlgoSelected()) {
+        return CreateKernelImplWithParam<Conv2dInt8Kernel>(conv2d_int8_param_);
+    }
+    if (IsBf16AlgoSelected()) {
+        return CreateKernelImplWithParam<Conv2dBf16Kernel>(conv2d_bf16_param_);
+    }
     if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
         return CreateKernelImplWithParam<Conv2dDynamicKernel>(param_.get());
     }
     return CreateKernelImplWithParam<Conv2dKernel>(conv2d_param_);
 }
 
+#ifdef PPLNN_ENABLE_PMX_MODEL
+enum {
+    CONV_PMX_ALGO_DYNAMIC = 0,
+    CONV_PMX_ALGO_FP32 = 1,
+    CONV_PMX_ALGO_INT8 = 2,
+    CONV_PMX_ALGO_BF16 = 3,
+};
+
+static void SerializeConv2dFp32Weights(const ppl::kernel::x86::conv2d_fp32_manager* mgr, PmxDataWriter* writer) {
+    writer->WriteArray(mgr->cvt_filter(), mgr->cvt_filter_size());
+    writer->WriteArray(mgr->cvt_bias(), mgr->cvt_bias_size());
+}
+
+static RetCode DeserializeConv2dFp32Weights(PmxDataReader* reader, ppl::kernel::x86::conv2d_fp32_manager* mgr) {
+    uint64_t filter_size = 0, bias_size = 0;
+    auto filter = reader->ReadArray<float>(&filter_size);
+    auto bias = reader->ReadArray<float>(&bias_size);
+    if (!filter || !bias || filter_size == 0 || bias_size == 0) {
+        return RC_INVALID_VALUE;
+    }
+
+    auto allocator = mgr->allocator();
+    auto cvt_filter = (float*)allocator->Alloc(filter_size * sizeof(float));
+    if (!cvt_filter) {
+        return RC_OUT_OF_MEMORY;
+    }
+    auto cvt_bias = (float*)allocator->Alloc(bias_size * sizeof(float));
+    if (!cvt_bias) {
+        allocator->Free(cvt_filter);
+        return RC_OUT_OF_MEMORY;
+    }
+
+    memcpy(cvt_filter, filter, filter_size * sizeof(float));
+    memcpy(cvt_bias, bias, bias_size * sizeof(float));
+    mgr->set_cvt_filter(cvt_filter, filter_size);
+    mgr->set_cvt_bias(cvt_bias, bias_size);
+    return RC_SUCCESS;
+}
+
+static RetCode DeserializeConv2dFp32Param(PmxDataReader* reader, ppl::common::Allocator* allocator,
+                                          Conv2dParam* conv2d_param) {
+    ppl::kernel::x86::conv2d_fp32_param fused_param;
+    uint8_t has_fallback = 0;
+    if (!reader->Read(&conv2d_param->param) || !reader->Read(&conv2d_param->algo_info) ||
+        !reader->Read(&fused_param) || !reader->Read(&has_fallback)) {
+        return RC_INVALID_VALUE;
+    }
+
+    conv2d_param->mgr =
+        ppl::kernel::x86::conv2d_algo_selector::gen_algo(conv2d_param->param, conv2d_param->algo_info, allocator);
+    if (!conv2d_param->mgr) {
+        return RC_UNSUPPORTED;
+    }
+    conv2d_param->mgr->set_param(fused_param);
+    auto status = DeserializeConv2dFp32Weights(reader, conv2d_param->mgr);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    if (has_fallback) {
+        auto fallback_algo_info = conv2d_param->algo_info;
+        fallback_algo_info.algo_type = ppl::kernel::x86::conv2d_fp32_algo::DIRECT;
+        conv2d_param->fallback_mgr =
+            ppl::kernel::x86::conv2d_algo_selector::gen_algo(conv2d_param->param, fallback_algo_info, allocator);
+        if (!conv2d_param->fallback_mgr) {
+            return RC_UNSUPPORTED;
+        }
+        conv2d_param->fallback_mgr->set_param(fused_param);
+        status = DeserializeConv2dFp32Weights(reader, conv2d_param->fallback_mgr);
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+        conv2d_param->infer_fallback_func = InferWinogradFallback;
+    }
+
+    return RC_SUCCESS;
+}
+
+static RetCode DeserializeConv2dInt8Param(PmxDataReader* reader, ppl::common::Allocator* allocator,
+                                          Conv2dInt8Param* conv2d_param) {
+    ppl::kernel::x86::conv2d_int8_param fused_param;
+    if (!reader->Read(&conv2d_param->param) || !reader->Read(&conv2d_param->algo_info) ||
+        !reader->Read(&fused_param)) {
+        return RC_INVALID_VALUE;
+    }
+
+    uint64_t cvt_weights_bytes = 0;
+    auto cvt_weights = reader->ReadArray<uint8_t>(&cvt_weights_bytes);
+    if (!cvt_weights) {
+        return RC_INVALID_VALUE;
+    }
+
+    conv2d_param->mgr =
+        ppl::kernel::x86::conv2d_int8_algo_selector::gen_algo(conv2d_param->param, conv2d_param->algo_info, allocator);
+    if (!conv2d_param->mgr) {
+        return RC_UNSUPPORTED;
+    }
+    conv2d_param->mgr->set_param(fused_param);
+    return conv2d_param->mgr->set_cvt_weights(cvt_weights, cvt_weights_bytes);
+}
+
+static RetCode DeserializeConv2dBf16Param(PmxDataReader* reader, ppl::common::Allocator* allocator,
+                                          Conv2dBf16Param* conv2d_param) {
+    ppl::kernel::x86::conv2d_bf16_param fused_param;
+    if (!reader->Read(&conv2d_param->param) || !reader->Read(&conv2d_param->algo_info) ||
+        !reader->Read(&fused_param)) {
+        return RC_INVALID_VALUE;
+    }
+
+    uint64_t cvt_weights_bytes = 0;
+    auto cvt_weights = reader->ReadArray<uint8_t>(&cvt_weights_bytes);
+    if (!cvt_weights) {
+        return RC_INVALID_VALUE;
+    }
+
+    conv2d_param->mgr =
+        ppl::kernel::x86::conv2d_bf16_algo_selector::gen_algo(conv2d_param->param, conv2d_param->algo_info, allocator);
+    if (!conv2d_param->mgr) {
+        return RC_UNSUPPORTED;
+    }
+    conv2d_param->mgr->set_param(fused_param);
+    return conv2d_param->mgr->set_cvt_weights(cvt_weights, cvt_weights_bytes);
+}
+
+RetCode ConvOp::SerializeData(const pmx::SerializationContext&, utils::DataStream* ds) const {
+    PmxDataWriter writer;
+    SerializeCommonParam(&writer);
+    writer.Write(bias_term_);
+
+    if (IsInt8AlgoSelected()) {
+        auto mgr = conv2d_int8_param_->mgr;
+        writer.Write<uint32_t>(CONV_PMX_ALGO_INT8);
+        writer.Write(conv2d_int8_param_->param);
+        writer.Write(conv2d_int8_param_->algo_info);
+        writer.Write(mgr->param());
+        writer.WriteArray((const uint8_t*)mgr->cvt_weights(), mgr->cvt_weights_bytes());
+    } else if (IsBf16AlgoSelected()) {
+        auto mgr = conv2d_bf16_param_->mgr;
+        writer.Write<uint32_t>(CONV_PMX_ALGO_BF16);
+        writer.Write(conv2d_bf16_param_->param);
+        writer.Write(conv2d_bf16_param_->algo_info);
+        writer.Write(mgr->param());
+        writer.WriteArray((const uint8_t*)mgr->cvt_weights(), mgr->cvt_weights_bytes());
+    } else if (conv2d_param_ && conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
+        auto mgr = conv2d_param_->mgr;
+        writer.Write<uint32_t>(CONV_PMX_ALGO_FP32);
+        writer.Write(conv2d_param_->param);
+        writer.Write(conv2d_param_->algo_info);
+        writer.Write(mgr->param());
+        writer.Write<uint8_t>(conv2d_param_->fallback_mgr ? 1 : 0);
+        SerializeConv2dFp32Weights(mgr, &writer);
+        if (conv2d_param_->fallback_mgr) {
+            SerializeConv2dFp32Weights(conv2d_param_->fallback_mgr, &writer);
+        }
+    } else {
+        writer.Write<uint32_t>(CONV_PMX_ALGO_DYNAMIC);
+    }
+
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_param = pmx::onnx::SerializeConvParam(*param_, &builder);
+    auto fb_data = builder.CreateVector(writer.GetData());
+    auto fb_op_param = pmx::onnx::CreateOpParam(builder, pmx::onnx::OpParamType_ConvParam, fb_param.Union(), fb_data);
+    pmx::onnx::FinishOpParamBuffer(builder, fb_op_param);
+    return ds->Write(builder.GetBufferPointer(), builder.GetSize());
+}
+
+RetCode ConvOp::DeserializeData(const pmx::DeserializationContext&, const void* base, uint64_t size) {
+    auto node = GetNode();
+
+    flatbuffers::Verifier verifier((const uint8_t*)base, size);
+    if (!pmx::onnx::VerifyOpParamBuffer(verifier)) {
+        LOG(ERROR) << "invalid data of Conv[" << node->GetName() << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    auto fb_op_param = pmx::onnx::GetOpParam(base);
+    auto fb_conv_param = fb_op_param->value_as_ConvParam();
+    if (!fb_conv_param || !fb_op_param->data_()) {
+        LOG(ERROR) << "param of Conv[" << node->GetName() << "] not found";
+        return RC_NOT_FOUND;
+    }
+
+    param_ = make_shared<ppl::nn::common::ConvParam>();
+    pmx::onnx::DeserializeConvParam(*fb_conv_param, param_.get());
+    SetInferFuncs();
+
+    PmxDataReader reader(fb_op_param->data_()->data(), fb_op_param->data_()->size());
+    auto status = DeserializeCommonParam(&reader);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    uint32_t algo = CONV_PMX_ALGO_DYNAMIC;
+    if (!reader.Read(&bias_term_) || !reader.Read(&algo)) {
+        LOG(ERROR) << "read algorithm of Conv[" << node->GetName() << "] failed";
+        return RC_INVALID_VALUE;
+    }
+
+    if (algo == CONV_PMX_ALGO_DYNAMIC) {
+        return RC_SUCCESS;
+    }
+
+    if (!device_) {
+        LOG(ERROR) << "device of Conv[" << node->GetName() << "] is not set";
+        return RC_INVALID_VALUE;
+    }
+
+    if (algo == CONV_PMX_ALGO_FP32) {
+        conv2d_param_ = new Conv2dParam;
+        status = DeserializeConv2dFp32Param(&reader, device_->GetAllocator(), conv2d_param_);
+    } else if (algo == CONV_PMX_ALGO_INT8) {
+        conv2d_int8_param_ = new Conv2dInt8Param;
+        status = DeserializeConv2dInt8Param(&reader, device_->GetAllocator(), conv2d_int8_param_);
+    } else if (algo == CONV_PMX_ALGO_BF16) {
+        conv2d_bf16_param_ = new Conv2dBf16Param;
+        status = DeserializeConv2dBf16Param(&reader, device_->GetAllocator(), conv2d_bf16_param_);
+    } else {
+        LOG(ERROR) << "unknown algorithm[" << algo << "] of Conv[" << node->GetName() << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "restore converted weights of Conv[" << node->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    return RC_SUCCESS;
+}
+#endif
+
 }}} // namespace ppl::nn::x86
@@ -27,7 +27,8 @@ namespace ppl { namespace nn { namespace x86 {
 class PostDepthwiseConvOp;
 class ConvOp final : public X86OptKernel {
 public:
-    ConvOp(const ir::Node* node) : X86OptKernel(node), conv2d_param_(nullptr) {}
+    ConvOp(const ir::Node* node)
+        : X86OptKernel(node), conv2d_param_(nullptr), conv2d_int8_param_(nullptr), conv2d_bf16_param_(nullptr) {}
 
     ~ConvOp();
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
@@ -42,9 +43,29 @@ public:
     bool TryFuseReLU6();
     bool TryFuseSum();
 
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    ppl::common::RetCode SerializeData(const pmx::SerializationContext&, utils::DataStream*) const override;
+    ppl::common::RetCode DeserializeData(const pmx::DeserializationContext&, const void*, uint64_t) override;
+#endif
+
+private:
+    void SetInferFuncs();
+    bool TrySelectInt8Algorithm(const OptKernelOptions& options, const float* weight_data, const float* bias_data);
+    bool IsInt8AlgoSelected() const {
+        return conv2d_int8_param_ &&
+            conv2d_int8_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_int8_algo::UNKNOWN;
+    }
+    bool TrySelectBf16Algorithm(const OptKernelOptions& options, const float* weight_data, const float* bias_data);
+    bool IsBf16AlgoSelected() const {
+        return conv2d_bf16_param_ &&
+            conv2d_bf16_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_bf16_algo::UNKNOWN;
+    }
+
 private:
     int32_t bias_term_ = 0;
     Conv2dParam* conv2d_param_;
+    Conv2dInt8Param* conv2d_int8_param_;
+    Conv2dBf16Param* conv2d_bf16_param_;
     std::shared_ptr<ppl::nn::common::ConvParam> param_;
 
     friend PostDepthwiseConvOp;
@@ -18,8 +18,15 @@
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/gemm_op.h"
 #include "ppl/nn/engines/x86/kernels/onnx/gemm_kernel.h"
 #include "ppl/nn/engines/x86/kernels/onnx/fc_kernel.h"
+#include "ppl/nn/engines/x86/kernels/onnx/fc_int8_kernel.h"
+#include "ppl/nn/engines/x86/kernels/onnx/fc_bf16_kernel.h"
 #include "ppl/nn/oputils/onnx/reshape_gemm.h"
 #include "ppl/nn/common/logger.h"
+
+#ifdef PPLNN_ENABLE_PMX_MODEL
+#include "ppl/nn/models/pmx/oputils/onnx/gemm.h"
+#endif
+
 using namespace std;
 using namespace ppl::common;
 
@@ -32,6 +39,93 @@ GemmOp::~GemmOp() {
         }
         delete fc_param_;
     }
+    if (fc_int8_param_ != nullptr) {
+        if (fc_int8_param_->mgr != nullptr) {
+            fc_int8_param_->mgr->release_cvt_weights();
+        }
+        delete fc_int8_param_;
+    }
+    if (fc_bf16_param_ != nullptr) {
+        if (fc_bf16_param_->mgr != nullptr) {
+            fc_bf16_param_->mgr->release_cvt_weights();
+        }
+        delete fc_bf16_param_;
+    }
+}
+
+bool GemmOp::TrySelectInt8Algorithm(const OptKernelOptions& options, const float* weight_data,
+                                    const float* bias_data) {
+    float src_scale;
+    if (!GetInputQuantScale(options, 0, &src_scale)) {
+        return false;
+    }
+
+    auto node = GetNode();
+    const ir::Shape& weight_shape = options.graph_data->shapes.find(node->GetInput(1))->second;
+
+    if (!fc_int8_param_) {
+        fc_int8_param_ = new FCInt8Param;
+    }
+    fc_int8_param_->param.num_output = weight_shape.dims[0];
+    fc_int8_param_->param.channels = weight_shape.dims[1];
+    fc_int8_param_->param.fuse_flag = 0;
+    fc_int8_param_->param.src_scale = src_scale;
+
+    fc_int8_param_->algo_info = ppl::kernel::x86::fc_int8_algo_selector::select_algo(
+        ppl::common::DATAFORMAT_NDARRAY, fc_int8_param_->param, options.device->GetISA());
+    if (fc_int8_param_->algo_info.algo_type == ppl::kernel::x86::fc_int8_algo::UNKNOWN) {
+        LOG(INFO) << "Gemm[" << node->GetName() << "] has quant info but int8 is unsupported, use fp32 kernel";
+        return false;
+    }
+
+    fc_int8_param_->mgr = ppl::kernel::x86::fc_int8_algo_selector::gen_algo(
+        fc_int8_param_->param, fc_int8_param_->algo_info, options.device->GetAllocator());
+    if (!fc_int8_param_->mgr ||
+        fc_int8_param_->mgr->gen_cvt_weights(weight_data, bias_data) != ppl::common::RC_SUCCESS) {
+        LOG(WARNING) << "Gemm[" << node->GetName() << "] generate int8 weights failed, use fp32 kernel";
+        delete fc_int8_param_;
+        fc_int8_param_ = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool GemmOp::TrySelectBf16Algorithm(const OptKernelOptions& options, const float* weight_data,
+                                    const float* bias_data) {
+    if (forward_precision_ != DATATYPE_BFLOAT16) {
+        return false;
+    }
+
+    auto node = GetNode();
+    const ir::Shape& weight_shape = options.graph_data->shapes.find(node->GetInput(1))->second;
+
+    if (!fc_bf16_param_) {
+        fc_bf16_param_ = new FCBf16Param;
+    }
+
+    fc_bf16_param_->param.num_output = weight_shape.dims[0];
+    fc_bf16_param_->param.channels = weight_shape.dims[1];
+    fc_bf16_param_->param.fuse_flag = 0;
+
+    fc_bf16_param_->algo_info = ppl::kernel::x86::fc_bf16_algo_selector::select_algo(
+        ppl::common::DATAFORMAT_NDARRAY, fc_bf16_param_->param, options.device->GetISA());
+    if (fc_bf16_param_->algo_info.algo_type == ppl::kernel::x86::fc_bf16_algo::UNKNOWN) {
+        LOG(DEBUG) << "Gemm[" << node->GetName() << "] is not supported by bf16 kernels, use fp32 kernel";
+        return false;
+    }
+
+    fc_bf16_param_->mgr = ppl::kernel::x86::fc_bf16_algo_selector::gen_algo(
+        fc_bf16_param_->param, fc_bf16_param_->algo_info, options.device->GetAllocator());
+    if (!fc_bf16_param_->mgr ||
+        fc_bf16_param_->mgr->gen_cvt_weights(weight_data, bias_data) != ppl::common::RC_SUCCESS) {
+        LOG(WARNING) << "Gemm[" << node->GetName() << "] generate bf16 weights failed, use fp32 kernel";
+        delete fc_bf16_param_;
+        fc_bf16_param_ = nullptr;
+        return false;
+    }
+
+    return true;
 }
 
 RetCode GemmOp::Init(const OptKernelOptions& options) {
@@ -59,8 +153,13 @@ RetCode GemmOp::Init(const OptKernelOptions& options) {
     }
 
     param_->bias_term = (node->GetInputCount() == 3) ? 1 : 0;
+    if (options.engine_options) {
+        forward_precision_ = options.engine_options->forward_precision;
+    }
 
-    if (!param_->transA && param_->transB && weight_data != nullptr) {
+    if (!param_->transA && param_->transB && weight_data != nullptr &&
+        !TrySelectInt8Algorithm(options, weight_data, bias_data) &&
+        !TrySelectBf16Algorithm(options, weight_data, bias_data)) {
         if (!fc_param_) {
             fc_param_ = new FCParam;
         }
@@ -90,17 +189,22 @@ RetCode GemmOp::Init(const OptKernelOptions& options) {
         }
     }
 
+    SetInferFuncs();
+
+    return RC_SUCCESS;
+}
+
+void GemmOp::SetInferFuncs() {
     infer_dims_func_ = [this](InputOutputInfo* info) -> RetCode {
         return oputils::ReshapeGemm(info, param_.get());
     };
 
     infer_type_func_ = GenericInferType;
-
-    return RC_SUCCESS;
 }
 
 RetCode GemmOp::OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_refcount) {
-    if (fc_param_ && fc_param_->algo_info.algo_type != ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
+    if (IsInt8AlgoSelected() || IsBf16AlgoSelected() ||
+        (fc_param_ && fc_param_->algo_info.algo_type != ppl::kernel::x86::fc_fp32_algo::UNKNOWN)) {
         auto weight_id = GetNode()->GetInput(1);
         auto it = constants_data_refcount->find(weight_id);
         if (it != constants_data_refcount->end()) {
@@ -119,6 +223,16 @@ RetCode GemmOp::OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_re
 
 bool GemmOp::TryFuseReLU() {
     gemm_fuse_relu_ = true;
+    if (IsInt8AlgoSelected()) {
+        ppl::kernel::x86::fc_int8_param param = fc_int8_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::fc_fuse_flag::RELU;
+        fc_int8_param_->mgr->set_param(param);
+    }
+    if (IsBf16AlgoSelected()) {
+        ppl::kernel::x86::fc_bf16_param param = fc_bf16_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::fc_fuse_flag::RELU;
+        fc_bf16_param_->mgr->set_param(param);
+    }
     if (fc_param_ && fc_param_->algo_info.algo_type != ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
         ppl::kernel::x86::fc_fp32_param param = fc_param_->mgr->param();
         param.fuse_flag |= ppl::kernel::x86::fc_fuse_flag::RELU;
@@ -128,13 +242,215 @@ bool GemmOp::TryFuseReLU() {
 }
 
 KernelImpl* GemmOp::CreateKernelImpl() const {
+    if (IsInt8AlgoSelected()) {
+        return CreateKernelImplWithParam<FCInt8Kernel>(fc_int8_param_);
+    }
+    if (IsBf16AlgoSelected()) {
+        return CreateKernelImplWithParam<FCBf16Kernel>(fc_bf16_param_);
+    }
     if (fc_param_ && fc_param_->algo_info.algo_type != ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
         return CreateKernelImplWithParam<FCKernel>(fc_param_);
     } else {
         auto kernel = CreateKernelImplWithParam<GemmKernel>(param_.get());
         kernel->SetFuseReLU(gemm_fuse_relu_);
+        kernel->SetForwardPrecision(forward_precision_);
         return kernel;
     }
 }
 
+#ifdef PPLNN_ENABLE_PMX_MODEL
+enum {
+    GEMM_PMX_ALGO_GENERIC = 0,
+    GEMM_PMX_ALGO_FP32 = 1,
+    GEMM_PMX_ALGO_INT8 = 2,
+    GEMM_PMX_ALGO_BF16 = 3,
+};
+
+static RetCode DeserializeFCParam(PmxDataReader* reader, ppl::common::Allocator* allocator, FCParam* fc_param) {
+    ppl::kernel::x86::fc_fp32_param fused_param;
+    if (!reader->Read(&fc_param->param) || !reader->Read(&fc_param->algo_info) || !reader->Read(&fused_param)) {
+        return RC_INVALID_VALUE;
+    }
+
+    uint64_t filter_size = 0, bias_size = 0;
+    auto filter = reader->ReadArray<float>(&filter_size);
+    auto bias = reader->ReadArray<float>(&bias_size);
+    if (!filter || !bias || filter_size == 0 || bias_size == 0) {
+        return RC_INVALID_VALUE;
+    }
+
+    fc_param->mgr = ppl::kernel::x86::fc_algo_selector::gen_algo(fc_param->param, fc_param->algo_info, allocator);
+    if (!fc_param->mgr) {
+        return RC_UNSUPPORTED;
+    }
+    fc_param->mgr->set_param(fused_param);
+
+    auto cvt_filter = (float*)allocator->Alloc(filter_size * sizeof(float));
+    if (!cvt_filter) {
+        return RC_OUT_OF_MEMORY;
+    }
+    auto cvt_bias = (float*)allocator->Alloc(bias_size * sizeof(float));
+    if (!cvt_bias) {
+        allocator->Free(cvt_filter);
+        return RC_OUT_OF_MEMORY;
+    }
+
+    memcpy(cvt_filter, filter, filter_size * sizeof(float));
+    memcpy(cvt_bias, bias, bias_size * sizeof(float));
+    fc_param->mgr->set_cvt_filter(cvt_filter, filter_size);
+    fc_param->mgr->set_cvt_bias(cvt_bias, bias_size);
+    return RC_SUCCESS;
+}
+
+static RetCode DeserializeFCInt8Param(PmxDataReader* reader, ppl::common::Allocator* allocator,
+                                      FCInt8Param* fc_param) {
+    ppl::kernel::x86::fc_int8_param fused_param;
+    if (!reader->Read(&fc_param->param) || !reader->Read(&fc_param->algo_info) || !reader->Read(&fused_param)) {
+        return RC_INVALID_VALUE;
+    }
+
+    uint64_t cvt_weights_bytes = 0;
+    auto cvt_weights = reader->ReadArray<uint8_t>(&cvt_weights_bytes);
+    if (!cvt_weights) {
+        return RC_INVALID_VALUE;
+    }
+
+    fc_param->mgr = ppl::kernel::x86::fc_int8_algo_selector::gen_algo(fc_param->param, fc_param->algo_info, allocator);
+    if (!fc_param->mgr) {
+        return RC_UNSUPPORTED;
+    }
+    fc_param->mgr->set_param(fused_param);
+    return fc_param->mgr->set_cvt_weights(cvt_weights, cvt_weights_bytes);
+}
+
+static RetCode DeserializeFCBf16Param(PmxDataReader* reader, ppl::common::Allocator* allocator,
+                                      FCBf16Param* fc_param) {
+    ppl::kernel::x86::fc_bf16_param fused_param;
+    if (!reader->Read(&fc_param->param) || !reader->Read(&fc_param->algo_info) || !reader->Read(&fused_param)) {
+        return RC_INVALID_VALUE;
+    }
+
+    uint64_t cvt_weights_bytes = 0;
+    auto cvt_weights = reader->ReadArray<uint8_t>(&cvt_weights_bytes);
+    if (!cvt_weights) {
+        return RC_INVALID_VALUE;
+    }
+
+    fc_param->mgr = ppl::kernel::x86::fc_bf16_algo_selector::gen_algo(fc_param->param, fc_param->algo_info, allocator);
+    if (!fc_param->mgr) {
+        return RC_UNSUPPORTED;
+    }
+    fc_param->mgr->set_param(fused_param);
+    return fc_param->mgr->set_cvt_weights(cvt_weights, cvt_weights_bytes);
+}
+
+RetCode GemmOp::SerializeData(const pmx::SerializationContext&, utils::DataStream* ds) const {
+    PmxDataWriter writer;
+    SerializeCommonParam(&writer);
+    writer.Write<uint8_t>(gemm_fuse_relu_ ? 1 : 0);
+    writer.Write<uint32_t>(forward_precision_);
+
+    if (IsInt8AlgoSelected()) {
+        auto mgr = fc_int8_param_->mgr;
+        writer.Write<uint32_t>(GEMM_PMX_ALGO_INT8);
+        writer.Write(fc_int8_param_->param);
+        writer.Write(fc_int8_param_->algo_info);
+        writer.Write(mgr->param());
+        writer.WriteArray((const uint8_t*)mgr->cvt_weights(), mgr->cvt_weights_bytes());
+    } else if (IsBf16AlgoSelected()) {
+        auto mgr = fc_bf16_param_->mgr;
+        writer.Write<uint32_t>(GEMM_PMX_ALGO_BF16);
+        writer.Write(fc_bf16_param_->param);
+        writer.Write(fc_bf16_param_->algo_info);
+        writer.Write(mgr->param());
+        writer.WriteArray((const uint8_t*)mgr->cvt_weights(), mgr->cvt_weights_bytes());
+    } else if (fc_param_ && fc_param_->algo_info.algo_type != ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
+        auto mgr = fc_param_->mgr;
+        writer.Write<uint32_t>(GEMM_PMX_ALGO_FP32);
+        writer.Write(fc_param_->param);
+        writer.Write(fc_param_->algo_info);
+        writer.Write(mgr->param());
+        writer.WriteArray(mgr->cvt_filter(), mgr->cvt_filter_size());
+        writer.WriteArray(mgr->cvt_bias(), mgr->cvt_bias_size());
+    } else {
+        writer.Write<uint32_t>(GEMM_PMX_ALGO_GENERIC);
+    }
+
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_param = pmx::onnx::SerializeGemmParam(*param_, &builder);
+    auto fb_data = builder.CreateVector(writer.GetData());
+    auto fb_op_param = pmx::onnx::CreateOpParam(builder, pmx::onnx::OpParamType_GemmParam, fb_param.Union(), fb_data);
+    pmx::onnx::FinishOpParamBuffer(builder, fb_op_param);
+    return ds->Write(builder.GetBufferPointer(), builder.GetSize());
+}
+
+RetCode GemmOp::DeserializeData(const pmx::DeserializationContext&, const void* base, uint64_t size) {
+    auto node = GetNode();
+
+    flatbuffers::Verifier verifier((const uint8_t*)base, size);
+    if (!pmx::onnx::VerifyOpParamBuffer(verifier)) {
+        LOG(ERROR) << "invalid data of Gemm[" << node->GetName() << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    auto fb_op_param = pmx::onnx::GetOpParam(base);
+    auto fb_gemm_param = fb_op_param->value_as_GemmParam();
+    if (!fb_gemm_param || !fb_op_param->data_()) {
+        LOG(ERROR) << "param of Gemm[" << node->GetName() << "] not found";
+        return RC_NOT_FOUND;
+    }
+
+    param_ = make_shared<ppl::nn::common::GemmParam>();
+    pmx::onnx::DeserializeGemmParam(*fb_gemm_param, param_.get());
+    param_->bias_term = (node->GetInputCount() == 3) ? 1 : 0;
+    SetInferFuncs();
+
+    PmxDataReader reader(fb_op_param->data_()->data(), fb_op_param->data_()->size());
+    auto status = DeserializeCommonParam(&reader);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    uint8_t fuse_relu = 0;
+    uint32_t forward_precision = DATATYPE_FLOAT32;
+    uint32_t algo = GEMM_PMX_ALGO_GENERIC;
+    if (!reader.Read(&fuse_relu) || !reader.Read(&forward_precision) || !reader.Read(&algo)) {
+        LOG(ERROR) << "read algorithm of Gemm[" << node->GetName() << "] failed";
+        return RC_INVALID_VALUE;
+    }
+    gemm_fuse_relu_ = (fuse_relu != 0);
+    forward_precision_ = forward_precision;
+
+    if (algo == GEMM_PMX_ALGO_GENERIC) {
+        return RC_SUCCESS;
+    }
+
+    if (!device_) {
+        LOG(ERROR) << "device of Gemm[" << node->GetName() << "] is not set";
+        return RC_INVALID_VALUE;
+    }
+
+    if (algo == GEMM_PMX_ALGO_FP32) {
+        fc_param_ = new FCParam;
+        status = DeserializeFCParam(&reader, device_->GetAllocator(), fc_param_);
+    } else if (algo == GEMM_PMX_ALGO_INT8) {
+        fc_int8_param_ = new FCInt8Param;
+        status = DeserializeFCInt8Param(&reader, device_->GetAllocator(), fc_int8_param_);
+    } else if (algo == GEMM_PMX_ALGO_BF16) {
+        fc_bf16_param_ = new FCBf16Param;
+        status = DeserializeFCBf16Param(&reader, device_->GetAllocator(), fc_bf16_param_);
+    } else {
+        LOG(ERROR) << "unknown algorithm[" << algo << "] of Gemm[" << node->GetName() << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "restore converted weights of Gemm[" << node->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    return RC_SUCCESS;
+}
+#endif
+
 }}} // namespace ppl::nn::x86
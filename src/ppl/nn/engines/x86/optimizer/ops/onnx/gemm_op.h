@@ -26,17 +26,37 @@ namespace ppl { namespace nn { namespace x86 {
 
 class GemmOp final : public X86OptKernel {
 public:
-    GemmOp(const ir::Node* node) : X86OptKernel(node), fc_param_(nullptr) {}
+    GemmOp(const ir::Node* node)
+        : X86OptKernel(node), fc_param_(nullptr), fc_int8_param_(nullptr), fc_bf16_param_(nullptr) {}
     ~GemmOp();
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
     ppl::common::RetCode OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_refcount) override;
     bool TryFuseReLU();
 
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    ppl::common::RetCode SerializeData(const pmx::SerializationContext&, utils::DataStream*) const override;
+    ppl::common::RetCode DeserializeData(const pmx::DeserializationContext&, const void*, uint64_t) override;
+#endif
+
+private:
+    void SetInferFuncs();
+    bool TrySelectInt8Algorithm(const OptKernelOptions& options, const float* weight_data, const float* bias_data);
+    bool IsInt8AlgoSelected() const {
+        return fc_int8_param_ && fc_int8_param_->algo_info.algo_type != ppl::kernel::x86::fc_int8_algo::UNKNOWN;
+    }
+    bool TrySelectBf16Algorithm(const OptKernelOptions& options, const float* weight_data, const float* bias_data);
+    bool IsBf16AlgoSelected() const {
+        return fc_bf16_param_ && fc_bf16_param_->algo_info.algo_type != ppl::kernel::x86::fc_bf16_algo::UNKNOWN;
+    }
+
 private:
     FCParam* fc_param_;
+    FCInt8Param* fc_int8_param_;
+    FCBf16Param* fc_bf16_param_;
     std::shared_ptr<ppl::nn::common::GemmParam> param_;
     bool gemm_fuse_relu_ = false;
+    ppl::common::datatype_t forward_precision_ = ppl::common::DATATYPE_FLOAT32;
 };
 
 }}} // namespace ppl::nn::x86
@@ -17,13 +17,61 @@
 
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/matmul_op.h"
 #include "ppl/nn/engines/x86/kernels/onnx/matmul_kernel.h"
+#include "ppl/nn/engines/utils.h"
 #include "ppl/nn/oputils/onnx/reshape_matmul.h"
+#include "ppl/kernel/x86/fp32/matmul.h"
+#include <cstring>
 using namespace std;
 using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace x86 {
 
+void MatMulOp::TryPackConstantB(const OptKernelOptions& options) {
+    auto node = GetNode();
+    auto graph_data = options.graph_data;
+    if (!graph_data) {
+        return;
+    }
+
+    auto b_data_it = graph_data->constants.find(node->GetInput(1));
+    auto b_shape_it = graph_data->shapes.find(node->GetInput(1));
+    if (b_data_it == graph_data->constants.end() || b_shape_it == graph_data->shapes.end() ||
+        b_shape_it->second.data_type != DATATYPE_FLOAT32) {
+        return;
+    }
+
+    TensorShape b_shape;
+    utils::IrShape2TensorShape(b_shape_it->second, &b_shape);
+    const uint64_t packed_bytes = kernel::x86::matmul_ndarray_fp32_get_packed_b_bytes(&b_shape, options.device->GetISA());
+    if (packed_bytes == 0 || b_data_it->second.data.size() != b_shape.GetBytesExcludingPadding()) {
+        return;
+    }
+
+    auto allocator = options.device->GetAllocator();
+    auto packed_b = allocator->Alloc(packed_bytes);
+    if (!packed_b) {
+        LOG(WARNING) << "MatMul[" << node->GetName() << "] alloc packed B failed, B will be packed in every run";
+        return;
+    }
+
+    auto status = kernel::x86::matmul_ndarray_fp32_pack_b(&b_shape, (const float*)b_data_it->second.data.data(),
+                                                          options.device->GetISA(), packed_b);
+    if (status != RC_SUCCESS) {
+        LOG(WARNING) << "MatMul[" << node->GetName() << "] pack B failed: " << GetRetCodeStr(status)
+                     << ", B will be packed in every run";
+        allocator->Free(packed_b);
+        return;
+    }
+
+    param_.reset(new MatMulParam);
+    param_->packed_b = packed_b;
+    param_->packed_b_bytes = packed_bytes;
+    param_->allocator = allocator;
+}
+
 RetCode MatMulOp::Init(const OptKernelOptions& options) {
+    TryPackConstantB(options);
+
     infer_dims_func_ = [](InputOutputInfo* info) -> RetCode {
         return oputils::ReshapeMatMul(info, nullptr);
     };
@@ -33,8 +81,66 @@ RetCode MatMulOp::Init(const OptKernelOptions& options) {
     return RC_SUCCESS;
 }
 
+RetCode MatMulOp::OmitConstantsData(std::map<edgeid_t, int64_t>* constants_data_refcount) {
+    if (param_) {
+        auto it = constants_data_refcount->find(GetNode()->GetInput(1));
+        if (it != constants_data_refcount->end()) {
+            it->second--;
+        }
+    }
+    return RC_SUCCESS;
+}
+
 KernelImpl* MatMulOp::CreateKernelImpl() const {
+    if (param_) {
+        return CreateKernelImplWithParam<MatMulKernel>(param_.get());
+    }
     return CreateKernelImplWithoutParam<MatMulKernel>();
 }
 
+#ifdef PPLNN_ENABLE_PMX_MODEL
+// B is omitted from constants after being packed, so the packed data is saved instead. it is packed with the isa
+// saved by the engine, which is restored before ops are deserialized.
+void MatMulOp::SerializePrivateData(PmxDataWriter* writer) const {
+    if (param_) {
+        writer->WriteArray((const uint8_t*)param_->packed_b, param_->packed_b_bytes);
+    } else {
+        writer->WriteArray((const uint8_t*)nullptr, 0);
+    }
+}
+
+RetCode MatMulOp::DeserializePrivateData(PmxDataReader* reader) {
+    auto node = GetNode();
+
+    uint64_t packed_bytes = 0;
+    auto packed_data = reader->ReadArray<uint8_t>(&packed_bytes);
+    if (!packed_data) {
+        LOG(ERROR) << "read packed B of MatMul[" << node->GetName() << "] failed.";
+        return RC_INVALID_VALUE;
+    }
+    if (packed_bytes == 0) {
+        return RC_SUCCESS;
+    }
+
+    if (!device_) {
+        LOG(ERROR) << "device of MatMul[" << node->GetName() << "] is not set";
+        return RC_INVALID_VALUE;
+    }
+
+    auto allocator = device_->GetAllocator();
+    auto packed_b = allocator->Alloc(packed_bytes);
+    if (!packed_b) {
+        LOG(ERROR) << "alloc packed B of MatMul[" << node->GetName() << "] failed.";
+        return RC_OUT_OF_MEMORY;
+    }
+    memcpy(packed_b, packed_data, packed_bytes);
+
+    param_.reset(new MatMulParam);
+    param_->packed_b = packed_b;
+    param_->packed_b_bytes = packed_bytes;
+    param_->allocator = allocator;
+    return RC_SUCCESS;
+}
+#endif
+
 }}} // namespace ppl::nn::x86
@@ -18,6 +18,7 @@
 #ifndef _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_ONNX_MATMUL_OP_H_
 #define _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_ONNX_MATMUL_OP_H_
 
+#include "ppl/nn/engines/x86/params/matmul_param.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
 
 namespace ppl { namespace nn { namespace x86 {
@@ -27,6 +28,18 @@ public:
     MatMulOp(const ir::Node* node) : X86OptKernel(node) {}
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
+    ppl::common::RetCode OmitConstantsData(std::map<edgeid_t, int64_t>* constants_data_refcount) override;
+
+private:
+    void TryPackConstantB(const OptKernelOptions& options);
+
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    void SerializePrivateData(PmxDataWriter*) const override;
+    ppl::common::RetCode DeserializePrivateData(PmxDataReader*) override;
+#endif
+
+private:
+    std::unique_ptr<MatMulParam> param_;
 };
 
 }}} // namespace ppl::nn::x86
@@ -28,6 +28,9 @@ public:
     SqueezeOp(const ir::Node* node) : X86OptKernel(node) {}
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
+    bool MayTransferBuffers() const override {
+        return true;
+    }
 
 private:
     std::shared_ptr<ppl::nn::common::SqueezeParam> param_;
@@ -27,6 +27,9 @@ public:
     SubOp(const ir::Node* node) : X86OptKernel(node) {}
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
+    bool MayTransferBuffers() const override {
+        return true;
+    }
     ppl::common::RetCode SelectFormat(const InputOutputInfo& info,
                                       std::vector<ppl::common::dataformat_t>* selected_input_formats,
                                       std::vector<ppl::common::dataformat_t>* selected_output_formats) override;
@@ -39,6 +42,15 @@ public:
     }
 
 private:
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    void SerializePrivateData(PmxDataWriter* writer) const override {
+        writer->Write(fuse_relu_);
+    }
+    ppl::common::RetCode DeserializePrivateData(PmxDataReader* reader) override {
+        return reader->Read(&fuse_relu_) ? ppl::common::RC_SUCCESS : ppl::common::RC_INVALID_VALUE;
+    }
+#endif
+
     bool fuse_relu_ = false;
 };
 
@@ -0,0 +1,57 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/attention_op.h"
+#include "ppl/nn/engines/x86/kernels/ppl/attention_kernel.h"
+#include "ppl/nn/common/logger.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+RetCode AttentionOp::Init(const OptKernelOptions& options) {
+    auto status = GenericLoadParam(options, &param_);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "load param failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    infer_type_func_ = GenericInferType;
+
+    infer_dims_func_ = [](InputOutputInfo* info) -> RetCode {
+        // Q: [batch..., S, D], K: [batch..., D, T], V: [batch..., T, Dv] => Y: [batch..., S, Dv]
+        auto& q_shape = *info->GetInput<TensorImpl>(0)->GetShape();
+        auto& v_shape = *info->GetInput<TensorImpl>(2)->GetShape();
+        auto& y_shape = *info->GetOutput<TensorImpl>(0)->GetShape();
+        const uint32_t dim_count = q_shape.GetDimCount();
+        if (dim_count < 2 || v_shape.GetDimCount() != dim_count) {
+            LOG(DEBUG) << "invalid input dim count of Attention";
+            return RC_INVALID_VALUE;
+        }
+        y_shape.Reshape(q_shape.GetDims(), dim_count);
+        y_shape.SetDim(dim_count - 1, v_shape.GetDim(dim_count - 1));
+        return RC_SUCCESS;
+    };
+
+    return RC_SUCCESS;
+}
+
+KernelImpl* AttentionOp::CreateKernelImpl() const {
+    return CreateKernelImplWithParam<AttentionKernel>(param_.get());
+}
+
+}}} // namespace ppl::nn::x86
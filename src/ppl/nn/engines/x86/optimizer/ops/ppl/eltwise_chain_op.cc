@@ -0,0 +1,44 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/eltwise_chain_op.h"
+#include "ppl/nn/engines/x86/kernels/ppl/eltwise_chain_kernel.h"
+#include "ppl/nn/oputils/onnx/reshape_sum.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+RetCode EltwiseChainOp::Init(const OptKernelOptions& options) {
+    infer_dims_func_ = [](InputOutputInfo* info) -> RetCode {
+        // output is all inputs broadcasted together
+        if (info->GetInputCount() == 1) {
+            return GenericInferDims(info);
+        }
+        return oputils::ReshapeSum(info, nullptr);
+    };
+
+    infer_type_func_ = GenericInferType;
+
+    return RC_SUCCESS;
+}
+
+KernelImpl* EltwiseChainOp::CreateKernelImpl() const {
+    return CreateKernelImplWithParam<EltwiseChainKernel>(&param_);
+}
+
+}}} // namespace ppl::nn::x86
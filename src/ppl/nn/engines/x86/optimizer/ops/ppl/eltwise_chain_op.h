@@ -0,0 +1,57 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_PPL_ELTWISE_CHAIN_OP_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_PPL_ELTWISE_CHAIN_OP_H_
+
+#include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
+#include "ppl/nn/engines/x86/params/eltwise_chain_param.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+class EltwiseChainOp final : public X86OptKernel {
+public:
+    EltwiseChainOp(const ir::Node* node) : X86OptKernel(node) {}
+    ppl::common::RetCode Init(const OptKernelOptions& options) override;
+    KernelImpl* CreateKernelImpl() const override;
+
+    void SetEltwiseChainParam(const EltwiseChainParam& param) {
+        param_ = param;
+    }
+
+private:
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    void SerializePrivateData(PmxDataWriter* writer) const override {
+        writer->WriteArray(param_.ops.data(), param_.ops.size());
+    }
+    ppl::common::RetCode DeserializePrivateData(PmxDataReader* reader) override {
+        uint64_t count = 0;
+        auto ops = reader->ReadArray<ppl::kernel::x86::eltwise_chain_op>(&count);
+        if (!ops) {
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        param_.ops.assign(ops, ops + count);
+        return ppl::common::RC_SUCCESS;
+    }
+#endif
+
+    EltwiseChainParam param_;
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
@@ -17,6 +17,7 @@
 
 #include "ppl/nn/engines/x86/optimizer/ops/ppl/reorder_op.h"
 #include "ppl/nn/engines/x86/kernels/ppl/reorder_kernel.h"
+#include "ppl/nn/common/logger.h"
 using namespace std;
 using namespace ppl::common;
 
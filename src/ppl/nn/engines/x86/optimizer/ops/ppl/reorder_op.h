@@ -27,6 +27,9 @@ public:
     ReorderOp(const ir::Node* node) : X86OptKernel(node) {}
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
+    bool MayTransferBuffers() const override {
+        return true;
+    }
 };
 
 }}} // namespace ppl::nn::x86
@@ -36,6 +36,15 @@ public:
     };
 
 private:
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    void SerializePrivateData(PmxDataWriter* writer) const override {
+        writer->Write(param_->beta);
+    }
+    ppl::common::RetCode DeserializePrivateData(PmxDataReader* reader) override {
+        return reader->Read(&param_->beta) ? ppl::common::RC_SUCCESS : ppl::common::RC_INVALID_VALUE;
+    }
+#endif
+
     std::shared_ptr<ppl::nn::common::SwishParam> param_;
 };
 
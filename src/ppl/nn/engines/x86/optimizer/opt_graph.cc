@@ -16,6 +16,7 @@
 // under the License.
 
 #include <string.h>
+#include <set>
 
 #include "ppl/nn/engines/x86/optimizer/opt_graph.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel_creator_manager.h"
@@ -169,9 +170,56 @@ RetCode OptGraph::TryToInferDims(X86Device* device) {
     return RC_SUCCESS;
 }
 
-RetCode OptGraph::DoOptimize(X86Device* device) {
+void OptGraph::CollectFixedShapes() {
+    auto topo = graph_->topo.get();
+
+    set<edgeid_t> excluded_edges;
+    for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        // inputs and outputs of ops which may transfer buffers are allocated by device
+        auto kernel_ref = info_->kernels.find(node->GetId());
+        if (kernel_ref != info_->kernels.end() && ((X86OptKernel*)(kernel_ref->second.get()))->MayTransferBuffers()) {
+            for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+                excluded_edges.insert(node->GetInput(i));
+            }
+            for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+                excluded_edges.insert(node->GetOutput(i));
+            }
+        }
+    }
+
+    for (auto it = tensor_impls_.begin(); it != tensor_impls_.end(); ++it) {
+        auto edge_id = it->first;
+        if (!topo->GetEdgeById(edge_id) || excluded_edges.find(edge_id) != excluded_edges.end() ||
+            graph_->data->constants.find(edge_id) != graph_->data->constants.end()) {
+            continue;
+        }
+
+        auto shape = it->second->GetShape();
+        if (shape->GetDimCount() == 0 || shape->GetDataType() == DATATYPE_UNKNOWN) {
+            continue;
+        }
+
+        bool is_fixed = true;
+        for (uint32_t i = 0; i < shape->GetDimCount(); ++i) {
+            if (shape->GetDim(i) <= 0) {
+                is_fixed = false;
+                break;
+            }
+        }
+        if (is_fixed) {
+            info_->shapes.insert(make_pair(edge_id, *shape));
+        }
+    }
+}
+
+RetCode OptGraph::DoOptimize(const X86EngineOptions& engine_options, const QuantParamInfo* quant_info,
+                             AlgoSelectMap* algos, X86Device* device) {
     OptKernelOptions options;
     options.resource = resource_;
+    options.quant_info = quant_info;
+    options.engine_options = &engine_options;
+    options.algos = algos;
     options.graph_data = graph_->data.get();
     options.graph_topo = graph_->topo.get();
     options.tensors = &tensor_impls_;
@@ -239,6 +287,9 @@ RetCode OptGraph::DoOptimize(X86Device* device) {
         }
     }
 
+    // shapes are used to generate a static memory plan for models with fixed input shapes
+    CollectFixedShapes();
+
     return RC_SUCCESS;
 }
 
@@ -32,13 +32,14 @@ class OptGraph final {
 public:
     OptGraph() : tensor_getter_(&tensor_impls_) {}
     ppl::common::RetCode Init(const utils::SharedResource*, ir::Graph*, RuntimePartitionInfo*);
-    ppl::common::RetCode DoOptimize(X86Device*);
+    ppl::common::RetCode DoOptimize(const X86EngineOptions&, const QuantParamInfo*, AlgoSelectMap*, X86Device*);
 
 private:
     ppl::common::RetCode InitKernels(const ir::Graph* graph);
     ppl::common::RetCode InitTensorImpls();
     ppl::common::RetCode TryToInferType(X86Device* device);
     ppl::common::RetCode TryToInferDims(X86Device* device);
+    void CollectFixedShapes();
 
 private:
     const utils::SharedResource* resource_ = nullptr;
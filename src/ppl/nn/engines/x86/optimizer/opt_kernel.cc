@@ -16,7 +16,9 @@
 // under the License.
 
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
+#include "ppl/nn/common/logger.h"
 #include "ppl/common/sys.h"
+#include <math.h>
 using namespace std;
 using namespace ppl::common;
 
@@ -26,4 +28,129 @@ X86OptKernel::X86OptKernel(const ir::Node* node) : OptKernel(node) {
     common_param_.output_formats.resize(node->GetOutputCount(), DATAFORMAT_NDARRAY);
 }
 
+static bool GetDoubleField(const QuantParam& param, const char* name, double* value) {
+    auto it = param.fields.find(name);
+    if (it == param.fields.end() || it->second.content.size() < sizeof(double)) {
+        return false;
+    }
+    *value = *(const double*)(it->second.content.data());
+    return true;
+}
+
+bool X86OptKernel::GetInputQuantScale(const OptKernelOptions& options, uint32_t idx, float* scale) const {
+    if (!options.quant_info) {
+        return false;
+    }
+
+    auto node = GetNode();
+    auto& node_params = options.quant_info->node_params;
+    auto node_it = node_params.find(node->GetName());
+    if (node_it != node_params.end()) {
+        auto type_it = node_it->second.fields.find("data_type");
+        if (type_it != node_it->second.fields.end() && type_it->second.content != "INT8") {
+            return false;
+        }
+    }
+
+    auto edge = options.graph_topo->GetEdgeById(node->GetInput(idx));
+    if (!edge) {
+        return false;
+    }
+    auto& tensor_params = options.quant_info->tensor_params;
+    auto tensor_it = tensor_params.find(edge->GetName());
+    if (tensor_it == tensor_params.end()) {
+        return false;
+    }
+    auto& param = tensor_it->second;
+
+    // only symmetric per-tensor 8-bit activations are supported
+    auto per_channel_it = param.fields.find("per_channel");
+    if (per_channel_it != param.fields.end() && !per_channel_it->second.content.empty() &&
+        *(const bool*)(per_channel_it->second.content.data())) {
+        return false;
+    }
+    auto bit_width_it = param.fields.find("bit_width");
+    if (bit_width_it != param.fields.end() && bit_width_it->second.content.size() >= sizeof(int32_t) &&
+        *(const int32_t*)(bit_width_it->second.content.data()) != 8) {
+        return false;
+    }
+
+    double tensor_max, tensor_min, tensor_scale;
+    if (GetDoubleField(param, "tensor_max", &tensor_max) && GetDoubleField(param, "tensor_min", &tensor_min)) {
+        tensor_scale = max(fabs(tensor_max), fabs(tensor_min)) / 127.0;
+    } else if (!GetDoubleField(param, "scale", &tensor_scale)) {
+        return false;
+    }
+
+    if (!(tensor_scale > 0.0)) {
+        LOG(WARNING) << "invalid quant scale[" << tensor_scale << "] of tensor[" << edge->GetName() << "]";
+        return false;
+    }
+
+    *scale = (float)tensor_scale;
+    return true;
+}
+
+#ifdef PPLNN_ENABLE_PMX_MODEL
+void X86OptKernel::SerializeCommonParam(PmxDataWriter* writer) const {
+    writer->Write<uint32_t>(common_param_.output_formats.size());
+    for (auto x = common_param_.output_formats.begin(); x != common_param_.output_formats.end(); ++x) {
+        writer->Write<uint32_t>(*x);
+    }
+}
+
+RetCode X86OptKernel::DeserializeCommonParam(PmxDataReader* reader) {
+    uint32_t format_count = 0;
+    if (!reader->Read(&format_count) || format_count != common_param_.output_formats.size()) {
+        LOG(ERROR) << "output format count of op[" << GetNode()->GetName() << "] mismatch.";
+        return RC_INVALID_VALUE;
+    }
+    for (uint32_t i = 0; i < format_count; ++i) {
+        uint32_t format;
+        if (!reader->Read(&format)) {
+            LOG(ERROR) << "read output format of op[" << GetNode()->GetName() << "] failed.";
+            return RC_INVALID_VALUE;
+        }
+        common_param_.output_formats[i] = format;
+    }
+    return RC_SUCCESS;
+}
+
+RetCode X86OptKernel::SerializeData(const pmx::SerializationContext&, utils::DataStream* ds) const {
+    if (has_param_) {
+        LOG(ERROR) << "serializing params of op[" << GetNode()->GetName() << "] of type[" << GetNode()->GetType().name
+                   << "] is not supported.";
+        return RC_UNSUPPORTED;
+    }
+
+    PmxDataWriter writer;
+    SerializeCommonParam(&writer);
+    SerializePrivateData(&writer);
+    auto& data = writer.GetData();
+    return ds->Write(data.data(), data.size());
+}
+
+RetCode X86OptKernel::DeserializeData(const pmx::DeserializationContext&, const void* base, uint64_t size) {
+    auto status = Init(OptKernelOptions());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "init op[" << GetNode()->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    PmxDataReader reader(base, size);
+    status = DeserializeCommonParam(&reader);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    status = DeserializePrivateData(&reader);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "read private data of op[" << GetNode()->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    return RC_SUCCESS;
+}
+#endif
+
 }}} // namespace ppl::nn::x86
@@ -22,9 +22,16 @@
 #include "ppl/nn/runtime/tensor_impl.h"
 #include "ppl/nn/engines/x86/x86_device.h"
 #include "ppl/nn/engines/x86/x86_common_param.h"
+#include "ppl/nn/engines/x86/x86_engine_options.h"
+#include "ppl/nn/engines/x86/algo_select.h"
 #include "ppl/nn/runtime/runtime_partition_info.h"
+#include "ppl/nn/quantization/quant_param_info.h"
 #include <functional>
 
+#ifdef PPLNN_ENABLE_PMX_MODEL
+#include "ppl/nn/engines/x86/pmx_data.h"
+#endif
+
 namespace ppl { namespace nn { namespace utils {
 struct SharedResource;
 }}} // namespace ppl::nn::utils
@@ -38,6 +45,9 @@ struct OptKernelOptions final {
     X86Device* device = nullptr;
     RuntimePartitionInfo* info = nullptr;
     std::map<edgeid_t, std::unique_ptr<TensorImpl>>* tensors = nullptr;
+    const QuantParamInfo* quant_info = nullptr;
+    const X86EngineOptions* engine_options = nullptr;
+    AlgoSelectMap* algos = nullptr; // algorithms imported or selected by dynamic tuning
 };
 
 class X86OptKernel : public OptKernel {
@@ -78,20 +88,36 @@ public:
         return ppl::common::RC_SUCCESS;
     }
 
-#ifdef PPLNN_ENABLE_PMX_MODEL
-    ppl::common::RetCode SerializeData(const pmx::SerializationContext&, utils::DataStream*) const override {
-        return ppl::common::RC_UNSUPPORTED;
+    /**
+       @brief tells whether kernels of this op may transfer buffers of inputs to outputs instead of copying data,
+       which makes tensors outlive their planned lifetimes. ops doing so MUST override this function.
+    */
+    virtual bool MayTransferBuffers() const {
+        return false;
     }
-    ppl::common::RetCode DeserializeData(const pmx::DeserializationContext&, const void*, uint64_t) override {
-        return ppl::common::RC_UNSUPPORTED;
+
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    /**
+       @brief saves output formats and private data of ops without params, which are restored by calling `Init()`
+       in `DeserializeData()`. ops with params or states that `Init()` cannot restore MUST override both functions.
+    */
+    ppl::common::RetCode SerializeData(const pmx::SerializationContext&, utils::DataStream*) const override;
+    ppl::common::RetCode DeserializeData(const pmx::DeserializationContext&, const void*, uint64_t) override;
+
+    /** @brief device used to allocate converted weights when restoring ops in `DeserializeData()` */
+    void SetDevice(const X86Device* device) {
+        device_ = device;
     }
 #endif
 
 protected:
     template <typename T>
-    ppl::common::RetCode GenericLoadParam(const OptKernelOptions& options, std::shared_ptr<T>* param) const {
+    ppl::common::RetCode GenericLoadParam(const OptKernelOptions& options, std::shared_ptr<T>* param) {
         auto node = GetNode();
         auto graph_data = options.graph_data;
+        if (!graph_data) {
+            return ppl::common::RC_NOT_FOUND;
+        }
 
         auto param_ref = graph_data->attrs.find(node->GetId());
         if (param_ref == graph_data->attrs.end()) {
@@ -99,6 +125,7 @@ protected:
         }
 
         *param = std::static_pointer_cast<T>(param_ref->second);
+        has_param_ = true;
         return ppl::common::RC_SUCCESS;
     }
 
@@ -131,6 +158,24 @@ protected:
         return kernel;
     }
 
+    /**
+       @brief get the per-tensor int8 scale of input `idx` from quantization info.
+       @return false if this node should not run in int8.
+    */
+    bool GetInputQuantScale(const OptKernelOptions& options, uint32_t idx, float* scale) const;
+
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    /** @brief saves output formats selected by the optimizer into private data of this op */
+    void SerializeCommonParam(PmxDataWriter*) const;
+    ppl::common::RetCode DeserializeCommonParam(PmxDataReader*);
+
+    /** @brief saves states set by graph optimizations, e.g. fused activations, in the default `SerializeData()` */
+    virtual void SerializePrivateData(PmxDataWriter*) const {}
+    virtual ppl::common::RetCode DeserializePrivateData(PmxDataReader*) {
+        return ppl::common::RC_SUCCESS;
+    }
+#endif
+
     static ppl::common::RetCode GenericInferDims(InputOutputInfo* info) {
         auto& in_shape0 = *info->GetInput<TensorImpl>(0)->GetShape();
         for (uint32_t i = 0; i < info->GetOutputCount(); ++i) {
@@ -156,6 +201,12 @@ protected:
     std::function<void(InputOutputInfo*)> infer_type_func_;
     std::function<ppl::common::RetCode(InputOutputInfo*)> infer_dims_func_;
     X86CommonParam common_param_;
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    const X86Device* device_ = nullptr;
+#endif
+
+private:
+    bool has_param_ = false; // params are loaded from graph data by `GenericLoadParam()`
 };
 
 }}} // namespace ppl::nn::x86
@@ -42,6 +42,7 @@
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/gather_nd_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/gemm_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/greater_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/gru_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/identity_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/if_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/leaky_relu_op.h"
@@ -71,6 +72,7 @@
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/relu_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/reshape_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/resize_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/rnn_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/scatter_elements_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/scatter_nd_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/sequence_at_op.h"
@@ -100,6 +102,9 @@
 #include "ppl/nn/engines/x86/optimizer/ops/ppl/shape_operation_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/ppl/swish_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/ppl/post_depthwise_conv_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/layer_norm_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/attention_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/eltwise_chain_op.h"
 #include "ppl/nn/common/logger.h"
 using namespace std;
 using namespace ppl::common;
@@ -179,6 +184,7 @@ OptKernelCreatorManager::OptKernelCreatorManager() {
     REGISTER_OPT_KERNEL_CREATOR("", "Gemm", 11, 12, GemmOp);
     REGISTER_OPT_KERNEL_CREATOR("", "GlobalAveragePool", 1, 16, AveragePoolOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Greater", 9, 12, GreaterOp);
+    REGISTER_OPT_KERNEL_CREATOR("", "GRU", 7, 13, GRUOp);
     // I
     REGISTER_OPT_KERNEL_CREATOR("", "Identity", 1, 12, IdentityOp);
     REGISTER_OPT_KERNEL_CREATOR("", "If", 11, 12, IfOp);
@@ -213,6 +219,7 @@ OptKernelCreatorManager::OptKernelCreatorManager() {
     REGISTER_OPT_KERNEL_CREATOR("", "Relu", 6, 12, ReluOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Reshape", 5, 12, ReshapeOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Resize", 11, 12, ResizeOp);
+    REGISTER_OPT_KERNEL_CREATOR("", "RNN", 7, 13, RNNOp);
     REGISTER_OPT_KERNEL_CREATOR("", "RoiAlign", 10, 15, ROIAlignOp);
     // S
     REGISTER_OPT_KERNEL_CREATOR("", "ScatterElements", 11, 12, ScatterElementsOp);
@@ -251,6 +258,9 @@ OptKernelCreatorManager::OptKernelCreatorManager() {
     REGISTER_OPT_KERNEL_CREATOR("ppl", "Shape", 1, 1, PPLShapeOperationOp);
     REGISTER_OPT_KERNEL_CREATOR("ppl", "Swish", 1, 1, SwishOp);
     REGISTER_OPT_KERNEL_CREATOR("ppl", "PostDepthwiseConv", 1, 1, PostDepthwiseConvOp);
+    REGISTER_OPT_KERNEL_CREATOR("ppl", "LayerNorm", 1, 1, LayerNormOp);
+    REGISTER_OPT_KERNEL_CREATOR("ppl", "Attention", 1, 1, AttentionOp);
+    REGISTER_OPT_KERNEL_CREATOR("ppl", "EltwiseChain", 1, 1, EltwiseChainOp);
 }
 
 }}} // namespace ppl::nn::x86
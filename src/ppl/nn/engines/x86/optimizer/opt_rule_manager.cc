@@ -26,21 +26,34 @@
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_batch_normalization_relu.h"
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_channel_shuffle.h"
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_swish.h"
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_eltwise_chain.h"
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_layer_norm.h"
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_attention.h"
 #include "ppl/nn/engines/x86/optimizer/rules/layout_optimize.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
 ppl::common::RetCode OptRuleManager::Register(const std::string& tag, const std::string& name, OptRule rule) {
-    auto tag_ret = rule_all_.insert(std::make_pair(tag, std::map<std::string, OptRule>()));
-    auto name_ret = tag_ret.first->second.insert(make_pair(name, rule));
-    return name_ret.second ? ppl::common::RC_SUCCESS : ppl::common::RC_EXISTS;
+    auto& tag_rules = rule_all_[tag];
+    for (auto it = tag_rules.begin(); it != tag_rules.end(); ++it) {
+        if (it->first == name) {
+            return ppl::common::RC_EXISTS;
+        }
+    }
+    tag_rules.push_back(make_pair(name, rule));
+    return ppl::common::RC_SUCCESS;
 }
 
 void OptRuleManager::Remove(const std::string& tag, const std::string& name) {
     auto tag_ret = rule_all_.find(tag);
     if (tag_ret != rule_all_.end()) {
         auto& tag_rules = tag_ret->second;
-        tag_rules.erase(name);
+        for (auto it = tag_rules.begin(); it != tag_rules.end(); ++it) {
+            if (it->first == name) {
+                tag_rules.erase(it);
+                break;
+            }
+        }
         if (tag_rules.empty()) {
             rule_all_.erase(tag_ret);
         }
@@ -50,9 +63,10 @@ void OptRuleManager::Remove(const std::string& tag, const std::string& name) {
 OptRule OptRuleManager::Find(const std::string& tag, const std::string& name) {
     auto tag_ret = rule_all_.find(tag);
     if (tag_ret != rule_all_.end()) {
-        auto rule = tag_ret->second.find(name);
-        if (rule != tag_ret->second.end()) {
-            return rule->second;
+        for (auto it = tag_ret->second.begin(); it != tag_ret->second.end(); ++it) {
+            if (it->first == name) {
+                return it->second;
+            }
         }
     }
     return nullptr;
@@ -70,11 +84,11 @@ void OptRuleManager::ApplyByTag(const std::string& tag, const OptKernelOptions&
     auto tag_it = rule_all_.find(tag);
     if (tag_it != rule_all_.end()) {
         bool ret = false;
-        auto& tag_rules_map = tag_it->second;
+        auto& tag_rules = tag_it->second;
         do {
             ret = false;
-            auto rule_it = tag_rules_map.begin();
-            while (rule_it != tag_rules_map.end()) {
+            auto rule_it = tag_rules.begin();
+            while (rule_it != tag_rules.end()) {
                 ret = ret || rule_it->second(options);
                 ++rule_it;
             }
@@ -91,14 +105,18 @@ OptRuleManager::OptRuleManager() {
     REGISTER_OPT_RULE("", "LayoutOptimize", LayoutOptimize);
 
     REGISTER_OPT_RULE("BeforeLayoutOptimize", "FuseChannelShuffle", FuseChannelShuffle);
+    REGISTER_OPT_RULE("BeforeLayoutOptimize", "FuseLayerNorm", FuseLayerNorm);
+    REGISTER_OPT_RULE("BeforeLayoutOptimize", "FuseAttention", FuseAttention);
 
-    REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseConvActivation", FuseConvActivation);
-    REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseConvEltwise", FuseConvEltwise);
-    REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseConvDepthwise", FuseConvDepthwise);
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseArithmeticReLU", FuseArithmeticReLU);
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseBatchNormalizationReLU", FuseBatchNormalizationReLU);
+    REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseConvActivation", FuseConvActivation);
+    REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseConvDepthwise", FuseConvDepthwise);
+    REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseConvEltwise", FuseConvEltwise);
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseGemmActivation", FuseGemmActivation);
+    // dedicated kernels must match before their ops are taken by an eltwise chain
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseSwish", FuseSwish);
+    REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseEltwiseChain", FuseEltwiseChain);
 }
 
 }}} // namespace ppl::nn::x86
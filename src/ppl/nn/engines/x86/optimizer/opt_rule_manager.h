@@ -36,10 +36,11 @@ public:
     void Remove(const std::string& tag, const std::string& name);
     OptRule Find(const std::string& tag, const std::string& name);
     bool Apply(const std::string& tag, const std::string& name, const OptKernelOptions& options);
+    /** applies rules of `tag` in the order they are registered, starting over after any of them changes the graph */
     void ApplyByTag(const std::string& tag, const OptKernelOptions& options);
 
 private:
-    std::map<std::string, std::map<std::string, OptRule>> rule_all_;
+    std::map<std::string, std::vector<std::pair<std::string, OptRule>>> rule_all_;
 
 private:
     OptRuleManager();
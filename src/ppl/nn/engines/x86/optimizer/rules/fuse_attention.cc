@@ -0,0 +1,223 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_attention.h"
+#include "ppl/nn/engines/x86/optimizer/rules/utils.h"
+#include "ppl/nn/engines/x86/optimizer/opt_rule_manager.h"
+#include "ppl/nn/params/onnx/softmax_param.h"
+#include "ppl/nn/params/ppl/attention_param.h"
+#include "ppl/nn/common/logger.h"
+#include "ppl/kernel/x86/fp32/attention.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+// producer of edge if edge is only consumed by consumer, or nullptr
+static ir::Node* GetExclusiveProducer(ir::GraphTopo* graph_topo, edgeid_t eid, const ir::Node* consumer) {
+    auto edge = graph_topo->GetEdgeById(eid);
+    if (GetSingleConsumer(graph_topo, edge) != consumer) {
+        return nullptr;
+    }
+    return graph_topo->GetNodeById(edge->GetProducer());
+}
+
+static bool GetScalarConstant(const OptKernelOptions& options, edgeid_t eid, float* value) {
+    auto it = options.graph_data->constants.find(eid);
+    if (it == options.graph_data->constants.end() || it->second.data.size() != sizeof(float)) {
+        return false;
+    }
+    if ((*options.tensors)[eid]->GetShape()->GetDataType() != ppl::common::DATATYPE_FLOAT32) {
+        return false;
+    }
+    *value = *(const float*)it->second.data.data();
+    return true;
+}
+
+// matches `MatMul(Q, K) [ / c | * c ]` ending at edge `eid` consumed only by `consumer`
+static ir::Node* MatchScaledMatMul(const OptKernelOptions& options, edgeid_t eid, const ir::Node* consumer,
+                                   ir::Node** scale_node, float* scale) {
+    auto graph_topo = options.graph_topo;
+    auto producer = GetExclusiveProducer(graph_topo, eid, consumer);
+    *scale_node = nullptr;
+    *scale = 1.0f;
+
+    if (IsOnnxOp(producer, "Div") || IsOnnxOp(producer, "Mul")) {
+        float value = 0.0f;
+        edgeid_t data_eid;
+        if (GetScalarConstant(options, producer->GetInput(1), &value)) {
+            data_eid = producer->GetInput(0);
+        } else if (IsOnnxOp(producer, "Mul") && GetScalarConstant(options, producer->GetInput(0), &value)) {
+            data_eid = producer->GetInput(1);
+        } else {
+            return nullptr;
+        }
+        if (IsOnnxOp(producer, "Div")) {
+            if (value == 0.0f) {
+                return nullptr;
+            }
+            value = 1.0f / value;
+        }
+        *scale_node = producer;
+        *scale = value;
+        producer = GetExclusiveProducer(graph_topo, data_eid, producer);
+    }
+
+    if (!IsOnnxOp(producer, "MatMul")) {
+        return nullptr;
+    }
+    return producer;
+}
+
+// Q: [batch..., S, D], K: [batch..., D, T], V: [batch..., T, Dv], mask broadcastable to [batch..., S, T]
+static bool IsSupportedShape(const TensorShape& q, const TensorShape& k, const TensorShape& v,
+                             const TensorShape* mask) {
+    if (q.IsEmpty() || k.IsEmpty() || v.IsEmpty() || (mask && mask->IsEmpty())) {
+        return false;
+    }
+    if (q.GetDataType() != ppl::common::DATATYPE_FLOAT32 || k.GetDataType() != ppl::common::DATATYPE_FLOAT32 ||
+        v.GetDataType() != ppl::common::DATATYPE_FLOAT32 ||
+        (mask && mask->GetDataType() != ppl::common::DATATYPE_FLOAT32)) {
+        return false;
+    }
+
+    return ppl::kernel::x86::attention_fp32_check_shapes(&q, &k, &v, mask);
+}
+
+bool FuseAttention(const OptKernelOptions& options) {
+    bool graph_changed = false;
+
+    auto graph_topo = options.graph_topo;
+    auto graph_data = options.graph_data;
+    auto& tensors = *options.tensors;
+
+    for (auto it = graph_topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        if (!IsOnnxOp(node, "Softmax")) { // start from softmax op
+            continue;
+        }
+
+        /******************** pattern match ***********************/
+        // Y = MatMul(Softmax(MatMul(Q, K) [* scale] [+ mask]), V), softmax over the last axis
+        auto softmax_node = node;
+        auto softmax_input_edge = graph_topo->GetEdgeById(softmax_node->GetInput(0));
+        auto& softmax_input_shape = *tensors[softmax_input_edge->GetId()]->GetShape();
+        if (softmax_input_shape.IsEmpty()) {
+            continue;
+        }
+        auto attr_ref = graph_data->attrs.find(softmax_node->GetId());
+        if (attr_ref == graph_data->attrs.end()) {
+            continue;
+        }
+        const int32_t dim_count = softmax_input_shape.GetDimCount();
+        const int32_t softmax_axis = ((const common::SoftmaxParam*)attr_ref->second.get())->axis;
+        if (softmax_axis != -1 && softmax_axis != dim_count - 1) {
+            continue;
+        }
+
+        // P * V
+        auto softmax_output_edge = graph_topo->GetEdgeById(softmax_node->GetOutput(0));
+        auto pv_node = GetSingleConsumer(graph_topo, softmax_output_edge);
+        if (!IsOnnxOp(pv_node, "MatMul") || pv_node->GetInput(0) != softmax_output_edge->GetId()) {
+            continue;
+        }
+
+        // optional mask, either input of Add may be the scores
+        ir::Node* mask_node = nullptr;
+        ir::Edge* mask_edge = nullptr;
+        ir::Node* scale_node = nullptr;
+        ir::Node* qk_node = nullptr;
+        float scale = 1.0f;
+        auto producer = GetExclusiveProducer(graph_topo, softmax_input_edge->GetId(), softmax_node);
+        if (IsOnnxOp(producer, "Add")) {
+            for (uint32_t i = 0; i < 2 && !qk_node; ++i) {
+                qk_node = MatchScaledMatMul(options, producer->GetInput(i), producer, &scale_node, &scale);
+                if (qk_node) {
+                    mask_node = producer;
+                    mask_edge = graph_topo->GetEdgeById(producer->GetInput(1 - i));
+                }
+            }
+        } else {
+            qk_node = MatchScaledMatMul(options, softmax_input_edge->GetId(), softmax_node, &scale_node, &scale);
+        }
+        if (!qk_node) {
+            continue;
+        }
+
+        auto q_edge = graph_topo->GetEdgeById(qk_node->GetInput(0));
+        auto k_edge = graph_topo->GetEdgeById(qk_node->GetInput(1));
+        auto v_edge = graph_topo->GetEdgeById(pv_node->GetInput(1));
+        auto output_edge = graph_topo->GetEdgeById(pv_node->GetOutput(0));
+        if (!IsSupportedShape(*tensors[q_edge->GetId()]->GetShape(), *tensors[k_edge->GetId()]->GetShape(),
+                              *tensors[v_edge->GetId()]->GetShape(),
+                              mask_edge ? tensors[mask_edge->GetId()]->GetShape() : nullptr)) {
+            continue;
+        }
+
+        /******************** do optimize ***********************/
+        /** 1. create & register fused op **/
+        const std::string attention_node_name = "Attention_" + qk_node->GetName() + "_" + softmax_node->GetName() +
+            "_" + pv_node->GetName();
+        auto node_ret_pair = graph_topo->AddNode(attention_node_name);
+        if (!node_ret_pair.second) {
+            LOG(ERROR) << "node[" << attention_node_name << "] already exists.";
+            continue;
+        }
+        ir::Node* attention_node = node_ret_pair.first;
+        attention_node->SetType(ir::Node::Type("ppl", "Attention", 1));
+
+        auto attention_param = std::make_shared<ppl::nn::common::AttentionParam>();
+        attention_param->scale = scale;
+        graph_data->attrs[attention_node->GetId()] = attention_param;
+
+        /** 2. replace ops with fused op **/
+        std::vector<ir::Node*> to_delete_nodes{qk_node, softmax_node, pv_node};
+        if (scale_node) {
+            to_delete_nodes.push_back(scale_node);
+        }
+        if (mask_node) {
+            to_delete_nodes.push_back(mask_node);
+        }
+        std::vector<ir::Edge*> inputs{q_edge, k_edge, v_edge};
+        if (mask_edge) {
+            inputs.push_back(mask_edge);
+        }
+        std::vector<ir::Edge*> outputs{output_edge};
+
+        if (ppl::common::RC_SUCCESS !=
+            ReplaceSubgraphWithOneNode(options, to_delete_nodes, inputs, outputs, attention_node)) {
+            LOG(ERROR) << "Replace sequence nodes with node [" << attention_node->GetName() << "] failed.";
+            graph_data->attrs.erase(attention_node->GetId());
+            graph_topo->DelNodeById(attention_node->GetId());
+            continue;
+        }
+
+        /** 3. create opt_kernel **/
+        X86OptKernel* opt_kernel = nullptr;
+        if (ppl::common::RC_SUCCESS != CreateX86OptKernel(options, attention_node, &opt_kernel)) {
+            LOG(ERROR) << "Create OptKernel [" << attention_node->GetName() << "] failed.";
+            graph_data->attrs.erase(attention_node->GetId());
+            graph_topo->DelNodeById(attention_node->GetId());
+            continue;
+        }
+
+        LOG(DEBUG) << "Successfully fused " << attention_node_name;
+        graph_changed = true;
+    }
+
+    return graph_changed;
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,376 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_eltwise_chain.h"
+#include "ppl/nn/engines/x86/optimizer/rules/utils.h"
+#include "ppl/nn/engines/x86/optimizer/opt_rule_manager.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/add_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/mul_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/sub_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/div_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/eltwise_chain_op.h"
+#include "ppl/nn/params/onnx/leaky_relu_param.h"
+#include "ppl/nn/common/logger.h"
+#include <float.h>
+#include <map>
+
+using namespace ppl::kernel::x86;
+
+namespace ppl { namespace nn { namespace x86 {
+
+struct EltwiseChainInfo {
+    std::vector<ir::Node*> nodes;
+    std::vector<uint32_t> node_op_ends; // ops of nodes[i] end at node_op_ends[i]
+    std::vector<eltwise_chain_op> ops;
+    std::vector<ir::Edge*> inputs; // inputs[0] is the head of the chain
+    std::map<edgeid_t, int32_t> values; // output edge of a chained node -> its last op
+};
+
+static bool GetEltwiseChainOpType(const ir::Node* node, eltwise_chain_op_type_t* type) {
+    static const std::map<std::string, eltwise_chain_op_type_t> supported_ops = {
+        {"Add", eltwise_chain_op_type::ADD},         {"Sub", eltwise_chain_op_type::SUB},
+        {"Mul", eltwise_chain_op_type::MUL},         {"Div", eltwise_chain_op_type::DIV},
+        {"Relu", eltwise_chain_op_type::RELU},       {"Sigmoid", eltwise_chain_op_type::SIGMOID},
+        {"Tanh", eltwise_chain_op_type::TANH},       {"Exp", eltwise_chain_op_type::EXP},
+        {"Sqrt", eltwise_chain_op_type::SQRT},       {"Clip", eltwise_chain_op_type::CLIP},
+        {"LeakyRelu", eltwise_chain_op_type::LEAKY_RELU},
+    };
+    if (!node || node->GetType().domain != "" || node->GetOutputCount() != 1) {
+        return false;
+    }
+    auto it = supported_ops.find(node->GetType().name);
+    if (it == supported_ops.end()) {
+        return false;
+    }
+    *type = it->second;
+    return true;
+}
+
+// arithmetic ops may have absorbed a following Relu by FuseArithmeticReLU
+static bool HasFusedReLU(const OptKernelOptions& options, const ir::Node* node) {
+    auto it = options.info->kernels.find(node->GetId());
+    if (it == options.info->kernels.end()) {
+        return false;
+    }
+    auto& name = node->GetType().name;
+    if (name == "Add") {
+        return ((AddOp*)it->second.get())->HasFuseReLU();
+    } else if (name == "Sub") {
+        return ((SubOp*)it->second.get())->HasFuseReLU();
+    } else if (name == "Mul") {
+        return ((MulOp*)it->second.get())->HasFuseReLU();
+    } else if (name == "Div") {
+        return ((DivOp*)it->second.get())->HasFuseReLU();
+    }
+    return false;
+}
+
+static bool GetScalarConstant(const OptKernelOptions& options, edgeid_t eid, float* value) {
+    auto it = options.graph_data->constants.find(eid);
+    if (it == options.graph_data->constants.end() || it->second.data.size() != sizeof(float) ||
+        (*options.tensors)[eid]->GetShape()->GetDataType() != ppl::common::DATATYPE_FLOAT32) {
+        return false;
+    }
+    *value = *(const float*)it->second.data.data();
+    return true;
+}
+
+static bool IsSameShape(const TensorShape& a, const TensorShape& b) {
+    if (a.GetDimCount() != b.GetDimCount() || a.GetDataFormat() != b.GetDataFormat()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.GetDimCount(); ++i) {
+        if (a.GetDim(i) != b.GetDim(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// checks that edge is a fp32 tensor which can be broadcasted to the chain output in one loop
+static bool IsSupportedInput(const OptKernelOptions& options, edgeid_t eid, const TensorShape& chain_shape) {
+    auto& shape = *(*options.tensors)[eid]->GetShape();
+    eltwise_chain_src src;
+    return !shape.IsEmpty() && shape.GetDataType() == ppl::common::DATATYPE_FLOAT32 &&
+        eltwise_chain_init_src(&shape, &chain_shape, nullptr, &src);
+}
+
+static int32_t FindOrAddInput(EltwiseChainInfo* chain, ir::Edge* edge) {
+    for (size_t i = 0; i < chain->inputs.size(); ++i) {
+        if (chain->inputs[i] == edge) {
+            return i;
+        }
+    }
+    chain->inputs.push_back(edge);
+    return chain->inputs.size() - 1;
+}
+
+// appends node whose input `cur_eid` is the current value of the chain
+static bool AppendNode(const OptKernelOptions& options, ir::Node* node, edgeid_t cur_eid,
+                       const TensorShape& chain_shape, EltwiseChainInfo* chain) {
+    eltwise_chain_op_type_t type;
+    if (!GetEltwiseChainOpType(node, &type)) {
+        return false;
+    }
+    auto& output_shape = *(*options.tensors)[node->GetOutput(0)]->GetShape();
+    if (output_shape.GetDataType() != ppl::common::DATATYPE_FLOAT32 || !IsSameShape(output_shape, chain_shape)) {
+        return false;
+    }
+
+    eltwise_chain_op op;
+    op.type = type;
+    op.src_idx = -1;
+    op.value_idx = -1;
+    op.reverse = false;
+    op.alpha = 0.0f;
+    op.beta = 0.0f;
+
+    edgeid_t other_eid = INVALID_EDGEID;
+    if (eltwise_chain_op_is_binary(type)) {
+        if (node->GetInputCount() != 2) {
+            return false;
+        }
+        if (node->GetInput(0) == cur_eid) {
+            other_eid = node->GetInput(1);
+        } else if (node->GetInput(1) == cur_eid) {
+            other_eid = node->GetInput(0);
+            op.reverse = true;
+        } else {
+            return false;
+        }
+        auto value_ref = chain->values.find(other_eid);
+        if (value_ref != chain->values.end()) {
+            op.value_idx = value_ref->second;
+            other_eid = INVALID_EDGEID;
+        } else if (!IsSupportedInput(options, other_eid, chain_shape)) {
+            return false;
+        }
+    } else if (node->GetInput(0) != cur_eid) {
+        return false;
+    } else if (type == eltwise_chain_op_type::CLIP) {
+        op.alpha = -FLT_MAX;
+        op.beta = FLT_MAX;
+        if (node->GetInputCount() > 1 && node->GetInput(1) != INVALID_EDGEID &&
+            !GetScalarConstant(options, node->GetInput(1), &op.alpha)) {
+            return false;
+        }
+        if (node->GetInputCount() > 2 && node->GetInput(2) != INVALID_EDGEID &&
+            !GetScalarConstant(options, node->GetInput(2), &op.beta)) {
+            return false;
+        }
+    } else if (type == eltwise_chain_op_type::LEAKY_RELU) {
+        auto attr_ref = options.graph_data->attrs.find(node->GetId());
+        if (attr_ref == options.graph_data->attrs.end()) {
+            return false;
+        }
+        op.alpha = ((const common::LeakyReluParam*)attr_ref->second.get())->alpha;
+    }
+
+    if (other_eid != INVALID_EDGEID) {
+        op.src_idx = FindOrAddInput(chain, options.graph_topo->GetEdgeById(other_eid));
+    }
+    chain->ops.push_back(op);
+    if (eltwise_chain_op_is_binary(type) && HasFusedReLU(options, node)) {
+        eltwise_chain_op relu_op = op;
+        relu_op.type = eltwise_chain_op_type::RELU;
+        relu_op.src_idx = -1;
+        relu_op.value_idx = -1;
+        chain->ops.push_back(relu_op);
+    }
+    chain->nodes.push_back(node);
+    chain->node_op_ends.push_back(chain->ops.size());
+    chain->values[node->GetOutput(0)] = chain->ops.size() - 1;
+    return true;
+}
+
+// a binary consumer is not ready if its other operand is computed from the chain by a node not chained yet
+static bool IsReadyToAppend(const ir::GraphTopo* graph_topo, const ir::Node* node, edgeid_t cur_eid,
+                            const EltwiseChainInfo& chain) {
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        const edgeid_t eid = node->GetInput(i);
+        if (eid == cur_eid || eid == INVALID_EDGEID || chain.values.find(eid) != chain.values.end()) {
+            continue;
+        }
+        auto producer = graph_topo->GetNodeById(graph_topo->GetEdgeById(eid)->GetProducer());
+        if (!producer) {
+            continue;
+        }
+        for (uint32_t j = 0; j < producer->GetInputCount(); ++j) {
+            if (chain.values.find(producer->GetInput(j)) != chain.values.end()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// intermediate results must not be used outside of the first `node_count` nodes
+static bool IsClosedChain(const ir::GraphTopo* graph_topo, const EltwiseChainInfo& chain, uint32_t node_count) {
+    for (uint32_t i = 0; i + 1 < node_count; ++i) {
+        const edgeid_t eid = chain.nodes[i]->GetOutput(0);
+        if (IsGraphOutput(graph_topo, eid)) {
+            return false;
+        }
+        auto edge = graph_topo->GetEdgeById(eid);
+        for (auto it = edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+            bool inside = false;
+            for (uint32_t j = 0; j < node_count; ++j) {
+                inside = inside || chain.nodes[j]->GetId() == it.Get();
+            }
+            if (!inside) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// drops nodes after `node_count` and inputs only used by them
+static void TruncateChain(EltwiseChainInfo* chain, uint32_t node_count) {
+    chain->nodes.resize(node_count);
+    chain->ops.resize(chain->node_op_ends[node_count - 1]);
+
+    std::vector<ir::Edge*> inputs{chain->inputs[0]};
+    std::map<int32_t, int32_t> input_map{{0, 0}};
+    for (auto& op : chain->ops) {
+        if (op.src_idx < 0) {
+            continue;
+        }
+        auto it = input_map.find(op.src_idx);
+        if (it == input_map.end()) {
+            it = input_map.insert(std::make_pair(op.src_idx, (int32_t)inputs.size())).first;
+            inputs.push_back(chain->inputs[op.src_idx]);
+        }
+        op.src_idx = it->second;
+    }
+    chain->inputs = inputs;
+}
+
+bool FuseEltwiseChain(const OptKernelOptions& options) {
+    bool graph_changed = false;
+
+    auto graph_topo = options.graph_topo;
+    auto& tensors = *options.tensors;
+
+    for (auto it = graph_topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        eltwise_chain_op_type_t type;
+        if (!GetEltwiseChainOpType(node, &type)) {
+            continue;
+        }
+
+        // start from a node whose inputs are not produced by another chainable node
+        bool is_head = true;
+        const uint32_t data_input_count = eltwise_chain_op_is_binary(type) ? 2 : 1;
+        for (uint32_t i = 0; i < data_input_count && i < node->GetInputCount(); ++i) {
+            auto edge = graph_topo->GetEdgeById(node->GetInput(i));
+            eltwise_chain_op_type_t producer_type;
+            if (edge && edge->CalcConsumerCount() == 1 && !IsGraphOutput(graph_topo, edge->GetId()) &&
+                GetEltwiseChainOpType(graph_topo->GetNodeById(edge->GetProducer()), &producer_type)) {
+                is_head = false;
+            }
+        }
+        if (!is_head) {
+            continue;
+        }
+
+        /******************** pattern match ***********************/
+        auto& chain_shape = *tensors[node->GetOutput(0)]->GetShape();
+        if (chain_shape.IsEmpty()) {
+            continue;
+        }
+        auto head_edge = graph_topo->GetEdgeById(node->GetInput(0));
+        if (!IsSupportedInput(options, head_edge->GetId(), chain_shape)) {
+            continue;
+        }
+
+        EltwiseChainInfo chain;
+        chain.inputs.push_back(head_edge);
+        if (!AppendNode(options, node, head_edge->GetId(), chain_shape, &chain)) {
+            continue;
+        }
+
+        edgeid_t cur_eid = node->GetOutput(0);
+        while (!IsGraphOutput(graph_topo, cur_eid)) {
+            ir::Node* next_node = nullptr;
+            auto cur_edge = graph_topo->GetEdgeById(cur_eid);
+            for (auto consumer_it = cur_edge->CreateConsumerIter(); consumer_it.IsValid(); consumer_it.Forward()) {
+                auto consumer = graph_topo->GetNodeById(consumer_it.Get());
+                if (IsReadyToAppend(graph_topo, consumer, cur_eid, chain) &&
+                    AppendNode(options, consumer, cur_eid, chain_shape, &chain)) {
+                    next_node = consumer;
+                    break;
+                }
+            }
+            if (!next_node) {
+                break;
+            }
+            cur_eid = next_node->GetOutput(0);
+        }
+
+        uint32_t node_count = chain.nodes.size();
+        while (node_count >= 2 && !IsClosedChain(graph_topo, chain, node_count)) {
+            --node_count;
+        }
+        if (node_count < 2) {
+            continue;
+        }
+        TruncateChain(&chain, node_count);
+
+        /******************** do optimize ***********************/
+        /** 1. create fused op **/
+        const std::string chain_node_name =
+            "EltwiseChain_" + chain.nodes.front()->GetName() + "_" + chain.nodes.back()->GetName();
+        auto node_ret_pair = graph_topo->AddNode(chain_node_name);
+        if (!node_ret_pair.second) {
+            LOG(ERROR) << "node[" << chain_node_name << "] already exists.";
+            continue;
+        }
+        ir::Node* chain_node = node_ret_pair.first;
+        chain_node->SetType(ir::Node::Type("ppl", "EltwiseChain", 1));
+
+        /** 2. replace ops with fused op **/
+        auto output_edge = graph_topo->GetEdgeById(chain.nodes.back()->GetOutput(0));
+        const auto output_format = tensors[output_edge->GetId()]->GetShape()->GetDataFormat();
+        std::vector<ir::Edge*> outputs{output_edge};
+        if (ppl::common::RC_SUCCESS !=
+            ReplaceSubgraphWithOneNode(options, chain.nodes, chain.inputs, outputs, chain_node)) {
+            LOG(ERROR) << "Replace sequence nodes with node [" << chain_node->GetName() << "] failed.";
+            graph_topo->DelNodeById(chain_node->GetId());
+            continue;
+        }
+
+        /** 3. create opt_kernel **/
+        X86OptKernel* opt_kernel = nullptr;
+        if (ppl::common::RC_SUCCESS != CreateX86OptKernel(options, chain_node, &opt_kernel)) {
+            LOG(ERROR) << "Create OptKernel [" << chain_node->GetName() << "] failed.";
+            graph_topo->DelNodeById(chain_node->GetId());
+            continue;
+        }
+        EltwiseChainParam param;
+        param.ops = chain.ops;
+        ((EltwiseChainOp*)opt_kernel)->SetEltwiseChainParam(param);
+        opt_kernel->SetOutputDataFormat(0, output_format);
+
+        LOG(DEBUG) << "Successfully fused " << chain_node_name << " with " << chain.ops.size() << " ops";
+        graph_changed = true;
+    }
+
+    return graph_changed;
+}
+
+}}} // namespace ppl::nn::x86
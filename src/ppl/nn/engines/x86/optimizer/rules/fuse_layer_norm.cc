@@ -0,0 +1,276 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_layer_norm.h"
+#include "ppl/nn/engines/x86/optimizer/rules/utils.h"
+#include "ppl/nn/engines/x86/optimizer/opt_rule_manager.h"
+#include "ppl/nn/params/onnx/reduce_param.h"
+#include "ppl/nn/params/ppl/layer_norm_param.h"
+#include "ppl/nn/common/logger.h"
+#include <algorithm>
+
+namespace ppl { namespace nn { namespace x86 {
+
+static bool GetFloatConstant(const OptKernelOptions& options, edgeid_t eid, const float** data, uint64_t* count) {
+    auto it = options.graph_data->constants.find(eid);
+    if (it == options.graph_data->constants.end()) {
+        return false;
+    }
+    auto& shape = *(*options.tensors)[eid]->GetShape();
+    if (shape.GetDataType() != ppl::common::DATATYPE_FLOAT32) {
+        return false;
+    }
+    *data = (const float*)it->second.data.data();
+    *count = it->second.data.size() / sizeof(float);
+    return true;
+}
+
+// returns the first normalized axis if reduce_node is a ReduceMean over trailing axes with keepdims, or -1
+static int32_t GetTrailingReduceMeanAxis(const OptKernelOptions& options, const ir::Node* reduce_node,
+                                         uint32_t dim_count) {
+    if (!IsOnnxOp(reduce_node, "ReduceMean")) {
+        return -1;
+    }
+    auto attr_ref = options.graph_data->attrs.find(reduce_node->GetId());
+    if (attr_ref == options.graph_data->attrs.end()) {
+        return -1;
+    }
+    auto param = (const common::ReduceParam*)attr_ref->second.get();
+    if (!param->keepdims) {
+        return -1;
+    }
+    if (param->axes.empty()) {
+        return 0;
+    }
+
+    std::vector<int32_t> axes(param->axes.size());
+    for (size_t i = 0; i < axes.size(); ++i) {
+        axes[i] = param->axes[i] < 0 ? param->axes[i] + dim_count : param->axes[i];
+    }
+    std::sort(axes.begin(), axes.end());
+    for (size_t i = 0; i < axes.size(); ++i) {
+        if (axes[i] != int32_t(dim_count - axes.size() + i)) {
+            return -1;
+        }
+    }
+    return axes[0];
+}
+
+// gamma and beta must cover the normalized dims exactly, leading dims of 1 are allowed
+static bool IsNormalizedShape(const TensorShape& shape, const TensorShape& x_shape, int32_t axis) {
+    const int32_t dim_count = shape.GetDimCount();
+    const int32_t x_dim_count = x_shape.GetDimCount();
+    if (dim_count > x_dim_count) {
+        return false;
+    }
+    for (int32_t i = 0; i < dim_count; ++i) {
+        const int32_t xi = x_dim_count - dim_count + i;
+        const int64_t expected = xi >= axis ? x_shape.GetDim(xi) : 1;
+        if (shape.GetDim(i) != expected) {
+            return false;
+        }
+    }
+    for (int32_t xi = axis; xi < x_dim_count - dim_count; ++xi) {
+        if (x_shape.GetDim(xi) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// returns the other input of a binary node which is a float constant covering the normalized dims, or nullptr
+static ir::Edge* GetAffineConstant(const OptKernelOptions& options, const ir::Node* node, edgeid_t data_eid,
+                                   const TensorShape& x_shape, int32_t axis) {
+    if (node->GetInputCount() != 2) {
+        return nullptr;
+    }
+    edgeid_t other_eid = node->GetInput(0) == data_eid ? node->GetInput(1) : node->GetInput(0);
+    if (other_eid == data_eid) {
+        return nullptr;
+    }
+    const float* data = nullptr;
+    uint64_t count = 0;
+    if (!GetFloatConstant(options, other_eid, &data, &count)) {
+        return nullptr;
+    }
+    if (!IsNormalizedShape(*(*options.tensors)[other_eid]->GetShape(), x_shape, axis)) {
+        return nullptr;
+    }
+    return options.graph_topo->GetEdgeById(other_eid);
+}
+
+bool FuseLayerNorm(const OptKernelOptions& options) {
+    bool graph_changed = false;
+
+    auto graph_topo = options.graph_topo;
+    auto graph_data = options.graph_data;
+    auto& tensors = *options.tensors;
+
+    for (auto it = graph_topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        if (!IsOnnxOp(node, "ReduceMean")) { // start from the ReduceMean calculating mean
+            continue;
+        }
+
+        /******************** pattern match ***********************/
+        // y = (x - mean(x)) / sqrt(mean((x - mean(x))^2) + eps) [* gamma] [+ beta]
+        auto mean_node = node;
+        auto x_edge = graph_topo->GetEdgeById(mean_node->GetInput(0));
+        auto& x_shape = *tensors[x_edge->GetId()]->GetShape();
+        if (x_shape.IsEmpty() || x_shape.GetDataType() != ppl::common::DATATYPE_FLOAT32) {
+            continue;
+        }
+        const uint32_t dim_count = x_shape.GetDimCount();
+        const int32_t axis = GetTrailingReduceMeanAxis(options, mean_node, dim_count);
+        if (axis < 0) {
+            continue;
+        }
+
+        // d = x - mean
+        auto mean_edge = graph_topo->GetEdgeById(mean_node->GetOutput(0));
+        auto sub_node = GetSingleConsumer(graph_topo, mean_edge);
+        if (!IsOnnxOp(sub_node, "Sub") || sub_node->GetInput(0) != x_edge->GetId() ||
+            sub_node->GetInput(1) != mean_edge->GetId()) {
+            continue;
+        }
+        auto d_edge = graph_topo->GetEdgeById(sub_node->GetOutput(0));
+        if (d_edge->CalcConsumerCount() != 2 || IsGraphOutput(graph_topo, d_edge->GetId())) {
+            continue;
+        }
+
+        // d^2 by Pow(d, 2) or Mul(d, d), and d / std by Div
+        ir::Node* square_node = nullptr;
+        ir::Node* div_node = nullptr;
+        for (auto consumer_it = d_edge->CreateConsumerIter(); consumer_it.IsValid(); consumer_it.Forward()) {
+            auto consumer = graph_topo->GetNodeById(consumer_it.Get());
+            if (IsOnnxOp(consumer, "Div") && consumer->GetInput(0) == d_edge->GetId()) {
+                div_node = consumer;
+            } else if (IsOnnxOp(consumer, "Mul") && consumer->GetInput(0) == d_edge->GetId() &&
+                       consumer->GetInput(1) == d_edge->GetId()) {
+                square_node = consumer;
+            } else if (IsOnnxOp(consumer, "Pow") && consumer->GetInput(0) == d_edge->GetId()) {
+                const float* exponent = nullptr;
+                uint64_t count = 0;
+                if (GetFloatConstant(options, consumer->GetInput(1), &exponent, &count) && count == 1 &&
+                    exponent[0] == 2.0f) {
+                    square_node = consumer;
+                }
+            }
+        }
+        if (!square_node || !div_node) {
+            continue;
+        }
+
+        // var = mean(d^2)
+        auto square_edge = graph_topo->GetEdgeById(square_node->GetOutput(0));
+        auto var_node = GetSingleConsumer(graph_topo, square_edge);
+        if (GetTrailingReduceMeanAxis(options, var_node, dim_count) != axis) {
+            continue;
+        }
+
+        // std = sqrt(var + eps)
+        auto var_edge = graph_topo->GetEdgeById(var_node->GetOutput(0));
+        auto add_eps_node = GetSingleConsumer(graph_topo, var_edge);
+        if (!IsOnnxOp(add_eps_node, "Add")) {
+            continue;
+        }
+        const edgeid_t eps_eid = add_eps_node->GetInput(0) == var_edge->GetId() ? add_eps_node->GetInput(1)
+                                                                                 : add_eps_node->GetInput(0);
+        const float* eps_data = nullptr;
+        uint64_t eps_count = 0;
+        if (!GetFloatConstant(options, eps_eid, &eps_data, &eps_count) || eps_count != 1) {
+            continue;
+        }
+        auto add_eps_edge = graph_topo->GetEdgeById(add_eps_node->GetOutput(0));
+        auto sqrt_node = GetSingleConsumer(graph_topo, add_eps_edge);
+        if (!IsOnnxOp(sqrt_node, "Sqrt")) {
+            continue;
+        }
+        auto std_edge = graph_topo->GetEdgeById(sqrt_node->GetOutput(0));
+        if (GetSingleConsumer(graph_topo, std_edge) != div_node || div_node->GetInput(1) != std_edge->GetId()) {
+            continue;
+        }
+
+        std::vector<ir::Node*> to_delete_nodes{mean_node, sub_node, square_node, var_node,
+                                               add_eps_node, sqrt_node, div_node};
+        std::vector<ir::Edge*> inputs{x_edge};
+        auto output_edge = graph_topo->GetEdgeById(div_node->GetOutput(0));
+
+        // optional elementwise affine: * gamma + beta
+        auto mul_gamma_node = GetSingleConsumer(graph_topo, output_edge);
+        if (IsOnnxOp(mul_gamma_node, "Mul")) {
+            auto gamma_edge = GetAffineConstant(options, mul_gamma_node, output_edge->GetId(), x_shape, axis);
+            if (gamma_edge) {
+                auto gamma_output_edge = graph_topo->GetEdgeById(mul_gamma_node->GetOutput(0));
+                auto add_beta_node = GetSingleConsumer(graph_topo, gamma_output_edge);
+                if (IsOnnxOp(add_beta_node, "Add")) {
+                    auto beta_edge =
+                        GetAffineConstant(options, add_beta_node, gamma_output_edge->GetId(), x_shape, axis);
+                    if (beta_edge) {
+                        to_delete_nodes.push_back(mul_gamma_node);
+                        to_delete_nodes.push_back(add_beta_node);
+                        inputs.push_back(gamma_edge);
+                        inputs.push_back(beta_edge);
+                        output_edge = graph_topo->GetEdgeById(add_beta_node->GetOutput(0));
+                    }
+                }
+            }
+        }
+
+        /******************** do optimize ***********************/
+        /** 1. create & register fused op **/
+        const std::string layer_norm_node_name = "LayerNorm_" + mean_node->GetName() + "_" + div_node->GetName();
+        auto node_ret_pair = graph_topo->AddNode(layer_norm_node_name);
+        if (!node_ret_pair.second) {
+            LOG(ERROR) << "node[" << layer_norm_node_name << "] already exists.";
+            continue;
+        }
+        ir::Node* layer_norm_node = node_ret_pair.first;
+        layer_norm_node->SetType(ir::Node::Type("ppl", "LayerNorm", 1));
+
+        auto layer_norm_param = std::make_shared<ppl::nn::common::LayerNormParam>();
+        layer_norm_param->axis = axis;
+        layer_norm_param->epsilon = eps_data[0];
+        graph_data->attrs[layer_norm_node->GetId()] = layer_norm_param;
+
+        /** 2. replace ops with fused op **/
+        std::vector<ir::Edge*> outputs{output_edge};
+        if (ppl::common::RC_SUCCESS !=
+            ReplaceSubgraphWithOneNode(options, to_delete_nodes, inputs, outputs, layer_norm_node)) {
+            LOG(ERROR) << "Replace sequence nodes with node [" << layer_norm_node->GetName() << "] failed.";
+            graph_data->attrs.erase(layer_norm_node->GetId());
+            graph_topo->DelNodeById(layer_norm_node->GetId());
+            continue;
+        }
+
+        /** 3. create opt_kernel **/
+        X86OptKernel* opt_kernel = nullptr;
+        if (ppl::common::RC_SUCCESS != CreateX86OptKernel(options, layer_norm_node, &opt_kernel)) {
+            LOG(ERROR) << "Create OptKernel [" << layer_norm_node->GetName() << "] failed.";
+            graph_data->attrs.erase(layer_norm_node->GetId());
+            graph_topo->DelNodeById(layer_norm_node->GetId());
+            continue;
+        }
+
+        LOG(DEBUG) << "Successfully fused " << layer_norm_node_name;
+        graph_changed = true;
+    }
+
+    return graph_changed;
+}
+
+}}} // namespace ppl::nn::x86
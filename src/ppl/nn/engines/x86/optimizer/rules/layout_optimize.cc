@@ -19,6 +19,9 @@
 #include "ppl/nn/engines/x86/optimizer/opt_rule_manager.h"
 #include "ppl/nn/engines/x86/optimizer/tensor_getter.h"
 
+#include <algorithm>
+#include <set>
+
 namespace ppl { namespace nn { namespace x86 {
 
 #define REORDER_INPUT 0
@@ -190,6 +193,193 @@ static ppl::common::RetCode FuseReorderOp(const OptKernelOptions& options) {
     return ppl::common::RC_SUCCESS;
 }
 
+/*
+  layout planning: every kernel may run in several format choices, each one returned by its own SelectFormat()
+  when its inputs are pretended to be in a given format. the choice made from the actual input formats is the greedy
+  one used before. choices are then refined over the whole graph to minimize the estimated cost of reorder ops, which
+  is the bytes of each tensor that must be reordered, including graph outputs which are read in NDARRAY. sibling
+  reorders to the same format are counted once because they are merged by FuseReorderOp().
+*/
+
+struct FormatChoice final {
+    std::vector<ppl::common::dataformat_t> input_formats;
+    std::vector<ppl::common::dataformat_t> output_formats;
+
+    bool operator==(const FormatChoice& other) const {
+        return input_formats == other.input_formats && output_formats == other.output_formats;
+    }
+};
+
+struct NodeFormatPlan final {
+    std::vector<FormatChoice> choices; // choices[0] is the greedy one
+    uint32_t selected = 0;
+};
+
+#define LAYOUT_PLAN_MAX_ROUNDS 8
+
+static ppl::common::RetCode SelectFormatChoice(X86OptKernel* kernel, const InputOutputInfo& IOinfo,
+                                               FormatChoice* choice) {
+    auto node = kernel->GetNode();
+    choice->input_formats.assign(node->GetInputCount(), ppl::common::DATAFORMAT_NDARRAY);
+    choice->output_formats.assign(node->GetOutputCount(), ppl::common::DATAFORMAT_NDARRAY);
+    return kernel->SelectFormat(IOinfo, &choice->input_formats, &choice->output_formats);
+}
+
+// pretends that all reorderable inputs are in `format` and asks the kernel which formats it selects then
+static ppl::common::RetCode ProbeFormatChoice(X86OptKernel* kernel, const InputOutputInfo& IOinfo,
+                                              std::map<edgeid_t, std::unique_ptr<TensorImpl>>& tensors,
+                                              const ppl::common::dataformat_t format, FormatChoice* choice,
+                                              bool* probed) {
+    auto node = kernel->GetNode();
+    std::vector<ppl::common::dataformat_t> saved_formats(node->GetInputCount(), ppl::common::DATAFORMAT_UNKNOWN);
+
+    *probed = false;
+    for (uint32_t i = 0; i < node->GetInputCount(); i++) {
+        auto edge_id = node->GetInput(i);
+        if (edge_id == INVALID_EDGEID) {
+            continue;
+        }
+        auto shape = tensors[edge_id]->GetShape();
+        auto elem_size = ppl::common::GetSizeOfDataType(shape->GetDataType());
+        if (shape->GetDimCount() < 3 || (elem_size != 4 && elem_size != 8)) {
+            continue;
+        }
+        saved_formats[i] = shape->GetDataFormat();
+        if (saved_formats[i] != format) {
+            shape->SetDataFormat(format);
+            *probed = true;
+        }
+    }
+
+    ppl::common::RetCode status = ppl::common::RC_SUCCESS;
+    if (*probed) {
+        status = SelectFormatChoice(kernel, IOinfo, choice);
+    }
+
+    // restore in reverse order in case that an edge is used by more than one input
+    for (uint32_t i = node->GetInputCount(); i > 0; i--) {
+        if (saved_formats[i - 1] != ppl::common::DATAFORMAT_UNKNOWN) {
+            tensors[node->GetInput(i - 1)]->GetShape()->SetDataFormat(saved_formats[i - 1]);
+        }
+    }
+
+    return status;
+}
+
+static uint64_t CalcReorderBytes(const TensorShape* shape) {
+    const uint64_t bytes = shape->GetBytesExcludingPadding();
+    return bytes > 0 ? bytes : 1; // shape is unknown, count it as one reorder
+}
+
+// formats required by consumers of `edge_id` that differ from the format it is produced in. graph outputs are
+// required in NDARRAY because they are converted to NDARRAY when read by users or other engines.
+static uint32_t CalcEdgeReorderCount(const ir::GraphTopo* graph_topo, const std::vector<NodeFormatPlan>& plans,
+                                     const edgeid_t edge_id, const ppl::common::dataformat_t produced_format) {
+    std::set<ppl::common::dataformat_t> required_formats;
+    if (IsGraphOutput(graph_topo, edge_id)) {
+        required_formats.insert(ppl::common::DATAFORMAT_NDARRAY);
+    }
+    auto edge = graph_topo->GetEdgeById(edge_id);
+    for (auto it = edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+        auto consumer = graph_topo->GetNodeById(it.Get());
+        if (!consumer) {
+            continue;
+        }
+        auto& plan = plans[consumer->GetId()];
+        if (plan.choices.empty()) {
+            continue;
+        }
+        auto& choice = plan.choices[plan.selected];
+        for (uint32_t i = 0; i < consumer->GetInputCount(); i++) {
+            if (consumer->GetInput(i) == edge_id) {
+                required_formats.insert(choice.input_formats[i]);
+            }
+        }
+        for (uint32_t i = 0; i < consumer->GetExtraInputCount(); i++) {
+            if (consumer->GetExtraInput(i) == edge_id) {
+                required_formats.insert(ppl::common::DATAFORMAT_NDARRAY);
+            }
+        }
+    }
+    required_formats.erase(produced_format);
+    return required_formats.size();
+}
+
+static uint64_t CalcNodeReorderCost(const ir::GraphTopo* graph_topo, const std::vector<NodeFormatPlan>& plans,
+                                    std::map<edgeid_t, std::unique_ptr<TensorImpl>>& tensors, const ir::Node* node) {
+    std::set<edgeid_t> edges;
+    for (uint32_t i = 0; i < node->GetInputCount(); i++) {
+        if (node->GetInput(i) != INVALID_EDGEID) {
+            edges.insert(node->GetInput(i));
+        }
+    }
+    for (uint32_t i = 0; i < node->GetOutputCount(); i++) {
+        edges.insert(node->GetOutput(i));
+    }
+
+    uint64_t cost = 0;
+    for (auto edge_id : edges) {
+        auto shape = tensors[edge_id]->GetShape();
+        cost += CalcEdgeReorderCount(graph_topo, plans, edge_id, shape->GetDataFormat()) * CalcReorderBytes(shape);
+    }
+    return cost;
+}
+
+static void ApplyFormatChoice(const ir::Node* node, std::map<edgeid_t, std::unique_ptr<TensorImpl>>& tensors,
+                              NodeFormatPlan* plan, uint32_t selected) {
+    plan->selected = selected;
+    auto& choice = plan->choices[selected];
+    for (uint32_t i = 0; i < node->GetOutputCount(); i++) {
+        tensors[node->GetOutput(i)]->GetShape()->SetDataFormat(choice.output_formats[i]);
+    }
+}
+
+// returns true if any choice is changed
+static bool RefineFormatChoices(const ir::GraphTopo* graph_topo, const std::vector<nodeid_t>& sorted_nodes,
+                                std::map<edgeid_t, std::unique_ptr<TensorImpl>>& tensors,
+                                std::vector<NodeFormatPlan>* plans) {
+    bool changed = false;
+    for (auto node_id : sorted_nodes) {
+        auto& plan = plans->at(node_id);
+        if (plan.choices.size() <= 1) {
+            continue;
+        }
+        auto node = graph_topo->GetNodeById(node_id);
+
+        const uint32_t current = plan.selected;
+        uint32_t best = current;
+        uint64_t best_cost = CalcNodeReorderCost(graph_topo, *plans, tensors, node);
+        for (uint32_t c = 0; c < plan.choices.size(); c++) {
+            if (c == current) {
+                continue;
+            }
+            ApplyFormatChoice(node, tensors, &plan, c);
+            auto cost = CalcNodeReorderCost(graph_topo, *plans, tensors, node);
+            if (cost < best_cost) {
+                best = c;
+                best_cost = cost;
+            }
+        }
+
+        ApplyFormatChoice(node, tensors, &plan, best);
+        if (best != current) {
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+static uint32_t CalcGraphReorderCount(const ir::GraphTopo* graph_topo, const std::vector<NodeFormatPlan>& plans,
+                                      std::map<edgeid_t, std::unique_ptr<TensorImpl>>& tensors) {
+    uint32_t count = 0;
+    for (auto it = tensors.begin(); it != tensors.end(); ++it) {
+        if (graph_topo->GetEdgeById(it->first)) {
+            count += CalcEdgeReorderCount(graph_topo, plans, it->first, it->second->GetShape()->GetDataFormat());
+        }
+    }
+    return count;
+}
+
 bool LayoutOptimize(const OptKernelOptions &options) {
     auto graph_topo = options.graph_topo;
     auto info = options.info;
@@ -200,6 +390,9 @@ bool LayoutOptimize(const OptKernelOptions &options) {
         sorted_nodes.push_back(nid);
     });
 
+    // select algorithms and format choices. the greedy choice is applied for now so that
+    // algorithms of the following kernels are selected with the same input formats as before.
+    std::vector<NodeFormatPlan> plans(graph_topo->GetMaxNodeId());
     for (auto node_id : sorted_nodes) {
         if (info->kernels.find(node_id) == info->kernels.end()) {
             LOG(ERROR) << "cannot find node_id " << node_id << " in RuntimePartitionInfo.";
@@ -219,24 +412,54 @@ bool LayoutOptimize(const OptKernelOptions &options) {
             return false;
         }
 
-        std::vector<ppl::common::dataformat_t> selected_input_formats(node->GetInputCount(), ppl::common::DATAFORMAT_NDARRAY);
-        std::vector<ppl::common::dataformat_t> selected_output_formats(node->GetOutputCount(), ppl::common::DATAFORMAT_NDARRAY);
-
-        status = kernel->SelectFormat(IOinfo, &selected_input_formats, &selected_output_formats);
+        auto& plan = plans[node_id];
+        plan.choices.resize(1);
+        status = SelectFormatChoice(kernel, IOinfo, &plan.choices[0]);
         if (status != ppl::common::RC_SUCCESS) {
             LOG(ERROR) << "kernel[" << node->GetName() << "] SelectFormat failed: " << ppl::common::GetRetCodeStr(status);
             return false;
         }
 
+        const ppl::common::dataformat_t probe_formats[] = {ppl::common::DATAFORMAT_N16CX, ppl::common::DATAFORMAT_NDARRAY};
+        for (auto probe_format : probe_formats) {
+            FormatChoice choice;
+            bool probed = false;
+            status = ProbeFormatChoice(kernel, IOinfo, tensors, probe_format, &choice, &probed);
+            if (status != ppl::common::RC_SUCCESS) {
+                LOG(ERROR) << "kernel[" << node->GetName() << "] SelectFormat failed: " << ppl::common::GetRetCodeStr(status);
+                return false;
+            }
+            if (probed && std::find(plan.choices.begin(), plan.choices.end(), choice) == plan.choices.end()) {
+                plan.choices.push_back(choice);
+            }
+        }
+
+        ApplyFormatChoice(node, tensors, &plan, 0);
+    }
+
+    const uint32_t greedy_reorder_count = CalcGraphReorderCount(graph_topo, plans, tensors);
+    for (uint32_t round = 0; round < LAYOUT_PLAN_MAX_ROUNDS; round++) {
+        if (!RefineFormatChoices(graph_topo, sorted_nodes, tensors, &plans)) {
+            break;
+        }
+    }
+    const uint32_t planned_reorder_count = CalcGraphReorderCount(graph_topo, plans, tensors);
+
+    // insert reorder ops for the planned formats
+    for (auto node_id : sorted_nodes) {
+        auto kernel = (X86OptKernel*)info->kernels[node_id].get();
+        auto node = kernel->GetNode();
+        auto& choice = plans[node_id].choices[plans[node_id].selected];
+
         for (uint32_t i = 0; i < node->GetInputCount(); i++) {
             auto edge_id = node->GetInput(i);
             if (edge_id == INVALID_EDGEID) {
                 continue;
             }
             auto input_format = tensors[edge_id]->GetShape()->GetDataFormat();
-            auto selected_input_format = selected_input_formats[i];
+            auto selected_input_format = choice.input_formats[i];
             if (input_format != selected_input_format) {
-                status = AddReorderOp(options, edge_id, node_id, REORDER_INPUT, input_format, selected_input_format);
+                auto status = AddReorderOp(options, edge_id, node_id, REORDER_INPUT, input_format, selected_input_format);
                 if (status != ppl::common::RC_SUCCESS) {
                     LOG(ERROR) << "add reorder op failed.";
                     return false;
@@ -249,8 +472,8 @@ bool LayoutOptimize(const OptKernelOptions &options) {
             auto edge_id = node->GetExtraInput(i);
             auto extra_input_format = tensors[edge_id]->GetShape()->GetDataFormat();
             if (extra_input_format != ppl::common::DATAFORMAT_NDARRAY) {
-                status = AddReorderOp(options, edge_id, node_id, REORDER_EXTRA_INPUT, extra_input_format,
-                                      ppl::common::DATAFORMAT_NDARRAY);
+                auto status = AddReorderOp(options, edge_id, node_id, REORDER_EXTRA_INPUT, extra_input_format,
+                                           ppl::common::DATAFORMAT_NDARRAY);
                 if (status != ppl::common::RC_SUCCESS) {
                     LOG(ERROR) << "add reorder op failed.";
                     return false;
@@ -259,10 +482,7 @@ bool LayoutOptimize(const OptKernelOptions &options) {
         }
 
         for (uint32_t i = 0; i < node->GetOutputCount(); i++) {
-            auto edge_id = node->GetOutput(i);
-            auto selected_output_format = selected_output_formats[i];
-            tensors[edge_id]->GetShape()->SetDataFormat(selected_output_format);
-            kernel->SetOutputDataFormat(i, selected_output_format);
+            kernel->SetOutputDataFormat(i, choice.output_formats[i]);
         }
     }
 
@@ -272,6 +492,12 @@ bool LayoutOptimize(const OptKernelOptions &options) {
         return false;
     }
 
+    if (greedy_reorder_count > planned_reorder_count) {
+        LOG(INFO) << "layout planning eliminated " << greedy_reorder_count - planned_reorder_count << " of "
+                  << greedy_reorder_count << " reorder op(s).";
+    }
+    LOG(DEBUG) << "layout planning: " << planned_reorder_count << " reorder op(s) inserted.";
+
     return true;
 }
 
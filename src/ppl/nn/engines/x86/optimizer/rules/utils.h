@@ -64,6 +64,18 @@ inline bool IsGraphOutput(const ir::GraphTopo* graph_topo, edgeid_t edge_id) {
     return false;
 }
 
+inline bool IsOnnxOp(const ir::Node* node, const char* name) {
+    return node && node->GetType().domain == "" && node->GetType().name == name;
+}
+
+// returns the only consumer of edge, or nullptr if edge is a graph output or has more than one consumer
+inline ir::Node* GetSingleConsumer(ir::GraphTopo* graph_topo, const ir::Edge* edge) {
+    if (edge->CalcConsumerCount() != 1 || IsGraphOutput(graph_topo, edge->GetId())) {
+        return nullptr;
+    }
+    return graph_topo->GetNodeById(edge->CreateConsumerIter().Get());
+}
+
 // replace subgraph with one node
 ppl::common::RetCode ReplaceSubgraphWithOneNode(
     const OptKernelOptions& options, std::vector<ir::Node*>& nodes,
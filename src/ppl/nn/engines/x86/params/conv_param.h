@@ -22,6 +22,8 @@
 
 #include "ppl/nn/runtime/tensor_impl.h"
 #include "ppl/kernel/x86/fp32/conv2d.h"
+#include "ppl/kernel/x86/int8/conv2d.h"
+#include "ppl/kernel/x86/bf16/conv2d.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -39,6 +41,26 @@ struct Conv2dParam {
     }
 };
 
+struct Conv2dInt8Param {
+    ppl::kernel::x86::conv2d_int8_param param;
+    ppl::kernel::x86::conv2d_int8_algo_info algo_info;
+    ppl::kernel::x86::conv2d_int8_manager *mgr = nullptr;
+
+    ~Conv2dInt8Param() {
+        if (mgr != nullptr) delete mgr;
+    }
+};
+
+struct Conv2dBf16Param {
+    ppl::kernel::x86::conv2d_bf16_param param;
+    ppl::kernel::x86::conv2d_bf16_algo_info algo_info;
+    ppl::kernel::x86::conv2d_bf16_manager *mgr = nullptr;
+
+    ~Conv2dBf16Param() {
+        if (mgr != nullptr) delete mgr;
+    }
+};
+
 }}}; // namespace ppl::nn::x86
 
 #endif
\ No newline at end of file
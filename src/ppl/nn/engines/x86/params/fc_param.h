@@ -19,6 +19,8 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_PARAMS_FC_PARAM_H_
 
 #include "ppl/kernel/x86/fp32/fc.h"
+#include "ppl/kernel/x86/int8/fc.h"
+#include "ppl/kernel/x86/bf16/fc.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -30,6 +32,22 @@ struct FCParam {
     ~FCParam() { if (mgr != nullptr) delete mgr; }
 };
 
+struct FCInt8Param {
+    ppl::kernel::x86::fc_int8_param param;
+    ppl::kernel::x86::fc_int8_algo_info algo_info;
+    ppl::kernel::x86::fc_int8_manager* mgr = nullptr;
+
+    ~FCInt8Param() { if (mgr != nullptr) delete mgr; }
+};
+
+struct FCBf16Param {
+    ppl::kernel::x86::fc_bf16_param param;
+    ppl::kernel::x86::fc_bf16_algo_info algo_info;
+    ppl::kernel::x86::fc_bf16_manager* mgr = nullptr;
+
+    ~FCBf16Param() { if (mgr != nullptr) delete mgr; }
+};
+
 }}}; // namespace ppl::nn::x86
 
 #endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_PMX_DATA_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_PMX_DATA_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+namespace ppl { namespace nn { namespace x86 {
+
+/**
+   @brief appends plain values and buffers to the private data of an op or the engine.
+   @note data is written in host byte order and is only meant to be read by the x86 engine.
+*/
+class PmxDataWriter final {
+public:
+    void Write(const void* base, uint64_t bytes) {
+        auto ptr = (const uint8_t*)base;
+        data_.insert(data_.end(), ptr, ptr + bytes);
+    }
+
+    template <typename T>
+    void Write(const T& value) {
+        Write(&value, sizeof(T));
+    }
+
+    /** @brief writes element count followed by elements */
+    template <typename T>
+    void WriteArray(const T* values, uint64_t count) {
+        Write(count);
+        Write(values, count * sizeof(T));
+    }
+
+    const std::vector<uint8_t>& GetData() const {
+        return data_;
+    }
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+/** @brief reads data written by `PmxDataWriter` */
+class PmxDataReader final {
+public:
+    PmxDataReader(const void* base, uint64_t size) : base_((const uint8_t*)base), size_(size), offset_(0) {}
+
+    /** @return pointer to the next `bytes` bytes, or nullptr if there is not enough data left */
+    const void* Skip(uint64_t bytes) {
+        if (bytes > size_ - offset_) {
+            return nullptr;
+        }
+        auto ptr = base_ + offset_;
+        offset_ += bytes;
+        return ptr;
+    }
+
+    bool Read(void* dst, uint64_t bytes) {
+        auto src = Skip(bytes);
+        if (!src) {
+            return false;
+        }
+        memcpy(dst, src, bytes);
+        return true;
+    }
+
+    template <typename T>
+    bool Read(T* value) {
+        return Read(value, sizeof(T));
+    }
+
+    /** @return pointer to elements written by `PmxDataWriter::WriteArray()`, or nullptr if data is truncated */
+    template <typename T>
+    const T* ReadArray(uint64_t* count) {
+        if (!Read(count) || *count > (size_ - offset_) / sizeof(T)) {
+            return nullptr;
+        }
+        return (const T*)Skip(*count * sizeof(T));
+    }
+
+private:
+    const uint8_t* base_;
+    uint64_t size_;
+    uint64_t offset_;
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
@@ -29,14 +29,34 @@ namespace ppl { namespace nn { namespace x86 {
 
 static void DummyDeleter(ppl::common::Allocator*) {}
 
-RuntimeX86Device::RuntimeX86Device(uint64_t alignment, isa_t isa, uint32_t mm_policy)
-    : X86Device(alignment, isa), mm_policy_(mm_policy), tmp_buffer_size_(0) {
+RuntimeX86Device::RuntimeX86Device(uint64_t alignment, isa_t isa, uint32_t mm_policy,
+                                   const shared_ptr<const ThreadConfig>& thread_config)
+    : X86Device(alignment, isa)
+    , mm_policy_(mm_policy)
+    , tmp_buffer_size_(0)
+    , tmp_buffer_in_use_(false)
+    , memory_budget_(0)
+    , budget_exceeded_count_(0)
+    , activation_bytes_(0)
+    , max_activation_bytes_(0)
+    , scratch_bytes_(0)
+    , max_scratch_bytes_(0)
+    , max_total_bytes_(0) {
+    const int32_t numa_node_id = (thread_config ? thread_config->numa_node_id : -1);
+    SetThreadConfig(thread_config);
+    SetNumaNode(numa_node_id);
+
     if (mm_policy_ == X86_MM_MRU) {
         auto allocator_ptr = X86Device::GetAllocator();
         allocator_ = std::shared_ptr<Allocator>(allocator_ptr, DummyDeleter);
         buffer_manager_.reset(new utils::StackBufferManager(allocator_ptr));
     } else if (mm_policy_ == X86_MM_COMPACT) {
-        allocator_.reset(new utils::CpuBlockAllocator());
+        if (numa_node_id >= 0) {
+            block_allocator_.reset(new utils::CpuBlockAllocator());
+            allocator_.reset(new NumaAllocator(block_allocator_.get(), numa_node_id));
+        } else {
+            allocator_.reset(new utils::CpuBlockAllocator());
+        }
         buffer_manager_.reset(new utils::CompactBufferManager(allocator_.get(), alignment, 64u));
     }
 }
@@ -44,45 +64,187 @@ RuntimeX86Device::RuntimeX86Device(uint64_t alignment, isa_t isa, uint32_t mm_po
 RuntimeX86Device::~RuntimeX86Device() {
     LOG(DEBUG) << "buffer manager[" << buffer_manager_->GetName() << "] allocates ["
                << buffer_manager_->GetAllocatedBytes() << "] bytes.";
-    if (tmp_buffer_size_) {
+    LOG(DEBUG) << "max activation bytes[" << max_activation_bytes_ << "], max scratch bytes[" << max_scratch_bytes_
+               << "], max total bytes[" << max_total_bytes_ << "]";
+    ReleaseSharedTmpBuffer();
+    buffer_manager_.reset();
+    allocator_.reset();
+}
+
+void RuntimeX86Device::AddActivationBytes(uint64_t bytes) {
+    activation_bytes_ += bytes;
+    if (activation_bytes_ > max_activation_bytes_) {
+        max_activation_bytes_ = activation_bytes_;
+    }
+    if (activation_bytes_ + scratch_bytes_ > max_total_bytes_) {
+        max_total_bytes_ = activation_bytes_ + scratch_bytes_;
+    }
+}
+
+void RuntimeX86Device::AddScratchBytes(uint64_t bytes) {
+    scratch_bytes_ += bytes;
+    if (scratch_bytes_ > max_scratch_bytes_) {
+        max_scratch_bytes_ = scratch_bytes_;
+    }
+    if (activation_bytes_ + scratch_bytes_ > max_total_bytes_) {
+        max_total_bytes_ = activation_bytes_ + scratch_bytes_;
+    }
+}
+
+void RuntimeX86Device::ReleaseSharedTmpBuffer() {
+    if (shared_tmp_buffer_.addr) {
         buffer_manager_->Free(&shared_tmp_buffer_);
+        shared_tmp_buffer_.addr = nullptr;
     }
-    buffer_manager_.reset();
+    scratch_bytes_ -= tmp_buffer_size_;
+    tmp_buffer_size_ = 0;
+}
+
+bool RuntimeX86Device::IsWithinBudget(uint64_t bytes) {
+    if (memory_budget_ == 0 || activation_bytes_ + scratch_bytes_ + bytes <= memory_budget_) {
+        return true;
+    }
+
+    if (!tmp_buffer_in_use_ && tmp_buffer_size_ > 0) {
+        ReleaseSharedTmpBuffer();
+        if (activation_bytes_ + scratch_bytes_ + bytes <= memory_budget_) {
+            return true;
+        }
+    }
+
+    ++budget_exceeded_count_;
+    return false;
+}
+
+RetCode RuntimeX86Device::Realloc(uint64_t bytes, BufferDesc* buffer) {
+    lock_guard<mutex> lck(mutex_);
+
+    auto old_addr = buffer->addr;
+    auto old_ref = old_addr ? activation_addr2bytes_.find(old_addr) : activation_addr2bytes_.end();
+    const uint64_t old_bytes = (old_ref == activation_addr2bytes_.end()) ? 0 : old_ref->second;
+
+    if (bytes > old_bytes && !IsWithinBudget(bytes - old_bytes)) {
+        LOG(DEBUG) << "alloc [" << bytes << "] bytes exceeds memory budget[" << memory_budget_ << "]";
+        return RC_OUT_OF_MEMORY;
+    }
+
+    auto status = buffer_manager_->Realloc(bytes, buffer);
+
+    // old buffer is released unless it is kept on failure
+    if (old_bytes > 0 && (status == RC_SUCCESS || buffer->addr != old_addr)) {
+        activation_addr2bytes_.erase(old_ref);
+        activation_bytes_ -= old_bytes;
+    }
+    if (status == RC_SUCCESS && buffer->addr) {
+        activation_addr2bytes_[buffer->addr] = bytes;
+        AddActivationBytes(bytes);
+    }
+
+    return status;
+}
+
+void RuntimeX86Device::Free(BufferDesc* buffer) {
+    lock_guard<mutex> lck(mutex_);
+
+    if (buffer->addr) {
+        auto ref = activation_addr2bytes_.find(buffer->addr);
+        if (ref != activation_addr2bytes_.end()) {
+            activation_bytes_ -= ref->second;
+            activation_addr2bytes_.erase(ref);
+        }
+    }
+    buffer_manager_->Free(buffer);
 }
 
 RetCode RuntimeX86Device::AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) {
-    if (mm_policy_ == X86_MM_COMPACT) {
-        auto ret = buffer_manager_->Realloc(bytes, &shared_tmp_buffer_);
-        if (RC_SUCCESS != ret) {
-            return ret;
+    lock_guard<mutex> lck(mutex_);
+
+    if (tmp_buffer_in_use_) {
+        // the shared buffer is being used by another kernel running concurrently
+        if (!IsWithinBudget(bytes)) {
+            return RC_OUT_OF_MEMORY;
         }
-    } else {
-        if (bytes > tmp_buffer_size_ || bytes <= tmp_buffer_size_ / 2) {
-            auto ret = buffer_manager_->Realloc(bytes, &shared_tmp_buffer_);
-            if (RC_SUCCESS != ret) {
-                return ret;
-            }
-            tmp_buffer_size_ = bytes;
+
+        buffer->addr = nullptr;
+        auto status = buffer_manager_->Realloc(bytes, buffer);
+        if (status == RC_SUCCESS && buffer->addr) {
+            tmp_addr2bytes_[buffer->addr] = bytes;
+            AddScratchBytes(bytes);
+        }
+        return status;
+    }
+
+    if (mm_policy_ == X86_MM_COMPACT || bytes > tmp_buffer_size_ || bytes <= tmp_buffer_size_ / 2) {
+        ReleaseSharedTmpBuffer();
+        if (!IsWithinBudget(bytes)) {
+            return RC_OUT_OF_MEMORY;
+        }
+
+        auto status = buffer_manager_->Realloc(bytes, &shared_tmp_buffer_);
+        if (RC_SUCCESS != status) {
+            shared_tmp_buffer_.addr = nullptr;
+            return status;
         }
+        tmp_buffer_size_ = bytes;
+        AddScratchBytes(bytes);
     }
     *buffer = shared_tmp_buffer_;
+    tmp_buffer_in_use_ = true;
     return RC_SUCCESS;
 }
 
 void RuntimeX86Device::FreeTmpBuffer(BufferDesc* buffer) {
+    lock_guard<mutex> lck(mutex_);
+
+    if (!tmp_buffer_in_use_ || buffer->addr != shared_tmp_buffer_.addr) {
+        if (buffer->addr) {
+            auto ref = tmp_addr2bytes_.find(buffer->addr);
+            if (ref != tmp_addr2bytes_.end()) {
+                scratch_bytes_ -= ref->second;
+                tmp_addr2bytes_.erase(ref);
+            }
+        }
+        buffer_manager_->Free(buffer);
+        return;
+    }
+
+    tmp_buffer_in_use_ = false;
     if (mm_policy_ == X86_MM_COMPACT) {
-        buffer_manager_->Free(&shared_tmp_buffer_);
+        ReleaseSharedTmpBuffer();
     }
 }
 
+RetCode RuntimeX86Device::GetMemoryStatistics(MemoryStatistics* stat) const {
+    lock_guard<mutex> lck(mutex_);
+
+    stat->activation_bytes = activation_bytes_;
+    stat->max_activation_bytes = max_activation_bytes_;
+    stat->scratch_bytes = scratch_bytes_;
+    stat->max_scratch_bytes = max_scratch_bytes_;
+    stat->total_bytes = activation_bytes_ + scratch_bytes_;
+    stat->max_total_bytes = max_total_bytes_;
+    stat->reserved_bytes = buffer_manager_->GetAllocatedBytes();
+    stat->budget_exceeded_count = budget_exceeded_count_;
+    return RC_SUCCESS;
+}
+
 /* -------------------------------------------------------------------------- */
 
 RetCode RuntimeX86Device::DoMemDefrag(RuntimeX86Device* dev, va_list) {
     return RC_SUCCESS;
 }
 
+RetCode RuntimeX86Device::SetMemoryBudget(RuntimeX86Device* dev, va_list args) {
+    auto bytes = va_arg(args, uint64_t);
+
+    lock_guard<mutex> lck(dev->mutex_);
+    dev->memory_budget_ = bytes;
+    return RC_SUCCESS;
+}
+
 RuntimeX86Device::ConfHandlerFunc RuntimeX86Device::conf_handlers_[] = {
     DoMemDefrag, // X86_DEV_CONF_MEM_DEFRAG
+    SetMemoryBudget, // X86_DEV_CONF_SET_MEMORY_BUDGET
 };
 
 RetCode RuntimeX86Device::Configure(uint32_t option, ...) {
@@ -21,6 +21,8 @@
 #include "ppl/nn/engines/x86/x86_device.h"
 #include "ppl/nn/utils/buffer_manager.h"
 #include "ppl/common/allocator.h"
+#include <mutex>
+#include <map>
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -31,24 +33,22 @@ private:
     }
 
 public:
-    RuntimeX86Device(uint64_t alignment, ppl::common::isa_t isa, uint32_t mm_policy);
+    RuntimeX86Device(uint64_t alignment, ppl::common::isa_t isa, uint32_t mm_policy,
+                     const std::shared_ptr<const ThreadConfig>& thread_config);
     ~RuntimeX86Device();
 
     ppl::common::Allocator* GetAllocator() const override {
         return allocator_.get();
     }
 
-    ppl::common::RetCode Realloc(uint64_t bytes, BufferDesc* buffer) override {
-        return buffer_manager_->Realloc(bytes, buffer);
-    }
-
-    void Free(BufferDesc* buffer) override {
-        buffer_manager_->Free(buffer);
-    }
+    ppl::common::RetCode Realloc(uint64_t bytes, BufferDesc* buffer) override;
+    void Free(BufferDesc* buffer) override;
 
     ppl::common::RetCode AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) override;
     void FreeTmpBuffer(BufferDesc* buffer) override;
 
+    ppl::common::RetCode GetMemoryStatistics(MemoryStatistics*) const override;
+
     // ----- configurations ----- //
 
     /**
@@ -56,16 +56,50 @@ public:
        @note make sure that this device is not used when calling DoMemDefrag().
     */
     static ppl::common::RetCode DoMemDefrag(RuntimeX86Device*, va_list);
+    static ppl::common::RetCode SetMemoryBudget(RuntimeX86Device*, va_list);
 
     typedef ppl::common::RetCode (*ConfHandlerFunc)(RuntimeX86Device*, va_list);
     static ConfHandlerFunc conf_handlers_[X86_DEV_CONF_MAX];
 
     ppl::common::RetCode Configure(uint32_t, ...) override;
 
+private:
+    /**
+       @brief tells whether `bytes` more can be allocated within `memory_budget_`. the cached shared tmp buffer
+       is released if it is not used.
+    */
+    bool IsWithinBudget(uint64_t bytes);
+    void ReleaseSharedTmpBuffer();
+    void AddActivationBytes(uint64_t bytes);
+    void AddScratchBytes(uint64_t bytes);
+
 private:
     uint32_t mm_policy_;
     BufferDesc shared_tmp_buffer_;
     uint64_t tmp_buffer_size_;
+
+    /** tells whether `shared_tmp_buffer_` is held by a kernel. kernels may run concurrently in parallel scheduling. */
+    bool tmp_buffer_in_use_;
+
+    /** max bytes of activations and tmp buffers, 0 means unlimited */
+    uint64_t memory_budget_;
+    uint64_t budget_exceeded_count_;
+
+    /** sizes of buffers allocated by `Realloc()` */
+    std::map<void*, uint64_t> activation_addr2bytes_;
+    /** sizes of tmp buffers other than `shared_tmp_buffer_` */
+    std::map<void*, uint64_t> tmp_addr2bytes_;
+
+    uint64_t activation_bytes_;
+    uint64_t max_activation_bytes_;
+    uint64_t scratch_bytes_;
+    uint64_t max_scratch_bytes_;
+    uint64_t max_total_bytes_;
+
+    /** protects `buffer_manager_`, the shared tmp buffer and memory usage */
+    mutable std::mutex mutex_;
+
+    std::unique_ptr<ppl::common::Allocator> block_allocator_;
     std::unique_ptr<utils::BufferManager> buffer_manager_;
     std::shared_ptr<ppl::common::Allocator> allocator_;
 };
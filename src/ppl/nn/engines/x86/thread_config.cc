@@ -0,0 +1,128 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/thread_config.h"
+#include "ppl/nn/common/logger.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
+#include <atomic>
+using namespace std;
+using namespace ppl::common;
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+#if defined(__linux__) && defined(PPLNN_USE_NUMA)
+#include <numa.h>
+#endif
+
+namespace ppl { namespace nn { namespace x86 {
+
+static uint64_t GenThreadConfigId() {
+    static atomic<uint64_t> next_id(1);
+    return next_id.fetch_add(1);
+}
+
+ThreadConfig::ThreadConfig() : id(GenThreadConfigId()) {}
+
+void ApplyThreadConfig(const ThreadConfig& config) {
+    // openmp settings are per thread, and the same thread may run runtimes of different engines.
+    static thread_local uint64_t applied_id = 0;
+    static thread_local bool is_bound = false;
+    static thread_local int32_t default_thread_num = 0;
+    if (applied_id == config.id) {
+        return;
+    }
+    applied_id = config.id;
+
+    if (default_thread_num == 0) {
+        default_thread_num = ppl::kernel::x86::get_omp_max_threads();
+    }
+    // configs without thread num restore the openmp default instead of keeping the one set by the previous config
+    ppl::kernel::x86::set_omp_num_threads(config.thread_num > 0 ? config.thread_num : default_thread_num);
+
+    if (!config.cores.empty()) {
+#if defined(__linux__)
+        // the calling thread is openmp thread 0 and is bound to cores[0] too. it belongs to the caller of ppl.nn,
+        // so its affinity is restored after binding, which is documented in `X86_CONF_SET_CORE_BINDING`.
+        cpu_set_t caller_cpuset;
+        const bool caller_saved = (pthread_getaffinity_np(pthread_self(), sizeof(caller_cpuset), &caller_cpuset) == 0);
+        ppl::kernel::x86::set_omp_core_binding(config.cores.data(), config.cores.size(), 0);
+        if (caller_saved) {
+            pthread_setaffinity_np(pthread_self(), sizeof(caller_cpuset), &caller_cpuset);
+        }
+#else
+        ppl::kernel::x86::set_omp_core_binding(config.cores.data(), config.cores.size(), 0);
+#endif
+        is_bound = true;
+    } else if (is_bound) {
+        ppl::kernel::x86::unset_omp_core_binding();
+        is_bound = false;
+    }
+}
+
+#if defined(__linux__) && defined(PPLNN_USE_NUMA)
+bool IsNumaNodeAvailable(int32_t numa_node_id) {
+    if (numa_available() < 0) {
+        LOG(WARNING) << "current system does not support NUMA API.";
+        return false;
+    }
+    if (numa_node_id < 0 || numa_node_id > numa_max_node()) {
+        LOG(WARNING) << "invalid numa node id[" << numa_node_id << "], range [0, " << numa_max_node() << "]";
+        return false;
+    }
+    return true;
+}
+
+RetCode GetNumaNodeCores(int32_t numa_node_id, vector<int32_t>* cores) {
+    auto cpumask = numa_allocate_cpumask();
+    if (!cpumask) {
+        return RC_OUT_OF_MEMORY;
+    }
+
+    auto status = RC_SUCCESS;
+    if (numa_node_to_cpus(numa_node_id, cpumask) != 0) {
+        LOG(ERROR) << "get cpus of numa node[" << numa_node_id << "] failed.";
+        status = RC_OTHER_ERROR;
+    } else {
+        cores->clear();
+        for (uint32_t i = 0; i < cpumask->size; ++i) {
+            if (numa_bitmask_isbitset(cpumask, i) && numa_bitmask_isbitset(numa_all_cpus_ptr, i)) {
+                cores->push_back(i);
+            }
+        }
+        if (cores->empty()) {
+            LOG(ERROR) << "no cpu of numa node[" << numa_node_id << "] is available.";
+            status = RC_NOT_FOUND;
+        }
+    }
+
+    numa_free_cpumask(cpumask);
+    return status;
+}
+#else
+bool IsNumaNodeAvailable(int32_t) {
+    LOG(WARNING) << "current build does not support NUMA.";
+    return false;
+}
+
+RetCode GetNumaNodeCores(int32_t, vector<int32_t>*) {
+    return RC_UNSUPPORTED;
+}
+#endif
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,63 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_THREAD_CONFIG_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_THREAD_CONFIG_H_
+
+#include "ppl/common/retcode.h"
+#include <vector>
+#include <stdint.h>
+
+namespace ppl { namespace nn { namespace x86 {
+
+/** @brief threads used by kernels of an engine and runtimes created by it. it should not be modified after creation. */
+struct ThreadConfig final {
+    ThreadConfig();
+
+    /** unique among all configs. used to tell whether a thread has applied this config. */
+    const uint64_t id;
+
+    /** number of openmp threads. 0 means the openmp default. */
+    uint32_t thread_num = 0;
+
+    /** the i-th openmp thread is bound to cores[i]. empty means no binding. */
+    std::vector<int32_t> cores;
+
+    /** numa node where memory is allocated. -1 means no binding. */
+    int32_t numa_node_id = -1;
+
+private:
+    ThreadConfig(const ThreadConfig&) = delete;
+    ThreadConfig& operator=(const ThreadConfig&) = delete;
+};
+
+/**
+   @brief sets thread num and core binding of openmp threads started by the calling thread. the openmp default thread
+   num is restored and threads are unbound if `config` does not set them. affinity of the calling thread is kept.
+   @note it does nothing if the calling thread has applied `config` already.
+*/
+void ApplyThreadConfig(const ThreadConfig& config);
+
+/** @brief tells whether `numa_node_id` can be used for binding in current build and system */
+bool IsNumaNodeAvailable(int32_t numa_node_id);
+
+/** @brief gets cpus of `numa_node_id` which can be used by current process */
+ppl::common::RetCode GetNumaNodeCores(int32_t numa_node_id, std::vector<int32_t>* cores);
+
+}}} // namespace ppl::nn::x86
+
+#endif
@@ -20,8 +20,11 @@
 
 #include "ppl/nn/common/device.h"
 #include "ppl/nn/engines/x86/data_converter.h"
+#include "ppl/nn/engines/x86/numa_allocator.h"
+#include "ppl/nn/engines/x86/thread_config.h"
 #include "ppl/common/generic_cpu_allocator.h"
 #include <cstring> // memcpy
+#include <memory>
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -37,6 +40,23 @@ public:
         return isa_;
     }
 
+    /** @brief threads used by kernels running on this device. nullptr means using the openmp default. */
+    void SetThreadConfig(const std::shared_ptr<const ThreadConfig>& config) {
+        thread_config_ = config;
+    }
+    const ThreadConfig* GetThreadConfig() const {
+        return thread_config_.get();
+    }
+
+    /** @brief places memory allocated by this device on `numa_node_id`. -1 means no binding. */
+    void SetNumaNode(int32_t numa_node_id) {
+        if (numa_node_id < 0) {
+            numa_allocator_.reset();
+        } else {
+            numa_allocator_.reset(new NumaAllocator(&allocator_, numa_node_id));
+        }
+    }
+
     virtual ppl::common::RetCode AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) {
         return Realloc(bytes, buffer);
     }
@@ -46,12 +66,13 @@ public:
     }
 
     virtual ppl::common::Allocator* GetAllocator() const {
-        return &allocator_;
+        return X86Device::GetDefaultAllocator();
     }
 
     ppl::common::RetCode Realloc(uint64_t bytes, BufferDesc* buffer) override {
+        auto allocator = X86Device::GetDefaultAllocator();
         if (buffer->addr) {
-            allocator_.Free(buffer->addr);
+            allocator->Free(buffer->addr);
         }
 
         if (bytes == 0) {
@@ -59,7 +80,7 @@ public:
             return ppl::common::RC_SUCCESS;
         }
 
-        buffer->addr = allocator_.Alloc(bytes);
+        buffer->addr = allocator->Alloc(bytes);
         if (!buffer->addr) {
             return ppl::common::RC_OUT_OF_MEMORY;
         }
@@ -70,7 +91,7 @@ public:
 
     void Free(BufferDesc* buffer) override {
         if (buffer->addr) {
-            allocator_.Free(buffer->addr);
+            X86Device::GetDefaultAllocator()->Free(buffer->addr);
             buffer->addr = nullptr;
         }
     }
@@ -115,10 +136,20 @@ public:
         return ppl::common::RC_UNSUPPORTED;
     }
 
+private:
+    ppl::common::Allocator* GetDefaultAllocator() const {
+        if (numa_allocator_) {
+            return numa_allocator_.get();
+        }
+        return &allocator_;
+    }
+
 private:
     ppl::common::isa_t isa_;
     X86DataConverter data_converter_;
     mutable ppl::common::GenericCpuAllocator allocator_;
+    std::unique_ptr<NumaAllocator> numa_allocator_;
+    std::shared_ptr<const ThreadConfig> thread_config_;
 };
 
 }}} // namespace ppl::nn::x86
@@ -25,13 +25,11 @@ using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace onnx {
 
-static RetCode ParseGraphInitializer(const ::onnx::GraphProto& pb_graph, ir::GraphTopo* topo, ir::GraphData* data) {
+static RetCode ParseGraphInitializer(const ::onnx::GraphProto& pb_graph, ::onnx::GraphProto* movable_pb_graph,
+                                     utils::ExternalDataFileCache* file_cache, ir::GraphTopo* topo,
+                                     ir::GraphData* data) {
     for (int i = 0; i < pb_graph.initializer_size(); ++i) {
         const ::onnx::TensorProto& pb_initializer = pb_graph.initializer(i);
-        if (pb_initializer.external_data_size() > 0) {
-            LOG(ERROR) << "external data is not supported now.";
-            return RC_UNSUPPORTED;
-        }
 
         auto ret_pair = topo->AddEdge(pb_initializer.name());
         if (!ret_pair.second) {
@@ -42,7 +40,13 @@ static RetCode ParseGraphInitializer(const ::onnx::GraphProto& pb_graph, ir::Gra
 
         ir::Shape shape;
         ir::Constant constant;
-        auto status = utils::ParseTensorProto(pb_initializer, &constant.data, &shape);
+        RetCode status;
+        if (movable_pb_graph) {
+            status = utils::ParseTensorProto(movable_pb_graph->mutable_initializer(i), file_cache, &constant.data,
+                                             &shape);
+        } else {
+            status = utils::ParseTensorProto(pb_initializer, file_cache, &constant.data, &shape);
+        }
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "ParseTensorProto failed: " << GetRetCodeStr(status);
             return status;
@@ -238,7 +242,19 @@ static RetCode ParseGraphOutput(const ::onnx::GraphProto& pb_graph, ir::GraphTop
     return RC_SUCCESS;
 }
 
-RetCode GraphParser::Parse(const ::onnx::GraphProto& pb_graph, const map<string, uint64_t>& op_sets, ir::Graph* graph) {
+RetCode GraphParser::Parse(const ::onnx::GraphProto& pb_graph, const map<string, uint64_t>& op_sets,
+                           utils::ExternalDataFileCache* file_cache, ir::Graph* graph) {
+    return DoParse(pb_graph, nullptr, op_sets, file_cache, graph);
+}
+
+RetCode GraphParser::Parse(::onnx::GraphProto* pb_graph, const map<string, uint64_t>& op_sets,
+                           utils::ExternalDataFileCache* file_cache, ir::Graph* graph) {
+    return DoParse(*pb_graph, pb_graph, op_sets, file_cache, graph);
+}
+
+RetCode GraphParser::DoParse(const ::onnx::GraphProto& pb_graph, ::onnx::GraphProto* movable_pb_graph,
+                             const map<string, uint64_t>& op_sets, utils::ExternalDataFileCache* file_cache,
+                             ir::Graph* graph) {
     graph->topo = make_shared<ir::FullGraphTopo>();
     graph->data = make_shared<ir::GraphData>();
 
@@ -247,7 +263,7 @@ RetCode GraphParser::Parse(const ::onnx::GraphProto& pb_graph, const map<string,
 
     topo->SetName(pb_graph.name());
 
-    auto status = ParseGraphInitializer(pb_graph, topo, data);
+    auto status = ParseGraphInitializer(pb_graph, movable_pb_graph, file_cache, topo, data);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "ParseGraphInitializer failed.";
         return status;
@@ -21,13 +21,27 @@
 #include "ppl/common/retcode.h"
 #include "ppl/nn/ir/graph.h"
 #include "ppl/nn/models/onnx/generated/onnx.pb.h"
+#include "ppl/nn/models/onnx/utils.h"
 
 namespace ppl { namespace nn { namespace onnx {
 
 class GraphParser final {
 public:
+    /**
+       @param file_cache keeps files of external data of initializers mapped while parsing. files are mapped for
+       each initializer if it is nullptr.
+    */
     ppl::common::RetCode Parse(const ::onnx::GraphProto& pb_graph, const std::map<std::string, uint64_t>& op_sets,
-                               ir::Graph* graph);
+                               utils::ExternalDataFileCache* file_cache, ir::Graph* graph);
+
+    /** @brief same as above except that raw data of initializers are moved from `pb_graph` instead of being copied */
+    ppl::common::RetCode Parse(::onnx::GraphProto* pb_graph, const std::map<std::string, uint64_t>& op_sets,
+                               utils::ExternalDataFileCache* file_cache, ir::Graph* graph);
+
+private:
+    ppl::common::RetCode DoParse(const ::onnx::GraphProto& pb_graph, ::onnx::GraphProto* movable_pb_graph,
+                                 const std::map<std::string, uint64_t>& op_sets,
+                                 utils::ExternalDataFileCache* file_cache, ir::Graph* graph);
 
 private:
     uint32_t anonymous_node_count_ = 0; // used to generate anonymous node name
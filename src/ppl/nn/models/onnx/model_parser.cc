@@ -17,8 +17,9 @@
 
 #include "ppl/nn/models/onnx/model_parser.h"
 #include "ppl/nn/models/onnx/graph_parser.h"
+#include "ppl/nn/models/onnx/utils.h"
 #include "ppl/nn/common/logger.h"
-#include "ppl/common/file_mapping.h"
+#include <fstream>
 
 // large proto file support
 #include "google/protobuf/io/coded_stream.h"
@@ -46,7 +47,24 @@ static bool ParseFromBinaryBuffer(const char* buf, uint64_t buf_len, google::pro
     return pb_model->ParseFromCodedStream(&cis);
 }
 
-static map<string, uint64_t> ParseOpSets(const ::onnx::ModelProto pb_model) {
+/*
+  the model file is read and parsed block by block, so that the whole file is not kept in memory along with the
+  parsed model.
+*/
+static bool ParseFromBinaryFile(const char* model_file, google::protobuf::MessageLite* pb_model) {
+    ifstream ifs(model_file, ios_base::in | ios_base::binary);
+    if (!ifs.is_open()) {
+        LOG(ERROR) << "open model file[" << model_file << "] failed.";
+        return false;
+    }
+
+    google::protobuf::io::IstreamInputStream iis(&ifs);
+    google::protobuf::io::CodedInputStream cis(&iis);
+    cis.SetTotalBytesLimit(INT_MAX);
+    return pb_model->ParseFromCodedStream(&cis);
+}
+
+static map<string, uint64_t> ParseOpSets(const ::onnx::ModelProto& pb_model) {
     map<string, uint64_t> res;
     for (int i = 0; i < pb_model.opset_import_size(); ++i) {
         const string& domain = pb_model.opset_import(i).domain();
@@ -60,22 +78,136 @@ static map<string, uint64_t> ParseOpSets(const ::onnx::ModelProto pb_model) {
     return res;
 }
 
-RetCode ModelParser::Parse(const char* buf, uint64_t buf_len, ir::Graph* graph) {
-    ::onnx::ModelProto pb_model;
-    if (!ParseFromBinaryBuffer(buf, buf_len, &pb_model)) {
-        LOG(ERROR) << "load onnx model from model buffer failed.";
-        return RC_OTHER_ERROR;
+static inline bool IsAbsolutePath(const string& path) {
+#if defined(_WIN32) || defined(_WIN64)
+    return (path.size() > 1 && path[1] == ':') || (!path.empty() && (path[0] == '\\' || path[0] == '/'));
+#else
+    return (!path.empty() && path[0] == '/');
+#endif
+}
+
+// `..` may lead to files outside of the directory of the model
+static bool HasParentDirComponent(const string& path) {
+    string::size_type begin = 0;
+    while (begin <= path.size()) {
+#if defined(_WIN32) || defined(_WIN64)
+        auto end = path.find_first_of("/\\", begin);
+#else
+        auto end = path.find('/', begin);
+#endif
+        if (end == string::npos) {
+            end = path.size();
+        }
+        if (path.compare(begin, end - begin, "..") == 0) {
+            return true;
+        }
+        begin = end + 1;
+    }
+    return false;
+}
+
+static RetCode ResolveExternalDataLocation(const string& model_file_dir, ::onnx::TensorProto* pb_tensor) {
+    if (pb_tensor->data_location() != ::onnx::TensorProto_DataLocation_EXTERNAL) {
+        return RC_SUCCESS;
+    }
+
+    for (int i = 0; i < pb_tensor->external_data_size(); ++i) {
+        auto entry = pb_tensor->mutable_external_data(i);
+        if (entry->key() != "location") {
+            continue;
+        }
+        // onnx requires locations to be relative to the directory of the model file
+        if (IsAbsolutePath(entry->value())) {
+            LOG(ERROR) << "location[" << entry->value() << "] of external data of tensor[" << pb_tensor->name()
+                       << "] should be a relative path.";
+            return RC_INVALID_VALUE;
+        }
+        if (HasParentDirComponent(entry->value())) {
+            LOG(ERROR) << "location[" << entry->value() << "] of external data of tensor[" << pb_tensor->name()
+                       << "] should not contain `..`.";
+            return RC_INVALID_VALUE;
+        }
+        if (!model_file_dir.empty()) {
+            entry->set_value(model_file_dir + "/" + entry->value());
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+/* external data may be referred to by initializers and tensor attributes of nodes, including those in subgraphs */
+static RetCode ResolveExternalDataLocations(const string& model_file_dir, ::onnx::GraphProto* pb_graph) {
+    for (int i = 0; i < pb_graph->initializer_size(); ++i) {
+        auto status = ResolveExternalDataLocation(model_file_dir, pb_graph->mutable_initializer(i));
+        if (status != RC_SUCCESS) {
+            return status;
+        }
     }
 
-    if (pb_model.graph().quantization_annotation_size() > 0) {
+    for (int i = 0; i < pb_graph->node_size(); ++i) {
+        auto pb_node = pb_graph->mutable_node(i);
+        for (int j = 0; j < pb_node->attribute_size(); ++j) {
+            auto pb_attr = pb_node->mutable_attribute(j);
+
+            RetCode status = RC_SUCCESS;
+            if (pb_attr->has_t()) {
+                status = ResolveExternalDataLocation(model_file_dir, pb_attr->mutable_t());
+            }
+            for (int k = 0; status == RC_SUCCESS && k < pb_attr->tensors_size(); ++k) {
+                status = ResolveExternalDataLocation(model_file_dir, pb_attr->mutable_tensors(k));
+            }
+            if (status == RC_SUCCESS && pb_attr->has_g()) {
+                status = ResolveExternalDataLocations(model_file_dir, pb_attr->mutable_g());
+            }
+            for (int k = 0; status == RC_SUCCESS && k < pb_attr->graphs_size(); ++k) {
+                status = ResolveExternalDataLocations(model_file_dir, pb_attr->mutable_graphs(k));
+            }
+            if (status != RC_SUCCESS) {
+                return status;
+            }
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+static string GetParentDir(const char* path) {
+    const string str(path);
+#if defined(_WIN32) || defined(_WIN64)
+    auto pos = str.find_last_of("/\\");
+#else
+    auto pos = str.find_last_of('/');
+#endif
+    if (pos == string::npos) {
+        return string();
+    }
+    if (pos == 0) {
+        return string("/");
+    }
+    return str.substr(0, pos);
+}
+
+/* raw data of initializers are moved from `pb_model` to `graph` */
+static RetCode ParseModelProto(::onnx::ModelProto* pb_model, const char* model_file_dir, ir::Graph* graph) {
+    auto status = ResolveExternalDataLocations(model_file_dir ? string(model_file_dir) : string(),
+                                               pb_model->mutable_graph());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "ResolveExternalDataLocations failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    if (pb_model->graph().quantization_annotation_size() > 0) {
         LOG(ERROR) << "quantization in ONNX model is not supported now.";
         return RC_UNSUPPORTED;
     }
 
-    map<string, uint64_t> op_sets = ParseOpSets(pb_model);
+    map<string, uint64_t> op_sets = ParseOpSets(*pb_model);
+
+    // files of external data are mapped once while parsing
+    utils::ExternalDataFileCache file_cache;
 
     GraphParser graph_parser;
-    auto status = graph_parser.Parse(pb_model.graph(), op_sets, graph);
+    status = graph_parser.Parse(pb_model->mutable_graph(), op_sets, &file_cache, graph);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "parse graph failed: " << GetRetCodeStr(status);
         return status;
@@ -93,4 +225,25 @@ RetCode ModelParser::Parse(const char* buf, uint64_t buf_len, ir::Graph* graph)
     return RC_SUCCESS;
 }
 
+RetCode ModelParser::Parse(const char* buf, uint64_t buf_len, ir::Graph* graph, const char* model_file_dir) {
+    ::onnx::ModelProto pb_model;
+    if (!ParseFromBinaryBuffer(buf, buf_len, &pb_model)) {
+        LOG(ERROR) << "load onnx model from model buffer failed.";
+        return RC_OTHER_ERROR;
+    }
+
+    return ParseModelProto(&pb_model, model_file_dir, graph);
+}
+
+RetCode ModelParser::Parse(const char* model_file, ir::Graph* graph) {
+    ::onnx::ModelProto pb_model;
+    if (!ParseFromBinaryFile(model_file, &pb_model)) {
+        LOG(ERROR) << "load onnx model from file[" << model_file << "] failed.";
+        return RC_OTHER_ERROR;
+    }
+
+    const string model_file_dir = GetParentDir(model_file);
+    return ParseModelProto(&pb_model, model_file_dir.c_str(), graph);
+}
+
 }}} // namespace ppl::nn::onnx
@@ -25,7 +25,15 @@ namespace ppl { namespace nn { namespace onnx {
 
 class ModelParser final {
 public:
-    static ppl::common::RetCode Parse(const char* model_buf, uint64_t buf_len, ir::Graph* graph);
+    /**
+       @param model_file_dir directory which locations of external data are relative to. the current working
+       directory is used if it is nullptr or empty.
+    */
+    static ppl::common::RetCode Parse(const char* model_buf, uint64_t buf_len, ir::Graph* graph,
+                                      const char* model_file_dir = nullptr);
+
+    /** @brief parses `model_file` and loads external data relative to the directory of `model_file` */
+    static ppl::common::RetCode Parse(const char* model_file, ir::Graph* graph);
 };
 
 }}} // namespace ppl::nn::onnx
@@ -34,6 +34,7 @@
 #include "ppl/nn/models/onnx/parsers/onnx/parse_gather_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_gather_nd_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_gemm_param.h"
+#include "ppl/nn/models/onnx/parsers/onnx/parse_gru_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_if_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_leaky_relu_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_loop_param.h"
@@ -45,6 +46,7 @@
 #include "ppl/nn/models/onnx/parsers/onnx/parse_pooling_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_reduce_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_resize_param.h"
+#include "ppl/nn/models/onnx/parsers/onnx/parse_rnn_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_roialign_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_scatter_elements_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_softmax_param.h"
@@ -168,6 +170,7 @@ ParamParserManager::ParamParserManager() {
     PPL_REGISTER_OP_WITH_PARAM("", "Gemm", 11, 12, ppl::nn::common::GemmParam, ParseGemmParam);
     PPL_REGISTER_OP_WITH_PARAM("", "GlobalAveragePool", 1, 16, ppl::nn::common::PoolingParam, ParsePoolingParam);
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Greater", 9, 12);
+    PPL_REGISTER_OP_WITH_PARAM("", "GRU", 7, 13, ppl::nn::common::GRUParam, ParseGRUParam);
     // I
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Identity", 1, 12);
     PPL_REGISTER_OP_WITH_PARAM("", "If", 11, 12, ppl::nn::common::IfParam, ParseIfParam);
@@ -204,6 +207,7 @@ ParamParserManager::ParamParserManager() {
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Relu", 6, 12);
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Reshape", 5, 12);
     PPL_REGISTER_OP_WITH_PARAM("", "Resize", 11, 12, ppl::nn::common::ResizeParam, ParseResizeParam);
+    PPL_REGISTER_OP_WITH_PARAM("", "RNN", 7, 13, ppl::nn::common::RNNParam, ParseRNNParam);
     PPL_REGISTER_OP_WITH_PARAM("", "RoiAlign", 10, 15, ppl::nn::common::RoiAlignParam, ParseRoiAlignParam);
     // S
     PPL_REGISTER_OP_WITH_PARAM("", "ScatterElements", 11, 12, ppl::nn::common::ScatterElementsParam,
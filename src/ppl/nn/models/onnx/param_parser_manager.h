@@ -43,12 +43,12 @@ public:
         return &mgr;
     }
 
-    ppl::common::RetCode Register(const std::string& domain, const std::string& type, const utils::VersionRange&,
-                                  const ParserInfo&);
+    ppl::common::RetCode Register(const std::string& domain, const std::string& type,
+                                  const ppl::nn::utils::VersionRange&, const ParserInfo&);
     const ParserInfo* Find(const std::string& domain, const std::string& type, uint64_t version) const;
 
 private:
-    utils::OpInfoManager<ParserInfo> mgr_;
+    ppl::nn::utils::OpInfoManager<ParserInfo> mgr_;
 
 private:
     ParamParserManager();
@@ -34,7 +34,7 @@ ppl::common::RetCode ParseConstantOfShapeParam(const ::onnx::NodeProto& pb_node,
         param->data.assign((const char*)&f, sizeof(f));
     } else {
         ir::Shape shape;
-        auto status = utils::ParseTensorProto(*value, &param->data, &shape);
+        auto status = utils::ParseTensorProto(*value, nullptr, &param->data, &shape);
         if (status != ppl::common::RC_SUCCESS) {
             LOG(ERROR) << "parse attribute of node[" << pb_node.name()
                        << "] failed: " << ppl::common::GetRetCodeStr(status);
@@ -25,7 +25,7 @@ namespace ppl { namespace nn { namespace onnx {
 
 static RetCode DoParseTensorProto(const ::onnx::TensorProto& pb_tensor, ppl::nn::common::ConstantParam* param) {
     ir::Shape shape;
-    auto status = utils::ParseTensorProto(pb_tensor, &param->data, &shape);
+    auto status = utils::ParseTensorProto(pb_tensor, nullptr, &param->data, &shape);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "parse `value` failed: " << GetRetCodeStr(status);
         return status;
@@ -70,7 +70,7 @@ RetCode ParseIfParam(const ::onnx::NodeProto& pb_node, const map<string, uint64_
 
         if (attr.name() == "then_branch") {
             GraphParser parser;
-            auto status = parser.Parse(attr.g(), op_sets, &param->then_branch);
+            auto status = parser.Parse(attr.g(), op_sets, nullptr, &param->then_branch);
             if (status != RC_SUCCESS) {
                 LOG(ERROR) << "parse then_branch of if op[" << pb_node.name() << "] failed: " << GetRetCodeStr(status);
                 return status;
@@ -85,7 +85,7 @@ RetCode ParseIfParam(const ::onnx::NodeProto& pb_node, const map<string, uint64_
             }
         } else if (attr.name() == "else_branch") {
             GraphParser parser;
-            auto status = parser.Parse(attr.g(), op_sets, &param->else_branch);
+            auto status = parser.Parse(attr.g(), op_sets, nullptr, &param->else_branch);
             if (status != RC_SUCCESS) {
                 LOG(ERROR) << "parse else_branch of if op[" << pb_node.name() << "] failed: " << GetRetCodeStr(status);
                 return status;
@@ -15,7 +15,6 @@
 // specific language governing permissions and limitations
 // under the License.
 
-#include "ppl/common/file_mapping.h"
 #include "ppl/nn/common/logger.h"
 #include "ppl/nn/optimizers/utils.h"
 #include "ppl/nn/optimizers/engine_graph_partitioner.h"
@@ -43,13 +42,17 @@ RuntimeBuilderImpl::~RuntimeBuilderImpl() {
     graph_info_.reset();
 }
 
-RetCode RuntimeBuilderImpl::Init(const char* model_buf, uint64_t buf_len, Engine** engines, uint32_t engine_num) {
+void RuntimeBuilderImpl::InitResource(Engine** engines, uint32_t engine_num) {
     resource_.engines.resize(engine_num);
     for (uint32_t i = 0; i < engine_num; ++i) {
         resource_.engines[i] = static_cast<EngineImpl*>(engines[i]);
     }
 
     resource_.graph_partitioner = make_shared<EngineGraphPartitioner>();
+}
+
+RetCode RuntimeBuilderImpl::Init(const char* model_buf, uint64_t buf_len, Engine** engines, uint32_t engine_num) {
+    InitResource(engines, engine_num);
 
     auto status = ModelParser::Parse(model_buf, buf_len, &graph_);
     if (status != RC_SUCCESS) {
@@ -61,13 +64,16 @@ RetCode RuntimeBuilderImpl::Init(const char* model_buf, uint64_t buf_len, Engine
 }
 
 RetCode RuntimeBuilderImpl::Init(const char* model_file, Engine** engines, uint32_t engine_num) {
-    FileMapping fm;
-    auto status = fm.Init(model_file);
+    InitResource(engines, engine_num);
+
+    // external data, if any, is located relative to the directory of `model_file`
+    auto status = ModelParser::Parse(model_file, &graph_);
     if (status != RC_SUCCESS) {
-        LOG(ERROR) << "Init filemapping from file [" << model_file << "] faild: " << GetRetCodeStr(status);
+        LOG(ERROR) << "parse graph from file[" << model_file << "] failed: " << GetRetCodeStr(status);
         return status;
     }
-    return Init(fm.Data(), fm.Size(), engines, engine_num);
+
+    return RC_SUCCESS;
 }
 
 RetCode RuntimeBuilderImpl::Preprocess() {
@@ -77,12 +83,21 @@ RetCode RuntimeBuilderImpl::Preprocess() {
         return status;
     }
 
+    // constants have been loaded or converted by engines. release them to reduce memory usage.
+    graph_.data->constants.clear();
+
     status = GenerateRuntimeAuxInfo(graph_.topo.get(), aux_info_.get());
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "GenerateRuntimeAuxInfo failed: " << GetRetCodeStr(status);
         return status;
     }
 
+    status = GenerateRuntimeMemoryPlan(graph_.topo.get(), *graph_info_, *aux_info_, &aux_info_->memory_plan);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "GenerateRuntimeMemoryPlan failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
     return RC_SUCCESS;
 }
 
@@ -39,6 +39,9 @@ public:
     Runtime* CreateRuntime() override;
     ppl::common::RetCode Serialize(const char* output_file, const char* fmt) const override;
 
+private:
+    void InitResource(Engine** engines, uint32_t engine_num);
+
 private:
     ir::Graph graph_;
     utils::SharedResource resource_;
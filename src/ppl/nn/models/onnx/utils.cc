@@ -17,6 +17,8 @@
 
 #include "ppl/nn/models/onnx/utils.h"
 #include "ppl/nn/common/logger.h"
+#include "ppl/common/file_mapping.h"
+#include <stdlib.h>
 using namespace std;
 using namespace ppl::common;
 
@@ -144,16 +146,122 @@ datatype_t ConvertOnnxDataTypeToPplDataType(int32_t onnx_data_type) {
     return dt_map[onnx_data_type];
 }
 
-RetCode ParseTensorProto(const ::onnx::TensorProto& pb_tensor, string* data, ir::Shape* shape) {
+static bool ParseUint64(const string& str, uint64_t* value) {
+    if (str.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    *value = strtoull(str.c_str(), &end, 10);
+    return (*end == '\0');
+}
+
+RetCode ExternalDataFileCache::GetFile(const string& path, const FileMapping** fm) {
+    auto ref = files_.find(path);
+    if (ref != files_.end()) {
+        *fm = ref->second.get();
+        return RC_SUCCESS;
+    }
+
+    unique_ptr<FileMapping> new_fm(new FileMapping());
+    auto status = new_fm->Init(path.c_str());
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    *fm = new_fm.get();
+    files_.insert(make_pair(path, std::move(new_fm)));
+    return RC_SUCCESS;
+}
+
+/*
+  data of `pb_tensor` is in the file `location` instead of the model. the file is mapped and only the
+  [offset, offset + length) part is read into `data`. the mapping is kept by `file_cache` for other
+  tensors in the same file, or released right after copying if `file_cache` is nullptr.
+*/
+static RetCode ParseExternalData(const ::onnx::TensorProto& pb_tensor, uint64_t expected_bytes,
+                                 ExternalDataFileCache* file_cache, string* data) {
+    string location;
+    uint64_t offset = 0;
+    uint64_t length = expected_bytes;
+    for (int i = 0; i < pb_tensor.external_data_size(); ++i) {
+        auto& entry = pb_tensor.external_data(i);
+        if (entry.key() == "location") {
+            location = entry.value();
+        } else if (entry.key() == "offset") {
+            if (!ParseUint64(entry.value(), &offset)) {
+                LOG(ERROR) << "invalid offset[" << entry.value() << "] of external data of tensor[" << pb_tensor.name()
+                           << "]";
+                return RC_INVALID_VALUE;
+            }
+        } else if (entry.key() == "length") {
+            if (!ParseUint64(entry.value(), &length)) {
+                LOG(ERROR) << "invalid length[" << entry.value() << "] of external data of tensor[" << pb_tensor.name()
+                           << "]";
+                return RC_INVALID_VALUE;
+            }
+        }
+    }
+
+    if (location.empty()) {
+        LOG(ERROR) << "location of external data of tensor[" << pb_tensor.name() << "] is not set.";
+        return RC_INVALID_VALUE;
+    }
+    if (length != expected_bytes) {
+        LOG(ERROR) << "length of external data of tensor[" << pb_tensor.name() << "] is [" << length
+                   << "] while its shape requires [" << expected_bytes << "] bytes.";
+        return RC_INVALID_VALUE;
+    }
+    if (length == 0) {
+        data->clear();
+        return RC_SUCCESS;
+    }
+
+    FileMapping local_fm;
+    const FileMapping* fm = &local_fm;
+    RetCode status;
+    if (file_cache) {
+        status = file_cache->GetFile(location, &fm);
+    } else {
+        status = local_fm.Init(location.c_str());
+    }
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "Init filemapping from external data file[" << location << "] of tensor[" << pb_tensor.name()
+                   << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+    if (offset > fm->Size() || length > fm->Size() - offset) {
+        LOG(ERROR) << "external data [" << offset << ", " << offset + length << ") of tensor[" << pb_tensor.name()
+                   << "] exceeds size [" << fm->Size() << "] of file[" << location << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    data->assign(fm->Data() + offset, length);
+    return RC_SUCCESS;
+}
+
+RetCode ParseTensorProto(const ::onnx::TensorProto& pb_tensor, ExternalDataFileCache* file_cache, string* data,
+                         ir::Shape* shape) {
     const int32_t onnx_data_type = pb_tensor.data_type();
     const datatype_t ppl_data_type = utils::ConvertOnnxDataTypeToPplDataType(onnx_data_type);
     const uint32_t elem_size = GetSizeOfDataType(ppl_data_type);
 
     shape->data_type = ppl_data_type;
     shape->data_format = DATAFORMAT_NDARRAY; // default data format
+    uint64_t nr_element = 1;
     for (int j = 0; j < pb_tensor.dims_size(); ++j) {
         auto dim = pb_tensor.dims(j);
         shape->dims.push_back(dim);
+        nr_element *= dim;
+    }
+
+    if (pb_tensor.data_location() == ::onnx::TensorProto_DataLocation_EXTERNAL) {
+        if (ppl_data_type == DATATYPE_UNKNOWN) {
+            auto onnx_pb_type = (::onnx::TensorProto_DataType)onnx_data_type;
+            LOG(ERROR) << "unsupported onnx data type[" << ::onnx::TensorProto_DataType_Name(onnx_pb_type)
+                       << "] of tensor[" << pb_tensor.name() << "]";
+            return RC_UNSUPPORTED;
+        }
+        return ParseExternalData(pb_tensor, nr_element * elem_size, file_cache, data);
     }
 
     if (onnx_data_type == ::onnx::TensorProto_DataType_FLOAT) {
@@ -199,6 +307,28 @@ RetCode ParseTensorProto(const ::onnx::TensorProto& pb_tensor, string* data, ir:
     return RC_SUCCESS;
 }
 
+RetCode ParseTensorProto(::onnx::TensorProto* pb_tensor, ExternalDataFileCache* file_cache, string* data,
+                         ir::Shape* shape) {
+    if (pb_tensor->raw_data().empty()) {
+        return ParseTensorProto(*pb_tensor, file_cache, data, shape);
+    }
+
+    /*
+      raw data is taken out before parsing, so the const version above only fills `shape` and checks the data type,
+      and then it is moved to `data`.
+    */
+    string raw_data;
+    raw_data.swap(*pb_tensor->mutable_raw_data());
+
+    auto status = ParseTensorProto(*pb_tensor, file_cache, data, shape);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    data->swap(raw_data);
+    return RC_SUCCESS;
+}
+
 void ResolveExtraInputs(ir::GraphTopo* current, ir::Node* parent_node, ir::GraphTopo* parent_graph) {
     for (uint32_t i = 0; i < current->GetExtraInputCount(); ++i) {
         auto edge = current->GetEdgeById(current->GetExtraInput(i));
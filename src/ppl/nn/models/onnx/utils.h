@@ -21,6 +21,9 @@
 #include "ppl/nn/models/onnx/generated/onnx.pb.h"
 #include "ppl/nn/ir/graph.h"
 #include "ppl/common/types.h"
+#include "ppl/common/file_mapping.h"
+#include <map>
+#include <memory>
 
 namespace ppl { namespace nn { namespace onnx { namespace utils {
 
@@ -43,7 +46,35 @@ T GetNodeAttrByKey(const ::onnx::NodeProto& node, const char* key, T default_val
 
 const ::onnx::TensorProto* GetTensorProtoByKey(const ::onnx::NodeProto&, const char* key);
 
-ppl::common::RetCode ParseTensorProto(const ::onnx::TensorProto&, std::string*, ir::Shape*);
+/**
+   @brief keeps files of external data mapped while it exists, so that each file is mapped once no matter how many
+   tensors refer to it.
+*/
+class ExternalDataFileCache final {
+public:
+    ExternalDataFileCache() {}
+
+    /** @brief maps `path` if it is not mapped yet */
+    ppl::common::RetCode GetFile(const std::string& path, const ppl::common::FileMapping** fm);
+
+private:
+    std::map<std::string, std::unique_ptr<ppl::common::FileMapping>> files_;
+
+private:
+    ExternalDataFileCache(const ExternalDataFileCache&) = delete;
+    ExternalDataFileCache& operator=(const ExternalDataFileCache&) = delete;
+};
+
+/**
+   @param file_cache keeps files of external data mapped for other tensors. files are mapped for each tensor and
+   released right after copying if it is nullptr.
+*/
+ppl::common::RetCode ParseTensorProto(const ::onnx::TensorProto&, ExternalDataFileCache* file_cache, std::string*,
+                                      ir::Shape*);
+
+/** @brief same as above except that raw data is moved from the given tensor instead of being copied */
+ppl::common::RetCode ParseTensorProto(::onnx::TensorProto*, ExternalDataFileCache* file_cache, std::string*,
+                                      ir::Shape*);
 
 ppl::common::datatype_t ConvertOnnxDataTypeToPplDataType(int32_t data_type);
 
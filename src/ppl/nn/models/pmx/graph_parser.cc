@@ -148,8 +148,13 @@ static inline uint64_t Align(uint64_t v, uint64_t alignment) {
 class PmxConstantVisitor final : public ConstantVisitor {
 public:
     PmxConstantVisitor(const ir::GraphTopo* topo, const uint8_t* shared_data, const RuntimeGraphInfo* info,
-                       const flatbuffers::Vector<flatbuffers::Offset<ppl::nn::pmx::Constant>>* fb_constants)
-        : topo_(topo), shared_data_(shared_data), info_(info), fb_constants_(fb_constants) {}
+                       const flatbuffers::Vector<flatbuffers::Offset<ppl::nn::pmx::Constant>>* fb_constants,
+                       bool is_data_persistent)
+        : topo_(topo)
+        , shared_data_(shared_data)
+        , info_(info)
+        , fb_constants_(fb_constants)
+        , is_data_persistent_(is_data_persistent) {}
 
     uint64_t CalcTotalBytes(uint64_t alignment) const override {
         uint64_t total_bytes = 0;
@@ -160,6 +165,10 @@ public:
         return total_bytes;
     }
 
+    bool IsDataPersistent() const override {
+        return is_data_persistent_;
+    }
+
     RetCode ForEach(
         const function<RetCode(const ir::Edge*, const void*, uint64_t, const TensorShape&)>& f) const override {
         for (auto y = fb_constants_->begin(); y != fb_constants_->end(); ++y) {
@@ -187,10 +196,12 @@ private:
     const uint8_t* shared_data_;
     const RuntimeGraphInfo* info_;
     const flatbuffers::Vector<flatbuffers::Offset<ppl::nn::pmx::Constant>>* fb_constants_;
+    const bool is_data_persistent_;
 };
 
 static RetCode ParseGraphDataPartitions(const GraphData* fb_data, const ir::GraphTopo* topo,
-                                        const vector<EngineImpl*>& seq2engine, RuntimeGraphInfo* info) {
+                                        const vector<EngineImpl*>& seq2engine, bool is_data_persistent,
+                                        RuntimeGraphInfo* info) {
     auto fb_partitions = fb_data->partitions();
     info->partitions.reserve(fb_partitions->size());
 
@@ -227,7 +238,8 @@ static RetCode ParseGraphDataPartitions(const GraphData* fb_data, const ir::Grap
             partition.ops.emplace_back(std::move(op));
         }
 
-        PmxConstantVisitor visitor(topo, fb_data->shared_data()->data(), info, fb_partition->constants());
+        PmxConstantVisitor visitor(topo, fb_data->shared_data()->data(), info, fb_partition->constants(),
+                                   is_data_persistent);
         auto status = engine->LoadConstants(visitor, &partition.constants);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "LoadConstants of engine[" << engine->GetName() << "] failed: " << GetRetCodeStr(status);
@@ -241,14 +253,14 @@ static RetCode ParseGraphDataPartitions(const GraphData* fb_data, const ir::Grap
 }
 
 static RetCode ParseGraphData(const GraphData* fb_data, const ir::GraphTopo* topo,
-                              const vector<EngineImpl*>& seq2engine, RuntimeGraphInfo* info) {
+                              const vector<EngineImpl*>& seq2engine, bool is_data_persistent, RuntimeGraphInfo* info) {
     auto status = ParseGraphDataShapes(fb_data, &info->shapes);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "ParseGraphDataShapes failed: " << GetRetCodeStr(status);
         return status;
     }
 
-    status = ParseGraphDataPartitions(fb_data, topo, seq2engine, info);
+    status = ParseGraphDataPartitions(fb_data, topo, seq2engine, is_data_persistent, info);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "ParseGraphDataPartitions failed: " << GetRetCodeStr(status);
         return status;
@@ -257,15 +269,15 @@ static RetCode ParseGraphData(const GraphData* fb_data, const ir::GraphTopo* top
     return RC_SUCCESS;
 }
 
-RetCode GraphParser::Parse(const Graph* fb_graph, const vector<EngineImpl*>& seq2engine, ir::GraphTopo* topo,
-                           RuntimeGraphInfo* info) {
+RetCode GraphParser::Parse(const Graph* fb_graph, const vector<EngineImpl*>& seq2engine, bool is_data_persistent,
+                           ir::GraphTopo* topo, RuntimeGraphInfo* info) {
     auto status = ParseGraphTopo(fb_graph->topo(), topo);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "ParseGraphTopo failed: " << GetRetCodeStr(status);
         return status;
     }
 
-    status = ParseGraphData(fb_graph->data(), topo, seq2engine, info);
+    status = ParseGraphData(fb_graph->data(), topo, seq2engine, is_data_persistent, info);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "ParseGraphData failed: " << GetRetCodeStr(status);
         return status;
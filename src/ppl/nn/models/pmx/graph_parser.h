@@ -27,7 +27,12 @@ namespace ppl { namespace nn { namespace pmx {
 
 class GraphParser final {
 public:
-    static ppl::common::RetCode Parse(const Graph*, const std::vector<EngineImpl*>&, ir::GraphTopo*, RuntimeGraphInfo*);
+    /**
+       @param is_data_persistent tells whether data that `Graph` refers to is kept valid until `RuntimeGraphInfo` is
+       released. refer to `ConstantVisitor::IsDataPersistent()` for details.
+    */
+    static ppl::common::RetCode Parse(const Graph*, const std::vector<EngineImpl*>&, bool is_data_persistent,
+                                      ir::GraphTopo*, RuntimeGraphInfo*);
 };
 
 }}} // namespace ppl::nn::pmx
@@ -31,6 +31,16 @@ using namespace flatbuffers;
 
 namespace ppl { namespace nn { namespace pmx {
 
+/*
+  alignment of each item in `shared_data` relative to the beginning of the model, which makes it possible for engines
+  to use constants in mmapped models without copying.
+*/
+static const uint64_t g_shared_data_alignment = 64;
+
+static inline uint64_t Align(uint64_t x, uint64_t n) {
+    return (x + n - 1) & (~(n - 1));
+}
+
 static RetCode CreateFbEngine(FlatBufferBuilder* builder, const SerializationContext& ctx, const EngineImpl* engine,
                               Offset<pmx::Engine>* fb_engine) {
     utils::BufferDataStream content;
@@ -214,8 +224,9 @@ static pair<uint64_t, uint64_t> FindOrInsertData(const vector<uint8_t>& data, ve
         }
     }
 
-    auto new_data_item = pair<uint64_t, uint64_t>(shared_data->size(), data.size());
-    shared_data->resize(shared_data->size() + data.size());
+    const uint64_t offset = Align(shared_data->size(), g_shared_data_alignment);
+    auto new_data_item = pair<uint64_t, uint64_t>(offset, data.size());
+    shared_data->resize(offset + data.size());
     memcpy(shared_data->data() + new_data_item.first, data.data(), data.size());
     shared_data_items->push_back(new_data_item);
     return new_data_item;
@@ -382,6 +393,7 @@ static RetCode CreateFbGraphData(FlatBufferBuilder* builder, const Serialization
         return status;
     }
 
+    builder->ForceVectorAlignment(shared_data.size(), sizeof(uint8_t), g_shared_data_alignment);
     auto fb_shared_data = builder->CreateVector<uint8_t>(shared_data);
     *fb_data = CreateGraphData(*builder, fb_shapes, fb_partitions, fb_shared_data);
     return RC_SUCCESS;
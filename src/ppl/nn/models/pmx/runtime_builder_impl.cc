@@ -22,13 +22,14 @@
 #include "ppl/nn/models/pmx/runtime_builder_impl.h"
 #include "ppl/nn/models/pmx/graph_parser.h"
 #include "ppl/nn/models/pmx/pmx_serializer.h"
+#include <stdarg.h>
 using namespace std;
 using namespace ppl::common;
 using namespace flatbuffers;
 
 namespace ppl { namespace nn { namespace pmx {
 
-RuntimeBuilderImpl::RuntimeBuilderImpl() {
+RuntimeBuilderImpl::RuntimeBuilderImpl() : use_mmap_(false) {
     topo_ = make_shared<ir::FullGraphTopo>();
     graph_info_ = make_shared<RuntimeGraphInfo>();
     aux_info_ = make_shared<RuntimeAuxInfo>();
@@ -70,8 +71,8 @@ static RetCode ParseEngines(const Vector<Offset<Engine>>* fb_engines, const vect
     return RC_SUCCESS;
 }
 
-RetCode RuntimeBuilderImpl::Init(const char* model_buf, uint64_t buf_len, ppl::nn::Engine** engines,
-                                 uint32_t engine_num) {
+RetCode RuntimeBuilderImpl::DoInit(const char* model_buf, uint64_t buf_len, ppl::nn::Engine** engines,
+                                   uint32_t engine_num, bool is_data_persistent) {
     RetCode status;
 
     resource_.engines.resize(engine_num);
@@ -94,7 +95,7 @@ RetCode RuntimeBuilderImpl::Init(const char* model_buf, uint64_t buf_len, ppl::n
         return status;
     }
 
-    status = GraphParser::Parse(fb_model->graph(), seq2engine, topo_.get(), graph_info_.get());
+    status = GraphParser::Parse(fb_model->graph(), seq2engine, is_data_persistent, topo_.get(), graph_info_.get());
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "parse graph failed: " << GetRetCodeStr(status);
         return status;
@@ -106,17 +107,39 @@ RetCode RuntimeBuilderImpl::Init(const char* model_buf, uint64_t buf_len, ppl::n
         return status;
     }
 
+    status = GenerateRuntimeMemoryPlan(topo_.get(), *graph_info_, *aux_info_, &aux_info_->memory_plan);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "GenerateRuntimeMemoryPlan failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
     return RC_SUCCESS;
 }
 
+RetCode RuntimeBuilderImpl::Init(const char* model_buf, uint64_t buf_len, ppl::nn::Engine** engines,
+                                 uint32_t engine_num) {
+    return DoInit(model_buf, buf_len, engines, engine_num, false);
+}
+
 RetCode RuntimeBuilderImpl::Init(const char* model_file, ppl::nn::Engine** engines, uint32_t engine_num) {
-    FileMapping fm;
-    auto status = fm.Init(model_file);
+    unique_ptr<FileMapping> fm(new FileMapping());
+    auto status = fm->Init(model_file);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "Init filemapping from file [" << model_file << "] faild: " << GetRetCodeStr(status);
         return status;
     }
-    return Init(fm.Data(), fm.Size(), engines, engine_num);
+
+    status = DoInit(fm->Data(), fm->Size(), engines, engine_num, use_mmap_);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    if (use_mmap_) {
+        // constants may refer to the mapped file
+        graph_info_->file_mappings.emplace_back(std::move(fm));
+    }
+
+    return RC_SUCCESS;
 }
 
 Runtime* RuntimeBuilderImpl::CreateRuntime() {
@@ -145,4 +168,29 @@ RetCode RuntimeBuilderImpl::Serialize(const char* output_file, const char* fmt)
     return serializer.Serialize(output_file, topo_.get(), resource_.engines, *graph_info_);
 }
 
+/* -------------------------------------------------------------------------- */
+
+RetCode RuntimeBuilderImpl::SetMmapFlag(RuntimeBuilderImpl* builder, va_list args) {
+    builder->use_mmap_ = (va_arg(args, uint32_t) > 0);
+    return RC_SUCCESS;
+}
+
+RuntimeBuilderImpl::ConfHandlerFunc RuntimeBuilderImpl::conf_handlers_[] = {
+    RuntimeBuilderImpl::SetMmapFlag, // PMX_RB_CONF_SET_MMAP_FLAG
+};
+
+RetCode RuntimeBuilderImpl::Configure(uint32_t option, ...) {
+    if (option >= PMX_RB_CONF_MAX) {
+        LOG(ERROR) << "invalid option[" << option << "] >= [" << PMX_RB_CONF_MAX << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    va_list args;
+    va_start(args, option);
+    auto status = conf_handlers_[option](this, args);
+    va_end(args);
+
+    return status;
+}
+
 }}} // namespace ppl::nn::pmx
@@ -37,8 +37,20 @@ public:
     ppl::common::RetCode Init(const char* model_buf, uint64_t buf_len, Engine** engines, uint32_t engine_num) override;
     Runtime* CreateRuntime() override;
     ppl::common::RetCode Serialize(const char* output_file, const char* fmt) const override;
+    ppl::common::RetCode Configure(uint32_t option, ...) override;
 
 private:
+    ppl::common::RetCode DoInit(const char* model_buf, uint64_t buf_len, Engine** engines, uint32_t engine_num,
+                                bool is_data_persistent);
+
+private:
+    static ppl::common::RetCode SetMmapFlag(RuntimeBuilderImpl*, va_list);
+
+    typedef ppl::common::RetCode (*ConfHandlerFunc)(RuntimeBuilderImpl*, va_list);
+    static ConfHandlerFunc conf_handlers_[PMX_RB_CONF_MAX];
+
+private:
+    bool use_mmap_;
     utils::SharedResource resource_;
     std::shared_ptr<ir::GraphTopo> topo_;
     std::shared_ptr<RuntimeGraphInfo> graph_info_;
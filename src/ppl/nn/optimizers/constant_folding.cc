@@ -0,0 +1,508 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/constant_folding.h"
+#include "ppl/nn/optimizers/utils.h"
+#include "ppl/nn/engines/utils.h"
+#include "ppl/nn/ir/full_graph_topo.h"
+#include "ppl/nn/runtime/runtime_impl.h"
+#include "ppl/nn/runtime/runtime_aux_info.h"
+#include "ppl/nn/common/logger.h"
+#include <set>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace utils {
+
+// types of devices whose engines can evaluate nodes when processing graphs
+static const set<string> g_host_device_types = {"arm", "cpu", "riscv", "x86"};
+
+/*
+  outputs of these ops may differ between runs with the same inputs, or are not tensors, or depend on subgraphs
+  which are processed separately.
+*/
+static const set<string> g_unfoldable_op_types = {
+    "Bernoulli",        "ConcatFromSequence", "If",          "Loop",           "Multinomial",
+    "RandomNormal",     "RandomNormalLike",   "RandomUniform", "RandomUniformLike", "Scan",
+    "SequenceAt",       "SequenceConstruct",  "SequenceEmpty", "SequenceErase",  "SequenceInsert",
+    "SequenceLength",   "SplitToSequence",
+};
+
+static bool IsSupportedByEngines(const ir::Node* node, const vector<EngineImpl*>& engines) {
+    for (auto it = engines.begin(); it != engines.end(); ++it) {
+        if ((*it)->Supports(node)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// returns nodes whose inputs are constants or outputs of other nodes returned, in topological order
+static vector<nodeid_t> FindFoldableNodes(const ir::Graph* graph, const vector<EngineImpl*>& engines) {
+    auto topo = graph->topo.get();
+    auto& constants = graph->data->constants;
+
+    set<edgeid_t> outputs;
+    for (uint32_t i = 0; i < topo->GetOutputCount(); ++i) {
+        outputs.insert(topo->GetOutput(i));
+    }
+
+    set<edgeid_t> foldable_edges;
+    for (uint32_t i = 0; i < topo->GetConstantCount(); ++i) {
+        auto eid = topo->GetConstant(i);
+        if (constants.find(eid) != constants.end()) {
+            foldable_edges.insert(eid);
+        }
+    }
+
+    vector<nodeid_t> foldable_nodes;
+    topo->TopologicalSort([topo, &engines, &outputs, &foldable_edges, &foldable_nodes](nodeid_t nid) -> void {
+        auto node = topo->GetNodeById(nid);
+        if (node->GetExtraInputCount() > 0 ||
+            g_unfoldable_op_types.find(node->GetType().name) != g_unfoldable_op_types.end()) {
+            return;
+        }
+
+        uint32_t valid_input_count = 0;
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto eid = node->GetInput(i);
+            if (eid == INVALID_EDGEID) {
+                continue;
+            }
+            if (foldable_edges.find(eid) == foldable_edges.end()) {
+                return;
+            }
+            ++valid_input_count;
+        }
+        if (valid_input_count == 0) {
+            return;
+        }
+
+        // outputs of the graph are kept as they are
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            if (outputs.find(node->GetOutput(i)) != outputs.end()) {
+                return;
+            }
+        }
+
+        if (!IsSupportedByEngines(node, engines)) {
+            return;
+        }
+
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            foldable_edges.insert(node->GetOutput(i));
+        }
+        foldable_nodes.push_back(nid);
+    });
+
+    return foldable_nodes;
+}
+
+static ir::Edge* FindOrAddEdge(const ir::Edge* edge, ir::GraphTopo* topo, map<edgeid_t, edgeid_t>* eid_map) {
+    auto ref = eid_map->find(edge->GetId());
+    if (ref != eid_map->end()) {
+        return topo->GetEdgeById(ref->second);
+    }
+
+    auto ret_pair = topo->AddEdge(edge->GetName());
+    if (!ret_pair.second) {
+        return nullptr;
+    }
+    eid_map->insert(make_pair(edge->GetId(), ret_pair.first->GetId()));
+    return ret_pair.first;
+}
+
+/*
+  copies `nodes` into a standalone graph `sub_graph`. constants used by `nodes` become inputs of `sub_graph` so that
+  it will not be folded again, and all outputs of `nodes` become outputs so that their sizes can be checked.
+*/
+static RetCode BuildFoldingGraph(const ir::Graph* graph, const vector<nodeid_t>& nodes, ir::Graph* sub_graph,
+                                 map<edgeid_t, edgeid_t>* eid_map) {
+    auto topo = graph->topo.get();
+    auto graph_data = graph->data.get();
+
+    auto sub_topo = make_shared<ir::FullGraphTopo>();
+    sub_topo->SetName(topo->GetName() + ".constant_folding");
+    sub_graph->topo = sub_topo;
+    sub_graph->data = make_shared<ir::GraphData>();
+    auto sub_data = sub_graph->data.get();
+
+    set<nodeid_t> node_set(nodes.begin(), nodes.end());
+    for (auto x = nodes.begin(); x != nodes.end(); ++x) {
+        auto node = topo->GetNodeById(*x);
+        auto ret_pair = sub_topo->AddNode(node->GetName());
+        if (!ret_pair.second) {
+            LOG(ERROR) << "duplicated node[" << node->GetName() << "]";
+            return RC_EXISTS;
+        }
+        auto sub_node = ret_pair.first;
+        sub_node->SetType(node->GetType());
+
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto eid = node->GetInput(i);
+            if (eid == INVALID_EDGEID) {
+                sub_node->AddInput(INVALID_EDGEID);
+                continue;
+            }
+
+            auto edge = topo->GetEdgeById(eid);
+            auto sub_edge = FindOrAddEdge(edge, sub_topo.get(), eid_map);
+            if (!sub_edge) {
+                LOG(ERROR) << "duplicated edge[" << edge->GetName() << "]";
+                return RC_EXISTS;
+            }
+            sub_node->AddInput(sub_edge->GetId());
+            sub_edge->AddConsumer(sub_node->GetId());
+
+            if (node_set.find(edge->GetProducer()) == node_set.end()) {
+                sub_topo->MarkAsInput(sub_edge->GetId());
+            }
+        }
+
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            auto edge = topo->GetEdgeById(node->GetOutput(i));
+            auto sub_edge = FindOrAddEdge(edge, sub_topo.get(), eid_map);
+            if (!sub_edge) {
+                LOG(ERROR) << "duplicated edge[" << edge->GetName() << "]";
+                return RC_EXISTS;
+            }
+            sub_node->AddOutput(sub_edge->GetId());
+            sub_edge->SetProducer(sub_node->GetId());
+            sub_topo->MarkAsOutput(sub_edge->GetId());
+        }
+
+        auto attr_ref = graph_data->attrs.find(node->GetId());
+        if (attr_ref != graph_data->attrs.end()) {
+            sub_data->attrs.insert(make_pair(sub_node->GetId(), attr_ref->second));
+        }
+    }
+
+    for (auto x = eid_map->begin(); x != eid_map->end(); ++x) {
+        auto shape_ref = graph_data->shapes.find(x->first);
+        if (shape_ref != graph_data->shapes.end()) {
+            sub_data->shapes.insert(make_pair(x->second, shape_ref->second));
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+/*
+  a folded output may be larger than inputs of its producer by at most this many bytes, so that nodes like Expand or
+  ConstantOfShape do not turn small constants into large ones which are loaded and stored with the model.
+*/
+static const uint64_t g_max_folded_growth_bytes = 1024 * 1024;
+
+// removes nodes producing outputs that are too large, and nodes depending on them, from `nodes`
+static void ExcludeLargeOutputs(const ir::Graph* graph, const map<edgeid_t, uint64_t>& output_bytes,
+                                vector<nodeid_t>* nodes) {
+    auto topo = graph->topo.get();
+    auto& constants = graph->data->constants;
+
+    set<edgeid_t> excluded_edges;
+    vector<nodeid_t> kept_nodes;
+    for (auto x = nodes->begin(); x != nodes->end(); ++x) {
+        auto node = topo->GetNodeById(*x);
+
+        bool excluded = false;
+        uint64_t input_bytes = 0;
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto eid = node->GetInput(i);
+            if (eid == INVALID_EDGEID) {
+                continue;
+            }
+            if (excluded_edges.find(eid) != excluded_edges.end()) {
+                excluded = true;
+                break;
+            }
+            auto bytes_ref = output_bytes.find(eid);
+            if (bytes_ref != output_bytes.end()) {
+                input_bytes += bytes_ref->second;
+                continue;
+            }
+            auto constant_ref = constants.find(eid);
+            if (constant_ref != constants.end()) {
+                input_bytes += constant_ref->second.data.size();
+            }
+        }
+
+        for (uint32_t i = 0; i < node->GetOutputCount() && !excluded; ++i) {
+            auto bytes_ref = output_bytes.find(node->GetOutput(i));
+            if (bytes_ref != output_bytes.end() && bytes_ref->second > input_bytes + g_max_folded_growth_bytes) {
+                LOG(DEBUG) << "output[" << topo->GetEdgeById(node->GetOutput(i))->GetName() << "] of node["
+                           << node->GetName() << "] is too large to be folded: [" << bytes_ref->second
+                           << "] bytes, inputs [" << input_bytes << "] bytes.";
+                excluded = true;
+            }
+        }
+
+        if (excluded) {
+            for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+                excluded_edges.insert(node->GetOutput(i));
+            }
+        } else {
+            kept_nodes.push_back(*x);
+        }
+    }
+
+    nodes->swap(kept_nodes);
+}
+
+/*
+  runs `sub_graph` with values of constants in `graph`, removes nodes with large outputs from `nodes` and saves values
+  of outputs of `nodes` which are used by other nodes in `values`.
+*/
+static RetCode EvaluateFoldingGraph(const vector<EngineImpl*>& engines, const shared_ptr<GraphPartitioner>& partitioner,
+                                    const ir::Graph* graph, const map<edgeid_t, edgeid_t>& eid_map,
+                                    ir::Graph* sub_graph, vector<nodeid_t>* nodes,
+                                    map<edgeid_t, pair<ir::Shape, ir::Constant>>* values) {
+    // engines MUST be released after the runtime
+    vector<unique_ptr<EngineImpl>> engine_instances;
+    SharedResource sub_resource;
+    for (auto x = engines.begin(); x != engines.end(); ++x) {
+        auto e = (*x)->Create();
+        if (!e) {
+            LOG(ERROR) << "create instance of engine[" << (*x)->GetName() << "] failed.";
+            return RC_OTHER_ERROR;
+        }
+        engine_instances.emplace_back(unique_ptr<EngineImpl>(e));
+        sub_resource.engines.push_back(e);
+    }
+    sub_resource.graph_partitioner = partitioner;
+
+    auto graph_info = make_shared<RuntimeGraphInfo>();
+    auto status = ProcessGraph(&sub_resource, sub_graph, graph_info.get());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "ProcessGraph failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    auto aux_info = make_shared<RuntimeAuxInfo>();
+    status = GenerateRuntimeAuxInfo(sub_graph->topo.get(), aux_info.get());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "GenerateRuntimeAuxInfo failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    RuntimeImpl runtime;
+    status = runtime.Init(sub_graph->topo, graph_info, aux_info);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "init runtime failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    map<edgeid_t, edgeid_t> sub2eid;
+    for (auto x = eid_map.begin(); x != eid_map.end(); ++x) {
+        sub2eid.insert(make_pair(x->second, x->first));
+    }
+
+    auto sub_topo = sub_graph->topo.get();
+    auto& constants = graph->data->constants;
+    auto& shapes = graph->data->shapes;
+    for (uint32_t i = 0; i < runtime.GetInputCount(); ++i) {
+        auto eid = sub2eid[sub_topo->GetInput(i)];
+        auto tensor = runtime.GetInputTensorImpl(i);
+
+        auto shape_ref = shapes.find(eid);
+        auto constant_ref = constants.find(eid);
+        if (shape_ref == shapes.end() || constant_ref == constants.end()) {
+            LOG(ERROR) << "cannot find shape or data of constant[" << tensor->GetName() << "]";
+            return RC_NOT_FOUND;
+        }
+
+        TensorShape src_desc;
+        utils::IrShape2TensorShape(shape_ref->second, &src_desc);
+        src_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+        *tensor->GetShape() = src_desc;
+
+        status = tensor->ReallocBuffer();
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "ReallocBuffer for tensor[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+        if (src_desc.GetBytesExcludingPadding() > 0) {
+            status = tensor->ConvertFromHost(constant_ref->second.data.data(), src_desc);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "set data of tensor[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+        }
+    }
+
+    status = runtime.Run();
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "run graph[" << sub_topo->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    map<edgeid_t, uint64_t> output_bytes;
+    for (uint32_t i = 0; i < runtime.GetOutputCount(); ++i) {
+        auto eid = sub2eid[sub_topo->GetOutput(i)];
+        output_bytes.insert(make_pair(eid, runtime.GetOutputTensorImpl(i)->GetShape()->GetBytesExcludingPadding()));
+    }
+    ExcludeLargeOutputs(graph, output_bytes, nodes);
+
+    auto topo = graph->topo.get();
+    set<nodeid_t> node_set(nodes->begin(), nodes->end());
+    set<edgeid_t> used_edges;
+    for (auto x = nodes->begin(); x != nodes->end(); ++x) {
+        auto node = topo->GetNodeById(*x);
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            auto edge = topo->GetEdgeById(node->GetOutput(i));
+            for (auto it = edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+                if (node_set.find(it.Get()) == node_set.end()) {
+                    used_edges.insert(edge->GetId());
+                    break;
+                }
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < runtime.GetOutputCount(); ++i) {
+        auto eid = sub2eid[sub_topo->GetOutput(i)];
+        if (used_edges.find(eid) == used_edges.end()) {
+            continue;
+        }
+        auto tensor = runtime.GetOutputTensorImpl(i);
+
+        TensorShape dst_desc = *tensor->GetShape();
+        dst_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+
+        auto& value = (*values)[eid];
+        value.first.data_type = dst_desc.GetDataType();
+        value.first.data_format = DATAFORMAT_NDARRAY;
+        value.first.dims.assign(dst_desc.GetDims(), dst_desc.GetDims() + dst_desc.GetRealDimCount());
+        if (dst_desc.IsScalar()) {
+            value.first.dims.clear();
+        }
+
+        value.second.data.resize(dst_desc.GetBytesExcludingPadding());
+        if (!value.second.data.empty()) {
+            status = tensor->ConvertToHost(&value.second.data[0], dst_desc);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "get data of tensor[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+// replaces `nodes` with constants in `values` and removes constants that are not used anymore
+static void ReplaceWithConstants(const vector<nodeid_t>& nodes, map<edgeid_t, pair<ir::Shape, ir::Constant>>* values,
+                                 ir::Graph* graph) {
+    auto topo = graph->topo.get();
+    auto graph_data = graph->data.get();
+
+    set<edgeid_t> input_edges, output_edges;
+    for (auto x = nodes.begin(); x != nodes.end(); ++x) {
+        auto node = topo->GetNodeById(*x);
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto eid = node->GetInput(i);
+            if (eid != INVALID_EDGEID) {
+                topo->GetEdgeById(eid)->DelConsumer(node->GetId());
+                input_edges.insert(eid);
+            }
+        }
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            auto eid = node->GetOutput(i);
+            topo->GetEdgeById(eid)->SetProducer(INVALID_NODEID);
+            output_edges.insert(eid);
+        }
+        topo->DelNodeById(node->GetId());
+    }
+
+    for (auto x = output_edges.begin(); x != output_edges.end(); ++x) {
+        auto ref = values->find(*x);
+        if (ref == values->end()) {
+            // used by folded nodes only
+            graph_data->shapes.erase(*x);
+            topo->DelEdgeById(*x);
+            continue;
+        }
+
+        graph_data->shapes[*x] = std::move(ref->second.first);
+        graph_data->constants[*x] = std::move(ref->second.second);
+        topo->MarkAsConstant(*x);
+    }
+
+    for (uint32_t i = 0; i < topo->GetOutputCount(); ++i) {
+        input_edges.erase(topo->GetOutput(i));
+    }
+    for (auto x = input_edges.begin(); x != input_edges.end(); ++x) {
+        auto edge = topo->GetEdgeById(*x);
+        if (edge && edge->CalcConsumerCount() == 0 && output_edges.find(*x) == output_edges.end()) {
+            graph_data->constants.erase(*x);
+            graph_data->shapes.erase(*x);
+            topo->DelEdgeById(*x);
+        }
+    }
+}
+
+RetCode FoldConstants(const SharedResource* resource, ir::Graph* graph) {
+    auto topo = graph->topo.get();
+    if (topo->GetConstantCount() == 0) {
+        return RC_SUCCESS;
+    }
+
+    vector<EngineImpl*> host_engines;
+    for (auto x = resource->engines.begin(); x != resource->engines.end(); ++x) {
+        unique_ptr<EngineContext> ctx((*x)->CreateEngineContext());
+        if (ctx && g_host_device_types.find(ctx->GetDevice()->GetType()) != g_host_device_types.end()) {
+            host_engines.push_back(*x);
+        }
+    }
+    if (host_engines.empty()) {
+        return RC_SUCCESS;
+    }
+
+    auto nodes = FindFoldableNodes(graph, host_engines);
+    if (nodes.empty()) {
+        return RC_SUCCESS;
+    }
+
+    ir::Graph sub_graph;
+    map<edgeid_t, edgeid_t> eid_map;
+    auto status = BuildFoldingGraph(graph, nodes, &sub_graph, &eid_map);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "BuildFoldingGraph failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    // nodes are executed in runtime as usual if they cannot be evaluated here
+    map<edgeid_t, pair<ir::Shape, ir::Constant>> values;
+    status = EvaluateFoldingGraph(host_engines, resource->graph_partitioner, graph, eid_map, &sub_graph, &nodes,
+                                  &values);
+    if (status != RC_SUCCESS) {
+        LOG(WARNING) << "evaluating constant nodes of graph[" << topo->GetName()
+                     << "] failed. they will not be folded.";
+        return RC_SUCCESS;
+    }
+    if (nodes.empty()) {
+        return RC_SUCCESS;
+    }
+
+    const uint32_t constant_count = topo->GetConstantCount();
+    ReplaceWithConstants(nodes, &values, graph);
+    LOG(INFO) << "fold [" << nodes.size() << "] nodes of graph[" << topo->GetName() << "], number of constants: ["
+              << constant_count << "] -> [" << topo->GetConstantCount() << "]";
+
+    return RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::utils
@@ -0,0 +1,35 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_OPTIMIZERS_CONSTANT_FOLDING_H_
+#define _ST_HPC_PPL_NN_OPTIMIZERS_CONSTANT_FOLDING_H_
+
+#include "ppl/nn/utils/shared_resource.h"
+#include "ppl/nn/ir/graph.h"
+
+namespace ppl { namespace nn { namespace utils {
+
+/**
+   @brief evaluates nodes whose inputs are all constants once with cpu engines in `resource` and replaces them with
+   constants, so that they are not executed in every run.
+   @note nodes that cannot be evaluated, or whose outputs are much larger than their inputs, are left unchanged.
+*/
+ppl::common::RetCode FoldConstants(const SharedResource* resource, ir::Graph* graph);
+
+}}} // namespace ppl::nn::utils
+
+#endif
@@ -18,6 +18,7 @@
 #include "ppl/nn/optimizers/utils.h"
 #include "ppl/nn/optimizers/engine_graph_partitioner.h"
 #include "ppl/nn/optimizers/graph_optimizer_manager.h"
+#include "ppl/nn/optimizers/constant_folding.h"
 #include "ppl/nn/engines/common/ppl/converter_op.h"
 #include "ppl/nn/engines/utils.h"
 #include "ppl/nn/ir/partial_graph_topo.h"
@@ -291,6 +292,8 @@ static RetCode GenPartitionsInfoAndShapes(const vector<pair<EngineImpl*, vector<
             }
         }
 
+        par_info.shapes = std::move(subgraph_info.shapes);
+
         par_list->emplace_back(std::move(par_info));
     }
 
@@ -449,6 +452,12 @@ RetCode ProcessGraph(const utils::SharedResource* resource, ir::Graph* graph, Ru
         return status;
     }
 
+    status = FoldConstants(resource, graph);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "FoldConstants failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
     vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
     status = resource->graph_partitioner->Partition(resource->engines, graph->topo.get(), &partitions);
     if (status != RC_SUCCESS) {
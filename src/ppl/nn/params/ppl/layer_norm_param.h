@@ -0,0 +1,36 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_PARAMS_PPL_LAYER_NORM_PARAM_H_
+#define _ST_HPC_PPL_NN_PARAMS_PPL_LAYER_NORM_PARAM_H_
+
+#include <stdint.h>
+
+namespace ppl { namespace nn { namespace common {
+
+struct LayerNormParam {
+    int32_t axis; // normalize over dims [axis, dim_count)
+    float epsilon;
+
+    bool operator==(const LayerNormParam& p) const {
+        return this->axis == p.axis && this->epsilon == p.epsilon;
+    }
+};
+
+}}} // namespace ppl::nn::common
+
+#endif
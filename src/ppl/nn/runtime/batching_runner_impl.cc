@@ -0,0 +1,292 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/batching_runner_impl.h"
+#include "ppl/nn/common/logger.h"
+#include <string.h>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+BatchingRunnerImpl::BatchingRunnerImpl(Runtime* runtime, const BatchingOptions& options)
+    : runtime_(runtime), options_(options) {}
+
+BatchingRunnerImpl::~BatchingRunnerImpl() {
+    if (worker_.joinable()) {
+        {
+            lock_guard<mutex> lck(mutex_);
+            exit_ = true;
+        }
+        queue_cond_.notify_one();
+        worker_.join();
+    }
+}
+
+RetCode BatchingRunnerImpl::Init() {
+    if (options_.max_batch_size == 0) {
+        LOG(ERROR) << "max_batch_size of BatchingRunner cannot be 0.";
+        return RC_INVALID_VALUE;
+    }
+
+    input_buffers_.resize(runtime_->GetInputCount());
+    worker_ = thread(&BatchingRunnerImpl::Loop, this);
+    return RC_SUCCESS;
+}
+
+RetCode BatchingRunnerImpl::Run(const vector<const void*>& inputs, const vector<TensorShape>& input_shapes,
+                                vector<vector<char>>* outputs, vector<TensorShape>* output_shapes) {
+    if (inputs.size() != runtime_->GetInputCount() || input_shapes.size() != inputs.size()) {
+        LOG(ERROR) << "number of inputs [" << inputs.size() << "] or input shapes [" << input_shapes.size()
+                   << "] != runtime input count [" << runtime_->GetInputCount() << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    int64_t batch = -1;
+    for (uint32_t i = 0; i < input_shapes.size(); ++i) {
+        auto& shape = input_shapes[i];
+        if (shape.IsScalar() || shape.GetRealDimCount() == 0 || shape.GetDim(0) <= 0) {
+            LOG(ERROR) << "input[" << i << "] of request has no batch dimension.";
+            return RC_INVALID_VALUE;
+        }
+        if (batch == -1) {
+            batch = shape.GetDim(0);
+        } else if (batch != shape.GetDim(0)) {
+            LOG(ERROR) << "dim 0 of input[" << i << "] [" << shape.GetDim(0) << "] != dim 0 of input[0] [" << batch
+                       << "]";
+            return RC_INVALID_VALUE;
+        }
+    }
+
+    Request req;
+    req.inputs = &inputs;
+    req.input_shapes = &input_shapes;
+    req.outputs = outputs;
+    req.output_shapes = output_shapes;
+    req.batch = batch;
+    req.enqueue_ts = chrono::steady_clock::now();
+
+    unique_lock<mutex> lck(mutex_);
+    queue_.push_back(&req);
+    queue_cond_.notify_one();
+    finish_cond_.wait(lck, [&req]() -> bool {
+        return req.finished;
+    });
+
+    return req.status;
+}
+
+void BatchingRunnerImpl::GetStatistics(BatchingStatistics* stat) const {
+    lock_guard<mutex> lck(mutex_);
+    *stat = stat_;
+}
+
+bool BatchingRunnerImpl::IsCompatible(const Request* a, const Request* b) {
+    for (uint32_t i = 0; i < a->input_shapes->size(); ++i) {
+        auto& sa = a->input_shapes->at(i);
+        auto& sb = b->input_shapes->at(i);
+        if (sa.GetDataType() != sb.GetDataType() || sa.GetRealDimCount() != sb.GetRealDimCount()) {
+            return false;
+        }
+        for (uint32_t j = 1; j < sa.GetRealDimCount(); ++j) {
+            if (sa.GetDim(j) != sb.GetDim(j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void BatchingRunnerImpl::CollectBatch(unique_lock<mutex>* lck, vector<Request*>* batch) {
+    queue_cond_.wait(*lck, [this]() -> bool {
+        return (exit_ || !queue_.empty());
+    });
+    if (queue_.empty()) {
+        return;
+    }
+
+    auto first = queue_.front();
+    auto deadline = first->enqueue_ts + chrono::microseconds(options_.max_wait_us);
+    while (!exit_ && chrono::steady_clock::now() < deadline) {
+        uint64_t pending = 0;
+        for (auto req : queue_) {
+            if (IsCompatible(first, req)) {
+                pending += req->batch;
+            }
+        }
+        if (pending >= options_.max_batch_size) {
+            break;
+        }
+        queue_cond_.wait_until(*lck, deadline);
+    }
+
+    // the oldest request is always taken even if it is larger than `max_batch_size`
+    uint64_t total = first->batch;
+    batch->push_back(first);
+    queue_.pop_front();
+
+    for (auto it = queue_.begin(); it != queue_.end() && total < options_.max_batch_size;) {
+        auto req = *it;
+        if (IsCompatible(first, req) && total + req->batch <= options_.max_batch_size) {
+            total += req->batch;
+            batch->push_back(req);
+            it = queue_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+RetCode BatchingRunnerImpl::RunBatch(const vector<Request*>& batch) {
+    int64_t total = 0;
+    for (auto req : batch) {
+        total += req->batch;
+    }
+
+    for (uint32_t i = 0; i < runtime_->GetInputCount(); ++i) {
+        TensorShape src_desc = batch[0]->input_shapes->at(i);
+        src_desc.SetDim(0, total);
+
+        const void* src;
+        if (batch.size() == 1) {
+            src = batch[0]->inputs->at(i);
+        } else {
+            auto& buffer = input_buffers_[i];
+            buffer.resize(src_desc.GetBytesExcludingPadding());
+            uint64_t offset = 0;
+            for (auto req : batch) {
+                auto bytes = req->input_shapes->at(i).GetBytesExcludingPadding();
+                memcpy(buffer.data() + offset, req->inputs->at(i), bytes);
+                offset += bytes;
+            }
+            src = buffer.data();
+        }
+
+        auto t = runtime_->GetInputTensor(i);
+        t->GetShape()->Reshape(src_desc.GetDims(), src_desc.GetRealDimCount());
+        auto status = t->ReallocBuffer();
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "realloc buffer for input[" << t->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+        status = t->ConvertFromHost(src, src_desc);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "set input[" << t->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    auto status = runtime_->Run();
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "Run() failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    for (auto req : batch) {
+        req->outputs->resize(runtime_->GetOutputCount());
+        if (req->output_shapes) {
+            req->output_shapes->resize(runtime_->GetOutputCount());
+        }
+    }
+
+    for (uint32_t i = 0; i < runtime_->GetOutputCount(); ++i) {
+        auto t = runtime_->GetOutputTensor(i);
+        TensorShape dst_desc = *t->GetShape();
+        dst_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+
+        if (batch.size() == 1) {
+            auto req = batch[0];
+            auto& output = req->outputs->at(i);
+            output.resize(dst_desc.GetBytesExcludingPadding());
+            status = t->ConvertToHost(output.data(), dst_desc);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "get output[" << t->GetName() << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+            if (req->output_shapes) {
+                req->output_shapes->at(i) = dst_desc;
+            }
+            continue;
+        }
+
+        if (dst_desc.IsScalar() || dst_desc.GetRealDimCount() == 0 || dst_desc.GetDim(0) != total) {
+            LOG(ERROR) << "dim 0 of output[" << t->GetName() << "] is not the batch size [" << total << "]";
+            return RC_UNSUPPORTED;
+        }
+
+        output_buffer_.resize(dst_desc.GetBytesExcludingPadding());
+        status = t->ConvertToHost(output_buffer_.data(), dst_desc);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "get output[" << t->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+
+        auto bytes_per_sample = dst_desc.GetBytesFromDimesionExcludingPadding(1);
+        uint64_t offset = 0;
+        for (auto req : batch) {
+            auto bytes = bytes_per_sample * req->batch;
+            auto& output = req->outputs->at(i);
+            output.assign(output_buffer_.data() + offset, output_buffer_.data() + offset + bytes);
+            offset += bytes;
+
+            if (req->output_shapes) {
+                auto& shape = req->output_shapes->at(i);
+                shape = dst_desc;
+                shape.SetDim(0, req->batch);
+            }
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+void BatchingRunnerImpl::Loop() {
+    vector<Request*> batch;
+    while (true) {
+        batch.clear();
+        {
+            unique_lock<mutex> lck(mutex_);
+            CollectBatch(&lck, &batch);
+        }
+        if (batch.empty()) {
+            break;
+        }
+
+        auto status = RunBatch(batch);
+
+        {
+            lock_guard<mutex> lck(mutex_);
+            for (auto req : batch) {
+                req->status = status;
+                req->finished = true;
+            }
+            if (status == RC_SUCCESS) {
+                for (auto req : batch) {
+                    stat_.sample_count += req->batch;
+                }
+                stat_.request_count += batch.size();
+                ++stat_.batch_count;
+            } else {
+                stat_.failed_request_count += batch.size();
+                ++stat_.failed_batch_count;
+            }
+        }
+        finish_cond_.notify_all();
+    }
+}
+
+}} // namespace ppl::nn
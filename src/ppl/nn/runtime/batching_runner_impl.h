@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_BATCHING_RUNNER_IMPL_H_
+#define _ST_HPC_PPL_NN_RUNTIME_BATCHING_RUNNER_IMPL_H_
+
+#include "ppl/nn/runtime/batching_runner.h"
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+namespace ppl { namespace nn {
+
+class BatchingRunnerImpl final : public BatchingRunner {
+public:
+    BatchingRunnerImpl(Runtime* runtime, const BatchingOptions& options);
+    ~BatchingRunnerImpl();
+
+    /** @brief starts the worker thread */
+    ppl::common::RetCode Init();
+
+    ppl::common::RetCode Run(const std::vector<const void*>& inputs, const std::vector<TensorShape>& input_shapes,
+                             std::vector<std::vector<char>>* outputs,
+                             std::vector<TensorShape>* output_shapes) override;
+    void GetStatistics(BatchingStatistics*) const override;
+
+private:
+    struct Request final {
+        const std::vector<const void*>* inputs;
+        const std::vector<TensorShape>* input_shapes;
+        std::vector<std::vector<char>>* outputs;
+        std::vector<TensorShape>* output_shapes;
+        int64_t batch;
+        std::chrono::steady_clock::time_point enqueue_ts;
+        bool finished = false;
+        ppl::common::RetCode status = ppl::common::RC_SUCCESS;
+    };
+
+    static bool IsCompatible(const Request* a, const Request* b);
+
+    /**
+       @brief waits until the oldest request in `queue_` times out or enough compatible requests arrive,
+       and moves them into `batch`. `batch` is empty only if this runner is being destroyed.
+    */
+    void CollectBatch(std::unique_lock<std::mutex>* lck, std::vector<Request*>* batch);
+
+    ppl::common::RetCode RunBatch(const std::vector<Request*>& batch);
+    void Loop();
+
+private:
+    Runtime* runtime_;
+    const BatchingOptions options_;
+
+    bool exit_ = false;
+    std::deque<Request*> queue_;
+    BatchingStatistics stat_;
+    mutable std::mutex mutex_;
+    std::condition_variable queue_cond_;
+    std::condition_variable finish_cond_;
+    std::thread worker_;
+
+    /** used by the worker thread only */
+    std::vector<std::vector<char>> input_buffers_;
+    std::vector<char> output_buffer_;
+
+private:
+    BatchingRunnerImpl(const BatchingRunnerImpl&) = delete;
+    BatchingRunnerImpl& operator=(const BatchingRunnerImpl&) = delete;
+};
+
+}} // namespace ppl::nn
+
+#endif
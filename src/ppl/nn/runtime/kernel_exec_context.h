@@ -35,8 +35,20 @@ public:
         return is_profiling_enabled_;
     }
 
+    /**
+       @brief tells kernels that shapes of inputs are the same as those in the last run and outputs will be
+       created with shapes inferred in the last run, so that `Reshape()` can be skipped.
+    */
+    void SetSkipReshapeFlag(bool skip_reshape) {
+        skip_reshape_ = skip_reshape;
+    }
+    bool CanSkipReshape() const {
+        return skip_reshape_;
+    }
+
 private:
     bool is_profiling_enabled_ = false;
+    bool skip_reshape_ = false;
 };
 
 }} // namespace ppl::nn
@@ -63,12 +63,36 @@ public:
     */
     virtual ppl::common::RetCode Execute(KernelExecContext* ctx) = 0;
 
+    /** @brief get max bytes of temporary buffers used by one execution, 0 if not available */
+    virtual uint64_t GetMaxTmpBufferBytes() const {
+        return 0;
+    }
+
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
 public:
     /** @brief get execution time in microseconds */
     virtual uint64_t GetExecutionTime() const {
         return 0;
     }
+
+    /** @brief get description of the algorithm selected for this kernel, empty if not available */
+    virtual std::string GetAlgorithmInfo() const {
+        return std::string();
+    }
+
+    /** @brief estimate floating point operations of the execution with `ctx`, 0 if not available */
+    virtual uint64_t CalcFlops(const KernelExecContext& ctx) const {
+        return 0;
+    }
+
+    /**
+       @brief get the number of iterations and the time in microseconds spent outside of subgraphs in the last
+       execution, for kernels running subgraphs iteratively, e.g. Loop.
+    */
+    virtual void GetIterationInfo(uint64_t* iteration_count, uint64_t* overhead_microseconds) const {
+        *iteration_count = 0;
+        *overhead_microseconds = 0;
+    }
 #endif
 
 private:
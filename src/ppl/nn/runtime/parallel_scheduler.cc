@@ -0,0 +1,341 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/common/logger.h"
+#include "ppl/nn/runtime/parallel_scheduler.h"
+#include "ppl/nn/runtime/scheduler_common.h"
+#include <set>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+class ParallelAcquireObject final : public InputOutputInfo::AcquireObject {
+public:
+    ParallelAcquireObject(const ir::GraphTopo* topo, vector<EdgeObject*>* edgeid2object, ParallelScheduler* sched)
+        : device_(nullptr), topo_(topo), edgeid2object_(edgeid2object), sched_(sched) {}
+
+    void SetDevice(Device* d) {
+        device_ = d;
+    }
+
+    EdgeObject* Acquire(edgeid_t eid, uint32_t etype) override {
+        if (eid >= edgeid2object_->size()) {
+            return nullptr;
+        }
+
+        // an edge is produced by only one node, so different threads never allocate the same object.
+        auto object = edgeid2object_->at(eid);
+        if (!object) {
+            if (etype == EdgeObject::T_EDGE_OBJECT) {
+                return nullptr;
+            }
+
+            auto edge = topo_->GetEdgeById(eid);
+            object = sched_->AllocObject(edge, etype, device_);
+            if (!object) {
+                LOG(ERROR) << "create output object[" << edge->GetName() << "] failed";
+                return nullptr;
+            }
+            edgeid2object_->at(eid) = object;
+        }
+        return object;
+    }
+
+private:
+    Device* device_;
+    const ir::GraphTopo* topo_;
+    vector<EdgeObject*>* edgeid2object_;
+    ParallelScheduler* sched_;
+};
+
+ParallelScheduler::ParallelScheduler(uint32_t thread_num)
+    : topo_(nullptr), aux_info_(nullptr), graph_(nullptr), thread_num_(thread_num) {
+    if (thread_num_ == 0) {
+        thread_num_ = std::thread::hardware_concurrency();
+        if (thread_num_ == 0) {
+            thread_num_ = 1;
+        }
+    }
+}
+
+ParallelScheduler::~ParallelScheduler() {
+    {
+        lock_guard<mutex> lck(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+
+    for (auto t = workers_.begin(); t != workers_.end(); ++t) {
+        t->join();
+    }
+}
+
+RetCode ParallelScheduler::Init(const ir::GraphTopo* topo, const RuntimeAuxInfo* aux_info, RuntimeGraphResource* g) {
+    graph_ = g;
+    topo_ = topo;
+    aux_info_ = aux_info;
+
+    const nodeid_t max_node_id = topo->GetMaxNodeId();
+    const edgeid_t max_edge_id = topo->GetMaxEdgeId();
+
+    nodeid2successors_.clear();
+    nodeid2successors_.resize(max_node_id);
+    nodeid2predecessor_count_.assign(max_node_id, 0);
+    edgeid2refcount_.assign(max_edge_id, 0);
+
+    auto is_releasable = [aux_info, max_node_id, max_edge_id](edgeid_t eid) -> bool {
+        return (eid < max_edge_id && aux_info->tensor_last_consumer[eid] < max_node_id);
+    };
+
+    for (auto x = aux_info->sorted_nodes.begin(); x != aux_info->sorted_nodes.end(); ++x) {
+        auto node = topo->GetNodeById(*x);
+
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto eid = node->GetInput(i);
+            if (is_releasable(eid)) {
+                ++edgeid2refcount_[eid];
+            }
+        }
+        for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+            auto eid = node->GetExtraInput(i);
+            if (is_releasable(eid)) {
+                ++edgeid2refcount_[eid];
+            }
+        }
+
+        set<nodeid_t> successors;
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            auto eid = node->GetOutput(i);
+            if (is_releasable(eid)) {
+                ++edgeid2refcount_[eid];
+            }
+
+            auto edge = topo->GetEdgeById(eid);
+            for (auto it = edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+                successors.insert(it.Get());
+            }
+        }
+
+        auto& successor_list = nodeid2successors_[*x];
+        successor_list.assign(successors.begin(), successors.end());
+        for (auto s = successor_list.begin(); s != successor_list.end(); ++s) {
+            ++nodeid2predecessor_count_[*s];
+        }
+    }
+
+    initial_nodes_.clear();
+    for (auto x = aux_info->sorted_nodes.begin(); x != aux_info->sorted_nodes.end(); ++x) {
+        if (nodeid2predecessor_count_[*x] == 0) {
+            initial_nodes_.push_back(*x);
+        }
+    }
+
+    pending_edge_users_.reset(new atomic<uint32_t>[max_edge_id]);
+
+    // the caller of `Run()` is one of the executors
+    for (uint32_t i = workers_.size() + 1; i < thread_num_; ++i) {
+        workers_.emplace_back(&ParallelScheduler::ExecuteReadyNodes, this, true);
+    }
+
+    return RC_SUCCESS;
+}
+
+EdgeObject* ParallelScheduler::AllocObject(const ir::Edge* edge, uint32_t etype, Device* device) {
+    lock_guard<mutex> lck(pool_mutex_);
+
+    if (etype == EdgeObject::T_TENSOR) {
+        auto tensor = tensor_pool_.Alloc(edge, TENSORTYPE_NORMAL);
+        if (tensor) {
+            tensor->SetDevice(device);
+        }
+        return tensor;
+    }
+
+    if (etype == EdgeObject::T_TENSOR_SEQUENCE) {
+        return tensor_sequence_pool_.Alloc(edge);
+    }
+
+    LOG(ERROR) << "invalid object type[" << etype << "] of edge[" << edge->GetName() << "]";
+    return nullptr;
+}
+
+RetCode ParallelScheduler::ReleaseEdge(edgeid_t eid) {
+    if (eid >= edgeid2refcount_.size() || edgeid2refcount_[eid] == 0) {
+        return RC_SUCCESS;
+    }
+
+    // the last user of this edge is responsible for releasing it
+    if (pending_edge_users_[eid].fetch_sub(1) != 1) {
+        return RC_SUCCESS;
+    }
+
+    // users may not acquire this edge at all, e.g. kernels skipping optional outputs
+    auto obj = graph_->edgeid2object[eid];
+    if (!obj) {
+        return RC_SUCCESS;
+    }
+    graph_->edgeid2object[eid] = nullptr;
+
+    lock_guard<mutex> lck(pool_mutex_);
+    if (obj->GetObjectType() == EdgeObject::T_TENSOR) {
+        tensor_pool_.Free(static_cast<TensorImpl*>(obj));
+    } else if (obj->GetObjectType() == EdgeObject::T_TENSOR_SEQUENCE) {
+        tensor_sequence_pool_.Free(static_cast<TensorSequence*>(obj));
+    } else {
+        LOG(ERROR) << "invalid edge object type[" << obj->GetObjectType() << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode ParallelScheduler::ReleaseNodeEdges(const ir::Node* node) {
+    RetCode status = RC_SUCCESS;
+    auto release_edge = [this, &status](edgeid_t eid) -> void {
+        auto rc = ReleaseEdge(eid);
+        if (rc != RC_SUCCESS) {
+            status = rc;
+        }
+    };
+
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        release_edge(node->GetInput(i));
+    }
+    for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+        release_edge(node->GetExtraInput(i));
+    }
+    for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+        release_edge(node->GetOutput(i));
+    }
+
+    return status;
+}
+
+RetCode ParallelScheduler::ExecuteNode(nodeid_t nid, KernelExecContext* ctx, ParallelAcquireObject* getter) {
+    /*
+      edges are released by ids in `ReleaseNodeEdges()` instead of by objects existing after execution, so that
+      refcounts computed from the topology in `Init()` are decreased exactly once per user, whether or not the
+      user acquires the edge object.
+    */
+    auto release_object_func = [](EdgeObject*, nodeid_t) -> RetCode {
+        return RC_SUCCESS;
+    };
+
+    auto kernel = graph_->nodeid2kernel[nid].get();
+    ctx->SetNode(kernel->GetNode());
+    ctx->SetProfilingFlag(profiler_->IsProfilingEnabled());
+    getter->SetDevice(kernel->GetDevice());
+
+    auto status = utils::ExecuteKernel(kernel, ctx, release_object_func, profiler_);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "execute kernel[" << kernel->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    status = ReleaseNodeEdges(kernel->GetNode());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "release edges of kernel[" << kernel->GetName() << "] failed: " << GetRetCodeStr(status);
+    }
+    return status;
+}
+
+void ParallelScheduler::OnNodeFinished(nodeid_t nid, RetCode status) {
+    --pending_node_count_;
+
+    if (status != RC_SUCCESS) {
+        if (run_status_ == RC_SUCCESS) {
+            run_status_ = status;
+        }
+        // stops scheduling remaining nodes
+        ready_nodes_.clear();
+    } else if (run_status_ == RC_SUCCESS) {
+        auto& successors = nodeid2successors_[nid];
+        for (auto s = successors.begin(); s != successors.end(); ++s) {
+            uint32_t& count = pending_predecessors_[*s];
+            --count;
+            if (count == 0) {
+                ready_nodes_.push_back(*s);
+                cond_.notify_one();
+            }
+        }
+    }
+
+    if (IsRunFinished()) {
+        cond_.notify_all();
+    }
+}
+
+void ParallelScheduler::ExecuteReadyNodes(bool is_worker) {
+    KernelExecContext ctx;
+    ParallelAcquireObject getter(topo_, &graph_->edgeid2object, this);
+    ctx.SetAcquireObject(&getter);
+
+    unique_lock<mutex> lck(mutex_);
+    while (true) {
+        if (is_worker) {
+            cond_.wait(lck, [this]() -> bool {
+                return (stop_ || !ready_nodes_.empty());
+            });
+            if (stop_) {
+                return;
+            }
+        } else {
+            cond_.wait(lck, [this]() -> bool {
+                return (!ready_nodes_.empty() || IsRunFinished());
+            });
+            if (IsRunFinished()) {
+                return;
+            }
+        }
+
+        auto nid = ready_nodes_.front();
+        ready_nodes_.pop_front();
+        ++running_node_count_;
+
+        lck.unlock();
+        auto status = ExecuteNode(nid, &ctx, &getter);
+        lck.lock();
+
+        --running_node_count_;
+        OnNodeFinished(nid, status);
+    }
+}
+
+RetCode ParallelScheduler::Run(Profiler* profiler) {
+    profiler_ = profiler;
+    for (uint32_t i = 0; i < edgeid2refcount_.size(); ++i) {
+        pending_edge_users_[i].store(edgeid2refcount_[i], std::memory_order_relaxed);
+    }
+
+    {
+        lock_guard<mutex> lck(mutex_);
+        pending_predecessors_ = nodeid2predecessor_count_;
+        pending_node_count_ = aux_info_->sorted_nodes.size();
+        running_node_count_ = 0;
+        run_status_ = RC_SUCCESS;
+        ready_nodes_.assign(initial_nodes_.begin(), initial_nodes_.end());
+    }
+    cond_.notify_all();
+
+    ExecuteReadyNodes(false);
+
+    lock_guard<mutex> lck(mutex_);
+    return run_status_;
+}
+
+}} // namespace ppl::nn
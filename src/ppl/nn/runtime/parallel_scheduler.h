@@ -0,0 +1,131 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_PARALLEL_SCHEDULER_H_
+#define _ST_HPC_PPL_NN_RUNTIME_PARALLEL_SCHEDULER_H_
+
+#include "ppl/nn/runtime/scheduler.h"
+#include "ppl/common/object_pool.h"
+#include "ppl/nn/runtime/tensor_sequence.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <deque>
+
+namespace ppl { namespace nn {
+
+class ParallelAcquireObject;
+
+/**
+   @class ParallelScheduler
+   @brief runs kernels whose predecessors are finished concurrently on a worker pool.
+   @note an edge object is released after all of its users(the producer and consumers) finish executing, whether
+   or not they acquire it. edges whose `RuntimeAuxInfo::tensor_last_consumer` is invalid are never released, as
+   `SequentialScheduler` does.
+*/
+class ParallelScheduler final : public Scheduler {
+public:
+    /** @param thread_num number of threads including the caller of `Run()`. 0 means hardware concurrency. */
+    ParallelScheduler(uint32_t thread_num);
+    ~ParallelScheduler();
+
+    ppl::common::RetCode Init(const ir::GraphTopo* topo, const RuntimeAuxInfo* aux_info,
+                              RuntimeGraphResource* g) override;
+    ppl::common::RetCode Run(Profiler*) override;
+
+    EdgeObject* AllocObject(const ir::Edge*, uint32_t etype, Device*);
+
+private:
+    /**
+       @brief executes ready nodes until `Run()` is finished(if `is_worker` is false) or
+       this scheduler is destroyed(if `is_worker` is true).
+    */
+    void ExecuteReadyNodes(bool is_worker);
+
+    ppl::common::RetCode ExecuteNode(nodeid_t, KernelExecContext*, ParallelAcquireObject*);
+
+    /** @brief decreases the refcount of `eid` and releases its object when the last user finishes */
+    ppl::common::RetCode ReleaseEdge(edgeid_t eid);
+
+    /** @brief called after `node` is executed successfully */
+    ppl::common::RetCode ReleaseNodeEdges(const ir::Node* node);
+
+    /** @note MUST be called with `mutex_` held */
+    void OnNodeFinished(nodeid_t, ppl::common::RetCode);
+
+    /** @note MUST be called with `mutex_` held */
+    bool IsRunFinished() const {
+        return (pending_node_count_ == 0 ||
+                (run_status_ != ppl::common::RC_SUCCESS && running_node_count_ == 0));
+    }
+
+private:
+    const ir::GraphTopo* topo_;
+    const RuntimeAuxInfo* aux_info_;
+    RuntimeGraphResource* graph_;
+
+    /** successors of each node. subscriptor is node id. */
+    std::vector<std::vector<nodeid_t>> nodeid2successors_;
+
+    /** number of predecessors of each node. subscriptor is node id. */
+    std::vector<uint32_t> nodeid2predecessor_count_;
+
+    /** number of times each releasable edge is used(produced or consumed). 0 means never released. */
+    std::vector<uint32_t> edgeid2refcount_;
+
+    /** nodes that have no predecessors */
+    std::vector<nodeid_t> initial_nodes_;
+
+    // ----- states of a Run() ----- //
+
+    Profiler* profiler_ = nullptr;
+    std::unique_ptr<std::atomic<uint32_t>[]> pending_edge_users_;
+
+    /** protects the following states */
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<uint32_t> pending_predecessors_;
+    std::deque<nodeid_t> ready_nodes_;
+    uint32_t pending_node_count_ = 0;
+    uint32_t running_node_count_ = 0;
+    ppl::common::RetCode run_status_ = ppl::common::RC_SUCCESS;
+    bool stop_ = false;
+
+    // ----- worker pool ----- //
+
+    uint32_t thread_num_;
+    std::vector<std::thread> workers_;
+
+    /** protects object pools which are shared among threads */
+    std::mutex pool_mutex_;
+
+    /** used to accelerlate tensor allocations */
+    ppl::common::ObjectPool<TensorImpl> tensor_pool_;
+
+    /** used to accelerlate tensor sequence allocations */
+    ppl::common::ObjectPool<TensorSequence> tensor_sequence_pool_;
+
+private:
+    ParallelScheduler(const ParallelScheduler&) = delete;
+    ParallelScheduler& operator=(const ParallelScheduler&) = delete;
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -16,7 +16,9 @@
 // under the License.
 
 #include "ppl/nn/runtime/profiler.h"
+#include "ppl/nn/runtime/tensor_impl.h"
 #include "ppl/nn/common/logger.h"
+#include <algorithm>
 using namespace std;
 using namespace ppl::common;
 
@@ -30,16 +32,89 @@ void Profiler::Init(const RuntimeInternalConf* conf, const RuntimeGraphResource*
 }
 
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
-void Profiler::CollectStatistics(KernelImpl* kernel) {
-    if (conf_->profiling_flag) {
-        auto info = &nodeid2info_[kernel->GetNode()->GetId()];
-        info->exec_microseconds += kernel->GetExecutionTime();
-        ++info->exec_count;
+#define PROFILER_MAX_RECENT_EXEC_COUNT 4096
+#define PROFILER_MAX_TRACE_EVENT_COUNT (1 << 20)
+
+static const TensorImpl* GetTensor(EdgeObject* object) {
+    if (object && object->GetObjectType() == EdgeObject::T_TENSOR) {
+        return static_cast<const TensorImpl*>(object);
+    }
+    return nullptr;
+}
+
+void Profiler::CollectStatistics(KernelImpl* kernel, const KernelExecContext& ctx,
+                                 const std::chrono::time_point<std::chrono::steady_clock>& begin_ts) {
+    if (!conf_->profiling_flag) {
+        return;
+    }
+
+    auto nid = kernel->GetNode()->GetId();
+    auto info = &nodeid2info_[nid];
+    auto exec_microseconds = kernel->GetExecutionTime();
+
+    if (info->recent_microseconds.size() < PROFILER_MAX_RECENT_EXEC_COUNT) {
+        info->recent_microseconds.push_back(exec_microseconds);
+    } else {
+        info->recent_microseconds[info->exec_count % PROFILER_MAX_RECENT_EXEC_COUNT] = exec_microseconds;
+    }
+    info->exec_microseconds += exec_microseconds;
+    ++info->exec_count;
+
+    // inputs that are not used by this kernel any more are still available here
+    info->bytes = 0;
+    info->input_dims.resize(ctx.GetInputCount());
+    for (uint32_t i = 0; i < ctx.GetInputCount(); ++i) {
+        auto tensor = GetTensor(ctx.GetInput<EdgeObject>(i));
+        if (!tensor) {
+            info->input_dims[i].clear();
+            continue;
+        }
+        auto shape = tensor->GetShape();
+        info->input_dims[i].assign(shape->GetDims(), shape->GetDims() + shape->GetDimCount());
+        info->bytes += shape->GetBytesExcludingPadding();
+    }
+    for (uint32_t i = 0; i < ctx.GetOutputCount(); ++i) {
+        auto tensor = GetTensor(ctx.GetOutput<EdgeObject>(i));
+        if (tensor) {
+            info->bytes += tensor->GetShape()->GetBytesExcludingPadding();
+        }
+    }
+    info->flops = kernel->CalcFlops(ctx);
+    info->total_flops += info->flops;
+
+    uint64_t iteration_count, iteration_overhead_microseconds;
+    kernel->GetIterationInfo(&iteration_count, &iteration_overhead_microseconds);
+    info->iteration_count += iteration_count;
+    info->iteration_overhead_microseconds += iteration_overhead_microseconds;
+
+    TraceEvent event;
+    event.nid = nid;
+    event.begin_microseconds = std::chrono::duration_cast<std::chrono::microseconds>(begin_ts - start_ts_).count();
+    event.duration_microseconds = exec_microseconds;
+
+    std::lock_guard<std::mutex> lck(trace_mutex_);
+    auto ret_pair = thread_id2idx_.insert(make_pair(std::this_thread::get_id(), thread_id2idx_.size()));
+    event.thread_idx = ret_pair.first->second;
+    if (trace_events_.size() < PROFILER_MAX_TRACE_EVENT_COUNT) {
+        trace_events_.push_back(event);
+    } else {
+        trace_events_[trace_event_count_ % PROFILER_MAX_TRACE_EVENT_COUNT] = event;
     }
+    ++trace_event_count_;
 }
 
 void Profiler::StartProfiling(nodeid_t max_node_id) {
     nodeid2info_.resize(max_node_id);
+    start_ts_ = std::chrono::steady_clock::now();
+}
+
+static uint64_t GetPercentile(vector<uint64_t>* values, uint32_t percent) {
+    if (values->empty()) {
+        return 0;
+    }
+    auto nth = values->begin() + (values->size() - 1) * percent / 100;
+    std::nth_element(values->begin(), nth, values->end());
+    return *nth;
 }
 
 RetCode Profiler::GetProfilingStatistics(ProfilingStatistics* stat) const {
@@ -48,6 +123,8 @@ RetCode Profiler::GetProfilingStatistics(ProfilingStatistics* stat) const {
         return RC_INVALID_VALUE;
     }
 
+    vector<uint32_t> nid2kernel_idx(nodeid2info_.size(), UINT32_MAX);
+
     stat->prof_info.reserve(aux_info_->sorted_nodes.size());
     for (auto x = aux_info_->sorted_nodes.begin(); x != aux_info_->sorted_nodes.end(); ++x) {
         auto nid = *x;
@@ -61,14 +138,58 @@ RetCode Profiler::GetProfilingStatistics(ProfilingStatistics* stat) const {
         kernel_prof_info.type = op_type.name;
         kernel_prof_info.exec_microseconds = info.exec_microseconds;
         kernel_prof_info.exec_count = info.exec_count;
+
+        vector<uint64_t> recent_microseconds(info.recent_microseconds);
+        kernel_prof_info.p50_microseconds = GetPercentile(&recent_microseconds, 50);
+        kernel_prof_info.p99_microseconds = GetPercentile(&recent_microseconds, 99);
+        kernel_prof_info.max_microseconds = GetPercentile(&recent_microseconds, 100);
+
+        kernel_prof_info.algorithm = kernel->GetAlgorithmInfo();
+        kernel_prof_info.input_dims = info.input_dims;
+        kernel_prof_info.flops = info.flops;
+        kernel_prof_info.bytes = info.bytes;
+        if (info.exec_microseconds > 0) {
+            // flops per microsecond is 1e-3 GFLOP/s
+            kernel_prof_info.gflops_per_second = (double)info.total_flops / info.exec_microseconds / 1000;
+        }
+        kernel_prof_info.iteration_count = info.iteration_count;
+        if (info.iteration_count > 0) {
+            kernel_prof_info.iteration_overhead_microseconds =
+                (double)info.iteration_overhead_microseconds / info.iteration_count;
+        }
+
+        nid2kernel_idx[nid] = stat->prof_info.size();
         stat->prof_info.emplace_back(std::move(kernel_prof_info));
     }
 
+    std::lock_guard<std::mutex> lck(trace_mutex_);
+    stat->trace_events.reserve(trace_events_.size());
+    // the oldest event is at the current position of the ring buffer
+    const uint64_t first = (trace_events_.size() < PROFILER_MAX_TRACE_EVENT_COUNT)
+        ? 0
+        : trace_event_count_ % PROFILER_MAX_TRACE_EVENT_COUNT;
+    for (uint64_t i = 0; i < trace_events_.size(); ++i) {
+        auto& event = trace_events_[(first + i) % trace_events_.size()];
+        KernelTraceEvent trace_event;
+        trace_event.kernel_idx = nid2kernel_idx[event.nid];
+        if (trace_event.kernel_idx == UINT32_MAX) {
+            continue;
+        }
+        trace_event.thread_idx = event.thread_idx;
+        trace_event.begin_microseconds = event.begin_microseconds;
+        trace_event.duration_microseconds = event.duration_microseconds;
+        stat->trace_events.push_back(trace_event);
+    }
+
     return RC_SUCCESS;
 }
 
 void Profiler::StopProfiling() {
     nodeid2info_.clear();
+    std::lock_guard<std::mutex> lck(trace_mutex_);
+    thread_id2idx_.clear();
+    trace_events_.clear();
+    trace_event_count_ = 0;
 }
 #endif
 
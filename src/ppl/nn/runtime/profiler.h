@@ -26,6 +26,9 @@
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
 #include "ppl/nn/runtime/profiling_statistics.h"
 #include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
 #endif
 
 namespace ppl { namespace nn {
@@ -43,7 +46,9 @@ public:
     }
 
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
-    void CollectStatistics(KernelImpl*);
+    /** @note MUST be called before objects used by `kernel` are released */
+    void CollectStatistics(KernelImpl* kernel, const KernelExecContext& ctx,
+                           const std::chrono::time_point<std::chrono::steady_clock>& begin_ts);
 
 public:
     void StartProfiling(nodeid_t max_node_id);
@@ -54,9 +59,30 @@ private:
     struct KernelExecInfo {
         uint32_t exec_count = 0;
         uint64_t exec_microseconds = 0;
+        std::vector<uint64_t> recent_microseconds; // ring buffer of recent executions
+        std::vector<std::vector<int64_t>> input_dims;
+        uint64_t flops = 0; // of the last execution
+        uint64_t total_flops = 0; // of all executions, which may have different input shapes
+        uint64_t bytes = 0;
+        uint64_t iteration_count = 0;
+        uint64_t iteration_overhead_microseconds = 0;
+    };
+
+    struct TraceEvent {
+        nodeid_t nid;
+        uint32_t thread_idx;
+        uint64_t begin_microseconds;
+        uint64_t duration_microseconds;
     };
 
     std::vector<KernelExecInfo> nodeid2info_;
+    std::chrono::time_point<std::chrono::steady_clock> start_ts_;
+
+    // kernels may be executed by different threads
+    mutable std::mutex trace_mutex_;
+    std::map<std::thread::id, uint32_t> thread_id2idx_;
+    std::vector<TraceEvent> trace_events_; // ring buffer
+    uint64_t trace_event_count_ = 0;
 #endif
 
 private:
@@ -0,0 +1,106 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "ppl/nn/runtime/profiling_statistics.h"
+#include "ppl/nn/common/logger.h"
+#include <fstream>
+#include <stdio.h>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+static void WriteJsonString(const string& str, ofstream* ofs) {
+    *ofs << '"';
+    for (auto c : str) {
+        if (c == '"' || c == '\\') {
+            *ofs << '\\' << c;
+        } else if ((unsigned char)c < 0x20) {
+            char buf[8];
+            sprintf(buf, "\\u%04x", (unsigned int)c);
+            *ofs << buf;
+        } else {
+            *ofs << c;
+        }
+    }
+    *ofs << '"';
+}
+
+static void WriteDims(const vector<int64_t>& dims, ofstream* ofs) {
+    *ofs << '"';
+    for (uint32_t i = 0; i < dims.size(); ++i) {
+        if (i > 0) {
+            *ofs << 'x';
+        }
+        *ofs << dims[i];
+    }
+    *ofs << '"';
+}
+
+RetCode ExportChromeTrace(const ProfilingStatistics& stat, const char* filename) {
+    for (auto& event : stat.trace_events) {
+        if (event.kernel_idx >= stat.prof_info.size()) {
+            LOG(ERROR) << "kernel index [" << event.kernel_idx << "] of trace event >= kernel count ["
+                       << stat.prof_info.size() << "]";
+            return RC_INVALID_VALUE;
+        }
+    }
+
+    ofstream ofs(filename, ios_base::out | ios_base::trunc);
+    if (!ofs.is_open()) {
+        LOG(ERROR) << "open file [" << filename << "] failed.";
+        return RC_OTHER_ERROR;
+    }
+
+    // complete events("ph":"X") with timestamps in microseconds
+    ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (uint32_t i = 0; i < stat.trace_events.size(); ++i) {
+        auto& event = stat.trace_events[i];
+        auto& info = stat.prof_info[event.kernel_idx];
+
+        if (i > 0) {
+            ofs << ',';
+        }
+        ofs << "\n{\"name\":";
+        WriteJsonString(info.name, &ofs);
+        ofs << ",\"cat\":";
+        WriteJsonString(info.domain.empty() ? info.type : info.domain + "." + info.type, &ofs);
+        ofs << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread_idx << ",\"ts\":" << event.begin_microseconds
+            << ",\"dur\":" << event.duration_microseconds << ",\"args\":{";
+        if (!info.algorithm.empty()) {
+            ofs << "\"algorithm\":";
+            WriteJsonString(info.algorithm, &ofs);
+            ofs << ',';
+        }
+        ofs << "\"inputs\":[";
+        for (uint32_t j = 0; j < info.input_dims.size(); ++j) {
+            if (j > 0) {
+                ofs << ',';
+            }
+            WriteDims(info.input_dims[j], &ofs);
+        }
+        ofs << "],\"flops\":" << info.flops << ",\"bytes\":" << info.bytes << "}}";
+    }
+    ofs << "\n]}\n";
+
+    if (!ofs.good()) {
+        LOG(ERROR) << "write file [" << filename << "] failed.";
+        return RC_OTHER_ERROR;
+    }
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
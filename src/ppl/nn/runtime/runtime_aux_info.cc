@@ -18,6 +18,8 @@
 #include "ppl/nn/runtime/runtime_aux_info.h"
 #include "ppl/nn/ir/utils.h"
 #include "ppl/nn/common/logger.h"
+#include <map>
+#include <string>
 using namespace std;
 using namespace ppl::common;
 
@@ -145,6 +147,63 @@ static RetCode InitTensorLastConsumer(const ir::GraphTopo* topo, const vector<no
     return RC_SUCCESS;
 }
 
+/*
+  ops whose shapes of outputs depend on values of inputs, and the index of the first input whose values are used.
+  outputs of ops with subgraphs are treated as depending on values of all inputs.
+*/
+static const map<string, uint32_t> g_value_dependent_ops = {
+    {"ConstantOfShape", 0}, {"Expand", 1}, {"If", 0}, {"Loop", 0}, {"MaxUnpool", 2}, {"NonMaxSuppression", 0},
+    {"NonZero", 0}, {"OneHot", 1}, {"Pad", 1}, {"Range", 0}, {"ReduceSum", 1}, {"Reshape", 1}, {"Resize", 1},
+    {"Scan", 0}, {"SequenceAt", 1}, {"Slice", 1}, {"Split", 1}, {"SplitToSequence", 1}, {"Squeeze", 1}, {"Tile", 1},
+    {"TopK", 1}, {"Unsqueeze", 1}, {"Upsample", 1},
+};
+
+/*
+  values of an edge are stable if they are the same in every run with the same input shapes, e.g. constants and
+  outputs of `Shape`. returns true if every op in `g_value_dependent_ops` only uses values of stable edges.
+*/
+static bool AreShapesDeterminedByInputs(const ir::GraphTopo* topo, const vector<nodeid_t>& sorted_nodes) {
+    vector<bool> is_stable(topo->GetMaxEdgeId(), false);
+    for (uint32_t i = 0; i < topo->GetConstantCount(); ++i) {
+        is_stable[topo->GetConstant(i)] = true;
+    }
+
+    for (auto x = sorted_nodes.begin(); x != sorted_nodes.end(); ++x) {
+        auto node = topo->GetNodeById(*x);
+        auto& type = node->GetType();
+
+        bool all_inputs_stable = (node->GetInputCount() > 0);
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto eid = node->GetInput(i);
+            if (eid != INVALID_EDGEID && !is_stable[eid]) {
+                all_inputs_stable = false;
+                break;
+            }
+        }
+
+        auto ref = g_value_dependent_ops.find(type.name);
+        if (ref != g_value_dependent_ops.end()) {
+            for (uint32_t i = ref->second; i < node->GetInputCount(); ++i) {
+                auto eid = node->GetInput(i);
+                if (eid != INVALID_EDGEID && !is_stable[eid]) {
+                    return false;
+                }
+            }
+            if (node->GetExtraInputCount() > 0) {
+                return false;
+            }
+        }
+
+        // values of `Shape` only depend on shapes of inputs
+        bool outputs_stable = (type.name == "Shape" || all_inputs_stable);
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            is_stable[node->GetOutput(i)] = outputs_stable;
+        }
+    }
+
+    return true;
+}
+
 RetCode GenerateRuntimeAuxInfo(const ir::GraphTopo* topo, RuntimeAuxInfo* info) {
     utils::DfsDeeperFirst(topo, [info](nodeid_t nid) -> void {
         info->sorted_nodes.push_back(nid);
@@ -156,6 +215,8 @@ RetCode GenerateRuntimeAuxInfo(const ir::GraphTopo* topo, RuntimeAuxInfo* info)
         return status;
     }
 
+    info->shapes_determined_by_inputs = AreShapesDeterminedByInputs(topo, info->sorted_nodes);
+
     return RC_SUCCESS;
 }
 
@@ -20,6 +20,7 @@
 
 #include "ppl/nn/common/types.h"
 #include "ppl/nn/runtime/runtime_graph_info.h"
+#include "ppl/nn/runtime/runtime_memory_plan.h"
 #include <vector>
 
 namespace ppl { namespace nn {
@@ -34,6 +35,15 @@ struct RuntimeAuxInfo final {
 
     /** a tensor can be released right after the last consumer finish executing in `sorted_nodes` */
     std::vector<nodeid_t> tensor_last_consumer;
+
+    /** static memory plan of activations. empty if shapes are not fixed in preprocessing stage. */
+    RuntimeMemoryPlan memory_plan;
+
+    /**
+       tells whether shapes of all tensors are determined by shapes of inputs, i.e. no kernel infers shapes of outputs
+       from values of inputs that may vary between runs. shapes inferred in the last run can be reused if it is true.
+    */
+    bool shapes_determined_by_inputs = false;
 };
 
 ppl::common::RetCode GenerateRuntimeAuxInfo(const ir::GraphTopo*, RuntimeAuxInfo*);
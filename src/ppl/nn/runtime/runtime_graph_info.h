@@ -21,6 +21,7 @@
 #include "ppl/nn/common/tensor_shape.h"
 #include "ppl/nn/common/buffer_info.h"
 #include "ppl/nn/runtime/opt_kernel.h"
+#include "ppl/common/file_mapping.h"
 #include <vector>
 #include <map>
 
@@ -40,13 +41,20 @@ struct RuntimeGraphInfo final {
         EngineImpl* engine = nullptr;
         std::vector<std::unique_ptr<OptKernel>> ops;
         std::map<edgeid_t, BufferInfo> constants;
+
+        /** refer to `RuntimePartitionInfo::shapes` */
+        std::map<edgeid_t, TensorShape> shapes;
     };
 
     void Clear() {
         shapes.clear();
         partitions.clear();
+        file_mappings.clear();
     }
 
+    /** mapped model files which buffers of constants may point to. released after `partitions`. */
+    std::vector<std::unique_ptr<ppl::common::FileMapping>> file_mappings;
+
     std::map<edgeid_t, TensorShape> shapes;
     std::vector<Partition> partitions;
 };
@@ -33,6 +33,9 @@ struct RuntimeGraphResource final {
         tensors.clear();
         edgeid2object.clear();
         nodeid2kernel.clear();
+        edgeid2reserved_buffer.clear();
+        edgeid2cached_shape.clear();
+        use_cached_shapes = false;
     }
 
     /** union of inputs/extra_inputs/constants/outputs */
@@ -43,6 +46,24 @@ struct RuntimeGraphResource final {
 
     /** kernels list where the subscriptor is KernelImpl::GetNode()::GetId() */
     std::vector<std::unique_ptr<KernelImpl>> nodeid2kernel;
+
+    /**
+       buffers reserved by `RuntimeAuxInfo::memory_plan` where the subscriptor is edge id.
+       empty if static memory plan is not used.
+    */
+    std::vector<BufferDesc> edgeid2reserved_buffer;
+
+    /**
+       shapes of tensors inferred in the last `Run()` where the subscriptor is edge id.
+       empty if `RuntimeAuxInfo::shapes_determined_by_inputs` is false.
+    */
+    std::vector<TensorShape> edgeid2cached_shape;
+
+    /**
+       if true, tensors created during `Run()` use shapes in `edgeid2cached_shape` and kernels skip reshaping.
+       otherwise shapes of tensors are recorded in `edgeid2cached_shape` when they are released.
+    */
+    bool use_cached_shapes = false;
 };
 
 }} // namespace ppl::nn
@@ -19,9 +19,11 @@
 #include "ppl/nn/engines/engine_impl.h"
 #include "ppl/nn/runtime/runtime_impl.h"
 #include "ppl/nn/runtime/sequential_scheduler.h"
+#include "ppl/nn/runtime/parallel_scheduler.h"
 #include "ppl/nn/runtime/runtime_internal_conf.h"
 #include "ppl/nn/utils/utils.h"
 #include <stdarg.h>
+#include <string.h>
 using namespace std;
 using namespace ppl::common;
 
@@ -30,6 +32,7 @@ namespace ppl { namespace nn {
 RuntimeImpl::~RuntimeImpl() {
     sched_.reset();
     graph_.Clear();
+    FreeMemoryArenas();
     engctx_.clear();
     graph_info_.reset();
 }
@@ -281,8 +284,66 @@ RetCode RuntimeImpl::Init(const shared_ptr<ir::GraphTopo>& topo, const shared_pt
         return status;
     }
 
-    sched_.reset(new SequentialScheduler());
-    return sched_->Init(topo.get(), aux_info.get(), &graph_);
+    if (aux_info->shapes_determined_by_inputs) {
+        graph_.edgeid2cached_shape.resize(topo->GetMaxEdgeId());
+    }
+
+    return InitScheduler();
+}
+
+RetCode RuntimeImpl::InitScheduler() {
+    if (conf_.sched_policy == RUNTIME_SCHED_PARALLEL) {
+        sched_.reset(new ParallelScheduler(conf_.sched_thread_num));
+    } else {
+        sched_.reset(new SequentialScheduler());
+    }
+    return sched_->Init(topo_.get(), aux_info_.get(), &graph_);
+}
+
+RetCode RuntimeImpl::InitMemoryArenas() {
+    auto& plan = aux_info_->memory_plan;
+
+    map<EngineImpl*, uint32_t> engine2arena;
+    for (edgeid_t eid = 0; eid < plan.edgeid2block.size(); ++eid) {
+        auto engine = plan.edgeid2block[eid].engine;
+        if (!engine || engine2arena.find(engine) != engine2arena.end()) {
+            continue;
+        }
+
+        // arena of an engine is allocated by the device used by kernels of this engine
+        auto producer = topo_->GetEdgeById(eid)->GetProducer();
+        auto device = graph_.nodeid2kernel[producer]->GetDevice();
+
+        BufferDesc arena;
+        auto status = device->Realloc(plan.arena_bytes.at(engine), &arena);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "alloc [" << plan.arena_bytes.at(engine) << "] bytes for arena of engine["
+                       << engine->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+
+        engine2arena.insert(make_pair(engine, memory_arenas_.size()));
+        memory_arenas_.push_back(make_pair(device, arena));
+    }
+
+    graph_.edgeid2reserved_buffer.resize(plan.edgeid2block.size());
+    for (edgeid_t eid = 0; eid < plan.edgeid2block.size(); ++eid) {
+        auto& block = plan.edgeid2block[eid];
+        if (block.engine) {
+            auto arena = memory_arenas_[engine2arena[block.engine]].second.addr;
+            graph_.edgeid2reserved_buffer[eid] = BufferDesc(static_cast<char*>(arena) + block.offset);
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+void RuntimeImpl::FreeMemoryArenas() {
+    graph_.edgeid2reserved_buffer.clear();
+    for (auto x = memory_arenas_.begin(); x != memory_arenas_.end(); ++x) {
+        x->first->Free(&x->second);
+    }
+    memory_arenas_.clear();
 }
 
 RetCode RuntimeImpl::Sync() {
@@ -300,6 +361,50 @@ RetCode RuntimeImpl::Sync() {
     return RC_SUCCESS;
 }
 
+static inline bool IsSameShape(const TensorShape& a, const TensorShape& b) {
+    if (a.GetDataType() != b.GetDataType() || a.GetDataFormat() != b.GetDataFormat() ||
+        a.GetDimCount() != b.GetDimCount()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.GetDimCount(); ++i) {
+        if (a.GetDim(i) != b.GetDim(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RuntimeImpl::IsInputShapesUnchanged() const {
+    if (!is_shape_cache_valid_) {
+        return false;
+    }
+
+    uint32_t idx = 0;
+    for (uint32_t i = 0; i < GetInputCount(); ++i, ++idx) {
+        if (!IsSameShape(*GetInputTensorImpl(i)->GetShape(), cached_input_shapes_[idx])) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < GetExtraInputCount(); ++i, ++idx) {
+        if (!IsSameShape(*GetExtraInputTensorImpl(i)->GetShape(), cached_input_shapes_[idx])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RuntimeImpl::SaveInputShapes() {
+    cached_input_shapes_.resize(GetInputCount() + GetExtraInputCount());
+
+    uint32_t idx = 0;
+    for (uint32_t i = 0; i < GetInputCount(); ++i, ++idx) {
+        cached_input_shapes_[idx] = *GetInputTensorImpl(i)->GetShape();
+    }
+    for (uint32_t i = 0; i < GetExtraInputCount(); ++i, ++idx) {
+        cached_input_shapes_[idx] = *GetExtraInputTensorImpl(i)->GetShape();
+    }
+}
+
 RetCode RuntimeImpl::Run() {
     RetCode status;
 
@@ -312,12 +417,26 @@ RetCode RuntimeImpl::Run() {
         }
     }
 
+    /*
+      shapes are only recorded by the sequential scheduler. kernels can skip reshaping if shapes of inputs are
+      the same as those in the run in which shapes are recorded.
+    */
+    const bool shape_cache_enabled = (!graph_.edgeid2cached_shape.empty() &&
+                                      conf_.sched_policy == RUNTIME_SCHED_SEQUENTIAL);
+    graph_.use_cached_shapes = (shape_cache_enabled && IsInputShapesUnchanged());
+
     status = sched_->Run(&profiler_);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "Run() failed: " << GetRetCodeStr(status);
+        is_shape_cache_valid_ = false;
         return status;
     }
 
+    if (shape_cache_enabled && !graph_.use_cached_shapes) {
+        SaveInputShapes();
+        is_shape_cache_valid_ = true;
+    }
+
     return Sync();
 }
 
@@ -351,8 +470,142 @@ RetCode RuntimeImpl::SetProfilingFlag(RuntimeImpl* rt, va_list args) {
 #endif
 }
 
+RetCode RuntimeImpl::SetSchedulingPolicy(RuntimeImpl* rt, va_list args) {
+    auto policy = va_arg(args, uint32_t);
+    if (policy != RUNTIME_SCHED_SEQUENTIAL && policy != RUNTIME_SCHED_PARALLEL) {
+        LOG(ERROR) << "invalid scheduling policy[" << policy << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    if (policy == rt->conf_.sched_policy) {
+        return RC_SUCCESS;
+    }
+
+    if (policy == RUNTIME_SCHED_PARALLEL && rt->conf_.memory_plan_flag) {
+        LOG(ERROR) << "parallel scheduling cannot be used with static memory plan.";
+        return RC_UNSUPPORTED;
+    }
+
+    if (policy == RUNTIME_SCHED_PARALLEL) {
+        // kernels on the same device may run concurrently, which is only safe for x86 devices now
+        for (auto x = rt->engctx_.begin(); x != rt->engctx_.end(); ++x) {
+            auto device = (*x)->GetDevice();
+            if (strcmp(device->GetType(), "x86") != 0) {
+                LOG(ERROR) << "parallel scheduling is not supported by device[" << device->GetType()
+                           << "] of engine context[" << (*x)->GetName() << "].";
+                return RC_UNSUPPORTED;
+            }
+        }
+    }
+
+    rt->conf_.sched_policy = policy;
+    return rt->InitScheduler();
+}
+
+RetCode RuntimeImpl::SetSchedulingThreadNum(RuntimeImpl* rt, va_list args) {
+    auto thread_num = va_arg(args, uint32_t);
+    if (thread_num == rt->conf_.sched_thread_num) {
+        return RC_SUCCESS;
+    }
+
+    rt->conf_.sched_thread_num = thread_num;
+    if (rt->conf_.sched_policy == RUNTIME_SCHED_PARALLEL) {
+        return rt->InitScheduler();
+    }
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeImpl::SetMemoryPlanFlag(RuntimeImpl* rt, va_list args) {
+    bool flag = (va_arg(args, uint32_t) > 0);
+    if (flag == rt->conf_.memory_plan_flag) {
+        return RC_SUCCESS;
+    }
+
+    if (!flag) {
+        rt->FreeMemoryArenas();
+        rt->conf_.memory_plan_flag = false;
+        return RC_SUCCESS;
+    }
+
+    // lifetimes of planned tensors are based on the order of `RuntimeAuxInfo::sorted_nodes`
+    if (rt->conf_.sched_policy != RUNTIME_SCHED_SEQUENTIAL) {
+        LOG(ERROR) << "static memory plan can only be used with sequential scheduling.";
+        return RC_UNSUPPORTED;
+    }
+
+    auto status = rt->InitMemoryArenas();
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "InitMemoryArenas failed: " << GetRetCodeStr(status);
+        rt->FreeMemoryArenas();
+        return status;
+    }
+
+    rt->conf_.memory_plan_flag = true;
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeImpl::GetPlannedMemoryBytes(RuntimeImpl* rt, va_list args) {
+    auto bytes = va_arg(args, uint64_t*);
+    *bytes = rt->aux_info_->memory_plan.GetTotalBytes();
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeImpl::GetMemoryStatistics(RuntimeImpl* rt, va_list args) {
+    auto stat = va_arg(args, MemoryStatistics*);
+    *stat = MemoryStatistics();
+
+    auto& shapes = rt->graph_info_->shapes;
+    for (auto p = rt->graph_info_->partitions.begin(); p != rt->graph_info_->partitions.end(); ++p) {
+        for (auto c = p->constants.begin(); c != p->constants.end(); ++c) {
+            auto shape_ref = shapes.find(c->first);
+            if (shape_ref != shapes.end()) {
+                stat->constant_bytes += shape_ref->second.GetBytesIncludingPadding();
+            }
+        }
+    }
+
+    for (auto x = rt->engctx_.begin(); x != rt->engctx_.end(); ++x) {
+        MemoryStatistics dev_stat;
+        auto status = x->get()->GetDevice()->GetMemoryStatistics(&dev_stat);
+        if (status == RC_UNSUPPORTED) {
+            continue;
+        }
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "GetMemoryStatistics of EngineContext[" << x->get()->GetName()
+                       << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+
+        stat->activation_bytes += dev_stat.activation_bytes;
+        stat->max_activation_bytes += dev_stat.max_activation_bytes;
+        stat->scratch_bytes += dev_stat.scratch_bytes;
+        stat->max_scratch_bytes += dev_stat.max_scratch_bytes;
+        stat->total_bytes += dev_stat.total_bytes;
+        stat->max_total_bytes += dev_stat.max_total_bytes;
+        stat->reserved_bytes += dev_stat.reserved_bytes;
+        stat->budget_exceeded_count += dev_stat.budget_exceeded_count;
+    }
+
+    for (auto x = rt->aux_info_->sorted_nodes.begin(); x != rt->aux_info_->sorted_nodes.end(); ++x) {
+        auto kernel = rt->graph_.nodeid2kernel[*x].get();
+        KernelMemoryInfo info;
+        info.name = kernel->GetName();
+        info.domain = kernel->GetType().domain;
+        info.type = kernel->GetType().name;
+        info.max_scratch_bytes = kernel->GetMaxTmpBufferBytes();
+        stat->kernel_info.emplace_back(std::move(info));
+    }
+
+    return RC_SUCCESS;
+}
+
 RuntimeImpl::ConfHandlerFunc RuntimeImpl::conf_handlers_[] = {
-    RuntimeImpl::SetProfilingFlag,
+    RuntimeImpl::SetProfilingFlag, // RUNTIME_CONF_SET_KERNEL_PROFILING_FLAG
+    RuntimeImpl::SetSchedulingPolicy, // RUNTIME_CONF_SET_SCHEDULING_POLICY
+    RuntimeImpl::SetSchedulingThreadNum, // RUNTIME_CONF_SET_SCHEDULING_THREAD_NUM
+    RuntimeImpl::SetMemoryPlanFlag, // RUNTIME_CONF_SET_MEMORY_PLAN_FLAG
+    RuntimeImpl::GetPlannedMemoryBytes, // RUNTIME_CONF_GET_PLANNED_MEMORY_BYTES
+    RuntimeImpl::GetMemoryStatistics, // RUNTIME_CONF_GET_MEMORY_STATISTICS
 };
 
 RetCode RuntimeImpl::Configure(uint32_t option, ...) {
@@ -89,6 +89,17 @@ public:
 private:
     ppl::common::RetCode InitRuntimeGraphResource(const ir::GraphTopo*, const RuntimeGraphInfo&, RuntimeGraphResource*);
 
+    /** @brief creates a scheduler according to `conf_` */
+    ppl::common::RetCode InitScheduler();
+
+    /** @brief allocates arenas required by `RuntimeAuxInfo::memory_plan` and reserves buffers for tensors */
+    ppl::common::RetCode InitMemoryArenas();
+    void FreeMemoryArenas();
+
+    /** @brief tells whether shapes of inputs are the same as those when shapes in `graph_` are cached */
+    bool IsInputShapesUnchanged() const;
+    void SaveInputShapes();
+
     /**
        @brief blocks until all operations finish.
        @note MUST be called before getting outputs or profiling statistics in case some engine may run asynchronously.
@@ -102,6 +113,13 @@ private:
     RuntimeInternalConf conf_;
     Profiler profiler_;
 
+    /** arenas used by static memory plan */
+    std::vector<std::pair<Device*, BufferDesc>> memory_arenas_;
+
+    /** shapes of inputs and extra inputs in the run in which `RuntimeGraphResource::edgeid2cached_shape` is filled */
+    std::vector<TensorShape> cached_input_shapes_;
+    bool is_shape_cache_valid_ = false;
+
     // ----- shared data ----- //
 
     std::shared_ptr<ir::GraphTopo> topo_;
@@ -114,6 +132,11 @@ private:
       defined as member functions can avoid exporting unnecessary APIs
     */
     static ppl::common::RetCode SetProfilingFlag(RuntimeImpl*, va_list);
+    static ppl::common::RetCode SetSchedulingPolicy(RuntimeImpl*, va_list);
+    static ppl::common::RetCode SetSchedulingThreadNum(RuntimeImpl*, va_list);
+    static ppl::common::RetCode SetMemoryPlanFlag(RuntimeImpl*, va_list);
+    static ppl::common::RetCode GetPlannedMemoryBytes(RuntimeImpl*, va_list);
+    static ppl::common::RetCode GetMemoryStatistics(RuntimeImpl*, va_list);
 
     typedef ppl::common::RetCode (*ConfHandlerFunc)(RuntimeImpl*, va_list);
     static ConfHandlerFunc conf_handlers_[RUNTIME_CONF_MAX];
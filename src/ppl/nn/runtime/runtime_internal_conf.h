@@ -18,12 +18,17 @@
 #ifndef _ST_HPC_PPL_NN_RUNTIME_RUNTIME_INTERNAL_CONF_H_
 #define _ST_HPC_PPL_NN_RUNTIME_RUNTIME_INTERNAL_CONF_H_
 
+#include "ppl/nn/runtime/runtime.h"
+
 namespace ppl { namespace nn {
 
 struct RuntimeInternalConf {
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
     bool profiling_flag = false;
 #endif
+    uint32_t sched_policy = RUNTIME_SCHED_SEQUENTIAL;
+    uint32_t sched_thread_num = 0;
+    bool memory_plan_flag = false;
 };
 
 }} // namespace ppl::nn
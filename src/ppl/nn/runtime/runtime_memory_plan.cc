@@ -0,0 +1,170 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/runtime_memory_plan.h"
+#include "ppl/nn/runtime/runtime_aux_info.h"
+#include "ppl/nn/common/logger.h"
+#include <algorithm>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+/** offsets are aligned so that every block satisfies alignment requirements of all engines */
+static const uint64_t g_block_alignment = 256;
+
+static inline uint64_t Align(uint64_t x, uint64_t n) {
+    return (x + n - 1) & (~(n - 1));
+}
+
+struct BlockLifetime final {
+    edgeid_t eid;
+    uint32_t first; // index of the producer in `sorted_nodes`
+    uint32_t last; // index of the last user in `sorted_nodes`
+};
+
+static RetCode CollectPlannableBlocks(const ir::GraphTopo* topo, const RuntimeGraphInfo& info,
+                                      const RuntimeAuxInfo& aux_info, const vector<uint32_t>& nodeid2pos,
+                                      RuntimeMemoryPlan* plan, vector<BlockLifetime>* lifetimes) {
+    const nodeid_t max_node_id = topo->GetMaxNodeId();
+
+    for (auto p = info.partitions.begin(); p != info.partitions.end(); ++p) {
+        for (auto o = p->ops.begin(); o != p->ops.end(); ++o) {
+            auto node = (*o)->GetNode();
+            for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+                auto eid = node->GetOutput(i);
+                auto shape_ref = p->shapes.find(eid);
+                if (shape_ref == p->shapes.end()) {
+                    continue;
+                }
+
+                // tensors which are never released, e.g. outputs, are not planned
+                auto last_consumer = aux_info.tensor_last_consumer[eid];
+                if (last_consumer >= max_node_id) {
+                    continue;
+                }
+
+                auto bytes = shape_ref->second.GetBytesIncludingPadding();
+                if (bytes == 0) {
+                    continue;
+                }
+
+                auto& block = plan->edgeid2block[eid];
+                block.engine = p->engine;
+                block.bytes = Align(bytes, g_block_alignment);
+
+                BlockLifetime lifetime;
+                lifetime.eid = eid;
+                lifetime.first = nodeid2pos[node->GetId()];
+                lifetime.last = nodeid2pos[last_consumer];
+                if (lifetime.first >= aux_info.sorted_nodes.size() || lifetime.last >= aux_info.sorted_nodes.size()) {
+                    LOG(ERROR) << "cannot find producer or last consumer of tensor["
+                               << topo->GetEdgeById(eid)->GetName() << "] in sorted nodes";
+                    return RC_NOT_FOUND;
+                }
+                lifetimes->push_back(lifetime);
+            }
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+static void AssignOffsets(const vector<BlockLifetime>& lifetimes, RuntimeMemoryPlan* plan) {
+    auto& edgeid2block = plan->edgeid2block;
+
+    // larger blocks are placed first
+    vector<uint32_t> order(lifetimes.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&lifetimes, &edgeid2block](uint32_t a, uint32_t b) -> bool {
+        return (edgeid2block[lifetimes[a].eid].bytes > edgeid2block[lifetimes[b].eid].bytes);
+    });
+
+    vector<uint32_t> placed;
+    placed.reserve(order.size());
+    vector<const RuntimeMemoryPlan::Block*> conflicts;
+
+    for (auto x = order.begin(); x != order.end(); ++x) {
+        auto& lifetime = lifetimes[*x];
+        auto& block = edgeid2block[lifetime.eid];
+
+        conflicts.clear();
+        for (auto p = placed.begin(); p != placed.end(); ++p) {
+            auto& other_lifetime = lifetimes[*p];
+            auto other = &edgeid2block[other_lifetime.eid];
+            if (other->engine == block.engine && other_lifetime.first <= lifetime.last &&
+                lifetime.first <= other_lifetime.last) {
+                conflicts.push_back(other);
+            }
+        }
+        std::sort(conflicts.begin(), conflicts.end(),
+                  [](const RuntimeMemoryPlan::Block* a, const RuntimeMemoryPlan::Block* b) -> bool {
+                      return (a->offset < b->offset);
+                  });
+
+        // finds the smallest gap that can hold this block
+        uint64_t best_offset = UINT64_MAX;
+        uint64_t best_gap = UINT64_MAX;
+        uint64_t prev_end = 0;
+        for (auto c = conflicts.begin(); c != conflicts.end(); ++c) {
+            auto other = *c;
+            if (other->offset > prev_end) {
+                auto gap = other->offset - prev_end;
+                if (gap >= block.bytes && gap < best_gap) {
+                    best_gap = gap;
+                    best_offset = prev_end;
+                }
+            }
+            prev_end = max(prev_end, other->offset + other->bytes);
+        }
+        block.offset = (best_offset == UINT64_MAX) ? prev_end : best_offset;
+
+        uint64_t& arena_bytes = plan->arena_bytes[block.engine];
+        arena_bytes = max(arena_bytes, block.offset + block.bytes);
+
+        placed.push_back(*x);
+    }
+}
+
+RetCode GenerateRuntimeMemoryPlan(const ir::GraphTopo* topo, const RuntimeGraphInfo& info,
+                                  const RuntimeAuxInfo& aux_info, RuntimeMemoryPlan* plan) {
+    plan->Clear();
+    plan->edgeid2block.resize(topo->GetMaxEdgeId());
+    if (aux_info.sorted_nodes.empty()) {
+        return RC_SUCCESS;
+    }
+
+    vector<uint32_t> nodeid2pos(topo->GetMaxNodeId(), UINT32_MAX);
+    for (uint32_t i = 0; i < aux_info.sorted_nodes.size(); ++i) {
+        nodeid2pos[aux_info.sorted_nodes[i]] = i;
+    }
+
+    vector<BlockLifetime> lifetimes;
+    auto status = CollectPlannableBlocks(topo, info, aux_info, nodeid2pos, plan, &lifetimes);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "CollectPlannableBlocks failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    AssignOffsets(lifetimes, plan);
+
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
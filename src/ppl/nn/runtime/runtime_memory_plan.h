@@ -0,0 +1,74 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_RUNTIME_MEMORY_PLAN_H_
+#define _ST_HPC_PPL_NN_RUNTIME_RUNTIME_MEMORY_PLAN_H_
+
+#include "ppl/nn/ir/graph_topo.h"
+#include <vector>
+#include <map>
+
+namespace ppl { namespace nn {
+
+class EngineImpl;
+struct RuntimeGraphInfo;
+struct RuntimeAuxInfo;
+
+/**
+   @class RuntimeMemoryPlan
+   @brief assigns each activation with a fixed shape an offset in an arena of the engine which produces it.
+   activations whose lifetimes overlap never share memory in the topological order of `RuntimeAuxInfo::sorted_nodes`.
+*/
+struct RuntimeMemoryPlan final {
+    struct Block final {
+        /** engine whose device is used to allocate the arena. nullptr means that this tensor is not planned. */
+        EngineImpl* engine = nullptr;
+        uint64_t offset = 0;
+        uint64_t bytes = 0;
+    };
+
+    void Clear() {
+        edgeid2block.clear();
+        arena_bytes.clear();
+    }
+
+    /** returns the sum of all arenas' sizes */
+    uint64_t GetTotalBytes() const {
+        uint64_t total = 0;
+        for (auto it = arena_bytes.begin(); it != arena_bytes.end(); ++it) {
+            total += it->second;
+        }
+        return total;
+    }
+
+    /** subscriptor is edge id */
+    std::vector<Block> edgeid2block;
+
+    /** size of the arena required by each engine */
+    std::map<EngineImpl*, uint64_t> arena_bytes;
+};
+
+/**
+   @brief generates a static memory plan from shapes inferred by engines in preprocessing stage.
+   tensors without fixed shapes are left unplanned and allocated by devices during `Run()`.
+*/
+ppl::common::RetCode GenerateRuntimeMemoryPlan(const ir::GraphTopo*, const RuntimeGraphInfo&, const RuntimeAuxInfo&,
+                                               RuntimeMemoryPlan*);
+
+}} // namespace ppl::nn
+
+#endif
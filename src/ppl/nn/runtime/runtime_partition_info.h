@@ -28,6 +28,13 @@ namespace ppl { namespace nn {
 struct RuntimePartitionInfo final {
     std::map<edgeid_t, RuntimeConstantInfo> constants;
     std::map<nodeid_t, std::unique_ptr<OptKernel>> kernels;
+
+    /**
+       fixed shapes of non-constant tensors inferred in preprocessing stage, which are used to generate a static
+       memory plan. optional.
+       @note tensors whose buffers may be transferred to other tensors by kernels MUST NOT be included.
+    */
+    std::map<edgeid_t, TensorShape> shapes;
 };
 
 }} // namespace ppl::nn
@@ -54,6 +54,11 @@ static RetCode AfterExecuteKernel(KernelImpl* kernel, KernelExecContext* ctx,
 
     for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
         auto object = ctx->GetOutput<EdgeObject>(i);
+        // outputs may not be created if kernels skip reshaping and do not use them
+        if (!object) {
+            continue;
+        }
+
         auto status = release_func(object, nid);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "release edge[" << object->GetEdge()->GetName() << "] failed: " << GetRetCodeStr(status);
@@ -66,10 +71,17 @@ static RetCode AfterExecuteKernel(KernelImpl* kernel, KernelExecContext* ctx,
 
 RetCode ExecuteKernel(KernelImpl* kernel, KernelExecContext* ctx,
                       const function<RetCode(EdgeObject*, nodeid_t)>& release_func, Profiler* profiler) {
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    std::chrono::time_point<std::chrono::steady_clock> begin_ts;
+    if (profiler->IsProfilingEnabled()) {
+        begin_ts = std::chrono::steady_clock::now();
+    }
+#endif
+
     auto exec_status = kernel->Execute(ctx);
 
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
-    profiler->CollectStatistics(kernel);
+    profiler->CollectStatistics(kernel, *ctx, begin_ts);
 #endif
 
     auto status = AfterExecuteKernel(kernel, ctx, release_func);
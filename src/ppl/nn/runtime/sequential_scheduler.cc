@@ -36,10 +36,12 @@ RetCode SequentialScheduler::Init(const ir::GraphTopo* topo, const RuntimeAuxInf
 
 class SchedulerAcquireObject final : public InputOutputInfo::AcquireObject {
 public:
-    SchedulerAcquireObject(const ir::GraphTopo* topo, vector<EdgeObject*>* edgeid2object,
+    SchedulerAcquireObject(const ir::GraphTopo* topo, const RuntimeAuxInfo* aux_info, RuntimeGraphResource* graph,
                            ObjectPool<TensorImpl>* tensor_pool, ObjectPool<TensorSequence>* tensor_sequence_pool)
-        : device_(nullptr), topo_(topo), edgeid2object_(edgeid2object), tensor_pool_(tensor_pool)
-        , tensor_sequence_pool_(tensor_sequence_pool) {}
+        : device_(nullptr), topo_(topo), edgeid2object_(&graph->edgeid2object)
+        , edgeid2reserved_buffer_(&graph->edgeid2reserved_buffer), edgeid2block_(&aux_info->memory_plan.edgeid2block)
+        , edgeid2cached_shape_(graph->use_cached_shapes ? &graph->edgeid2cached_shape : nullptr)
+        , tensor_pool_(tensor_pool), tensor_sequence_pool_(tensor_sequence_pool) {}
 
     void SetDevice(Device* d) {
         device_ = d;
@@ -57,6 +59,12 @@ public:
             if (etype == EdgeObject::T_TENSOR) {
                 auto tensor = tensor_pool_->Alloc(edge, TENSORTYPE_NORMAL);
                 tensor->SetDevice(device_);
+                if (eid < edgeid2reserved_buffer_->size() && edgeid2reserved_buffer_->at(eid).addr) {
+                    tensor->SetReservedBuffer(edgeid2reserved_buffer_->at(eid), edgeid2block_->at(eid).bytes);
+                }
+                if (edgeid2cached_shape_) {
+                    *tensor->GetShape() = edgeid2cached_shape_->at(eid);
+                }
                 object = tensor;
             } else if (etype == EdgeObject::T_TENSOR_SEQUENCE) {
                 object = tensor_sequence_pool_->Alloc(edge);
@@ -80,17 +88,26 @@ private:
     Device* device_;
     const ir::GraphTopo* topo_;
     vector<EdgeObject*>* edgeid2object_;
+    const vector<BufferDesc>* edgeid2reserved_buffer_;
+    const vector<RuntimeMemoryPlan::Block>* edgeid2block_;
+    const vector<TensorShape>* edgeid2cached_shape_;
     ObjectPool<TensorImpl>* tensor_pool_;
     ObjectPool<TensorSequence>* tensor_sequence_pool_;
 };
 
 RetCode SequentialScheduler::Run(Profiler* profiler) {
-    auto release_object_func = [this](EdgeObject* object, nodeid_t user) -> RetCode {
+    const bool record_shapes = (!graph_->use_cached_shapes && !graph_->edgeid2cached_shape.empty());
+
+    auto release_object_func = [this, record_shapes](EdgeObject* object, nodeid_t user) -> RetCode {
         auto eid = object->GetEdge()->GetId();
         if (aux_info_->tensor_last_consumer[eid] == user) {
             auto obj = graph_->edgeid2object[eid];
             if (obj->GetObjectType() == EdgeObject::T_TENSOR) {
-                tensor_pool_.Free(static_cast<TensorImpl*>(obj));
+                auto tensor = static_cast<TensorImpl*>(obj);
+                if (record_shapes) {
+                    graph_->edgeid2cached_shape[eid] = *tensor->GetShape();
+                }
+                tensor_pool_.Free(tensor);
             } else if (obj->GetObjectType() == EdgeObject::T_TENSOR_SEQUENCE) {
                 tensor_sequence_pool_.Free(static_cast<TensorSequence*>(obj));
             } else {
@@ -113,8 +130,9 @@ RetCode SequentialScheduler::Run(Profiler* profiler) {
 
     KernelExecContext ctx;
     ctx.SetProfilingFlag(profiler->IsProfilingEnabled());
+    ctx.SetSkipReshapeFlag(graph_->use_cached_shapes);
 
-    SchedulerAcquireObject getter(topo_, &graph_->edgeid2object, &tensor_pool_, &tensor_sequence_pool_);
+    SchedulerAcquireObject getter(topo_, aux_info_, graph_, &tensor_pool_, &tensor_sequence_pool_);
     ctx.SetAcquireObject(&getter);
 
     for (auto x = aux_info_->sorted_nodes.begin(); x != aux_info_->sorted_nodes.end(); ++x) {
@@ -23,7 +23,8 @@ using namespace ppl::common;
 namespace ppl { namespace nn {
 
 RetCode TensorImpl::ReallocBuffer() {
-    if (!buffer_info_.IsBufferOwner() && buffer_info_.GetBufferPtr()) {
+    // reserved buffers are checked against the required size and replaced by device buffers if they are too small
+    if (!buffer_info_.IsBufferOwner() && buffer_info_.GetBufferPtr() && !buffer_info_.HasReservedBuffer()) {
         LOG(WARNING) << "tensor[" << GetName() << "] is not the buffer owner. ReallocBuffer() does nothing.";
         return RC_SUCCESS;
     }
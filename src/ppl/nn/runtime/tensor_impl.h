@@ -67,6 +67,11 @@ public:
         buffer_info_.SetBuffer(buf, device, is_buffer_owner);
     }
 
+    /** @brief refer to `BufferInfo::SetReservedBuffer()` */
+    void SetReservedBuffer(const BufferDesc& buf, uint64_t bytes) {
+        buffer_info_.SetReservedBuffer(buf, bytes);
+    }
+
     /**
        @brief move buffer from tensor `another`. old buffer of this tensor will be freed(or detached).
        @note this tensor will inherits the ownership of `another`.
@@ -0,0 +1,366 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/attention.h"
+#include "ppl/kernel/x86/fp32/eltwise_chain.h"
+#include "ppl/kernel/x86/fp32/layer_norm.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+
+static vector<float> GenData(uint64_t count, uint32_t seed) {
+    vector<float> data(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        data[i] = (float)((i * 7919 + seed * 104729) % 23) / 23.0f - 0.5f;
+    }
+    return data;
+}
+
+static ppl::nn::TensorShape MakeShape(const vector<int64_t>& dims) {
+    ppl::nn::TensorShape shape;
+    shape.Reshape(dims);
+    shape.SetDataType(DATATYPE_FLOAT32);
+    shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    return shape;
+}
+
+static void ExpectNear(const vector<float>& expected, const vector<float>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (uint64_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(expected[i], actual[i], 1e-4f * (1.0f + fabsf(expected[i]))) << "at " << i;
+    }
+}
+
+static bool HasFma() {
+    return (GetCpuISA() & ISA_X86_FMA) != 0;
+}
+
+#ifdef PPL_USE_X86_AVX512
+static bool HasAvx512() {
+    return (GetCpuISA() & ISA_X86_AVX512) != 0;
+}
+#endif
+
+/*
+  evaluates the subgraph replaced by FuseLayerNorm op by op:
+  ReduceMean, Sub, Pow(2), ReduceMean, Add(eps), Sqrt, Div, [Mul(scale), Add(shift)]
+*/
+static vector<float> LayerNormSubgraph(const vector<float>& x, int64_t outer, int64_t inner, const float* scale,
+                                       const float* shift, float eps) {
+    vector<float> y(x.size());
+    for (int64_t o = 0; o < outer; ++o) {
+        const float* src = x.data() + o * inner;
+        float* dst = y.data() + o * inner;
+
+        float mean = 0.0f;
+        for (int64_t i = 0; i < inner; ++i) {
+            mean += src[i];
+        }
+        mean /= inner;
+
+        vector<float> d(inner);
+        float var = 0.0f;
+        for (int64_t i = 0; i < inner; ++i) {
+            d[i] = src[i] - mean;
+            var += d[i] * d[i];
+        }
+        var /= inner;
+
+        const float std = sqrtf(var + eps);
+        for (int64_t i = 0; i < inner; ++i) {
+            dst[i] = d[i] / std;
+            if (scale) {
+                dst[i] = dst[i] * scale[i] + shift[i];
+            }
+        }
+    }
+    return y;
+}
+
+TEST(X86FusedKernelTest, layer_norm) {
+    const float eps = 1e-5f;
+    // normalized lengths cover simd tails: 37 = 2 * 16 + 5, 5 * 37 = 11 * 16 + 9
+    const vector<int64_t> dims = {3, 5, 37};
+
+    for (int64_t axis : {2, 1}) {
+        int64_t outer = 1, inner = 1;
+        for (int64_t i = 0; i < (int64_t)dims.size(); ++i) {
+            (i < axis ? outer : inner) *= dims[i];
+        }
+        auto src_shape = MakeShape(dims);
+        auto src = GenData(outer * inner, 1);
+        auto scale = GenData(inner, 2);
+        auto shift = GenData(inner, 3);
+
+        for (bool affine : {false, true}) {
+            const float* scale_data = affine ? scale.data() : nullptr;
+            const float* shift_data = affine ? shift.data() : nullptr;
+            auto expected = LayerNormSubgraph(src, outer, inner, scale_data, shift_data, eps);
+
+            vector<float> dst(src.size(), 123.0f);
+            ASSERT_EQ(RC_SUCCESS,
+                      layer_norm_fp32(&src_shape, src.data(), scale_data, shift_data, axis, eps, dst.data()));
+            ExpectNear(expected, dst);
+
+            if (HasFma()) {
+                dst.assign(src.size(), 123.0f);
+                ASSERT_EQ(RC_SUCCESS,
+                          layer_norm_fp32_fma(&src_shape, src.data(), scale_data, shift_data, axis, eps, dst.data()));
+                ExpectNear(expected, dst);
+            }
+
+#ifdef PPL_USE_X86_AVX512
+            if (HasAvx512()) {
+                dst.assign(src.size(), 123.0f);
+                ASSERT_EQ(RC_SUCCESS, layer_norm_fp32_avx512(&src_shape, src.data(), scale_data, shift_data, axis,
+                                                             eps, dst.data()));
+                ExpectNear(expected, dst);
+            }
+#endif
+        }
+    }
+}
+
+/*
+  evaluates the subgraph replaced by FuseAttention op by op:
+  MatMul(Q, K), Mul(scale), Add(mask), Softmax(axis = -1), MatMul(., V)
+  mask is indexed by `mask_strides` of [batch, S, T], 0 for broadcasted dims.
+*/
+static vector<float> AttentionSubgraph(const vector<float>& Q, const vector<float>& K, const vector<float>& V,
+                                       const float* mask, const int64_t mask_strides[3], int64_t batch, int64_t S,
+                                       int64_t D, int64_t T, int64_t Dv, float scale) {
+    vector<float> scores(batch * S * T);
+    for (int64_t b = 0; b < batch; ++b) {
+        for (int64_t i = 0; i < S; ++i) {
+            for (int64_t t = 0; t < T; ++t) {
+                float sum = 0.0f;
+                for (int64_t d = 0; d < D; ++d) {
+                    sum += Q[(b * S + i) * D + d] * K[(b * D + d) * T + t];
+                }
+                scores[(b * S + i) * T + t] = sum;
+            }
+        }
+    }
+    for (int64_t b = 0; b < batch; ++b) {
+        for (int64_t i = 0; i < S; ++i) {
+            for (int64_t t = 0; t < T; ++t) {
+                float& s = scores[(b * S + i) * T + t];
+                s *= scale;
+                if (mask) {
+                    s += mask[b * mask_strides[0] + i * mask_strides[1] + t * mask_strides[2]];
+                }
+            }
+        }
+    }
+    for (int64_t r = 0; r < batch * S; ++r) {
+        float* row = scores.data() + r * T;
+        float max_value = row[0];
+        for (int64_t t = 1; t < T; ++t) {
+            max_value = max(max_value, row[t]);
+        }
+        float sum = 0.0f;
+        for (int64_t t = 0; t < T; ++t) {
+            row[t] = expf(row[t] - max_value);
+            sum += row[t];
+        }
+        for (int64_t t = 0; t < T; ++t) {
+            row[t] /= sum;
+        }
+    }
+    vector<float> dst(batch * S * Dv);
+    for (int64_t b = 0; b < batch; ++b) {
+        for (int64_t i = 0; i < S; ++i) {
+            for (int64_t j = 0; j < Dv; ++j) {
+                float sum = 0.0f;
+                for (int64_t t = 0; t < T; ++t) {
+                    sum += scores[(b * S + i) * T + t] * V[(b * T + t) * Dv + j];
+                }
+                dst[(b * S + i) * Dv + j] = sum;
+            }
+        }
+    }
+    return dst;
+}
+
+TEST(X86FusedKernelTest, attention) {
+    // S is not a multiple of the rows blocked per thread, T and Dv are not multiples of simd width
+    const int64_t batch = 2, S = 7, D = 13, T = 19, Dv = 21;
+    const float scale = 1.0f / sqrtf((float)D);
+    auto q_shape = MakeShape({batch, S, D});
+    auto k_shape = MakeShape({batch, D, T});
+    auto v_shape = MakeShape({batch, T, Dv});
+    auto Q = GenData(batch * S * D, 1);
+    auto K = GenData(batch * D * T, 2);
+    auto V = GenData(batch * T * Dv, 3);
+
+    struct MaskCase {
+        vector<int64_t> dims;
+        int64_t strides[3]; // of [batch, S, T]
+    };
+    const vector<MaskCase> mask_cases = {
+        {{}, {0, 0, 0}}, // no mask
+        {{batch, S, T}, {S * T, T, 1}},
+        {{S, T}, {0, T, 1}},
+        {{batch, 1, T}, {T, 0, 1}},
+    };
+
+    for (auto& mask_case : mask_cases) {
+        auto mask_shape = MakeShape(mask_case.dims);
+        const ppl::nn::TensorShape* mask_shape_ptr = mask_case.dims.empty() ? nullptr : &mask_shape;
+        ASSERT_TRUE(attention_fp32_check_shapes(&q_shape, &k_shape, &v_shape, mask_shape_ptr));
+        auto mask = GenData(mask_case.dims.empty() ? 0 : mask_shape.GetElementsExcludingPadding(), 4);
+        const float* mask_data = mask_case.dims.empty() ? nullptr : mask.data();
+
+        auto expected = AttentionSubgraph(Q, K, V, mask_data, mask_case.strides, batch, S, D, T, Dv, scale);
+        vector<uint8_t> tmp(attention_fp32_get_buffer_bytes(&q_shape, &k_shape));
+
+        vector<float> dst(batch * S * Dv, 123.0f);
+        ASSERT_EQ(RC_SUCCESS, attention_fp32(&q_shape, &k_shape, &v_shape, mask_shape_ptr, Q.data(), K.data(),
+                                             V.data(), mask_data, scale, tmp.data(), dst.data()));
+        ExpectNear(expected, dst);
+
+        if (HasFma()) {
+            dst.assign(batch * S * Dv, 123.0f);
+            ASSERT_EQ(RC_SUCCESS, attention_fp32_fma(&q_shape, &k_shape, &v_shape, mask_shape_ptr, Q.data(), K.data(),
+                                                     V.data(), mask_data, scale, tmp.data(), dst.data()));
+            ExpectNear(expected, dst);
+        }
+
+#ifdef PPL_USE_X86_AVX512
+        if (HasAvx512()) {
+            dst.assign(batch * S * Dv, 123.0f);
+            ASSERT_EQ(RC_SUCCESS,
+                      attention_fp32_avx512(&q_shape, &k_shape, &v_shape, mask_shape_ptr, Q.data(), K.data(),
+                                            V.data(), mask_data, scale, tmp.data(), dst.data()));
+            ExpectNear(expected, dst);
+        }
+#endif
+    }
+}
+
+TEST(X86FusedKernelTest, attention_rejects_unsupported_shapes) {
+    auto q_shape = MakeShape({2, 4, 8});
+    auto k_shape = MakeShape({2, 8, 6});
+    auto v_shape = MakeShape({2, 6, 5});
+    EXPECT_TRUE(attention_fp32_check_shapes(&q_shape, &k_shape, &v_shape, nullptr));
+
+    // batch of K is broadcasted by MatMul but not by the fused kernel
+    auto k_bcast_shape = MakeShape({1, 8, 6});
+    EXPECT_FALSE(attention_fp32_check_shapes(&q_shape, &k_bcast_shape, &v_shape, nullptr));
+
+    // mask does not broadcast to [2, 4, 6]
+    auto mask_shape = MakeShape({3, 6});
+    EXPECT_FALSE(attention_fp32_check_shapes(&q_shape, &k_shape, &v_shape, &mask_shape));
+
+    // V does not match the length of K
+    auto v_bad_shape = MakeShape({2, 5, 5});
+    EXPECT_FALSE(attention_fp32_check_shapes(&q_shape, &k_shape, &v_bad_shape, nullptr));
+}
+
+static eltwise_chain_op MakeChainOp(eltwise_chain_op_type_t type, int32_t src_idx = -1, int32_t value_idx = -1,
+                                    bool reverse = false, float alpha = 0.0f, float beta = 0.0f) {
+    eltwise_chain_op op;
+    op.type = type;
+    op.src_idx = src_idx;
+    op.value_idx = value_idx;
+    op.reverse = reverse;
+    op.alpha = alpha;
+    op.beta = beta;
+    return op;
+}
+
+TEST(X86FusedKernelTest, eltwise_chain) {
+    // more than one tile of the kernel, and not a multiple of simd width
+    const int64_t N = 3, C = 7, H = 5, W = 37;
+    auto dst_shape = MakeShape({N, C, H, W});
+    const int64_t total = N * C * H * W;
+
+    auto x = GenData(total, 1);
+    auto per_channel = GenData(C, 2);
+    auto per_width = GenData(W, 3);
+    const float scalar = 0.25f;
+    auto per_plane = GenData(H * W, 4);
+
+    const vector<vector<int64_t>> src_dims = {{N, C, H, W}, {C, 1, 1}, {W}, {1}, {H, W}};
+    const vector<const float*> src_data = {x.data(), per_channel.data(), per_width.data(), &scalar, per_plane.data()};
+    vector<eltwise_chain_src> srcs(src_dims.size());
+    for (size_t i = 0; i < srcs.size(); ++i) {
+        auto src_shape = MakeShape(src_dims[i]);
+        ASSERT_TRUE(eltwise_chain_init_src(&src_shape, &dst_shape, src_data[i], &srcs[i]));
+    }
+
+    // broadcasting over a range of dims which is not contiguous can not be described by a src
+    auto split_shape = MakeShape({C, 1, W});
+    eltwise_chain_src split_src;
+    EXPECT_FALSE(eltwise_chain_init_src(&split_shape, &dst_shape, per_plane.data(), &split_src));
+
+    const vector<eltwise_chain_op> ops = {
+        MakeChainOp(eltwise_chain_op_type::ADD, 1),                    // 0: x + per_channel
+        MakeChainOp(eltwise_chain_op_type::MUL, 2, -1, true),          // 1: per_width * v
+        MakeChainOp(eltwise_chain_op_type::TANH),                      // 2
+        MakeChainOp(eltwise_chain_op_type::SUB, 3, -1, true),          // 3: scalar - v
+        MakeChainOp(eltwise_chain_op_type::LEAKY_RELU, -1, -1, false, 0.1f),
+        MakeChainOp(eltwise_chain_op_type::MUL, -1, 2),                // 5: v * result of op 2
+        MakeChainOp(eltwise_chain_op_type::CLIP, -1, -1, false, -0.3f, 0.4f),
+        MakeChainOp(eltwise_chain_op_type::SIGMOID),                   // 7
+        MakeChainOp(eltwise_chain_op_type::SUB, -1, 0, true),          // 8: result of op 0 - v
+        MakeChainOp(eltwise_chain_op_type::RELU),                      // 9
+        MakeChainOp(eltwise_chain_op_type::SQRT),                      // 10
+        MakeChainOp(eltwise_chain_op_type::DIV, 4),                    // 11: v / per_plane
+        MakeChainOp(eltwise_chain_op_type::EXP),                       // 12
+    };
+
+    vector<float> expected(total);
+    for (int64_t i = 0; i < total; ++i) {
+        const int64_t w = i % W;
+        const int64_t h = i / W % H;
+        const int64_t c = i / (H * W) % C;
+        const float v0 = x[i] + per_channel[c];
+        const float v2 = tanhf(per_width[w] * v0);
+        float v = scalar - v2;
+        v = v >= 0.0f ? v : v * 0.1f;
+        v = min(max(v * v2, -0.3f), 0.4f);
+        v = v0 - 1.0f / (1.0f + expf(-v));
+        v = sqrtf(max(v, 0.0f));
+        expected[i] = expf(v / per_plane[h * W + w]);
+    }
+
+    vector<uint8_t> tmp(eltwise_chain_fp32_get_buffer_bytes(ops.data(), ops.size()));
+    vector<float> dst(total, 123.0f);
+    ASSERT_EQ(RC_SUCCESS, eltwise_chain_fp32(&dst_shape, srcs.data(), ops.data(), ops.size(), tmp.data(), dst.data()));
+    ExpectNear(expected, dst);
+
+    if (HasFma()) {
+        dst.assign(total, 123.0f);
+        ASSERT_EQ(RC_SUCCESS,
+                  eltwise_chain_fp32_fma(&dst_shape, srcs.data(), ops.data(), ops.size(), tmp.data(), dst.data()));
+        ExpectNear(expected, dst);
+    }
+
+#ifdef PPL_USE_X86_AVX512
+    if (HasAvx512()) {
+        dst.assign(total, 123.0f);
+        ASSERT_EQ(RC_SUCCESS,
+                  eltwise_chain_fp32_avx512(&dst_shape, srcs.data(), ops.data(), ops.size(), tmp.data(), dst.data()));
+        ExpectNear(expected, dst);
+    }
+#endif
+}
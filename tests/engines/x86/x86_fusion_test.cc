@@ -0,0 +1,219 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_ENABLE_ONNX_MODEL
+
+#include "ppl/nn/engines/x86/engine_factory.h"
+#include "ppl/nn/models/onnx/onnx_runtime_builder_factory.h"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <map>
+#include <memory>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::common;
+
+class X86FusionTest : public testing::Test {
+protected:
+    static vector<float> GenInput(uint32_t input_idx, uint64_t count) {
+        vector<float> data(count);
+        for (uint64_t j = 0; j < count; ++j) {
+            data[j] = (float)((j * 5 + input_idx) % 7) - 3.0f;
+        }
+        return data;
+    }
+
+    /** runs `onnx_file` and collects outputs, and profiling info of all kernels by their names if available */
+    void RunOnnxModel(const string& onnx_file, map<string, vector<float>>* outputs,
+                      map<string, KernelProfilingInfo>* kernels) {
+        auto engine = unique_ptr<Engine>(X86EngineFactory::Create(X86EngineOptions()));
+        auto builder = unique_ptr<OnnxRuntimeBuilder>(OnnxRuntimeBuilderFactory::Create());
+        auto ep = engine.get();
+        ASSERT_EQ(RC_SUCCESS, builder->Init(onnx_file.c_str(), &ep, 1));
+        ASSERT_EQ(RC_SUCCESS, builder->Preprocess());
+
+        auto runtime = unique_ptr<Runtime>(builder->CreateRuntime());
+        ASSERT_TRUE(runtime != nullptr);
+        ASSERT_EQ(RC_SUCCESS, runtime->Configure(RUNTIME_CONF_SET_KERNEL_PROFILING_FLAG, true));
+
+        for (uint32_t i = 0; i < runtime->GetInputCount(); ++i) {
+            auto input = runtime->GetInputTensor(i);
+            ASSERT_EQ(RC_SUCCESS, input->ReallocBuffer());
+            auto input_data = GenInput(i, input->GetShape()->GetElementsExcludingPadding());
+            TensorShape src_desc = *input->GetShape();
+            src_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+            ASSERT_EQ(RC_SUCCESS, input->ConvertFromHost(input_data.data(), src_desc));
+        }
+
+        ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+        for (uint32_t i = 0; i < runtime->GetOutputCount(); ++i) {
+            auto output = runtime->GetOutputTensor(i);
+            TensorShape dst_desc = *output->GetShape();
+            dst_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+            auto& data = (*outputs)[output->GetName()];
+            data.resize(dst_desc.GetElementsExcludingPadding());
+            ASSERT_EQ(RC_SUCCESS, output->ConvertToHost(data.data(), dst_desc));
+        }
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+        ProfilingStatistics stat;
+        ASSERT_EQ(RC_SUCCESS, runtime->GetProfilingStatistics(&stat));
+        for (auto it = stat.prof_info.begin(); it != stat.prof_info.end(); ++it) {
+            kernels->insert(make_pair(it->name, *it));
+        }
+#endif
+    }
+
+    static vector<const KernelProfilingInfo*> FindKernels(const map<string, KernelProfilingInfo>& kernels,
+                                                          const string& domain, const string& type) {
+        vector<const KernelProfilingInfo*> found;
+        for (auto it = kernels.begin(); it != kernels.end(); ++it) {
+            if (it->second.domain == domain && it->second.type == type) {
+                found.push_back(&it->second);
+            }
+        }
+        return found;
+    }
+
+    static void ExpectNear(const vector<float>& expected, const vector<float>& actual) {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_NEAR(expected[i], actual[i], 1e-4f * (1.0f + fabsf(expected[i]))) << "at " << i;
+        }
+    }
+};
+
+TEST_F(X86FusionTest, layer_norm) {
+    /*
+      x -> ln_*    -> ln_out    : ReduceMean(-1), Sub, Pow, ReduceMean, Add(eps), Sqrt, Div, Mul(gamma), Add(beta)
+      x -> ref_*   -> ref_out   : same as ln_*, ref_d (output of Sub) is a graph output too
+      x -> axis1_* -> axis1_out : ReduceMean over axis 1 which is not the last one
+      x -> bcast_* -> bcast_out : same as ln_*, but gamma is [4, 1] and does not cover the normalized dims
+    */
+    map<string, vector<float>> outputs;
+    map<string, KernelProfilingInfo> kernels;
+    RunOnnxModel(PPLNN_TESTDATA_DIR + string("/layer_norm.onnx"), &outputs, &kernels);
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    auto layer_norms = FindKernels(kernels, "ppl", "LayerNorm");
+    ASSERT_EQ(2, layer_norms.size());
+
+    auto ln_ref = kernels.find("LayerNorm_ln_mean_ln_div");
+    ASSERT_TRUE(ln_ref != kernels.end());
+    EXPECT_EQ(3, ln_ref->second.input_dims.size()); // x, gamma and beta
+
+    // gamma and beta are left to Mul and Add
+    auto bcast_ref = kernels.find("LayerNorm_bcast_mean_bcast_div");
+    ASSERT_TRUE(bcast_ref != kernels.end());
+    EXPECT_EQ(1, bcast_ref->second.input_dims.size());
+
+    EXPECT_TRUE(kernels.find("ref_mean") != kernels.end());
+    EXPECT_TRUE(kernels.find("axis1_mean") != kernels.end());
+#endif
+
+    ExpectNear(outputs["ref_out"], outputs["ln_out"]);
+}
+
+TEST_F(X86FusionTest, attention) {
+    /*
+      q, k, mask, v -> att_*   -> att_out   : Softmax(MatMul(q, k) / sqrt(8) + mask, axis = -1) * v
+      q, k, mask, v -> ref_*   -> ref_out   : same as att_*, ref_p (output of Softmax) is a graph output too
+      q, k_bcast, v -> bcast_* -> bcast_out : k_bcast is [1, 8, 6] and is broadcasted over the batch of q
+    */
+    map<string, vector<float>> outputs;
+    map<string, KernelProfilingInfo> kernels;
+    RunOnnxModel(PPLNN_TESTDATA_DIR + string("/attention.onnx"), &outputs, &kernels);
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    auto attentions = FindKernels(kernels, "ppl", "Attention");
+    ASSERT_EQ(1, attentions.size());
+    EXPECT_EQ("Attention_att_qk_att_softmax_att_pv", attentions[0]->name);
+    EXPECT_EQ(4, attentions[0]->input_dims.size()); // q, k, v and mask
+
+    EXPECT_TRUE(kernels.find("ref_softmax") != kernels.end());
+    EXPECT_TRUE(kernels.find("bcast_softmax") != kernels.end());
+#endif
+
+    ExpectNear(outputs["ref_out"], outputs["att_out"]);
+}
+
+TEST_F(X86FusionTest, eltwise_chain) {
+    /*
+      x -> c_add(bias) -> c_mul(x) -> c_tanh -> c_sub(0.5, .) -> c_out : one chain
+      x -> o_add(bias) -> o_tanh -> o_mul(2)               -> o_out : o_tanh_out is a graph output
+      x -> m_add(bias) -> m_sigmoid -> m_mul(2)            -> m_out : m_add_out is also used by m_exp
+                       -> m_exp                            -> m_exp_out
+      x -> d_exp -> d_sqrt -> d_div(d_exp_out, .)          -> d_out : d_exp_out is used inside of the chain only
+      x -> s_sigmoid -> s_mul(x)                           -> s_out : swish
+    */
+    map<string, vector<float>> outputs;
+    map<string, KernelProfilingInfo> kernels;
+    RunOnnxModel(PPLNN_TESTDATA_DIR + string("/eltwise_chain.onnx"), &outputs, &kernels);
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    auto chains = FindKernels(kernels, "ppl", "EltwiseChain");
+    EXPECT_EQ(4, chains.size());
+
+    auto c_ref = kernels.find("EltwiseChain_c_add_c_sub");
+    ASSERT_TRUE(c_ref != kernels.end());
+    EXPECT_EQ(3, c_ref->second.input_dims.size()); // x, bias and 0.5
+
+    // chains end at graph outputs, o_mul is left alone
+    EXPECT_TRUE(kernels.find("EltwiseChain_o_add_o_tanh") != kernels.end());
+    EXPECT_TRUE(kernels.find("o_mul") != kernels.end());
+
+    // m_add_out is needed by m_exp, so the chain starts after m_add
+    EXPECT_TRUE(kernels.find("EltwiseChain_m_sigmoid_m_mul") != kernels.end());
+    EXPECT_TRUE(kernels.find("m_add") != kernels.end());
+    EXPECT_TRUE(kernels.find("m_exp") != kernels.end());
+
+    auto d_ref = kernels.find("EltwiseChain_d_exp_d_div");
+    ASSERT_TRUE(d_ref != kernels.end());
+    EXPECT_EQ(1, d_ref->second.input_dims.size());
+
+    // swish has a dedicated kernel which is preferred over a chain
+    auto s_ref = kernels.find("Fused_Swish_s_sigmoid_s_mul");
+    ASSERT_TRUE(s_ref != kernels.end());
+    EXPECT_EQ("Swish", s_ref->second.type);
+#endif
+
+    // x is [2, 3, 4, 5], bias is [5] filled by the model generator
+    auto x = GenInput(0, 2 * 3 * 4 * 5);
+    map<string, vector<float>> expected;
+    for (auto name : {"c_out", "o_tanh_out", "o_out", "m_out", "m_exp_out", "d_out", "s_out"}) {
+        expected[name].resize(x.size());
+    }
+    for (uint64_t i = 0; i < x.size(); ++i) {
+        const float bias = (float)((int64_t)((i % 5) * 7919 % 17) - 8) / 16.0f;
+        const float a = x[i] + bias;
+        expected["c_out"][i] = 0.5f - tanhf(x[i] * a);
+        expected["o_tanh_out"][i] = tanhf(a);
+        expected["o_out"][i] = tanhf(a) * 2.0f;
+        expected["m_out"][i] = 2.0f / (1.0f + expf(-a));
+        expected["m_exp_out"][i] = expf(a);
+        expected["d_out"][i] = expf(x[i]) / sqrtf(expf(x[i]));
+        expected["s_out"][i] = x[i] / (1.0f + expf(-x[i]));
+    }
+    for (auto it = expected.begin(); it != expected.end(); ++it) {
+        SCOPED_TRACE(it->first);
+        ExpectNear(it->second, outputs[it->first]);
+    }
+}
+
+#endif
@@ -0,0 +1,63 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_ENABLE_ONNX_MODEL
+
+#include "ppl/nn/engines/x86/engine_factory.h"
+#include "ppl/nn/models/onnx/onnx_runtime_builder_factory.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::common;
+
+TEST(X86LayoutOptimizeTest, graph_outputs_are_charged_for_ndarray) {
+    // input -> conv -> conv_out -> relu -> relu_out, both conv_out and relu_out are graph outputs
+    const string onnx_file = PPLNN_TESTDATA_DIR + string("/conv_relu.onnx");
+
+    auto engine = unique_ptr<Engine>(X86EngineFactory::Create(X86EngineOptions()));
+    auto builder = unique_ptr<OnnxRuntimeBuilder>(OnnxRuntimeBuilderFactory::Create());
+    auto ep = engine.get();
+    ASSERT_EQ(RC_SUCCESS, builder->Init(onnx_file.c_str(), &ep, 1));
+    ASSERT_EQ(RC_SUCCESS, builder->Preprocess());
+
+    auto runtime = unique_ptr<Runtime>(builder->CreateRuntime());
+    ASSERT_TRUE(runtime != nullptr);
+    ASSERT_EQ(1, runtime->GetInputCount());
+
+    auto input = runtime->GetInputTensor(0);
+    ASSERT_EQ(RC_SUCCESS, input->ReallocBuffer());
+    vector<float> input_data(input->GetShape()->GetElementsExcludingPadding(), 1.0f);
+    TensorShape src_desc = *input->GetShape();
+    src_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+    ASSERT_EQ(RC_SUCCESS, input->ConvertFromHost(input_data.data(), src_desc));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+    /*
+      if conv produces a blocked layout, conv_out has to be converted to NDARRAY for users anyway. running relu in
+      NDARRAY shares that conversion, while running relu in the blocked layout needs another one for relu_out.
+    */
+    for (uint32_t i = 0; i < runtime->GetOutputCount(); ++i) {
+        auto output = runtime->GetOutputTensor(i);
+        if (string(output->GetName()) == "relu_out") {
+            EXPECT_EQ(DATAFORMAT_NDARRAY, output->GetShape()->GetDataFormat());
+        }
+    }
+}
+
+#endif
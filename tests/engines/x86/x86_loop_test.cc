@@ -0,0 +1,90 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_ENABLE_ONNX_MODEL
+
+#include "ppl/nn/engines/x86/engine_factory.h"
+#include "ppl/nn/models/onnx/onnx_runtime_builder_factory.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::common;
+
+static Tensor* FindOutputTensor(Runtime* runtime, const string& name) {
+    for (uint32_t i = 0; i < runtime->GetOutputCount(); ++i) {
+        auto output = runtime->GetOutputTensor(i);
+        if (name == output->GetName()) {
+            return output;
+        }
+    }
+    return nullptr;
+}
+
+TEST(X86LoopTest, scan_outputs_with_early_exit) {
+    /*
+      Loop(M = 2^40, cond = "", x) with body (iter, cond_in, x_in) -> (iter < 4, x_in + 1, (x_in + 1) * 2).
+      `cond` is not given, so the loop may expect M iterations, but the body stops it after 5.
+    */
+    const string onnx_file = PPLNN_TESTDATA_DIR + string("/loop_scan.onnx");
+
+    auto engine = unique_ptr<Engine>(X86EngineFactory::Create(X86EngineOptions()));
+    auto builder = unique_ptr<OnnxRuntimeBuilder>(OnnxRuntimeBuilderFactory::Create());
+    auto ep = engine.get();
+    ASSERT_EQ(RC_SUCCESS, builder->Init(onnx_file.c_str(), &ep, 1));
+    ASSERT_EQ(RC_SUCCESS, builder->Preprocess());
+
+    auto runtime = unique_ptr<Runtime>(builder->CreateRuntime());
+    ASSERT_TRUE(runtime != nullptr);
+    ASSERT_EQ(1, runtime->GetInputCount());
+
+    const float x[] = {1.0f, 2.0f};
+    auto input = runtime->GetInputTensor(0);
+    ASSERT_EQ(RC_SUCCESS, input->ReallocBuffer());
+    TensorShape src_desc = *input->GetShape();
+    src_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+    ASSERT_EQ(RC_SUCCESS, input->ConvertFromHost(x, src_desc));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+    const int64_t trip_count = 5;
+
+    auto x_final = FindOutputTensor(runtime.get(), "x_final");
+    ASSERT_TRUE(x_final != nullptr);
+    float x_final_data[2];
+    TensorShape dst_desc = *x_final->GetShape();
+    dst_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+    ASSERT_EQ(RC_SUCCESS, x_final->ConvertToHost(x_final_data, dst_desc));
+    EXPECT_EQ(x[0] + trip_count, x_final_data[0]);
+    EXPECT_EQ(x[1] + trip_count, x_final_data[1]);
+
+    auto ys = FindOutputTensor(runtime.get(), "ys");
+    ASSERT_TRUE(ys != nullptr);
+    ASSERT_EQ(2, ys->GetShape()->GetDimCount());
+    ASSERT_EQ(trip_count, ys->GetShape()->GetDim(0));
+    ASSERT_EQ(2, ys->GetShape()->GetDim(1));
+    vector<float> ys_data(trip_count * 2);
+    dst_desc = *ys->GetShape();
+    dst_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+    ASSERT_EQ(RC_SUCCESS, ys->ConvertToHost(ys_data.data(), dst_desc));
+    for (int64_t i = 0; i < trip_count; ++i) {
+        EXPECT_EQ((x[0] + i + 1) * 2, ys_data[i * 2]);
+        EXPECT_EQ((x[1] + i + 1) * 2, ys_data[i * 2 + 1]);
+    }
+}
+
+#endif
@@ -0,0 +1,243 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/matmul.h"
+#include "ppl/kernel/x86/fp32/gemm_v2.h"
+#include "ppl/kernel/x86/common/simd_tools.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <memory>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+
+// not multiples of n_blk_len and k_blk_len of any gemm_v2 executor, and larger than one block
+static const int64_t g_m = 9;
+static const int64_t g_k = 300;
+static const int64_t g_n = 203;
+
+static vector<float> GenData(uint64_t count, uint32_t seed) {
+    vector<float> data(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        data[i] = (float)((i * 7919 + seed * 104729) % 23) / 23.0f - 0.5f;
+    }
+    return data;
+}
+
+static ppl::nn::TensorShape MakeShape(const vector<int64_t>& dims) {
+    ppl::nn::TensorShape shape;
+    shape.Reshape(dims);
+    shape.SetDataType(DATATYPE_FLOAT32);
+    shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    return shape;
+}
+
+// numpy matmul of A [batch_a..., M, K] and B [batch_b..., K, N] with broadcasted batch dims of the same rank
+static vector<float> NaiveMatMul(const vector<int64_t>& a_dims, const vector<int64_t>& b_dims, const float* A,
+                                 const float* B, vector<int64_t>* dst_dims) {
+    const int64_t dim_count = a_dims.size();
+    const int64_t M = a_dims[dim_count - 2], K = a_dims[dim_count - 1], N = b_dims[dim_count - 1];
+    dst_dims->assign(dim_count, 0);
+    int64_t batch = 1;
+    for (int64_t i = 0; i < dim_count - 2; ++i) {
+        (*dst_dims)[i] = max(a_dims[i], b_dims[i]);
+        batch *= (*dst_dims)[i];
+    }
+    (*dst_dims)[dim_count - 2] = M;
+    (*dst_dims)[dim_count - 1] = N;
+
+    vector<float> dst(batch * M * N);
+    for (int64_t b = 0; b < batch; ++b) {
+        int64_t a_offset = 0, b_offset = 0, a_stride = M * K, b_stride = K * N;
+        for (int64_t i = dim_count - 3, idx = b; i >= 0; --i) {
+            const int64_t dim_idx = idx % (*dst_dims)[i];
+            idx /= (*dst_dims)[i];
+            a_offset += (a_dims[i] == 1 ? 0 : dim_idx) * a_stride;
+            b_offset += (b_dims[i] == 1 ? 0 : dim_idx) * b_stride;
+            a_stride *= a_dims[i];
+            b_stride *= b_dims[i];
+        }
+        for (int64_t m = 0; m < M; ++m) {
+            for (int64_t n = 0; n < N; ++n) {
+                double sum = 0;
+                for (int64_t k = 0; k < K; ++k) {
+                    sum += (double)A[a_offset + m * K + k] * B[b_offset + k * N + n];
+                }
+                dst[(b * M + m) * N + n] = sum;
+            }
+        }
+    }
+    return dst;
+}
+
+// B of lower rank is aligned to the right
+static vector<int64_t> AlignDims(const vector<int64_t>& dims, size_t dim_count) {
+    vector<int64_t> aligned(dim_count - dims.size(), 1);
+    aligned.insert(aligned.end(), dims.begin(), dims.end());
+    return aligned;
+}
+
+static void ExpectNear(const vector<float>& expected, const vector<float>& actual, float tolerance) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (uint64_t i = 0; i < expected.size(); ++i) {
+        ASSERT_NEAR(expected[i], actual[i], tolerance * (1.0f + fabsf(expected[i]))) << "at " << i;
+    }
+}
+
+struct MatMulCase final {
+    vector<int64_t> a_dims;
+    vector<int64_t> b_dims;
+};
+
+class X86MatMulKernelTest : public testing::TestWithParam<isa_t> {
+protected:
+    bool IsSupported() const {
+        const isa_t isa = GetParam();
+#ifndef PPL_USE_X86_AVX512
+        if (isa & ISA_X86_AVX512) {
+            return false;
+        }
+#endif
+        return (GetCpuISA() & isa) == isa;
+    }
+
+    // runs matmul with B packed or not, and compares dst with the naive one
+    void Run(const MatMulCase& c, bool pack_b) const {
+        const isa_t isa = GetParam();
+        const size_t dim_count = max(c.a_dims.size(), c.b_dims.size());
+        auto a_shape = MakeShape(c.a_dims);
+        auto b_shape = MakeShape(c.b_dims);
+        auto A = GenData(a_shape.GetElementsExcludingPadding(), 1);
+        auto B = GenData(b_shape.GetElementsExcludingPadding(), 2);
+
+        vector<int64_t> dst_dims;
+        auto expected =
+            NaiveMatMul(AlignDims(c.a_dims, dim_count), AlignDims(c.b_dims, dim_count), A.data(), B.data(), &dst_dims);
+        auto dst_shape = MakeShape(dst_dims);
+
+        vector<uint8_t> tmp(matmul_ndarray_fp32_get_buffer_bytes(&a_shape, &b_shape, isa));
+        vector<float> dst(expected.size(), 123.0f);
+        if (pack_b) {
+            const uint64_t packed_bytes = matmul_ndarray_fp32_get_packed_b_bytes(&b_shape, isa);
+            ASSERT_NE(0, packed_bytes);
+            vector<uint8_t> packed_b(packed_bytes);
+            ASSERT_EQ(RC_SUCCESS, matmul_ndarray_fp32_pack_b(&b_shape, B.data(), isa, packed_b.data()));
+            // B is not read any more
+            B.assign(B.size(), 0.0f);
+            ASSERT_EQ(RC_SUCCESS, matmul_ndarray_fp32_with_packed_b(&a_shape, &b_shape, &dst_shape, A.data(),
+                                                                    packed_b.data(), isa, tmp.data(), dst.data()));
+        } else {
+            ASSERT_EQ(RC_SUCCESS, matmul_ndarray_fp32(&a_shape, &b_shape, &dst_shape, A.data(), B.data(), isa,
+                                                      tmp.data(), dst.data()));
+        }
+        ExpectNear(expected, dst, 1e-4f);
+    }
+};
+
+TEST_P(X86MatMulKernelTest, single) {
+    if (!IsSupported()) {
+        return;
+    }
+    const MatMulCase c = {{g_m, g_k}, {g_k, g_n}};
+    Run(c, false);
+    Run(c, true);
+}
+
+TEST_P(X86MatMulKernelTest, broadcast_batches) {
+    if (!IsSupported()) {
+        return;
+    }
+    Run({{2, 1, g_m, g_k}, {3, g_k, g_n}}, false);
+    Run({{2, 3, g_m, g_k}, {2, 1, g_k, g_n}}, false);
+    Run({{4, g_m, g_k}, {4, g_k, g_n}}, false);
+
+    // B with batch is not packed
+    auto b_shape = MakeShape({3, g_k, g_n});
+    EXPECT_EQ(0, matmul_ndarray_fp32_get_packed_b_bytes(&b_shape, GetParam()));
+}
+
+TEST_P(X86MatMulKernelTest, fold_batches_of_a_into_m) {
+    if (!IsSupported()) {
+        return;
+    }
+    for (bool pack_b : {false, true}) {
+        Run({{2, 3, g_m, g_k}, {g_k, g_n}}, pack_b);
+        Run({{2, 3, g_m, g_k}, {1, g_k, g_n}}, pack_b);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Isas, X86MatMulKernelTest,
+                        testing::Values((isa_t)ISA_X86_SSE, (isa_t)(ISA_X86_SSE | ISA_X86_AVX | ISA_X86_FMA),
+                                        (isa_t)(ISA_X86_SSE | ISA_X86_AVX | ISA_X86_FMA | ISA_X86_AVX512)));
+
+#ifdef PPL_USE_X86_AVX512BF16
+// the bf16 executor is only created for gemm_v2 callers asking for bf16 computation, matmul does not
+TEST(X86GemmV2Bf16Test, batched_and_packed_b) {
+    if (!(GetCpuISA() & ISA_X86_AVX512) || !cpu_supports_avx512bf16()) {
+        return;
+    }
+    const int64_t batch = 3;
+    auto A = GenData(batch * g_m * g_k, 1);
+    auto B = GenData(batch * g_k * g_n, 2);
+    vector<int64_t> dst_dims;
+    auto expected = NaiveMatMul({batch, g_m, g_k}, {batch, g_k, g_n}, A.data(), B.data(), &dst_dims);
+    auto expected_shared_b = NaiveMatMul({batch, g_m, g_k}, {1, g_k, g_n}, A.data(), B.data(), &dst_dims);
+
+    vector<int64_t> offsets_a, offsets_b, offsets_y;
+    for (int64_t b = 0; b < batch; ++b) {
+        offsets_a.push_back(b * g_m * g_k);
+        offsets_b.push_back(b * g_k * g_n);
+        offsets_y.push_back(b * g_m * g_n);
+    }
+
+    gemm_v2_param_fp32 param;
+    param.M = g_m;
+    param.N = g_n;
+    param.K = g_k;
+    param.lda = g_k;
+    param.ldb = g_n;
+    param.ldy = g_n;
+    param.isa_flag = GetCpuISA();
+    param.compute_type = DATATYPE_BFLOAT16;
+    param.src_A = A.data();
+    param.src_B = B.data();
+    param.batch = batch;
+    param.batch_offset_A = offsets_a.data();
+    param.batch_offset_B = offsets_b.data();
+    param.batch_offset_Y = offsets_y.data();
+
+    vector<float> dst(expected.size(), 123.0f);
+    param.dst_Y = dst.data();
+    auto executor = unique_ptr<gemm_v2_executor_fp32>(create_gemm_v2_executor_fp32(param));
+    ASSERT_TRUE(executor != nullptr);
+    vector<uint8_t> tmp(executor->get_buffer_bytes());
+    executor->set_temp_buffer(tmp.data());
+    ASSERT_EQ(RC_SUCCESS, executor->execute());
+    ExpectNear(expected, dst, 2e-2f); // inputs are rounded to bf16
+
+    // all batches share the first B after packing
+    vector<uint8_t> packed_b(executor->get_packed_b_bytes());
+    ASSERT_NE(0, packed_b.size());
+    ASSERT_EQ(RC_SUCCESS, executor->pack_b(B.data(), packed_b.data()));
+    dst.assign(expected.size(), 123.0f);
+    executor->get_param_mutable().packed_B = packed_b.data();
+    ASSERT_EQ(RC_SUCCESS, executor->execute());
+    ExpectNear(expected_shared_b, dst, 2e-2f);
+}
+#endif
@@ -0,0 +1,294 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/x86_options.h"
+#include "ppl/nn/engines/x86/runtime_x86_device.h"
+#include "ppl/nn/engines/x86/kernels/onnx/conv2d_kernel.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <map>
+#include <memory>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+
+static MemoryStatistics GetStatistics(const x86::RuntimeX86Device& device) {
+    MemoryStatistics stat;
+    EXPECT_EQ(RC_SUCCESS, device.GetMemoryStatistics(&stat));
+    return stat;
+}
+
+TEST(X86MemoryBudgetTest, device_accounting) {
+    x86::RuntimeX86Device device(64, GetCpuISA(), X86_MM_MRU, nullptr);
+
+    BufferDesc a, b;
+    ASSERT_EQ(RC_SUCCESS, device.Realloc(1024, &a));
+    ASSERT_EQ(RC_SUCCESS, device.Realloc(2048, &b));
+    // growing `a` replaces its old buffer instead of adding to it
+    ASSERT_EQ(RC_SUCCESS, device.Realloc(4096, &a));
+    auto stat = GetStatistics(device);
+    EXPECT_EQ(4096 + 2048, stat.activation_bytes);
+    EXPECT_EQ(4096 + 2048, stat.max_activation_bytes);
+
+    BufferDesc tmp;
+    ASSERT_EQ(RC_SUCCESS, device.AllocTmpBuffer(8192, &tmp));
+    stat = GetStatistics(device);
+    EXPECT_EQ(8192, stat.scratch_bytes);
+    EXPECT_EQ(4096 + 2048 + 8192, stat.total_bytes);
+    device.FreeTmpBuffer(&tmp);
+
+    device.Free(&a);
+    device.Free(&b);
+    stat = GetStatistics(device);
+    EXPECT_EQ(0, stat.activation_bytes);
+    EXPECT_EQ(4096 + 2048, stat.max_activation_bytes);
+    // the shared tmp buffer is cached for the next kernel under X86_MM_MRU
+    EXPECT_EQ(8192, stat.scratch_bytes);
+    EXPECT_EQ(8192, stat.max_scratch_bytes);
+    EXPECT_EQ(4096 + 2048 + 8192, stat.max_total_bytes);
+    EXPECT_EQ(0, stat.budget_exceeded_count);
+}
+
+TEST(X86MemoryBudgetTest, refuse_allocations_over_budget) {
+    x86::RuntimeX86Device device(64, GetCpuISA(), X86_MM_MRU, nullptr);
+    ASSERT_EQ(RC_SUCCESS, device.Configure(X86_DEV_CONF_SET_MEMORY_BUDGET, (uint64_t)16384));
+
+    BufferDesc a, b;
+    ASSERT_EQ(RC_SUCCESS, device.Realloc(8192, &a));
+    EXPECT_EQ(RC_OUT_OF_MEMORY, device.Realloc(16384, &b));
+    EXPECT_EQ(RC_OUT_OF_MEMORY, device.Realloc(32768, &a));
+
+    BufferDesc tmp;
+    EXPECT_EQ(RC_OUT_OF_MEMORY, device.AllocTmpBuffer(16384, &tmp));
+    ASSERT_EQ(RC_SUCCESS, device.AllocTmpBuffer(4096, &tmp));
+    device.FreeTmpBuffer(&tmp);
+
+    // the cached tmp buffer is released to make room for activations
+    ASSERT_EQ(RC_SUCCESS, device.Realloc(8192, &b));
+
+    auto stat = GetStatistics(device);
+    EXPECT_EQ(16384, stat.activation_bytes);
+    EXPECT_EQ(0, stat.scratch_bytes);
+    EXPECT_EQ(3, stat.budget_exceeded_count);
+
+    // 0 means unlimited
+    ASSERT_EQ(RC_SUCCESS, device.Configure(X86_DEV_CONF_SET_MEMORY_BUDGET, (uint64_t)0));
+    EXPECT_EQ(RC_SUCCESS, device.Realloc(32768, &a));
+
+    device.Free(&a);
+    device.Free(&b);
+}
+
+/* -------------------------------------------------------------------------- */
+
+struct FakeConvRecord final {
+    uint32_t execute_count = 0;
+    uint64_t executed_tmp_bytes = 0;
+};
+
+/** needs `tmp_bytes[i]` bytes of temp buffer after `reduce_temp_buffer()` is called i times */
+class FakeConvExecutor final : public conv2d_fp32_executor {
+public:
+    FakeConvExecutor(const conv2d_fp32_param* param, const vector<uint64_t>& tmp_bytes, FakeConvRecord* record)
+        : conv2d_fp32_executor(param, nullptr, nullptr), tmp_bytes_(tmp_bytes), record_(record) {}
+
+    uint64_t cal_temp_buffer_size() override {
+        return tmp_bytes_[level_];
+    }
+    RetCode prepare() override {
+        level_ = 0;
+        return RC_SUCCESS;
+    }
+    RetCode execute() override {
+        if (!temp_buffer_) {
+            return RC_INVALID_VALUE;
+        }
+        ++record_->execute_count;
+        record_->executed_tmp_bytes = tmp_bytes_[level_];
+        return RC_SUCCESS;
+    }
+    bool reduce_temp_buffer() override {
+        if (level_ + 1 >= tmp_bytes_.size()) {
+            return false;
+        }
+        ++level_;
+        return true;
+    }
+
+private:
+    uint32_t level_ = 0;
+    const vector<uint64_t> tmp_bytes_;
+    FakeConvRecord* record_;
+};
+
+class FakeConvManager final : public conv2d_fp32_manager {
+public:
+    FakeConvManager(const conv2d_fp32_param& param, const vector<uint64_t>& tmp_bytes, FakeConvRecord* record)
+        : conv2d_fp32_manager(param, nullptr), tmp_bytes_(tmp_bytes), record_(record) {}
+
+    bool is_supported() override {
+        return true;
+    }
+    RetCode gen_cvt_weights(const float*, const float*) override {
+        return RC_SUCCESS;
+    }
+    conv2d_fp32_executor* gen_executor() override {
+        return new FakeConvExecutor(&param_, tmp_bytes_, record_);
+    }
+
+private:
+    const vector<uint64_t> tmp_bytes_;
+    FakeConvRecord* record_;
+};
+
+class TensorAcquirer final : public KernelExecContext::AcquireObject {
+public:
+    TensorAcquirer(map<edgeid_t, TensorImpl>* tensors) : tensors_(tensors) {}
+    EdgeObject* Acquire(edgeid_t eid, uint32_t) override {
+        auto ref = tensors_->find(eid);
+        return (ref == tensors_->end()) ? nullptr : &ref->second;
+    }
+
+private:
+    map<edgeid_t, TensorImpl>* tensors_;
+};
+
+class X86ConvRetryTest : public testing::Test {
+protected:
+    X86ConvRetryTest() : device_(64, GetCpuISA(), X86_MM_MRU, nullptr) {}
+
+    void SetUp() override {
+        builder_.AddNode("conv", ir::Node::Type("", "Conv", 11), {"x"}, {"y"});
+        builder_.Finalize();
+        auto topo = builder_.GetGraph()->topo.get();
+
+        for (auto name : {"x", "y"}) {
+            auto edge = topo->GetEdgeByName(name);
+            auto ret_pair = tensors_.insert(make_pair(edge->GetId(), TensorImpl(edge, TENSORTYPE_NORMAL)));
+            auto& tensor = ret_pair.first->second;
+            tensor.SetDevice(&device_);
+            auto shape = tensor.GetShape();
+            shape->Reshape({1, 8, 4, 4});
+            shape->SetDataType(DATATYPE_FLOAT32);
+            shape->SetDataFormat(DATAFORMAT_NDARRAY);
+        }
+
+        param_.param.kernel_h = 3;
+        param_.param.kernel_w = 3;
+        param_.param.stride_h = 1;
+        param_.param.stride_w = 1;
+        param_.param.dilation_h = 1;
+        param_.param.dilation_w = 1;
+        param_.param.pad_h = 1;
+        param_.param.pad_w = 1;
+        param_.param.channels = 8;
+        param_.param.num_output = 8;
+        param_.param.group = 1;
+        param_.param.fuse_flag = 0;
+    }
+
+    void TearDown() override {
+        kernel_.reset();
+        tensors_.clear();
+    }
+
+    /** creates a conv whose algorithm needs `tmp_bytes` and whose fallback needs `fallback_tmp_bytes` */
+    void CreateKernel(const vector<uint64_t>& tmp_bytes, const vector<uint64_t>& fallback_tmp_bytes) {
+        param_.mgr = new FakeConvManager(param_.param, tmp_bytes, &record_);
+        param_.fallback_mgr = new FakeConvManager(param_.param, fallback_tmp_bytes, &fallback_record_);
+
+        kernel_.reset(new x86::Conv2dKernel(builder_.GetGraph()->topo->GetNodeByName("conv")));
+        kernel_->SetParam(&param_);
+        kernel_->SetDevice(&device_);
+        kernel_->SetReshapeFunc([](InputOutputInfo* info) -> RetCode {
+            *info->GetOutput<TensorImpl>(0)->GetShape() = *info->GetInput<TensorImpl>(0)->GetShape();
+            return RC_SUCCESS;
+        });
+    }
+
+    RetCode Run() {
+        TensorAcquirer acquirer(&tensors_);
+        KernelExecContext ctx;
+        ctx.SetNode(kernel_->GetNode());
+        ctx.SetAcquireObject(&acquirer);
+        return kernel_->Execute(&ctx);
+    }
+
+    RetCode Execute(const vector<uint64_t>& tmp_bytes, const vector<uint64_t>& fallback_tmp_bytes) {
+        CreateKernel(tmp_bytes, fallback_tmp_bytes);
+        return Run();
+    }
+
+protected:
+    static const uint64_t y_bytes_ = 1 * 8 * 4 * 4 * sizeof(float);
+
+    x86::RuntimeX86Device device_;
+    GraphBuilder builder_;
+    map<edgeid_t, TensorImpl> tensors_;
+    x86::Conv2dParam param_;
+    unique_ptr<x86::Conv2dKernel> kernel_;
+    FakeConvRecord record_;
+    FakeConvRecord fallback_record_;
+};
+
+TEST_F(X86ConvRetryTest, reduce_temp_buffer) {
+    ASSERT_EQ(RC_SUCCESS, device_.Configure(X86_DEV_CONF_SET_MEMORY_BUDGET, y_bytes_ + 32768));
+    ASSERT_EQ(RC_SUCCESS, Execute({65536, 16384}, {4096}));
+
+    EXPECT_EQ(1, record_.execute_count);
+    EXPECT_EQ(16384, record_.executed_tmp_bytes);
+    EXPECT_EQ(0, fallback_record_.execute_count);
+    EXPECT_EQ(1, GetStatistics(device_).budget_exceeded_count);
+}
+
+TEST_F(X86ConvRetryTest, use_fallback_algorithm) {
+    // like winograd, which cannot run with a smaller buffer and falls back to direct
+    ASSERT_EQ(RC_SUCCESS, device_.Configure(X86_DEV_CONF_SET_MEMORY_BUDGET, y_bytes_ + 8192));
+    ASSERT_EQ(RC_SUCCESS, Execute({65536, 16384}, {4096}));
+
+    EXPECT_EQ(0, record_.execute_count);
+    EXPECT_EQ(1, fallback_record_.execute_count);
+    EXPECT_EQ(4096, fallback_record_.executed_tmp_bytes);
+    EXPECT_EQ(2, GetStatistics(device_).budget_exceeded_count);
+}
+
+TEST_F(X86ConvRetryTest, use_fallback_algorithm_only_in_current_run) {
+    ASSERT_EQ(RC_SUCCESS, device_.Configure(X86_DEV_CONF_SET_MEMORY_BUDGET, y_bytes_ + 8192));
+    CreateKernel({65536, 16384}, {4096});
+    ASSERT_EQ(RC_SUCCESS, Run());
+    EXPECT_EQ(0, record_.execute_count);
+    EXPECT_EQ(1, fallback_record_.execute_count);
+
+    // the original algorithm is used again once memory is available
+    ASSERT_EQ(RC_SUCCESS, device_.Configure(X86_DEV_CONF_SET_MEMORY_BUDGET, (uint64_t)0));
+    ASSERT_EQ(RC_SUCCESS, Run());
+    EXPECT_EQ(1, record_.execute_count);
+    EXPECT_EQ(65536, record_.executed_tmp_bytes);
+    EXPECT_EQ(1, fallback_record_.execute_count);
+}
+
+TEST_F(X86ConvRetryTest, fail_when_nothing_fits) {
+    ASSERT_EQ(RC_SUCCESS, device_.Configure(X86_DEV_CONF_SET_MEMORY_BUDGET, y_bytes_ + 1024));
+    EXPECT_EQ(RC_OUT_OF_MEMORY, Execute({65536, 16384}, {4096, 2048}));
+
+    EXPECT_EQ(0, record_.execute_count);
+    EXPECT_EQ(0, fallback_record_.execute_count);
+    EXPECT_EQ(4, GetStatistics(device_).budget_exceeded_count);
+}
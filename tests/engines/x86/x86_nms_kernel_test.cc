@@ -0,0 +1,212 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/nms.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <math.h>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+
+static float NaiveIou(const float* boxes, int64_t i0, int64_t i1, bool centered) {
+    const float* b0 = boxes + i0 * 4;
+    const float* b1 = boxes + i1 * 4;
+    float x_min, x_max, y_min, y_max;
+    float w0, w1, h0, h1;
+    if (centered) { // [x_center, y_center, width, height]
+        w0 = b0[2];
+        w1 = b1[2];
+        h0 = b0[3];
+        h1 = b1[3];
+        x_min = min(b0[0] - w0 / 2, b1[0] - w1 / 2);
+        x_max = max(b0[0] + w0 / 2, b1[0] + w1 / 2);
+        y_min = min(b0[1] - h0 / 2, b1[1] - h1 / 2);
+        y_max = max(b0[1] + h0 / 2, b1[1] + h1 / 2);
+    } else { // [y1, x1, y2, x2]
+        w0 = fabsf(b0[1] - b0[3]);
+        w1 = fabsf(b1[1] - b1[3]);
+        h0 = fabsf(b0[0] - b0[2]);
+        h1 = fabsf(b1[0] - b1[2]);
+        x_min = min(min(b0[1], b0[3]), min(b1[1], b1[3]));
+        x_max = max(max(b0[1], b0[3]), max(b1[1], b1[3]));
+        y_min = min(min(b0[0], b0[2]), min(b1[0], b1[2]));
+        y_max = max(max(b0[0], b0[2]), max(b1[0], b1[2]));
+    }
+    if (w0 + w1 <= x_max - x_min || h0 + h1 <= y_max - y_min) {
+        return 0;
+    }
+    const float iw = w0 + w1 - (x_max - x_min);
+    const float ih = h0 + h1 - (y_max - y_min);
+    const float inter = iw * ih;
+    return inter / (w0 * h0 + w1 * h1 - inter);
+}
+
+// the sort-everything-then-scan implementation the optimized kernels replaced
+static void NaiveNms(const float* boxes, const float* scores, uint32_t num_boxes_in, uint32_t batch,
+                     uint32_t num_classes, bool center_point_box, int64_t max_output_boxes_per_batch_per_class,
+                     float iou_threshold, float score_threshold, vector<int64_t>* dst) {
+    dst->clear();
+    for (int64_t n = 0; n < batch; n++) {
+        const float* p_boxes = boxes + n * num_boxes_in * 4;
+        for (int64_t c = 0; c < num_classes; c++) {
+            const float* p_scores = scores + (n * num_classes + c) * num_boxes_in;
+            vector<uint32_t> sorted_index(num_boxes_in);
+            for (uint32_t i = 0; i < num_boxes_in; ++i) {
+                sorted_index[i] = i;
+            }
+            stable_sort(sorted_index.begin(), sorted_index.end(),
+                        [p_scores](uint32_t a, uint32_t b) { return p_scores[a] > p_scores[b]; });
+
+            vector<uint32_t> selected_index;
+            for (uint32_t i = 0; i < num_boxes_in; i++) {
+                if ((int64_t)selected_index.size() >= max_output_boxes_per_batch_per_class) {
+                    break;
+                }
+                const uint32_t idx = sorted_index[i];
+                if (p_scores[idx] <= score_threshold) {
+                    break;
+                }
+                bool keep = true;
+                for (size_t j = 0; j < selected_index.size() && keep; j++) {
+                    keep = NaiveIou(p_boxes, idx, selected_index[j], center_point_box) <= iou_threshold;
+                }
+                if (keep) {
+                    selected_index.push_back(idx);
+                }
+            }
+            for (auto idx : selected_index) {
+                dst->insert(dst->end(), {n, c, (int64_t)idx});
+            }
+        }
+    }
+}
+
+typedef RetCode (*nms_func_t)(const float*, const float*, const uint32_t, const uint32_t, const uint32_t, const bool,
+                              const int64_t, const float, const float, int64_t*, int64_t*);
+
+class X86NmsKernelTest : public testing::Test {
+protected:
+    void SetUp() override {
+        nms_funcs_.push_back(nms_ndarray_fp32);
+        if (GetCpuISA() & ISA_X86_FMA) {
+            nms_funcs_.push_back(nms_ndarray_fp32_fma);
+        }
+#ifdef PPL_USE_X86_AVX512
+        if (GetCpuISA() & ISA_X86_AVX512) {
+            nms_funcs_.push_back(nms_ndarray_fp32_avx512);
+        }
+#endif
+    }
+
+    void ExpectSameAsNaive(const vector<float>& boxes, const vector<float>& scores, uint32_t num_boxes_in,
+                           uint32_t batch, uint32_t num_classes, bool center_point_box, int64_t max_output,
+                           float iou_threshold, float score_threshold) const {
+        vector<int64_t> expected;
+        NaiveNms(boxes.data(), scores.data(), num_boxes_in, batch, num_classes, center_point_box, max_output,
+                 iou_threshold, score_threshold, &expected);
+
+        for (size_t i = 0; i < nms_funcs_.size(); ++i) {
+            SCOPED_TRACE("nms func " + to_string(i));
+            vector<int64_t> dst(batch * num_classes * num_boxes_in * 3, -1);
+            int64_t num_boxes_out = -1;
+            ASSERT_EQ(RC_SUCCESS,
+                      nms_funcs_[i](boxes.data(), scores.data(), num_boxes_in, batch, num_classes, center_point_box,
+                                    max_output, iou_threshold, score_threshold, dst.data(), &num_boxes_out));
+            ASSERT_EQ((int64_t)expected.size() / 3, num_boxes_out);
+            dst.resize(num_boxes_out * 3);
+            EXPECT_EQ(expected, dst);
+        }
+    }
+
+protected:
+    vector<nms_func_t> nms_funcs_;
+};
+
+TEST_F(X86NmsKernelTest, iou_at_threshold) {
+    // iou of box 0 and box 1 is exactly 0.5, box 2 is inside of box 0 with iou 0.25
+    const vector<float> boxes = {
+        0.0f, 0.0f, 2.0f, 2.0f, // [y1, x1, y2, x2]
+        0.0f, 0.0f, 2.0f, 1.0f, //
+        1.0f, 1.0f, 2.0f, 2.0f, //
+    };
+    const vector<float> scores = {0.9f, 0.8f, 0.7f};
+    ExpectSameAsNaive(boxes, scores, 3, 1, 1, false, 3, 0.5f, 0.0f); // boxes are kept if iou equals to threshold
+    ExpectSameAsNaive(boxes, scores, 3, 1, 1, false, 3, 0.25f, 0.0f);
+    ExpectSameAsNaive(boxes, scores, 3, 1, 1, false, 3, 0.2f, 0.0f);
+
+    // same boxes in [x_center, y_center, width, height]
+    const vector<float> center_boxes = {
+        1.0f, 1.0f, 2.0f, 2.0f, //
+        0.5f, 1.0f, 1.0f, 2.0f, //
+        1.5f, 1.5f, 1.0f, 1.0f, //
+    };
+    ExpectSameAsNaive(center_boxes, scores, 3, 1, 1, true, 3, 0.5f, 0.0f);
+    ExpectSameAsNaive(center_boxes, scores, 3, 1, 1, true, 3, 0.25f, 0.0f);
+
+    vector<int64_t> dst(9);
+    int64_t num_boxes_out = 0;
+    ASSERT_EQ(RC_SUCCESS, nms_ndarray_fp32(boxes.data(), scores.data(), 3, 1, 1, false, 3, 0.5f, 0.0f, dst.data(),
+                                           &num_boxes_out));
+    EXPECT_EQ(3, num_boxes_out);
+}
+
+TEST_F(X86NmsKernelTest, random_boxes) {
+    // coordinates on a grid of 0.5 keep iou exact in both implementations, so that many of them hit the threshold
+    const uint32_t num_boxes_in = 67, batch = 2, num_classes = 3;
+    vector<float> boxes(batch * num_boxes_in * 4);
+    vector<float> center_boxes(boxes.size());
+    for (uint32_t i = 0; i < batch * num_boxes_in; ++i) {
+        const float x1 = (float)(i * 7 % 11) * 0.5f;
+        const float y1 = (float)(i * 5 % 13) * 0.5f;
+        const float w = (float)(1 + i * 3 % 8) * 0.5f;
+        const float h = (float)(1 + i * 11 % 6) * 0.5f;
+        // corners in either order
+        const float box[4] = {y1, x1, y1 + h, x1 + w};
+        const bool flip = i % 3 == 0;
+        boxes[i * 4 + 0] = flip ? box[2] : box[0];
+        boxes[i * 4 + 1] = flip ? box[3] : box[1];
+        boxes[i * 4 + 2] = flip ? box[0] : box[2];
+        boxes[i * 4 + 3] = flip ? box[1] : box[3];
+        center_boxes[i * 4 + 0] = x1 + w / 2;
+        center_boxes[i * 4 + 1] = y1 + h / 2;
+        center_boxes[i * 4 + 2] = w;
+        center_boxes[i * 4 + 3] = h;
+    }
+    // only a few distinct scores, so that most boxes tie with others
+    vector<float> scores(batch * num_classes * num_boxes_in);
+    for (uint32_t i = 0; i < scores.size(); ++i) {
+        scores[i] = (float)(i * 13 % 5) * 0.25f;
+    }
+
+    for (bool center_point_box : {false, true}) {
+        auto& p_boxes = center_point_box ? center_boxes : boxes;
+        for (int64_t max_output : {0, 1, 4, 1000}) {
+            for (float iou_threshold : {0.0f, 0.25f, 0.5f, 1.0f}) {
+                for (float score_threshold : {-1.0f, 0.25f}) {
+                    SCOPED_TRACE("center_point_box " + to_string(center_point_box) + ", max_output " +
+                                 to_string(max_output) + ", iou_threshold " + to_string(iou_threshold) +
+                                 ", score_threshold " + to_string(score_threshold));
+                    ExpectSameAsNaive(p_boxes, scores, num_boxes_in, batch, num_classes, center_point_box,
+                                      max_output, iou_threshold, score_threshold);
+                }
+            }
+        }
+    }
+}
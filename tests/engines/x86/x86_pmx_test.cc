@@ -0,0 +1,196 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#if defined(PPLNN_ENABLE_PMX_MODEL) && defined(PPLNN_ENABLE_ONNX_MODEL)
+
+#include "ppl/nn/engines/x86/engine_factory.h"
+#include "ppl/nn/models/onnx/onnx_runtime_builder_factory.h"
+#include "ppl/nn/models/pmx/pmx_runtime_builder_factory.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::common;
+
+class X86PmxTest : public testing::Test {
+protected:
+    void SetUp() override {
+        // input -> conv -> conv_out, gemm_input -> gemm -> gemm_out
+        onnx_file_ = PPLNN_TESTDATA_DIR + string("/conv_gemm.onnx");
+        input_dims_ = {{"input", {1, 3, 4, 4}}, {"gemm_input", {2, 32}}};
+        pmx_file_ = "x86_pmx_test.pmx";
+    }
+
+    void TearDown() override {
+        remove(pmx_file_.c_str());
+    }
+
+    /** runs `runtime` and collects outputs and algorithms of all kernels */
+    void RunModel(Runtime* runtime, vector<vector<float>>* outputs, map<string, string>* algorithms) const {
+        ASSERT_EQ(RC_SUCCESS, runtime->Configure(RUNTIME_CONF_SET_KERNEL_PROFILING_FLAG, true));
+
+        ASSERT_EQ(input_dims_.size(), runtime->GetInputCount());
+        for (uint32_t i = 0; i < runtime->GetInputCount(); ++i) {
+            auto input = runtime->GetInputTensor(i);
+            auto dims_ref = input_dims_.find(input->GetName());
+            ASSERT_TRUE(dims_ref != input_dims_.end());
+            input->GetShape()->Reshape(dims_ref->second);
+            ASSERT_EQ(RC_SUCCESS, input->ReallocBuffer());
+
+            vector<float> input_data(input->GetShape()->GetElementsIncludingPadding());
+            for (uint32_t j = 0; j < input_data.size(); ++j) {
+                input_data[j] = (float)(j % 7) - 3.0f;
+            }
+            TensorShape src_desc = *input->GetShape();
+            src_desc.SetDataType(DATATYPE_FLOAT32);
+            src_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+            ASSERT_EQ(RC_SUCCESS, input->ConvertFromHost(input_data.data(), src_desc));
+        }
+
+        ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+        outputs->resize(runtime->GetOutputCount());
+        for (uint32_t i = 0; i < runtime->GetOutputCount(); ++i) {
+            auto output = runtime->GetOutputTensor(i);
+            TensorShape dst_desc = *output->GetShape();
+            dst_desc.SetDataType(DATATYPE_FLOAT32);
+            dst_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+            outputs->at(i).resize(dst_desc.GetElementsIncludingPadding());
+            ASSERT_EQ(RC_SUCCESS, output->ConvertToHost(outputs->at(i).data(), dst_desc));
+        }
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+        ProfilingStatistics stat;
+        ASSERT_EQ(RC_SUCCESS, runtime->GetProfilingStatistics(&stat));
+        for (auto it = stat.prof_info.begin(); it != stat.prof_info.end(); ++it) {
+            algorithms->insert(make_pair(it->name, it->algorithm));
+        }
+#endif
+    }
+
+    /** converts the onnx model to the pmx model and runs the onnx model */
+    void RunOnnxModel(vector<vector<float>>* outputs, map<string, string>* algorithms) {
+        auto engine = unique_ptr<Engine>(X86EngineFactory::Create(X86EngineOptions()));
+        auto builder = unique_ptr<OnnxRuntimeBuilder>(OnnxRuntimeBuilderFactory::Create());
+        auto ep = engine.get();
+        ASSERT_EQ(RC_SUCCESS, builder->Init(onnx_file_.c_str(), &ep, 1));
+        ASSERT_EQ(RC_SUCCESS, builder->Preprocess());
+        ASSERT_EQ(RC_SUCCESS, builder->Serialize(pmx_file_.c_str(), "pmx"));
+
+        auto runtime = unique_ptr<Runtime>(builder->CreateRuntime());
+        ASSERT_TRUE(runtime != nullptr);
+        RunModel(runtime.get(), outputs, algorithms);
+    }
+
+    /** loads the pmx model by reading or mapping the file and runs it */
+    void RunPmxModel(bool use_mmap, vector<vector<float>>* outputs, map<string, string>* algorithms) {
+        auto engine = unique_ptr<Engine>(X86EngineFactory::Create(X86EngineOptions()));
+        auto builder = unique_ptr<PmxRuntimeBuilder>(PmxRuntimeBuilderFactory::Create());
+        ASSERT_EQ(RC_SUCCESS, builder->Configure(PMX_RB_CONF_SET_MMAP_FLAG, use_mmap));
+        auto ep = engine.get();
+        ASSERT_EQ(RC_SUCCESS, builder->Init(pmx_file_.c_str(), &ep, 1));
+
+        auto runtime = unique_ptr<Runtime>(builder->CreateRuntime());
+        ASSERT_TRUE(runtime != nullptr);
+        RunModel(runtime.get(), outputs, algorithms);
+    }
+
+protected:
+    string onnx_file_;
+    map<string, vector<int64_t>> input_dims_;
+    string pmx_file_;
+};
+
+TEST_F(X86PmxTest, conv_gemm_round_trip) {
+    vector<vector<float>> onnx_outputs;
+    map<string, string> onnx_algorithms;
+    RunOnnxModel(&onnx_outputs, &onnx_algorithms);
+
+    // algorithms and converted weights are loaded from the pmx model instead of being selected and converted again
+    vector<vector<float>> pmx_outputs;
+    map<string, string> pmx_algorithms;
+    RunPmxModel(false, &pmx_outputs, &pmx_algorithms);
+
+    ASSERT_EQ(2, onnx_outputs.size());
+    EXPECT_EQ(onnx_outputs, pmx_outputs);
+    EXPECT_EQ(onnx_algorithms, pmx_algorithms);
+}
+
+TEST_F(X86PmxTest, mixed_ops_round_trip) {
+    // conv -> max_pool/average_pool -> add -> relu -> matmul -> relu -> global_average_pool
+    onnx_file_ = PPLNN_TESTDATA_DIR + string("/conv_pool_add_matmul.onnx");
+    input_dims_ = {{"input", {1, 16, 8, 8}}};
+
+    vector<vector<float>> onnx_outputs;
+    map<string, string> onnx_algorithms;
+    RunOnnxModel(&onnx_outputs, &onnx_algorithms);
+
+    // ops without params are restored from their output formats and fused states, e.g. relu fused into add
+    vector<vector<float>> pmx_outputs;
+    map<string, string> pmx_algorithms;
+    RunPmxModel(false, &pmx_outputs, &pmx_algorithms);
+
+    ASSERT_EQ(2, onnx_outputs.size());
+    EXPECT_EQ(onnx_outputs, pmx_outputs);
+    EXPECT_EQ(onnx_algorithms, pmx_algorithms);
+}
+
+TEST_F(X86PmxTest, matmul_packed_b_round_trip) {
+    // constant b of matmul is packed and omitted from constants, so the packed data is restored instead
+    onnx_file_ = PPLNN_TESTDATA_DIR + string("/matmul_const_b.onnx");
+    input_dims_ = {{"input", {2, 3, 5, 40}}};
+
+    vector<vector<float>> onnx_outputs;
+    map<string, string> onnx_algorithms;
+    RunOnnxModel(&onnx_outputs, &onnx_algorithms);
+
+    vector<vector<float>> pmx_outputs;
+    map<string, string> pmx_algorithms;
+    RunPmxModel(false, &pmx_outputs, &pmx_algorithms);
+
+    ASSERT_EQ(1, onnx_outputs.size());
+    EXPECT_EQ(onnx_outputs, pmx_outputs);
+}
+
+TEST_F(X86PmxTest, mmap_matches_read) {
+    {
+        auto engine = unique_ptr<Engine>(X86EngineFactory::Create(X86EngineOptions()));
+        auto builder = unique_ptr<OnnxRuntimeBuilder>(OnnxRuntimeBuilderFactory::Create());
+        auto ep = engine.get();
+        ASSERT_EQ(RC_SUCCESS, builder->Init(onnx_file_.c_str(), &ep, 1));
+        ASSERT_EQ(RC_SUCCESS, builder->Preprocess());
+        ASSERT_EQ(RC_SUCCESS, builder->Serialize(pmx_file_.c_str(), "pmx"));
+    }
+
+    vector<vector<float>> read_outputs;
+    map<string, string> read_algorithms;
+    RunPmxModel(false, &read_outputs, &read_algorithms);
+
+    // constants are used in the mapped file directly
+    vector<vector<float>> mmap_outputs;
+    map<string, string> mmap_algorithms;
+    RunPmxModel(true, &mmap_outputs, &mmap_algorithms);
+
+    ASSERT_EQ(2, read_outputs.size());
+    EXPECT_EQ(read_outputs, mmap_outputs);
+    EXPECT_EQ(read_algorithms, mmap_algorithms);
+}
+
+#endif
@@ -0,0 +1,250 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/gru.h"
+#include "ppl/kernel/x86/fp32/rnn.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+
+static const int64_t g_seq_len = 5;
+static const int64_t g_batch = 3;
+static const int64_t g_input_size = 6;
+static const int64_t g_hidden_size = 11; // not a multiple of simd width
+
+static vector<float> GenData(uint64_t count, uint32_t seed) {
+    vector<float> data(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        data[i] = (float)((i * 7919 + seed * 104729) % 23) / 23.0f - 0.5f;
+    }
+    return data;
+}
+
+static float Sigmoid(float x) {
+    return 1.0f / (1.0f + expf(-x));
+}
+
+// dst[h] = sum_k m[h][k] * v[k]
+static void MatVec(const float* m, const float* v, int64_t rows, int64_t cols, float* dst) {
+    for (int64_t h = 0; h < rows; ++h) {
+        float sum = 0.0f;
+        for (int64_t k = 0; k < cols; ++k) {
+            sum += m[h * cols + k] * v[k];
+        }
+        dst[h] = sum;
+    }
+}
+
+struct RnnData final {
+    RnnData(int64_t num_gate, int64_t num_direction) {
+        X = GenData(g_seq_len * g_batch * g_input_size, 1);
+        W = GenData(num_direction * num_gate * g_hidden_size * g_input_size, 2);
+        R = GenData(num_direction * num_gate * g_hidden_size * g_hidden_size, 3);
+        B = GenData(num_direction * 2 * num_gate * g_hidden_size, 4);
+        initial_h = GenData(num_direction * g_batch * g_hidden_size, 5);
+    }
+    vector<float> X, W, R, B, initial_h;
+};
+
+/*
+  naive implementation of the onnx spec: the i-th step of a reversed sequence is sequence_lens[b] - 1 - i, and Y is
+  zero past sequence_lens[b]. `step_func(d, x, h)` updates h of direction d with input x.
+*/
+template <typename StepFunc>
+static void RunReference(const RnnData& data, const int32_t* sequence_lens, rnn_direction_t direction,
+                         const StepFunc& step_func, vector<float>* Y, vector<float>* Y_h) {
+    const int64_t num_direction = (direction == rnn_direction::BIDIRECTIONAL) ? 2 : 1;
+    Y->assign(g_seq_len * num_direction * g_batch * g_hidden_size, 0.0f);
+    Y_h->resize(num_direction * g_batch * g_hidden_size);
+
+    for (int64_t d = 0; d < num_direction; ++d) {
+        const bool is_reverse = (d == 1 || direction == rnn_direction::REVERSE);
+        for (int64_t b = 0; b < g_batch; ++b) {
+            const int64_t len = sequence_lens ? sequence_lens[b] : g_seq_len;
+            vector<float> h(data.initial_h.begin() + (d * g_batch + b) * g_hidden_size,
+                            data.initial_h.begin() + (d * g_batch + b + 1) * g_hidden_size);
+            for (int64_t i = 0; i < len; ++i) {
+                const int64_t t = is_reverse ? (len - 1 - i) : i;
+                step_func(d, data.X.data() + (t * g_batch + b) * g_input_size, &h);
+                for (int64_t j = 0; j < g_hidden_size; ++j) {
+                    Y->at(((t * num_direction + d) * g_batch + b) * g_hidden_size + j) = h[j];
+                }
+            }
+            for (int64_t j = 0; j < g_hidden_size; ++j) {
+                Y_h->at((d * g_batch + b) * g_hidden_size + j) = h[j];
+            }
+        }
+    }
+}
+
+static void RunRnnReference(const RnnData& data, const int32_t* sequence_lens, rnn_direction_t direction,
+                            vector<float>* Y, vector<float>* Y_h) {
+    auto step_func = [&data](int64_t d, const float* x, vector<float>* h) -> void {
+        const int64_t H = g_hidden_size;
+        vector<float> wx(H), rh(H);
+        MatVec(data.W.data() + d * H * g_input_size, x, H, g_input_size, wx.data());
+        MatVec(data.R.data() + d * H * H, h->data(), H, H, rh.data());
+        const float* wb = data.B.data() + d * 2 * H;
+        const float* rb = wb + H;
+        for (int64_t j = 0; j < H; ++j) {
+            h->at(j) = tanhf(wx[j] + wb[j] + rh[j] + rb[j]);
+        }
+    };
+    RunReference(data, sequence_lens, direction, step_func, Y, Y_h);
+}
+
+static void RunGruReference(const RnnData& data, const int32_t* sequence_lens, rnn_direction_t direction,
+                            bool linear_before_reset, vector<float>* Y, vector<float>* Y_h) {
+    auto step_func = [&data, linear_before_reset](int64_t d, const float* x, vector<float>* h) -> void {
+        const int64_t H = g_hidden_size;
+        const float* W = data.W.data() + d * 3 * H * g_input_size;
+        const float* R = data.R.data() + d * 3 * H * H;
+        const float* wb = data.B.data() + d * 6 * H;
+        const float* rb = wb + 3 * H;
+
+        vector<float> wx(3 * H), rh(3 * H);
+        MatVec(W, x, 3 * H, g_input_size, wx.data());
+        MatVec(R, h->data(), 3 * H, H, rh.data());
+
+        vector<float> z(H), r(H), r_h(H), rh_h(H);
+        for (int64_t j = 0; j < H; ++j) {
+            z[j] = Sigmoid(wx[j] + wb[j] + rh[j] + rb[j]);
+            r[j] = Sigmoid(wx[H + j] + wb[H + j] + rh[H + j] + rb[H + j]);
+            r_h[j] = r[j] * h->at(j);
+        }
+        MatVec(R + 2 * H * H, r_h.data(), H, H, rh_h.data());
+        for (int64_t j = 0; j < H; ++j) {
+            const float xh = wx[2 * H + j] + wb[2 * H + j];
+            float hh;
+            if (linear_before_reset) {
+                hh = tanhf(xh + r[j] * (rh[2 * H + j] + rb[2 * H + j]));
+            } else {
+                hh = tanhf(xh + rh_h[j] + rb[2 * H + j]);
+            }
+            h->at(j) = (1.0f - z[j]) * hh + z[j] * h->at(j);
+        }
+    };
+    RunReference(data, sequence_lens, direction, step_func, Y, Y_h);
+}
+
+static void ExpectNear(const vector<float>& expected, const vector<float>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (uint64_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(expected[i], actual[i], 1e-4f) << "at " << i;
+    }
+}
+
+class X86RnnKernelTest : public testing::TestWithParam<rnn_direction_t> {
+protected:
+    static bool HasFma() {
+        return (GetCpuISA() & ISA_X86_FMA) != 0;
+    }
+
+    int64_t NumDirection() const {
+        return (GetParam() == rnn_direction::BIDIRECTIONAL) ? 2 : 1;
+    }
+
+    ppl::nn::TensorShape XShape() const {
+        ppl::nn::TensorShape shape;
+        shape.Reshape({g_seq_len, g_batch, g_input_size});
+        shape.SetDataType(DATATYPE_FLOAT32);
+        return shape;
+    }
+
+    // Y is filled with garbage to check that padded steps are zeroed
+    void ResetOutputs(vector<float>* Y, vector<float>* Y_h) const {
+        Y->assign(g_seq_len * NumDirection() * g_batch * g_hidden_size, 123.0f);
+        Y_h->assign(NumDirection() * g_batch * g_hidden_size, 123.0f);
+    }
+
+protected:
+    // the second sequence is shorter than the third so that padded steps are not at the same position
+    const vector<int32_t> ragged_lens_ = {g_seq_len, 2, 3};
+};
+
+TEST_P(X86RnnKernelTest, rnn) {
+    const rnn_direction_t direction = GetParam();
+    RnnData data(rnn_num_gate::RNN, NumDirection());
+    auto X_shape = XShape();
+
+    for (const int32_t* sequence_lens : {(const int32_t*)nullptr, ragged_lens_.data()}) {
+        vector<float> ref_Y, ref_Y_h;
+        RunRnnReference(data, sequence_lens, direction, &ref_Y, &ref_Y_h);
+
+        vector<float> Y, Y_h;
+        vector<uint8_t> tmp(rnn_ref_fp32_get_buffer_bytes(&X_shape, direction, g_hidden_size, true, true));
+        ResetOutputs(&Y, &Y_h);
+        ASSERT_EQ(RC_SUCCESS,
+                  rnn_ref_fp32(&X_shape, data.X.data(), data.W.data(), data.R.data(), data.B.data(), sequence_lens,
+                               data.initial_h.data(), direction, g_hidden_size, tmp.data(), Y.data(), Y_h.data()));
+        ExpectNear(ref_Y, Y);
+        ExpectNear(ref_Y_h, Y_h);
+
+        if (HasFma()) {
+            tmp.resize(rnn_fp32_fma_get_buffer_bytes(&X_shape, direction, g_hidden_size, true, true));
+            ResetOutputs(&Y, &Y_h);
+            ASSERT_EQ(RC_SUCCESS,
+                      rnn_fp32_fma(&X_shape, data.X.data(), data.W.data(), data.R.data(), data.B.data(), sequence_lens,
+                                   data.initial_h.data(), direction, g_hidden_size, tmp.data(), Y.data(), Y_h.data()));
+            ExpectNear(ref_Y, Y);
+            ExpectNear(ref_Y_h, Y_h);
+        }
+    }
+}
+
+TEST_P(X86RnnKernelTest, gru) {
+    const rnn_direction_t direction = GetParam();
+    RnnData data(rnn_num_gate::GRU, NumDirection());
+    auto X_shape = XShape();
+
+    for (const int32_t* sequence_lens : {(const int32_t*)nullptr, ragged_lens_.data()}) {
+        for (bool linear_before_reset : {false, true}) {
+            vector<float> ref_Y, ref_Y_h;
+            RunGruReference(data, sequence_lens, direction, linear_before_reset, &ref_Y, &ref_Y_h);
+
+            vector<float> Y, Y_h;
+            vector<uint8_t> tmp(gru_ref_fp32_get_buffer_bytes(&X_shape, direction, g_hidden_size, true, true));
+            ResetOutputs(&Y, &Y_h);
+            ASSERT_EQ(RC_SUCCESS,
+                      gru_ref_fp32(&X_shape, data.X.data(), data.W.data(), data.R.data(), data.B.data(),
+                                   sequence_lens, data.initial_h.data(), direction, g_hidden_size,
+                                   linear_before_reset, tmp.data(), Y.data(), Y_h.data()));
+            ExpectNear(ref_Y, Y);
+            ExpectNear(ref_Y_h, Y_h);
+
+            if (HasFma()) {
+                tmp.resize(gru_fp32_fma_get_buffer_bytes(&X_shape, direction, g_hidden_size, true, true));
+                ResetOutputs(&Y, &Y_h);
+                ASSERT_EQ(RC_SUCCESS,
+                          gru_fp32_fma(&X_shape, data.X.data(), data.W.data(), data.R.data(), data.B.data(),
+                                       sequence_lens, data.initial_h.data(), direction, g_hidden_size,
+                                       linear_before_reset, tmp.data(), Y.data(), Y_h.data()));
+                ExpectNear(ref_Y, Y);
+                ExpectNear(ref_Y_h, Y_h);
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Directions, X86RnnKernelTest,
+                        testing::Values((rnn_direction_t)rnn_direction::FORWARD,
+                                        (rnn_direction_t)rnn_direction::REVERSE,
+                                        (rnn_direction_t)rnn_direction::BIDIRECTIONAL));
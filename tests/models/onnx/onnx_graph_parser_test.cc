@@ -48,6 +48,6 @@ TEST_F(GraphParserTest, Parse_Test) {
     ppl::nn::onnx::GraphParser graph_parser;
     ppl::nn::ir::Graph graph;
     map<string, uint64_t> op_sets = {{"", 11}};
-    auto status = graph_parser.Parse(pb_model.graph(), op_sets, &graph);
+    auto status = graph_parser.Parse(pb_model.graph(), op_sets, nullptr, &graph);
     EXPECT_EQ(status, ppl::common::RC_SUCCESS);
 }
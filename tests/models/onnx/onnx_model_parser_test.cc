@@ -17,7 +17,9 @@
 
 #include "ppl/nn/models/onnx/model_parser.h"
 #include "ppl/common/file_mapping.h"
+#include "ppl/nn/models/onnx/generated/onnx.pb.h"
 #include "gtest/gtest.h"
+#include <fstream>
 #include <string>
 using namespace std;
 using namespace ppl::nn;
@@ -30,6 +32,92 @@ TEST_F(ModelParserTest, TestModelParser) {
     const string onnx_file = PPLNN_TESTDATA_DIR + string("/conv.onnx");
     FileMapping fm;
     EXPECT_EQ(RC_SUCCESS, fm.Init(onnx_file.c_str()));
-    auto res = onnx::ModelParser::Parse(fm.Data(), fm.Size(), &graph);
+    auto res = ppl::nn::onnx::ModelParser::Parse(fm.Data(), fm.Size(), &graph);
     EXPECT_EQ(RC_SUCCESS, res);
 }
+
+static void AddExternalData(::onnx::TensorProto* pb_tensor, const string& key, const string& value) {
+    auto entry = pb_tensor->add_external_data();
+    entry->set_key(key);
+    entry->set_value(value);
+}
+
+TEST_F(ModelParserTest, TestExternalData) {
+    const string dir = testing::TempDir();
+    const string data_file = "external_data_test.bin";
+    const string model_file = dir + "/external_data_test.onnx";
+
+    const float values[] = {1, 2, 3, 4, 5, 6};
+    const uint64_t offset = 16;
+    {
+        ofstream ofs(dir + "/" + data_file, ios_base::binary);
+        ofs << string(offset, '\0');
+        ofs.write((const char*)values, sizeof(values));
+    }
+
+    ::onnx::ModelProto pb_model;
+    pb_model.add_opset_import()->set_version(11);
+    auto pb_graph = pb_model.mutable_graph();
+    auto pb_initializer = pb_graph->add_initializer();
+    pb_initializer->set_name("weight");
+    pb_initializer->set_data_type(::onnx::TensorProto_DataType_FLOAT);
+    pb_initializer->add_dims(2);
+    pb_initializer->add_dims(3);
+    pb_initializer->set_data_location(::onnx::TensorProto_DataLocation_EXTERNAL);
+    AddExternalData(pb_initializer, "location", data_file);
+    AddExternalData(pb_initializer, "offset", std::to_string(offset));
+    AddExternalData(pb_initializer, "length", std::to_string(sizeof(values)));
+    pb_graph->add_output()->set_name("weight");
+
+    // in the same file as `weight`
+    auto pb_shared_initializer = pb_graph->add_initializer();
+    pb_shared_initializer->set_name("scale");
+    pb_shared_initializer->set_data_type(::onnx::TensorProto_DataType_FLOAT);
+    pb_shared_initializer->add_dims(4);
+    pb_shared_initializer->set_data_location(::onnx::TensorProto_DataLocation_EXTERNAL);
+    AddExternalData(pb_shared_initializer, "location", data_file);
+    AddExternalData(pb_shared_initializer, "offset", std::to_string(offset + 2 * sizeof(float)));
+    AddExternalData(pb_shared_initializer, "length", std::to_string(4 * sizeof(float)));
+    pb_graph->add_output()->set_name("scale");
+
+    auto pb_inline_initializer = pb_graph->add_initializer();
+    pb_inline_initializer->set_name("bias");
+    pb_inline_initializer->set_data_type(::onnx::TensorProto_DataType_FLOAT);
+    pb_inline_initializer->add_dims(2);
+    pb_inline_initializer->set_raw_data(string((const char*)values, 2 * sizeof(float)));
+    pb_graph->add_output()->set_name("bias");
+    {
+        ofstream ofs(model_file, ios_base::binary);
+        EXPECT_TRUE(pb_model.SerializeToOstream(&ofs));
+    }
+
+    ir::Graph graph;
+    EXPECT_EQ(RC_SUCCESS, ppl::nn::onnx::ModelParser::Parse(model_file.c_str(), &graph));
+    auto edge = graph.topo->GetEdgeByName("weight");
+    EXPECT_NE(nullptr, edge);
+    auto constant_ref = graph.data->constants.find(edge->GetId());
+    EXPECT_NE(graph.data->constants.end(), constant_ref);
+    EXPECT_EQ(string((const char*)values, sizeof(values)), constant_ref->second.data);
+    auto shared_edge = graph.topo->GetEdgeByName("scale");
+    EXPECT_NE(nullptr, shared_edge);
+    EXPECT_EQ(string((const char*)(values + 2), 4 * sizeof(float)), graph.data->constants[shared_edge->GetId()].data);
+    auto inline_edge = graph.topo->GetEdgeByName("bias");
+    EXPECT_NE(nullptr, inline_edge);
+    EXPECT_EQ(string((const char*)values, 2 * sizeof(float)), graph.data->constants[inline_edge->GetId()].data);
+
+    // length which does not match the shape
+    pb_initializer->mutable_external_data(2)->set_value(std::to_string(sizeof(values) - sizeof(float)));
+    string buf;
+    EXPECT_TRUE(pb_model.SerializeToString(&buf));
+    ir::Graph bad_graph;
+    EXPECT_NE(RC_SUCCESS, ppl::nn::onnx::ModelParser::Parse(buf.data(), buf.size(), &bad_graph, dir.c_str()));
+
+    // locations going up from the directory of the model are rejected even if they lead to the right file
+    string dir_name = dir.substr(0, dir.find_last_not_of('/') + 1);
+    dir_name = dir_name.substr(dir_name.find_last_of('/') + 1);
+    pb_initializer->mutable_external_data(2)->set_value(std::to_string(sizeof(values)));
+    pb_initializer->mutable_external_data(0)->set_value("../" + dir_name + "/" + data_file);
+    EXPECT_TRUE(pb_model.SerializeToString(&buf));
+    ir::Graph parent_dir_graph;
+    EXPECT_NE(RC_SUCCESS, ppl::nn::onnx::ModelParser::Parse(buf.data(), buf.size(), &parent_dir_graph, dir.c_str()));
+}
@@ -0,0 +1,251 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "gtest/gtest.h"
+#include "tests/ir/graph_builder.h"
+#include "tests/engines/tmp_engine_context.h"
+#include "ppl/nn/optimizers/constant_folding.h"
+#include "ppl/nn/optimizers/engine_graph_partitioner.h"
+#include "ppl/nn/engines/engine_impl.h"
+#include "ppl/nn/runtime/opt_kernel.h"
+#include "ppl/nn/runtime/runtime_partition_info.h"
+#include "ppl/nn/runtime/kernel_impl.h"
+#include "ppl/nn/runtime/tensor_impl.h"
+#include <memory>
+#include <string.h>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+namespace {
+
+class AddOneKernel final : public KernelImpl {
+public:
+    AddOneKernel(const ir::Node* node) : KernelImpl(node) {}
+    RetCode Execute(KernelExecContext* ctx) override {
+        auto input = ctx->GetInput<TensorImpl>(0);
+        auto output = ctx->GetOutput<TensorImpl>(0);
+        *output->GetShape() = *input->GetShape();
+        auto status = output->ReallocBuffer();
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+
+        auto src = input->GetBufferPtr<float>();
+        auto dst = output->GetBufferPtr<float>();
+        for (uint32_t i = 0; i < input->GetShape()->GetElementsIncludingPadding(); ++i) {
+            dst[i] = src[i] + 1;
+        }
+        return RC_SUCCESS;
+    }
+};
+
+// repeats the input `kRepeatCount` times
+class RepeatKernel final : public KernelImpl {
+public:
+    static const uint32_t kRepeatCount = 256 * 1024;
+
+    RepeatKernel(const ir::Node* node) : KernelImpl(node) {}
+    RetCode Execute(KernelExecContext* ctx) override {
+        auto input = ctx->GetInput<TensorImpl>(0);
+        auto output = ctx->GetOutput<TensorImpl>(0);
+        const uint64_t count = input->GetShape()->GetElementsIncludingPadding();
+        *output->GetShape() = *input->GetShape();
+        output->GetShape()->Reshape({(int64_t)(count * kRepeatCount)});
+        auto status = output->ReallocBuffer();
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+
+        auto src = input->GetBufferPtr<float>();
+        auto dst = output->GetBufferPtr<float>();
+        for (uint32_t i = 0; i < kRepeatCount; ++i) {
+            memcpy(dst + i * count, src, count * sizeof(float));
+        }
+        return RC_SUCCESS;
+    }
+};
+
+class AddOneOptKernel final : public OptKernel {
+public:
+    AddOneOptKernel(const ir::Node* node) : OptKernel(node) {}
+    KernelImpl* CreateKernelImpl() const override {
+        if (GetNode()->GetType().name == "Repeat") {
+            return new RepeatKernel(GetNode());
+        }
+        return new AddOneKernel(GetNode());
+    }
+
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    RetCode SerializeData(const pmx::SerializationContext&, utils::DataStream*) const override {
+        return RC_UNSUPPORTED;
+    }
+    RetCode DeserializeData(const pmx::DeserializationContext&, const void*, uint64_t) override {
+        return RC_UNSUPPORTED;
+    }
+#endif
+};
+
+class AddOneEngine final : public EngineImpl {
+public:
+    AddOneEngine() : EngineImpl("AddOneEngine") {}
+    RetCode Configure(uint32_t, ...) override {
+        return RC_UNSUPPORTED;
+    }
+    EngineContext* CreateEngineContext() override {
+        return new TmpEngineContext();
+    }
+    bool Supports(const ir::Node* node) const override {
+        return (node->GetType().name == "AddOne" || node->GetType().name == "Repeat");
+    }
+    RetCode ProcessGraph(const utils::SharedResource*, ir::Graph* graph, RuntimePartitionInfo* info) override {
+        auto topo = graph->topo.get();
+        for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            auto node = it->Get();
+            info->kernels.emplace(node->GetId(), unique_ptr<OptKernel>(new AddOneOptKernel(node)));
+        }
+        return RC_SUCCESS;
+    }
+    EngineImpl* Create() override {
+        return new AddOneEngine();
+    }
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    RetCode LoadConstants(const ConstantVisitor&, map<edgeid_t, BufferInfo>*) override {
+        return RC_SUCCESS;
+    }
+    OptKernel* CreateOptKernel(const ir::Node* node) const override {
+        return new AddOneOptKernel(node);
+    }
+    RetCode SerializeData(const pmx::SerializationContext&, utils::DataStream*) const override {
+        return RC_UNSUPPORTED;
+    }
+    RetCode DeserializeData(const void*, uint64_t) override {
+        return RC_UNSUPPORTED;
+    }
+#endif
+};
+
+} // namespace
+
+class ConstantFoldingTest : public testing::Test {
+protected:
+    void SetUp() override {
+        resource_.engines.push_back(&engine_);
+        resource_.graph_partitioner = make_shared<EngineGraphPartitioner>();
+    }
+
+    AddOneEngine engine_;
+    utils::SharedResource resource_;
+};
+
+TEST_F(ConstantFoldingTest, fold_chain) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("test", "AddOne", 1), {"c"}, {"t"});
+    builder.AddNode("b", ir::Node::Type("test", "AddOne", 1), {"t"}, {"u"});
+    builder.AddNode("d", ir::Node::Type("test", "AddOne", 1), {"u"}, {"out"});
+
+    auto graph = builder.GetGraph();
+    auto topo = graph->topo.get();
+    auto data = graph->data.get();
+
+    auto c = topo->GetEdgeByName("c")->GetId();
+    topo->MarkAsConstant(c);
+    topo->MarkAsOutput(topo->GetEdgeByName("out")->GetId());
+
+    const float values[] = {1, 2, 3};
+    data->constants[c].data.assign((const char*)values, sizeof(values));
+    auto& shape = data->shapes[c];
+    shape.data_type = DATATYPE_FLOAT32;
+    shape.data_format = DATAFORMAT_NDARRAY;
+    shape.dims = {3};
+
+    EXPECT_EQ(RC_SUCCESS, utils::FoldConstants(&resource_, graph));
+
+    // node `d` produces the output of graph and is kept
+    EXPECT_EQ(nullptr, topo->GetNodeByName("a"));
+    EXPECT_EQ(nullptr, topo->GetNodeByName("b"));
+    EXPECT_NE(nullptr, topo->GetNodeByName("d"));
+    EXPECT_EQ(nullptr, topo->GetEdgeByName("c"));
+    EXPECT_EQ(nullptr, topo->GetEdgeByName("t"));
+
+    auto u = topo->GetEdgeByName("u");
+    ASSERT_NE(nullptr, u);
+    EXPECT_EQ(INVALID_NODEID, u->GetProducer());
+    EXPECT_EQ(1, topo->GetConstantCount());
+    EXPECT_EQ(u->GetId(), topo->GetConstant(0));
+
+    auto& u_shape = data->shapes[u->GetId()];
+    EXPECT_EQ(DATATYPE_FLOAT32, u_shape.data_type);
+    ASSERT_EQ(1, u_shape.dims.size());
+    EXPECT_EQ(3, u_shape.dims[0]);
+
+    auto& u_data = data->constants[u->GetId()].data;
+    ASSERT_EQ(sizeof(values), u_data.size());
+    auto folded = (const float*)u_data.data();
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(values[i] + 2, folded[i]);
+    }
+}
+
+TEST_F(ConstantFoldingTest, keep_large_outputs) {
+    GraphBuilder builder;
+    builder.AddNode("r", ir::Node::Type("test", "Repeat", 1), {"c"}, {"large"});
+    builder.AddNode("b", ir::Node::Type("test", "AddOne", 1), {"large"}, {"t"});
+    builder.AddNode("d", ir::Node::Type("test", "AddOne", 1), {"t"}, {"out0"});
+    builder.AddNode("a", ir::Node::Type("test", "AddOne", 1), {"c"}, {"small"});
+    builder.AddNode("e", ir::Node::Type("test", "AddOne", 1), {"small"}, {"out1"});
+
+    auto graph = builder.GetGraph();
+    auto topo = graph->topo.get();
+    auto data = graph->data.get();
+
+    auto c = topo->GetEdgeByName("c")->GetId();
+    topo->MarkAsConstant(c);
+    topo->MarkAsOutput(topo->GetEdgeByName("out0")->GetId());
+    topo->MarkAsOutput(topo->GetEdgeByName("out1")->GetId());
+
+    const float values[] = {1, 2, 3};
+    data->constants[c].data.assign((const char*)values, sizeof(values));
+    auto& shape = data->shapes[c];
+    shape.data_type = DATATYPE_FLOAT32;
+    shape.data_format = DATAFORMAT_NDARRAY;
+    shape.dims = {3};
+
+    EXPECT_EQ(RC_SUCCESS, utils::FoldConstants(&resource_, graph));
+
+    // `r` grows 12 bytes to 3M bytes, so it and `b` which depends on it are kept
+    EXPECT_NE(nullptr, topo->GetNodeByName("r"));
+    EXPECT_NE(nullptr, topo->GetNodeByName("b"));
+    EXPECT_NE(nullptr, topo->GetNodeByName("d"));
+    EXPECT_EQ(nullptr, topo->GetNodeByName("a"));
+    EXPECT_NE(nullptr, topo->GetNodeByName("e"));
+
+    auto large = topo->GetEdgeByName("large");
+    ASSERT_NE(nullptr, large);
+    EXPECT_EQ(data->constants.end(), data->constants.find(large->GetId()));
+
+    auto small = topo->GetEdgeByName("small");
+    ASSERT_NE(nullptr, small);
+    EXPECT_EQ(INVALID_NODEID, small->GetProducer());
+    ASSERT_NE(data->constants.end(), data->constants.find(small->GetId()));
+    EXPECT_EQ(sizeof(values), data->constants[small->GetId()].data.size());
+
+    // `c` is still used by `r`
+    EXPECT_NE(nullptr, topo->GetEdgeByName("c"));
+    EXPECT_EQ(2, topo->GetConstantCount());
+}
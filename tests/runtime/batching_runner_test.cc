@@ -0,0 +1,206 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/batching_runner.h"
+#include "ppl/nn/runtime/tensor_impl.h"
+#include "ppl/nn/utils/generic_cpu_device.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <thread>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+/** doubles its input and records the batch size of every `Run()`. it fails if the first input value is negative. */
+class DoubleRuntime final : public Runtime {
+public:
+    DoubleRuntime(const ir::Edge* in_edge, const ir::Edge* out_edge)
+        : input_(in_edge, TENSORTYPE_NORMAL), output_(out_edge, TENSORTYPE_NORMAL) {
+        input_.SetDevice(&device_);
+        input_.GetShape()->SetDataType(DATATYPE_FLOAT32);
+        input_.GetShape()->SetDataFormat(DATAFORMAT_NDARRAY);
+        output_.SetDevice(&device_);
+        output_.GetShape()->SetDataType(DATATYPE_FLOAT32);
+        output_.GetShape()->SetDataFormat(DATAFORMAT_NDARRAY);
+    }
+
+    RetCode Configure(uint32_t, ...) override {
+        return RC_UNSUPPORTED;
+    }
+    uint32_t GetInputCount() const override {
+        return 1;
+    }
+    Tensor* GetInputTensor(uint32_t) const override {
+        return const_cast<TensorImpl*>(&input_);
+    }
+    uint32_t GetOutputCount() const override {
+        return 1;
+    }
+    Tensor* GetOutputTensor(uint32_t) const override {
+        return const_cast<TensorImpl*>(&output_);
+    }
+    uint32_t GetDeviceContextCount() const override {
+        return 0;
+    }
+    DeviceContext* GetDeviceContext(uint32_t) const override {
+        return nullptr;
+    }
+    RetCode GetProfilingStatistics(ProfilingStatistics*) const override {
+        return RC_UNSUPPORTED;
+    }
+
+    RetCode Run() override {
+        auto in_shape = input_.GetShape();
+        output_.GetShape()->Reshape(in_shape->GetDims(), in_shape->GetRealDimCount());
+        auto status = output_.ReallocBuffer();
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+
+        auto src = input_.GetBufferPtr<float>();
+        if (src[0] < 0) {
+            return RC_INVALID_VALUE;
+        }
+        auto dst = output_.GetBufferPtr<float>();
+        for (uint64_t i = 0; i < in_shape->GetElementsExcludingPadding(); ++i) {
+            dst[i] = src[i] * 2;
+        }
+        batch_sizes.push_back(in_shape->GetDim(0));
+        return RC_SUCCESS;
+    }
+
+public:
+    vector<int64_t> batch_sizes;
+
+private:
+    utils::GenericCpuDevice device_;
+    TensorImpl input_;
+    TensorImpl output_;
+};
+
+class BatchingRunnerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        builder_.AddNode("a", ir::Node::Type("test", "op1", 1), {"input_of_a"}, {"output_of_a"});
+        builder_.Finalize();
+
+        auto topo = builder_.GetGraph()->topo.get();
+        runtime_.reset(new DoubleRuntime(topo->GetEdgeByName("input_of_a"), topo->GetEdgeByName("output_of_a")));
+    }
+
+    static TensorShape MakeShape(int64_t batch, int64_t channels) {
+        TensorShape shape;
+        shape.Reshape({batch, channels});
+        shape.SetDataType(DATATYPE_FLOAT32);
+        shape.SetDataFormat(DATAFORMAT_NDARRAY);
+        return shape;
+    }
+
+    /** runs a request whose data are `base`, `base + 1`, ... and checks its outputs */
+    static void RunAndCheck(BatchingRunner* runner, int64_t batch, int64_t channels, float base) {
+        vector<float> data(batch * channels);
+        for (uint32_t i = 0; i < data.size(); ++i) {
+            data[i] = base + i;
+        }
+
+        vector<vector<char>> outputs;
+        vector<TensorShape> output_shapes;
+        EXPECT_EQ(RC_SUCCESS, runner->Run({data.data()}, {MakeShape(batch, channels)}, &outputs, &output_shapes));
+        ASSERT_EQ(1, outputs.size());
+        ASSERT_EQ(1, output_shapes.size());
+        EXPECT_EQ(batch, output_shapes[0].GetDim(0));
+        EXPECT_EQ(channels, output_shapes[0].GetDim(1));
+        ASSERT_EQ(data.size() * sizeof(float), outputs[0].size());
+
+        auto out = (const float*)outputs[0].data();
+        for (uint32_t i = 0; i < data.size(); ++i) {
+            EXPECT_FLOAT_EQ(data[i] * 2, out[i]);
+        }
+    }
+
+protected:
+    GraphBuilder builder_;
+    unique_ptr<DoubleRuntime> runtime_;
+};
+
+TEST_F(BatchingRunnerTest, single_request) {
+    unique_ptr<BatchingRunner> runner(BatchingRunnerFactory::Create(runtime_.get()));
+    ASSERT_NE(nullptr, runner);
+    RunAndCheck(runner.get(), 3, 4, 1.0f);
+    EXPECT_EQ(vector<int64_t>({3}), runtime_->batch_sizes);
+}
+
+TEST_F(BatchingRunnerTest, coalesce_concurrent_requests) {
+    BatchingOptions options;
+    options.max_batch_size = 4;
+    options.max_wait_us = 1000000;
+    unique_ptr<BatchingRunner> runner(BatchingRunnerFactory::Create(runtime_.get(), options));
+    ASSERT_NE(nullptr, runner);
+
+    vector<thread> clients;
+    for (uint32_t i = 0; i < 4; ++i) {
+        clients.emplace_back(RunAndCheck, runner.get(), 1, 8, i * 100.0f);
+    }
+    for (auto& t : clients) {
+        t.join();
+    }
+
+    BatchingStatistics stat;
+    runner->GetStatistics(&stat);
+    EXPECT_EQ(4, stat.request_count);
+    EXPECT_EQ(4, stat.sample_count);
+    EXPECT_EQ(1, stat.batch_count);
+    EXPECT_EQ(vector<int64_t>({4}), runtime_->batch_sizes);
+}
+
+TEST_F(BatchingRunnerTest, incompatible_requests_are_not_coalesced) {
+    BatchingOptions options;
+    options.max_batch_size = 2;
+    options.max_wait_us = 100000;
+    unique_ptr<BatchingRunner> runner(BatchingRunnerFactory::Create(runtime_.get(), options));
+    ASSERT_NE(nullptr, runner);
+
+    thread t0(RunAndCheck, runner.get(), 1, 4, 0.0f);
+    thread t1(RunAndCheck, runner.get(), 1, 8, 0.0f);
+    t0.join();
+    t1.join();
+
+    BatchingStatistics stat;
+    runner->GetStatistics(&stat);
+    EXPECT_EQ(2, stat.request_count);
+    EXPECT_EQ(2, stat.batch_count);
+}
+
+TEST_F(BatchingRunnerTest, failed_batches_are_counted_separately) {
+    unique_ptr<BatchingRunner> runner(BatchingRunnerFactory::Create(runtime_.get()));
+    ASSERT_NE(nullptr, runner);
+    RunAndCheck(runner.get(), 2, 4, 1.0f);
+
+    vector<float> data(2 * 4, -1.0f);
+    vector<vector<char>> outputs;
+    EXPECT_NE(RC_SUCCESS, runner->Run({data.data()}, {MakeShape(2, 4)}, &outputs));
+
+    BatchingStatistics stat;
+    runner->GetStatistics(&stat);
+    EXPECT_EQ(1, stat.request_count);
+    EXPECT_EQ(2, stat.sample_count);
+    EXPECT_EQ(1, stat.batch_count);
+    EXPECT_EQ(1, stat.failed_request_count);
+    EXPECT_EQ(1, stat.failed_batch_count);
+}
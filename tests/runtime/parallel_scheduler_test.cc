@@ -0,0 +1,162 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/ir/graph_builder.h"
+#include "ppl/nn/runtime/parallel_scheduler.h"
+#include "ppl/nn/utils/generic_cpu_device.h"
+#include "gtest/gtest.h"
+#include <atomic>
+
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+class OrderRecordingKernel final : public KernelImpl {
+public:
+    OrderRecordingKernel(const ir::Node* node, atomic<uint32_t>* counter, vector<uint32_t>* nodeid2seq)
+        : KernelImpl(node), counter_(counter), nodeid2seq_(nodeid2seq), acquire_edges_(true) {}
+
+    /** @brief simulates kernels which use neither inputs nor outputs, e.g. ops computing nothing */
+    void SetAcquireEdges(bool acquire) {
+        acquire_edges_ = acquire;
+    }
+
+    RetCode Execute(KernelExecContext* ctx) override {
+        if (!acquire_edges_) {
+            nodeid2seq_->at(GetNode()->GetId()) = counter_->fetch_add(1);
+            return RC_SUCCESS;
+        }
+
+        for (uint32_t i = 0; i < ctx->GetInputCount(); ++i) {
+            if (!ctx->GetInput<TensorImpl>(i)) {
+                return RC_NOT_FOUND;
+            }
+        }
+        for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
+            if (!ctx->GetOutput<TensorImpl>(i)) {
+                return RC_NOT_FOUND;
+            }
+        }
+        nodeid2seq_->at(GetNode()->GetId()) = counter_->fetch_add(1);
+        return RC_SUCCESS;
+    }
+
+private:
+    atomic<uint32_t>* counter_;
+    vector<uint32_t>* nodeid2seq_;
+    bool acquire_edges_;
+};
+
+class ParallelSchedulerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        builder_.AddNode("a", ir::Node::Type("test", "op1", 1), {"input_of_a"}, {"output_of_a"});
+        builder_.AddNode("b", ir::Node::Type("test", "op1", 1), {"output_of_a"}, {"output_of_b"});
+        builder_.AddNode("c", ir::Node::Type("test", "op1", 1), {"output_of_a"}, {"output_of_c"});
+        builder_.AddNode("d", ir::Node::Type("test", "op1", 1), {"output_of_b", "output_of_c"}, {"output_of_d"});
+        builder_.Finalize();
+
+        auto topo = builder_.GetGraph()->topo.get();
+        ASSERT_EQ(RC_SUCCESS, GenerateRuntimeAuxInfo(topo, &aux_info_));
+
+        nodeid2seq_.resize(topo->GetMaxNodeId());
+        graph_.nodeid2kernel.resize(topo->GetMaxNodeId());
+        graph_.edgeid2object.resize(topo->GetMaxEdgeId(), nullptr);
+
+        for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            auto node = it->Get();
+            auto kernel = new OrderRecordingKernel(node, &counter_, &nodeid2seq_);
+            kernel->SetDevice(&device_);
+            graph_.nodeid2kernel[node->GetId()].reset(kernel);
+        }
+
+        for (uint32_t i = 0; i < topo->GetInputCount(); ++i) {
+            AddReservedTensor(topo->GetInput(i));
+        }
+        for (uint32_t i = 0; i < topo->GetOutputCount(); ++i) {
+            AddReservedTensor(topo->GetOutput(i));
+        }
+
+        profiler_.Init(&conf_, &graph_, &aux_info_);
+    }
+
+    void AddReservedTensor(edgeid_t eid) {
+        auto edge = builder_.GetGraph()->topo->GetEdgeById(eid);
+        auto ret_pair = graph_.tensors.insert(make_pair(eid, TensorImpl(edge, TENSORTYPE_RESERVED)));
+        graph_.edgeid2object[eid] = &ret_pair.first->second;
+    }
+
+    uint32_t GetSeq(const string& name) const {
+        auto topo = builder_.GetGraph()->topo.get();
+        return nodeid2seq_[topo->GetNodeByName(name)->GetId()];
+    }
+
+protected:
+    GraphBuilder builder_;
+    RuntimeAuxInfo aux_info_;
+    RuntimeGraphResource graph_;
+    RuntimeInternalConf conf_;
+    Profiler profiler_;
+    utils::GenericCpuDevice device_;
+    atomic<uint32_t> counter_;
+    vector<uint32_t> nodeid2seq_;
+};
+
+TEST_F(ParallelSchedulerTest, run) {
+    auto topo = builder_.GetGraph()->topo.get();
+
+    ParallelScheduler sched(4);
+    EXPECT_EQ(RC_SUCCESS, sched.Init(topo, &aux_info_, &graph_));
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        counter_ = 0;
+        EXPECT_EQ(RC_SUCCESS, sched.Run(&profiler_));
+        EXPECT_EQ(4, counter_.load());
+        EXPECT_LT(GetSeq("a"), GetSeq("b"));
+        EXPECT_LT(GetSeq("a"), GetSeq("c"));
+        EXPECT_LT(GetSeq("b"), GetSeq("d"));
+        EXPECT_LT(GetSeq("c"), GetSeq("d"));
+
+        // only inputs and outputs are kept after running
+        for (uint32_t eid = 0; eid < graph_.edgeid2object.size(); ++eid) {
+            bool is_reserved = (graph_.tensors.find(eid) != graph_.tensors.end());
+            EXPECT_EQ(is_reserved, (graph_.edgeid2object[eid] != nullptr));
+        }
+    }
+}
+
+TEST_F(ParallelSchedulerTest, release_edges_not_acquired) {
+    auto topo = builder_.GetGraph()->topo.get();
+    auto kernel = graph_.nodeid2kernel[topo->GetNodeByName("b")->GetId()].get();
+    static_cast<OrderRecordingKernel*>(kernel)->SetAcquireEdges(false);
+
+    ParallelScheduler sched(4);
+    EXPECT_EQ(RC_SUCCESS, sched.Init(topo, &aux_info_, &graph_));
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        counter_ = 0;
+        EXPECT_EQ(RC_SUCCESS, sched.Run(&profiler_));
+        EXPECT_EQ(4, counter_.load());
+
+        // `output_of_a` is not used by `b` and `output_of_b` is only created by `d`
+        for (uint32_t eid = 0; eid < graph_.edgeid2object.size(); ++eid) {
+            bool is_reserved = (graph_.tensors.find(eid) != graph_.tensors.end());
+            EXPECT_EQ(is_reserved, (graph_.edgeid2object[eid] != nullptr));
+        }
+    }
+}
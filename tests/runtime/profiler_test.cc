@@ -0,0 +1,160 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+
+#include "ppl/nn/runtime/profiler.h"
+#include "ppl/nn/utils/generic_cpu_device.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+/** reports the execution time and flops set by the test */
+class ProfiledKernel final : public KernelImpl {
+public:
+    ProfiledKernel(const ir::Node* node) : KernelImpl(node) {}
+    RetCode Execute(KernelExecContext*) override {
+        return RC_SUCCESS;
+    }
+    uint64_t GetExecutionTime() const override {
+        return exec_microseconds;
+    }
+    uint64_t CalcFlops(const KernelExecContext&) const override {
+        return flops;
+    }
+
+public:
+    uint64_t exec_microseconds = 0;
+    uint64_t flops = 0;
+};
+
+class TensorAcquirer final : public KernelExecContext::AcquireObject {
+public:
+    TensorAcquirer(map<edgeid_t, TensorImpl>* tensors) : tensors_(tensors) {}
+    EdgeObject* Acquire(edgeid_t eid, uint32_t) override {
+        auto ref = tensors_->find(eid);
+        return (ref == tensors_->end()) ? nullptr : &ref->second;
+    }
+
+private:
+    map<edgeid_t, TensorImpl>* tensors_;
+};
+
+class ProfilerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        builder_.AddNode("a", ir::Node::Type("test", "op1", 1), {"input_of_a"}, {"output_of_a"});
+        builder_.Finalize();
+        auto topo = builder_.GetGraph()->topo.get();
+
+        for (auto name : {"input_of_a", "output_of_a"}) {
+            auto edge = topo->GetEdgeByName(name);
+            auto ret_pair = tensors_.insert(make_pair(edge->GetId(), TensorImpl(edge, TENSORTYPE_NORMAL)));
+            auto shape = ret_pair.first->second.GetShape();
+            shape->Reshape({2, 8});
+            shape->SetDataType(DATATYPE_FLOAT32);
+            shape->SetDataFormat(DATAFORMAT_NDARRAY);
+        }
+
+        auto node = topo->GetNodeByName("a");
+        kernel_ = new ProfiledKernel(node);
+        resource_.nodeid2kernel.resize(topo->GetMaxNodeId());
+        resource_.nodeid2kernel[node->GetId()].reset(kernel_);
+        aux_info_.sorted_nodes.push_back(node->GetId());
+
+        conf_.profiling_flag = true;
+        profiler_.Init(&conf_, &resource_, &aux_info_);
+        profiler_.StartProfiling(topo->GetMaxNodeId());
+    }
+
+    void Execute(uint64_t exec_microseconds, uint64_t flops) {
+        TensorAcquirer acquirer(&tensors_);
+        KernelExecContext ctx;
+        ctx.SetNode(kernel_->GetNode());
+        ctx.SetAcquireObject(&acquirer);
+
+        kernel_->exec_microseconds = exec_microseconds;
+        kernel_->flops = flops;
+        profiler_.CollectStatistics(kernel_, ctx, std::chrono::steady_clock::now());
+    }
+
+protected:
+    GraphBuilder builder_;
+    map<edgeid_t, TensorImpl> tensors_;
+    ProfiledKernel* kernel_;
+    RuntimeInternalConf conf_;
+    RuntimeGraphResource resource_;
+    RuntimeAuxInfo aux_info_;
+    Profiler profiler_;
+};
+
+TEST_F(ProfilerTest, percentiles_and_flops) {
+    // 1 GFLOP/s for every execution. flops differ among executions like kernels with dynamic shapes.
+    const uint64_t long_exec_microseconds = (1ull << 33);
+    for (uint64_t us = 1; us <= 100; ++us) {
+        Execute(us, us * 1000);
+    }
+    Execute(long_exec_microseconds, long_exec_microseconds * 1000);
+
+    ProfilingStatistics stat;
+    ASSERT_EQ(RC_SUCCESS, profiler_.GetProfilingStatistics(&stat));
+    ASSERT_EQ(1, stat.prof_info.size());
+    auto& info = stat.prof_info[0];
+    EXPECT_EQ("a", info.name);
+    EXPECT_EQ(101, info.exec_count);
+    EXPECT_EQ(5050 + long_exec_microseconds, info.exec_microseconds);
+    EXPECT_EQ(51, info.p50_microseconds);
+    EXPECT_EQ(100, info.p99_microseconds);
+    EXPECT_EQ(long_exec_microseconds, info.max_microseconds);
+    EXPECT_EQ(long_exec_microseconds * 1000, info.flops);
+    EXPECT_DOUBLE_EQ(1.0, info.gflops_per_second);
+    EXPECT_EQ(2 * 2 * 8 * sizeof(float), info.bytes);
+    ASSERT_EQ(1, info.input_dims.size());
+    EXPECT_EQ(vector<int64_t>({2, 8}), info.input_dims[0]);
+}
+
+TEST_F(ProfilerTest, export_chrome_trace) {
+    Execute(10, 0);
+    Execute(20, 0);
+
+    ProfilingStatistics stat;
+    ASSERT_EQ(RC_SUCCESS, profiler_.GetProfilingStatistics(&stat));
+    ASSERT_EQ(2, stat.trace_events.size());
+    EXPECT_EQ(0, stat.trace_events[0].kernel_idx);
+    EXPECT_EQ(10, stat.trace_events[0].duration_microseconds);
+    EXPECT_EQ(20, stat.trace_events[1].duration_microseconds);
+
+    const string trace_file = "profiler_test_trace.json";
+    ASSERT_EQ(RC_SUCCESS, ExportChromeTrace(stat, trace_file.c_str()));
+    ifstream ifs(trace_file);
+    stringstream content;
+    content << ifs.rdbuf();
+    EXPECT_NE(string::npos, content.str().find("\"name\":\"a\",\"cat\":\"test.op1\""));
+    EXPECT_NE(string::npos, content.str().find("\"dur\":20"));
+
+    stat.trace_events[1].kernel_idx = stat.prof_info.size();
+    EXPECT_EQ(RC_INVALID_VALUE, ExportChromeTrace(stat, trace_file.c_str()));
+    remove(trace_file.c_str());
+}
+
+#endif
@@ -0,0 +1,46 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "tests/ir/graph_builder.h"
+#include "ppl/nn/runtime/runtime_aux_info.h"
+#include "gtest/gtest.h"
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+TEST(RuntimeAuxInfoTest, shapes_determined_by_shape_values) {
+    // input -> Shape -> shape_of_input -> Reshape(input, shape_of_input) -> output
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("", "Shape", 1), {"input"}, {"shape_of_input"});
+    builder.AddNode("b", ir::Node::Type("", "Reshape", 1), {"input", "shape_of_input"}, {"output"});
+    builder.Finalize();
+
+    RuntimeAuxInfo aux_info;
+    ASSERT_EQ(RC_SUCCESS, GenerateRuntimeAuxInfo(builder.GetGraph()->topo.get(), &aux_info));
+    EXPECT_TRUE(aux_info.shapes_determined_by_inputs);
+}
+
+TEST(RuntimeAuxInfoTest, shapes_determined_by_input_values) {
+    // Reshape(data, shape) -> output where `shape` is an input of the graph
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("", "Reshape", 1), {"data", "shape"}, {"output"});
+    builder.Finalize();
+
+    RuntimeAuxInfo aux_info;
+    ASSERT_EQ(RC_SUCCESS, GenerateRuntimeAuxInfo(builder.GetGraph()->topo.get(), &aux_info));
+    EXPECT_FALSE(aux_info.shapes_determined_by_inputs);
+}
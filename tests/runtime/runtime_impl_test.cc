@@ -0,0 +1,311 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/runtime_impl.h"
+#include "tests/engines/tmp_engine.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+/** records the buffer of its constant input and whether reshaping can be skipped in every execution */
+class ConstantRecordingKernel final : public KernelImpl {
+public:
+    ConstantRecordingKernel(const ir::Node* node, vector<const void*>* records, vector<bool>* skip_reshape_records)
+        : KernelImpl(node), records_(records), skip_reshape_records_(skip_reshape_records) {}
+
+    RetCode Execute(KernelExecContext* ctx) override {
+        records_->push_back(ctx->GetInput<TensorImpl>(1)->GetBufferPtr());
+        skip_reshape_records_->push_back(ctx->CanSkipReshape());
+        return RC_SUCCESS;
+    }
+
+private:
+    vector<const void*>* records_;
+    vector<bool>* skip_reshape_records_;
+};
+
+class ConstantRecordingOptKernel final : public OptKernel {
+public:
+    ConstantRecordingOptKernel(const ir::Node* node, vector<const void*>* records, vector<bool>* skip_reshape_records)
+        : OptKernel(node), records_(records), skip_reshape_records_(skip_reshape_records) {}
+
+    KernelImpl* CreateKernelImpl() const override {
+        return new ConstantRecordingKernel(GetNode(), records_, skip_reshape_records_);
+    }
+
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    RetCode SerializeData(const pmx::SerializationContext&, utils::DataStream*) const override {
+        return RC_UNSUPPORTED;
+    }
+    RetCode DeserializeData(const pmx::DeserializationContext&, const void*, uint64_t) override {
+        return RC_UNSUPPORTED;
+    }
+#endif
+
+private:
+    vector<const void*>* records_;
+    vector<bool>* skip_reshape_records_;
+};
+
+/** copies its input to its output and records the output buffer in every execution */
+class CopyKernel final : public KernelImpl {
+public:
+    CopyKernel(const ir::Node* node, vector<const void*>* records) : KernelImpl(node), records_(records) {}
+
+    RetCode Execute(KernelExecContext* ctx) override {
+        auto input = ctx->GetInput<TensorImpl>(0);
+        auto output = ctx->GetOutput<TensorImpl>(0);
+        *output->GetShape() = *input->GetShape();
+        auto status = output->ReallocBuffer();
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+        memcpy(output->GetBufferPtr(), input->GetBufferPtr(), input->GetShape()->GetBytesIncludingPadding());
+        records_->push_back(output->GetBufferPtr());
+        return RC_SUCCESS;
+    }
+
+private:
+    vector<const void*>* records_;
+};
+
+class CopyOptKernel final : public OptKernel {
+public:
+    CopyOptKernel(const ir::Node* node, vector<const void*>* records) : OptKernel(node), records_(records) {}
+
+    KernelImpl* CreateKernelImpl() const override {
+        return new CopyKernel(GetNode(), records_);
+    }
+
+#ifdef PPLNN_ENABLE_PMX_MODEL
+    RetCode SerializeData(const pmx::SerializationContext&, utils::DataStream*) const override {
+        return RC_UNSUPPORTED;
+    }
+    RetCode DeserializeData(const pmx::DeserializationContext&, const void*, uint64_t) override {
+        return RC_UNSUPPORTED;
+    }
+#endif
+
+private:
+    vector<const void*>* records_;
+};
+
+class RuntimeImplTest : public testing::Test {
+protected:
+    void SetUp() override {
+        builder_.AddNode("a", ir::Node::Type("test", "op1", 1), {"input_of_a", "weight_of_a"}, {"output_of_a"});
+
+        auto topo = builder_.GetGraph()->topo;
+        auto in_edge = topo->GetEdgeByName("input_of_a");
+        auto weight_edge = topo->GetEdgeByName("weight_of_a");
+        auto out_edge = topo->GetEdgeByName("output_of_a");
+        topo->MarkAsInput(in_edge->GetId());
+        topo->MarkAsConstant(weight_edge->GetId());
+        topo->MarkAsOutput(out_edge->GetId());
+
+        TensorShape shape;
+        shape.Reshape({1, 4});
+        shape.SetDataType(DATATYPE_FLOAT32);
+        shape.SetDataFormat(DATAFORMAT_NDARRAY);
+
+        auto graph_info = make_shared<RuntimeGraphInfo>();
+        graph_info->shapes.insert(make_pair(in_edge->GetId(), shape));
+        graph_info->shapes.insert(make_pair(weight_edge->GetId(), shape));
+        graph_info->shapes.insert(make_pair(out_edge->GetId(), shape));
+
+        RuntimeGraphInfo::Partition partition;
+        partition.engine = &engine_;
+        partition.ops.emplace_back(new ConstantRecordingOptKernel(topo->GetNodeByName("a"), &records_, &skip_reshape_records_));
+
+        BufferInfo weight_info;
+        weight_info.SetDevice(&device_);
+        ASSERT_EQ(RC_SUCCESS, weight_info.ReallocBuffer(shape));
+        partition.constants.insert(make_pair(weight_edge->GetId(), std::move(weight_info)));
+        graph_info->partitions.emplace_back(std::move(partition));
+        graph_info_ = graph_info;
+
+        auto aux_info = make_shared<RuntimeAuxInfo>();
+        ASSERT_EQ(RC_SUCCESS, GenerateRuntimeAuxInfo(topo.get(), aux_info.get()));
+        aux_info_ = aux_info;
+    }
+
+protected:
+    GraphBuilder builder_;
+    TmpEngine engine_;
+    utils::GenericCpuDevice device_;
+    vector<const void*> records_;
+    vector<bool> skip_reshape_records_;
+    shared_ptr<const RuntimeGraphInfo> graph_info_;
+    shared_ptr<const RuntimeAuxInfo> aux_info_;
+};
+
+TEST_F(RuntimeImplTest, runtimes_share_constants) {
+    auto topo = builder_.GetGraph()->topo;
+    const void* weight = graph_info_->partitions[0].constants.begin()->second.GetBufferPtr();
+
+    RuntimeImpl r0, r1;
+    ASSERT_EQ(RC_SUCCESS, r0.Init(topo, graph_info_, aux_info_));
+    ASSERT_EQ(RC_SUCCESS, r1.Init(topo, graph_info_, aux_info_));
+
+    for (auto r : {&r0, &r1}) {
+        auto in = r->GetInputTensorImpl(0);
+        ASSERT_EQ(RC_SUCCESS, in->ReallocBuffer());
+        EXPECT_EQ(RC_SUCCESS, r->Run());
+    }
+
+    // activations are owned by each runtime
+    EXPECT_NE(r0.GetInputTensorImpl(0)->GetBufferPtr(), r1.GetInputTensorImpl(0)->GetBufferPtr());
+
+    // constants are loaded once and used by all runtimes without being copied
+    ASSERT_EQ(2, records_.size());
+    EXPECT_EQ(weight, records_[0]);
+    EXPECT_EQ(weight, records_[1]);
+}
+
+TEST_F(RuntimeImplTest, skip_reshape_if_input_shapes_unchanged) {
+    auto topo = builder_.GetGraph()->topo;
+    ASSERT_TRUE(aux_info_->shapes_determined_by_inputs);
+
+    RuntimeImpl r;
+    ASSERT_EQ(RC_SUCCESS, r.Init(topo, graph_info_, aux_info_));
+
+    auto in = r.GetInputTensorImpl(0);
+    ASSERT_EQ(RC_SUCCESS, in->ReallocBuffer());
+    EXPECT_EQ(RC_SUCCESS, r.Run());
+    EXPECT_EQ(RC_SUCCESS, r.Run());
+
+    in->GetShape()->Reshape({2, 4});
+    ASSERT_EQ(RC_SUCCESS, in->ReallocBuffer());
+    EXPECT_EQ(RC_SUCCESS, r.Run());
+    EXPECT_EQ(RC_SUCCESS, r.Run());
+
+    ASSERT_EQ(4, skip_reshape_records_.size());
+    EXPECT_FALSE(skip_reshape_records_[0]);
+    EXPECT_TRUE(skip_reshape_records_[1]);
+    EXPECT_FALSE(skip_reshape_records_[2]);
+    EXPECT_TRUE(skip_reshape_records_[3]);
+}
+
+TEST_F(RuntimeImplTest, memory_statistics) {
+    auto topo = builder_.GetGraph()->topo;
+
+    RuntimeImpl r;
+    ASSERT_EQ(RC_SUCCESS, r.Init(topo, graph_info_, aux_info_));
+
+    auto in = r.GetInputTensorImpl(0);
+    ASSERT_EQ(RC_SUCCESS, in->ReallocBuffer());
+    EXPECT_EQ(RC_SUCCESS, r.Run());
+
+    MemoryStatistics stat;
+    EXPECT_EQ(RC_SUCCESS, r.Configure(RUNTIME_CONF_GET_MEMORY_STATISTICS, &stat));
+
+    // generic cpu devices do not report usage of activations
+    EXPECT_EQ(4 * sizeof(float), stat.constant_bytes);
+    EXPECT_EQ(0, stat.max_total_bytes);
+
+    ASSERT_EQ(1, stat.kernel_info.size());
+    EXPECT_EQ("a", stat.kernel_info[0].name);
+    EXPECT_EQ("op1", stat.kernel_info[0].type);
+    EXPECT_EQ(0, stat.kernel_info[0].max_scratch_bytes);
+}
+
+TEST_F(RuntimeImplTest, planned_tensor_grows_beyond_reserved_buffer) {
+    // input_of_a -> a -> output_of_a -> b -> output_of_b
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("test", "op1", 1), {"input_of_a"}, {"output_of_a"});
+    builder.AddNode("b", ir::Node::Type("test", "op1", 1), {"output_of_a"}, {"output_of_b"});
+    builder.Finalize();
+    auto topo = builder.GetGraph()->topo;
+
+    TensorShape shape;
+    shape.Reshape({1, 64});
+    shape.SetDataType(DATATYPE_FLOAT32);
+    shape.SetDataFormat(DATAFORMAT_NDARRAY);
+
+    vector<const void*> records;
+    auto graph_info = make_shared<RuntimeGraphInfo>();
+    RuntimeGraphInfo::Partition partition;
+    partition.engine = &engine_;
+    for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        partition.ops.emplace_back(new CopyOptKernel(node, &records));
+        partition.shapes.insert(make_pair(node->GetOutput(0), shape));
+    }
+    graph_info->partitions.emplace_back(std::move(partition));
+    graph_info->shapes.insert(make_pair(topo->GetEdgeByName("input_of_a")->GetId(), shape));
+    graph_info->shapes.insert(make_pair(topo->GetEdgeByName("output_of_b")->GetId(), shape));
+
+    auto aux_info = make_shared<RuntimeAuxInfo>();
+    ASSERT_EQ(RC_SUCCESS, GenerateRuntimeAuxInfo(topo.get(), aux_info.get()));
+    ASSERT_EQ(RC_SUCCESS, GenerateRuntimeMemoryPlan(topo.get(), *graph_info, *aux_info, &aux_info->memory_plan));
+    ASSERT_EQ(shape.GetBytesIncludingPadding(), aux_info->memory_plan.GetTotalBytes());
+
+    RuntimeImpl r;
+    ASSERT_EQ(RC_SUCCESS, r.Init(topo, graph_info, aux_info));
+    ASSERT_EQ(RC_SUCCESS, r.Configure(RUNTIME_CONF_SET_MEMORY_PLAN_FLAG, 1u));
+
+    const void* planned_buffer = nullptr;
+    for (int64_t batch : {1, 3, 1}) {
+        auto in = r.GetInputTensorImpl(0);
+        in->GetShape()->Reshape({batch, 64});
+        ASSERT_EQ(RC_SUCCESS, in->ReallocBuffer());
+
+        vector<float> in_data(batch * 64);
+        for (uint32_t i = 0; i < in_data.size(); ++i) {
+            in_data[i] = (float)i;
+        }
+        ASSERT_EQ(RC_SUCCESS, in->CopyFromHost(in_data.data()));
+
+        records.clear();
+        ASSERT_EQ(RC_SUCCESS, r.Run());
+
+        vector<float> out_data(batch * 64);
+        auto out = r.GetOutputTensorImpl(0);
+        ASSERT_EQ(RC_SUCCESS, out->CopyToHost(out_data.data()));
+        EXPECT_EQ(in_data, out_data);
+
+        // `output_of_a` uses its planned buffer only if it fits
+        ASSERT_EQ(2, records.size());
+        if (!planned_buffer) {
+            planned_buffer = records[0];
+        } else if (batch == 1) {
+            EXPECT_EQ(planned_buffer, records[0]);
+        } else {
+            EXPECT_NE(planned_buffer, records[0]);
+        }
+    }
+}
+
+TEST_F(RuntimeImplTest, parallel_scheduling_requires_x86_devices) {
+    auto topo = builder_.GetGraph()->topo;
+
+    RuntimeImpl r;
+    ASSERT_EQ(RC_SUCCESS, r.Init(topo, graph_info_, aux_info_));
+
+    // kernels of `TmpEngine` run on a generic cpu device, which cannot be used by multiple threads
+    EXPECT_EQ(RC_UNSUPPORTED, r.Configure(RUNTIME_CONF_SET_SCHEDULING_POLICY, RUNTIME_SCHED_PARALLEL));
+    EXPECT_EQ(RC_SUCCESS, r.Configure(RUNTIME_CONF_SET_SCHEDULING_POLICY, RUNTIME_SCHED_SEQUENTIAL));
+
+    auto in = r.GetInputTensorImpl(0);
+    ASSERT_EQ(RC_SUCCESS, in->ReallocBuffer());
+    EXPECT_EQ(RC_SUCCESS, r.Run());
+}
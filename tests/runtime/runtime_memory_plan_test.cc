@@ -0,0 +1,96 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/ir/graph_builder.h"
+#include "tests/engines/tmp_engine.h"
+#include "ppl/nn/runtime/runtime_aux_info.h"
+#include "gtest/gtest.h"
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+class RuntimeMemoryPlanTest : public testing::Test {
+protected:
+    void SetUp() override {
+        // input_of_a -> a -> output_of_a -> b -> output_of_b -> c -> output_of_c -> d -> output_of_d
+        builder_.AddNode("a", ir::Node::Type("test", "op1", 1), {"input_of_a"}, {"output_of_a"});
+        builder_.AddNode("b", ir::Node::Type("test", "op1", 1), {"output_of_a"}, {"output_of_b"});
+        builder_.AddNode("c", ir::Node::Type("test", "op1", 1), {"output_of_b"}, {"output_of_c"});
+        builder_.AddNode("d", ir::Node::Type("test", "op1", 1), {"output_of_c"}, {"output_of_d"});
+        builder_.Finalize();
+
+        auto topo = builder_.GetGraph()->topo.get();
+        ASSERT_EQ(RC_SUCCESS, GenerateRuntimeAuxInfo(topo, &aux_info_));
+
+        RuntimeGraphInfo::Partition partition;
+        partition.engine = &engine_;
+        for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            auto node = it->Get();
+            partition.ops.emplace_back(unique_ptr<OptKernel>(new TmpOptKernelOne(node)));
+            for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+                TensorShape shape;
+                shape.SetDataType(DATATYPE_FLOAT32);
+                shape.SetDataFormat(DATAFORMAT_NDARRAY);
+                shape.Reshape({1, 3, 32, 32});
+                partition.shapes.insert(make_pair(node->GetOutput(i), shape));
+            }
+        }
+        graph_info_.partitions.emplace_back(std::move(partition));
+    }
+
+    const RuntimeMemoryPlan::Block& GetBlock(const string& name) const {
+        auto topo = builder_.GetGraph()->topo.get();
+        return aux_info_.memory_plan.edgeid2block[topo->GetEdgeByName(name)->GetId()];
+    }
+
+    static bool IsOverlapped(const RuntimeMemoryPlan::Block& a, const RuntimeMemoryPlan::Block& b) {
+        return (a.offset < b.offset + b.bytes && b.offset < a.offset + a.bytes);
+    }
+
+protected:
+    GraphBuilder builder_;
+    TmpEngine engine_;
+    RuntimeGraphInfo graph_info_;
+    RuntimeAuxInfo aux_info_;
+};
+
+TEST_F(RuntimeMemoryPlanTest, generate) {
+    auto topo = builder_.GetGraph()->topo.get();
+    EXPECT_EQ(RC_SUCCESS, GenerateRuntimeMemoryPlan(topo, graph_info_, aux_info_, &aux_info_.memory_plan));
+
+    const uint64_t bytes = 1 * 3 * 32 * 32 * sizeof(float);
+
+    // outputs are kept after running and are not planned
+    EXPECT_EQ(nullptr, GetBlock("output_of_d").engine);
+
+    auto& block_a = GetBlock("output_of_a");
+    auto& block_b = GetBlock("output_of_b");
+    auto& block_c = GetBlock("output_of_c");
+    EXPECT_EQ(&engine_, block_a.engine);
+    EXPECT_EQ(&engine_, block_b.engine);
+    EXPECT_EQ(&engine_, block_c.engine);
+
+    // tensors used by the same node cannot share memory
+    EXPECT_FALSE(IsOverlapped(block_a, block_b));
+    EXPECT_FALSE(IsOverlapped(block_b, block_c));
+
+    // `output_of_a` is released before `output_of_c` is produced
+    EXPECT_EQ(block_a.offset, block_c.offset);
+
+    EXPECT_EQ(2 * bytes, aux_info_.memory_plan.GetTotalBytes());
+}
@@ -15,7 +15,6 @@
 // specific language governing permissions and limitations
 // under the License.
 
-#include "ppl/common/file_mapping.h"
 #include "ppl/nn/models/onnx/model_parser.h"
 #include "ppl/nn/common/logger.h"
 #include <iostream>
@@ -30,15 +29,8 @@ int main(int argc, char* argv[]) {
     }
     const char* model_file = argv[1];
 
-    FileMapping fm;
-    auto status = fm.Init(model_file);
-    if (status != RC_SUCCESS) {
-        LOG(ERROR) << "Init filemapping from file [" << model_file << "] error: " << GetRetCodeStr(status);
-        return 1;
-    }
-
     ir::Graph graph;
-    status = ppl::nn::onnx::ModelParser::Parse(fm.Data(), fm.Size(), &graph);
+    auto status = ppl::nn::onnx::ModelParser::Parse(model_file, &graph);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "parse model failed: " << GetRetCodeStr(status);
         return 1;
@@ -29,11 +29,17 @@
 #include <iostream>
 #include <functional>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/resource.h>
+#endif
 using namespace ppl::nn;
 using namespace ppl::common;
 using namespace std;
 
 #include "ppl/nn/runtime/runtime.h"
+#include "ppl/nn/runtime/batching_runner.h"
 
 #ifdef PPLNN_ENABLE_ONNX_MODEL
 #include "ppl/nn/models/onnx/onnx_runtime_builder_factory.h"
@@ -57,16 +63,34 @@ Define_string_opt("--onnx-model", g_flag_onnx_model, "", "onnx model file");
 #ifdef PPLNN_ENABLE_PMX_MODEL
 Define_string_opt("--pmx-model", g_flag_pmx_model, "", "pmx model file");
 Define_string_opt("--save-pmx-model", g_flag_save_pmx_model, "", "dump model to <filename> in pmx format");
+Define_bool_opt("--use-mmap", g_flag_use_mmap, false,
+                "map the pmx model into memory and use constants in it without copying if possible");
 #endif
 
 Define_string_opt("--mm-policy", g_flag_mm_policy, "mem",
                   "\"perf\" => better performance, or \"mem\" => less memory usage");
 
 Define_bool_opt("--enable-profiling", g_flag_enable_profiling, false, "enable profiling and print profiling info");
+Define_string_opt("--export-profiling-trace", g_flag_export_profiling_trace, "",
+                  "export kernel executions during profiling to a json file in chrome trace event format");
+Define_string_opt("--sched-policy", g_flag_sched_policy, "seq",
+                  "\"seq\" => runs kernels one by one, \"parallel\" => runs independent kernels concurrently");
+Define_uint32_opt("--sched-thread-num", g_flag_sched_thread_num, 0,
+                  "number of threads used by parallel scheduling. 0 means hardware concurrency");
+Define_bool_opt("--enable-memory-plan", g_flag_enable_memory_plan, false,
+                "allocate activations with fixed shapes from preallocated arenas planned in preprocessing stage");
 Define_float_opt("--min-profiling-seconds", g_flag_min_profiling_seconds, 1.0f,
                  "min execute time by seconds for profiling");
 Define_uint32_opt("--min-profiling-iterations", g_flag_min_profiling_iterations, 1, "declare profiling iteration");
 Define_uint32_opt("--warmup-iterations", g_flag_warmup_iterations, 1, "declare profiling warmup iteration");
+Define_uint32_opt("--benchmark-clients", g_flag_benchmark_clients, 0,
+                  "number of concurrent clients sending requests, which are coalesced into batches along dim 0,"
+                  " in benchmark mode. 0 means benchmark mode is disabled");
+Define_float_opt("--benchmark-seconds", g_flag_benchmark_seconds, 5.0f, "duration in seconds of benchmark mode");
+Define_uint32_opt("--max-batch-size", g_flag_max_batch_size, 8,
+                  "max number of samples run in one batch in benchmark mode");
+Define_uint32_opt("--max-batch-wait-us", g_flag_max_batch_wait_us, 1000,
+                  "max time in microseconds that a request waits for others in benchmark mode");
 
 Define_string_opt("--input", g_flag_input, "", "binary input file containing all tensors' data");
 Define_string_opt("--inputs", g_flag_inputs, "", "binary input files separated by comma");
@@ -180,26 +204,14 @@ static bool ParseInputShapes(const string& shape_str, vector<vector<int64_t>>* i
 
 /* -------------------------------------------------------------------------- */
 
-#ifdef PPLNN_USE_CUDA
-
-Define_bool_opt("--use-cuda", g_flag_use_cuda, false, "use cuda engine");
-
-Define_bool_opt("--quick-select", g_flag_quick_select, false, "quick select algorithms for conv and gemm kernel");
-Define_uint32_opt("--device-id", g_flag_device_id, 0, "declare device id for cuda");
-Define_string_opt("--kernel-type", g_flag_kernel_type, "",
-                  "set kernel type for cuda inferencing. valid values: int8/16/32/64,float16/32");
+#if defined(PPLNN_USE_CUDA) || defined(PPLNN_USE_X86)
 
+Define_string_opt("--quant-file", g_flag_quant_file, "", "a json file containing quantization information");
 Define_string_opt("--export-algo-file", g_flag_export_algo_file, "",
                   "Export the selected best algo info into the json file.");
 Define_string_opt("--import-algo-file", g_flag_import_algo_file, "",
                   "The objects in the json file declare best algo info for certain conv input shape");
 
-Define_string_opt("--quant-file", g_flag_quant_file, "", "a json file containing quantization information");
-
-#include "ppl/nn/engines/cuda/engine_factory.h"
-#include "ppl/nn/engines/cuda/cuda_options.h"
-#include "ppl/nn/utils/array.h"
-
 static RetCode ReadFileContent(const char* fname, string* buf) {
     ifstream ifile;
 
@@ -217,6 +229,21 @@ static RetCode ReadFileContent(const char* fname, string* buf) {
     return RC_SUCCESS;
 }
 
+#endif
+
+#ifdef PPLNN_USE_CUDA
+
+Define_bool_opt("--use-cuda", g_flag_use_cuda, false, "use cuda engine");
+
+Define_bool_opt("--quick-select", g_flag_quick_select, false, "quick select algorithms for conv and gemm kernel");
+Define_uint32_opt("--device-id", g_flag_device_id, 0, "declare device id for cuda");
+Define_string_opt("--kernel-type", g_flag_kernel_type, "",
+                  "set kernel type for cuda inferencing. valid values: int8/16/32/64,float16/32");
+
+#include "ppl/nn/engines/cuda/engine_factory.h"
+#include "ppl/nn/engines/cuda/cuda_options.h"
+#include "ppl/nn/utils/array.h"
+
 static inline bool RegisterCudaEngine(vector<unique_ptr<Engine>>* engines) {
     CudaEngineOptions options;
     options.device_id = g_flag_device_id;
@@ -313,6 +340,17 @@ Define_bool_opt("--use-x86", g_flag_use_x86, false, "use x86 engine");
 Define_bool_opt("--disable-avx512", g_flag_disable_avx512, false, "disable avx512 feature");
 Define_bool_opt("--disable-avx-fma3", g_flag_disable_avx_fma3, false, "disable avx, fma3 and avx512 feature");
 Define_bool_opt("--core-binding", g_flag_core_binding, false, "core binding");
+Define_uint32_opt("--thread-num", g_flag_thread_num, 0, "number of threads used by x86 kernels. 0 means openmp default");
+Define_string_opt("--core-list", g_flag_core_list, "",
+                  "bind threads of x86 kernels to cores separated by comma, for example \"0,1,2,3\"");
+Define_int32_opt("--numa-node-id", g_flag_numa_node_id, -1,
+                 "bind x86 engine to specified numa node, range [0, numa_max_node], -1 means not bind");
+Define_uint32_opt("--tuning-level", g_flag_tuning_level, 0,
+                  "select conv algo dynamic tuning level[0-1]. 0: off. 1: measure candidate algorithms");
+Define_bool_opt("--use-bf16", g_flag_use_bf16, false,
+                "infer conv and gemm with x86 avx512-bf16/amx-bf16 if supported (use fp32 by default)");
+Define_uint32_opt("--x86-memory-budget-mb", g_flag_x86_memory_budget_mb, 0,
+                  "max activation and temporary memory in MB used by x86 devices of the runtime. 0 means unlimited");
 
 #include "ppl/nn/engines/x86/engine_factory.h"
 #include "ppl/nn/engines/x86/x86_options.h"
@@ -325,8 +363,18 @@ static inline bool RegisterX86Engine(vector<unique_ptr<Engine>>* engines) {
     } else if (g_flag_mm_policy == "mem") {
         options.mm_policy = X86_MM_COMPACT;
     }
+    options.dynamic_tuning_level = g_flag_tuning_level;
+    if (g_flag_use_bf16) {
+        options.forward_precision = ppl::common::DATATYPE_BFLOAT16;
+    }
+    options.thread_num = g_flag_thread_num;
+    options.numa_node_id = g_flag_numa_node_id;
 
     auto x86_engine = X86EngineFactory::Create(options);
+    if (!x86_engine) {
+        LOG(ERROR) << "create x86 engine failed.";
+        return false;
+    }
     if (g_flag_disable_avx512) {
         x86_engine->Configure(ppl::nn::X86_CONF_DISABLE_AVX512);
     }
@@ -336,12 +384,70 @@ static inline bool RegisterX86Engine(vector<unique_ptr<Engine>>* engines) {
     if (g_flag_core_binding) {
         ppl::kernel::x86::set_omp_core_binding(nullptr, 0, 1);
     }
+    if (!g_flag_core_list.empty()) {
+        vector<int32_t> cores;
+        SplitString(g_flag_core_list.data(), g_flag_core_list.size(), ",", 1,
+                    [&cores](const char* s, unsigned int l) -> bool {
+                        if (l > 0) {
+                            cores.push_back(atoi(string(s, l).c_str()));
+                        }
+                        return true;
+                    });
+        auto status = x86_engine->Configure(ppl::nn::X86_CONF_SET_CORE_BINDING, cores.data(), (uint32_t)cores.size());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "set core binding failed: " << GetRetCodeStr(status);
+            return false;
+        }
+    }
+    if (!g_flag_quant_file.empty()) {
+        string file_content;
+        auto status = ReadFileContent(g_flag_quant_file.c_str(), &file_content);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "read file[" << g_flag_quant_file << "] failed: " << GetRetCodeStr(status);
+            return false;
+        }
+        status = x86_engine->Configure(ppl::nn::X86_CONF_SET_QUANT_INFO, file_content.c_str());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "set quant info failed: " << GetRetCodeStr(status);
+            return false;
+        }
+    }
+    if (!g_flag_import_algo_file.empty()) {
+        auto status = x86_engine->Configure(ppl::nn::X86_CONF_IMPORT_ALGORITHMS, g_flag_import_algo_file.c_str());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "import algorithms failed: " << GetRetCodeStr(status);
+            return false;
+        }
+    }
+    if (!g_flag_export_algo_file.empty()) {
+        auto status = x86_engine->Configure(ppl::nn::X86_CONF_EXPORT_ALGORITHMS, g_flag_export_algo_file.c_str());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "export algorithms failed: " << GetRetCodeStr(status);
+            return false;
+        }
+    }
     // configure engine
     engines->emplace_back(unique_ptr<Engine>(x86_engine));
     LOG(INFO) << "***** register X86Engine *****";
     return true;
 }
 
+static bool SetX86MemoryBudget(Runtime* runtime) {
+    const uint64_t budget = (uint64_t)g_flag_x86_memory_budget_mb * 1024 * 1024;
+    for (uint32_t i = 0; i < runtime->GetDeviceContextCount(); ++i) {
+        auto dev = runtime->GetDeviceContext(i);
+        if (strcmp(dev->GetType(), "x86") != 0) {
+            continue;
+        }
+        auto status = dev->Configure(X86_DEV_CONF_SET_MEMORY_BUDGET, budget);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "set memory budget of x86 device failed: " << GetRetCodeStr(status);
+            return false;
+        }
+    }
+    return true;
+}
+
 #endif
 
 #ifdef PPLNN_USE_RISCV
@@ -915,9 +1021,29 @@ static void PrintProfilingStatistics(const ProfilingStatistics& stat, double run
         sprintf(float_buf_0, "%8.4f", avg_time);
         string temp = x->name;
         temp.insert(temp.length(), temp.length() > 50 ? 0 : 50 - temp.length(), ' ');
+        string shapes_str;
+        for (auto dims = x->input_dims.begin(); dims != x->input_dims.end(); ++dims) {
+            shapes_str += (shapes_str.empty() ? "" : ",");
+            for (uint32_t i = 0; i < dims->size(); ++i) {
+                shapes_str += (i == 0 ? "" : "x") + std::to_string(dims->at(i));
+            }
+        }
+        sprintf(float_buf_1, "%.2f", x->gflops_per_second);
+        string iteration_str;
+        if (x->iteration_count > 0) {
+            char iteration_buf[128];
+            sprintf(iteration_buf, ", ITERATIONS: [%lu], OVERHEAD_PER_ITER: [%.2fus]", (unsigned long)x->iteration_count,
+                    x->iteration_overhead_microseconds);
+            iteration_str = iteration_buf;
+        }
         LOG(INFO) << "NAME: [" << temp << "], "
                   << "AVG_TIME: [" << float_buf_0 << "], "
-                  << "EXEC_COUNT: [" << x->exec_count << "]";
+                  << "P50: [" << x->p50_microseconds << "us], "
+                  << "P99: [" << x->p99_microseconds << "us], "
+                  << "EXEC_COUNT: [" << x->exec_count << "], "
+                  << "INPUTS: [" << shapes_str << "]"
+                  << (x->algorithm.empty() ? "" : ", ALGO: [" + x->algorithm + "]")
+                  << (x->flops == 0 ? "" : ", GFLOPS: [" + string(float_buf_1) + "]") << iteration_str;
     }
     LOG(INFO) << "----- OP statistics by OpType -----";
     double tot_kernel_time = 0;
@@ -1037,6 +1163,16 @@ static bool Profiling(const vector<string>& input_data, Runtime* runtime) {
         LOG(WARNING) << "Get profiling statistics failed: " << GetRetCodeStr(status);
     }
     PrintProfilingStatistics(stat, run_dur, run_count);
+
+    if (!g_flag_export_profiling_trace.empty()) {
+        status = ExportChromeTrace(stat, g_flag_export_profiling_trace.c_str());
+        if (status != RC_SUCCESS) {
+            LOG(WARNING) << "export profiling trace to [" << g_flag_export_profiling_trace
+                         << "] failed: " << GetRetCodeStr(status);
+        } else {
+            LOG(INFO) << "profiling trace is exported to [" << g_flag_export_profiling_trace << "].";
+        }
+    }
 #else
     LOG(INFO) << "Average run costs: " << (run_dur / run_count) << " ms.";
 #endif
@@ -1045,6 +1181,159 @@ static bool Profiling(const vector<string>& input_data, Runtime* runtime) {
     return true;
 }
 
+/** @brief percentile `p` of sorted `values` */
+static double GetPercentile(const vector<double>& values, double p) {
+    auto idx = (size_t)(p / 100 * (values.size() - 1) + 0.5);
+    return values[idx];
+}
+
+/**
+   @brief sends requests made from current inputs of `runtime` by `g_flag_benchmark_clients` threads concurrently
+   and reports throughput and latency.
+   @note `runtime` cannot be used after benchmarking because its inputs are reshaped.
+*/
+static bool Benchmark(Runtime* runtime) {
+    vector<vector<char>> input_data(runtime->GetInputCount());
+    vector<const void*> inputs(runtime->GetInputCount());
+    vector<TensorShape> input_shapes(runtime->GetInputCount());
+    for (uint32_t i = 0; i < runtime->GetInputCount(); ++i) {
+        auto t = runtime->GetInputTensor(i);
+        TensorShape dst_desc = *t->GetShape();
+        dst_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+        input_data[i].resize(dst_desc.GetBytesExcludingPadding());
+        auto status = t->ConvertToHost(input_data[i].data(), dst_desc);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "get data of input[" << t->GetName() << "] failed: " << GetRetCodeStr(status);
+            return false;
+        }
+        inputs[i] = input_data[i].data();
+        input_shapes[i] = dst_desc;
+    }
+
+    BatchingOptions options;
+    options.max_batch_size = g_flag_max_batch_size;
+    options.max_wait_us = g_flag_max_batch_wait_us;
+    unique_ptr<BatchingRunner> runner(BatchingRunnerFactory::Create(runtime, options));
+    if (!runner) {
+        LOG(ERROR) << "create BatchingRunner failed.";
+        return false;
+    }
+
+    LOG(INFO) << "Benchmark start with " << g_flag_benchmark_clients << " clients, max batch size "
+              << g_flag_max_batch_size << ", max wait " << g_flag_max_batch_wait_us << " us";
+
+    atomic<bool> failed(false);
+    vector<vector<double>> client_latencies(g_flag_benchmark_clients);
+    auto bench_begin_ts = std::chrono::steady_clock::now();
+    auto bench_end_ts = bench_begin_ts + std::chrono::microseconds((int64_t)(g_flag_benchmark_seconds * 1000000));
+
+    vector<thread> clients;
+    for (uint32_t c = 0; c < g_flag_benchmark_clients; ++c) {
+        clients.emplace_back([&, c]() {
+            vector<vector<char>> outputs;
+            while (!failed && std::chrono::steady_clock::now() < bench_end_ts) {
+                auto run_begin_ts = std::chrono::steady_clock::now();
+                auto status = runner->Run(inputs, input_shapes, &outputs);
+                auto run_end_ts = std::chrono::steady_clock::now();
+                if (status != RC_SUCCESS) {
+                    LOG(ERROR) << "Run() of client[" << c << "] failed: " << GetRetCodeStr(status);
+                    failed = true;
+                    break;
+                }
+                auto diff = std::chrono::duration_cast<std::chrono::microseconds>(run_end_ts - run_begin_ts);
+                client_latencies[c].push_back((double)diff.count() / 1000);
+            }
+        });
+    }
+    for (auto& t : clients) {
+        t.join();
+    }
+    auto diff = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                      bench_begin_ts);
+
+    BatchingStatistics stat;
+    runner->GetStatistics(&stat);
+    if (stat.failed_batch_count > 0) {
+        LOG(ERROR) << "failed requests: " << stat.failed_request_count << ", failed batches: "
+                   << stat.failed_batch_count;
+    }
+    if (failed) {
+        return false;
+    }
+
+    vector<double> latencies;
+    for (auto& l : client_latencies) {
+        latencies.insert(latencies.end(), l.begin(), l.end());
+    }
+    if (latencies.empty()) {
+        LOG(ERROR) << "no requests finished in " << g_flag_benchmark_seconds << " seconds.";
+        return false;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    double total_latency = 0;
+    for (auto l : latencies) {
+        total_latency += l;
+    }
+
+    double seconds = (double)diff.count() / 1000000;
+
+    LOG(INFO) << "Requests: " << stat.request_count << ", samples: " << stat.sample_count
+              << ", batches: " << stat.batch_count
+              << ", average batch size: " << (double)stat.sample_count / stat.batch_count;
+    LOG(INFO) << "Throughput: " << stat.request_count / seconds << " requests/s, "
+              << stat.sample_count / seconds << " samples/s";
+    LOG(INFO) << "Latency(ms): avg " << total_latency / latencies.size() << ", p50 "
+              << GetPercentile(latencies, 50) << ", p90 " << GetPercentile(latencies, 90) << ", p99 "
+              << GetPercentile(latencies, 99) << ", max " << latencies.back();
+    LOG(INFO) << "Benchmark End";
+
+    return true;
+}
+
+/* returns 0 if it is not available */
+static uint64_t GetPeakRssKb() {
+#if defined(_WIN32) || defined(_WIN64)
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // in bytes on macos
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+static void PrintMemoryStatistics(Runtime* runtime) {
+    MemoryStatistics stat;
+    auto status = runtime->Configure(RUNTIME_CONF_GET_MEMORY_STATISTICS, &stat);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "get memory statistics failed: " << GetRetCodeStr(status);
+        return;
+    }
+
+    LOG(INFO) << "Memory: constants " << stat.constant_bytes << " bytes, activations " << stat.activation_bytes
+              << " (peak " << stat.max_activation_bytes << ") bytes, scratch " << stat.scratch_bytes << " (peak "
+              << stat.max_scratch_bytes << ") bytes, total " << stat.total_bytes << " (peak "
+              << stat.max_total_bytes << ") bytes, reserved " << stat.reserved_bytes << " bytes.";
+    if (stat.budget_exceeded_count > 0) {
+        LOG(INFO) << "Memory budget exceeded " << stat.budget_exceeded_count << " times.";
+    }
+
+    auto max_scratch = std::max_element(stat.kernel_info.begin(), stat.kernel_info.end(),
+                                        [](const KernelMemoryInfo& a, const KernelMemoryInfo& b) -> bool {
+                                            return a.max_scratch_bytes < b.max_scratch_bytes;
+                                        });
+    if (max_scratch != stat.kernel_info.end() && max_scratch->max_scratch_bytes > 0) {
+        LOG(INFO) << "Max scratch memory: " << max_scratch->max_scratch_bytes << " bytes used by kernel["
+                  << max_scratch->name << "] of type[" << max_scratch->domain << ":" << max_scratch->type << "].";
+    }
+}
+
 static inline bool HasMultipleModelOptions() {
 #if defined(PPLNN_ENABLE_PMX_MODEL) && defined(PPLNN_ENABLE_ONNX_MODEL)
     return (!g_flag_onnx_model.empty() && !g_flag_pmx_model.empty());
@@ -1093,6 +1382,7 @@ int main(int argc, char* argv[]) {
     }
 
     unique_ptr<Runtime> runtime;
+    auto load_begin_ts = std::chrono::system_clock::now();
 
 #ifdef PPLNN_ENABLE_ONNX_MODEL
     if (!g_flag_onnx_model.empty()) {
@@ -1144,7 +1434,13 @@ int main(int argc, char* argv[]) {
             return -1;
         }
 
-        auto status = builder->Init(g_flag_pmx_model.c_str(), engine_ptrs.data(), engine_ptrs.size());
+        auto status = builder->Configure(PMX_RB_CONF_SET_MMAP_FLAG, g_flag_use_mmap);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "set mmap flag failed: " << GetRetCodeStr(status);
+            return -1;
+        }
+
+        status = builder->Init(g_flag_pmx_model.c_str(), engine_ptrs.data(), engine_ptrs.size());
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "init PmxRuntimeBuilder failed: " << GetRetCodeStr(status);
             return -1;
@@ -1167,6 +1463,47 @@ int main(int argc, char* argv[]) {
         return -1;
     }
 
+    auto load_end_ts = std::chrono::system_clock::now();
+    auto load_diff = std::chrono::duration_cast<std::chrono::microseconds>(load_end_ts - load_begin_ts);
+    LOG(INFO) << "Load model costs: " << (float)load_diff.count() / 1000 << " ms, peak RSS: " << GetPeakRssKb() / 1024
+              << " MB.";
+
+    if (g_flag_sched_policy == "parallel") {
+        status = runtime->Configure(RUNTIME_CONF_SET_SCHEDULING_THREAD_NUM, g_flag_sched_thread_num);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "set scheduling thread num failed: " << GetRetCodeStr(status);
+            return -1;
+        }
+        status = runtime->Configure(RUNTIME_CONF_SET_SCHEDULING_POLICY, RUNTIME_SCHED_PARALLEL);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "set scheduling policy failed: " << GetRetCodeStr(status);
+            return -1;
+        }
+    } else if (g_flag_sched_policy != "seq") {
+        LOG(ERROR) << "unknown scheduling policy[" << g_flag_sched_policy << "]";
+        return -1;
+    }
+
+    uint64_t planned_memory_bytes = 0;
+    runtime->Configure(RUNTIME_CONF_GET_PLANNED_MEMORY_BYTES, &planned_memory_bytes);
+    LOG(INFO) << "planned activation memory: " << planned_memory_bytes << " bytes";
+
+#ifdef PPLNN_USE_X86
+    if (g_flag_use_x86 && g_flag_x86_memory_budget_mb > 0) {
+        if (!SetX86MemoryBudget(runtime.get())) {
+            return -1;
+        }
+    }
+#endif
+
+    if (g_flag_enable_memory_plan) {
+        status = runtime->Configure(RUNTIME_CONF_SET_MEMORY_PLAN_FLAG, true);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "enable static memory plan failed: " << GetRetCodeStr(status);
+            return -1;
+        }
+    }
+
     vector<vector<int64_t>> input_shapes;
     if (!g_flag_input_shapes.empty()) {
         if (!ParseInputShapes(g_flag_input_shapes, &input_shapes)) {
@@ -1239,6 +1576,8 @@ int main(int argc, char* argv[]) {
     auto diff = std::chrono::duration_cast<std::chrono::microseconds>(run_end_ts - run_begin_ts);
     LOG(INFO) << "Run() costs: " << (float)diff.count() / 1000 << " ms.";
 
+    PrintMemoryStatistics(runtime.get());
+
     if (g_flag_save_outputs) {
         if (!SaveOutputsOneByOne(runtime.get())) {
             return -1;
@@ -1254,5 +1593,12 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (g_flag_benchmark_clients > 0) {
+        if (!Benchmark(runtime.get())) {
+            LOG(ERROR) << "Benchmark() failed.";
+            return -1;
+        }
+    }
+
     return 0;
 }